@@ -17,6 +17,8 @@ function(add_engine_dependencies target_name)
 
 	if(AUDIO_MODULE MATCHES "FMOD")
 		add_dependencies(${target_name} bsfFMOD)
+	elseif(AUDIO_MODULE MATCHES "Software")
+		add_dependencies(${target_name} bsfSoftwareAudio)
 	else() # Default to OpenAudio
 		add_dependencies(${target_name} bsfOpenAudio)
 	endif()
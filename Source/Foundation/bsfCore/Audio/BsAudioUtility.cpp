@@ -1,6 +1,9 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Audio/BsAudioUtility.h"
+#include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -15,7 +18,7 @@ namespace bs
 				++input;
 			}
 
-			*output = sum / numChannels;
+			*output = sum / (INT32)numChannels;
 			++output;
 		}
 	}
@@ -31,7 +34,7 @@ namespace bs
 				++input;
 			}
 
-			*output = sum / numChannels;
+			*output = sum / (INT32)numChannels;
 			++output;
 		}
 	}
@@ -122,7 +125,7 @@ namespace bs
 		}
 	}
 
-	void AudioUtility::convertToMono(const UINT8* input, UINT8* output, UINT32 bitDepth, UINT32 numSamples, UINT32 numChannels)
+	void convertToMonoScalar(const UINT8* input, UINT8* output, UINT32 bitDepth, UINT32 numSamples, UINT32 numChannels)
 	{
 		switch (bitDepth)
 		{
@@ -144,7 +147,7 @@ namespace bs
 		}
 	}
 
-	void AudioUtility::convertBitDepth(const UINT8* input, UINT32 inBitDepth, UINT8* output, UINT32 outBitDepth, UINT32 numSamples)
+	void convertBitDepthScalar(const UINT8* input, UINT32 inBitDepth, UINT8* output, UINT32 outBitDepth, UINT32 numSamples)
 	{
 		INT32* srcBuffer = nullptr;
 
@@ -202,7 +205,7 @@ namespace bs
 		}
 	}
 
-	void AudioUtility::convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples)
+	void convertToFloatScalar(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples)
 	{
 		if (inBitDepth == 8)
 		{
@@ -228,7 +231,7 @@ namespace bs
 		{
 			for (UINT32 i = 0; i < numSamples; i++)
 			{
-				INT32 sample = convert24To32Bits(input);
+				INT32 sample = AudioUtility::convert24To32Bits(input);
 				output[i] = sample / 2147483647.0f;
 
 				input += 3;
@@ -248,6 +251,444 @@ namespace bs
 			assert(false);
 	}
 
+	/** Number of samples processed at once by kernels that need an intermediate buffer. */
+	static constexpr UINT32 CONVERSION_CHUNK_SIZE = 1024;
+
+	/** Maximum number of channels the vectorized mono conversion handles, larger counts use the scalar path. */
+	static constexpr UINT32 MAX_VECTORIZED_CHANNELS = 8;
+
+	/** Minimum number of samples handled by a single worker when converting in parallel. */
+	static constexpr UINT32 MIN_SAMPLES_PER_WORKER = 64 * 1024;
+
+	/** Sign extends 8-bit samples into 32-bit samples, shifting them left by @p shift bits. */
+	void widen8To32BitsSIMD(const INT8* input, INT32* output, UINT32 numSamples, UINT32 shift)
+	{
+		using namespace simd;
+
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			int8x16 value = load_u(input + i);
+			int32<16> wide = shift_l(to_int32(value), shift);
+
+			store_u(output + i, wide);
+		}
+
+		for (; i < numSamples; i++)
+			output[i] = input[i] << shift;
+	}
+
+	/** Sign extends 16-bit samples into 32-bit samples, shifting them left by @p shift bits. */
+	void widen16To32BitsSIMD(const INT16* input, INT32* output, UINT32 numSamples, UINT32 shift)
+	{
+		using namespace simd;
+
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			int16x8 value = load_u(input + i);
+			int32x8 wide = shift_l(to_int32(value), shift);
+
+			store_u(output + i, wide);
+		}
+
+		for (; i < numSamples; i++)
+			output[i] = input[i] << shift;
+	}
+
+	/** Same as convert24To32Bits(), using byte shuffles to expand four samples at once. */
+	void widen24To32BitsSIMD(const UINT8* input, INT32* output, UINT32 numSamples)
+	{
+		using namespace simd;
+
+		// Moves each 3-byte sample into the upper three bytes of a 32-bit lane, zeroing the lowest byte
+		const uint8x16 mask = make_uint(0x80, 0, 1, 2, 0x80, 3, 4, 5, 0x80, 6, 7, 8, 0x80, 9, 10, 11);
+
+		// Each iteration reads 16 bytes but only consumes 12, make sure the read stays within the buffer
+		UINT32 i = 0;
+		for (; i + 6 <= numSamples; i += 4)
+		{
+			uint8x16 bytes = load_u(input + i * 3);
+			int32x4 value = int32x4(permute_zbytes16(bytes, mask));
+
+			store_u(output + i, value);
+		}
+
+		for (; i < numSamples; i++)
+			output[i] = AudioUtility::convert24To32Bits(input + i * 3);
+	}
+
+	/** Converts 32-bit samples into 8-bit samples, shifting them right by @p shift bits and keeping the low bits. */
+	void narrow32To8BitsSIMD(const INT32* input, UINT8* output, UINT32 numSamples, UINT32 shift)
+	{
+		using namespace simd;
+
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			int32<16> value = load_u(input + i);
+			int8x16 narrow = to_int8(shift_r(value, shift));
+
+			store_u(output + i, narrow);
+		}
+
+		for (; i < numSamples; i++)
+			output[i] = (INT8)(input[i] >> shift);
+	}
+
+	/** Converts 32-bit samples into 16-bit samples, shifting them right by @p shift bits and keeping the low bits. */
+	void narrow32To16BitsSIMD(const INT32* input, INT16* output, UINT32 numSamples, UINT32 shift)
+	{
+		using namespace simd;
+
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			int32x8 value = load_u(input + i);
+			int16x8 narrow = to_int16(shift_r(value, shift));
+
+			store_u(output + i, narrow);
+		}
+
+		for (; i < numSamples; i++)
+			output[i] = (INT16)(input[i] >> shift);
+	}
+
+	/** Converts 32-bit samples into 24-bit samples, keeping the most significant bits. */
+	void narrow32To24BitsSIMD(const INT32* input, UINT8* output, UINT32 numSamples)
+	{
+		using namespace simd;
+
+		// Packs the upper three bytes of each 32-bit lane into the first 12 bytes
+		const uint8x16 mask = make_uint(1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, 0x80, 0x80, 0x80, 0x80);
+
+		// Each iteration writes 16 bytes but only 12 are valid, the rest is overwritten by the next iteration
+		UINT32 i = 0;
+		for (; i + 6 <= numSamples; i += 4)
+		{
+			uint8x16 value = load_u(input + i);
+			uint8x16 packed = permute_zbytes16(value, mask);
+
+			store_u(output + i * 3, packed);
+		}
+
+		for (; i < numSamples; i++)
+			convert32To24Bits(input[i], output + i * 3);
+	}
+
+	/** Converts 32-bit samples into floating point samples by dividing them with @p divisor. */
+	void convert32ToFloatSIMD(const INT32* input, float* output, UINT32 numSamples, float divisor)
+	{
+		using namespace simd;
+
+		const float32x4 divisorVec = load_splat(&divisor);
+
+		UINT32 i = 0;
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			int32x4 value = load_u(input + i);
+			float32x4 result = div(to_float32(value), divisorVec);
+
+			store_u(output + i, result);
+		}
+
+		for (; i < numSamples; i++)
+			output[i] = input[i] / divisor;
+	}
+
+	/**
+	 * Expands samples of the provided bit depth into 32-bit integers. 8- and 16-bit samples keep their original range if
+	 * @p keepRange is true, otherwise all samples are scaled to the full 32-bit range. Returns a pointer to the expanded
+	 * samples, which is either @p buffer or @p input itself if no conversion was needed.
+	 */
+	const INT32* widenTo32BitsSIMD(const UINT8* input, UINT32 bitDepth, UINT32 numSamples, INT32* buffer, bool keepRange)
+	{
+		switch (bitDepth)
+		{
+		case 8:
+			widen8To32BitsSIMD((const INT8*)input, buffer, numSamples, keepRange ? 0 : 24);
+			return buffer;
+		case 16:
+			widen16To32BitsSIMD((const INT16*)input, buffer, numSamples, keepRange ? 0 : 16);
+			return buffer;
+		case 24:
+			widen24To32BitsSIMD(input, buffer, numSamples);
+			return buffer;
+		case 32:
+			return (const INT32*)input;
+		default:
+			assert(false);
+			return buffer;
+		}
+	}
+
+	/**
+	 * Averages all channels of each frame of 32-bit samples. Results are rounded towards zero, same as integer division
+	 * in the scalar path. Sums are performed in double precision, which represents them exactly for any supported
+	 * channel count, so the results are bit-exact.
+	 */
+	void averageChannelsSIMD(const INT32* input, INT32* output, UINT32 numFrames, UINT32 numChannels)
+	{
+		using namespace simd;
+
+		if (numChannels == 1)
+		{
+			memcpy(output, input, numFrames * sizeof(INT32));
+			return;
+		}
+
+		const double numChannelsDbl = (double)numChannels;
+		const float64x4 divisor = load_splat(&numChannelsDbl);
+
+		UINT32 i = 0;
+		if (numChannels == 2)
+		{
+			for (; i + 4 <= numFrames; i += 4)
+			{
+				int32x4 a = load_u(input + i * 2);
+				int32x4 b = load_u(input + i * 2 + 4);
+
+				float64x4 left = to_float64(unzip4_lo(a, b));
+				float64x4 right = to_float64(unzip4_hi(a, b));
+
+				int32x4 avg = to_int32(div(add(left, right), divisor));
+				store_u(output + i, avg);
+			}
+		}
+		else
+		{
+			INT32 channel[4];
+			for (; i + 4 <= numFrames; i += 4)
+			{
+				float64x4 sum = make_zero();
+				for (UINT32 j = 0; j < numChannels; j++)
+				{
+					for (UINT32 k = 0; k < 4; k++)
+						channel[k] = input[(i + k) * numChannels + j];
+
+					int32x4 value = load_u(channel);
+					sum = add(sum, to_float64(value));
+				}
+
+				int32x4 avg = to_int32(div(sum, divisor));
+				store_u(output + i, avg);
+			}
+		}
+
+		for (; i < numFrames; i++)
+		{
+			INT64 sum = 0;
+			for (UINT32 j = 0; j < numChannels; j++)
+				sum += input[i * numChannels + j];
+
+			output[i] = (INT32)(sum / (INT64)numChannels);
+		}
+	}
+
+	/** Vectorized version of convertToMonoScalar(). */
+	void convertToMonoSIMD(const UINT8* input, UINT8* output, UINT32 bitDepth, UINT32 numSamples, UINT32 numChannels)
+	{
+		if (numChannels > MAX_VECTORIZED_CHANNELS)
+		{
+			convertToMonoScalar(input, output, bitDepth, numSamples, numChannels);
+			return;
+		}
+
+		const UINT32 bytesPerSample = bitDepth / 8;
+		const UINT32 framesPerChunk = CONVERSION_CHUNK_SIZE / numChannels;
+
+		INT32 samples[CONVERSION_CHUNK_SIZE];
+		INT32 averages[CONVERSION_CHUNK_SIZE];
+
+		for (UINT32 i = 0; i < numSamples; i += framesPerChunk)
+		{
+			UINT32 numFrames = std::min(framesPerChunk, numSamples - i);
+			const UINT8* src = input + i * numChannels * bytesPerSample;
+			UINT8* dst = output + i * bytesPerSample;
+
+			// 8- and 16-bit samples are averaged in their original range, to match the scalar rounding
+			const INT32* wide = widenTo32BitsSIMD(src, bitDepth, numFrames * numChannels, samples, bitDepth <= 16);
+			averageChannelsSIMD(wide, averages, numFrames, numChannels);
+
+			switch (bitDepth)
+			{
+			case 8:
+				narrow32To8BitsSIMD(averages, dst, numFrames, 0);
+				break;
+			case 16:
+				narrow32To16BitsSIMD(averages, (INT16*)dst, numFrames, 0);
+				break;
+			case 24:
+				narrow32To24BitsSIMD(averages, dst, numFrames);
+				break;
+			case 32:
+				memcpy(dst, averages, numFrames * sizeof(INT32));
+				break;
+			default:
+				assert(false);
+				break;
+			}
+		}
+	}
+
+	/** Vectorized version of convertBitDepthScalar(). */
+	void convertBitDepthSIMD(const UINT8* input, UINT32 inBitDepth, UINT8* output, UINT32 outBitDepth, UINT32 numSamples)
+	{
+		const UINT32 inBytesPerSample = inBitDepth / 8;
+		const UINT32 outBytesPerSample = outBitDepth / 8;
+
+		// Converts through a small intermediate 32-bit buffer that stays in cache, rather than one for the whole input
+		INT32 buffer[CONVERSION_CHUNK_SIZE];
+		for (UINT32 i = 0; i < numSamples; i += CONVERSION_CHUNK_SIZE)
+		{
+			UINT32 count = std::min(CONVERSION_CHUNK_SIZE, numSamples - i);
+			const INT32* wide = widenTo32BitsSIMD(input + i * inBytesPerSample, inBitDepth, count, buffer, false);
+
+			UINT8* dst = output + i * outBytesPerSample;
+			switch (outBitDepth)
+			{
+			case 8:
+				narrow32To8BitsSIMD(wide, dst, count, 24);
+				break;
+			case 16:
+				narrow32To16BitsSIMD(wide, (INT16*)dst, count, 16);
+				break;
+			case 24:
+				narrow32To24BitsSIMD(wide, dst, count);
+				break;
+			case 32:
+				memcpy(dst, wide, count * sizeof(INT32));
+				break;
+			default:
+				assert(false);
+				break;
+			}
+		}
+	}
+
+	/** Vectorized version of convertToFloatScalar(). */
+	void convertToFloatSIMD(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples)
+	{
+		const UINT32 bytesPerSample = inBitDepth / 8;
+
+		float divisor;
+		switch (inBitDepth)
+		{
+		case 8:
+			divisor = 127.0f;
+			break;
+		case 16:
+			divisor = 32767.0f;
+			break;
+		case 24:
+		case 32:
+			divisor = 2147483647.0f;
+			break;
+		default:
+			assert(false);
+			return;
+		}
+
+		INT32 buffer[CONVERSION_CHUNK_SIZE];
+		for (UINT32 i = 0; i < numSamples; i += CONVERSION_CHUNK_SIZE)
+		{
+			UINT32 count = std::min(CONVERSION_CHUNK_SIZE, numSamples - i);
+
+			const INT32* wide = widenTo32BitsSIMD(input + i * bytesPerSample, inBitDepth, count, buffer, true);
+			convert32ToFloatSIMD(wide, output + i, count, divisor);
+		}
+	}
+
+	/**
+	 * Runs @p kernel over @p numItems items. In parallel mode large workloads are split into ranges processed by task
+	 * scheduler workers, otherwise the kernel runs once on the calling thread. Kernel receives the first item of its
+	 * range and the number of items in it.
+	 */
+	void dispatchConversion(UINT32 numItems, UINT32 samplesPerItem, AudioConversionMode mode,
+		const std::function<void(UINT32, UINT32)>& kernel)
+	{
+		const UINT32 numTasks = AudioUtility::_getNumConversionTasks(numItems * samplesPerItem, mode);
+		if (numTasks <= 1)
+		{
+			kernel(0, numItems);
+			return;
+		}
+
+		const UINT32 itemsPerTask = Math::divideAndRoundUp(numItems, numTasks);
+		auto worker = [&](UINT32 idx)
+		{
+			UINT32 start = idx * itemsPerTask;
+			if (start >= numItems)
+				return;
+
+			kernel(start, std::min(itemsPerTask, numItems - start));
+		};
+
+		SPtr<TaskGroup> taskGroup = TaskGroup::create("AudioConversion", worker, numTasks, TaskPriority::High);
+		TaskScheduler::instance().addTaskGroup(taskGroup);
+		taskGroup->wait();
+	}
+
+	void AudioUtility::convertToMono(const UINT8* input, UINT8* output, UINT32 bitDepth, UINT32 numSamples,
+		UINT32 numChannels, AudioConversionMode mode)
+	{
+		if (mode == AudioConversionMode::Reference)
+		{
+			convertToMonoScalar(input, output, bitDepth, numSamples, numChannels);
+			return;
+		}
+
+		const UINT32 bytesPerSample = bitDepth / 8;
+		dispatchConversion(numSamples, numChannels, mode, [=](UINT32 start, UINT32 count)
+		{
+			convertToMonoSIMD(input + start * numChannels * bytesPerSample, output + start * bytesPerSample, bitDepth,
+				count, numChannels);
+		});
+	}
+
+	void AudioUtility::convertBitDepth(const UINT8* input, UINT32 inBitDepth, UINT8* output, UINT32 outBitDepth,
+		UINT32 numSamples, AudioConversionMode mode)
+	{
+		if (mode == AudioConversionMode::Reference)
+		{
+			convertBitDepthScalar(input, inBitDepth, output, outBitDepth, numSamples);
+			return;
+		}
+
+		const UINT32 inBytesPerSample = inBitDepth / 8;
+		const UINT32 outBytesPerSample = outBitDepth / 8;
+		dispatchConversion(numSamples, 1, mode, [=](UINT32 start, UINT32 count)
+		{
+			convertBitDepthSIMD(input + start * inBytesPerSample, inBitDepth, output + start * outBytesPerSample,
+				outBitDepth, count);
+		});
+	}
+
+	void AudioUtility::convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples,
+		AudioConversionMode mode)
+	{
+		if (mode == AudioConversionMode::Reference)
+		{
+			convertToFloatScalar(input, inBitDepth, output, numSamples);
+			return;
+		}
+
+		const UINT32 bytesPerSample = inBitDepth / 8;
+		dispatchConversion(numSamples, 1, mode, [=](UINT32 start, UINT32 count)
+		{
+			convertToFloatSIMD(input + start * bytesPerSample, inBitDepth, output + start, count);
+		});
+	}
+
+	UINT32 AudioUtility::_getNumConversionTasks(UINT32 numSamples, AudioConversionMode mode)
+	{
+		if (mode != AudioConversionMode::Parallel || !TaskScheduler::isStarted())
+			return 1;
+
+		UINT32 maxTasks = Math::divideAndRoundUp(numSamples, MIN_SAMPLES_PER_WORKER);
+		return std::max(1U, std::min(TaskScheduler::instance().getNumWorkers(), maxTasks));
+	}
+
 	INT32 AudioUtility::convert24To32Bits(const UINT8* input)
 	{
 		return (input[2] << 24) | (input[1] << 16) | (input[0] << 8);
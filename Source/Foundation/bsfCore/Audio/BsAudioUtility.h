@@ -10,6 +10,20 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Determines how are audio sample conversions in AudioUtility performed. */
+	enum class AudioConversionMode
+	{
+		/** Uses vectorized kernels on the calling thread. */
+		Default,
+		/**
+		 * Same as Default, except large buffers are split between task scheduler workers. The calling thread blocks until
+		 * all workers are done. Falls back to Default if the task scheduler is not running.
+		 */
+		Parallel,
+		/** Uses plain scalar loops. Slowest, primarily used for validating the other modes. */
+		Reference
+	};
+
 	/** Provides various utility functionality relating to audio. */
 	class BS_CORE_EXPORT AudioUtility
 	{
@@ -25,8 +39,10 @@ namespace bs
 		 * @param[in]	bitDepth	Size of a single sample in bits.
 		 * @param[in]	numSamples	Number of samples per a single channel.
 		 * @param[in]	numChannels	Number of channels in the input data.
+		 * @param[in]	mode		Determines how is the conversion performed. All modes produce identical output.
 		 */
-		static void convertToMono(const UINT8* input, UINT8* output, UINT32 bitDepth, UINT32 numSamples, UINT32 numChannels);
+		static void convertToMono(const UINT8* input, UINT8* output, UINT32 bitDepth, UINT32 numSamples, UINT32 numChannels,
+			AudioConversionMode mode = AudioConversionMode::Default);
 
 		/**
 		 * Converts a set of audio samples of a certain bit depth to a new bit depth.
@@ -38,8 +54,10 @@ namespace bs
 		 *							@p numSamples * @p outBitDepth / 8.
 		 * @param[in]	outBitDepth	Size of a single sample in the @p output array, in bits.
 		 * @param[in]	numSamples	Total number of samples to process.
+		 * @param[in]	mode		Determines how is the conversion performed. All modes produce identical output.
 		 */
-		static void convertBitDepth(const UINT8* input, UINT32 inBitDepth, UINT8* output, UINT32 outBitDepth, UINT32 numSamples);
+		static void convertBitDepth(const UINT8* input, UINT32 inBitDepth, UINT8* output, UINT32 outBitDepth, UINT32 numSamples,
+			AudioConversionMode mode = AudioConversionMode::Default);
 
 		/**
 		 * Converts a set of audio samples of a certain bit depth to a set of floating point samples in range [-1, 1].
@@ -50,8 +68,10 @@ namespace bs
 		 * @param[out]	output		Pre-allocated buffer to store the output samples in. Total size of the buffer should be
 		 *							@p numSamples * sizeof(float).
 		 * @param[in]	numSamples	Total number of samples to process.
+		 * @param[in]	mode		Determines how is the conversion performed. All modes produce identical output.
 		 */
-		static void convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples);
+		static void convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples,
+			AudioConversionMode mode = AudioConversionMode::Default);
 
 		/** 
 		 * Converts a 24-bit signed integer into a 32-bit signed integer. 
@@ -60,6 +80,12 @@ namespace bs
 		 * @return				32-bit signed integer.
 		 */
 		static INT32 convert24To32Bits(const UINT8* input);
+
+		/**
+		 * Returns the number of tasks a conversion of @p numSamples samples gets split into when performed with the
+		 * provided mode. Conversion runs on the calling thread if this is one.
+		 */
+		static UINT32 _getNumConversionTasks(UINT32 numSamples, AudioConversionMode mode);
 	};
 
 	/** @} */
@@ -45,6 +45,7 @@
 #include "Animation/BsAnimationManager.h"
 #include "Renderer/BsParamBlocks.h"
 #include "Particles/BsParticleManager.h"
+#include "Text/BsGlyphCache.h"
 
 namespace bs
 {
@@ -62,6 +63,7 @@ namespace bs
 		mPrimaryWindow = nullptr;
 
 		Importer::shutDown();
+		GlyphCacheManager::shutDown();
 		MaterialManager::shutDown();
 		MeshManager::shutDown();
 		ProfilerGPU::shutDown();
@@ -118,6 +120,9 @@ namespace bs
 		MemStack::endThread();
 		Platform::_shutDown();
 
+		// Output any remaining messages and continue logging synchronously
+		gDebug().getLog().setAsync(false);
+
 		CrashHandler::shutDown();
 	}
 
@@ -128,6 +133,9 @@ namespace bs
 		Platform::_startUp();
 		MemStack::beginThread();
 
+		// Keep console and file output of log messages off the calling threads
+		gDebug().getLog().setAsync(true);
+
 		ShaderManager::startUp(getShaderIncludeHandler());
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
@@ -166,6 +174,7 @@ namespace bs
 		MeshManager::startUp();
 		MaterialManager::startUp();
 		Importer::startUp();
+		GlyphCacheManager::startUp();
 		AudioManager::startUp(mStartUpDesc.audio);
 		PhysicsManager::startUp(mStartUpDesc.physics, isEditor());
 		AnimationManager::startUp();
@@ -250,6 +259,9 @@ namespace bs
 
 			postUpdate();
 
+			// Upload any glyphs rasterized during this frame's text updates
+			GlyphCacheManager::instance()._update();
+
 			PerFrameData perFrameData;
 
 			// Evaluate animation after scene and plugin updates because the renderer will just now be displaying the
@@ -268,6 +268,8 @@ namespace bs
 	class GpuProgramImportOptions;
 	class MeshImportOptions;
 	struct FontBitmap;
+	class GlyphCache;
+	class GlyphPageRefs;
 	class GameObject;
 	class GpuResourceData;
 	struct RenderOperation;
@@ -280,6 +282,7 @@ namespace bs
 	class VideoOutputInfo;
 	class VideoModeInfo;
 	struct SubMesh;
+	struct MeshLOD;
 	class IResourceListener;
 	class TextureProperties;
 	class IShaderIncludeHandler;
@@ -241,6 +241,7 @@ set(BS_CORE_INC_TEXT
 	"bsfCore/Text/BsFontImportOptions.h"
 	"bsfCore/Text/BsFontDesc.h"
 	"bsfCore/Text/BsFont.h"
+	"bsfCore/Text/BsGlyphCache.h"
 )
 
 set(BS_CORE_SRC_PROFILING
@@ -450,6 +451,7 @@ set(BS_CORE_INC_LOCALIZATION
 
 set(BS_CORE_SRC_TEXT
 	"bsfCore/Text/BsFont.cpp"
+	"bsfCore/Text/BsGlyphCache.cpp"
 	"bsfCore/Text/BsFontImportOptions.cpp"
 	"bsfCore/Text/BsTextData.cpp"
 )
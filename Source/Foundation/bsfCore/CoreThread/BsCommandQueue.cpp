@@ -4,6 +4,7 @@
 #include "Error/BsException.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Debug/BsDebug.h"
+#include "Debug/BsProfilerTimeline.h"
 
 namespace bs
 {
@@ -103,6 +104,8 @@ namespace bs
 		if(commands == nullptr)
 			return;
 
+		ProfilerTimeline::beginEvent("Command playback");
+
 		while(!commands->empty())
 		{
 			QueuedCommand& command = commands->front();
@@ -132,6 +135,8 @@ namespace bs
 			commands->pop();
 		}
 
+		ProfilerTimeline::endEvent();
+
 		mEmptyCommandQueues.push(commands);
 	}
 
@@ -3,6 +3,7 @@
 #include "CoreThread/BsCoreThread.h"
 #include "Threading/BsThreadPool.h"
 #include "Threading/BsTaskScheduler.h"
+#include "Debug/BsProfilerTimeline.h"
 #include "BsCoreApplication.h"
 
 using namespace std::placeholders;
@@ -80,6 +81,7 @@ namespace bs
 	{
 #if !BS_FORCE_SINGLETHREADED_RENDERING
 		TaskScheduler::instance().removeWorker(); // One less worker because we are reserving one core for this thread
+		ProfilerTimeline::setThreadName("Core");
 
 		{
 			Lock lock(mThreadStartedMutex);
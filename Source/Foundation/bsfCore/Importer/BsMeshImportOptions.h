@@ -165,6 +165,46 @@ namespace bs
 		 */
 		bool getImportRootMotion() const { return mImportRootMotion; }
 
+		/**
+		 * Enables or disables mesh optimization. When enabled triangles and vertices are reordered in order to improve
+		 * GPU vertex cache efficiency, vertex fetch locality and reduce overdraw. Mesh appearance is unaffected.
+		 */
+		void setOptimize(bool enabled) { mOptimize = enabled; }
+
+		/**
+		 * Checks is mesh optimization enabled.
+		 *
+		 * @see	setOptimize
+		 */
+		bool getOptimize() const { return mOptimize; }
+
+		/**
+		 * Determines how many lower levels of detail to generate for the mesh. Each level is a simplified version of the
+		 * previous one, rendered when the mesh is small on screen. Fewer levels might be generated if the mesh cannot be
+		 * simplified further without a noticeable change in shape. Zero disables level of detail generation.
+		 */
+		void setLODCount(UINT32 count) { mLODCount = count; }
+
+		/**
+		 * Returns the number of lower levels of detail to generate.
+		 *
+		 * @see	setLODCount
+		 */
+		UINT32 getLODCount() const { return mLODCount; }
+
+		/** 
+		 * Determines the fraction of triangles each level of detail keeps, relative to the previous level. Only relevant 
+		 * if LOD generation is enabled through setLODCount().
+		 */
+		void setLODReduction(float reduction) { mLODReduction = reduction; }
+
+		/**
+		 * Returns the fraction of triangles each level of detail keeps, relative to the previous level.
+		 *
+		 * @see	setLODReduction
+		 */
+		float getLODReduction() const { return mLODReduction; }
+
 		/** Creates a new import options object that allows you to customize how are meshes imported. */
 		static SPtr<MeshImportOptions> create();
 
@@ -177,6 +217,9 @@ namespace bs
 		bool mImportAnimation;
 		bool mReduceKeyFrames;
 		bool mImportRootMotion;
+		bool mOptimize;
+		UINT32 mLODCount;
+		float mLODReduction;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
 		Vector<AnimationSplitInfo> mAnimationSplits;
@@ -797,6 +797,56 @@ namespace bs
 			bs_frame_free(offsets);
 		}
 		bs_frame_clear();
+
+		// Map each material parameter to all the locations it is bound to, so that update() can visit just the
+		// parameters that changed
+		auto forEachBinding = [this, numPasses](auto func)
+		{
+			for(UINT32 i = 0; i < (UINT32)mDataParamInfos.size(); i++)
+				func(mDataParamInfos[i].paramIdx, ParamBinding{ ParamBindingType::Data, 0, 0, i });
+
+			for (UINT32 i = 0; i < numPasses; i++)
+			{
+				for (UINT32 j = 0; j < NUM_STAGES; j++)
+				{
+					const StageParamInfo& stageInfo = mPassParamInfos[i].stages[j];
+
+					for (UINT32 k = 0; k < stageInfo.numTextures; k++)
+						func(stageInfo.textures[k].paramIdx, ParamBinding{ ParamBindingType::Texture, i, j, k });
+
+					for (UINT32 k = 0; k < stageInfo.numLoadStoreTextures; k++)
+					{
+						func(stageInfo.loadStoreTextures[k].paramIdx, 
+							ParamBinding{ ParamBindingType::LoadStoreTexture, i, j, k });
+					}
+
+					for (UINT32 k = 0; k < stageInfo.numBuffers; k++)
+						func(stageInfo.buffers[k].paramIdx, ParamBinding{ ParamBindingType::Buffer, i, j, k });
+
+					for (UINT32 k = 0; k < stageInfo.numSamplerStates; k++)
+						func(stageInfo.samplerStates[k].paramIdx, ParamBinding{ ParamBindingType::SamplerState, i, j, k });
+				}
+			}
+		};
+
+		const UINT32 numMaterialParams = params->getNumParams();
+		mParamBindingOffsets.resize(numMaterialParams + 1, 0);
+
+		forEachBinding([this](UINT32 paramIdx, const ParamBinding& binding)
+		{
+			mParamBindingOffsets[paramIdx + 1]++;
+		});
+
+		for (UINT32 i = 0; i < numMaterialParams; i++)
+			mParamBindingOffsets[i + 1] += mParamBindingOffsets[i];
+
+		mParamBindings.resize(mParamBindingOffsets[numMaterialParams]);
+
+		Vector<UINT32> writeOffsets(mParamBindingOffsets.begin(), mParamBindingOffsets.end() - 1);
+		forEachBinding([this, &writeOffsets](UINT32 paramIdx, const ParamBinding& binding)
+		{
+			mParamBindings[writeOffsets[paramIdx]++] = binding;
+		});
 	}
 
 	template<bool Core>
@@ -881,265 +931,345 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TGpuParamsSet<Core>::update(const SPtr<MaterialParamsType>& params, float t, bool updateAll)
+	bool TGpuParamsSet<Core>::isDataParamAnimated(const DataParamInfo& paramInfo, const SPtr<MaterialParamsType>& params)
 	{
-		// Note: Instead of iterating over every single parameter, it might be more efficient for @p params to keep
-		// a ring buffer and a version number. Then we could just iterate over the ring buffer and only access dirty
-		// parameters. If the version number is too high (larger than ring buffer can store), then we force update for all.
+		const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+		UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
 
-		// Update data params
-		for(auto& paramInfo : mDataParamInfos)
+		for(UINT32 i = 0; i < arraySize; i++)
 		{
-			ParamBlockPtrType paramBlock = mBlocks[paramInfo.blockIdx].buffer;
-			if (paramBlock == nullptr || !mBlocks[paramInfo.blockIdx].allowUpdate)
-				continue;
+			if(params->isAnimated(*materialParamInfo, i))
+				return true;
+		}
 
-			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-			UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
-			
-			bool isAnimated = false;
-			for(UINT32 i = 0; i < arraySize; i++)
-			{
-				isAnimated = params->isAnimated(*materialParamInfo, i);
-				if(isAnimated)
-					break;
-			}
+		return false;
+	}
 
-			if (materialParamInfo->version <= mParamVersion && !updateAll && !isAnimated)
-				continue;
+	template<bool Core>
+	void TGpuParamsSet<Core>::updateDataParam(const DataParamInfo& paramInfo, const SPtr<MaterialParamsType>& params,
+		float t, bool isAnimated)
+	{
+		ParamBlockPtrType paramBlock = mBlocks[paramInfo.blockIdx].buffer;
+		if (paramBlock == nullptr || !mBlocks[paramInfo.blockIdx].allowUpdate)
+			return;
+
+		const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+		UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
 
-			const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[(int)materialParamInfo->dataType];
-			UINT32 paramSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
+		const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[(int)materialParamInfo->dataType];
+		UINT32 paramSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
 
-			UINT8* data = params->getData(materialParamInfo->index);
-			if(!isAnimated)
+		UINT8* data = params->getData(materialParamInfo->index);
+		if(!isAnimated)
+		{
+			const bool transposeMatrices = ct::RenderAPI::instance().getAPIInfo().isFlagSet(RenderAPIFeatureFlag::ColumnMajorMatrices);
+			if (transposeMatrices)
 			{
-				const bool transposeMatrices = ct::RenderAPI::instance().getAPIInfo().isFlagSet(RenderAPIFeatureFlag::ColumnMajorMatrices);
-				if (transposeMatrices)
+				auto writeTransposed = [&](auto& temp)
 				{
-					auto writeTransposed = [&](auto& temp)
+					for (UINT32 i = 0; i < arraySize; i++)
 					{
-						for (UINT32 i = 0; i < arraySize; i++)
-						{
-							UINT32 arrayOffset = i * paramSize;
-							memcpy(&temp, data + arrayOffset, paramSize);
-							auto transposed = temp.transpose();
-
-							paramBlock->write(paramInfo.offset * sizeof(UINT32) + arrayOffset, &transposed, paramSize);
-						}
-					};
+						UINT32 arrayOffset = i * paramSize;
+						memcpy(&temp, data + arrayOffset, paramSize);
+						auto transposed = temp.transpose();
 
-					switch (materialParamInfo->dataType)
-					{
-					case GPDT_MATRIX_2X2:
-					{
-						MatrixNxM<2, 2> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_2X3:
-					{
-						MatrixNxM<2, 3> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_2X4:
-					{
-						MatrixNxM<2, 4> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_3X2:
-					{
-						MatrixNxM<3, 2> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_3X3:
-					{
-						Matrix3 matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_3X4:
-					{
-						MatrixNxM<3, 4> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_4X2:
-					{
-						MatrixNxM<4, 2> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_4X3:
-					{
-						MatrixNxM<4, 3> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_4X4:
-					{
-						Matrix4 matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					default:
-					{
-						paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
-						break;
-					}
+						paramBlock->write(paramInfo.offset * sizeof(UINT32) + arrayOffset, &transposed, paramSize);
 					}
+				};
+
+				switch (materialParamInfo->dataType)
+				{
+				case GPDT_MATRIX_2X2:
+				{
+					MatrixNxM<2, 2> matrix;
+					writeTransposed(matrix);
 				}
-				else
+				break;
+				case GPDT_MATRIX_2X3:
+				{
+					MatrixNxM<2, 3> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_2X4:
+				{
+					MatrixNxM<2, 4> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_3X2:
+				{
+					MatrixNxM<3, 2> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_3X3:
+				{
+					Matrix3 matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_3X4:
+				{
+					MatrixNxM<3, 4> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_4X2:
+				{
+					MatrixNxM<4, 2> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_4X3:
+				{
+					MatrixNxM<4, 3> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_4X4:
+				{
+					Matrix4 matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				default:
+				{
 					paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
+					break;
+				}
+				}
 			}
-			else // Animated
+			else
+				paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
+		}
+		else // Animated
+		{
+			if(materialParamInfo->dataType == GPDT_FLOAT1)
 			{
-				if(materialParamInfo->dataType == GPDT_FLOAT1)
+				assert(paramSize == sizeof(float));
+
+				for (UINT32 i = 0; i < arraySize; i++)
 				{
-					assert(paramSize == sizeof(float));
+					UINT32 arrayOffset = i * paramSize;
+					UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
 
-					for (UINT32 i = 0; i < arraySize; i++)
+					float value;
+					if(params->isAnimated(*materialParamInfo, i))
 					{
-						UINT32 arrayOffset = i * paramSize;
-						UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
-
-						float value;
-						if(params->isAnimated(*materialParamInfo, i))
-						{
-							const TAnimationCurve<float>& curve = params->template getCurveParam<float>(*materialParamInfo, i);
+						const TAnimationCurve<float>& curve = params->template getCurveParam<float>(*materialParamInfo, i);
 
-							value = curve.evaluate(t, true);
-						}
-						else
-							memcpy(&value, data + arrayOffset, paramSize);
-
-						paramBlock->write(writeOffset, &value, paramSize);
+						value = curve.evaluate(t, true);
 					}
+					else
+						memcpy(&value, data + arrayOffset, paramSize);
+
+					paramBlock->write(writeOffset, &value, paramSize);
 				}
-				else if(materialParamInfo->dataType == GPDT_FLOAT4)
-				{
-					assert(paramSize == sizeof(Rect2));
-					
-					typename TSpriteTextureType<Core>::Type spriteTexture = 
-						params->getOwningSpriteTexture(*materialParamInfo);
+			}
+			else if(materialParamInfo->dataType == GPDT_FLOAT4)
+			{
+				assert(paramSize == sizeof(Rect2));
+				
+				typename TSpriteTextureType<Core>::Type spriteTexture = 
+					params->getOwningSpriteTexture(*materialParamInfo);
 
-					UINT32 writeOffset = paramInfo.offset * sizeof(UINT32);
-					Rect2 uv = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
-					if(spriteTexture != nullptr)
-						uv = spriteTexture->evaluate(t);
+				UINT32 writeOffset = paramInfo.offset * sizeof(UINT32);
+				Rect2 uv = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+				if(spriteTexture != nullptr)
+					uv = spriteTexture->evaluate(t);
 
-					paramBlock->write(writeOffset, &uv, paramSize);
+				paramBlock->write(writeOffset, &uv, paramSize);
 
-					// Only the first array element receives sprite UVs, the rest are treated as normal
-					if(arraySize > 1)
-					{
-						writeOffset = paramInfo.offset * sizeof(UINT32) + paramSize;
-						paramBlock->write(writeOffset, data + paramSize, paramSize * (arraySize - 1));
-					}
+				// Only the first array element receives sprite UVs, the rest are treated as normal
+				if(arraySize > 1)
+				{
+					writeOffset = paramInfo.offset * sizeof(UINT32) + paramSize;
+					paramBlock->write(writeOffset, data + paramSize, paramSize * (arraySize - 1));
 				}
-				else if(materialParamInfo->dataType == GPDT_COLOR)
+			}
+			else if(materialParamInfo->dataType == GPDT_COLOR)
+			{
+				for (UINT32 i = 0; i < arraySize; i++)
 				{
-					for (UINT32 i = 0; i < arraySize; i++)
-					{
-						assert(paramSize == sizeof(Color));
-
-						UINT32 arrayOffset = i * paramSize;
-						UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
+					assert(paramSize == sizeof(Color));
 
-						Color value;
-						if(params->isAnimated(*materialParamInfo, i))
-						{
-							const ColorGradient& gradient = params->getColorGradientParam(*materialParamInfo, i);
+					UINT32 arrayOffset = i * paramSize;
+					UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
 
-							const float wrappedT = Math::repeat(t, gradient.getDuration());
-							value.setAsRGBA(gradient.evaluate(wrappedT));
-						}
-						else
-							memcpy(&value, data + arrayOffset, paramSize);
+					Color value;
+					if(params->isAnimated(*materialParamInfo, i))
+					{
+						const ColorGradient& gradient = params->getColorGradientParam(*materialParamInfo, i);
 
-						paramBlock->write(writeOffset, &value, paramSize);
+						const float wrappedT = Math::repeat(t, gradient.getDuration());
+						value.setAsRGBA(gradient.evaluate(wrappedT));
 					}
+					else
+						memcpy(&value, data + arrayOffset, paramSize);
+
+					paramBlock->write(writeOffset, &value, paramSize);
 				}
 			}
 		}
+	}
 
-		// Update object params
-		const auto numPasses = (UINT32)mPassParams.size();
+	template<bool Core>
+	void TGpuParamsSet<Core>::updateObjectParam(const ParamBinding& binding, const SPtr<MaterialParamsType>& params)
+	{
+		SPtr<GpuParamsType> paramPtr = mPassParams[binding.passIdx];
+		const StageParamInfo& stageInfo = mPassParamInfos[binding.passIdx].stages[binding.stageIdx];
 
-		for(UINT32 i = 0; i < numPasses; i++)
+		switch(binding.type)
 		{
-			SPtr<GpuParamsType> paramPtr = mPassParams[i];
+		case ParamBindingType::Texture:
+		{
+			const ObjectParamInfo& paramInfo = stageInfo.textures[binding.entryIdx];
+			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
 
-			for(UINT32 j = 0; j < NUM_STAGES; j++)
-			{
-				const StageParamInfo& stageInfo = mPassParamInfos[i].stages[j];
+			TextureSurface surface;
+			TextureType texture;
+			params->getTexture(*materialParamInfo, texture, surface);
 
-				for(UINT32 k = 0; k < stageInfo.numTextures; k++)
-				{
-					const ObjectParamInfo& paramInfo = stageInfo.textures[k];
+			paramPtr->setTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
+		}
+			break;
+		case ParamBindingType::LoadStoreTexture:
+		{
+			const ObjectParamInfo& paramInfo = stageInfo.loadStoreTextures[binding.entryIdx];
+			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
-						continue;
+			TextureSurface surface;
+			TextureType texture;
+			params->getLoadStoreTexture(*materialParamInfo, texture, surface);
 
-					TextureSurface surface;
-					TextureType texture;
-					params->getTexture(*materialParamInfo, texture, surface);
+			paramPtr->setLoadStoreTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
+		}
+			break;
+		case ParamBindingType::Buffer:
+		{
+			const ObjectParamInfo& paramInfo = stageInfo.buffers[binding.entryIdx];
+			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
 
-					paramPtr->setTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
-				}
+			BufferType buffer;
+			params->getBuffer(*materialParamInfo, buffer);
 
-				for (UINT32 k = 0; k < stageInfo.numLoadStoreTextures; k++)
-				{
-					const ObjectParamInfo& paramInfo = stageInfo.loadStoreTextures[k];
+			paramPtr->setBuffer(paramInfo.setIdx, paramInfo.slotIdx, buffer);
+		}
+			break;
+		case ParamBindingType::SamplerState:
+		{
+			const ObjectParamInfo& paramInfo = stageInfo.samplerStates[binding.entryIdx];
+			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
-						continue;
+			SamplerStateType samplerState;
+			params->getSamplerState(*materialParamInfo, samplerState);
 
-					TextureSurface surface;
-					TextureType texture;
-					params->getLoadStoreTexture(*materialParamInfo, texture, surface);
+			paramPtr->setSamplerState(paramInfo.setIdx, paramInfo.slotIdx, samplerState);
+		}
+			break;
+		default:
+			break;
+		}
+	}
 
-					paramPtr->setLoadStoreTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
-				}
+	template<bool Core>
+	void TGpuParamsSet<Core>::update(const SPtr<MaterialParamsType>& params, float t, bool updateAll)
+	{
+		const UINT64 paramVersion = params->getParamVersion();
 
-				for (UINT32 k = 0; k < stageInfo.numBuffers; k++)
+		// If the material parameters can tell us exactly which parameters changed since the last update, only visit
+		// those, plus the animated parameters which need to be re-evaluated every time. Otherwise fall through to the full
+		// update below, which also rebuilds the list of animated parameters.
+		if(!updateAll && params->isDirtyRingValid(mParamVersion))
+		{
+			params->forEachDirtyParam(mParamVersion, false, [&](UINT32 paramIdx)
+			{
+				const UINT32 bindingStart = mParamBindingOffsets[paramIdx];
+				const UINT32 bindingEnd = mParamBindingOffsets[paramIdx + 1];
+				for(UINT32 i = bindingStart; i < bindingEnd; i++)
 				{
-					const ObjectParamInfo& paramInfo = stageInfo.buffers[k];
-
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
+					const ParamBinding& binding = mParamBindings[i];
+					if(binding.type != ParamBindingType::Data)
+					{
+						updateObjectParam(binding, params);
 						continue;
+					}
 
-					BufferType buffer;
-					params->getBuffer(*materialParamInfo, buffer);
+					// Parameter might have had a curve or a gradient assigned or removed
+					const bool isAnimated = isDataParamAnimated(mDataParamInfos[binding.entryIdx], params);
+					auto iterFind = std::find(mAnimatedDataParams.begin(), mAnimatedDataParams.end(), binding.entryIdx);
+					if(isAnimated)
+					{
+						if(iterFind == mAnimatedDataParams.end())
+							mAnimatedDataParams.push_back(binding.entryIdx);
+					}
+					else
+					{
+						if(iterFind != mAnimatedDataParams.end())
+							mAnimatedDataParams.erase(iterFind);
 
-					paramPtr->setBuffer(paramInfo.setIdx, paramInfo.slotIdx, buffer);
+						updateDataParam(mDataParamInfos[binding.entryIdx], params, t, false);
+					}
 				}
+			});
 
-				for (UINT32 k = 0; k < stageInfo.numSamplerStates; k++)
-				{
-					const ObjectParamInfo& paramInfo = stageInfo.samplerStates[k];
+			for(auto& entry : mAnimatedDataParams)
+				updateDataParam(mDataParamInfos[entry], params, t, true);
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
-						continue;
+			mParamVersion = paramVersion;
+			return;
+		}
 
-					SamplerStateType samplerState;
-					params->getSamplerState(*materialParamInfo, samplerState);
+		// Update data params
+		mAnimatedDataParams.clear();
+		for(UINT32 i = 0; i < (UINT32)mDataParamInfos.size(); i++)
+		{
+			const DataParamInfo& paramInfo = mDataParamInfos[i];
+			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+			
+			const bool isAnimated = isDataParamAnimated(paramInfo, params);
+			if(isAnimated)
+				mAnimatedDataParams.push_back(i);
 
-					paramPtr->setSamplerState(paramInfo.setIdx, paramInfo.slotIdx, samplerState);
-				}
+			if (materialParamInfo->version <= mParamVersion && !updateAll && !isAnimated)
+				continue;
+
+			updateDataParam(paramInfo, params, t, isAnimated);
+		}
+
+		// Update object params
+		const auto numPasses = (UINT32)mPassParams.size();
+
+		for(UINT32 i = 0; i < numPasses; i++)
+		{
+			for(UINT32 j = 0; j < NUM_STAGES; j++)
+			{
+				const StageParamInfo& stageInfo = mPassParamInfos[i].stages[j];
+
+				auto updateObjectParams = [&](ParamBindingType type, const ObjectParamInfo* paramInfos, UINT32 numParams)
+				{
+					for(UINT32 k = 0; k < numParams; k++)
+					{
+						const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfos[k].paramIdx);
+						if (materialParamInfo->version <= mParamVersion && !updateAll)
+							continue;
+
+						updateObjectParam({ type, i, j, k }, params);
+					}
+				};
+
+				updateObjectParams(ParamBindingType::Texture, stageInfo.textures, stageInfo.numTextures);
+				updateObjectParams(ParamBindingType::LoadStoreTexture, stageInfo.loadStoreTextures, 
+					stageInfo.numLoadStoreTextures);
+				updateObjectParams(ParamBindingType::Buffer, stageInfo.buffers, stageInfo.numBuffers);
+				updateObjectParams(ParamBindingType::SamplerState, stageInfo.samplerStates, stageInfo.numSamplerStates);
 			}
 
-			paramPtr->_markCoreDirty();
+			mPassParams[i]->_markCoreDirty();
 		}
 
-		mParamVersion = params->getParamVersion();
+		mParamVersion = paramVersion;
 	}
 
 	template class TGpuParamsSet <false>;
@@ -102,6 +102,26 @@ namespace bs
 			StageParamInfo stages[GPT_COUNT];
 		};
 
+		/** Types of locations a material parameter can be bound to. */
+		enum class ParamBindingType
+		{
+			Data, Texture, LoadStoreTexture, Buffer, SamplerState
+		};
+
+		/** Single location a material parameter is bound to. */
+		struct ParamBinding
+		{
+			ParamBindingType type;
+			UINT32 passIdx;
+			UINT32 stageIdx;
+
+			/** 
+			 * Index into mDataParamInfos for data parameters, or index into the relevant StageParamInfo array for object 
+			 * parameters. 
+			 */
+			UINT32 entryIdx;
+		};
+
 	public:
 		TGpuParamsSet() {}
 		TGpuParamsSet(const SPtr<TechniqueType>& technique, const ShaderType& shader,
@@ -174,11 +194,25 @@ namespace bs
 	private:
 		template<bool Core2> friend class TMaterial;
 
+		/** Checks if any array entry of the material parameter referenced by the data parameter is animated. */
+		bool isDataParamAnimated(const DataParamInfo& paramInfo, const SPtr<MaterialParamsType>& params);
+
+		/** Writes the value of a data parameter from the material parameters into its parameter block buffer. */
+		void updateDataParam(const DataParamInfo& paramInfo, const SPtr<MaterialParamsType>& params, float t, 
+			bool isAnimated);
+
+		/** Assigns the value of an object parameter from the material parameters to the relevant pass GpuParams. */
+		void updateObjectParam(const ParamBinding& binding, const SPtr<MaterialParamsType>& params);
+
 		Vector<SPtr<GpuParamsType>> mPassParams;
 		Vector<BlockInfo> mBlocks;
 		Vector<DataParamInfo> mDataParamInfos;
 		PassParamInfo* mPassParamInfos;
 
+		Vector<UINT32> mParamBindingOffsets;
+		Vector<ParamBinding> mParamBindings;
+		Vector<UINT32> mAnimatedDataParams;
+
 		UINT64 mParamVersion;
 		UINT8* mData;
 	};
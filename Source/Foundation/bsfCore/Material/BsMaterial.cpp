@@ -15,6 +15,7 @@
 #include "Material/BsMaterialParams.h"
 #include "Material/BsGpuParamsSet.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Image/BsColorGradient.h"
 
 namespace bs
 {
@@ -373,6 +374,135 @@ namespace bs
 		output = TMaterialDataParam<T, Core>(name, getMaterialPtr(this));
 	}
 
+	template<bool Core>
+	template <typename T>
+	void TMaterial<Core>::setHandleParam(const MaterialParamHandle<T>& handle, const T& value, UINT32 arrayIdx)
+	{
+		throwIfNotInitialized();
+
+		mParams->setDataParam(handle, arrayIdx, value);
+		_markCoreDirty();
+	}
+
+	template<bool Core>
+	template <typename T>
+	T TMaterial<Core>::getHandleParam(const MaterialParamHandle<T>& handle, UINT32 arrayIdx) const
+	{
+		throwIfNotInitialized();
+
+		T output{};
+		mParams->getDataParam(handle, arrayIdx, output);
+		return output;
+	}
+
+	template<bool Core>
+	const MaterialParams::ParamData* TMaterial<Core>::getHandleObjectParam(const MaterialParamHandleBase& handle, 
+		MaterialParams::ParamType type) const
+	{
+		throwIfNotInitialized();
+
+		UINT32 paramIdx;
+		auto result = mParams->getParamIndex(handle, type, GPDT_UNKNOWN, 0, paramIdx);
+		if(result != MaterialParams::GetParamResult::Success)
+		{
+			mParams->reportGetParamError(result, handle.getName().c_str(), 0);
+			return nullptr;
+		}
+
+		return mParams->getParamData(paramIdx);
+	}
+
+	template<bool Core>
+	void TMaterial<Core>::setTexture(const MaterialParamHandle<Texture>& handle, const TextureType& value, 
+		const TextureSurface& surface)
+	{
+		const MaterialParams::ParamData* data = getHandleObjectParam(handle, MaterialParams::ParamType::Texture);
+		if(data == nullptr)
+			return;
+
+		// If there is a default value, assign that instead of null
+		TextureType newValue = value;
+		if (newValue == nullptr)
+			mParams->getDefaultTexture(*data, newValue);
+
+		mParams->setTexture(*data, newValue, surface);
+		_markCoreDirty();
+		_markDependenciesDirty();
+		_markResourcesDirty();
+	}
+
+	template<bool Core>
+	void TMaterial<Core>::setLoadStoreTexture(const MaterialParamHandle<Texture>& handle, const TextureType& value, 
+		const TextureSurface& surface)
+	{
+		const MaterialParams::ParamData* data = getHandleObjectParam(handle, MaterialParams::ParamType::Texture);
+		if(data == nullptr)
+			return;
+
+		mParams->setLoadStoreTexture(*data, value, surface);
+		_markCoreDirty();
+		_markDependenciesDirty();
+		_markResourcesDirty();
+	}
+
+	template<bool Core>
+	void TMaterial<Core>::setBuffer(const MaterialParamHandle<GpuBuffer>& handle, const BufferType& value)
+	{
+		const MaterialParams::ParamData* data = getHandleObjectParam(handle, MaterialParams::ParamType::Buffer);
+		if(data == nullptr)
+			return;
+
+		mParams->setBuffer(*data, value);
+		_markCoreDirty();
+		_markDependenciesDirty();
+	}
+
+	template<bool Core>
+	void TMaterial<Core>::setSamplerState(const MaterialParamHandle<SamplerState>& handle, 
+		const SamplerStateType& value)
+	{
+		const MaterialParams::ParamData* data = getHandleObjectParam(handle, MaterialParams::ParamType::Sampler);
+		if(data == nullptr)
+			return;
+
+		// If there is a default value, assign that instead of null
+		SamplerStateType newValue = value;
+		if (newValue == nullptr)
+			mParams->getDefaultSamplerState(*data, newValue);
+
+		mParams->setSamplerState(*data, newValue);
+		_markCoreDirty();
+		_markDependenciesDirty();
+	}
+
+	template<bool Core>
+	typename TMaterial<Core>::TextureType TMaterial<Core>::getTexture(const MaterialParamHandle<Texture>& handle) const
+	{
+		TextureType texture;
+
+		const MaterialParams::ParamData* data = getHandleObjectParam(handle, MaterialParams::ParamType::Texture);
+		if(data == nullptr)
+			return texture;
+
+		TextureSurface surface;
+		mParams->getTexture(*data, texture, surface);
+		return texture;
+	}
+
+	template<bool Core>
+	typename TMaterial<Core>::SamplerStateType TMaterial<Core>::getSamplerState(
+		const MaterialParamHandle<SamplerState>& handle) const
+	{
+		SamplerStateType samplerState;
+
+		const MaterialParams::ParamData* data = getHandleObjectParam(handle, MaterialParams::ParamType::Sampler);
+		if(data == nullptr)
+			return samplerState;
+
+		mParams->getSamplerState(*data, samplerState);
+		return samplerState;
+	}
+
 	template<bool Core>
 	void TMaterial<Core>::throwIfNotInitialized() const
 	{
@@ -428,6 +558,36 @@ namespace bs
 	template BS_CORE_EXPORT void TMaterial<true>::getParam(const String&, TMaterialDataParam<Matrix4x2, true>&) const;
 	template BS_CORE_EXPORT void TMaterial<true>::getParam(const String&, TMaterialDataParam<Matrix4x3, true>&) const;
 
+	template BS_CORE_EXPORT void TMaterial<false>::setHandleParam(const MaterialParamHandle<float>&, const float&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<false>::setHandleParam(const MaterialParamHandle<Color>&, const Color&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<false>::setHandleParam(const MaterialParamHandle<Vector2>&, const Vector2&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<false>::setHandleParam(const MaterialParamHandle<Vector3>&, const Vector3&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<false>::setHandleParam(const MaterialParamHandle<Vector4>&, const Vector4&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<false>::setHandleParam(const MaterialParamHandle<Matrix3>&, const Matrix3&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<false>::setHandleParam(const MaterialParamHandle<Matrix4>&, const Matrix4&, UINT32);
+	template BS_CORE_EXPORT float TMaterial<false>::getHandleParam(const MaterialParamHandle<float>&, UINT32) const;
+	template BS_CORE_EXPORT Color TMaterial<false>::getHandleParam(const MaterialParamHandle<Color>&, UINT32) const;
+	template BS_CORE_EXPORT Vector2 TMaterial<false>::getHandleParam(const MaterialParamHandle<Vector2>&, UINT32) const;
+	template BS_CORE_EXPORT Vector3 TMaterial<false>::getHandleParam(const MaterialParamHandle<Vector3>&, UINT32) const;
+	template BS_CORE_EXPORT Vector4 TMaterial<false>::getHandleParam(const MaterialParamHandle<Vector4>&, UINT32) const;
+	template BS_CORE_EXPORT Matrix3 TMaterial<false>::getHandleParam(const MaterialParamHandle<Matrix3>&, UINT32) const;
+	template BS_CORE_EXPORT Matrix4 TMaterial<false>::getHandleParam(const MaterialParamHandle<Matrix4>&, UINT32) const;
+
+	template BS_CORE_EXPORT void TMaterial<true>::setHandleParam(const MaterialParamHandle<float>&, const float&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<true>::setHandleParam(const MaterialParamHandle<Color>&, const Color&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<true>::setHandleParam(const MaterialParamHandle<Vector2>&, const Vector2&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<true>::setHandleParam(const MaterialParamHandle<Vector3>&, const Vector3&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<true>::setHandleParam(const MaterialParamHandle<Vector4>&, const Vector4&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<true>::setHandleParam(const MaterialParamHandle<Matrix3>&, const Matrix3&, UINT32);
+	template BS_CORE_EXPORT void TMaterial<true>::setHandleParam(const MaterialParamHandle<Matrix4>&, const Matrix4&, UINT32);
+	template BS_CORE_EXPORT float TMaterial<true>::getHandleParam(const MaterialParamHandle<float>&, UINT32) const;
+	template BS_CORE_EXPORT Color TMaterial<true>::getHandleParam(const MaterialParamHandle<Color>&, UINT32) const;
+	template BS_CORE_EXPORT Vector2 TMaterial<true>::getHandleParam(const MaterialParamHandle<Vector2>&, UINT32) const;
+	template BS_CORE_EXPORT Vector3 TMaterial<true>::getHandleParam(const MaterialParamHandle<Vector3>&, UINT32) const;
+	template BS_CORE_EXPORT Vector4 TMaterial<true>::getHandleParam(const MaterialParamHandle<Vector4>&, UINT32) const;
+	template BS_CORE_EXPORT Matrix3 TMaterial<true>::getHandleParam(const MaterialParamHandle<Matrix3>&, UINT32) const;
+	template BS_CORE_EXPORT Matrix4 TMaterial<true>::getHandleParam(const MaterialParamHandle<Matrix4>&, UINT32) const;
+
 	Material::Material()
 		:mLoadFlags(Load_None)
 	{ }
@@ -430,6 +430,91 @@ namespace bs
 			return data;
 		}
 
+		/** 
+		 * Assigns a float value to the shader parameter referenced by the handle. Handle based setters avoid string 
+		 * lookups and remain valid if the material shader changes, making them preferable for frequently updated 
+		 * parameters.
+		 *
+		 * Optionally if the parameter is an array you may provide an array index to assign the value to.
+		 */
+		void setFloat(const MaterialParamHandle<float>& handle, float value, UINT32 arrayIdx = 0)
+		{ setHandleParam(handle, value, arrayIdx); }
+
+		/** Assigns a color to the shader parameter referenced by the handle. @see setFloat(const MaterialParamHandle<float>&, float, UINT32) */
+		void setColor(const MaterialParamHandle<Color>& handle, const Color& value, UINT32 arrayIdx = 0)
+		{ setHandleParam(handle, value, arrayIdx); }
+
+		/** Assigns a 2D vector to the shader parameter referenced by the handle. @see setFloat(const MaterialParamHandle<float>&, float, UINT32) */
+		void setVec2(const MaterialParamHandle<Vector2>& handle, const Vector2& value, UINT32 arrayIdx = 0)
+		{ setHandleParam(handle, value, arrayIdx); }
+
+		/** Assigns a 3D vector to the shader parameter referenced by the handle. @see setFloat(const MaterialParamHandle<float>&, float, UINT32) */
+		void setVec3(const MaterialParamHandle<Vector3>& handle, const Vector3& value, UINT32 arrayIdx = 0)
+		{ setHandleParam(handle, value, arrayIdx); }
+
+		/** Assigns a 4D vector to the shader parameter referenced by the handle. @see setFloat(const MaterialParamHandle<float>&, float, UINT32) */
+		void setVec4(const MaterialParamHandle<Vector4>& handle, const Vector4& value, UINT32 arrayIdx = 0)
+		{ setHandleParam(handle, value, arrayIdx); }
+
+		/** Assigns a 3x3 matrix to the shader parameter referenced by the handle. @see setFloat(const MaterialParamHandle<float>&, float, UINT32) */
+		void setMat3(const MaterialParamHandle<Matrix3>& handle, const Matrix3& value, UINT32 arrayIdx = 0)
+		{ setHandleParam(handle, value, arrayIdx); }
+
+		/** Assigns a 4x4 matrix to the shader parameter referenced by the handle. @see setFloat(const MaterialParamHandle<float>&, float, UINT32) */
+		void setMat4(const MaterialParamHandle<Matrix4>& handle, const Matrix4& value, UINT32 arrayIdx = 0)
+		{ setHandleParam(handle, value, arrayIdx); }
+
+		/** Assigns a texture to the shader parameter referenced by the handle. */
+		void setTexture(const MaterialParamHandle<Texture>& handle, const TextureType& value, 
+			const TextureSurface& surface = TextureSurface::COMPLETE);
+
+		/** 
+		 * Assigns a texture to be used for random load/store operations to the shader parameter referenced by the 
+		 * handle. 
+		 */
+		void setLoadStoreTexture(const MaterialParamHandle<Texture>& handle, const TextureType& value, 
+			const TextureSurface& surface);
+
+		/** Assigns a buffer to the shader parameter referenced by the handle. */
+		void setBuffer(const MaterialParamHandle<GpuBuffer>& handle, const BufferType& value);
+
+		/** Assigns a sampler state to the shader parameter referenced by the handle. */
+		void setSamplerState(const MaterialParamHandle<SamplerState>& handle, const SamplerStateType& value);
+
+		/** Returns a float value assigned to the parameter referenced by the handle. */
+		float getFloat(const MaterialParamHandle<float>& handle, UINT32 arrayIdx = 0) const 
+		{ return getHandleParam(handle, arrayIdx); }
+
+		/** Returns a color assigned to the parameter referenced by the handle. */
+		Color getColor(const MaterialParamHandle<Color>& handle, UINT32 arrayIdx = 0) const 
+		{ return getHandleParam(handle, arrayIdx); }
+
+		/** Returns a 2D vector assigned to the parameter referenced by the handle. */
+		Vector2 getVec2(const MaterialParamHandle<Vector2>& handle, UINT32 arrayIdx = 0) const 
+		{ return getHandleParam(handle, arrayIdx); }
+
+		/** Returns a 3D vector assigned to the parameter referenced by the handle. */
+		Vector3 getVec3(const MaterialParamHandle<Vector3>& handle, UINT32 arrayIdx = 0) const 
+		{ return getHandleParam(handle, arrayIdx); }
+
+		/** Returns a 4D vector assigned to the parameter referenced by the handle. */
+		Vector4 getVec4(const MaterialParamHandle<Vector4>& handle, UINT32 arrayIdx = 0) const 
+		{ return getHandleParam(handle, arrayIdx); }
+
+		/** Returns a 3x3 matrix assigned to the parameter referenced by the handle. */
+		Matrix3 getMat3(const MaterialParamHandle<Matrix3>& handle, UINT32 arrayIdx = 0) const 
+		{ return getHandleParam(handle, arrayIdx); }
+
+		/** Returns a 4x4 matrix assigned to the parameter referenced by the handle. */
+		Matrix4 getMat4(const MaterialParamHandle<Matrix4>& handle, UINT32 arrayIdx = 0) const 
+		{ return getHandleParam(handle, arrayIdx); }
+
+		/** Returns a texture assigned to the parameter referenced by the handle. */
+		TextureType getTexture(const MaterialParamHandle<Texture>& handle) const;
+
+		/** Returns a sampler state assigned to the parameter referenced by the handle. */
+		SamplerStateType getSamplerState(const MaterialParamHandle<SamplerState>& handle) const;
+
 		/**
 		 * Returns a handle that allows you to assign a constant value to a floating point parameter. This handle 
 		 * may be used for more efficiently getting/setting GPU parameter values than calling 
@@ -694,6 +779,21 @@ namespace bs
 		template <typename T>
 		void setParamValue(const String& name, UINT8* buffer, UINT32 numElements);
 
+		/** Assigns a value to the data parameter referenced by the handle. */
+		template <typename T>
+		void setHandleParam(const MaterialParamHandle<T>& handle, const T& value, UINT32 arrayIdx);
+
+		/** Returns the value of the data parameter referenced by the handle. */
+		template <typename T>
+		T getHandleParam(const MaterialParamHandle<T>& handle, UINT32 arrayIdx) const;
+
+		/** 
+		 * Resolves an object parameter referenced by the handle. Logs an error and returns null if the parameter doesn't
+		 * exist or is not of the provided type.
+		 */
+		const MaterialParams::ParamData* getHandleObjectParam(const MaterialParamHandleBase& handle, 
+			MaterialParams::ParamType type) const;
+
 		/**
 		 * Initializes the material by using the compatible techniques from the currently set shader. Shader must contain 
 		 * the techniques that matches the current renderer and render system. Only the techniques matching the provided
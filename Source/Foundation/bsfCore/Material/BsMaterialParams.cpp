@@ -13,13 +13,19 @@
 
 namespace bs
 {
+	std::atomic<UINT64> MaterialParamsBase::mNextUniqueLayoutId { FIRST_UNIQUE_LAYOUT_ID };
+
 	MaterialParamsBase::MaterialParamsBase(
 		const Map<String, SHADER_DATA_PARAM_DESC>& dataParams,
 		const Map<String, SHADER_OBJECT_PARAM_DESC>& textureParams,
 		const Map<String, SHADER_OBJECT_PARAM_DESC>& bufferParams,
-		const Map<String, SHADER_OBJECT_PARAM_DESC>& samplerParams
+		const Map<String, SHADER_OBJECT_PARAM_DESC>& samplerParams,
+		UINT64 layoutId
 	)
+		:mLayoutId(layoutId)
 	{
+		assert(layoutId != 0 && layoutId < FIRST_UNIQUE_LAYOUT_ID);
+
 		mDataSize = 0;
 
 		for (auto& param : dataParams)
@@ -53,6 +59,7 @@ namespace bs
 			const auto paramIdx = (UINT32)mParams.size();
 			mParams.push_back(ParamData());
 			mParamLookup[entry.first] = paramIdx;
+			registerParamHash(entry.first, paramIdx);
 
 			ParamData& dataParam = mParams.back();
 
@@ -81,6 +88,7 @@ namespace bs
 			UINT32 paramIdx = (UINT32)mParams.size();
 			mParams.push_back(ParamData());
 			mParamLookup[entry.first] = paramIdx;
+			registerParamHash(entry.first, paramIdx);
 
 			ParamData& dataParam = mParams.back();
 
@@ -99,6 +107,7 @@ namespace bs
 			UINT32 paramIdx = (UINT32)mParams.size();
 			mParams.push_back(ParamData());
 			mParamLookup[entry.first] = paramIdx;
+			registerParamHash(entry.first, paramIdx);
 
 			ParamData& dataParam = mParams.back();
 
@@ -117,6 +126,7 @@ namespace bs
 			UINT32 paramIdx = (UINT32)mParams.size();
 			mParams.push_back(ParamData());
 			mParamLookup[entry.first] = paramIdx;
+			registerParamHash(entry.first, paramIdx);
 
 			ParamData& dataParam = mParams.back();
 
@@ -195,7 +205,55 @@ namespace bs
 
 		paramInfo.colorGradient = bs_pool_new<ColorGradient>(input);
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
+	}
+
+	bool MaterialParamsBase::resolveHandle(const MaterialParamHandleBase& handle) const
+	{
+		auto iterFind = mParamHashLookup.find(handle.getNameHash());
+		if (iterFind == mParamHashLookup.end())
+			return false;
+
+		const ParamHashEntry& entry = iterFind->second;
+
+		UINT32 paramIdx;
+		if(entry.paramIdx != (UINT32)-1)
+		{
+			// Different name with the same hash as an existing parameter
+			if(entry.name != handle.getName().c_str())
+				return false;
+
+			paramIdx = entry.paramIdx;
+		}
+		else
+		{
+			// Multiple parameters with the same hash, fall back to the name lookup
+			auto iterFindName = mParamLookup.find(handle.getName().c_str());
+			if(iterFindName == mParamLookup.end())
+				return false;
+
+			paramIdx = iterFindName->second;
+		}
+
+		handle.mCachedParamIdx = paramIdx;
+		handle.mCachedLayoutId = mLayoutId;
+
+		return true;
+	}
+
+	void MaterialParamsBase::registerParamHash(const String& name, UINT32 paramIdx)
+	{
+		const UINT32 hash = MaterialParamHandleBase::hashName(name.c_str());
+
+		auto result = mParamHashLookup.insert(std::make_pair(hash, ParamHashEntry { name, paramIdx }));
+		if(!result.second)
+		{
+			ParamHashEntry& entry = result.first->second;
+			if(entry.name != name)
+				entry.paramIdx = (UINT32)-1;
+			else if(entry.paramIdx != (UINT32)-1)
+				entry.paramIdx = paramIdx;
+		}
 	}
 
 	UINT32 MaterialParamsBase::getParamIndex(const String& name) const
@@ -291,7 +349,8 @@ namespace bs
 			shader->getDataParams(),
 			shader->getTextureParams(),
 			shader->getBufferParams(),
-			shader->getSamplerParams()
+			shader->getSamplerParams(),
+			(UINT64)shader->getId() + 1 // Zero is reserved for unresolved handles
 		)
 	{
 		mStructParams = mAlloc.construct<ParamStructDataType>(mNumStructParams);
@@ -584,7 +643,7 @@ namespace bs
 		}
 
 		memcpy(structParam.data, value, structParam.dataSize);
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -616,7 +675,7 @@ namespace bs
 		textureParam.isLoadStore = false;
 		textureParam.surface = surface;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -635,7 +694,7 @@ namespace bs
 		textureParam.isLoadStore = false;
 		textureParam.surface = TextureSurface::COMPLETE;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -649,7 +708,7 @@ namespace bs
 	{
 		mBufferParams[param.index].value = value;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -669,7 +728,7 @@ namespace bs
 		textureParam.isLoadStore = true;
 		textureParam.surface = surface;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -683,7 +742,7 @@ namespace bs
 	{
 		mSamplerStateParams[param.index].value = value;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -751,11 +810,9 @@ namespace bs
 		UINT32 numDirtySamplerParams = 0;
 
 		UINT32 dataParamSize = 0;
-		for(auto& param : mParams)
+		forEachDirtyParam(mLastSyncVersion, forceAll, [&](UINT32 i)
 		{
-			if (param.version <= mLastSyncVersion && !forceAll)
-				continue;
-
+			const ParamData& param = mParams[i];
 			switch(param.type)
 			{
 			case ParamType::Data:
@@ -806,7 +863,7 @@ namespace bs
 				numDirtySamplerParams++;
 				break;
 			}
-		}
+		});
 
 		const UINT32 textureEntrySize = sizeof(MaterialParamTextureDataCore) + sizeof(UINT32);
 		const UINT32 bufferEntrySize = sizeof(MaterialParamBufferDataCore) + sizeof(UINT32);
@@ -844,12 +901,9 @@ namespace bs
 		UINT32 dirtyBufferParamIdx = 0;
 		UINT32 dirtySamplerParamIdx = 0;
 
-		for(UINT32 i = 0; i < (UINT32)mParams.size(); i++)
+		forEachDirtyParam(mLastSyncVersion, forceAll, [&](UINT32 i)
 		{
-			ParamData& param = mParams[i];
-			if (param.version <= mLastSyncVersion && !forceAll)
-				continue;
-
+			const ParamData& param = mParams[i];
 			switch (param.type)
 			{
 			case ParamType::Data:
@@ -958,7 +1012,7 @@ namespace bs
 			}
 				break;
 			}
-		}
+		});
 
 		mLastSyncVersion = mParamVersion;
 	}
@@ -1123,8 +1177,6 @@ namespace bs
 		sourceData = rttiReadElem(numDirtyBufferParams, sourceData);
 		sourceData = rttiReadElem(numDirtySamplerParams, sourceData);
 
-		mParamVersion++;
-
 		for(UINT32 i = 0; i < numDirtyDataParams; i++)
 		{
 			// Param index
@@ -1132,7 +1184,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			const UINT32 arraySize = param.arraySize > 1 ? param.arraySize : 1;
 			const GpuParamDataTypeInfo& typeInfo = bs::GpuParams::PARAM_SIZES.lookup[(int)param.dataType];
@@ -1181,7 +1233,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			MaterialParamTextureDataCore* sourceTexData = (MaterialParamTextureDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamTextureDataCore);
@@ -1196,7 +1248,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			MaterialParamBufferDataCore* sourceBufferData = (MaterialParamBufferDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamBufferDataCore);
@@ -1211,7 +1263,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			MaterialParamSamplerStateDataCore* sourceSamplerStateData = (MaterialParamSamplerStateDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamSamplerStateDataCore);
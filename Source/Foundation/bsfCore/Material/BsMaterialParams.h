@@ -15,6 +15,101 @@ namespace bs
 	class TAnimationCurve;
 	class ColorGradient;
 
+	/** @addtogroup Material
+	 *  @{
+	 */
+
+	/** Common functionality for all MaterialParamHandle types. */
+	class BS_CORE_EXPORT MaterialParamHandleBase
+	{
+	public:
+		MaterialParamHandleBase() = default;
+
+		/** Creates a handle referencing a parameter with the specified name. */
+		explicit MaterialParamHandleBase(const char* name)
+			:mName(name), mNameHash(hashName(name))
+		{ }
+
+		/** Creates a handle referencing a parameter with the specified name. */
+		explicit MaterialParamHandleBase(const String& name)
+			:mName(name), mNameHash(hashName(name.c_str()))
+		{ }
+
+		/** Creates a handle referencing a parameter with the specified name. */
+		explicit MaterialParamHandleBase(const StringID& name)
+			:mName(name), mNameHash(hashName(name.c_str()))
+		{ }
+
+		/** Returns the name of the parameter referenced by the handle. */
+		const StringID& getName() const { return mName; }
+
+		/** Returns the hash of the parameter name, as calculated by hashName(). */
+		UINT32 getNameHash() const { return mNameHash; }
+
+		/** Calculates a hash of a parameter name (32-bit FNV-1a). Evaluated at compile time for constant input. */
+		static constexpr UINT32 hashName(const char* name)
+		{
+			UINT32 hash = 2166136261u;
+			while(*name != '\0')
+			{
+				hash ^= (UINT8)*name++;
+				hash *= 16777619u;
+			}
+
+			return hash;
+		}
+
+	private:
+		friend class MaterialParamsBase;
+
+		StringID mName;
+		UINT32 mNameHash = 0;
+
+		mutable UINT32 mCachedParamIdx = (UINT32)-1;
+		mutable UINT64 mCachedLayoutId = 0;
+	};
+
+	/**
+	 * Handle to a material parameter of type @p T, that can be used for setting or retrieving material parameters without
+	 * performing string lookups. The handle is resolved using a hash of the parameter name and caches the parameter index
+	 * for the last parameter layout (i.e. shader) it was used with. Unlike TMaterialDataParam the handle is not bound to a
+	 * specific material, and it remains valid if material shader or shader variation changes, as well as when used with
+	 * different materials.
+	 *
+	 * For texture parameters (normal or load-store) use MaterialParamHandle<Texture>, for buffer parameters
+	 * MaterialParamHandle<GpuBuffer> and for sampler state parameters MaterialParamHandle<SamplerState>.
+	 *
+	 * @note	
+	 * The handle keeps its own copy of the name, so it may be created from a temporary string. Creating a handle is
+	 * relatively expensive, so handles should be created once (e.g. as static variables) and reused.
+	 * @note
+	 * The handle modifies its internal cache when used, therefore a single handle shouldn't be used from multiple threads 
+	 * at once.
+	 */
+	template<class T>
+	class MaterialParamHandle : public MaterialParamHandleBase
+	{
+	public:
+		MaterialParamHandle() = default;
+
+		/** @copydoc MaterialParamHandleBase::MaterialParamHandleBase(const char*) */
+		explicit MaterialParamHandle(const char* name)
+			:MaterialParamHandleBase(name)
+		{ }
+
+		/** @copydoc MaterialParamHandleBase::MaterialParamHandleBase(const String&) */
+		explicit MaterialParamHandle(const String& name)
+			:MaterialParamHandleBase(name)
+		{ }
+
+		/** @copydoc MaterialParamHandleBase::MaterialParamHandleBase(const StringID&) */
+		explicit MaterialParamHandle(const StringID& name)
+			:MaterialParamHandleBase(name)
+		{ }
+	};
+
+	/** @} */
+
 	/** @addtogroup Material-Internal
 	 *  @{
 	 */
@@ -75,12 +170,23 @@ namespace bs
 
 		/** 
 		 * Creates a new material params object and initializes enough room for parameters from the provided parameter data.
+		 *
+		 * @param[in]	dataParams		Data parameters to create.
+		 * @param[in]	textureParams	Texture parameters to create.
+		 * @param[in]	bufferParams	Buffer parameters to create.
+		 * @param[in]	samplerParams	Sampler parameters to create.
+		 * @param[in]	layoutId		Identifier of the parameter layout. All objects created from the same parameter
+		 *								descriptions must use the same identifier (e.g. the ID of the shader they were
+		 *								created from), so handles resolved by one of them can be used with all of them
+		 *								without being resolved again. Must be non-zero and less than
+		 *								FIRST_UNIQUE_LAYOUT_ID.
 		 */
 		MaterialParamsBase(
 			const Map<String, SHADER_DATA_PARAM_DESC>& dataParams, 
 			const Map<String, SHADER_OBJECT_PARAM_DESC>& textureParams,
 			const Map<String, SHADER_OBJECT_PARAM_DESC>& bufferParams,
-			const Map<String, SHADER_OBJECT_PARAM_DESC>& samplerParams
+			const Map<String, SHADER_OBJECT_PARAM_DESC>& samplerParams,
+			UINT64 layoutId
 		);
 
 		/** Constructor for serialization use only. */
@@ -272,6 +378,78 @@ namespace bs
 		 */
 		void reportGetParamError(GetParamResult errorCode, const String& name, UINT32 arrayIdx) const;
 
+		/**
+		 * Returns an index of the parameter referenced by the provided handle. Index can be used in a call to 
+		 * getParamData(UINT32) to get the actual parameter data. The resolved index is cached in the handle, so subsequent
+		 * calls using the same handle and the same object don't perform any lookups.
+		 *
+		 * @param[in]	handle		Handle referencing the parameter.
+		 * @param[in]	type		Type of the parameter retrieve. Error will be logged if actual type of the parameter
+		 *							doesn't match.
+		 * @param[in]	dataType	Only relevant if the parameter is a data type. Determines exact data type of the parameter
+		 *							to retrieve.
+		 * @param[in]	arrayIdx	Array index of the entry to retrieve.
+		 * @param[out]	output		Index of the requested parameter, only valid if success is returned.
+		 * @return					Success or error state of the request.
+		 */
+		GetParamResult getParamIndex(const MaterialParamHandleBase& handle, ParamType type, GpuParamDataType dataType, 
+			UINT32 arrayIdx, UINT32& output) const
+		{
+			if(handle.mCachedLayoutId != mLayoutId)
+			{
+				if(!resolveHandle(handle))
+					return GetParamResult::NotFound;
+			}
+
+			const ParamData& param = mParams[handle.mCachedParamIdx];
+			if (param.type != type || (type == ParamType::Data && param.dataType != dataType))
+				return GetParamResult::InvalidType;
+
+			if (arrayIdx >= param.arraySize)
+				return GetParamResult::IndexOutOfBounds;
+
+			output = handle.mCachedParamIdx;
+			return GetParamResult::Success;
+		}
+
+		/**
+		 * Equivalent to getDataParam(const String&, UINT32, T&) except it uses a parameter handle, avoiding the name 
+		 * lookup.
+		 */
+		template <typename T>
+		void getDataParam(const MaterialParamHandle<T>& handle, UINT32 arrayIdx, T& output) const
+		{
+			UINT32 paramIdx;
+			auto result = getParamIndex(handle, ParamType::Data, (GpuParamDataType)TGpuDataParamInfo<T>::TypeId, arrayIdx,
+				paramIdx);
+			if (result != GetParamResult::Success)
+			{
+				reportGetParamError(result, handle.getName().c_str(), arrayIdx);
+				return;
+			}
+
+			getDataParam(mParams[paramIdx], arrayIdx, output);
+		}
+
+		/**
+		 * Equivalent to setDataParam(const String&, UINT32, const T&) except it uses a parameter handle, avoiding the name 
+		 * lookup.
+		 */
+		template <typename T>
+		void setDataParam(const MaterialParamHandle<T>& handle, UINT32 arrayIdx, const T& input) const
+		{
+			UINT32 paramIdx;
+			auto result = getParamIndex(handle, ParamType::Data, (GpuParamDataType)TGpuDataParamInfo<T>::TypeId, arrayIdx,
+				paramIdx);
+			if (result != GetParamResult::Success)
+			{
+				reportGetParamError(result, handle.getName().c_str(), arrayIdx);
+				return;
+			}
+
+			setDataParam(mParams[paramIdx], arrayIdx, input);
+		}
+
 		/**
 		 * Equivalent to getDataParam(const String&, UINT32, T&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
@@ -320,7 +498,7 @@ namespace bs
 			assert(sizeof(input) == paramTypeSize);
 			memcpy(&mDataParamsBuffer[paramInfo.offset], &input, paramTypeSize);
 
-			param.version = ++mParamVersion;
+			markParamDirty(param);
 		}
 
 		/**
@@ -364,7 +542,7 @@ namespace bs
 
 				paramInfo.floatCurve = bs_pool_new<TAnimationCurve<T>>(std::move(input));
 
-				param.version = ++mParamVersion;
+				markParamDirty(param);
 			}
 		}
 
@@ -391,10 +569,102 @@ namespace bs
 		/** Returns a counter that gets incremented whenever a parameter gets updated. */
 		UINT64 getParamVersion() const { return mParamVersion; }
 
+		/**
+		 * Checks if all parameters modified since the provided version can be enumerated through getDirtyParam(). If
+		 * false, the caller must fall back to checking the version of every parameter individually.
+		 */
+		bool isDirtyRingValid(UINT64 version) const
+		{
+			return version >= 1 && version <= mParamVersion && (mParamVersion - version) <= DIRTY_PARAM_RING_SIZE;
+		}
+
+		/**
+		 * Returns the index of the parameter that was modified when the parameter version was incremented to @p version.
+		 * Only valid for versions in range (lastVersion, getParamVersion()], where isDirtyRingValid(lastVersion) returned
+		 * true.
+		 *
+		 * @param[in]	version		Version at which the parameter was modified.
+		 * @param[out]	paramIdx	Global index of the modified parameter.
+		 * @return					False if the parameter has been modified again at a later version, in which case it
+		 *							will be reported again for that later version. Caller should ignore the parameter.
+		 */
+		bool getDirtyParam(UINT64 version, UINT32& paramIdx) const
+		{
+			paramIdx = mDirtyParams[version & (DIRTY_PARAM_RING_SIZE - 1)];
+			return mParams[paramIdx].version == version;
+		}
+
+		/**
+		 * Calls @p func with the global index of every parameter modified since @p lastVersion. Each parameter is
+		 * reported once, no matter how many times it was modified. Parameters are enumerated through the dirty parameter
+		 * ring if it covers the requested range, or by checking the version of every parameter otherwise.
+		 *
+		 * @param[in]	lastVersion		Parameter version at the time of the last update, as returned by
+		 *								getParamVersion().
+		 * @param[in]	forceAll		If true, all parameters will be reported, modified or not.
+		 * @param[in]	func			Callable with signature void(UINT32 paramIdx).
+		 */
+		template<class Func>
+		void forEachDirtyParam(UINT64 lastVersion, bool forceAll, Func func) const
+		{
+			if(!forceAll && isDirtyRingValid(lastVersion))
+			{
+				for(UINT64 version = lastVersion + 1; version <= mParamVersion; version++)
+				{
+					UINT32 paramIdx;
+					if(getDirtyParam(version, paramIdx))
+						func(paramIdx);
+				}
+			}
+			else
+			{
+				for(UINT32 i = 0; i < (UINT32)mParams.size(); i++)
+				{
+					if (mParams[i].version <= lastVersion && !forceAll)
+						continue;
+
+					func(i);
+				}
+			}
+		}
+
+		/** Maximum number of parameter modifications the dirty parameter ring buffer can track. Must be a power of two. */
+		static constexpr UINT32 DIRTY_PARAM_RING_SIZE = 64;
+
 	protected:
+		/** 
+		 * Looks up the parameter referenced by the handle using the name hash, and caches the parameter index in the 
+		 * handle. Returns false if the parameter cannot be found.
+		 */
+		bool resolveHandle(const MaterialParamHandleBase& handle) const;
+
+		/** 
+		 * Registers the hash of the parameter name, allowing the parameter to be looked up through a handle. Parameters
+		 * whose names have the same hash are still accessible through handles, but are resolved using a name lookup.
+		 */
+		void registerParamHash(const String& name, UINT32 paramIdx);
+
+		/**
+		 * Assigns a new version to the provided parameter and records its index in the dirty parameter ring buffer. Must
+		 * be called whenever parameter data changes.
+		 */
+		void markParamDirty(const ParamData& param) const
+		{
+			param.version = ++mParamVersion;
+			mDirtyParams[mParamVersion & (DIRTY_PARAM_RING_SIZE - 1)] = (UINT32)(&param - mParams.data());
+		}
+
+		/** Entry in the parameter name hash lookup table. */
+		struct ParamHashEntry
+		{
+			String name;
+			UINT32 paramIdx; /**< (UINT32)-1 if multiple parameter names have the same hash. */
+		};
+
 		const static UINT32 STATIC_BUFFER_SIZE = 256;
 
 		UnorderedMap<String, UINT32> mParamLookup;
+		UnorderedMap<UINT32, ParamHashEntry> mParamHashLookup;
 		Vector<ParamData> mParams;
 
 		DataParamInfo* mDataParams = nullptr;
@@ -408,7 +678,17 @@ namespace bs
 		UINT32 mNumSamplerParams = 0;
 
 		mutable UINT64 mParamVersion = 1;
+		mutable UINT32 mDirtyParams[DIRTY_PARAM_RING_SIZE] = {};
 		mutable StaticAlloc<STATIC_BUFFER_SIZE> mAlloc;
+
+		/** 
+		 * Layout identifiers starting with this value are assigned to objects that weren't created from a shader (e.g.
+		 * deserialized objects), and are unique per object.
+		 */
+		static constexpr UINT64 FIRST_UNIQUE_LAYOUT_ID = 1ULL << 32;
+
+		UINT64 mLayoutId = mNextUniqueLayoutId++;
+		static std::atomic<UINT64> mNextUniqueLayoutId;
 	};
 
 	/** Raw data for a single structure parameter. */
@@ -834,7 +1114,7 @@ namespace bs
 	private:
 		friend class ct::MaterialParams;
 
-		UINT64 mLastSyncVersion;
+		UINT64 mLastSyncVersion = 1;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
@@ -479,7 +479,7 @@ namespace bs
 	protected:
 		String mName;
 		TSHADER_DESC<Core> mDesc;
-		UINT32 mId;
+		UINT32 mId = 0;
 	};
 
 	/** @} */
@@ -39,6 +39,12 @@ namespace bs
 		 */
 		Vector<SubMesh> subMeshes;
 
+		/**
+		 * Optional lower levels of detail, ordered from the most to the least detailed. Each level must contain as many
+		 * sub-meshes as @p subMeshes, referencing indices in the same index buffer.
+		 */
+		Vector<MeshLOD> lods;
+
 		/** Optimizes performance depending on planned usage of the mesh. */
 		INT32 usage = MU_STATIC; 
 
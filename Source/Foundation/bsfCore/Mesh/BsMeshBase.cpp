@@ -3,6 +3,7 @@
 #include "Mesh/BsMeshBase.h"
 #include "Private/RTTI/BsMeshBaseRTTI.h"
 #include "CoreThread/BsCoreThread.h"
+#include "Debug/BsDebug.h"
 
 namespace bs
 {
@@ -40,6 +41,68 @@ namespace bs
 		return (UINT32)mSubMeshes.size();
 	}
 
+	const SubMesh& MeshProperties::getSubMesh(UINT32 subMeshIdx, UINT32 lodIdx) const
+	{
+		if (lodIdx == 0)
+			return getSubMesh(subMeshIdx);
+
+		if (lodIdx >= getNumLODs())
+		{
+			BS_EXCEPT(InvalidParametersException, "Invalid LOD index (" + toString(lodIdx) + "). Number of LODs "
+				"available: " + toString(getNumLODs()));
+		}
+
+		if (subMeshIdx >= mSubMeshes.size())
+		{
+			BS_EXCEPT(InvalidParametersException, "Invalid sub-mesh index ("
+				+ toString(subMeshIdx) + "). Number of sub-meshes available: " + toString((int)mSubMeshes.size()));
+		}
+
+		return mLODSubMeshes[(lodIdx - 1) * mSubMeshes.size() + subMeshIdx];
+	}
+
+	float MeshProperties::getLODScreenSize(UINT32 lodIdx) const
+	{
+		if (lodIdx == 0 || lodIdx >= getNumLODs())
+			return std::numeric_limits<float>::infinity();
+
+		return mLODScreenSizes[lodIdx - 1];
+	}
+
+	void MeshProperties::setLODs(const Vector<MeshLOD>& lods)
+	{
+		mLODSubMeshes.clear();
+		mLODScreenSizes.clear();
+
+		for (auto& lod : lods)
+		{
+			if (lod.subMeshes.size() != mSubMeshes.size())
+			{
+				LOGERR("Mesh LOD ignored because its number of sub-meshes (" + toString((UINT32)lod.subMeshes.size()) +
+					") doesn't match the full mesh (" + toString((UINT32)mSubMeshes.size()) + ").");
+				continue;
+			}
+
+			mLODSubMeshes.insert(mLODSubMeshes.end(), lod.subMeshes.begin(), lod.subMeshes.end());
+			mLODScreenSizes.push_back(lod.screenSize);
+		}
+	}
+
+	Vector<MeshLOD> MeshProperties::getLODs() const
+	{
+		const UINT32 numSubMeshes = getNumSubMeshes();
+
+		Vector<MeshLOD> lods(mLODScreenSizes.size());
+		for (UINT32 i = 0; i < (UINT32)lods.size(); i++)
+		{
+			auto iterStart = mLODSubMeshes.begin() + i * numSubMeshes;
+			lods[i].subMeshes.assign(iterStart, iterStart + numSubMeshes);
+			lods[i].screenSize = mLODScreenSizes[i];
+		}
+
+		return lods;
+	}
+
 	MeshBase::MeshBase(UINT32 numVertices, UINT32 numIndices, DrawOperationType drawOp)
 		:mProperties(numVertices, numIndices, drawOp)
 	{ }
@@ -48,6 +48,21 @@ namespace bs
 		/** Retrieves a total number of sub-meshes in this mesh. */
 		UINT32 getNumSubMeshes() const;
 
+		/**
+		 * Retrieves a sub-mesh to render at the specified level of detail. LOD 0 represents the full mesh and returns the
+		 * same sub-mesh as getSubMesh(UINT32).
+		 */
+		const SubMesh& getSubMesh(UINT32 subMeshIdx, UINT32 lodIdx) const;
+
+		/** Returns the number of levels of detail of the mesh, including the full mesh. Always at least one. */
+		UINT32 getNumLODs() const { return (UINT32)mLODScreenSizes.size() + 1; }
+
+		/** 
+		 * Returns the screen size below which the specified level of detail should be used. See MeshLOD::screenSize. LOD 0
+		 * is used at any size.
+		 */
+		float getLODScreenSize(UINT32 lodIdx) const;
+
 		/**	Returns maximum number of vertices the mesh may store. */
 		UINT32 getNumVertices() const { return mNumVertices; }
 
@@ -66,7 +81,15 @@ namespace bs
 		friend class ct::TransientMesh;
 		friend class MeshBaseRTTI;
 
+		/** Assigns lower levels of detail. Each level must contain the same number of sub-meshes as the full mesh. */
+		void setLODs(const Vector<MeshLOD>& lods);
+
+		/** Returns lower levels of detail in the same format accepted by setLODs(). */
+		Vector<MeshLOD> getLODs() const;
+
 		Vector<SubMesh> mSubMeshes;
+		Vector<SubMesh> mLODSubMeshes; // For LOD 1 and onwards, getNumSubMeshes() entries per LOD
+		Vector<float> mLODScreenSizes; // For LOD 1 and onwards
 		UINT32 mNumVertices;
 		UINT32 mNumIndices;
 		Bounds mBounds;
@@ -5,6 +5,9 @@
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
 #include "Math/BsPlane.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "RenderAPI/BsSubMesh.h"
 
 namespace bs
 {
@@ -934,4 +937,1078 @@ namespace bs
 			ptr += stride;
 		}
 	}
+
+	/** Reads a single index from an index buffer with the specified index size. */
+	static UINT32 readIndex(const UINT8* indices, UINT32 idx, UINT32 indexSize)
+	{
+		UINT32 value = 0;
+		memcpy(&value, indices + idx * indexSize, indexSize);
+
+		return value;
+	}
+
+	/** Writes a single index to an index buffer with the specified index size. */
+	static void writeIndex(UINT8* indices, UINT32 idx, UINT32 value, UINT32 indexSize)
+	{
+		memcpy(indices + idx * indexSize, &value, indexSize);
+	}
+
+	/** Size of the LRU cache modeled by the vertex cache optimizer. */
+	static constexpr UINT32 OPTIMIZER_CACHE_SIZE = 32;
+
+	/** 
+	 * Calculates the score of a vertex used by the vertex cache optimizer. Triangles with highest summed scores of their
+	 * vertices are output first.
+	 */
+	static float calcVertexCacheScore(INT32 cachePos, UINT32 numRemainingTris)
+	{
+		// Vertex isn't used by any more triangles
+		if (numRemainingTris == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+		if (cachePos >= 0)
+		{
+			// Vertices of the last triangle get a fixed score, so the next triangle isn't biased towards any of them
+			if (cachePos < 3)
+				score = 0.75f;
+			else
+			{
+				const float scale = 1.0f / (OPTIMIZER_CACHE_SIZE - 3);
+				score = std::pow(1.0f - (cachePos - 3) * scale, 1.5f);
+			}
+		}
+
+		// Prefer vertices with few remaining triangles, so lone triangles don't get left behind
+		score += 2.0f * std::pow((float)numRemainingTris, -0.5f);
+		return score;
+	}
+
+	float MeshUtility::calculateACMR(const UINT8* indices, UINT32 numIndices, UINT32 numVertices, UINT32 indexSize, 
+		UINT32 cacheSize)
+	{
+		const UINT32 numTris = numIndices / 3;
+		if (numTris == 0)
+			return 0.0f;
+
+		// A vertex is in the FIFO cache if less than cacheSize vertices were added to the cache since it was added
+		Vector<UINT32> timestamps(numVertices, 0);
+		UINT32 time = cacheSize + 1;
+		UINT32 numMisses = 0;
+
+		for (UINT32 i = 0; i < numTris * 3; i++)
+		{
+			UINT32 vertIdx = readIndex(indices, i, indexSize);
+			if (time - timestamps[vertIdx] > cacheSize)
+			{
+				timestamps[vertIdx] = time++;
+				numMisses++;
+			}
+		}
+
+		return numMisses / (float)numTris;
+	}
+
+	void MeshUtility::optimizeVertexCache(UINT8* indices, UINT32 numIndices, UINT32 numVertices, UINT32 indexSize)
+	{
+		const UINT32 numTris = numIndices / 3;
+		if (numTris == 0)
+			return;
+
+		Vector<UINT32> triVerts(numTris * 3);
+		for (UINT32 i = 0; i < numTris * 3; i++)
+			triVerts[i] = readIndex(indices, i, indexSize);
+
+		// Build a list of triangles using each vertex
+		Vector<UINT32> adjOffsets(numVertices + 1, 0);
+		for (auto& vertIdx : triVerts)
+			adjOffsets[vertIdx + 1]++;
+
+		for (UINT32 i = 0; i < numVertices; i++)
+			adjOffsets[i + 1] += adjOffsets[i];
+
+		Vector<UINT32> adjTris(numTris * 3);
+		Vector<UINT32> numRemainingTris(numVertices, 0);
+		for (UINT32 i = 0; i < numTris * 3; i++)
+		{
+			UINT32 vertIdx = triVerts[i];
+			adjTris[adjOffsets[vertIdx] + numRemainingTris[vertIdx]++] = i / 3;
+		}
+
+		Vector<INT32> cachePositions(numVertices, -1);
+		Vector<float> vertScores(numVertices);
+		for (UINT32 i = 0; i < numVertices; i++)
+			vertScores[i] = calcVertexCacheScore(-1, numRemainingTris[i]);
+
+		Vector<float> triScores(numTris);
+		Vector<UINT8> triEmitted(numTris, 0);
+		UINT32 bestTri = 0;
+		for (UINT32 i = 0; i < numTris; i++)
+		{
+			triScores[i] = vertScores[triVerts[i * 3 + 0]] + vertScores[triVerts[i * 3 + 1]] + 
+				vertScores[triVerts[i * 3 + 2]];
+
+			if (triScores[i] > triScores[bestTri])
+				bestTri = i;
+		}
+
+		UINT32 cache[OPTIMIZER_CACHE_SIZE + 3];
+		UINT32 cacheCount = 0;
+		UINT32 nextUnemittedTri = 0;
+
+		for (UINT32 i = 0; i < numTris; i++)
+		{
+			// No candidates in the cache, continue from any triangle that wasn't yet output
+			if (bestTri == (UINT32)-1)
+			{
+				while (triEmitted[nextUnemittedTri])
+					nextUnemittedTri++;
+
+				bestTri = nextUnemittedTri;
+			}
+
+			triEmitted[bestTri] = 1;
+
+			// Output the triangle and move its vertices to the front of the cache
+			UINT32 newCache[OPTIMIZER_CACHE_SIZE + 3];
+			UINT32 newCacheCount = 0;
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				UINT32 vertIdx = triVerts[bestTri * 3 + j];
+				writeIndex(indices, i * 3 + j, vertIdx, indexSize);
+
+				UINT32* vertTris = &adjTris[adjOffsets[vertIdx]];
+				for (UINT32 k = 0; k < numRemainingTris[vertIdx]; k++)
+				{
+					if (vertTris[k] == bestTri)
+					{
+						std::swap(vertTris[k], vertTris[numRemainingTris[vertIdx] - 1]);
+						numRemainingTris[vertIdx]--;
+						break;
+					}
+				}
+
+				// Degenerate triangles can reference the same vertex more than once
+				if (std::find(newCache, newCache + newCacheCount, vertIdx) == newCache + newCacheCount)
+					newCache[newCacheCount++] = vertIdx;
+			}
+
+			const UINT32 numTriVerts = newCacheCount;
+			for (UINT32 j = 0; j < cacheCount; j++)
+			{
+				if (std::find(newCache, newCache + numTriVerts, cache[j]) == newCache + numTriVerts)
+					newCache[newCacheCount++] = cache[j];
+			}
+
+			for (UINT32 j = OPTIMIZER_CACHE_SIZE; j < newCacheCount; j++)
+				cachePositions[newCache[j]] = -1;
+
+			cacheCount = std::min(newCacheCount, OPTIMIZER_CACHE_SIZE);
+			for (UINT32 j = 0; j < cacheCount; j++)
+			{
+				cache[j] = newCache[j];
+				cachePositions[newCache[j]] = (INT32)j;
+			}
+
+			// Update scores of all vertices whose cache position changed, and of their triangles
+			for (UINT32 j = 0; j < newCacheCount; j++)
+			{
+				UINT32 vertIdx = newCache[j];
+				vertScores[vertIdx] = calcVertexCacheScore(cachePositions[vertIdx], numRemainingTris[vertIdx]);
+			}
+
+			bestTri = (UINT32)-1;
+			float bestScore = -1.0f;
+			for (UINT32 j = 0; j < newCacheCount; j++)
+			{
+				UINT32 vertIdx = newCache[j];
+				const UINT32* vertTris = &adjTris[adjOffsets[vertIdx]];
+				for (UINT32 k = 0; k < numRemainingTris[vertIdx]; k++)
+				{
+					UINT32 triIdx = vertTris[k];
+					triScores[triIdx] = vertScores[triVerts[triIdx * 3 + 0]] + vertScores[triVerts[triIdx * 3 + 1]] + 
+						vertScores[triVerts[triIdx * 3 + 2]];
+
+					// Only triangles using cached vertices are considered, for linear running time
+					if (j < cacheCount && triScores[triIdx] > bestScore)
+					{
+						bestScore = triScores[triIdx];
+						bestTri = triIdx;
+					}
+				}
+			}
+		}
+	}
+
+	void MeshUtility::optimizeOverdraw(const UINT8* positions, UINT32 positionStride, UINT8* indices, UINT32 numIndices, 
+		UINT32 numVertices, UINT32 indexSize, float threshold)
+	{
+		const UINT32 numTris = numIndices / 3;
+		if (numTris < 2)
+			return;
+
+		auto getPosition = [positions, positionStride](UINT32 vertIdx)
+		{
+			Vector3 position;
+			memcpy(&position, positions + vertIdx * positionStride, sizeof(position));
+
+			return position;
+		};
+
+		Vector<UINT32> triVerts(numTris * 3);
+		for (UINT32 i = 0; i < numTris * 3; i++)
+			triVerts[i] = readIndex(indices, i, indexSize);
+
+		// Split the triangles into clusters wherever the simulated cache gets flushed (i.e. a triangle whose vertices all
+		// miss), so that reordering the clusters has minimal effect on the cache efficiency
+		static constexpr UINT32 CLUSTER_CACHE_SIZE = 16;
+		Vector<UINT32> clusterStarts = { 0 };
+		{
+			Vector<UINT32> timestamps(numVertices, 0);
+			UINT32 time = CLUSTER_CACHE_SIZE + 1;
+			for (UINT32 i = 0; i < numTris; i++)
+			{
+				UINT32 numMisses = 0;
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					UINT32 vertIdx = triVerts[i * 3 + j];
+					if (time - timestamps[vertIdx] > CLUSTER_CACHE_SIZE)
+					{
+						timestamps[vertIdx] = time++;
+						numMisses++;
+					}
+				}
+
+				if (numMisses == 3 && i > clusterStarts.back())
+					clusterStarts.push_back(i);
+			}
+		}
+
+		const UINT32 numClusters = (UINT32)clusterStarts.size();
+		if (numClusters < 2)
+			return;
+
+		clusterStarts.push_back(numTris);
+
+		// Sort clusters so the ones facing away from the mesh center, and therefore likely to occlude the others, are
+		// drawn first
+		Vector3 meshCenter(BsZero);
+		Vector<Vector3> clusterCenters(numClusters, Vector3(BsZero));
+		Vector<Vector3> clusterNormals(numClusters, Vector3(BsZero));
+		float meshArea = 0.0f;
+
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			float clusterArea = 0.0f;
+			for (UINT32 j = clusterStarts[i]; j < clusterStarts[i + 1]; j++)
+			{
+				Vector3 a = getPosition(triVerts[j * 3 + 0]);
+				Vector3 b = getPosition(triVerts[j * 3 + 1]);
+				Vector3 c = getPosition(triVerts[j * 3 + 2]);
+
+				// Length of the cross product is twice the triangle area
+				Vector3 normal = (b - a).cross(c - a);
+				float area = normal.length();
+
+				clusterCenters[i] += (a + b + c) * (area / 3.0f);
+				clusterNormals[i] += normal;
+				clusterArea += area;
+			}
+
+			meshCenter += clusterCenters[i];
+			meshArea += clusterArea;
+
+			if (clusterArea > 0.0f)
+				clusterCenters[i] /= clusterArea;
+		}
+
+		if (meshArea > 0.0f)
+			meshCenter /= meshArea;
+
+		Vector<float> sortKeys(numClusters);
+		Vector<UINT32> clusterOrder(numClusters);
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			sortKeys[i] = Vector3::normalize(clusterNormals[i]).dot(clusterCenters[i] - meshCenter);
+			clusterOrder[i] = i;
+		}
+
+		std::stable_sort(clusterOrder.begin(), clusterOrder.end(),
+			[&sortKeys](UINT32 a, UINT32 b) { return sortKeys[a] > sortKeys[b]; });
+
+		Vector<UINT32> sortedTriVerts;
+		sortedTriVerts.reserve(numTris * 3);
+		for (auto& clusterIdx : clusterOrder)
+		{
+			sortedTriVerts.insert(sortedTriVerts.end(), triVerts.begin() + clusterStarts[clusterIdx] * 3, 
+				triVerts.begin() + clusterStarts[clusterIdx + 1] * 3);
+		}
+
+		// Keep the original order if the cache efficiency suffers too much
+		float acmrBefore = calculateACMR((UINT8*)triVerts.data(), numTris * 3, numVertices, sizeof(UINT32));
+		float acmrAfter = calculateACMR((UINT8*)sortedTriVerts.data(), numTris * 3, numVertices, sizeof(UINT32));
+		if (acmrAfter > acmrBefore * threshold)
+			return;
+
+		for (UINT32 i = 0; i < numTris * 3; i++)
+			writeIndex(indices, i, sortedTriVerts[i], indexSize);
+	}
+
+	void MeshUtility::optimizeVertexFetch(MeshData& meshData)
+	{
+		const UINT32 numVertices = meshData.getNumVertices();
+		const UINT32 numIndices = meshData.getNumIndices();
+		const UINT32 indexSize = meshData.getIndexElementSize();
+
+		UINT8* indices;
+		if (meshData.getIndexType() == IT_32BIT)
+			indices = (UINT8*)meshData.getIndices32();
+		else
+			indices = (UINT8*)meshData.getIndices16();
+
+		// Assign new vertex indices in order of first use
+		Vector<UINT32> remap(numVertices, (UINT32)-1);
+		UINT32 nextVertIdx = 0;
+		for (UINT32 i = 0; i < numIndices; i++)
+		{
+			UINT32 vertIdx = readIndex(indices, i, indexSize);
+			if (remap[vertIdx] == (UINT32)-1)
+				remap[vertIdx] = nextVertIdx++;
+
+			writeIndex(indices, i, remap[vertIdx], indexSize);
+		}
+
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			if (remap[i] == (UINT32)-1)
+				remap[i] = nextVertIdx++;
+		}
+
+		// Move the vertices in every stream
+		const SPtr<VertexDataDesc>& vertexDesc = meshData.getVertexDesc();
+		Vector<UINT32> streams;
+		for (UINT32 i = 0; i < vertexDesc->getNumElements(); i++)
+		{
+			UINT32 streamIdx = vertexDesc->getElement(i).getStreamIdx();
+			if (std::find(streams.begin(), streams.end(), streamIdx) == streams.end())
+				streams.push_back(streamIdx);
+		}
+
+		Vector<UINT8> original;
+		for (auto& streamIdx : streams)
+		{
+			const UINT32 stride = vertexDesc->getVertexStride(streamIdx);
+			UINT8* data = meshData.getStreamData(streamIdx);
+
+			original.assign(data, data + stride * numVertices);
+			for (UINT32 i = 0; i < numVertices; i++)
+				memcpy(data + remap[i] * stride, original.data() + i * stride, stride);
+		}
+	}
+
+	MeshOptimizationStats MeshUtility::optimize(MeshData& meshData, const Vector<SubMesh>& subMeshes, 
+		bool reorderVertices)
+	{
+		const UINT32 numVertices = meshData.getNumVertices();
+		const UINT32 indexSize = meshData.getIndexElementSize();
+
+		UINT8* indices;
+		if (meshData.getIndexType() == IT_32BIT)
+			indices = (UINT8*)meshData.getIndices32();
+		else
+			indices = (UINT8*)meshData.getIndices16();
+
+		const SPtr<VertexDataDesc>& vertexDesc = meshData.getVertexDesc();
+		const VertexElement* positionElem = vertexDesc->getElement(VES_POSITION);
+
+		const UINT8* positions = nullptr;
+		UINT32 positionStride = 0;
+		if (positionElem != nullptr && positionElem->getType() == VET_FLOAT3)
+		{
+			positions = meshData.getElementData(VES_POSITION);
+			positionStride = vertexDesc->getVertexStride(positionElem->getStreamIdx());
+		}
+
+		MeshOptimizationStats stats;
+		UINT32 numTris = 0;
+		for (auto& subMesh : subMeshes)
+		{
+			if (subMesh.drawOp != DOT_TRIANGLE_LIST)
+				continue;
+
+			UINT8* subMeshIndices = indices + subMesh.indexOffset * indexSize;
+			UINT32 numSubMeshTris = subMesh.indexCount / 3;
+
+			stats.acmrBefore += calculateACMR(subMeshIndices, subMesh.indexCount, numVertices, indexSize) * numSubMeshTris;
+
+			optimizeVertexCache(subMeshIndices, subMesh.indexCount, numVertices, indexSize);
+
+			if (positions != nullptr)
+			{
+				optimizeOverdraw(positions, positionStride, subMeshIndices, subMesh.indexCount, numVertices, 
+					indexSize);
+			}
+
+			stats.acmrAfter += calculateACMR(subMeshIndices, subMesh.indexCount, numVertices, indexSize) * numSubMeshTris;
+			numTris += numSubMeshTris;
+		}
+
+		if (numTris > 0)
+		{
+			stats.acmrBefore /= numTris;
+			stats.acmrAfter /= numTris;
+		}
+
+		// Doesn't influence the cache efficiency, as only vertex indices change
+		if (reorderVertices)
+			optimizeVertexFetch(meshData);
+
+		return stats;
+	}
+	/** Symmetric 4x4 matrix whose quadratic form evaluates to the weighted sum of squared distances from a set of planes. */
+	struct SimplifyQuadric
+	{
+		/** Adds a plane with the provided unit normal and distance (n.p + d = 0), scaled by the provided weight. */
+		void addPlane(const Vector3& n, float d, float weight)
+		{
+			a00 += weight * n.x * n.x; a01 += weight * n.x * n.y; a02 += weight * n.x * n.z; a03 += weight * n.x * d;
+			a11 += weight * n.y * n.y; a12 += weight * n.y * n.z; a13 += weight * n.y * d;
+			a22 += weight * n.z * n.z; a23 += weight * n.z * d;
+			a33 += weight * d * d;
+
+			totalWeight += weight;
+		}
+
+		/** Adds planes of another quadric to this one. */
+		void add(const SimplifyQuadric& other)
+		{
+			a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+			a11 += other.a11; a12 += other.a12; a13 += other.a13;
+			a22 += other.a22; a23 += other.a23;
+			a33 += other.a33;
+
+			totalWeight += other.totalWeight;
+		}
+
+		/** Returns the weighted average of squared distances of the point from all the planes. */
+		float evaluate(const Vector3& p) const
+		{
+			if (totalWeight <= 0.0f)
+				return 0.0f;
+
+			float rx = a00 * p.x + a01 * p.y + a02 * p.z + a03;
+			float ry = a01 * p.x + a11 * p.y + a12 * p.z + a13;
+			float rz = a02 * p.x + a12 * p.y + a22 * p.z + a23;
+			float rw = a03 * p.x + a13 * p.y + a23 * p.z + a33;
+
+			return std::abs(rx * p.x + ry * p.y + rz * p.z + rw) / totalWeight;
+		}
+
+		float a00 = 0.0f, a01 = 0.0f, a02 = 0.0f, a03 = 0.0f;
+		float a11 = 0.0f, a12 = 0.0f, a13 = 0.0f;
+		float a22 = 0.0f, a23 = 0.0f;
+		float a33 = 0.0f;
+		float totalWeight = 0.0f;
+	};
+
+	/** Determines how is a vertex allowed to move during simplification. */
+	enum class SimplifyVertexType : UINT8
+	{
+		Manifold, /**< Interior vertex that can collapse onto any of its neighbours. */
+		Border, /**< Vertex on an open border that can only collapse along the border. */
+		Locked /**< Vertex on an attribute seam or a non-manifold edge that cannot move. */
+	};
+
+	/** Potential collapse of one vertex onto another, used during simplification. */
+	struct SimplifyCollapse
+	{
+		UINT32 from;
+		UINT32 to;
+		float error;
+	};
+
+	/** Multiplier applied to the weight of planes that keep open borders in place. */
+	static constexpr float SIMPLIFY_BORDER_WEIGHT = 10.0f;
+
+	/** 
+	 * Maximum sum of absolute differences in bone weights between two vertices that can be merged, out of the maximum 
+	 * of 2. 
+	 */
+	static constexpr float SIMPLIFY_MAX_BONE_WEIGHT_DIFFERENCE = 0.5f;
+
+	/** Returns a key uniquely identifying an undirected edge between two vertices. */
+	static UINT64 getEdgeKey(UINT32 a, UINT32 b)
+	{
+		return a < b ? ((UINT64)a << 32) | b : ((UINT64)b << 32) | a;
+	}
+
+	UINT32 MeshUtility::simplify(const MeshData& meshData, const UINT8* indices, UINT32 numIndices, UINT8* output,
+		UINT32 targetNumIndices, float maxError, float* resultError)
+	{
+		const UINT32 numVertices = meshData.getNumVertices();
+		const UINT32 indexSize = meshData.getIndexElementSize();
+		UINT32 numTris = numIndices / 3;
+
+		if (resultError != nullptr)
+			*resultError = 0.0f;
+
+		const SPtr<VertexDataDesc>& vertexDesc = meshData.getVertexDesc();
+		const VertexElement* positionElem = vertexDesc->getElement(VES_POSITION);
+		if (positionElem == nullptr || positionElem->getType() != VET_FLOAT3 || numTris * 3 <= targetNumIndices)
+		{
+			memmove(output, indices, numTris * 3 * indexSize);
+			return numTris * 3;
+		}
+
+		// Normalize positions so the error is relative to the mesh size
+		Vector<Vector3> positions(numVertices);
+		{
+			const UINT8* positionData = meshData.getElementData(VES_POSITION);
+			const UINT32 positionStride = vertexDesc->getVertexStride(positionElem->getStreamIdx());
+
+			Vector3 min(Vector3::INF);
+			Vector3 max(-Vector3::INF);
+			for (UINT32 i = 0; i < numVertices; i++)
+			{
+				memcpy(&positions[i], positionData + i * positionStride, sizeof(Vector3));
+
+				min = Vector3::min(min, positions[i]);
+				max = Vector3::max(max, positions[i]);
+			}
+
+			Vector3 extents = max - min;
+			float scale = std::max(extents.x, std::max(extents.y, extents.z));
+			float invScale = scale > 0.0f ? 1.0f / scale : 1.0f;
+
+			for (auto& position : positions)
+				position = (position - min) * invScale;
+		}
+
+		// Vertices that are exact duplicates are treated as a single vertex. Vertices sharing a position but differing
+		// in any other attribute lie on a seam, and are locked in place so the seam doesn't open up.
+		Vector<UINT32> weld(numVertices);
+		Vector<SimplifyVertexType> vertexTypes(numVertices, SimplifyVertexType::Manifold);
+		{
+			Vector<UINT32> streams;
+			for (UINT32 i = 0; i < vertexDesc->getNumElements(); i++)
+			{
+				UINT32 streamIdx = vertexDesc->getElement(i).getStreamIdx();
+				if (std::find(streams.begin(), streams.end(), streamIdx) == streams.end())
+					streams.push_back(streamIdx);
+			}
+
+			auto isSameVertex = [&meshData, &vertexDesc, &streams](UINT32 a, UINT32 b)
+			{
+				for (auto& streamIdx : streams)
+				{
+					const UINT32 stride = vertexDesc->getVertexStride(streamIdx);
+					const UINT8* data = meshData.getStreamData(streamIdx);
+
+					if (memcmp(data + a * stride, data + b * stride, stride) != 0)
+						return false;
+				}
+
+				return true;
+			};
+
+			Vector<UINT32> sortedVertices(numVertices);
+			for (UINT32 i = 0; i < numVertices; i++)
+			{
+				sortedVertices[i] = i;
+				weld[i] = i;
+			}
+
+			std::sort(sortedVertices.begin(), sortedVertices.end(), [&positions](UINT32 a, UINT32 b)
+			{
+				const Vector3& posA = positions[a];
+				const Vector3& posB = positions[b];
+
+				if (posA.x != posB.x) return posA.x < posB.x;
+				if (posA.y != posB.y) return posA.y < posB.y;
+				return posA.z < posB.z;
+			});
+
+			for (UINT32 groupStart = 0; groupStart < numVertices;)
+			{
+				UINT32 groupEnd = groupStart + 1;
+				while (groupEnd < numVertices && positions[sortedVertices[groupEnd]] == positions[sortedVertices[groupStart]])
+					groupEnd++;
+
+				bool isSeam = false;
+				for (UINT32 i = groupStart + 1; i < groupEnd; i++)
+				{
+					UINT32 vertIdx = sortedVertices[i];
+					for (UINT32 j = groupStart; j < i; j++)
+					{
+						UINT32 otherIdx = sortedVertices[j];
+						if (weld[otherIdx] == otherIdx && isSameVertex(vertIdx, otherIdx))
+						{
+							weld[vertIdx] = otherIdx;
+							break;
+						}
+					}
+
+					if (weld[vertIdx] == vertIdx)
+						isSeam = true;
+				}
+
+				if (isSeam)
+				{
+					for (UINT32 i = groupStart; i < groupEnd; i++)
+						vertexTypes[sortedVertices[i]] = SimplifyVertexType::Locked;
+				}
+
+				groupStart = groupEnd;
+			}
+		}
+
+		Vector<UINT32> triVerts(numTris * 3);
+		for (UINT32 i = 0; i < numTris * 3; i++)
+			triVerts[i] = weld[readIndex(indices, i, indexSize)];
+
+		auto removeDegenerateTris = [&triVerts, &numTris]()
+		{
+			UINT32 numValidTris = 0;
+			for (UINT32 i = 0; i < numTris; i++)
+			{
+				UINT32 a = triVerts[i * 3 + 0];
+				UINT32 b = triVerts[i * 3 + 1];
+				UINT32 c = triVerts[i * 3 + 2];
+
+				if (a == b || b == c || a == c)
+					continue;
+
+				triVerts[numValidTris * 3 + 0] = a;
+				triVerts[numValidTris * 3 + 1] = b;
+				triVerts[numValidTris * 3 + 2] = c;
+				numValidTris++;
+			}
+
+			numTris = numValidTris;
+			triVerts.resize(numTris * 3);
+		};
+
+		UnorderedMap<UINT64, UINT32> edgeCounts;
+		auto countEdges = [&triVerts, &numTris, &edgeCounts]()
+		{
+			edgeCounts.clear();
+			for (UINT32 i = 0; i < numTris; i++)
+			{
+				for (UINT32 j = 0; j < 3; j++)
+					edgeCounts[getEdgeKey(triVerts[i * 3 + j], triVerts[i * 3 + (j + 1) % 3])]++;
+			}
+		};
+
+		removeDegenerateTris();
+		countEdges();
+
+		// Quadrics measure the distance from planes of the original triangles. Open borders additionally get planes 
+		// perpendicular to the border, keeping the border outline in place.
+		Vector<SimplifyQuadric> quadrics(numVertices);
+		{
+			Vector<UINT32> numBorderEdges(numVertices, 0);
+			for (UINT32 i = 0; i < numTris; i++)
+			{
+				const UINT32* tri = &triVerts[i * 3];
+
+				Vector3 normal = (positions[tri[1]] - positions[tri[0]]).cross(positions[tri[2]] - positions[tri[0]]);
+				float doubleArea = normal.length();
+				if (doubleArea <= 0.0f)
+					continue;
+
+				normal /= doubleArea;
+				float distance = -normal.dot(positions[tri[0]]);
+				for (UINT32 j = 0; j < 3; j++)
+					quadrics[tri[j]].addPlane(normal, distance, doubleArea * 0.5f);
+
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					UINT32 a = tri[j];
+					UINT32 b = tri[(j + 1) % 3];
+
+					UINT32 edgeCount = edgeCounts[getEdgeKey(a, b)];
+					if (edgeCount == 1)
+					{
+						Vector3 edge = positions[b] - positions[a];
+						float edgeLength = edge.length();
+						if (edgeLength > 0.0f)
+						{
+							Vector3 borderNormal = Vector3::normalize(edge.cross(normal));
+							float borderDistance = -borderNormal.dot(positions[a]);
+							float weight = edgeLength * edgeLength * SIMPLIFY_BORDER_WEIGHT;
+
+							quadrics[a].addPlane(borderNormal, borderDistance, weight);
+							quadrics[b].addPlane(borderNormal, borderDistance, weight);
+						}
+
+						numBorderEdges[a]++;
+						numBorderEdges[b]++;
+					}
+					else if (edgeCount > 2)
+					{
+						vertexTypes[a] = SimplifyVertexType::Locked;
+						vertexTypes[b] = SimplifyVertexType::Locked;
+					}
+				}
+			}
+
+			// Vertices where multiple borders meet can't move without changing the border shape
+			for (UINT32 i = 0; i < numVertices; i++)
+			{
+				if (vertexTypes[i] == SimplifyVertexType::Locked || numBorderEdges[i] == 0)
+					continue;
+
+				vertexTypes[i] = numBorderEdges[i] == 2 ? SimplifyVertexType::Border : SimplifyVertexType::Locked;
+			}
+		}
+
+		// Skinned vertices may only merge if they're influenced by similar bones
+		const UINT8* blendWeights = nullptr;
+		const UINT8* blendIndices = nullptr;
+		UINT32 blendWeightStride = 0;
+		UINT32 blendIndexStride = 0;
+		{
+			const VertexElement* weightElem = vertexDesc->getElement(VES_BLEND_WEIGHTS);
+			const VertexElement* indexElem = vertexDesc->getElement(VES_BLEND_INDICES);
+			if (weightElem != nullptr && weightElem->getType() == VET_FLOAT4 && indexElem != nullptr && 
+				indexElem->getType() == VET_UBYTE4)
+			{
+				blendWeights = meshData.getElementData(VES_BLEND_WEIGHTS);
+				blendIndices = meshData.getElementData(VES_BLEND_INDICES);
+				blendWeightStride = vertexDesc->getVertexStride(weightElem->getStreamIdx());
+				blendIndexStride = vertexDesc->getVertexStride(indexElem->getStreamIdx());
+			}
+		}
+
+		auto getBoneWeightDifference = [&](UINT32 a, UINT32 b)
+		{
+			UINT8 bones[8];
+			float weights[8];
+			UINT32 numBones = 0;
+
+			auto accumulate = [&](UINT32 vertIdx, float sign)
+			{
+				float vertWeights[4];
+				memcpy(vertWeights, blendWeights + vertIdx * blendWeightStride, sizeof(vertWeights));
+
+				const UINT8* vertBones = blendIndices + vertIdx * blendIndexStride;
+				for (UINT32 i = 0; i < 4; i++)
+				{
+					if (vertWeights[i] == 0.0f)
+						continue;
+
+					UINT32 boneIdx = (UINT32)(std::find(bones, bones + numBones, vertBones[i]) - bones);
+					if (boneIdx == numBones)
+					{
+						bones[numBones] = vertBones[i];
+						weights[numBones++] = 0.0f;
+					}
+
+					weights[boneIdx] += vertWeights[i] * sign;
+				}
+			};
+
+			accumulate(a, 1.0f);
+			accumulate(b, -1.0f);
+
+			float difference = 0.0f;
+			for (UINT32 i = 0; i < numBones; i++)
+				difference += std::abs(weights[i]);
+
+			return difference;
+		};
+
+		// Collapsing a vertex must not flip any of the triangles that remain
+		Vector<UINT32> adjOffsets(numVertices + 1);
+		Vector<UINT32> adjTris;
+		auto hasFlippedTriangle = [&](UINT32 from, UINT32 to)
+		{
+			for (UINT32 i = adjOffsets[from]; i < adjOffsets[from + 1]; i++)
+			{
+				const UINT32* tri = &triVerts[adjTris[i] * 3];
+				if (tri[0] == to || tri[1] == to || tri[2] == to)
+					continue;
+
+				Vector3 oldPositions[3] = { positions[tri[0]], positions[tri[1]], positions[tri[2]] };
+				Vector3 newPositions[3] = { oldPositions[0], oldPositions[1], oldPositions[2] };
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					if (tri[j] == from)
+						newPositions[j] = positions[to];
+				}
+
+				Vector3 oldNormal = (oldPositions[1] - oldPositions[0]).cross(oldPositions[2] - oldPositions[0]);
+				Vector3 newNormal = (newPositions[1] - newPositions[0]).cross(newPositions[2] - newPositions[0]);
+
+				float oldLength = oldNormal.length();
+				if (oldLength > 0.0f && oldNormal.dot(newNormal) <= 0.25f * oldLength * newNormal.length())
+					return true;
+			}
+
+			return false;
+		};
+
+		const UINT32 targetNumTris = targetNumIndices / 3;
+		const float maxErrorSqrd = maxError * maxError;
+		float largestErrorSqrd = 0.0f;
+
+		Vector<SimplifyCollapse> collapses;
+		Vector<UINT32> collapseTargets(numVertices);
+		Vector<UINT8> touched(numVertices);
+		while (numTris > targetNumTris)
+		{
+			countEdges();
+
+			// Build a list of triangles using each vertex
+			adjOffsets.assign(numVertices + 1, 0);
+			for (auto& vertIdx : triVerts)
+				adjOffsets[vertIdx + 1]++;
+
+			for (UINT32 i = 0; i < numVertices; i++)
+				adjOffsets[i + 1] += adjOffsets[i];
+
+			adjTris.resize(numTris * 3);
+			{
+				Vector<UINT32> adjCounts(numVertices, 0);
+				for (UINT32 i = 0; i < numTris * 3; i++)
+				{
+					UINT32 vertIdx = triVerts[i];
+					adjTris[adjOffsets[vertIdx] + adjCounts[vertIdx]++] = i / 3;
+				}
+			}
+
+			// Find all valid collapses along triangle edges, and their costs
+			collapses.clear();
+			auto addCollapse = [&](UINT32 from, UINT32 to)
+			{
+				if (vertexTypes[from] == SimplifyVertexType::Locked)
+					return;
+
+				if (vertexTypes[from] == SimplifyVertexType::Border)
+				{
+					if (vertexTypes[to] == SimplifyVertexType::Manifold || edgeCounts[getEdgeKey(from, to)] != 1)
+						return;
+				}
+
+				if (blendWeights != nullptr && getBoneWeightDifference(from, to) > SIMPLIFY_MAX_BONE_WEIGHT_DIFFERENCE)
+					return;
+
+				SimplifyQuadric quadric = quadrics[from];
+				quadric.add(quadrics[to]);
+
+				float error = quadric.evaluate(positions[to]);
+				if (error > maxErrorSqrd)
+					return;
+
+				collapses.push_back({ from, to, error });
+			};
+
+			for (UINT32 i = 0; i < numTris; i++)
+			{
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					UINT32 a = triVerts[i * 3 + j];
+					UINT32 b = triVerts[i * 3 + (j + 1) % 3];
+
+					addCollapse(a, b);
+					addCollapse(b, a);
+				}
+			}
+
+			std::sort(collapses.begin(), collapses.end(), 
+				[](const SimplifyCollapse& a, const SimplifyCollapse& b) { return a.error < b.error; });
+
+			// Perform the cheapest collapses that don't affect each other's neighbourhood
+			for (UINT32 i = 0; i < numVertices; i++)
+				collapseTargets[i] = i;
+
+			touched.assign(numVertices, 0);
+
+			const UINT32 numTrisToRemove = numTris - targetNumTris;
+			UINT32 numRemovedTris = 0;
+			UINT32 numCollapses = 0;
+			for (auto& collapse : collapses)
+			{
+				if (numRemovedTris >= numTrisToRemove)
+					break;
+
+				if (touched[collapse.from] || touched[collapse.to])
+					continue;
+
+				if (hasFlippedTriangle(collapse.from, collapse.to))
+					continue;
+
+				for (UINT32 i = adjOffsets[collapse.from]; i < adjOffsets[collapse.from + 1]; i++)
+				{
+					const UINT32* tri = &triVerts[adjTris[i] * 3];
+					if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to)
+						numRemovedTris++;
+
+					touched[tri[0]] = 1;
+					touched[tri[1]] = 1;
+					touched[tri[2]] = 1;
+				}
+
+				collapseTargets[collapse.from] = collapse.to;
+				quadrics[collapse.to].add(quadrics[collapse.from]);
+				largestErrorSqrd = std::max(largestErrorSqrd, collapse.error);
+				numCollapses++;
+			}
+
+			if (numCollapses == 0)
+				break;
+
+			for (auto& vertIdx : triVerts)
+				vertIdx = collapseTargets[vertIdx];
+
+			removeDegenerateTris();
+		}
+
+		for (UINT32 i = 0; i < numTris * 3; i++)
+			writeIndex(output, i, triVerts[i], indexSize);
+
+		if (resultError != nullptr)
+			*resultError = std::sqrt(largestErrorSqrd);
+
+		return numTris * 3;
+	}
+
+	/** 
+	 * Largest error a level of detail is allowed to have when displayed, relative to the viewport height. Roughly a pixel
+	 * at common resolutions.
+	 */
+	static constexpr float LOD_MAX_SCREEN_ERROR = 0.001f;
+
+	SPtr<MeshData> MeshUtility::generateLODs(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+		UINT32 maxLODs, float reduction, float maxError, Vector<MeshLOD>& lods)
+	{
+		lods.clear();
+
+		const UINT32 numIndices = meshData->getNumIndices();
+		const UINT32 indexSize = meshData->getIndexElementSize();
+		const UINT8* indices = meshData->getIndexData();
+
+		UINT32 numOriginalTris = 0;
+		for (auto& subMesh : subMeshes)
+		{
+			if (subMesh.drawOp == DOT_TRIANGLE_LIST)
+				numOriginalTris += subMesh.indexCount / 3;
+		}
+
+		if (numOriginalTris == 0)
+			return meshData;
+
+		// Errors reported by simplify() are relative to the largest extent of the mesh, while screen size is relative to
+		// the diameter of its bounding sphere
+		const Bounds bounds = meshData->calculateBounds();
+		const Vector3 extents = bounds.getBox().getSize();
+		const float maxExtent = std::max(extents.x, std::max(extents.y, extents.z));
+		const float diameter = bounds.getSphere().getRadius() * 2.0f;
+		const float errorToDiameter = diameter > 0.0f ? maxExtent / diameter : 1.0f;
+
+		// Each level is simplified from the previous one, with its indices placed after the original indices
+		Vector<UINT8> lodIndices;
+		auto getIndexPtr = [&](UINT32 indexOffset) -> const UINT8*
+		{
+			if (indexOffset < numIndices)
+				return indices + indexOffset * indexSize;
+
+			return lodIndices.data() + (indexOffset - numIndices) * indexSize;
+		};
+
+		Vector<SubMesh> prevSubMeshes = subMeshes;
+		UINT32 prevNumTris = numOriginalTris;
+		float lodMaxError = maxError;
+		float totalError = 0.0f;
+		float prevScreenSize = std::numeric_limits<float>::max();
+
+		Vector<UINT8> sourceIndices;
+		for (UINT32 i = 0; i < maxLODs; i++)
+		{
+			const UINT32 lodStart = (UINT32)lodIndices.size();
+
+			MeshLOD lod;
+			lod.subMeshes.resize(subMeshes.size());
+
+			UINT32 numTris = 0;
+			float lodError = 0.0f;
+			for (UINT32 j = 0; j < (UINT32)subMeshes.size(); j++)
+			{
+				const SubMesh& prevSubMesh = prevSubMeshes[j];
+				if (prevSubMesh.drawOp != DOT_TRIANGLE_LIST)
+				{
+					lod.subMeshes[j] = prevSubMesh;
+					continue;
+				}
+
+				// Copy as the output buffer might get reallocated
+				const UINT8* prevIndices = getIndexPtr(prevSubMesh.indexOffset);
+				sourceIndices.assign(prevIndices, prevIndices + prevSubMesh.indexCount * indexSize);
+
+				const UINT32 outputOffset = (UINT32)lodIndices.size();
+				const UINT32 targetNumIndices = (UINT32)(prevSubMesh.indexCount / 3 * reduction) * 3;
+
+				lodIndices.resize(outputOffset + prevSubMesh.indexCount * indexSize);
+
+				float subMeshError = 0.0f;
+				UINT32 numLODIndices = simplify(*meshData, sourceIndices.data(), prevSubMesh.indexCount, 
+					lodIndices.data() + outputOffset, targetNumIndices, lodMaxError, &subMeshError);
+				lodIndices.resize(outputOffset + numLODIndices * indexSize);
+
+				lod.subMeshes[j] = SubMesh(numIndices + outputOffset / indexSize, numLODIndices, DOT_TRIANGLE_LIST);
+				numTris += numLODIndices / 3;
+				lodError = std::max(lodError, subMeshError);
+			}
+
+			// Stop once the mesh cannot be simplified noticeably further
+			if (numTris == 0 || numTris > prevNumTris * 0.9f)
+			{
+				lodIndices.resize(lodStart);
+				break;
+			}
+
+			// Each level is simplified from the previous one, so errors accumulate. Switch to the level once its error,
+			// projected on screen, falls below the threshold. Levels without any error are as good as the previous level.
+			totalError += lodError;
+
+			const float errorDiameterFraction = totalError * errorToDiameter;
+			if (errorDiameterFraction > 0.0f)
+				lod.screenSize = std::min(LOD_MAX_SCREEN_ERROR / errorDiameterFraction, prevScreenSize);
+			else
+				lod.screenSize = prevScreenSize;
+
+			lods.push_back(lod);
+			prevScreenSize = lod.screenSize;
+
+			prevSubMeshes = lod.subMeshes;
+			prevNumTris = numTris;
+			lodMaxError *= 2.0f;
+		}
+
+		if (lods.empty())
+			return meshData;
+
+		const UINT32 numLODIndices = (UINT32)lodIndices.size() / indexSize;
+		const SPtr<VertexDataDesc>& vertexDesc = meshData->getVertexDesc();
+
+		SPtr<MeshData> output = MeshData::create(meshData->getNumVertices(), numIndices + numLODIndices, vertexDesc, 
+			meshData->getIndexType());
+
+		Vector<UINT32> copiedStreams;
+		for (UINT32 i = 0; i < vertexDesc->getNumElements(); i++)
+		{
+			UINT32 streamIdx = vertexDesc->getElement(i).getStreamIdx();
+			if (std::find(copiedStreams.begin(), copiedStreams.end(), streamIdx) != copiedStreams.end())
+				continue;
+
+			memcpy(output->getStreamData(streamIdx), meshData->getStreamData(streamIdx), 
+				meshData->getStreamSize(streamIdx));
+			copiedStreams.push_back(streamIdx);
+		}
+
+		memcpy(output->getIndexData(), indices, numIndices * indexSize);
+		memcpy(output->getIndexData() + numIndices * indexSize, lodIndices.data(), lodIndices.size());
+
+		return output;
+	}
 }
\ No newline at end of file
@@ -25,6 +25,16 @@ namespace bs
 		UINT32 packed;
 	};
 
+	/** Vertex cache efficiency of a mesh before and after MeshUtility::optimize(). */
+	struct MeshOptimizationStats
+	{
+		/** Average number of vertices transformed per triangle (average cache miss ratio), before optimization. */
+		float acmrBefore = 0.0f;
+
+		/** Average number of vertices transformed per triangle (average cache miss ratio), after optimization. */
+		float acmrAfter = 0.0f;
+	};
+
 	/** Performs various operations on mesh geometry. */
 	class BS_CORE_EXPORT MeshUtility
 	{
@@ -191,6 +201,115 @@ namespace bs
 
 			return output;
 		}
+
+		/**
+		 * Calculates the average cache miss ratio (ACMR) of a triangle list, by simulating a FIFO post-transform vertex
+		 * cache. Lower values are better, with the theoretical minimum being 0.5 for large regular meshes, and maximum 3.
+		 *
+		 * @param[in]	indices		Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]	numIndices	Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]	numVertices	Number of vertices referenced by the indices.
+		 * @param[in]	indexSize	Size of a single index in the indices array, in bytes.
+		 * @param[in]	cacheSize	Number of vertices the simulated cache can hold.
+		 * @return					Average number of vertices transformed per triangle.
+		 */
+		static float calculateACMR(const UINT8* indices, UINT32 numIndices, UINT32 numVertices, UINT32 indexSize = 4,
+			UINT32 cacheSize = 16);
+
+		/**
+		 * Reorders triangles of a triangle list so vertices shared between triangles are more likely to be found in the
+		 * post-transform vertex cache, using Tom Forsyth's linear-speed vertex cache optimization algorithm.
+		 *
+		 * @param[in, out]	indices		Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]		numIndices	Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]		numVertices	Number of vertices referenced by the indices.
+		 * @param[in]		indexSize	Size of a single index in the indices array, in bytes.
+		 */
+		static void optimizeVertexCache(UINT8* indices, UINT32 numIndices, UINT32 numVertices, UINT32 indexSize = 4);
+
+		/**
+		 * Reorders clusters of triangles so that triangles likely to occlude others are drawn first, reducing overdraw.
+		 * Triangles within clusters keep their order, so this should be called after optimizeVertexCache(). If sorting
+		 * the clusters would make the cache efficiency worse than @p threshold times the original, the order is left
+		 * unchanged.
+		 *
+		 * @param[in]		positions		Pointer to the position of the first vertex.
+		 * @param[in]		positionStride	Distance between positions of two consecutive vertices, in bytes.
+		 * @param[in, out]	indices			Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]		numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]		numVertices		Number of vertices referenced by the indices.
+		 * @param[in]		indexSize		Size of a single index in the indices array, in bytes.
+		 * @param[in]		threshold		Maximum allowed ratio between the ACMR after and before sorting.
+		 */
+		static void optimizeOverdraw(const UINT8* positions, UINT32 positionStride, UINT8* indices, UINT32 numIndices, 
+			UINT32 numVertices, UINT32 indexSize = 4, float threshold = 1.05f);
+
+		/**
+		 * Reorders vertices of the mesh in the order they are first referenced by the index buffer, improving the
+		 * locality of vertex fetches. Indices are updated accordingly, and vertices not referenced by any triangle are
+		 * moved to the end of the vertex buffer.
+		 */
+		static void optimizeVertexFetch(MeshData& meshData);
+
+		/**
+		 * Optimizes the mesh for rendering by improving the post-transform cache efficiency, reducing overdraw and
+		 * improving vertex fetch locality. Only sub-meshes using triangle lists are optimized.
+		 *
+		 * @param[in, out]	meshData		Mesh to optimize.
+		 * @param[in]		subMeshes		Index ranges of the mesh that are rendered separately. Triangles are never
+		 *									moved between sub-meshes.
+		 * @param[in]		reorderVertices	If true the vertices are reordered as well, see optimizeVertexFetch(). This
+		 *									should be disabled if any external data references the vertices by index
+		 *									(e.g. morph shapes).
+		 * @return							Vertex cache efficiency before and after the optimization.
+		 */
+		static MeshOptimizationStats optimize(MeshData& meshData, const Vector<SubMesh>& subMeshes, 
+			bool reorderVertices = true);
+
+		/**
+		 * Reduces the number of triangles in a triangle list by collapsing edges in order of their quadric error. Only
+		 * the indices are modified, and the simplified triangles reference a subset of the original vertices.
+		 *
+		 * Vertices on UV, normal or other attribute seams (vertices sharing a position but differing in other
+		 * attributes) are never moved, and vertices on open borders only move along the border. Vertices with
+		 * significantly different bone weights are never merged.
+		 *
+		 * @param[in]	meshData			Mesh containing the vertices referenced by the indices. Must contain 3D
+		 *									positions.
+		 * @param[in]	indices				Triangle list to simplify, using the index size of @p meshData.
+		 * @param[in]	numIndices			Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[out]	output				Buffer to write the simplified triangle list to, using the index size of
+		 *									@p meshData. Must be able to hold @p numIndices indices.
+		 * @param[in]	targetNumIndices	Number of indices to reduce the triangle list to. The result may contain
+		 *									more indices if the mesh cannot be simplified enough within @p maxError.
+		 * @param[in]	maxError			Maximum distance a surface is allowed to move, relative to the size of the
+		 *									mesh.
+		 * @param[out]	resultError			Optional output for the largest error introduced, relative to the size of
+		 *									the mesh.
+		 * @return							Number of indices written to @p output.
+		 */
+		static UINT32 simplify(const MeshData& meshData, const UINT8* indices, UINT32 numIndices, UINT8* output,
+			UINT32 targetNumIndices, float maxError = 0.01f, float* resultError = nullptr);
+
+		/**
+		 * Generates progressively simplified levels of detail of a mesh, using simplify(). Vertices are shared between
+		 * all levels, and the indices of each level are appended after the original indices. Generation stops early if
+		 * a level cannot be simplified noticeably further within the allowed error.
+		 *
+		 * @param[in]	meshData	Mesh to generate levels of detail for. Must contain 3D positions.
+		 * @param[in]	subMeshes	Index ranges of the mesh. Each level of detail contains a simplified version of every
+		 *							sub-mesh. Sub-meshes not using triangle lists are copied as is.
+		 * @param[in]	maxLODs		Maximum number of levels of detail to generate, not counting the original mesh.
+		 * @param[in]	reduction	Fraction of triangles to keep in each level, relative to the previous level.
+		 * @param[in]	maxError	Maximum error allowed for the first level, relative to the size of the mesh. Each
+		 *							following level allows twice as much error as the previous one.
+		 * @param[out]	lods		Generated levels of detail. Screen sizes are calculated from the error of each level,
+		 *							so a level is only used once its error is smaller than about a pixel on screen.
+		 * @return					Mesh data containing the original vertices and indices, followed by indices of all
+		 *							the levels of detail. Returns @p meshData if no levels were generated.
+		 */
+		static SPtr<MeshData> generateLODs(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+			UINT32 maxLODs, float reduction, float maxError, Vector<MeshLOD>& lods);
 	};
 
 	/** @} */
@@ -46,7 +46,17 @@ namespace bs
 		 * Enables continous collision detection. This will prevent fast-moving objects from tunneling through each other.
 		 * You must also enable CCD for individual Rigidbodies. This option can have a significant performance impact.
 		 */
-		CCD_Enable = 1<<3
+		CCD_Enable = 1<<3,
+		/**
+		 * Runs the physics simulation in the background, overlapping with the rest of the frame. Results of a simulation
+		 * step are retrieved during the next fixed update, and rigidbody transforms are interpolated between the two most
+		 * recent results every frame. This removes the simulation from the critical path of the main thread, at the cost
+		 * of the physics state being displayed one fixed step late. Queries, and changes to physics objects, wait for the
+		 * running step to complete first, so the simulation only overlaps with work that doesn't access physics. Such
+		 * accesses must be made from the thread that runs the simulation while the step is in progress. Even if the step
+		 * completes early, its results and collision events are only delivered during the next fixed update.
+		 */
+		Async_Simulation = 1<<4
 	};
 
 	/** @copydoc CharacterCollisionFlag */
@@ -427,6 +437,29 @@ namespace bs
 		virtual bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const = 0;
 
+		/**
+		 * Executes a set of scene queries at once, splitting them across worker threads. Results are written into caller
+		 * provided buffers so no memory is allocated per query, making this preferable to individual queries when many of
+		 * them need to be executed at once (e.g. line of sight checks for a large number of agents).
+		 *
+		 * @param[in]	queries			Queries to execute.
+		 * @param[in]	numQueries		Number of entries in the @pqueries array.
+		 * @param[out]	hits			Buffer that receives the query hits, of size @pnumQueries * @pmaxHitsPerQuery.
+		 *								Hits of the query at index i start at index i * @pmaxHitsPerQuery. Hits of ray and
+		 *								shape casts that report all hits are sorted by distance, closest first. For overlap
+		 *								queries only the collider fields of the hit are populated, in no particular order.
+		 * @param[in]	maxHitsPerQuery	Maximum number of hits to record for a single query. If a query has more hits, which
+		 *								of them are recorded is undefined.
+		 * @param[out]	numHits			Buffer of size @pnumQueries that receives the number of hits recorded for each
+		 *								query.
+		 *
+		 * @note	Only one batch is executed at a time. Batches issued from multiple threads are executed in sequence.
+		 * @note	When PhysicsFlag::Async_Simulation is enabled, the batch waits for the running simulation step to 
+		 *			complete, and must be issued from the thread running the simulation while the step is in progress.
+		 */
+		virtual void queryBatch(const PHYSICS_QUERY_DESC* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+			UINT32 maxHitsPerQuery, UINT32* numHits) const = 0;
+
 		/******************************************************************************************************************/
 		/************************************************* OPTIONS ********************************************************/
 		/******************************************************************************************************************/
@@ -489,6 +522,23 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:IsCollisionEnabled)
 		bool isCollisionEnabled(UINT64 groupA, UINT64 groupB) const;
 
+		/** 
+		 * Determines which layers generate collision and trigger events. Each bit in the mask corresponds to a layer. 
+		 * Events are only recorded for colliders on one of the enabled layers, allowing contact heavy objects (e.g.
+		 * debris) to skip event processing altogether. All layers are enabled by default.
+		 *
+		 * The layer is checked for the collider receiving the event, not the one it interacts with. A collider on an
+		 * enabled layer still receives events about colliders on disabled layers, and a trigger receives events about
+		 * any collider entering it, as long as the trigger itself is on an enabled layer.
+		 */
+		void setEventLayers(UINT64 layerMask) { mEventLayers = layerMask; }
+
+		/** @copydoc setEventLayers */
+		UINT64 getEventLayers() const { return mEventLayers; }
+
+		/** Checks should a collider on the provided layer receive collision and trigger events. */
+		bool isEventLayer(UINT64 layer) const { return layer < 64 && (mEventLayers & (1ULL << layer)) != 0; }
+
 		/** @name Internal
 		 *  @{
 		 */
@@ -601,6 +651,7 @@ namespace bs
 
 		bool mUpdateInProgress = false;
 		PhysicsFlags mFlags;
+		UINT64 mEventLayers = BS_ALL_LAYERS;
 	};
 
 	/** Provides easier access to Physics. */
@@ -615,6 +666,17 @@ namespace bs
 		bool initCooking = true; /**< Determines should the cooking library be initialized. */
 		/** Flags that control global physics option. */
 		PhysicsFlags flags = PhysicsFlag::CCT_OverlapRecovery | PhysicsFlag::CCT_PreciseSweeps | PhysicsFlag::CCD_Enable;
+		/** 
+		 * Number of TaskScheduler workers to leave to other systems when choosing how many threads to run the simulation
+		 * on. The simulation uses the rest, but always at least one thread.
+		 */
+		UINT32 numReservedWorkers = 1;
+		/**
+		 * Number of times an idle simulation thread checks for new work before going to sleep. Higher values reduce the
+		 * latency of picking up new work, at the cost of CPU time spent spinning. Simulation threads never spin while
+		 * the TaskScheduler has tasks running, so they don't take cores away from its workers.
+		 */
+		UINT32 numSpinsBeforeSleep = 64;
 	};
 
 	/** @} */
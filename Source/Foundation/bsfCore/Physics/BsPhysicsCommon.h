@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
+#include "Math/BsQuaternion.h"
 
 namespace bs
 {
@@ -87,5 +88,48 @@ namespace bs
 		Collider* colliderRaw = nullptr; /**< Collider that was hit. */
 	};
 
+	/** Types of scene queries that can be executed as a part of a query batch. */
+	enum class PhysicsQueryType
+	{
+		RayCast, /**< Casts a ray along a direction. */
+		BoxCast, /**< Sweeps a box along a direction. */
+		SphereCast, /**< Sweeps a sphere along a direction. */
+		CapsuleCast, /**< Sweeps a capsule along a direction. */
+		BoxOverlap, /**< Finds colliders overlapping a box. */
+		SphereOverlap, /**< Finds colliders overlapping a sphere. */
+		CapsuleOverlap /**< Finds colliders overlapping a capsule. */
+	};
+
+	/** Describes a single scene query executed as a part of a query batch. */
+	struct PHYSICS_QUERY_DESC
+	{
+		PhysicsQueryType type = PhysicsQueryType::RayCast; /**< Type of the query to perform. */
+
+		/** Origin of the ray, or the center of the shape for shape casts and overlaps, in world space. */
+		Vector3 position = Vector3::ZERO;
+
+		/** Orientation of the box or capsule. Ignored by ray and sphere queries. */
+		Quaternion rotation = Quaternion::IDENTITY;
+
+		/** Unit direction of the ray or the shape cast. Ignored by overlap queries. */
+		Vector3 unitDir = -Vector3::UNIT_Z;
+
+		Vector3 halfExtents = Vector3::ZERO; /**< Half-size of the box, for box queries. */
+		float radius = 0.0f; /**< Radius of the sphere or capsule, for sphere and capsule queries. */
+		float halfHeight = 0.0f; /**< Half of the capsule height, not including the caps, for capsule queries. */
+
+		/** Maximum distance at which to search for hits. Ignored by overlap queries. */
+		float maxDistance = FLT_MAX;
+
+		/** Layers to consider for the query. This allows you to ignore certain groups of objects. */
+		UINT64 layer = BS_ALL_LAYERS;
+
+		/**
+		 * If true, all hits along the ray or shape cast are reported, up to the maximum number of hits per query. If
+		 * false only the closest hit is reported. Overlap queries always report all overlapping colliders.
+		 */
+		bool allHits = false;
+	};
+
 	/** @} */
 }
\ No newline at end of file
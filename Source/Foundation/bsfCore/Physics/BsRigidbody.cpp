@@ -23,6 +23,18 @@ namespace bs
 		mLinkedSO->setWorldRotation(rotation);
 	}
 
+	void Rigidbody::_getTransform(Vector3& position, Quaternion& rotation) const
+	{
+		const Transform& tfrm = mLinkedSO->getTransform();
+		position = tfrm.getPosition();
+		rotation = tfrm.getRotation();
+	}
+
+	SceneObject* Rigidbody::_getSceneObject() const
+	{
+		return mLinkedSO.get();
+	}
+
 	SPtr<Rigidbody> Rigidbody::create(const HSceneObject& linkedSO)
 	{
 		return gPhysics().createRigidbody(linkedSO);
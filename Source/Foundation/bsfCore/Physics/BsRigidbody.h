@@ -305,6 +305,15 @@ namespace bs
 		 */
 		void _setTransform(const Vector3& position, const Quaternion& rotation);
 
+		/** Returns the transform of the scene object the rigidbody is attached to, as last set by _setTransform(). */
+		void _getTransform(Vector3& position, Quaternion& rotation) const;
+
+		/** 
+		 * Returns the scene object the rigidbody is attached to. Allows the physics system to update transforms of many 
+		 * rigidbodies at once through SceneObject::_setWorldPoses().
+		 */
+		SceneObject* _getSceneObject() const;
+
 		/** 
 		 * Sets the object that owns this physics object, if any. Used for high level systems so they can easily map their
 		 * high level physics objects from the low level ones returned by various queries and events.
@@ -0,0 +1,71 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsCorePrerequisites.h"
+#include "Animation/BsAnimationCurve.h"
+#include "Image/BsColorGradient.h"
+#include "Material/BsMaterialParams.h"
+#include "Material/BsShader.h"
+#include "Utility/BsTimer.h"
+#include <iostream>
+
+namespace bs
+{
+	/** Number of parameters in the tested parameter layout. */
+	static constexpr UINT32 NUM_PARAMS = 128;
+
+	/** Number of parameter writes to measure. */
+	static constexpr UINT32 NUM_ITERATIONS = 1000000;
+
+	/** Writes every parameter through a name lookup, and then through a handle. Returns both times in milliseconds. */
+	void runMaterialParamsBenchmark(double& nameTime, double& handleTime)
+	{
+		Map<String, SHADER_DATA_PARAM_DESC> dataParams;
+		Map<String, SHADER_OBJECT_PARAM_DESC> emptyParams;
+
+		Vector<String> names;
+		for(UINT32 i = 0; i < NUM_PARAMS; i++)
+		{
+			String name = "gParam" + toString(i);
+			dataParams[name] = SHADER_DATA_PARAM_DESC(name, name, GPDT_FLOAT4);
+			names.push_back(name);
+		}
+
+		MaterialParamsBase params(dataParams, emptyParams, emptyParams, emptyParams, 1);
+
+		Vector<MaterialParamHandle<Vector4>> handles;
+		for(auto& name : names)
+			handles.push_back(MaterialParamHandle<Vector4>(name));
+
+		const Vector4 value(1.0f, 1.0f, 1.0f, 1.0f);
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			const MaterialParamsBase::ParamData* paramData = nullptr;
+			params.getParamData(names[i % NUM_PARAMS], MaterialParamsBase::ParamType::Data, GPDT_FLOAT4, 0, &paramData);
+			params.setDataParam(*paramData, 0, value);
+		}
+		nameTime = timer.getMicroseconds() / 1000.0;
+
+		timer.reset();
+		for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			params.setDataParam(handles[i % NUM_PARAMS], 0, value);
+		handleTime = timer.getMicroseconds() / 1000.0;
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	std::cout << "Writing " << NUM_ITERATIONS << " material parameters, from a layout of " << NUM_PARAMS 
+		<< " parameters." << std::endl;
+
+	double nameTime, handleTime;
+	runMaterialParamsBenchmark(nameTime, handleTime);
+
+	std::cout << "Name lookup: " << nameTime << " ms" << std::endl;
+	std::cout << "Handle: " << handleTime << " ms (" << nameTime / handleTime << "x faster)" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsCorePrerequisites.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsComponent.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Utility/BsTimer.h"
+#include <iostream>
+
+namespace bs
+{
+	/** Number of scene objects moved every update, matching the number of active rigidbodies. */
+	static constexpr UINT32 NUM_OBJECTS = 10000;
+
+	/** Number of updates to measure. */
+	static constexpr UINT32 NUM_ITERATIONS = 200;
+
+	/** Component that wants to be notified of transform changes, like the components attached to a rigidbody. */
+	class TransformListener : public Component
+	{
+	public:
+		TransformListener(const HSceneObject& parent)
+			:Component(parent)
+		{
+			setNotifyFlags(TCF_Transform);
+			setFlag(ComponentFlag::AlwaysRun, true);
+		}
+
+		UINT32 numNotifications = 0;
+
+	protected:
+		void onTransformChanged(TransformChangedFlags flags) override { numNotifications++; }
+	};
+
+	/**
+	 * Moves every object one at a time, the way Rigidbody::_setTransform() does, and then through
+	 * SceneObject::_setWorldPoses(). Returns both times in milliseconds.
+	 */
+	void runSceneObjectPosesBenchmark(double& singleTime, double& bulkTime)
+	{
+		Vector<HSceneObject> objects;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			HSceneObject so = SceneObject::create("Body");
+			so->addComponent<TransformListener>();
+
+			objects.push_back(so);
+		}
+
+		Vector<SceneObjectPose> poses(NUM_OBJECTS);
+		auto updatePoses = [&poses, &objects](UINT32 iteration)
+		{
+			for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+			{
+				const float t = (float)(i + iteration);
+				poses[i] = { objects[i].get(), Vector3(t, t * 0.5f, -t), Quaternion(Degree(t), Degree(0), Degree(0)) };
+			}
+		};
+
+		// Both methods run within the same iteration, so neither one is favored by the state of the caches or the clock
+		singleTime = 0.0;
+		bulkTime = 0.0;
+		for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			updatePoses(i * 2);
+
+			Timer timer;
+			for(auto& entry : poses)
+			{
+				entry.sceneObject->setWorldPosition(entry.position);
+				entry.sceneObject->setWorldRotation(entry.rotation);
+			}
+			singleTime += timer.getMicroseconds() / 1000.0;
+
+			updatePoses(i * 2 + 1);
+
+			timer.reset();
+			SceneObject::_setWorldPoses(poses.data(), NUM_OBJECTS);
+			bulkTime += timer.getMicroseconds() / 1000.0;
+		}
+
+		for(auto& entry : objects)
+			entry->destroy(true);
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+	GameObjectManager::startUp();
+	SceneManager::startUp();
+
+	std::cout << "Moving " << NUM_OBJECTS << " scene objects, " << NUM_ITERATIONS << " times." << std::endl;
+
+	double singleTime, bulkTime;
+	runSceneObjectPosesBenchmark(singleTime, bulkTime);
+
+	std::cout << "One at a time: " << singleTime << " ms" << std::endl;
+	std::cout << "Bulk: " << bulkTime << " ms (" << singleTime / bulkTime << "x faster)" << std::endl;
+
+	SceneManager::shutDown();
+	GameObjectManager::shutDown();
+	MemStack::endThread();
+
+	return 0;
+}
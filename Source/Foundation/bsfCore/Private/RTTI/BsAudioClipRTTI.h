@@ -49,7 +49,7 @@ namespace bs
 	public:
 		AudioClipRTTI()
 		{
-			addDataBlockField("mData", 6, &AudioClipRTTI::getData, &AudioClipRTTI::setData, 0);
+			addDataBlockField("mData", 6, &AudioClipRTTI::getData, &AudioClipRTTI::setData, RTTI_Flag_StreamedDataBlock);
 		}
 
 		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
@@ -34,6 +34,12 @@ namespace bs
 		bool& getItalic(FontImportOptions* obj) { return obj->mItalic; }
 		void setItalic(FontImportOptions* obj, bool& value) { obj->mItalic = value; }
 
+		bool& getDynamic(FontImportOptions* obj) { return obj->mDynamic; }
+		void setDynamic(FontImportOptions* obj, bool& value) { obj->mDynamic = value; }
+
+		bool& getDistanceField(FontImportOptions* obj) { return obj->mDistanceField; }
+		void setDistanceField(FontImportOptions* obj, bool& value) { obj->mDistanceField = value; }
+
 	public:
 		FontImportOptionsRTTI()
 		{
@@ -43,6 +49,8 @@ namespace bs
 			addPlainField("mRenderMode", 3, &FontImportOptionsRTTI::getRenderMode, &FontImportOptionsRTTI::setRenderMode);
 			addPlainField("mBold", 4, &FontImportOptionsRTTI::getBold, &FontImportOptionsRTTI::setBold);
 			addPlainField("mItalic", 5, &FontImportOptionsRTTI::getItalic, &FontImportOptionsRTTI::setItalic);
+			addPlainField("mDynamic", 6, &FontImportOptionsRTTI::getDynamic, &FontImportOptionsRTTI::setDynamic);
+			addPlainField("mDistanceField", 7, &FontImportOptionsRTTI::getDistanceField, &FontImportOptionsRTTI::setDistanceField);
 		}
 
 		const String& getRTTIName() override
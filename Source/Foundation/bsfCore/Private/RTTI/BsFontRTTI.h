@@ -6,6 +6,7 @@
 #include "Reflection/BsRTTIType.h"
 #include "Text/BsFont.h"
 #include "Image/BsTexture.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -25,6 +26,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(spaceWidth, 4)
 			BS_RTTI_MEMBER_REFL_ARRAY(texturePages, 5)
 			BS_RTTI_MEMBER_PLAIN(characters, 6)
+			BS_RTTI_MEMBER_PLAIN(distanceField, 7)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -85,10 +87,31 @@ namespace bs
 			initData->fontDataPerSize.resize(size);
 		}
 
+		SPtr<DataStream> getFontFileData(Font* obj, UINT32& size)
+		{
+			size = (UINT32)obj->mFontFileData.size();
+			return bs_shared_ptr_new<MemoryDataStream>(obj->mFontFileData.data(), size, false);
+		}
+
+		void setFontFileData(Font* obj, const SPtr<DataStream>& value, UINT32 size)
+		{
+			obj->mFontFileData.resize(size);
+			value->read(obj->mFontFileData.data(), size);
+		}
+
+		UINT32& getDPI(Font* obj) { return obj->mDPI; }
+		void setDPI(Font* obj, UINT32& value) { obj->mDPI = value; }
+
+		FontRenderMode& getRenderMode(Font* obj) { return obj->mRenderMode; }
+		void setRenderMode(Font* obj, FontRenderMode& value) { obj->mRenderMode = value; }
+
 	public:
 		FontRTTI()
 		{
 			addReflectableArrayField("mBitmaps", 0, &FontRTTI::getBitmap, &FontRTTI::getNumBitmaps, &FontRTTI::setBitmap, &FontRTTI::setNumBitmaps);
+			addDataBlockField("mFontFileData", 1, &FontRTTI::getFontFileData, &FontRTTI::setFontFileData);
+			addPlainField("mDPI", 2, &FontRTTI::getDPI, &FontRTTI::setDPI);
+			addPlainField("mRenderMode", 3, &FontRTTI::getRenderMode, &FontRTTI::setRenderMode);
 		}
 
 		const String& getRTTIName() override
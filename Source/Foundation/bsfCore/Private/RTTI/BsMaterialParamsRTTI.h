@@ -110,6 +110,7 @@ namespace bs
 
 			obj->mParams.push_back(param.data);
 			obj->mParamLookup[param.name] = paramIdx;
+			obj->registerParamHash(param.name, paramIdx);
 		}
 
 		UINT32 getParamDataArraySize(MaterialParams* obj)
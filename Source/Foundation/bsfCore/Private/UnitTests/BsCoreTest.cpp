@@ -3,6 +3,32 @@
 #include "Testing/BsConsoleTestOutput.h"
 #include "Testing/BsTestSuite.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Material/BsMaterialParams.h"
+#include "Material/BsShader.h"
+#include "Image/BsColorGradient.h"
+#include "Utility/BsTimer.h"
+#include "Mesh/BsMeshUtility.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "RenderAPI/BsSubMesh.h"
+#include "Debug/BsDebug.h"
+#include "Audio/BsAudioUtility.h"
+#include "Math/BsRandom.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Profiling/BsProfilingManager.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Text/BsGlyphCache.h"
+#include "Resources/BsResources.h"
+#include "Managers/BsResourceListenerManager.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Private/RTTI/BsResourceRTTI.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsComponent.h"
+#include "Scene/BsGameObjectManager.h"
 
 namespace bs
 {
@@ -11,18 +37,189 @@ namespace bs
 		return acceleration * time * time * 0.5f + velocity * time;
 	}
 
+	/**
+	 * Creates mesh data for a regular grid of quads in the XY plane, with positions and UVs set to the grid coordinates.
+	 * Vertex at (x, y) is stored at index y * (gridSize + 1) + x, followed by @p numExtraVertices uninitialized vertices.
+	 * Index buffer has room for two triangles per quad, but is left for the caller to fill.
+	 */
+	SPtr<MeshData> createGridMeshData(UINT32 gridSize, UINT32 numExtraVertices = 0)
+	{
+		const UINT32 numVertices = (gridSize + 1) * (gridSize + 1) + numExtraVertices;
+		const UINT32 numIndices = gridSize * gridSize * 6;
+
+		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD);
+
+		SPtr<MeshData> meshData = MeshData::create(numVertices, numIndices, vertexDesc);
+		UINT8* positions = meshData->getElementData(VES_POSITION);
+		UINT8* uvs = meshData->getElementData(VES_TEXCOORD);
+		const UINT32 stride = vertexDesc->getVertexStride();
+
+		for (UINT32 y = 0; y <= gridSize; y++)
+		{
+			for (UINT32 x = 0; x <= gridSize; x++)
+			{
+				UINT32 idx = y * (gridSize + 1) + x;
+				*(Vector3*)(positions + idx * stride) = Vector3((float)x, (float)y, 0.0f);
+				*(Vector2*)(uvs + idx * stride) = Vector2((float)x, (float)y);
+			}
+		}
+
+		return meshData;
+	}
+
+	/** Resource with a data block that is read on demand, same as the samples of a streaming audio clip. */
+	class TestStreamedResource : public Resource
+	{
+	public:
+		TestStreamedResource()
+			: Resource(false)
+		{ }
+
+		/** Creates a new resource referencing the provided data. */
+		static SPtr<TestStreamedResource> create(const SPtr<DataStream>& data, UINT32 size)
+		{
+			SPtr<TestStreamedResource> resource = bs_core_ptr<TestStreamedResource>(
+				new (bs_alloc<TestStreamedResource>()) TestStreamedResource());
+			resource->_setThisPtr(resource);
+			resource->mData = data;
+			resource->mDataSize = size;
+			resource->initialize();
+
+			return resource;
+		}
+
+		SPtr<DataStream> mData;
+		UINT32 mDataSize = 0;
+		UINT32 mDataOffset = 0;
+
+		friend class TestStreamedResourceRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override { return getRTTIStatic(); }
+	};
+
+	class TestStreamedResourceRTTI : public RTTIType<TestStreamedResource, Resource, TestStreamedResourceRTTI>
+	{
+	private:
+		SPtr<DataStream> getData(TestStreamedResource* obj, UINT32& size)
+		{
+			obj->mData->seek(obj->mDataOffset);
+
+			size = obj->mDataSize;
+			return obj->mData;
+		}
+
+		void setData(TestStreamedResource* obj, const SPtr<DataStream>& val, UINT32 size)
+		{
+			// Same as AudioClipRTTI, references the source stream instead of reading the data
+			obj->mData = val->clone();
+			obj->mDataSize = size;
+			obj->mDataOffset = (UINT32)val->tell();
+		}
+
+	public:
+		TestStreamedResourceRTTI()
+		{
+			addDataBlockField("mData", 0, &TestStreamedResourceRTTI::getData, &TestStreamedResourceRTTI::setData,
+				RTTI_Flag_StreamedDataBlock);
+		}
+
+		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
+		{
+			static_cast<TestStreamedResource*>(obj)->initialize();
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestStreamedResource";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return 90000;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			SPtr<TestStreamedResource> resource = bs_core_ptr<TestStreamedResource>(
+				new (bs_alloc<TestStreamedResource>()) TestStreamedResource());
+			resource->_setThisPtr(resource);
+
+			return resource;
+		}
+	};
+
+	RTTITypeBase* TestStreamedResource::getRTTIStatic()
+	{
+		return TestStreamedResourceRTTI::instance();
+	}
+
+	/** Component that counts how many times it was notified about its scene object's transform changing. */
+	class TransformCounter : public Component
+	{
+	public:
+		TransformCounter(const HSceneObject& parent)
+			:Component(parent)
+		{
+			setNotifyFlags(TCF_Transform);
+			setFlag(ComponentFlag::AlwaysRun, true);
+		}
+
+		UINT32 numNotifications = 0;
+
+	protected:
+		void onTransformChanged(TransformChangedFlags flags) override { numNotifications++; }
+	};
+
 	class CoreTestSuite : public TestSuite
 	{
 	public:
 		CoreTestSuite();
+		void startUp() override;
+		void shutDown() override;
 
 	private:
 		void testAnimCurveIntegration();
+		void testMaterialParamHandles();
+		void testMaterialParamDirtyRing();
+		void testMeshOptimization();
+		void testMeshSimplification();
+		void testAudioConversion();
+		void testProfilerSampleScopes();
+		void testProfilerSampleDepthLimit();
+		void testFrameTimeHistory();
+		void testGlyphAtlas();
+		void testStreamedResourceData();
+		void testSceneObjectWorldPoses();
 	};
 
 	CoreTestSuite::CoreTestSuite()
 	{
 		BS_ADD_TEST(CoreTestSuite::testAnimCurveIntegration);
+		BS_ADD_TEST(CoreTestSuite::testMaterialParamHandles);
+		BS_ADD_TEST(CoreTestSuite::testMaterialParamDirtyRing);
+		BS_ADD_TEST(CoreTestSuite::testMeshOptimization);
+		BS_ADD_TEST(CoreTestSuite::testMeshSimplification);
+		BS_ADD_TEST(CoreTestSuite::testAudioConversion);
+		BS_ADD_TEST(CoreTestSuite::testProfilerSampleScopes);
+		BS_ADD_TEST(CoreTestSuite::testProfilerSampleDepthLimit);
+		BS_ADD_TEST(CoreTestSuite::testFrameTimeHistory);
+		BS_ADD_TEST(CoreTestSuite::testGlyphAtlas);
+		BS_ADD_TEST(CoreTestSuite::testStreamedResourceData);
+		BS_ADD_TEST(CoreTestSuite::testSceneObjectWorldPoses);
+	}
+
+	void CoreTestSuite::startUp()
+	{
+		// Modules can't be restarted once shut down, so the ones used by multiple tests run for the entire suite
+		ProfilerCPU::startUp();
+	}
+
+	void CoreTestSuite::shutDown()
+	{
+		ProfilerCPU::shutDown();
 	}
 
 	void CoreTestSuite::testAnimCurveIntegration()
@@ -80,16 +277,1043 @@ namespace bs
 			}
 		}
 	}
+
+	void CoreTestSuite::testMaterialParamHandles()
+	{
+		static constexpr UINT32 NUM_PARAMS = 128;
+
+		Map<String, SHADER_DATA_PARAM_DESC> dataParams;
+		Map<String, SHADER_OBJECT_PARAM_DESC> emptyParams;
+
+		Vector<String> names;
+		for(UINT32 i = 0; i < NUM_PARAMS; i++)
+		{
+			String name = "gParam" + toString(i);
+			dataParams[name] = SHADER_DATA_PARAM_DESC(name, name, GPDT_FLOAT4);
+			names.push_back(name);
+		}
+
+		MaterialParamsBase params(dataParams, emptyParams, emptyParams, emptyParams, 1);
+
+		Vector<MaterialParamHandle<Vector4>> handles;
+		for(auto& name : names)
+			handles.push_back(MaterialParamHandle<Vector4>(name));
+
+		// Values written through a handle must be visible through the name lookup, and vice versa
+		for(UINT32 i = 0; i < NUM_PARAMS; i++)
+		{
+			Vector4 value((float)i, 1.0f, 2.0f, 3.0f);
+			params.setDataParam(handles[i], 0, value);
+
+			const MaterialParamsBase::ParamData* paramData = nullptr;
+			auto result = params.getParamData(names[i], MaterialParamsBase::ParamType::Data, GPDT_FLOAT4, 0, &paramData);
+			BS_TEST_ASSERT(result == MaterialParamsBase::GetParamResult::Success);
+
+			Vector4 output;
+			params.getDataParam(*paramData, 0, output);
+			BS_TEST_ASSERT(output == value);
+
+			Vector4 newValue(1.0f, 2.0f, 3.0f, (float)i);
+			params.setDataParam(*paramData, 0, newValue);
+			params.getDataParam(handles[i], 0, output);
+			BS_TEST_ASSERT(output == newValue);
+		}
+
+		// Handles keep their own copy of the name, and remain usable after the string they were created from is gone
+		MaterialParamHandle<Vector4>* tempNameHandle;
+		{
+			String tempName = "gParam" + toString(7);
+			tempNameHandle = bs_new<MaterialParamHandle<Vector4>>(tempName);
+		}
+
+		BS_TEST_ASSERT(tempNameHandle->getName() == StringID("gParam7"));
+		BS_TEST_ASSERT(tempNameHandle->getNameHash() == MaterialParamHandleBase::hashName("gParam7"));
+
+		Vector4 output;
+		params.getDataParam(*tempNameHandle, 0, output);
+		BS_TEST_ASSERT(output == Vector4(1.0f, 2.0f, 3.0f, 7.0f));
+		bs_delete(tempNameHandle);
+
+		// Objects with the same layout share the resolved index, while a different layout re-resolves the handle
+		MaterialParamsBase sameLayoutParams(dataParams, emptyParams, emptyParams, emptyParams, 1);
+		sameLayoutParams.setDataParam(handles[5], 0, Vector4(5.0f, 5.0f, 5.0f, 5.0f));
+
+		Map<String, SHADER_DATA_PARAM_DESC> otherDataParams;
+		otherDataParams["gOther"] = SHADER_DATA_PARAM_DESC("gOther", "gOther", GPDT_FLOAT4);
+		otherDataParams[names[5]] = SHADER_DATA_PARAM_DESC(names[5], names[5], GPDT_FLOAT4);
+
+		MaterialParamsBase otherLayoutParams(otherDataParams, emptyParams, emptyParams, emptyParams, 2);
+		otherLayoutParams.setDataParam(handles[5], 0, Vector4(6.0f, 6.0f, 6.0f, 6.0f));
+
+		const MaterialParamsBase::ParamData* paramData = nullptr;
+		otherLayoutParams.getParamData(names[5], MaterialParamsBase::ParamType::Data, GPDT_FLOAT4, 0, &paramData);
+		otherLayoutParams.getDataParam(*paramData, 0, output);
+		BS_TEST_ASSERT(output == Vector4(6.0f, 6.0f, 6.0f, 6.0f));
+
+		sameLayoutParams.getDataParam(handles[5], 0, output);
+		BS_TEST_ASSERT(output == Vector4(5.0f, 5.0f, 5.0f, 5.0f));
+
+		// "costarring" and "liquid" have the same FNV-1a hash. Handles must only resolve to the parameter with the
+		// matching name.
+		static_assert(MaterialParamHandleBase::hashName("costarring") == MaterialParamHandleBase::hashName("liquid"), "");
+
+		MaterialParamHandle<Vector4> collidingHandleA("costarring");
+		MaterialParamHandle<Vector4> collidingHandleB("liquid");
+		UINT32 paramIdx = (UINT32)-1;
+
+		Map<String, SHADER_DATA_PARAM_DESC> singleCollidingParams;
+		singleCollidingParams["liquid"] = SHADER_DATA_PARAM_DESC("liquid", "liquid", GPDT_FLOAT4);
+
+		MaterialParamsBase singleCollidingParamsObj(singleCollidingParams, emptyParams, emptyParams, emptyParams, 3);
+		BS_TEST_ASSERT(singleCollidingParamsObj.getParamIndex(collidingHandleA, MaterialParamsBase::ParamType::Data, 
+			GPDT_FLOAT4, 0, paramIdx) == MaterialParamsBase::GetParamResult::NotFound);
+		BS_TEST_ASSERT(singleCollidingParamsObj.getParamIndex(collidingHandleB, MaterialParamsBase::ParamType::Data, 
+			GPDT_FLOAT4, 0, paramIdx) == MaterialParamsBase::GetParamResult::Success);
+		BS_TEST_ASSERT(paramIdx == singleCollidingParamsObj.getParamIndex("liquid"));
+
+		Map<String, SHADER_DATA_PARAM_DESC> collidingParams = singleCollidingParams;
+		collidingParams["costarring"] = SHADER_DATA_PARAM_DESC("costarring", "costarring", GPDT_FLOAT4);
+
+		MaterialParamsBase collidingParamsObj(collidingParams, emptyParams, emptyParams, emptyParams, 4);
+		BS_TEST_ASSERT(collidingParamsObj.getParamIndex(collidingHandleA, MaterialParamsBase::ParamType::Data, 
+			GPDT_FLOAT4, 0, paramIdx) == MaterialParamsBase::GetParamResult::Success);
+		BS_TEST_ASSERT(paramIdx == collidingParamsObj.getParamIndex("costarring"));
+		BS_TEST_ASSERT(collidingParamsObj.getParamIndex(collidingHandleB, MaterialParamsBase::ParamType::Data, 
+			GPDT_FLOAT4, 0, paramIdx) == MaterialParamsBase::GetParamResult::Success);
+		BS_TEST_ASSERT(paramIdx == collidingParamsObj.getParamIndex("liquid"));
+	}
+
+	void CoreTestSuite::testMaterialParamDirtyRing()
+	{
+		static constexpr UINT32 NUM_PARAMS = 8;
+
+		Map<String, SHADER_DATA_PARAM_DESC> dataParams;
+		Map<String, SHADER_OBJECT_PARAM_DESC> emptyParams;
+
+		for(UINT32 i = 0; i < NUM_PARAMS; i++)
+		{
+			String name = "gParam" + toString(i);
+			dataParams[name] = SHADER_DATA_PARAM_DESC(name, name, GPDT_FLOAT4);
+		}
+
+		MaterialParamsBase params(dataParams, emptyParams, emptyParams, emptyParams, 1);
+
+		Vector<UINT32> paramIndices;
+		for(UINT32 i = 0; i < NUM_PARAMS; i++)
+			paramIndices.push_back(params.getParamIndex("gParam" + toString(i)));
+
+		auto setParam = [&](UINT32 i, float value)
+		{
+			params.setDataParam(*params.getParamData(paramIndices[i]), 0, Vector4(value, value, value, value));
+		};
+
+		auto getDirtyParams = [&](UINT64 lastVersion)
+		{
+			Vector<UINT32> output;
+			params.forEachDirtyParam(lastVersion, false, [&](UINT32 paramIdx) { output.push_back(paramIdx); });
+
+			std::sort(output.begin(), output.end());
+			return output;
+		};
+
+		// Nothing modified, nothing reported
+		UINT64 lastVersion = params.getParamVersion();
+		BS_TEST_ASSERT(getDirtyParams(lastVersion).empty());
+
+		// Setting the same parameter repeatedly reports it only once
+		for(UINT32 i = 0; i < 10; i++)
+			setParam(3, (float)i);
+
+		BS_TEST_ASSERT(params.isDirtyRingValid(lastVersion));
+
+		Vector<UINT32> dirtyParams = getDirtyParams(lastVersion);
+		BS_TEST_ASSERT(dirtyParams.size() == 1 && dirtyParams[0] == paramIndices[3]);
+
+		// Only the parameters modified since the provided version are reported, as the sync data would contain
+		lastVersion = params.getParamVersion();
+		setParam(1, 1.0f);
+		setParam(5, 1.0f);
+		setParam(1, 2.0f);
+
+		dirtyParams = getDirtyParams(lastVersion);
+		Vector<UINT32> expectedParams = { paramIndices[1], paramIndices[5] };
+		std::sort(expectedParams.begin(), expectedParams.end());
+		BS_TEST_ASSERT(dirtyParams == expectedParams);
+
+		// All parameters are reported when forced, whether modified or not
+		UINT32 numForced = 0;
+		params.forEachDirtyParam(params.getParamVersion(), true, [&](UINT32 paramIdx) { numForced++; });
+		BS_TEST_ASSERT(numForced == NUM_PARAMS);
+
+		// When more modifications happen than the ring can hold, fall back to checking every parameter, and still report
+		// each modified parameter exactly once
+		lastVersion = params.getParamVersion();
+		for(UINT32 i = 0; i < MaterialParamsBase::DIRTY_PARAM_RING_SIZE * 2; i++)
+			setParam(i % 2 == 0 ? 2 : 6, (float)i);
+
+		BS_TEST_ASSERT(!params.isDirtyRingValid(lastVersion));
+
+		dirtyParams = getDirtyParams(lastVersion);
+		expectedParams = { paramIndices[2], paramIndices[6] };
+		std::sort(expectedParams.begin(), expectedParams.end());
+		BS_TEST_ASSERT(dirtyParams == expectedParams);
+
+		// Ring covers the range again once the caller catches up
+		lastVersion = params.getParamVersion();
+		setParam(0, 1.0f);
+
+		BS_TEST_ASSERT(params.isDirtyRingValid(lastVersion));
+
+		dirtyParams = getDirtyParams(lastVersion);
+		BS_TEST_ASSERT(dirtyParams.size() == 1 && dirtyParams[0] == paramIndices[0]);
+	}
+
+	void CoreTestSuite::testMeshOptimization()
+	{
+		// Regular grid with triangles in shuffled order
+		constexpr UINT32 GRID_SIZE = 32;
+		constexpr UINT32 NUM_VERTICES = (GRID_SIZE + 1) * (GRID_SIZE + 1);
+		constexpr UINT32 NUM_INDICES = GRID_SIZE * GRID_SIZE * 6;
+
+		SPtr<MeshData> meshData = createGridMeshData(GRID_SIZE);
+		Vector3* positions = (Vector3*)meshData->getElementData(VES_POSITION);
+		Vector2* uvs = (Vector2*)meshData->getElementData(VES_TEXCOORD);
+		const UINT32 stride = meshData->getVertexDesc()->getVertexStride();
+
+		Vector<UINT32> tris;
+		for (UINT32 y = 0; y < GRID_SIZE; y++)
+		{
+			for (UINT32 x = 0; x < GRID_SIZE; x++)
+			{
+				UINT32 idx = y * (GRID_SIZE + 1) + x;
+				tris.push_back(idx);
+				tris.push_back(idx + GRID_SIZE + 1);
+				tris.push_back(idx + 1);
+			}
+		}
+
+		UINT32* indices = meshData->getIndices32();
+		UINT32 seed = 12345;
+		Vector<UINT32> order(tris.size() / 3 * 2);
+		for (UINT32 i = 0; i < (UINT32)order.size(); i++)
+			order[i] = i;
+
+		for (UINT32 i = (UINT32)order.size() - 1; i > 0; i--)
+		{
+			seed = seed * 1664525 + 1013904223;
+			std::swap(order[i], order[seed % (i + 1)]);
+		}
+
+		for (UINT32 i = 0; i < (UINT32)order.size(); i++)
+		{
+			UINT32 quadIdx = order[i] / 2;
+			const UINT32* tri = &tris[quadIdx * 3];
+			if (order[i] % 2 == 0)
+			{
+				indices[i * 3 + 0] = tri[0];
+				indices[i * 3 + 1] = tri[1];
+				indices[i * 3 + 2] = tri[2];
+			}
+			else
+			{
+				indices[i * 3 + 0] = tri[2];
+				indices[i * 3 + 1] = tri[1];
+				indices[i * 3 + 2] = tri[1] + 1;
+			}
+		}
+
+		// Remember all triangles by their positions, as the vertices get reordered
+		auto getTriangleSet = [&]()
+		{
+			Vector<Vector<float>> output;
+			for (UINT32 i = 0; i < NUM_INDICES / 3; i++)
+			{
+				Vector<float> tri;
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					UINT32 vertIdx = indices[i * 3 + j];
+					Vector3 position = *(Vector3*)((UINT8*)positions + vertIdx * stride);
+					Vector2 uv = *(Vector2*)((UINT8*)uvs + vertIdx * stride);
+
+					tri.push_back(position.x); tri.push_back(position.y);
+					tri.push_back(uv.x); tri.push_back(uv.y);
+				}
+
+				output.push_back(tri);
+			}
+
+			std::sort(output.begin(), output.end());
+			return output;
+		};
+
+		Vector<Vector<float>> trianglesBefore = getTriangleSet();
+
+		Vector<SubMesh> subMeshes = { SubMesh(0, NUM_INDICES, DOT_TRIANGLE_LIST) };
+		MeshOptimizationStats stats = MeshUtility::optimize(*meshData, subMeshes);
+
+		BS_TEST_ASSERT(stats.acmrAfter < stats.acmrBefore);
+		BS_TEST_ASSERT(stats.acmrAfter < 1.0f);
+		BS_TEST_ASSERT(Math::approxEquals(stats.acmrAfter, 
+			MeshUtility::calculateACMR((UINT8*)indices, NUM_INDICES, NUM_VERTICES)));
+
+		// Same triangles, with the same winding order, must be present after optimization
+		BS_TEST_ASSERT(getTriangleSet() == trianglesBefore);
+
+		// Vertices must be ordered by first use
+		UINT32 maxVertIdx = 0;
+		bool orderedByUse = true;
+		for (UINT32 i = 0; i < NUM_INDICES; i++)
+		{
+			if (indices[i] > maxVertIdx + 1)
+				orderedByUse = false;
+
+			maxVertIdx = std::max(maxVertIdx, indices[i]);
+		}
+
+		BS_TEST_ASSERT(indices[0] == 0 && orderedByUse);
+	}
+
+	void CoreTestSuite::testMeshSimplification()
+	{
+		// Flat grid with a UV seam running through the middle column, where vertices are duplicated with different UVs
+		constexpr UINT32 GRID_SIZE = 32;
+		constexpr UINT32 SEAM_X = GRID_SIZE / 2;
+		constexpr UINT32 NUM_GRID_VERTICES = (GRID_SIZE + 1) * (GRID_SIZE + 1);
+		constexpr UINT32 NUM_VERTICES = NUM_GRID_VERTICES + GRID_SIZE + 1;
+		constexpr UINT32 NUM_INDICES = GRID_SIZE * GRID_SIZE * 6;
+
+		SPtr<MeshData> meshData = createGridMeshData(GRID_SIZE, GRID_SIZE + 1);
+		UINT8* positions = meshData->getElementData(VES_POSITION);
+		UINT8* uvs = meshData->getElementData(VES_TEXCOORD);
+		const UINT32 stride = meshData->getVertexDesc()->getVertexStride();
+
+		for (UINT32 y = 0; y <= GRID_SIZE; y++)
+		{
+			UINT32 seamIdx = NUM_GRID_VERTICES + y;
+			*(Vector3*)(positions + seamIdx * stride) = Vector3((float)SEAM_X, (float)y, 0.0f);
+			*(Vector2*)(uvs + seamIdx * stride) = Vector2(0.0f, (float)y);
+		}
+
+		// Quads right of the seam use the duplicated vertices
+		auto getVertex = [](UINT32 x, UINT32 y, bool rightOfSeam)
+		{
+			if (rightOfSeam && x == SEAM_X)
+				return NUM_GRID_VERTICES + y;
+
+			return y * (GRID_SIZE + 1) + x;
+		};
+
+		UINT32* indices = meshData->getIndices32();
+		UINT32 numIndices = 0;
+		for (UINT32 y = 0; y < GRID_SIZE; y++)
+		{
+			for (UINT32 x = 0; x < GRID_SIZE; x++)
+			{
+				bool rightOfSeam = x >= SEAM_X;
+
+				indices[numIndices++] = getVertex(x, y, rightOfSeam);
+				indices[numIndices++] = getVertex(x + 1, y, rightOfSeam);
+				indices[numIndices++] = getVertex(x, y + 1, rightOfSeam);
+
+				indices[numIndices++] = getVertex(x + 1, y, rightOfSeam);
+				indices[numIndices++] = getVertex(x + 1, y + 1, rightOfSeam);
+				indices[numIndices++] = getVertex(x, y + 1, rightOfSeam);
+			}
+		}
+
+		const UINT32 targetNumIndices = NUM_INDICES / 4 / 3 * 3;
+		Vector<UINT32> output(NUM_INDICES);
+		float error = 0.0f;
+		UINT32 numOutputIndices = MeshUtility::simplify(*meshData, (UINT8*)indices, NUM_INDICES, (UINT8*)output.data(), 
+			targetNumIndices, 0.01f, &error);
+
+		// Flat surface can be simplified to the target without any error
+		BS_TEST_ASSERT(numOutputIndices <= targetNumIndices);
+		BS_TEST_ASSERT(numOutputIndices % 3 == 0 && numOutputIndices > 0);
+		BS_TEST_ASSERT(error < 0.001f);
+
+		// No triangle may flip, and seam vertices must not move
+		Vector<bool> used(NUM_VERTICES, false);
+		for (UINT32 i = 0; i < numOutputIndices; i += 3)
+		{
+			Vector3 a = *(Vector3*)(positions + output[i + 0] * stride);
+			Vector3 b = *(Vector3*)(positions + output[i + 1] * stride);
+			Vector3 c = *(Vector3*)(positions + output[i + 2] * stride);
+
+			BS_TEST_ASSERT((b - a).cross(c - a).z > 0.0f);
+
+			for (UINT32 j = 0; j < 3; j++)
+				used[output[i + j]] = true;
+		}
+
+		for (UINT32 y = 0; y <= GRID_SIZE; y++)
+			BS_TEST_ASSERT(used[getVertex(SEAM_X, y, false)] && used[getVertex(SEAM_X, y, true)]);
+
+		// Level of detail chain appends indices after the original ones
+		Vector<SubMesh> subMeshes = { SubMesh(0, NUM_INDICES, DOT_TRIANGLE_LIST) };
+		Vector<MeshLOD> lods;
+		SPtr<MeshData> lodMeshData = MeshUtility::generateLODs(meshData, subMeshes, 3, 0.5f, 0.01f, lods);
+
+		BS_TEST_ASSERT(!lods.empty());
+		BS_TEST_ASSERT(lodMeshData->getNumVertices() == NUM_VERTICES);
+
+		// Levels of a flat surface don't introduce any error, so they can be used at any size
+		UINT32 expectedOffset = NUM_INDICES;
+		for (auto& lod : lods)
+		{
+			BS_TEST_ASSERT(lod.subMeshes.size() == 1);
+			BS_TEST_ASSERT(lod.subMeshes[0].indexOffset == expectedOffset);
+			BS_TEST_ASSERT(lod.screenSize >= 1.0f);
+
+			expectedOffset += lod.subMeshes[0].indexCount;
+		}
+
+		BS_TEST_ASSERT(lodMeshData->getNumIndices() == expectedOffset);
+
+		// Levels of a curved surface are less accurate the more they are simplified, and must only be used at
+		// progressively smaller sizes
+		SPtr<MeshData> curvedMeshData = createGridMeshData(GRID_SIZE);
+		UINT8* curvedPositions = curvedMeshData->getElementData(VES_POSITION);
+		for (UINT32 i = 0; i < (GRID_SIZE + 1) * (GRID_SIZE + 1); i++)
+		{
+			Vector3& position = *(Vector3*)(curvedPositions + i * stride);
+			position.z = std::sin(position.x * 0.2f) * std::cos(position.y * 0.2f) * 2.0f;
+		}
+
+		UINT32* curvedIndices = curvedMeshData->getIndices32();
+		numIndices = 0;
+		for (UINT32 y = 0; y < GRID_SIZE; y++)
+		{
+			for (UINT32 x = 0; x < GRID_SIZE; x++)
+			{
+				curvedIndices[numIndices++] = getVertex(x, y, false);
+				curvedIndices[numIndices++] = getVertex(x + 1, y, false);
+				curvedIndices[numIndices++] = getVertex(x, y + 1, false);
+
+				curvedIndices[numIndices++] = getVertex(x + 1, y, false);
+				curvedIndices[numIndices++] = getVertex(x + 1, y + 1, false);
+				curvedIndices[numIndices++] = getVertex(x, y + 1, false);
+			}
+		}
+
+		Vector<MeshLOD> curvedLods;
+		MeshUtility::generateLODs(curvedMeshData, subMeshes, 3, 0.5f, 0.02f, curvedLods);
+		BS_TEST_ASSERT(!curvedLods.empty());
+
+		float prevScreenSize = std::numeric_limits<float>::max();
+		for (auto& lod : curvedLods)
+		{
+			BS_TEST_ASSERT(lod.screenSize > 0.0f && lod.screenSize < prevScreenSize);
+			prevScreenSize = lod.screenSize;
+		}
+	}
+
+	void CoreTestSuite::testAudioConversion()
+	{
+		// Lengths chosen to exercise both vectorized loops and their scalar remainders, as well as buffers large enough
+		// to be split between workers in parallel mode
+		const UINT32 bitDepths[] = { 8, 16, 24, 32 };
+		const UINT32 numFrames[] = { 1, 5, 1023, 4099, 70001 };
+		const AudioConversionMode modes[] = { AudioConversionMode::Default, AudioConversionMode::Parallel };
+
+		// Parallel mode falls back to the calling thread without a task scheduler. Make sure there are enough workers
+		// for the large buffers to be split even on machines with few cores.
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(4);
+		TaskScheduler::startUp();
+		while (TaskScheduler::instance().getNumWorkers() < 4)
+			TaskScheduler::instance().addWorker();
+
+		bool anySplit = false;
+		Random random(1234);
+		for (auto bitDepth : bitDepths)
+		{
+			const UINT32 bytesPerSample = bitDepth / 8;
+			for (UINT32 numChannels = 1; numChannels <= 8; numChannels++)
+			{
+				for (auto frames : numFrames)
+				{
+					const UINT32 numSamples = frames * numChannels;
+
+					Vector<UINT8> input(numSamples * bytesPerSample);
+					for (auto& entry : input)
+						entry = (UINT8)random.get();
+
+					// Make sure the extremes are covered
+					memset(input.data(), 0x80, bytesPerSample);
+					memset(input.data() + (numSamples - 1) * bytesPerSample, 0x7F, bytesPerSample);
+
+					Vector<UINT8> monoRef(frames * bytesPerSample);
+					AudioUtility::convertToMono(input.data(), monoRef.data(), bitDepth, frames, numChannels,
+						AudioConversionMode::Reference);
+
+					Vector<float> floatRef(numSamples);
+					AudioUtility::convertToFloat(input.data(), bitDepth, floatRef.data(), numSamples,
+						AudioConversionMode::Reference);
+
+					for (auto mode : modes)
+					{
+						// Anything over the minimum per-worker workload of 64K samples should get split
+						UINT32 numTasks = AudioUtility::_getNumConversionTasks(numSamples, mode);
+						if (mode == AudioConversionMode::Parallel && numSamples > 64 * 1024)
+							BS_TEST_ASSERT(numTasks > 1);
+
+						anySplit |= numTasks > 1;
+
+						Vector<UINT8> mono(frames * bytesPerSample);
+						AudioUtility::convertToMono(input.data(), mono.data(), bitDepth, frames, numChannels, mode);
+						BS_TEST_ASSERT(mono == monoRef);
+
+						Vector<float> floats(numSamples);
+						AudioUtility::convertToFloat(input.data(), bitDepth, floats.data(), numSamples, mode);
+						BS_TEST_ASSERT(memcmp(floats.data(), floatRef.data(), numSamples * sizeof(float)) == 0);
+
+						for (auto outBitDepth : bitDepths)
+						{
+							const UINT32 outSize = numSamples * (outBitDepth / 8);
+
+							Vector<UINT8> convertedRef(outSize);
+							AudioUtility::convertBitDepth(input.data(), bitDepth, convertedRef.data(), outBitDepth,
+								numSamples, AudioConversionMode::Reference);
+
+							Vector<UINT8> converted(outSize);
+							AudioUtility::convertBitDepth(input.data(), bitDepth, converted.data(), outBitDepth, numSamples,
+								mode);
+							BS_TEST_ASSERT(converted == convertedRef);
+						}
+					}
+				}
+			}
+		}
+
+		BS_TEST_ASSERT(anySplit);
+
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	void CoreTestSuite::testProfilerSampleScopes()
+	{
+		BS_TEST_ASSERT(ProfilerCPU::registerSample("TestOuter") == ProfilerCPU::registerSample("TestOuter"));
+		BS_TEST_ASSERT(ProfilerCPU::registerSample("TestOuter") != ProfilerCPU::registerSample("TestInner"));
+
+		// Run multiple frames to ensure the hierarchy gets rebuilt properly after a reset
+		for(UINT32 frame = 0; frame < 2; frame++)
+		{
+			gProfilerCPU().beginThread("TestThread");
+
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				PROFILE_SCOPE("TestOuter");
+
+				{
+					PROFILE_SCOPE("TestInner");
+
+					// Allocated bytes are attributed to the innermost active sample
+					bs_free(bs_alloc(1000));
+				}
+
+				// String and ID based samples with the same name must end up in the same node
+				gProfilerCPU().beginSample("TestInner");
+				gProfilerCPU().endSample("TestInner");
+
+				gProfilerCPU().beginSamplePrecise("TestPrecise");
+				gProfilerCPU().endSamplePrecise("TestPrecise");
+			}
+
+			gProfilerCPU().endThread();
+
+			CPUProfilerReport report = gProfilerCPU().generateReport();
+			gProfilerCPU().reset();
+
+			const CPUProfilerBasicSamplingEntry& root = report.getBasicSamplingData();
+			BS_TEST_ASSERT(root.data.name == "TestThread");
+			BS_TEST_ASSERT(root.data.numCalls == 1);
+			BS_TEST_ASSERT(root.childEntries.size() == 1);
+
+			if(root.childEntries.size() == 1)
+			{
+				const CPUProfilerBasicSamplingEntry& outer = root.childEntries[0];
+				BS_TEST_ASSERT(outer.data.name == "TestOuter");
+				BS_TEST_ASSERT(outer.data.numCalls == 3);
+				BS_TEST_ASSERT(outer.data.totalTimeMs <= root.data.totalTimeMs);
+				BS_TEST_ASSERT(outer.childEntries.size() == 1);
+
+				if(outer.childEntries.size() == 1)
+				{
+					BS_TEST_ASSERT(outer.childEntries[0].data.name == "TestInner");
+					BS_TEST_ASSERT(outer.childEntries[0].data.numCalls == 6);
+					BS_TEST_ASSERT(outer.childEntries[0].data.memAllocBytes[(int)MemoryCategory::General] >= 3000);
+				}
+			}
+
+			const CPUProfilerPreciseSamplingEntry& preciseRoot = report.getPreciseSamplingData();
+			BS_TEST_ASSERT(preciseRoot.childEntries.size() == 1);
+
+			if(preciseRoot.childEntries.size() == 1)
+			{
+				BS_TEST_ASSERT(preciseRoot.childEntries[0].data.name == "TestPrecise");
+				BS_TEST_ASSERT(preciseRoot.childEntries[0].data.numCalls == 3);
+			}
+		}
+	}
+
+	void CoreTestSuite::testProfilerSampleDepthLimit()
+	{
+		// Deeper than the per-thread sample stack, so some of the samples get dropped
+		static constexpr UINT32 NUM_NESTED = 200;
+
+		gProfilerCPU().beginThread("TestThread");
+		{
+			PROFILE_SCOPE("TestOuter");
+
+			for(UINT32 i = 0; i < NUM_NESTED; i++)
+				gProfilerCPU().beginSample("TestDeep");
+
+			for(UINT32 i = 0; i < NUM_NESTED; i++)
+				gProfilerCPU().endSample("TestDeep");
+
+			// Dropped samples must not end any of the samples that were started before them
+			gProfilerCPU().beginSample("TestAfter");
+			gProfilerCPU().endSample("TestAfter");
+		}
+		gProfilerCPU().endThread();
+
+		CPUProfilerReport report = gProfilerCPU().generateReport();
+		gProfilerCPU().reset();
+
+		const CPUProfilerBasicSamplingEntry& root = report.getBasicSamplingData();
+		BS_TEST_ASSERT(root.data.name == "TestThread");
+		BS_TEST_ASSERT(root.childEntries.size() == 1);
+
+		if(root.childEntries.size() == 1)
+		{
+			const CPUProfilerBasicSamplingEntry& outer = root.childEntries[0];
+			BS_TEST_ASSERT(outer.data.name == "TestOuter");
+			BS_TEST_ASSERT(outer.data.numCalls == 1);
+			BS_TEST_ASSERT(outer.childEntries.size() == 2);
+
+			if(outer.childEntries.size() == 2)
+			{
+				BS_TEST_ASSERT(outer.childEntries[0].data.name == "TestDeep");
+				BS_TEST_ASSERT(outer.childEntries[1].data.name == "TestAfter");
+				BS_TEST_ASSERT(outer.childEntries[1].data.numCalls == 1);
+			}
+		}
+
+		// The thread must still be usable after the overflow
+		gProfilerCPU().beginThread("TestThread");
+		gProfilerCPU().beginSample("TestAfter");
+		gProfilerCPU().endSample("TestAfter");
+		gProfilerCPU().endThread();
+
+		report = gProfilerCPU().generateReport();
+		gProfilerCPU().reset();
+
+		BS_TEST_ASSERT(report.getBasicSamplingData().childEntries.size() == 1);
+	}
+
+	void CoreTestSuite::testFrameTimeHistory()
+	{
+		ProfilingManager::startUp();
+
+		gProfiler().trackSample(ProfiledThread::Sim, "TestWork");
+		gProfiler().setSpikeThreshold(4.0f, 5.0f);
+
+		auto spin = [](double ms)
+		{
+			Timer timer;
+			while(timer.getMicroseconds() < (UINT64)(ms * 1000.0))
+				;
+		};
+
+		// Steady frames followed by a single frame that is much slower
+		const UINT32 numFrames = 60;
+		for(UINT32 i = 0; i < numFrames; i++)
+		{
+			gProfilerCPU().beginThread("TestSim");
+
+			{
+				PROFILE_SCOPE("TestWork");
+				spin(i == numFrames - 1 ? 40.0 : 0.5);
+			}
+
+			gProfilerCPU().endThread();
+			gProfiler()._update();
+		}
+
+		// Sample times are measured in timestamp counter ticks, and converted to milliseconds using the tick rate calibrated
+		// against the system clock, so they can't be shorter than the spin. Only allow for a small error in that rate
+		// (0.25%, the worst case of a ~10 us calibration skew over the ~40 ms the profiler runs before the slow frame).
+		const float minSlowFrameMs = 40.0f - 0.1f;
+
+		FrameTimeStats frameStats = gProfiler().getFrameTimeStats(FrameTimeSeries::SimCPU);
+		BS_TEST_ASSERT(frameStats.numFrames == numFrames);
+		BS_TEST_ASSERT(frameStats.p50 <= frameStats.p95 && frameStats.p95 <= frameStats.p99);
+		BS_TEST_ASSERT(frameStats.p99 <= frameStats.max);
+		BS_TEST_ASSERT(frameStats.max >= minSlowFrameMs);
+		BS_TEST_ASSERT(frameStats.p50 < 20.0f);
+
+		FrameTimeStats sampleStats = gProfiler().getSampleTimeStats(ProfiledThread::Sim, "TestWork");
+		BS_TEST_ASSERT(sampleStats.numFrames == numFrames);
+		BS_TEST_ASSERT(sampleStats.max >= minSlowFrameMs);
+
+		Vector<float> history;
+		gProfiler().getSampleTimeHistory(ProfiledThread::Sim, "TestWork", history);
+		BS_TEST_ASSERT(history.size() == numFrames);
+		BS_TEST_ASSERT(!history.empty() && history.back() >= minSlowFrameMs);
+
+		Vector<FrameSpike> spikes = gProfiler().getSpikes();
+		BS_TEST_ASSERT(!spikes.empty());
+
+		if(!spikes.empty())
+		{
+			const FrameSpike& spike = spikes.back();
+			BS_TEST_ASSERT(spike.series == FrameTimeSeries::SimCPU);
+			BS_TEST_ASSERT(spike.frameIdx == numFrames - 1);
+			BS_TEST_ASSERT(spike.cpuReport.getBasicSamplingData().data.name == "TestSim");
+			BS_TEST_ASSERT(spike.cpuReport.getBasicSamplingData().childEntries.size() == 1);
+		}
+
+		ProfilingManager::shutDown();
+	}
+
+	void CoreTestSuite::testGlyphAtlas()
+	{
+		// Each page fits four glyphs
+		static constexpr UINT32 PAGE_SIZE = 64;
+		static constexpr UINT32 GLYPH_SIZE = 32;
+
+		GlyphAtlas atlas(PAGE_SIZE, 2);
+		atlas.addPage(0);
+		atlas.clearDirtyRect(0);
+
+		Vector<GlyphAtlas::GlyphKey> evictedGlyphs;
+		UINT32 pageIdx, x, y;
+
+		// Glyphs are packed into the existing page, and only their area is marked as modified
+		UINT64 frameIdx = 1;
+		BS_TEST_ASSERT(atlas.allocate({ 10, 0 }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::Allocated);
+		BS_TEST_ASSERT(pageIdx == 0);
+		BS_TEST_ASSERT(atlas.getDirtyRect(0) == Rect2I((INT32)x, (INT32)y, GLYPH_SIZE, GLYPH_SIZE));
+
+		Rect2I firstGlyphArea = atlas.getDirtyRect(0);
+		BS_TEST_ASSERT(atlas.allocate({ 10, 1 }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::Allocated);
+		BS_TEST_ASSERT(pageIdx == 0);
+
+		Rect2I bothGlyphsArea = firstGlyphArea;
+		bothGlyphsArea.encapsulate(Rect2I((INT32)x, (INT32)y, GLYPH_SIZE, GLYPH_SIZE));
+		BS_TEST_ASSERT(atlas.getDirtyRect(0) == bothGlyphsArea);
+		BS_TEST_ASSERT(bothGlyphsArea.width * bothGlyphsArea.height < PAGE_SIZE * PAGE_SIZE);
+
+		for (UINT32 i = 2; i < 4; i++)
+		{
+			BS_TEST_ASSERT(atlas.allocate({ 10, i }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+				GlyphAllocResult::Allocated);
+		}
+
+		// Glyphs larger than a page never fit
+		BS_TEST_ASSERT(atlas.allocate({ 10, 100 }, PAGE_SIZE + 1, 1, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::Failed);
+
+		// New pages are added until the limit is reached, and are uploaded in full
+		BS_TEST_ASSERT(atlas.allocate({ 10, 4 }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::AddedPage);
+		BS_TEST_ASSERT(pageIdx == 1 && atlas.getNumPages() == 2);
+		BS_TEST_ASSERT(atlas.getDirtyRect(1) == Rect2I(0, 0, PAGE_SIZE, PAGE_SIZE));
+
+		for (UINT32 i = 5; i < 8; i++)
+		{
+			BS_TEST_ASSERT(atlas.allocate({ 10, i }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+				GlyphAllocResult::Allocated);
+			BS_TEST_ASSERT(pageIdx == 1);
+		}
+
+		atlas.clearDirtyRect(0);
+		atlas.clearDirtyRect(1);
+		BS_TEST_ASSERT(evictedGlyphs.empty());
+
+		// Once full, the least recently used page is evicted and reused
+		frameIdx = 2;
+		atlas.markUsed(1, frameIdx);
+
+		BS_TEST_ASSERT(atlas.allocate({ 12, 0 }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::EvictedPage);
+		BS_TEST_ASSERT(pageIdx == 0 && atlas.getNumPages() == 2);
+		BS_TEST_ASSERT(evictedGlyphs.size() == 4);
+		for (UINT32 i = 0; i < (UINT32)evictedGlyphs.size(); i++)
+			BS_TEST_ASSERT(evictedGlyphs[i] == GlyphAtlas::GlyphKey(10, i));
+
+		BS_TEST_ASSERT(atlas.getDirtyRect(0) == Rect2I(0, 0, PAGE_SIZE, PAGE_SIZE));
+		BS_TEST_ASSERT(atlas.getDirtyRect(1).width == 0);
+		evictedGlyphs.clear();
+
+		for (UINT32 i = 1; i < 4; i++)
+		{
+			BS_TEST_ASSERT(atlas.allocate({ 12, i }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+				GlyphAllocResult::Allocated);
+			BS_TEST_ASSERT(pageIdx == 0);
+		}
+
+		// Pinned pages and pages used during the current frame are never evicted, the limit is exceeded instead
+		frameIdx = 3;
+		atlas.addRef(0);
+		atlas.markUsed(1, frameIdx);
+
+		BS_TEST_ASSERT(atlas.allocate({ 14, 0 }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::AddedPage);
+		BS_TEST_ASSERT(pageIdx == 2 && atlas.getNumPages() == 3);
+		BS_TEST_ASSERT(evictedGlyphs.empty());
+
+		// Pages above the limit are only removed once they are no longer used
+		BS_TEST_ASSERT(!atlas.removeExcessPage(frameIdx, evictedGlyphs));
+
+		frameIdx = 4;
+		BS_TEST_ASSERT(atlas.removeExcessPage(frameIdx, evictedGlyphs));
+		BS_TEST_ASSERT(atlas.getNumPages() == 2);
+		BS_TEST_ASSERT(evictedGlyphs.size() == 1 && evictedGlyphs[0] == GlyphAtlas::GlyphKey(14, 0));
+		BS_TEST_ASSERT(!atlas.removeExcessPage(frameIdx, evictedGlyphs));
+		evictedGlyphs.clear();
+
+		// Pinned page is skipped even though it is the least recently used one
+		BS_TEST_ASSERT(atlas.allocate({ 14, 1 }, GLYPH_SIZE, GLYPH_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::EvictedPage);
+		BS_TEST_ASSERT(pageIdx == 1);
+		evictedGlyphs.clear();
+
+		// Once released, the page can be evicted again
+		atlas.removeRef(0);
+
+		frameIdx = 5;
+		BS_TEST_ASSERT(atlas.allocate({ 14, 2 }, PAGE_SIZE, PAGE_SIZE, frameIdx, pageIdx, x, y, evictedGlyphs) ==
+			GlyphAllocResult::EvictedPage);
+		BS_TEST_ASSERT(pageIdx == 0);
+		BS_TEST_ASSERT(evictedGlyphs.size() == 4 && evictedGlyphs[0] == GlyphAtlas::GlyphKey(12, 0));
+	}
+
+	void CoreTestSuite::testStreamedResourceData()
+	{
+		CoreObjectManager::startUp();
+		Resources::startUp();
+		ResourceListenerManager::startUp();
+
+		static constexpr UINT32 DATA_SIZE = 64 * 1024;
+
+		SPtr<MemoryDataStream> data = bs_shared_ptr_new<MemoryDataStream>(DATA_SIZE);
+		for (UINT32 i = 0; i < DATA_SIZE; i++)
+			data->getPtr()[i] = (UINT8)(i * 7);
+
+		auto checkData = [](TestStreamedResource* resource)
+		{
+			Vector<UINT8> loadedData(DATA_SIZE);
+			resource->mData->seek(resource->mDataOffset);
+
+			bool matches = resource->mDataSize == DATA_SIZE &&
+				resource->mData->read(loadedData.data(), DATA_SIZE) == DATA_SIZE;
+			for (UINT32 i = 0; matches && i < DATA_SIZE; i++)
+				matches = loadedData[i] == (UINT8)(i * 7);
+
+			return matches;
+		};
+
+		// Data blocks of uncompressed resources are streamed directly from the file, instead of from an in-memory copy
+		Path uncompressedPath = FileSystem::getTempDirectoryPath();
+		uncompressedPath.setFilename("bsfTestStreamedResource.asset");
+		gResources()._save(TestStreamedResource::create(data, DATA_SIZE), uncompressedPath, false);
+
+		HResource uncompressed = gResources().load(uncompressedPath);
+		BS_TEST_ASSERT(uncompressed.isLoaded());
+
+		if (uncompressed.isLoaded())
+		{
+			auto resource = static_cast<TestStreamedResource*>(uncompressed.get());
+			BS_TEST_ASSERT(resource->mData != nullptr && resource->mData->isFile());
+			BS_TEST_ASSERT(checkData(resource));
+		}
+
+		// Compressed resources are decompressed in memory, so their data blocks can't be streamed from the file
+		Path compressedPath = FileSystem::getTempDirectoryPath();
+		compressedPath.setFilename("bsfTestStreamedResourceCompressed.asset");
+		gResources()._save(TestStreamedResource::create(data, DATA_SIZE), compressedPath, true);
+
+		HResource compressed = gResources().load(compressedPath);
+		BS_TEST_ASSERT(compressed.isLoaded());
+
+		if (compressed.isLoaded())
+		{
+			auto resource = static_cast<TestStreamedResource*>(compressed.get());
+			BS_TEST_ASSERT(resource->mData != nullptr && !resource->mData->isFile());
+			BS_TEST_ASSERT(checkData(resource));
+		}
+
+		gResources().release(uncompressed);
+		gResources().release(compressed);
+
+		ResourceListenerManager::shutDown();
+		Resources::shutDown();
+		CoreObjectManager::shutDown();
+
+		FileSystem::remove(uncompressedPath);
+		FileSystem::remove(compressedPath);
+	}
+
+	void CoreTestSuite::testSceneObjectWorldPoses()
+	{
+		GameObjectManager::startUp();
+		SceneManager::startUp();
+
+		static constexpr UINT32 NUM_ROOT_OBJECTS = 8;
+		static constexpr UINT32 NUM_CHILDREN = 4;
+
+		// Two identical hierarchies, one updated through _setWorldPoses() and the other one object at a time, the same
+		// way Rigidbody::_setTransform() does it
+		struct Hierarchy
+		{
+			Vector<HSceneObject> rootObjects;
+			HSceneObject parent;
+			Vector<HSceneObject> children;
+			HSceneObject grandchild;
+			HSceneObject immovable;
+			GameObjectHandle<TransformCounter> rootCounter;
+		};
+
+		auto createHierarchy = []()
+		{
+			Hierarchy output;
+			for (UINT32 i = 0; i < NUM_ROOT_OBJECTS; i++)
+			{
+				output.rootObjects.push_back(SceneObject::create("Root"));
+				output.rootObjects.back()->setPosition(Vector3((float)i, 0.0f, 0.0f));
+			}
+
+			output.rootCounter = output.rootObjects[0]->addComponent<TransformCounter>();
+
+			// Parent with a non-uniform scale and a rotation, so the world to local conversion is not trivial
+			output.parent = SceneObject::create("Parent");
+			output.parent->setPosition(Vector3(1.0f, 2.0f, 3.0f));
+			output.parent->setRotation(Quaternion(Degree(30), Degree(45), Degree(10)));
+			output.parent->setScale(Vector3(2.0f, 1.0f, 0.5f));
+
+			for (UINT32 i = 0; i < NUM_CHILDREN; i++)
+			{
+				output.children.push_back(SceneObject::create("Child"));
+				output.children.back()->setParent(output.parent);
+				output.children.back()->setPosition(Vector3(0.0f, (float)i, 0.0f));
+			}
+
+			output.grandchild = SceneObject::create("Grandchild");
+			output.grandchild->setParent(output.children[1]);
+			output.grandchild->setPosition(Vector3(0.0f, 0.0f, 1.0f));
+
+			output.immovable = SceneObject::create("Immovable");
+			output.immovable->setPosition(Vector3(0.0f, -1.0f, 0.0f));
+			output.immovable->setMobility(ObjectMobility::Immovable);
+
+			return output;
+		};
+
+		auto getPoses = [](Hierarchy& hierarchy, UINT32 step)
+		{
+			Vector<SceneObjectPose> poses;
+			auto addPose = [&poses, step](const HSceneObject& so)
+			{
+				const float t = (float)(poses.size() + 1) * (float)(step + 1);
+				poses.push_back({ so.get(), Vector3(t, t * 0.5f, -t), Quaternion(Degree(t), Degree(t * 2.0f), Degree(0)) });
+			};
+
+			for (auto& entry : hierarchy.rootObjects)
+				addPose(entry);
+
+			// Children that share a parent, followed by the parent itself and children of a child moved before them
+			addPose(hierarchy.children[0]);
+			addPose(hierarchy.children[1]);
+			addPose(hierarchy.parent);
+			addPose(hierarchy.children[2]);
+			addPose(hierarchy.grandchild);
+			addPose(hierarchy.children[3]);
+			addPose(hierarchy.immovable);
+
+			return poses;
+		};
+
+		Hierarchy bulk = createHierarchy();
+		Hierarchy single = createHierarchy();
+
+		auto compare = [](const HSceneObject& a, const HSceneObject& b)
+		{
+			const Transform& tfrmA = a->getTransform();
+			const Transform& tfrmB = b->getTransform();
+
+			return Math::approxEquals(tfrmA.getPosition(), tfrmB.getPosition(), 0.001f) &&
+				Math::approxEquals(tfrmA.getRotation(), tfrmB.getRotation(), 0.001f) &&
+				Math::approxEquals(tfrmA.getScale(), tfrmB.getScale(), 0.001f);
+		};
+
+		for (UINT32 step = 0; step < 2; step++)
+		{
+			bulk.rootCounter->numNotifications = 0;
+
+			Vector<SceneObjectPose> bulkPoses = getPoses(bulk, step);
+			SceneObject::_setWorldPoses(bulkPoses.data(), (UINT32)bulkPoses.size());
+
+			for (auto& entry : getPoses(single, step))
+			{
+				entry.sceneObject->setWorldPosition(entry.position);
+				entry.sceneObject->setWorldRotation(entry.rotation);
+			}
+
+			for (UINT32 i = 0; i < NUM_ROOT_OBJECTS; i++)
+				BS_TEST_ASSERT(compare(bulk.rootObjects[i], single.rootObjects[i]));
+
+			for (UINT32 i = 0; i < NUM_CHILDREN; i++)
+				BS_TEST_ASSERT(compare(bulk.children[i], single.children[i]));
+
+			BS_TEST_ASSERT(compare(bulk.parent, single.parent));
+			BS_TEST_ASSERT(compare(bulk.grandchild, single.grandchild));
+			BS_TEST_ASSERT(compare(bulk.immovable, single.immovable));
+
+			// Bodies get the exact world transform they were assigned, unless they're immovable. Children moved before
+			// their parent follow the parent afterwards, so they're only compared with the other hierarchy above.
+			for (auto& entry : bulkPoses)
+			{
+				if (entry.sceneObject == bulk.children[0].get() || entry.sceneObject == bulk.children[1].get())
+					continue;
+
+				const Transform& tfrm = entry.sceneObject->getTransform();
+				if (entry.sceneObject == bulk.immovable.get())
+				{
+					BS_TEST_ASSERT(Math::approxEquals(tfrm.getPosition(), Vector3(0.0f, -1.0f, 0.0f), 0.001f));
+				}
+				else
+				{
+					BS_TEST_ASSERT(Math::approxEquals(tfrm.getPosition(), entry.position, 0.001f));
+					BS_TEST_ASSERT(Math::approxEquals(tfrm.getRotation(), entry.rotation, 0.001f));
+				}
+			}
+
+			// Components are notified once per object, instead of once for position and once for rotation
+			BS_TEST_ASSERT(bulk.rootCounter->numNotifications == 1);
+			BS_TEST_ASSERT(single.rootCounter->numNotifications == 2 * (step + 1));
+		}
+
+		SceneManager::shutDown();
+		GameObjectManager::shutDown();
+	}
 }
 
 using namespace bs;
 
 int main()
 {
+	// Some of the tested systems use the stack allocator, normally set up by the application
+	MemStack::beginThread();
+
 	SPtr<TestSuite> tests = CoreTestSuite::create<CoreTestSuite>();
 
 	ExceptionTestOutput testOutput;
 	tests->run(testOutput);
 
+	MemStack::endThread();
 	return 0;
 }
\ No newline at end of file
@@ -100,73 +100,87 @@ namespace bs
 #endif		
 	}
 
-	ProfilerCPU::ProfileData::ProfileData(FrameAlloc* alloc)
-		:samples(alloc)
-	{ }
+	/** Value of ActiveSample::node for samples that were dropped. */
+	static constexpr UINT32 INVALID_NODE = (UINT32)-1;
 
-	void ProfilerCPU::ProfileData::beginSample()
-	{
-		memAllocs = MemoryCounter::getNumAllocs();
-		memFrees = MemoryCounter::getNumFrees();
-
-		timer.reset();
-		timer.start();
-	}
+	/** Maximum number of sample sites that can be registered. */
+	static constexpr UINT32 MAX_SAMPLE_SITES = 16384;
 
-	void ProfilerCPU::ProfileData::endSample()
+	/** Registered sample sites. Names are never freed, so they can be read without locking once published. */
+	struct SampleRegistry
 	{
-		timer.stop();
-
-		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
-		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
+		const char* names[MAX_SAMPLE_SITES];
+		std::atomic<UINT32> numSamples { 0 };
 
-		samples.push_back(ProfileSample(timer.time, numAllocs, numFrees));
-	}
+		UnorderedMap<String, UINT32> lookup;
+		Mutex mutex;
+	};
 
-	void ProfilerCPU::ProfileData::resumeLastSample()
+	/** Returns the registry of all sample sites. Constructed on first use, as sites can get registered at any point. */
+	static SampleRegistry& getSampleRegistry()
 	{
-		timer.start();
-		samples.erase(samples.end() - 1);
+		static SampleRegistry registry;
+		return registry;
 	}
 
-	ProfilerCPU::PreciseProfileData::PreciseProfileData(FrameAlloc* alloc)
-		:samples(alloc)
-	{ }
-
-	void ProfilerCPU::PreciseProfileData::beginSample()
+	/** Reads the timestamp counter, without serializing the instruction stream. Cheaper than TimerPrecise. */
+	static inline UINT64 getTicks()
 	{
-		memAllocs = MemoryCounter::getNumAllocs();
-		memFrees = MemoryCounter::getNumFrees();
-
-		timer.reset();
-		timer.start();
+#if BS_COMPILER == BS_COMPILER_GNUC || BS_COMPILER == BS_COMPILER_CLANG
+#if BS_ARCH_TYPE == BS_ARCHITECTURE_x86_64
+		UINT32 __a, __d;
+		__asm__ __volatile__ ("rdtsc" : "=a" (__a), "=d" (__d));
+		return (UINT64(__a) | UINT64(__d) << 32);
+#else
+		UINT64 x;
+		__asm__ volatile (".byte 0x0f, 0x31" : "=A" (x));
+		return x;
+#endif
+#elif BS_COMPILER == BS_COMPILER_MSVC
+		return __rdtsc();
+#else
+		static_assert(false, "Unsupported compiler");
+#endif
 	}
 
-	void ProfilerCPU::PreciseProfileData::endSample()
+	/** 
+	 * Reads the timestamp counter and the system clock at (nearly) the same moment. The thread can get preempted between
+	 * the two reads, which would skew the tick rate calibrated from them, so the clock read is bracketed by two counter
+	 * reads and the attempt with the tightest bracket is kept.
+	 */
+	static void getTicksAndTime(UINT64& ticks, std::chrono::high_resolution_clock::time_point& time)
 	{
-		timer.stop();
-
-		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
-		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
+		UINT64 minWindow = std::numeric_limits<UINT64>::max();
+		for(UINT32 i = 0; i < 5; i++)
+		{
+			const UINT64 before = getTicks();
+			const auto now = std::chrono::high_resolution_clock::now();
+			const UINT64 after = getTicks();
 
-		samples.push_back(PreciseProfileSample(timer.cycles, numAllocs, numFrees));
+			if(after - before < minWindow)
+			{
+				minWindow = after - before;
+				ticks = before + (after - before) / 2;
+				time = now;
+			}
+		}
 	}
 
-	void ProfilerCPU::PreciseProfileData::resumeLastSample()
+	/** Returns a hash of the pair of values used for looking up child nodes. */
+	static inline UINT32 hashChildKey(UINT32 parent, UINT32 sampleId)
 	{
-		timer.start();
-		samples.erase(samples.end() - 1);
+		return (parent * 0x9E3779B1U) ^ (sampleId * 0x85EBCA77U);
 	}
 
 	BS_THREADLOCAL ProfilerCPU::ThreadInfo* ProfilerCPU::ThreadInfo::activeThread = nullptr;
 
 	ProfilerCPU::ThreadInfo::ThreadInfo()
-		:isActive(false), rootBlock(nullptr), frameAlloc(1024 * 512), activeBlocks(nullptr)
+		:isActive(false), numDroppedSamples(0), numNodes(0), numActiveSamples(0), numOverflowSamples(0)
 	{
-
+		memset(childLookup, 0, sizeof(childLookup));
 	}
 
-	void ProfilerCPU::ThreadInfo::begin(const char* _name)
+	void ProfilerCPU::ThreadInfo::begin(UINT32 sampleId)
 	{
 		if(isActive)
 		{
@@ -174,53 +188,46 @@ namespace bs
 			return;
 		}
 
-		if(rootBlock == nullptr)
-			rootBlock = getBlock(_name);
+		if(numNodes == 0)
+		{
+			SampleNode& root = nodes[0];
+			root = SampleNode();
+			root.sampleId = sampleId;
+			root.parent = INVALID_NODE;
+			root.firstChild = INVALID_NODE;
+			root.lastChild = INVALID_NODE;
+			root.nextSibling = INVALID_NODE;
+
+			numNodes = 1;
+		}
 
-		activeBlock = ActiveBlock(ActiveSamplingType::Basic, rootBlock);
-		if (activeBlocks == nullptr)
-			activeBlocks = frameAlloc.construct<Stack<ActiveBlock, StdFrameAlloc<ActiveBlock>>>
-					(StdFrameAlloc<ActiveBlock>(&frameAlloc));
+		ActiveSample& sample = activeSamples[0];
+		sample.node = 0;
+		sample.precise = false;
+		sample.startMemory = MemoryCounter::getCounts();
+		sample.startTime = getTicks();
 
-		activeBlocks->push(activeBlock);
-		
-		rootBlock->basic.beginSample();
+		numActiveSamples = 1;
+		numOverflowSamples = 0;
 		isActive = true;
 	}
 
 	void ProfilerCPU::ThreadInfo::end()
 	{
-		if(activeBlock.type == ActiveSamplingType::Basic)
-			activeBlock.block->basic.endSample();
-		else
-			activeBlock.block->precise.endSample();
-
-		activeBlocks->pop();
-
 		if(!isActive)
+		{
 			LOGWRN("Profiler::endThread called on a thread that isn't being sampled.");
+			return;
+		}
 
-		if (activeBlocks->size() > 0)
-		{
+		if (numActiveSamples > 1 || numOverflowSamples > 0)
 			LOGWRN("Profiler::endThread called but not all sample pairs were closed. Sampling data will not be valid.");
 
-			while (activeBlocks->size() > 0)
-			{
-				ActiveBlock& curBlock = activeBlocks->top();
-				if(curBlock.type == ActiveSamplingType::Basic)
-					curBlock.block->basic.endSample();
-				else
-					curBlock.block->precise.endSample();
-
-				activeBlocks->pop();
-			}
-		}
-
 		isActive = false;
-		activeBlock = ActiveBlock();
+		numOverflowSamples = 0;
 
-		frameAlloc.free(activeBlocks);
-		activeBlocks = nullptr;
+		while (numActiveSamples > 0)
+			endSample();
 	}
 
 	void ProfilerCPU::ThreadInfo::reset()
@@ -228,57 +235,141 @@ namespace bs
 		if(isActive)
 			end();
 
-		if(rootBlock != nullptr)
-			releaseBlock(rootBlock);
+		// Only the entries that were used need clearing
+		for(UINT32 i = 1; i < numNodes; i++)
+		{
+			UINT32 slot = hashChildKey(nodes[i].parent, nodes[i].sampleId) & (LOOKUP_SIZE - 1);
+			while(childLookup[slot] != 0)
+			{
+				childLookup[slot] = 0;
+				slot = (slot + 1) & (LOOKUP_SIZE - 1);
+			}
+		}
 
-		rootBlock = nullptr;
-		frameAlloc.clear(); // Note: This never actually frees memory
+		numNodes = 0;
 	}
 
-	ProfilerCPU::ProfiledBlock* ProfilerCPU::ThreadInfo::getBlock(const char* name)
+	UINT32 ProfilerCPU::ThreadInfo::findOrCreateChild(UINT32 parent, UINT32 sampleId)
 	{
-		ProfiledBlock* block = frameAlloc.construct<ProfiledBlock>(&frameAlloc);
-		block->name = (char*)frameAlloc.alloc(((UINT32)strlen(name) + 1) * sizeof(char));
-		strcpy(block->name, name);
+		UINT32 slot = hashChildKey(parent, sampleId) & (LOOKUP_SIZE - 1);
+		while(childLookup[slot] != 0)
+		{
+			const UINT32 nodeIdx = childLookup[slot] - 1;
+
+			const SampleNode& node = nodes[nodeIdx];
+			if(node.parent == parent && node.sampleId == sampleId)
+				return nodeIdx;
+
+			slot = (slot + 1) & (LOOKUP_SIZE - 1);
+		}
+
+		if(numNodes == MAX_NODES)
+			return INVALID_NODE;
+
+		const UINT32 nodeIdx = numNodes++;
+		childLookup[slot] = nodeIdx + 1;
+
+		SampleNode& node = nodes[nodeIdx];
+		node = SampleNode();
+		node.sampleId = sampleId;
+		node.parent = parent;
+		node.firstChild = INVALID_NODE;
+		node.lastChild = INVALID_NODE;
+		node.nextSibling = INVALID_NODE;
+
+		SampleNode& parentNode = nodes[parent];
+		if(parentNode.lastChild != INVALID_NODE)
+			nodes[parentNode.lastChild].nextSibling = nodeIdx;
+		else
+			parentNode.firstChild = nodeIdx;
 
-		return block;
+		parentNode.lastChild = nodeIdx;
+		return nodeIdx;
 	}
 
-	void ProfilerCPU::ThreadInfo::releaseBlock(ProfiledBlock* block)
+	void ProfilerCPU::ThreadInfo::beginSample(UINT32 sampleId, bool precise)
 	{
-		frameAlloc.free((UINT8*)block->name);
-		frameAlloc.free(block);
-	}
+		if(numActiveSamples == MAX_DEPTH)
+		{
+			// Too deep to store, only count it so the matching endSample() doesn't end one of the stored samples
+			numDroppedSamples++;
+			numOverflowSamples++;
+			return;
+		}
 
-	ProfilerCPU::ProfiledBlock::ProfiledBlock(FrameAlloc* alloc)
-		:basic(alloc), precise(alloc), children(alloc)
-	{ }
+		UINT32 parent = activeSamples[numActiveSamples - 1].node;
 
-	ProfilerCPU::ProfiledBlock::~ProfiledBlock()
-	{
-		ThreadInfo* thread = ThreadInfo::activeThread;
+		UINT32 node = INVALID_NODE;
+		if(parent != INVALID_NODE)
+			node = findOrCreateChild(parent, sampleId);
 
-		for(auto& child : children)
-			thread->releaseBlock(child);
+		if(node == INVALID_NODE)
+			numDroppedSamples++;
 
-		children.clear();
+		ActiveSample& sample = activeSamples[numActiveSamples++];
+		sample.node = node;
+		sample.precise = precise;
+		sample.startMemory = MemoryCounter::getCounts();
+		sample.startTime = precise ? TimerPrecise::getNumCycles() : getTicks();
 	}
 
-	ProfilerCPU::ProfiledBlock* ProfilerCPU::ProfiledBlock::findChild(const char* name) const
+	void ProfilerCPU::ThreadInfo::endSample()
 	{
-		for(auto& child : children)
+		if(numOverflowSamples > 0)
 		{
-			if(strcmp(child->name, name) == 0)
-				return child;
+			numOverflowSamples--;
+			return;
 		}
 
-		return nullptr;
+		// Never end the primary sample, it's ended by end()
+		if(numActiveSamples == 0 || (numActiveSamples == 1 && isActive))
+			return;
+
+		ActiveSample& sample = activeSamples[numActiveSamples - 1];
+		const UINT64 endTime = sample.precise ? TimerPrecise::getNumCycles() : getTicks();
+
+		if(sample.node != INVALID_NODE)
+		{
+			const MemoryCounts memory = MemoryCounter::getCounts();
+
+			SampleNode& node = nodes[sample.node];
+			SampleStats& stats = sample.precise ? node.precise : node.basic;
+
+			const UINT64 elapsed = endTime - sample.startTime;
+			stats.total += elapsed;
+			stats.max = std::max(stats.max, elapsed);
+			stats.numAllocs += memory.numAllocs - sample.startMemory.numAllocs;
+			stats.numFrees += memory.numFrees - sample.startMemory.numFrees;
+
+			for(int i = 0; i < (int)MemoryCategory::Count; i++)
+				stats.allocBytes[i] += memory.numAllocBytes[i] - sample.startMemory.numAllocBytes[i];
+
+			stats.numCalls++;
+		}
+
+		numActiveSamples--;
+	}
+
+	UINT32 ProfilerCPU::ThreadInfo::getSampleId(const char* name)
+	{
+		// Most names are string literals, so their address is a good key. Different strings can end up at the same
+		// address though (e.g. temporaries), so the name must be verified.
+		NameCacheEntry& entry = nameCache[((UINT64)(size_t)name >> 3) & (NAME_CACHE_SIZE - 1)];
+		if(entry.name == name && strcmp(getSampleName(entry.sampleId), name) == 0)
+			return entry.sampleId;
+
+		entry.name = name;
+		entry.sampleId = registerSample(name);
+
+		return entry.sampleId;
 	}
 
 	ProfilerCPU::ProfilerCPU()
 		: mBasicTimerOverhead(0.0), mPreciseTimerOverhead(0), mBasicSamplingOverheadMs(0.0), mPreciseSamplingOverheadMs(0.0)
 		, mBasicSamplingOverheadCycles(0), mPreciseSamplingOverheadCycles(0)
 	{
+		getTicksAndTime(mStartTicks, mStartTime);
+
 		// TODO - We only estimate overhead on program start. It might be better to estimate it each time beginThread is called,
 		// and keep separate values per thread.
 		estimateTimerOverhead();
@@ -294,7 +385,7 @@ namespace bs
 			bs_delete<ThreadInfo, ProfilerAlloc>(threadInfo);
 	}
 
-	void ProfilerCPU::beginThread(const char* name)
+	ProfilerCPU::ThreadInfo* ProfilerCPU::getActiveThread()
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
 		if(thread == nullptr)
@@ -309,13 +400,25 @@ namespace bs
 			}
 		}
 
-		thread->begin(name);
+		return thread;
+	}
+
+	void ProfilerCPU::beginThread(const char* name)
+	{
+		ThreadInfo* thread = getActiveThread();
+
+		ProfilerTimeline::setThreadName(name);
+		ProfilerTimeline::beginEvent(name);
+
+		thread->begin(thread->getSampleId(name));
 	}
 
 	void ProfilerCPU::endThread()
 	{
 		// I don't do a nullcheck where on purpose, so endSample can be called ASAP
 		ThreadInfo::activeThread->end();
+
+		ProfilerTimeline::endEvent();
 	}
 
 	void ProfilerCPU::beginSample(const char* name)
@@ -327,62 +430,46 @@ namespace bs
 			thread = ThreadInfo::activeThread;
 		}
 
-		ProfiledBlock* parent = thread->activeBlock.block;
-		ProfiledBlock* block = nullptr;
-		
-		if(parent != nullptr)
-			block = parent->findChild(name);
-
-		if(block == nullptr)
-		{
-			block = thread->getBlock(name);
-
-			if(parent != nullptr)
-				parent->children.push_back(block);
-			else
-				thread->rootBlock->children.push_back(block);
-		}
-
-		thread->activeBlock = ActiveBlock(ActiveSamplingType::Basic, block);
-		thread->activeBlocks->push(thread->activeBlock);
-
-		block->basic.beginSample();
+		ProfilerTimeline::beginEvent(name);
+		thread->beginSample(thread->getSampleId(name), false);
 	}
 
 	void ProfilerCPU::endSample(const char* name)
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
-		ProfiledBlock* block = thread->activeBlock.block;
 
 #if BS_DEBUG_MODE
-		if(block == nullptr)
+		if(thread == nullptr || thread->numActiveSamples <= 1)
 		{
 			LOGWRN("Mismatched CPUProfiler::endSample. No beginSample was called.");
 			return;
 		}
 
-		if(thread->activeBlock.type == ActiveSamplingType::Precise)
+		// Samples started past the depth limit were never stored, so there is nothing to verify them against
+		if(thread->numOverflowSamples == 0)
 		{
-			LOGWRN("Mismatched CPUProfiler::endSample. Was expecting Profiler::endSamplePrecise.");
-			return;
-		}
+			const ActiveSample& sample = thread->activeSamples[thread->numActiveSamples - 1];
+			if(sample.precise)
+			{
+				LOGWRN("Mismatched CPUProfiler::endSample. Was expecting Profiler::endSamplePrecise.");
+				return;
+			}
 
-		if(strcmp(block->name, name) != 0)
-		{
-			LOGWRN("Mismatched CPUProfiler::endSample. Was expecting \"" + String(block->name) + 
-				"\" but got \"" + String(name) + "\". Sampling data will not be valid.");
-			return;
+			if(sample.node != INVALID_NODE)
+			{
+				const char* activeName = getSampleName(thread->nodes[sample.node].sampleId);
+				if(strcmp(activeName, name) != 0)
+				{
+					LOGWRN("Mismatched CPUProfiler::endSample. Was expecting \"" + String(activeName) + 
+						"\" but got \"" + String(name) + "\". Sampling data will not be valid.");
+					return;
+				}
+			}
 		}
 #endif
 
-		block->basic.endSample();
-
-		thread->activeBlocks->pop();
-
-		if (!thread->activeBlocks->empty())
-			thread->activeBlock = thread->activeBlocks->top();
-		else
-			thread->activeBlock = ActiveBlock();
+		thread->endSample();
+		ProfilerTimeline::endEvent();
 	}
 
 	void ProfilerCPU::beginSamplePrecise(const char* name)
@@ -392,64 +479,201 @@ namespace bs
 		
 		ThreadInfo* thread = ThreadInfo::activeThread;
 		if(thread == nullptr || !thread->isActive)
+		{
 			beginThread("Unknown");
+			thread = ThreadInfo::activeThread;
+		}
 
-		ProfiledBlock* parent = thread->activeBlock.block;
-		ProfiledBlock* block = nullptr;
-		
-		if(parent != nullptr)
-			block = parent->findChild(name);
+		ProfilerTimeline::beginEvent(name);
+		thread->beginSample(thread->getSampleId(name), true);
+	}
+
+	void ProfilerCPU::endSamplePrecise(const char* name)
+	{
+		ThreadInfo* thread = ThreadInfo::activeThread;
 
-		if(block == nullptr)
+#if BS_DEBUG_MODE
+		if(thread == nullptr || thread->numActiveSamples <= 1)
 		{
-			block = thread->getBlock(name);
+			LOGWRN("Mismatched Profiler::endSamplePrecise. No beginSamplePrecise was called.");
+			return;
+		}
 
-			if(parent != nullptr)
-				parent->children.push_back(block);
-			else
-				thread->rootBlock->children.push_back(block);
+		// Samples started past the depth limit were never stored, so there is nothing to verify them against
+		if(thread->numOverflowSamples == 0)
+		{
+			const ActiveSample& sample = thread->activeSamples[thread->numActiveSamples - 1];
+			if(!sample.precise)
+			{
+				LOGWRN("Mismatched CPUProfiler::endSamplePrecise. Was expecting Profiler::endSample.");
+				return;
+			}
+
+			if(sample.node != INVALID_NODE)
+			{
+				const char* activeName = getSampleName(thread->nodes[sample.node].sampleId);
+				if(strcmp(activeName, name) != 0)
+				{
+					LOGWRN("Mismatched Profiler::endSamplePrecise. Was expecting \"" + String(activeName) + 
+						"\" but got \"" + String(name) + "\". Sampling data will not be valid.");
+					return;
+				}
+			}
 		}
+#endif
 
-		thread->activeBlock = ActiveBlock(ActiveSamplingType::Precise, block);
-		thread->activeBlocks->push(thread->activeBlock);
+		thread->endSample();
+		ProfilerTimeline::endEvent();
+	}
 
-		block->precise.beginSample();
+	void ProfilerCPU::beginSample(UINT32 sampleId)
+	{
+		beginScope(sampleId);
 	}
 
-	void ProfilerCPU::endSamplePrecise(const char* name)
+	void ProfilerCPU::endSample(UINT32 sampleId)
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
-		ProfiledBlock* block = thread->activeBlock.block;
 
 #if BS_DEBUG_MODE
-		if(block == nullptr)
+		if(thread == nullptr || thread->numActiveSamples <= 1)
 		{
-			LOGWRN("Mismatched Profiler::endSamplePrecise. No beginSamplePrecise was called.");
+			LOGWRN("Mismatched CPUProfiler::endSample. No beginSample was called.");
 			return;
 		}
 
-		if(thread->activeBlock.type == ActiveSamplingType::Basic)
+		// Samples started past the depth limit were never stored, so there is nothing to verify them against
+		if(thread->numOverflowSamples == 0)
 		{
-			LOGWRN("Mismatched CPUProfiler::endSamplePrecise. Was expecting Profiler::endSample.");
-			return;
+			const ActiveSample& sample = thread->activeSamples[thread->numActiveSamples - 1];
+			if(sample.precise || (sample.node != INVALID_NODE && thread->nodes[sample.node].sampleId != sampleId))
+			{
+				LOGWRN("Mismatched CPUProfiler::endSample. Was expecting a different sample than \"" + 
+					String(getSampleName(sampleId)) + "\". Sampling data will not be valid.");
+				return;
+			}
 		}
+#endif
 
-		if (strcmp(block->name, name) != 0)
+		thread->endSample();
+		ProfilerTimeline::endEvent();
+	}
+
+	void ProfilerCPU::beginSamplePrecise(UINT32 sampleId)
+	{
+		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(thread == nullptr || !thread->isActive)
+		{
+			beginThread("Unknown");
+			thread = ThreadInfo::activeThread;
+		}
+
+		if(ProfilerTimeline::isRecording())
+			ProfilerTimeline::beginEvent(getSampleName(sampleId));
+
+		thread->beginSample(sampleId, true);
+	}
+
+	void ProfilerCPU::endSamplePrecise(UINT32 sampleId)
+	{
+		ThreadInfo* thread = ThreadInfo::activeThread;
+
+#if BS_DEBUG_MODE
+		if(thread == nullptr || thread->numActiveSamples <= 1)
 		{
-			LOGWRN("Mismatched Profiler::endSamplePrecise. Was expecting \"" + String(block->name) + 
-				"\" but got \"" + String(name) + "\". Sampling data will not be valid.");
+			LOGWRN("Mismatched Profiler::endSamplePrecise. No beginSamplePrecise was called.");
 			return;
 		}
+
+		// Samples started past the depth limit were never stored, so there is nothing to verify them against
+		if(thread->numOverflowSamples == 0)
+		{
+			const ActiveSample& sample = thread->activeSamples[thread->numActiveSamples - 1];
+			if(!sample.precise || (sample.node != INVALID_NODE && thread->nodes[sample.node].sampleId != sampleId))
+			{
+				LOGWRN("Mismatched Profiler::endSamplePrecise. Was expecting a different sample than \"" + 
+					String(getSampleName(sampleId)) + "\". Sampling data will not be valid.");
+				return;
+			}
+		}
 #endif
 
-		block->precise.endSample();
+		thread->endSample();
+		ProfilerTimeline::endEvent();
+	}
+
+	ProfilerCPU::ThreadInfo* ProfilerCPU::beginScope(UINT32 sampleId)
+	{
+		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(thread == nullptr || !thread->isActive)
+		{
+			gProfilerCPU().beginThread("Unknown");
+			thread = ThreadInfo::activeThread;
+		}
 
-		thread->activeBlocks->pop();
+		// Avoid the name lookup unless it's needed
+		if(ProfilerTimeline::isRecording())
+			ProfilerTimeline::beginEvent(getSampleName(sampleId));
 
-		if (!thread->activeBlocks->empty())
-			thread->activeBlock = thread->activeBlocks->top();
-		else
-			thread->activeBlock = ActiveBlock();
+		thread->beginSample(sampleId, false);
+		return thread;
+	}
+
+	void ProfilerCPU::endScope(ThreadInfo* thread)
+	{
+		thread->endSample();
+		ProfilerTimeline::endEvent();
+	}
+
+	UINT32 ProfilerCPU::registerSample(const char* name)
+	{
+		SampleRegistry& registry = getSampleRegistry();
+		Lock lock(registry.mutex);
+
+		auto iterFind = registry.lookup.find(name);
+		if(iterFind != registry.lookup.end())
+			return iterFind->second;
+
+		const UINT32 numSamples = registry.numSamples.load(std::memory_order_relaxed);
+		if(numSamples == MAX_SAMPLE_SITES)
+		{
+			// Everything past the limit is reported under the last registered name
+			LOGWRN("Maximum number of profiler sample sites reached. Ignoring sample \"" + String(name) + "\".");
+			return numSamples - 1;
+		}
+
+		const UINT32 length = (UINT32)strlen(name);
+		char* nameCopy = (char*)bs_alloc<ProfilerAlloc>(length + 1);
+		memcpy(nameCopy, name, length + 1);
+
+		registry.names[numSamples] = nameCopy;
+		registry.lookup[name] = numSamples;
+		registry.numSamples.store(numSamples + 1, std::memory_order_release);
+
+		return numSamples;
+	}
+
+	const char* ProfilerCPU::getSampleName(UINT32 sampleId)
+	{
+		return getSampleRegistry().names[sampleId];
+	}
+
+	double ProfilerCPU::getTicksPerMs() const
+	{
+		using namespace std::chrono;
+
+		// Calibrated over the entire lifetime of the profiler, so the estimate keeps getting more accurate
+		UINT64 ticks;
+		high_resolution_clock::time_point time;
+		getTicksAndTime(ticks, time);
+
+		const double elapsedMs = duration<double, std::milli>(time - mStartTime).count();
+		const UINT64 elapsedTicks = ticks - mStartTicks;
+
+		if(elapsedMs <= 0.0 || elapsedTicks == 0)
+			return 1.0;
+
+		return elapsedTicks / elapsedMs;
 	}
 
 	void ProfilerCPU::reset()
@@ -472,16 +696,25 @@ namespace bs
 			thread->end();
 
 		// We need to separate out basic and precise data and form two separate hierarchies
-		if(thread->rootBlock == nullptr)
+		if(thread->numNodes == 0)
 			return report;
 
+		if(thread->numDroppedSamples > 0)
+		{
+			LOGWRN("Profiler dropped " + toString(thread->numDroppedSamples) + " samples because they didn't fit in the "
+				"per-thread budget. Sampling data will be incomplete.");
+			thread->numDroppedSamples = 0;
+		}
+
+		const double msPerTick = 1.0 / getTicksPerMs();
+
 		struct TempEntry
 		{
-			TempEntry(ProfiledBlock* _parentBlock, UINT32 _entryIdx)
-				:parentBlock(_parentBlock), entryIdx(_entryIdx)
+			TempEntry(UINT32 _node, UINT32 _entryIdx)
+				:node(_node), entryIdx(_entryIdx)
 			{ }
 
-			ProfiledBlock* parentBlock;
+			UINT32 node;
 			UINT32 entryIdx;
 			ProfilerVector<UINT32> childIndexes;
 		};
@@ -495,17 +728,17 @@ namespace bs
 
 		UINT32 entryIdx = 0;
 		todo.push(entryIdx);
-		flatHierarchy.push_back(TempEntry(thread->rootBlock, entryIdx));
+		flatHierarchy.push_back(TempEntry(0, entryIdx));
 
 		entryIdx++;
 		while(!todo.empty())
 		{
 			UINT32 curDataIdx = todo.top();
-			ProfiledBlock* curBlock = flatHierarchy[curDataIdx].parentBlock;
+			const SampleNode& curNode = thread->nodes[flatHierarchy[curDataIdx].node];
 
 			todo.pop();
 
-			for(auto& child : curBlock->children)
+			for(UINT32 child = curNode.firstChild; child != INVALID_NODE; child = thread->nodes[child].nextSibling)
 			{
 				flatHierarchy[curDataIdx].childIndexes.push_back(entryIdx);
 
@@ -523,27 +756,20 @@ namespace bs
 		for(auto iter = flatHierarchy.rbegin(); iter != flatHierarchy.rend(); ++iter)
 		{
 			TempEntry& curData = *iter;
-			ProfiledBlock* curBlock = curData.parentBlock;
+			const SampleNode& curNode = thread->nodes[curData.node];
 
 			CPUProfilerBasicSamplingEntry* entryBasic = &basicEntries[curData.entryIdx];
 			CPUProfilerPreciseSamplingEntry* entryPrecise = &preciseEntries[curData.entryIdx];
 
 			// Calculate basic data
-			entryBasic->data.name = String(curBlock->name);
+			entryBasic->data.name = String(getSampleName(curNode.sampleId));
 
-			entryBasic->data.memAllocs = 0;
-			entryBasic->data.memFrees = 0;
-			entryBasic->data.totalTimeMs = 0.0;
-			entryBasic->data.maxTimeMs = 0.0;
-			for(auto& sample : curBlock->basic.samples)
-			{
-				entryBasic->data.totalTimeMs += sample.time;
-				entryBasic->data.maxTimeMs = std::max(entryBasic->data.maxTimeMs, sample.time);
-				entryBasic->data.memAllocs += sample.numAllocs;
-				entryBasic->data.memFrees += sample.numFrees;
-			}
-
-			entryBasic->data.numCalls = (UINT32)curBlock->basic.samples.size();
+			entryBasic->data.memAllocs = curNode.basic.numAllocs;
+			entryBasic->data.memFrees = curNode.basic.numFrees;
+			memcpy(entryBasic->data.memAllocBytes, curNode.basic.allocBytes, sizeof(curNode.basic.allocBytes));
+			entryBasic->data.totalTimeMs = curNode.basic.total * msPerTick;
+			entryBasic->data.maxTimeMs = curNode.basic.max * msPerTick;
+			entryBasic->data.numCalls = curNode.basic.numCalls;
 
 			if(entryBasic->data.numCalls > 0)
 				entryBasic->data.avgTimeMs = entryBasic->data.totalTimeMs / entryBasic->data.numCalls;
@@ -558,8 +784,8 @@ namespace bs
 				entryBasic->data.estimatedOverheadMs += childEntry->data.estimatedOverheadMs;
 			}
 
-			entryBasic->data.estimatedOverheadMs += curBlock->basic.samples.size() * mBasicSamplingOverheadMs;
-			entryBasic->data.estimatedOverheadMs += curBlock->precise.samples.size() * mPreciseSamplingOverheadMs;
+			entryBasic->data.estimatedOverheadMs += curNode.basic.numCalls * mBasicSamplingOverheadMs;
+			entryBasic->data.estimatedOverheadMs += curNode.precise.numCalls * mPreciseSamplingOverheadMs;
 
 			entryBasic->data.totalSelfTimeMs = entryBasic->data.totalTimeMs - totalChildTime;
 
@@ -569,21 +795,14 @@ namespace bs
 			entryBasic->data.estimatedSelfOverheadMs = mBasicTimerOverhead;
 
 			// Calculate precise data
-			entryPrecise->data.name = String(curBlock->name);
-
-			entryPrecise->data.memAllocs = 0;
-			entryPrecise->data.memFrees = 0;
-			entryPrecise->data.totalCycles = 0;
-			entryPrecise->data.maxCycles = 0;
-			for(auto& sample : curBlock->precise.samples)
-			{
-				entryPrecise->data.totalCycles += sample.cycles;
-				entryPrecise->data.maxCycles = std::max(entryPrecise->data.maxCycles, sample.cycles);
-				entryPrecise->data.memAllocs += sample.numAllocs;
-				entryPrecise->data.memFrees += sample.numFrees;
-			}
+			entryPrecise->data.name = String(getSampleName(curNode.sampleId));
 
-			entryPrecise->data.numCalls = (UINT32)curBlock->precise.samples.size();
+			entryPrecise->data.memAllocs = curNode.precise.numAllocs;
+			entryPrecise->data.memFrees = curNode.precise.numFrees;
+			memcpy(entryPrecise->data.memAllocBytes, curNode.precise.allocBytes, sizeof(curNode.precise.allocBytes));
+			entryPrecise->data.totalCycles = curNode.precise.total;
+			entryPrecise->data.maxCycles = curNode.precise.max;
+			entryPrecise->data.numCalls = curNode.precise.numCalls;
 
 			if(entryPrecise->data.numCalls > 0)
 				entryPrecise->data.avgCycles = entryPrecise->data.totalCycles / entryPrecise->data.numCalls;
@@ -598,8 +817,8 @@ namespace bs
 				entryPrecise->data.estimatedOverhead += childEntry->data.estimatedOverhead;
 			}
 
-			entryPrecise->data.estimatedOverhead += curBlock->precise.samples.size() * mPreciseSamplingOverheadCycles;
-			entryPrecise->data.estimatedOverhead += curBlock->basic.samples.size() * mBasicSamplingOverheadCycles;
+			entryPrecise->data.estimatedOverhead += curNode.precise.numCalls * mPreciseSamplingOverheadCycles;
+			entryPrecise->data.estimatedOverhead += curNode.basic.numCalls * mBasicSamplingOverheadCycles;
 
 			entryPrecise->data.totalSelfCycles = entryPrecise->data.totalCycles - totalChildCycles;
 
@@ -618,7 +837,7 @@ namespace bs
 
 		entryIdx = 0;
 		parentBasicEntryIndexes.push(entryIdx);
-		newBasicEntries.push_back(TempEntry(nullptr, entryIdx));
+		newBasicEntries.push_back(TempEntry(0, entryIdx));
 
 		entryIdx++;
 
@@ -638,7 +857,7 @@ namespace bs
 				CPUProfilerBasicSamplingEntry& basicEntry = basicEntries[childIdx];
 				if(basicEntry.data.numCalls > 0)
 				{
-					newBasicEntries.push_back(TempEntry(nullptr, childIdx));
+					newBasicEntries.push_back(TempEntry(0, childIdx));
 					newBasicEntries[parentEntryIdx].childIndexes.push_back(entryIdx);
 
 					parentBasicEntryIndexes.push(entryIdx);
@@ -692,7 +911,7 @@ namespace bs
 
 		entryIdx = 0;
 		parentPreciseEntryIndexes.push(entryIdx);
-		newPreciseEntries.push_back(TempEntry(nullptr, entryIdx));
+		newPreciseEntries.push_back(TempEntry(0, entryIdx));
 
 		entryIdx++;
 
@@ -712,7 +931,7 @@ namespace bs
 				CPUProfilerPreciseSamplingEntry& preciseEntry = preciseEntries[childIdx];
 				if(preciseEntry.data.numCalls > 0)
 				{
-					newPreciseEntries.push_back(TempEntry(nullptr, childIdx));
+					newPreciseEntries.push_back(TempEntry(0, childIdx));
 					newPreciseEntries[parentEntryIdx].childIndexes.push_back(entryIdx);
 
 					parentPreciseEntryIndexes.push(entryIdx);
@@ -760,6 +979,58 @@ namespace bs
 		return report;
 	}
 
+	void ProfilerCPU::captureTimeline(UINT32 numFrames, const Path& path, TimelineFormat format)
+	{
+		Lock lock(mTimelineSync);
+
+		if(mTimelineCapture.state != TimelineCaptureState::Inactive)
+		{
+			LOGWRN("Timeline capture is already in progress. Ignoring the new capture request.");
+			return;
+		}
+
+		mTimelineCapture.state = TimelineCaptureState::Requested;
+		mTimelineCapture.numFrames = std::max(numFrames, 1U);
+		mTimelineCapture.numRecordedFrames = 0;
+		mTimelineCapture.path = path;
+		mTimelineCapture.format = format;
+	}
+
+	bool ProfilerCPU::isCapturingTimeline() const
+	{
+		Lock lock(mTimelineSync);
+		return mTimelineCapture.state != TimelineCaptureState::Inactive;
+	}
+
+	void ProfilerCPU::_updateTimeline()
+	{
+		Lock lock(mTimelineSync);
+
+		switch(mTimelineCapture.state)
+		{
+		case TimelineCaptureState::Requested:
+			ProfilerTimeline::startRecording();
+			mTimelineCapture.state = TimelineCaptureState::Recording;
+			break;
+		case TimelineCaptureState::Recording:
+			// Collect every frame so per-thread queues never need to hold more than a frame's worth of events
+			ProfilerTimeline::collect();
+			mTimelineCapture.numRecordedFrames++;
+
+			if(mTimelineCapture.numRecordedFrames >= mTimelineCapture.numFrames)
+			{
+				ProfilerTimeline::stopRecording();
+				ProfilerTimeline::save(mTimelineCapture.path, mTimelineCapture.format);
+				ProfilerTimeline::clear();
+
+				mTimelineCapture.state = TimelineCaptureState::Inactive;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
 	void ProfilerCPU::estimateTimerOverhead()
 	{
 		// Get an idea of how long timer calls and RDTSC takes
@@ -1003,13 +1274,17 @@ namespace bs
 		:numCalls(0), avgTimeMs(0.0), maxTimeMs(0.0), totalTimeMs(0.0),
 		avgSelfTimeMs(0.0), totalSelfTimeMs(0.0), estimatedSelfOverheadMs(0.0),
 		estimatedOverheadMs(0.0), pctOfParent(1.0f)
-	{ }
+	{
+		memset(memAllocBytes, 0, sizeof(memAllocBytes));
+	}
 
 	CPUProfilerPreciseSamplingEntry::Data::Data()
 		:numCalls(0), avgCycles(0), maxCycles(0), totalCycles(0),
 		avgSelfCycles(0), totalSelfCycles(0), estimatedSelfOverhead(0),
 		estimatedOverhead(0), pctOfParent(1.0f)
-	{ }
+	{
+		memset(memAllocBytes, 0, sizeof(memAllocBytes));
+	}
 
 	CPUProfilerReport::CPUProfilerReport()
 	{
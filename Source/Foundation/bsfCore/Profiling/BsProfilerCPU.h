@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Debug/BsProfilerTimeline.h"
 
 namespace bs
 {
@@ -59,155 +60,82 @@ namespace bs
 			/**	Resets the cycle count to zero. */
 			void reset();
 
+			/** Queries the CPU for the current number of CPU cycles executed since the program was started. */
+			static inline UINT64 getNumCycles();
+
 			UINT64 cycles;
 		private:
 			UINT64 startCycles;
-
-			/** Queries the CPU for the current number of CPU cycles executed since the program was started. */
-			static inline UINT64 getNumCycles();
 		};
 
 		/**
-		 * Contains data about a single profiler sample (counting time in milliseconds).
-		 *	
-		 * @note	
-		 * A sample is created whenever a named profile block is entered. For example if you have a function you are
-		 * profiling, and it gets called 10 times, there will be 10 samples.
+		 * Measurements accumulated over all samples taken in a single node, for one sampling type. Basic samples are
+		 * measured in timestamp counter ticks, precise samples in CPU cycles.
 		 */
-		struct ProfileSample
+		struct SampleStats
 		{
-			ProfileSample(double _time, UINT64 _numAllocs, UINT64 _numFrees)
-				:time(_time), numAllocs(_numAllocs), numFrees(_numFrees)
-			{ }
-
-			double time;
-			UINT64 numAllocs;
-			UINT64 numFrees;
+			UINT64 total = 0;
+			UINT64 max = 0;
+			UINT64 numAllocs = 0;
+			UINT64 numFrees = 0;
+			UINT64 allocBytes[(int)MemoryCategory::Count] = { };
+			UINT32 numCalls = 0;
 		};
 
 		/**
-		 * Contains data about a single precise profiler sample (counting CPU cycles).
-		 *
-		 * @note	
-		 * A sample is created whenever a named profile block is entered. For example if you have a function you are
-		 * profiling, and it gets called 10 times, there will be 10 samples.
+		 * Single sample site at a specific position in the sample hierarchy of a thread. The same site sampled under two
+		 * different parents results in two nodes.
 		 */
-		struct PreciseProfileSample
+		struct SampleNode
 		{
-			PreciseProfileSample(UINT64 _cycles, UINT64 _numAllocs, UINT64 _numFrees)
-				:cycles(_cycles), numAllocs(_numAllocs), numFrees(_numFrees)
-			{ }
-
-			UINT64 cycles;
-			UINT64 numAllocs;
-			UINT64 numFrees;
+			UINT32 sampleId;
+			UINT32 parent;
+			UINT32 firstChild;
+			UINT32 lastChild;
+			UINT32 nextSibling;
+
+			SampleStats basic;
+			SampleStats precise;
 		};
 
-		/**	Contains basic (time based) profiling data contained in a profiling block. */
-		struct ProfileData
+		/** Sample that was started but not yet ended. */
+		struct ActiveSample
 		{
-			ProfileData(FrameAlloc* alloc);
-
-			/** Begins a new sample and records current sample state. Previous sample must not be active. */
-			void beginSample();
-
-			/**
-			 * Records current sample state and creates a new sample based on start and end state. Adds the sample to the 
-			 * sample list.
-			 */
-			void endSample();
-
-			/**
-			 * Removes the last added sample from the sample list and makes it active again. You must call endSample() 
-			 * when done as if you called beginSample().
-			 */
-			void resumeLastSample();
-
-			Vector<ProfileSample, StdFrameAlloc<ProfileSample>> samples;
-			Timer timer;
-
-			UINT64 memAllocs;
-			UINT64 memFrees;
+			UINT32 node; /**< INVALID_NODE if the sample didn't fit in the thread's budget. */
+			bool precise;
+			UINT64 startTime;
+			MemoryCounts startMemory;
 		};
 
-		/**	Contains precise (CPU cycle based) profiling data contained in a profiling block. */
-		struct PreciseProfileData
+		/** Maps a sample name pointer to its identifier, so repeated calls with the same string avoid the registry. */
+		struct NameCacheEntry
 		{
-			PreciseProfileData(FrameAlloc* alloc);
-
-			/** Begins a new sample and records current sample state. Previous sample must not be active. */
-			void beginSample();
-
-			/**
-			 * Records current sample state and creates a new sample based on start and end state. Adds the sample to the 
-			 * sample list.
-			 */
-			void endSample();
-
-			/**
-			 * Removes the last added sample from the sample list and makes it active again. You must call endSample() 
-			 * when done as if you called beginSample.
-			 */
-			void resumeLastSample();
-
-			Vector<PreciseProfileSample, StdFrameAlloc<PreciseProfileSample>> samples;
-			TimerPrecise timer;
-
-			UINT64 memAllocs;
-			UINT64 memFrees;
+			const char* name = nullptr;
+			UINT32 sampleId = 0;
 		};
 
 		/**
-		 * Contains all sampling information about a single named profiling block. Each block has its own sampling 
-		 * information and optionally child blocks.
+		 * Contains data about an active profiling thread. All storage is allocated up front, so taking samples never
+		 * allocates memory. Samples that don't fit in the budget are dropped.
 		 */
-		struct ProfiledBlock
-		{
-			ProfiledBlock(FrameAlloc* alloc);
-			~ProfiledBlock();
-
-			/**	Attempts to find a child block with the specified name. Returns null if not found. */
-			ProfiledBlock* findChild(const char* name) const;
-
-			char* name;
-			
-			ProfileData basic;
-			PreciseProfileData precise;
-
-			Vector<ProfiledBlock*, StdFrameAlloc<ProfiledBlock*>> children;
-		};
-
-		/**	CPU sampling type. */
-		enum class ActiveSamplingType
+		struct ThreadInfo
 		{
-			Basic, /**< Sample using milliseconds. */
-			Precise /**< Sample using CPU cycles. */
-		};
+			/** Maximum number of nodes in the sample hierarchy, between two calls to reset(). */
+			static constexpr UINT32 MAX_NODES = 2048;
 
-		/**	Contains data about the currently active profiling block. */
-		struct ActiveBlock
-		{
-			ActiveBlock()
-				:type(ActiveSamplingType::Basic), block(nullptr)
-			{ }
+			/** Maximum number of nested samples. */
+			static constexpr UINT32 MAX_DEPTH = 128;
 
-			ActiveBlock(ActiveSamplingType _type, ProfiledBlock* _block)
-				:type(_type), block(_block)
-			{ }
+			/** Number of entries in the child lookup table. Must be a power of two larger than MAX_NODES. */
+			static constexpr UINT32 LOOKUP_SIZE = MAX_NODES * 2;
 
-			ActiveSamplingType type;
-			ProfiledBlock* block;
-		};
+			/** Number of entries in the name cache. Must be a power of two. */
+			static constexpr UINT32 NAME_CACHE_SIZE = 256;
 
-		/** Contains data about an active profiling thread. */
-		struct ThreadInfo
-		{
 			ThreadInfo();
 
-			/**
-			 * Starts profiling on the thread. New primary profiling block is created with the given name.
-			 */
-			void begin(const char* _name);
+			/** Starts profiling on the thread. Primary sample of the thread is created with the given identifier. */
+			void begin(UINT32 sampleId);
 
 			/**
 			 * Ends profiling on the thread. You should end all samples before calling this, but if you don't they will be 
@@ -215,32 +143,46 @@ namespace bs
 			 */
 			void end();
 
+			/** Clears the sample hierarchy and all measurements, and makes the object ready for another iteration. */
+			void reset();
+
+			/** Starts a new sample as a child of the currently active sample. */
+			void beginSample(UINT32 sampleId, bool precise);
+
+			/** Ends the currently active sample. The primary sample of the thread is only ended by end(). */
+			void endSample();
+
 			/**
-			 * 	Deletes all internal profiling data and makes the object ready for another iteration. Should be called 
-			 * after end in order to delete any existing data.
+			 * Returns the child of the provided node that represents the provided sample site, creating it if it doesn't
+			 * exist. Returns INVALID_NODE if the node budget was exhausted.
 			 */
-			void reset();
+			UINT32 findOrCreateChild(UINT32 parent, UINT32 sampleId);
 
-			/**	Gets the primary profiling block used by the thread. */
-			ProfiledBlock* getBlock(const char* name);
-			
-			/** Deletes the provided block. */
-			void releaseBlock(ProfiledBlock* block);
+			/** Returns the identifier of a sample with the provided name, using the name cache when possible. */
+			UINT32 getSampleId(const char* name);
 
 			static BS_THREADLOCAL ThreadInfo* activeThread;
 			bool isActive;
+			UINT32 numDroppedSamples;
+
+			SampleNode nodes[MAX_NODES];
+			UINT32 numNodes;
 
-			ProfiledBlock* rootBlock;
+			UINT32 childLookup[LOOKUP_SIZE]; /**< Node index + 1, or 0 if empty. Keyed by parent node and sample ID. */
 
-			FrameAlloc frameAlloc;
-			ActiveBlock activeBlock;
-			Stack<ActiveBlock, StdFrameAlloc<ActiveBlock>>* activeBlocks;
+			ActiveSample activeSamples[MAX_DEPTH];
+			UINT32 numActiveSamples;
+			UINT32 numOverflowSamples; /**< Number of started samples nested deeper than MAX_DEPTH, which aren't stored. */
+
+			NameCacheEntry nameCache[NAME_CACHE_SIZE];
 		};
 
 	public:
 		ProfilerCPU();
 		~ProfilerCPU();
 
+		friend class ProfilerScope;
+
 		/**
 		 * Registers a new thread we will be doing sampling in. This needs to be called before any beginSample* \ endSample* 
 		 * calls are made in that thread.
@@ -293,6 +235,22 @@ namespace bs
 		 */
 		void endSamplePrecise(const char* name);
 
+		/**
+		 * Begins sample measurement of a sample site registered with registerSample(). Faster than the variant accepting
+		 * a name, as it avoids looking up the sample by name. Must be followed by endSample() with the same identifier.
+		 * Normally you would use PROFILE_SCOPE instead of calling this directly.
+		 */
+		void beginSample(UINT32 sampleId);
+
+		/** Ends sample measurement started with beginSample(UINT32). */
+		void endSample(UINT32 sampleId);
+
+		/** Same as beginSample(UINT32), except it performs a precise measurement as in beginSamplePrecise(). */
+		void beginSamplePrecise(UINT32 sampleId);
+
+		/** Ends sample measurement started with beginSamplePrecise(UINT32). */
+		void endSamplePrecise(UINT32 sampleId);
+
 		/** Clears all sampling data, and ends any unfinished sampling blocks. */
 		void reset();
 
@@ -304,13 +262,81 @@ namespace bs
 		 */
 		CPUProfilerReport generateReport();
 
+		/**
+		 * Records a timeline of the next @p numFrames frames and saves it to a file once done. Timeline contains every
+		 * begin and end of a sample with its timestamp and thread, as well as execution of task scheduler tasks and core
+		 * thread command playback. Use this to see how work is scheduled across threads, which the aggregated data in
+		 * generateReport() cannot show.
+		 *
+		 * @param[in]	numFrames	Number of frames to record. Recording starts at the beginning of the next frame.
+		 * @param[in]	path		Path of the file to save the timeline to.
+		 * @param[in]	format		Format to save the timeline in.
+		 */
+		void captureTimeline(UINT32 numFrames, const Path& path, TimelineFormat format = TimelineFormat::ChromeJSON);
+
+		/** Returns true if a timeline capture was requested and hasn't finished yet. */
+		bool isCapturingTimeline() const;
+
+		/**
+		 * Registers a sample site and returns an identifier that can be used for starting samples without a name lookup.
+		 * Registering the same name multiple times returns the same identifier. 
+		 *
+		 * @note	Thread safe.
+		 */
+		static UINT32 registerSample(const char* name);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Starts, advances or finishes a timeline capture requested with captureTimeline(). Must be called once per frame,
+		 * outside of any samples.
+		 */
+		void _updateTimeline();
+
+		/** @} */
+
 	private:
+		/** States of a timeline capture. */
+		enum class TimelineCaptureState
+		{
+			Inactive,
+			Requested,
+			Recording
+		};
+
+		/** Information about a timeline capture requested through captureTimeline(). */
+		struct TimelineCapture
+		{
+			TimelineCaptureState state = TimelineCaptureState::Inactive;
+			UINT32 numFrames = 0;
+			UINT32 numRecordedFrames = 0;
+			Path path;
+			TimelineFormat format = TimelineFormat::ChromeJSON;
+		};
+
 		/**
 		 * Calculates overhead that the timing and sampling methods themselves introduce so we might get more accurate 
 		 * measurements when creating reports.
 		 */
 		void estimateTimerOverhead();
 
+		/** Returns the number of timestamp counter ticks per millisecond, used for converting basic sample times. */
+		double getTicksPerMs() const;
+
+		/** Returns the name of a sample registered with registerSample(). */
+		static const char* getSampleName(UINT32 sampleId);
+
+		/** Returns information about the current thread, registering the thread if needed. */
+		ThreadInfo* getActiveThread();
+
+		/** Starts a basic sample for ProfilerScope. Returns the thread the sample was started on. */
+		static ThreadInfo* beginScope(UINT32 sampleId);
+
+		/** Ends a sample started with beginScope(). */
+		static void endScope(ThreadInfo* thread);
+
 	private:
 		double mBasicTimerOverhead;
 		UINT64 mPreciseTimerOverhead;
@@ -320,8 +346,14 @@ namespace bs
 		UINT64 mBasicSamplingOverheadCycles;
 		UINT64 mPreciseSamplingOverheadCycles;
 
+		UINT64 mStartTicks;
+		std::chrono::high_resolution_clock::time_point mStartTime;
+
 		ProfilerVector<ThreadInfo*> mActiveThreads;
 		Mutex mThreadSync;
+
+		TimelineCapture mTimelineCapture;
+		mutable Mutex mTimelineSync;
 	};
 
 	/** Profiling entry containing information about a single CPU profiling block containing timing information. */
@@ -336,6 +368,7 @@ namespace bs
 
 			UINT64 memAllocs; /**< Number of memory allocations that happened within the block. */
 			UINT64 memFrees; /**< Number of memory deallocations that happened within the block. */
+			UINT64 memAllocBytes[(int)MemoryCategory::Count]; /**< Number of bytes allocated within the block, per allocator category. */
 
 			double avgTimeMs; /**< Average time it took to execute the block, per call. In milliseconds. */
 			double maxTimeMs; /**< Maximum time of a single call in the block. In milliseconds. */
@@ -368,6 +401,7 @@ namespace bs
 
 			UINT64 memAllocs; /**< Number of memory allocations that happened within the block. */
 			UINT64 memFrees; /**< Number of memory deallocations that happened within the block. */
+			UINT64 memAllocBytes[(int)MemoryCategory::Count]; /**< Number of bytes allocated within the block, per allocator category. */
 
 			UINT64 avgCycles; /**< Average number of cycles it took to execute the block, per call. */
 			UINT64 maxCycles; /**< Maximum number of cycles of a single call in the block. */
@@ -413,11 +447,44 @@ namespace bs
 	/** Provides global access to ProfilerCPU instance. */
 	BS_CORE_EXPORT ProfilerCPU& gProfilerCPU();
 
+	/**
+	 * Begins a sample on construction and ends it on destruction. Use through PROFILE_SCOPE. Remembers the thread the
+	 * sample was started on, so ending it doesn't need to look up the thread again.
+	 */
+	class ProfilerScope
+	{
+	public:
+		ProfilerScope(UINT32 sampleId)
+			:mThread(ProfilerCPU::beginScope(sampleId))
+		{ }
+
+		~ProfilerScope()
+		{
+			ProfilerCPU::endScope(mThread);
+		}
+
+	private:
+		ProfilerCPU::ThreadInfo* mThread;
+	};
+
+#define BS_PROFILER_CONCAT_INNER(a, b) a##b
+#define BS_PROFILER_CONCAT(a, b) BS_PROFILER_CONCAT_INNER(a, b)
+
+	/**
+	 * Profiles the rest of the current scope. Sample site is registered the first time the scope is entered, after which
+	 * taking a sample requires no name lookups or memory allocations.
+	 */
+#define PROFILE_SCOPE(name)																	\
+	static const bs::UINT32 BS_PROFILER_CONCAT(bsProfilerSampleId, __LINE__) =				\
+		bs::ProfilerCPU::registerSample(name);												\
+	bs::ProfilerScope BS_PROFILER_CONCAT(bsProfilerScope, __LINE__)(BS_PROFILER_CONCAT(bsProfilerSampleId, __LINE__));
+
 	/** Shortcut for profiling a single function call. */
-#define PROFILE_CALL(call, name)							\
-	bs::gProfilerCPU().beginSample(name);		\
-	call;													\
-	bs::gProfilerCPU().endSample(name);
+#define PROFILE_CALL(call, name)															\
+	{																						\
+		PROFILE_SCOPE(name)																	\
+		call;																				\
+	}
 
 	/** @} */
 }
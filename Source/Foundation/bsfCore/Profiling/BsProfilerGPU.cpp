@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilerGPU.h"
 #include "Profiling/BsRenderStats.h"
+#include "Profiling/BsProfilingManager.h"
 #include "RenderAPI/BsTimerQuery.h"
 #include "RenderAPI/BsOcclusionQuery.h"
 #include "Error/BsException.h"
@@ -144,6 +145,9 @@ namespace bs
 				freeSample(frameSample);
 				mUnresolvedFrames.pop();
 
+				if (ProfilingManager::isStarted())
+					gProfiler()._recordGPUFrame(report);
+
 				{
 					Lock lock(mMutex);
 					mReadyReports[(mReportHeadPos + mReportCount) % MAX_QUEUE_ELEMENTS] = report;
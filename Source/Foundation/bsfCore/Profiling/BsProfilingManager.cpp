@@ -2,11 +2,93 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilingManager.h"
 #include "Math/BsMath.h"
+#include <algorithm>
 
 namespace bs
 {
 	const UINT32 ProfilingManager::NUM_SAVED_FRAMES = 200;
 
+	/** Minimum number of recorded frames before spike detection kicks in. */
+	static constexpr UINT32 MIN_SPIKE_DETECTION_FRAMES = 30;
+
+	/** Returns the total time of all entries with the provided name in the sample hierarchy. */
+	static double findSampleTime(const CPUProfilerBasicSamplingEntry& entry, const String& name)
+	{
+		if(entry.data.name == name)
+			return entry.data.totalTimeMs;
+
+		double timeMs = 0.0;
+		for(auto& child : entry.childEntries)
+			timeMs += findSampleTime(child, name);
+
+		return timeMs;
+	}
+
+	/** Returns the value at the provided percentile of a sorted list of values, using nearest-rank. */
+	static float getPercentile(const Vector<float>& sorted, float percentile)
+	{
+		UINT32 rank = (UINT32)std::ceil(percentile * sorted.size());
+		rank = Math::clamp(rank, 1U, (UINT32)sorted.size());
+
+		return sorted[rank - 1];
+	}
+
+	void ProfilingManager::FrameTimeHistory::record(float timeMs)
+	{
+		values[next] = timeMs;
+		next = (next + 1) % FRAME_HISTORY_SIZE;
+		count = std::min(count + 1, FRAME_HISTORY_SIZE);
+		numRecorded++;
+	}
+
+	void ProfilingManager::FrameTimeHistory::getValues(Vector<float>& output) const
+	{
+		output.resize(count);
+
+		const UINT32 start = (next + FRAME_HISTORY_SIZE - count) % FRAME_HISTORY_SIZE;
+		for(UINT32 i = 0; i < count; i++)
+			output[i] = values[(start + i) % FRAME_HISTORY_SIZE];
+	}
+
+	FrameTimeStats ProfilingManager::FrameTimeHistory::getStats() const
+	{
+		FrameTimeStats stats;
+		if(count == 0)
+			return stats;
+
+		Vector<float> sorted;
+		getValues(sorted);
+		std::sort(sorted.begin(), sorted.end());
+
+		double total = 0.0;
+		for(auto& value : sorted)
+			total += value;
+
+		stats.p50 = getPercentile(sorted, 0.50f);
+		stats.p95 = getPercentile(sorted, 0.95f);
+		stats.p99 = getPercentile(sorted, 0.99f);
+		stats.max = sorted.back();
+		stats.average = (float)(total / count);
+		stats.numFrames = count;
+
+		return stats;
+	}
+
+	float ProfilingManager::FrameTimeHistory::getMedian() const
+	{
+		if(count == 0)
+			return 0.0f;
+
+		// Only the median is needed, so a partial sort is enough
+		float sorted[FRAME_HISTORY_SIZE];
+		memcpy(sorted, values, count * sizeof(float));
+
+		float* median = sorted + (count - 1) / 2;
+		std::nth_element(sorted, median, sorted + count);
+
+		return *median;
+	}
+
 	ProfilingManager::ProfilingManager()
 		:mSavedSimReports(nullptr), mNextSimReportIdx(0),
 		mSavedCoreReports(nullptr), mNextCoreReportIdx(0)
@@ -28,8 +110,10 @@ namespace bs
 	{
 #if BS_PROFILING_ENABLED
 		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
+		recordCPUFrame(ProfiledThread::Sim, mSavedSimReports[mNextSimReportIdx].cpuReport);
 
 		gProfilerCPU().reset();
+		gProfilerCPU()._updateTimeline();
 
 		mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
 #endif
@@ -40,6 +124,7 @@ namespace bs
 #if BS_PROFILING_ENABLED
 		Lock lock(mSync);
 		mSavedCoreReports[mNextCoreReportIdx].cpuReport = gProfilerCPU().generateReport();
+		recordCPUFrame(ProfiledThread::Core, mSavedCoreReports[mNextCoreReportIdx].cpuReport);
 
 		gProfilerCPU().reset();
 
@@ -69,6 +154,181 @@ namespace bs
 		}
 	}
 
+	void ProfilingManager::recordCPUFrame(ProfiledThread thread, const CPUProfilerReport& report)
+	{
+		const CPUProfilerBasicSamplingEntry& root = report.getBasicSamplingData();
+		const float timeMs = (float)root.data.totalTimeMs;
+
+		const FrameTimeSeries series = thread == ProfiledThread::Sim ? FrameTimeSeries::SimCPU : FrameTimeSeries::CoreCPU;
+
+		Lock lock(mHistorySync);
+		FrameTimeHistory& history = mFrameTimes[(UINT32)series];
+
+		float medianMs;
+		if(isSpike(history, timeMs, medianMs))
+		{
+			FrameSpike spike;
+			spike.series = series;
+			spike.frameIdx = history.numRecorded;
+			spike.timeMs = timeMs;
+			spike.medianMs = medianMs;
+			spike.cpuReport = report;
+
+			addSpike(std::move(spike));
+		}
+
+		history.record(timeMs);
+
+		for(auto& entry : mTrackedSamples)
+		{
+			if(entry.thread == thread)
+				entry.history.record((float)findSampleTime(root, entry.name));
+		}
+	}
+
+	void ProfilingManager::_recordGPUFrame(const GPUProfilerReport& report)
+	{
+		const float timeMs = report.frameSample.timeMs;
+
+		Lock lock(mHistorySync);
+		FrameTimeHistory& history = mFrameTimes[(UINT32)FrameTimeSeries::GPU];
+
+		float medianMs;
+		if(isSpike(history, timeMs, medianMs))
+		{
+			FrameSpike spike;
+			spike.series = FrameTimeSeries::GPU;
+			spike.frameIdx = history.numRecorded;
+			spike.timeMs = timeMs;
+			spike.medianMs = medianMs;
+			spike.gpuReport = report;
+
+			addSpike(std::move(spike));
+		}
+
+		history.record(timeMs);
+	}
+
+	bool ProfilingManager::isSpike(const FrameTimeHistory& history, float timeMs, float& medianMs) const
+	{
+		medianMs = 0.0f;
+
+		if(mSpikeFactor <= 0.0f || history.count < MIN_SPIKE_DETECTION_FRAMES)
+			return false;
+
+		// Cheap early out, so the median only needs calculating for slow frames
+		if(timeMs <= mSpikeMinTimeMs)
+			return false;
+
+		medianMs = history.getMedian();
+		return timeMs > medianMs * mSpikeFactor;
+	}
+
+	void ProfilingManager::addSpike(FrameSpike&& spike)
+	{
+		if(mSpikes.size() == MAX_SAVED_SPIKES)
+			mSpikes.pop_front();
+
+		mSpikes.push_back(std::move(spike));
+	}
+
+	FrameTimeStats ProfilingManager::getFrameTimeStats(FrameTimeSeries series) const
+	{
+		Lock lock(mHistorySync);
+		return mFrameTimes[(UINT32)series].getStats();
+	}
+
+	void ProfilingManager::getFrameTimeHistory(FrameTimeSeries series, Vector<float>& output) const
+	{
+		Lock lock(mHistorySync);
+		mFrameTimes[(UINT32)series].getValues(output);
+	}
+
+	void ProfilingManager::trackSample(ProfiledThread thread, const String& name)
+	{
+		Lock lock(mHistorySync);
+
+		for(auto& entry : mTrackedSamples)
+		{
+			if(entry.thread == thread && entry.name == name)
+				return;
+		}
+
+		mTrackedSamples.push_back(TrackedSample());
+
+		TrackedSample& entry = mTrackedSamples.back();
+		entry.thread = thread;
+		entry.name = name;
+	}
+
+	void ProfilingManager::untrackSample(ProfiledThread thread, const String& name)
+	{
+		Lock lock(mHistorySync);
+
+		auto iterFind = std::find_if(mTrackedSamples.begin(), mTrackedSamples.end(), 
+			[&](const TrackedSample& entry) { return entry.thread == thread && entry.name == name; });
+
+		if(iterFind != mTrackedSamples.end())
+			mTrackedSamples.erase(iterFind);
+	}
+
+	const ProfilingManager::FrameTimeHistory* ProfilingManager::findTrackedSample(ProfiledThread thread, 
+		const String& name) const
+	{
+		for(auto& entry : mTrackedSamples)
+		{
+			if(entry.thread == thread && entry.name == name)
+				return &entry.history;
+		}
+
+		return nullptr;
+	}
+
+	FrameTimeStats ProfilingManager::getSampleTimeStats(ProfiledThread thread, const String& name) const
+	{
+		Lock lock(mHistorySync);
+
+		const FrameTimeHistory* history = findTrackedSample(thread, name);
+		if(history == nullptr)
+			return FrameTimeStats();
+
+		return history->getStats();
+	}
+
+	void ProfilingManager::getSampleTimeHistory(ProfiledThread thread, const String& name, Vector<float>& output) const
+	{
+		Lock lock(mHistorySync);
+
+		const FrameTimeHistory* history = findTrackedSample(thread, name);
+		if(history == nullptr)
+		{
+			output.clear();
+			return;
+		}
+
+		history->getValues(output);
+	}
+
+	void ProfilingManager::setSpikeThreshold(float factor, float minTimeMs)
+	{
+		Lock lock(mHistorySync);
+
+		mSpikeFactor = factor;
+		mSpikeMinTimeMs = minTimeMs;
+	}
+
+	Vector<FrameSpike> ProfilingManager::getSpikes() const
+	{
+		Lock lock(mHistorySync);
+		return Vector<FrameSpike>(mSpikes.begin(), mSpikes.end());
+	}
+
+	void ProfilingManager::clearSpikes()
+	{
+		Lock lock(mHistorySync);
+		mSpikes.clear();
+	}
+
 	ProfilingManager& gProfiler()
 	{
 		return ProfilingManager::instance();
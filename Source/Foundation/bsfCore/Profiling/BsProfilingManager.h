@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Profiling/BsProfilerCPU.h"
+#include "Profiling/BsProfilerGPU.h"
 
 namespace bs
 {
@@ -25,6 +26,41 @@ namespace bs
 		Core
 	};
 
+	/** Per-frame timings tracked by ProfilingManager. */
+	enum class FrameTimeSeries
+	{
+		SimCPU, /**< Time spent by the simulation thread, in milliseconds. */
+		CoreCPU, /**< Time spent by the core thread, in milliseconds. */
+		GPU, /**< Time spent by the GPU, in milliseconds. Only recorded when GPU profiling is active. */
+		Count // Keep at end
+	};
+
+	/** Distribution of frame times over the frames recorded in a frame time history. All values are in milliseconds. */
+	struct FrameTimeStats
+	{
+		float p50 = 0.0f;
+		float p95 = 0.0f;
+		float p99 = 0.0f;
+		float max = 0.0f;
+		float average = 0.0f;
+		UINT32 numFrames = 0; /**< Number of frames the statistics were calculated from. */
+	};
+
+	/** Information about a frame that took significantly longer than a typical frame. */
+	struct FrameSpike
+	{
+		FrameTimeSeries series = FrameTimeSeries::SimCPU; /**< Frame timing that spiked. */
+		UINT64 frameIdx = 0; /**< Sequential index of the frame in the spiked series. */
+		float timeMs = 0.0f; /**< Time the frame took. */
+		float medianMs = 0.0f; /**< Median frame time at the point the spike was detected. */
+
+		/** Full sample hierarchy of the frame. Only valid for SimCPU and CoreCPU spikes. */
+		CPUProfilerReport cpuReport;
+
+		/** Full sample hierarchy of the frame. Only valid for GPU spikes. */
+		GPUProfilerReport gpuReport;
+	};
+
 	/**
 	 * Tracks CPU profiling information with each frame for sim and core threads.
 	 *
@@ -60,7 +96,139 @@ namespace bs
 		 */
 		const ProfilerReport& getReport(ProfiledThread thread, UINT32 idx = 0) const;
 
+		/** 
+		 * Returns percentiles of the frame times over the last FRAME_HISTORY_SIZE frames.
+		 *
+		 * @note	Thread safe.
+		 */
+		FrameTimeStats getFrameTimeStats(FrameTimeSeries series) const;
+
+		/**
+		 * Outputs frame times recorded for the provided series, ordered from oldest to newest.
+		 *
+		 * @note	Thread safe.
+		 */
+		void getFrameTimeHistory(FrameTimeSeries series, Vector<float>& output) const;
+
+		/**
+		 * Starts recording the per-frame time of a CPU sample with the specified name. If the sample appears multiple
+		 * times in the frame's sample hierarchy, the times of all occurrences are summed. Frames in which the sample
+		 * wasn't taken are recorded as zero.
+		 *
+		 * @note	Thread safe.
+		 */
+		void trackSample(ProfiledThread thread, const String& name);
+
+		/** 
+		 * Stops recording a sample previously registered with trackSample() and discards its history.
+		 *
+		 * @note	Thread safe.
+		 */
+		void untrackSample(ProfiledThread thread, const String& name);
+
+		/**
+		 * Returns percentiles of the per-frame times of a sample registered with trackSample(). Returns empty statistics
+		 * if the sample isn't being tracked.
+		 *
+		 * @note	Thread safe.
+		 */
+		FrameTimeStats getSampleTimeStats(ProfiledThread thread, const String& name) const;
+
+		/**
+		 * Outputs per-frame times recorded for a sample registered with trackSample(), ordered from oldest to newest.
+		 *
+		 * @note	Thread safe.
+		 */
+		void getSampleTimeHistory(ProfiledThread thread, const String& name, Vector<float>& output) const;
+
+		/**
+		 * Controls when a frame is considered a spike. A frame is a spike if it took longer than @p factor times the
+		 * median frame time, and longer than @p minTimeMs. Spikes are only detected once enough frames were recorded for
+		 * the median to be meaningful. Set @p factor to zero to disable spike detection.
+		 *
+		 * @note	Thread safe.
+		 */
+		void setSpikeThreshold(float factor, float minTimeMs = 1.0f);
+
+		/**
+		 * Returns the most recently detected frame spikes, ordered from oldest to newest. Up to MAX_SAVED_SPIKES are
+		 * kept. Use FrameSpike::frameIdx to tell apart spikes already seen by a previous call.
+		 *
+		 * @note	Thread safe.
+		 */
+		Vector<FrameSpike> getSpikes() const;
+
+		/** 
+		 * Discards all detected frame spikes.
+		 *
+		 * @note	Thread safe.
+		 */
+		void clearSpikes();
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Records the GPU time of a frame whose GPU profiling report was resolved.
+		 *
+		 * @note	Core thread only.
+		 */
+		void _recordGPUFrame(const GPUProfilerReport& report);
+
+		/** @} */
+
+		/** Number of frames for which frame times are kept. */
+		static constexpr UINT32 FRAME_HISTORY_SIZE = 1024;
+
+		/** Maximum number of frame spikes kept, older spikes are discarded. */
+		static constexpr UINT32 MAX_SAVED_SPIKES = 16;
+
 	private:
+		/** Fixed size ring buffer of per-frame times. */
+		struct FrameTimeHistory
+		{
+			/** Adds a new frame time, overwriting the oldest one if the history is full. */
+			void record(float timeMs);
+
+			/** Calculates percentiles of all recorded frame times. */
+			FrameTimeStats getStats() const;
+
+			/** Outputs all recorded frame times, ordered from oldest to newest. */
+			void getValues(Vector<float>& output) const;
+
+			/** Returns the median of all recorded frame times. */
+			float getMedian() const;
+
+			float values[FRAME_HISTORY_SIZE];
+			UINT32 next = 0;
+			UINT32 count = 0;
+			UINT64 numRecorded = 0;
+		};
+
+		/** Frame time history of a CPU sample tracked by name. */
+		struct TrackedSample
+		{
+			ProfiledThread thread;
+			String name;
+			FrameTimeHistory history;
+		};
+
+		/** Records frame times from a newly generated CPU report, and checks for spikes. */
+		void recordCPUFrame(ProfiledThread thread, const CPUProfilerReport& report);
+
+		/** 
+		 * Checks if the provided frame time should be considered a spike, using the history before the frame was
+		 * recorded. 
+		 */
+		bool isSpike(const FrameTimeHistory& history, float timeMs, float& medianMs) const;
+
+		/** Adds a new spike to the list of saved spikes, discarding the oldest one if full. */
+		void addSpike(FrameSpike&& spike);
+
+		/** Returns the frame time history for a sample tracked by name, or null if the sample isn't being tracked. */
+		const FrameTimeHistory* findTrackedSample(ProfiledThread thread, const String& name) const;
+
 		static const UINT32 NUM_SAVED_FRAMES;
 		ProfilerReport* mSavedSimReports;
 		UINT32 mNextSimReportIdx;
@@ -69,6 +237,13 @@ namespace bs
 		UINT32 mNextCoreReportIdx;
 
 		mutable Mutex mSync;
+
+		FrameTimeHistory mFrameTimes[(UINT32)FrameTimeSeries::Count];
+		Vector<TrackedSample> mTrackedSamples;
+		Deque<FrameSpike> mSpikes;
+		float mSpikeFactor = 2.0f;
+		float mSpikeMinTimeMs = 1.0f;
+		mutable Mutex mHistorySync;
 	};
 
 	/** Easy way to access ProfilingManager. */
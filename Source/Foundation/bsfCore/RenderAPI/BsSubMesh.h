@@ -26,5 +26,22 @@ namespace bs
 		DrawOperationType drawOp;
 	};
 
+	/** Describes a single lower level of detail of a mesh, rendered in place of the full mesh when small on screen. */
+	struct BS_CORE_EXPORT MeshLOD
+	{
+		/** 
+		 * Index ranges to render at this level of detail, one for each sub-mesh of the full mesh. Ranges reference the same
+		 * vertex and index buffers as the full mesh.
+		 */
+		Vector<SubMesh> subMeshes;
+
+		/** 
+		 * Size of the mesh on screen below which this level of detail is used. Size is the diameter of the mesh bounds
+		 * relative to the height of the viewport, meaning a value of 1 corresponds to a mesh covering the viewport
+		 * vertically.
+		 */
+		float screenSize = 0.0f;
+	};
+
 	/** @} */
 }
\ No newline at end of file
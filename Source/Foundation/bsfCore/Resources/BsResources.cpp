@@ -353,7 +353,7 @@ namespace bs
 
 	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
 	{
-		Lock fileLock = FileScheduler::getLock(filePath);
+		FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
 
 		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
 		if (stream == nullptr)
@@ -390,14 +390,40 @@ namespace bs
 				UINT32 objectSize = 0;
 				stream->read(&objectSize, sizeof(objectSize));
 
-				if (metaData->getCompressionMethod() != 0)
-					stream = Compression::decompress(stream);
-
 				BinarySerializer bs;
-				loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
+				if (metaData->getCompressionMethod() != 0)
+				{
+					// Compressed data has to be fully read in order to decompress it, so read it all in one go and decode
+					// it without holding the device access slot
+					const size_t compressedSize = stream->size() - stream->tell();
+					SPtr<MemoryDataStream> compressedData = bs_shared_ptr_new<MemoryDataStream>(compressedSize);
+					stream->read(compressedData->getPtr(), compressedSize);
+					fileSlot.release();
+
+					SPtr<DataStream> compressedStream = compressedData;
+					SPtr<DataStream> decompressedStream = Compression::decompress(compressedStream);
+
+					loadedData = std::static_pointer_cast<SavedResourceData>(
+						bs.decode(decompressedStream, objectSize, params));
+				}
+				else
+				{
+					// Read the object data in one go and decode it without holding the device access slot. Data blocks
+					// meant for streaming (e.g. audio clip samples) keep referencing the file instead of the copy.
+					const UINT32 fileOffset = (UINT32)stream->tell();
+					SPtr<MemoryDataStream> objectData = bs_shared_ptr_new<MemoryDataStream>(objectSize);
+					stream->read(objectData->getPtr(), objectSize);
+					fileSlot.release();
+
+					SPtr<DataStream> objectStream = objectData;
+					loadedData = std::static_pointer_cast<SavedResourceData>(
+						bs.decode(objectStream, objectSize, stream, fileOffset, params));
+				}
 			}
 		}
 
+		fileSlot.release();
+
 		if (loadedData == nullptr)
 		{
 			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
@@ -645,42 +671,44 @@ namespace bs
 		else
 			savePath = filePath;
 		
-		Lock fileLock = FileScheduler::getLock(filePath);
-
-		std::ofstream stream;
-		stream.open(savePath.toPlatformString().c_str(), std::ios::out | std::ios::binary);
-		if (stream.fail())
-			LOGWRN("Failed to save file: \"" + filePath.toString() + "\". Error: " + strerror(errno) + ".");
-	
-		// Write meta-data
+		// Encode everything up front, so the device access slot is only held while writing
+		UINT32 metaNumBytes = 0;
+		UINT8* metaBytes;
 		{
 			MemorySerializer ms;
-			UINT32 numBytes = 0;
-			UINT8* bytes = ms.encode(resourceData.get(), numBytes);
-			
-			stream.write((char*)&numBytes, sizeof(numBytes));
-			stream.write((char*)bytes, numBytes);
-			
-			bs_free(bytes);
+			metaBytes = ms.encode(resourceData.get(), metaNumBytes);
 		}
 
-		// Write object data
+		UINT32 objNumBytes = 0;
+		SPtr<MemoryDataStream> objStream;
 		{
 			MemorySerializer ms;
-			UINT32 numBytes = 0;
-			UINT8* bytes = ms.encode(resource.get(), numBytes);
+			UINT8* bytes = ms.encode(resource.get(), objNumBytes);
 
-			SPtr<MemoryDataStream> objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, numBytes);
+			objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, objNumBytes);
 			if (compressionMethod != 0)
 			{
 				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
 				objStream = Compression::compress(srcStream);
 			}
-
-			stream.write((char*)&numBytes, sizeof(numBytes));
-			stream.write((char*)objStream->getPtr(), objStream->size());
 		}
 
+		FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
+
+		std::ofstream stream;
+		stream.open(savePath.toPlatformString().c_str(), std::ios::out | std::ios::binary);
+		if (stream.fail())
+			LOGWRN("Failed to save file: \"" + filePath.toString() + "\". Error: " + strerror(errno) + ".");
+	
+		// Write meta-data
+		stream.write((char*)&metaNumBytes, sizeof(metaNumBytes));
+		stream.write((char*)metaBytes, metaNumBytes);
+		bs_free(metaBytes);
+
+		// Write object data
+		stream.write((char*)&objNumBytes, sizeof(objNumBytes));
+		stream.write((char*)objStream->getPtr(), objStream->size());
+
 		stream.close();
 		stream.clear();
 
@@ -425,6 +425,56 @@ namespace bs
 			updateWorldTfrm();
 	}
 
+	void SceneObject::_setWorldPoses(const SceneObjectPose* poses, UINT32 count)
+	{
+		// Most objects share the same parent, so avoid looking up its transform for each of them
+		const SceneObject* lastParent = nullptr;
+		const Transform* parentTfrm = nullptr;
+
+		const bool isRunning = gSceneManager().isRunning();
+		for (UINT32 i = 0; i < count; i++)
+		{
+			SceneObject* so = poses[i].sceneObject;
+			if (so->mMobility != ObjectMobility::Movable)
+				continue;
+
+			if (so->mParent != nullptr)
+			{
+				// Parent might have been moved by an earlier entry, in which case its transform needs to be re-fetched
+				if (so->mParent.get() != lastParent || !lastParent->isCachedWorldTfrmUpToDate())
+				{
+					lastParent = so->mParent.get();
+					parentTfrm = &lastParent->getTransform();
+				}
+
+				so->mLocalTfrm.setWorldPosition(poses[i].position, *parentTfrm);
+				so->mLocalTfrm.setWorldRotation(poses[i].rotation, *parentTfrm);
+			}
+			else
+			{
+				so->mLocalTfrm.setPosition(poses[i].position);
+				so->mLocalTfrm.setRotation(poses[i].rotation);
+			}
+
+			so->mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
+			so->mDirtyHash++;
+
+			// Components are notified while the object is still in cache. Visiting all the objects again in a separate
+			// pass is slower once they no longer fit in the cache.
+			for (auto& entry : so->mComponents)
+			{
+				if (entry->supportsNotify(TCF_Transform))
+				{
+					if (isRunning || entry->hasFlag(ComponentFlag::AlwaysRun))
+						entry->onTransformChanged(TCF_Transform);
+				}
+			}
+
+			for (auto& child : so->mChildren)
+				child->notifyTransformChanged(TCF_Transform);
+		}
+	}
+
 	void SceneObject::notifyTransformChanged(TransformChangedFlags flags) const
 	{
 		// If object is immovable, don't send transform changed events nor mark the transform dirty
@@ -30,6 +30,14 @@ namespace bs
 										 user created ones. */
 	};
 
+	/** World space position and rotation of a scene object, used for updating transforms of many objects at once. */
+	struct SceneObjectPose
+	{
+		SceneObject* sceneObject;
+		Vector3 position;
+		Quaternion rotation;
+	};
+
 	/**
 	 * An object in the scene graph. It has a transform object that allows it to be positioned, scaled and rotated. It can
 	 * have other scene objects as children, and will have a scene object as a parent, in which case transform changes
@@ -303,6 +311,16 @@ namespace bs
 		 */
 		UINT32 getTransformHash() const { return mDirtyHash; }
 
+		/**
+		 * Assigns new world position and rotation to a set of scene objects. Components are notified once per object,
+		 * instead of separately for the position and the rotation. Meant for systems that move large numbers of objects
+		 * at once, like physics. Immovable objects are skipped.
+		 *
+		 * @param[in]	poses		Scene objects and the world transforms to assign to them.
+		 * @param[in]	count		Number of entries in the @pposes array.
+		 */
+		static void _setWorldPoses(const SceneObjectPose* poses, UINT32 count);
+
 	private:
 		Transform mLocalTfrm;
 		mutable Transform mWorldTfrm;
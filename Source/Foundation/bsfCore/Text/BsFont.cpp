@@ -3,6 +3,8 @@
 #include "Text/BsFont.h"
 #include "Private/RTTI/BsFontRTTI.h"
 #include "Resources/BsResources.h"
+#include "Text/BsGlyphCache.h"
+#include "Math/BsMath.h"
 
 namespace bs
 {
@@ -32,18 +34,38 @@ namespace bs
 	{ }
 
 	Font::~Font()
-	{ }
+	{
+		// Glyph cache's rasterizer references the font file data, so make sure it is destroyed first
+		mGlyphCache = nullptr;
+	}
 
 	void Font::initialize(const Vector<SPtr<FontBitmap>>& fontData)
 	{
 		for(auto iter = fontData.begin(); iter != fontData.end(); ++iter)
+		{
 			mFontDataPerSize[(*iter)->size] = *iter;
 
+			if ((*iter)->distanceField)
+				mDistanceFieldBitmap = *iter;
+		}
+
 		Resource::initialize();
 	}
 
 	SPtr<FontBitmap> Font::getBitmap(UINT32 size) const
 	{
+		if (isDynamic())
+		{
+			GlyphCache* glyphCache = getGlyphCache();
+			if (glyphCache == nullptr)
+				return nullptr;
+
+			return glyphCache->getBitmap(size);
+		}
+
+		if (mDistanceFieldBitmap != nullptr)
+			return getDistanceFieldBitmap(size);
+
 		auto iterFind = mFontDataPerSize.find(size);
 
 		if(iterFind == mFontDataPerSize.end())
@@ -54,6 +76,10 @@ namespace bs
 
 	INT32 Font::getClosestSize(UINT32 size) const
 	{
+		// Dynamic and distance field fonts can render any size
+		if (isDynamic() || mDistanceFieldBitmap != nullptr)
+			return size;
+
 		UINT32 minDiff = std::numeric_limits<UINT32>::max();
 		UINT32 bestSize = size;
 
@@ -84,6 +110,84 @@ namespace bs
 		return bestSize;
 	}
 
+	void Font::_cacheGlyphs(UINT32 size, const U32String& text) const
+	{
+		GlyphCache* glyphCache = getGlyphCache();
+		if (glyphCache != nullptr)
+			glyphCache->cacheGlyphs(size, text);
+	}
+
+	void Font::_markGlyphPagesUsed(const Vector<UINT32>& pages) const
+	{
+		GlyphCache* glyphCache = getGlyphCache();
+		if (glyphCache != nullptr)
+			glyphCache->markPagesUsed(pages);
+	}
+
+	SPtr<GlyphPageRefs> Font::_referenceGlyphPages(Vector<UINT32> pages) const
+	{
+		if (getGlyphCache() == nullptr)
+			return nullptr;
+
+		return bs_shared_ptr_new<GlyphPageRefs>(mGlyphCache, std::move(pages));
+	}
+
+	GlyphCache* Font::getGlyphCache() const
+	{
+		if (!isDynamic())
+			return nullptr;
+
+		// Created lazily (rather than on initialization) since fonts can be loaded or imported on worker threads, while
+		// the cache is only meant to be used from the sim thread
+		if (mGlyphCache == nullptr && !mGlyphCacheFailed)
+		{
+			mGlyphCache = GlyphCacheManager::instance().createCache(mFontFileData.data(), (UINT32)mFontFileData.size(),
+				mDPI, mRenderMode);
+
+			mGlyphCacheFailed = mGlyphCache == nullptr;
+		}
+
+		return mGlyphCache.get();
+	}
+
+	SPtr<FontBitmap> Font::getDistanceFieldBitmap(UINT32 size) const
+	{
+		if (size == mDistanceFieldBitmap->size || mDistanceFieldBitmap->size == 0)
+			return mDistanceFieldBitmap;
+
+		auto iterFind = mScaledBitmaps.find(size);
+		if (iterFind != mScaledBitmaps.end())
+			return iterFind->second;
+
+		const float scale = size / (float)mDistanceFieldBitmap->size;
+		auto scaleChar = [scale](CharDesc& charDesc)
+		{
+			charDesc.width = Math::roundToPosInt(charDesc.width * scale);
+			charDesc.height = Math::roundToPosInt(charDesc.height * scale);
+			charDesc.xOffset = Math::roundToInt(charDesc.xOffset * scale);
+			charDesc.yOffset = Math::roundToInt(charDesc.yOffset * scale);
+			charDesc.xAdvance = Math::roundToInt(charDesc.xAdvance * scale);
+			charDesc.yAdvance = Math::roundToInt(charDesc.yAdvance * scale);
+
+			for (auto& kerningPair : charDesc.kerningPairs)
+				kerningPair.amount = Math::roundToInt(kerningPair.amount * scale);
+		};
+
+		// Texture pages and UV coordinates are shared, only the size of the generated quads changes
+		SPtr<FontBitmap> bitmap = bs_shared_ptr_new<FontBitmap>(*mDistanceFieldBitmap);
+		bitmap->size = size;
+		bitmap->baselineOffset = Math::roundToInt(bitmap->baselineOffset * scale);
+		bitmap->lineHeight = Math::roundToPosInt(bitmap->lineHeight * scale);
+		bitmap->spaceWidth = Math::roundToPosInt(bitmap->spaceWidth * scale);
+
+		scaleChar(bitmap->missingGlyph);
+		for (auto& entry : bitmap->characters)
+			scaleChar(entry.second);
+
+		mScaledBitmaps[size] = bitmap;
+		return bitmap;
+	}
+
 	void Font::getResourceDependencies(FrameVector<HResource>& dependencies) const
 	{
 		for (auto& fontDataEntry : mFontDataPerSize)
@@ -124,6 +228,25 @@ namespace bs
 		return newFont;
 	}
 
+	HFont Font::createDynamic(const Vector<UINT8>& fontFileData, UINT32 dpi, FontRenderMode renderMode)
+	{
+		SPtr<Font> newFont = _createDynamicPtr(fontFileData, dpi, renderMode);
+
+		return static_resource_cast<Font>(gResources()._createResourceHandle(newFont));
+	}
+
+	SPtr<Font> Font::_createDynamicPtr(const Vector<UINT8>& fontFileData, UINT32 dpi, FontRenderMode renderMode)
+	{
+		SPtr<Font> newFont = bs_core_ptr<Font>(new (bs_alloc<Font>()) Font());
+		newFont->_setThisPtr(newFont);
+		newFont->mFontFileData = fontFileData;
+		newFont->mDPI = dpi;
+		newFont->mRenderMode = renderMode;
+		newFont->initialize(Vector<SPtr<FontBitmap>>());
+
+		return newFont;
+	}
+
 	SPtr<Font> Font::_createEmpty()
 	{
 		SPtr<Font> newFont = bs_core_ptr<Font>(new (bs_alloc<Font>()) Font());
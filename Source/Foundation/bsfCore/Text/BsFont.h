@@ -46,6 +46,12 @@ namespace bs
 		/** All characters in the font referenced by character ID. */
 		Map<UINT32, CharDesc> characters;
 
+		/**
+		 * If true the texture pages contain signed distance fields instead of glyph coverage. Distance field bitmaps can
+		 * be used for rendering text of any size, and require a material that reconstructs the glyph edges.
+		 */
+		bool distanceField = false;
+
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
 		/************************************************************************/
@@ -57,7 +63,8 @@ namespace bs
 
 	/**
 	 * Font resource containing data about textual characters and how to render text. Contains one or multiple font 
-	 * bitmaps, each for a specific size.
+	 * bitmaps, each for a specific size. Alternatively the font can be dynamic, in which case it contains the font file
+	 * itself and bitmaps of any size are generated on demand.
 	 */
 	class BS_CORE_EXPORT BS_SCRIPT_EXPORT(m:GUI_Engine) Font : public Resource
 	{
@@ -74,7 +81,8 @@ namespace bs
 		SPtr<FontBitmap> getBitmap(UINT32 size) const;
 
 		/**	
-		 * Finds the available font bitmap size closest to the provided size. 
+		 * Finds the available font bitmap size closest to the provided size. Dynamic and distance field fonts can provide
+		 * bitmaps of any size, in which case the provided size is returned.
 		 * 
 		 * @param[in]	size	Size of the bitmap in points.
 		 * @return				Nearest available bitmap size.
@@ -82,9 +90,22 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		INT32 getClosestSize(UINT32 size) const;
 
+		/** Checks if the font rasterizes its glyphs on demand, rather than using pre-generated bitmaps. */
+		bool isDynamic() const { return !mFontFileData.empty(); }
+
 		/**	Creates a new font from the provided per-size font data. */
 		static HFont create(const Vector<SPtr<FontBitmap>>& fontInitData);
 
+		/**
+		 * Creates a new dynamic font that rasterizes glyphs of any size on demand.
+		 *
+		 * @param[in]	fontFileData	Contents of a font file (e.g. TTF or OTF) used for rendering the glyphs.
+		 * @param[in]	dpi				Dots per inch resolution to render the glyphs at.
+		 * @param[in]	renderMode		Determines how are the glyphs rendered.
+		 */
+		static HFont createDynamic(const Vector<UINT8>& fontFileData, UINT32 dpi = 96, 
+			FontRenderMode renderMode = FontRenderMode::HintedSmooth);
+
 	public: // ***** INTERNAL ******
 		using Resource::initialize;
 
@@ -102,6 +123,28 @@ namespace bs
 		/** Creates a new font as a pointer instead of a resource handle. */
 		static SPtr<Font> _createPtr(const Vector<SPtr<FontBitmap>>& fontInitData);
 
+		/** Creates a new dynamic font as a pointer instead of a resource handle. */
+		static SPtr<Font> _createDynamicPtr(const Vector<UINT8>& fontFileData, UINT32 dpi, FontRenderMode renderMode);
+
+		/**
+		 * Makes sure the bitmap of the specified size contains glyphs for all characters in the provided text. Only
+		 * relevant for dynamic fonts, must be called before accessing the characters of the bitmap.
+		 */
+		void _cacheGlyphs(UINT32 size, const U32String& text) const;
+
+		/**
+		 * Marks the glyph cache pages with the specified indices as used in the current frame, preventing their eviction
+		 * during it. Allows text whose glyphs are known to be cached to skip _cacheGlyphs(). Only relevant for dynamic
+		 * fonts.
+		 */
+		void _markGlyphPagesUsed(const Vector<UINT32>& pages) const;
+
+		/**
+		 * Prevents the glyph cache pages with the specified indices from being evicted, for as long as the returned object
+		 * exists. Only relevant for dynamic fonts, returns null for other fonts.
+		 */
+		SPtr<GlyphPageRefs> _referenceGlyphPages(Vector<UINT32> pages) const;
+
 		/** Creates a Font without initializing it. */
 		static SPtr<Font> _createEmpty();
 
@@ -118,9 +161,32 @@ namespace bs
 		/** @copydoc CoreObject::getCoreDependencies */
 		void getCoreDependencies(Vector<CoreObject*>& dependencies) override;
 
+		/**
+		 * Returns the cache containing glyphs of a dynamic font, creating it on first use. Returns null if the font is not
+		 * dynamic or the cache cannot be created.
+		 */
+		GlyphCache* getGlyphCache() const;
+
+		/**
+		 * Returns a bitmap of the specified size created from the font's distance field bitmap. The bitmap shares the
+		 * distance field textures, while its character metrics are scaled to the requested size.
+		 */
+		SPtr<FontBitmap> getDistanceFieldBitmap(UINT32 size) const;
+
 	private:
 		Map<UINT32, SPtr<FontBitmap>> mFontDataPerSize;
 
+		// Distance field fonts only
+		SPtr<FontBitmap> mDistanceFieldBitmap;
+		mutable Map<UINT32, SPtr<FontBitmap>> mScaledBitmaps;
+
+		// Dynamic fonts only
+		Vector<UINT8> mFontFileData;
+		UINT32 mDPI = 96;
+		FontRenderMode mRenderMode = FontRenderMode::HintedSmooth;
+		mutable SPtr<GlyphCache> mGlyphCache;
+		mutable bool mGlyphCacheFailed = false;
+
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
 		/************************************************************************/
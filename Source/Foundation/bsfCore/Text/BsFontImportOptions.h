@@ -12,15 +12,6 @@ namespace bs
 	 *  @{
 	 */
 
-	/**	Determines how is a font rendered into the bitmap texture. */
-	enum class FontRenderMode
-	{
-		Smooth, /*< Render antialiased fonts without hinting (slightly more blurry). */
-		Raster, /*< Render non-antialiased fonts without hinting (slightly more blurry). */
-		HintedSmooth, /*< Render antialiased fonts with hinting. */
-		HintedRaster /*< Render non-antialiased fonts with hinting. */
-	};
-
 	/**	Import options that allow you to control how is a font imported. */
 	class BS_CORE_EXPORT FontImportOptions : public ImportOptions
 	{
@@ -42,12 +33,29 @@ namespace bs
 		/**	Set the render mode used for rendering the characters into a bitmap. */
 		void setRenderMode(FontRenderMode renderMode) { mRenderMode = renderMode; }
 
-		/**	Sets whether the bold font style should be used when rendering. */
+		/**	Sets whether the bold font style should be used when rendering. Not supported for dynamic fonts. */
 		void setBold(bool bold) { mBold = bold; }
 
-		/**	Sets whether the italic font style should be used when rendering. */
+		/**	Sets whether the italic font style should be used when rendering. Not supported for dynamic fonts. */
 		void setItalic(bool italic) { mItalic = italic; }
 
+		/**
+		 * Determines if the font glyphs should be rasterized at runtime, as they are needed. When enabled the font file
+		 * data is stored in the font resource and no bitmaps are generated during import, meaning font sizes and
+		 * character ranges are ignored. Glyphs of any size are instead rendered on demand into a shared texture atlas.
+		 * This is preferable for fonts with a large number of characters (e.g. CJK), or when many different sizes are
+		 * needed. Requires the font importer plugin to be loaded at runtime.
+		 */
+		void setDynamic(bool dynamic) { mDynamic = dynamic; }
+
+		/**
+		 * Determines if the font should be imported as a signed distance field. When enabled only a single bitmap is
+		 * generated, at the largest of the provided font sizes, and text of any size is rendered from it with smooth
+		 * edges. This significantly reduces the memory used by fonts needed at many different sizes. Larger source sizes
+		 * (e.g. 48 or more points) yield better quality at large text sizes.
+		 */
+		void setDistanceField(bool distanceField) { mDistanceField = distanceField; }
+
 		/**	Gets the sizes that are to be imported. Ranges are defined as unicode numbers. */
 		Vector<UINT32> getFontSizes() const { return mFontSizes; }
 
@@ -66,6 +74,12 @@ namespace bs
 		/**	Sets whether the italic font style should be used when rendering. */
 		bool getItalic() const { return mItalic; }
 
+		/** @copydoc setDynamic */
+		bool getDynamic() const { return mDynamic; }
+
+		/** @copydoc setDistanceField */
+		bool getDistanceField() const { return mDistanceField; }
+
 		/** Creates a new import options object that allows you to customize how are fonts imported. */
 		static SPtr<FontImportOptions> create();
 
@@ -76,6 +90,8 @@ namespace bs
 		FontRenderMode mRenderMode;
 		bool mBold;
 		bool mItalic;
+		bool mDynamic;
+		bool mDistanceField;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
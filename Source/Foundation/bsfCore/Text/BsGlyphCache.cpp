@@ -0,0 +1,472 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Text/BsGlyphCache.h"
+#include "Text/BsFont.h"
+#include "Image/BsTexture.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "Utility/BsTime.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	GlyphAtlas::GlyphAtlas(UINT32 pageSize, UINT32 maxPages)
+		: mPageSize(pageSize), mMaxPages(std::max(1U, maxPages))
+	{ }
+
+	GlyphAllocResult GlyphAtlas::allocate(const GlyphKey& glyph, UINT32 width, UINT32 height, UINT64 frameIdx,
+		UINT32& pageIdx, UINT32& x, UINT32& y, Vector<GlyphKey>& evictedGlyphs)
+	{
+		if (width > mPageSize || height > mPageSize)
+			return GlyphAllocResult::Failed;
+
+		GlyphAllocResult result = GlyphAllocResult::Allocated;
+		pageIdx = (UINT32)-1;
+		for (UINT32 i = 0; i < (UINT32)mPages.size(); i++)
+		{
+			if (mPages[i].layout.addElement(width, height, x, y))
+			{
+				pageIdx = i;
+				break;
+			}
+		}
+
+		if (pageIdx == (UINT32)-1)
+		{
+			// No room, evict the least recently used page. Referenced pages and pages used during the current frame
+			// cannot be evicted as displayed text, or text generated this frame, might be referencing their glyphs.
+			if ((UINT32)mPages.size() >= mMaxPages)
+			{
+				UINT64 lruFrame = frameIdx;
+				for (UINT32 i = 0; i < (UINT32)mPages.size(); i++)
+				{
+					if (mPages[i].numRefs == 0 && mPages[i].lastUsedFrame < lruFrame)
+					{
+						lruFrame = mPages[i].lastUsedFrame;
+						pageIdx = i;
+					}
+				}
+			}
+
+			if (pageIdx != (UINT32)-1)
+			{
+				clearPage(mPages[pageIdx], evictedGlyphs);
+				result = GlyphAllocResult::EvictedPage;
+			}
+			else
+			{
+				addPage(frameIdx);
+
+				pageIdx = (UINT32)mPages.size() - 1;
+				result = GlyphAllocResult::AddedPage;
+			}
+
+			// Always fits as the glyph is not larger than an empty page
+			mPages[pageIdx].layout.addElement(width, height, x, y);
+		}
+
+		Page& page = mPages[pageIdx];
+		page.glyphs.push_back(glyph);
+		page.lastUsedFrame = frameIdx;
+		markDirty(page, Rect2I((INT32)x, (INT32)y, width, height));
+
+		return result;
+	}
+
+	void GlyphAtlas::addPage(UINT64 frameIdx)
+	{
+		if (!mPages.empty() && (UINT32)mPages.size() == mMaxPages)
+			LOGWRN("Glyph cache page limit exceeded. Consider increasing the limit.");
+
+		Page page;
+		page.layout = TextureAtlasLayout(mPageSize, mPageSize, mPageSize, mPageSize);
+		page.lastUsedFrame = frameIdx;
+		page.dirtyRect = Rect2I(0, 0, mPageSize, mPageSize);
+
+		mPages.push_back(page);
+	}
+
+	bool GlyphAtlas::removeExcessPage(UINT64 frameIdx, Vector<GlyphKey>& evictedGlyphs)
+	{
+		if ((UINT32)mPages.size() <= mMaxPages)
+			return false;
+
+		Page& lastPage = mPages.back();
+		if (lastPage.numRefs > 0 || lastPage.lastUsedFrame >= frameIdx)
+			return false;
+
+		evictedGlyphs.insert(evictedGlyphs.end(), lastPage.glyphs.begin(), lastPage.glyphs.end());
+		mPages.pop_back();
+
+		return true;
+	}
+
+	void GlyphAtlas::removeRef(UINT32 pageIdx)
+	{
+		assert(mPages[pageIdx].numRefs > 0);
+		mPages[pageIdx].numRefs--;
+	}
+
+	void GlyphAtlas::markDirty(Page& page, const Rect2I& area)
+	{
+		if (page.dirtyRect.width == 0 || page.dirtyRect.height == 0)
+			page.dirtyRect = area;
+		else
+			page.dirtyRect.encapsulate(area);
+	}
+
+	void GlyphAtlas::clearPage(Page& page, Vector<GlyphKey>& evictedGlyphs)
+	{
+		evictedGlyphs.insert(evictedGlyphs.end(), page.glyphs.begin(), page.glyphs.end());
+
+		page.glyphs.clear();
+		page.layout.clear();
+
+		// Stale pixels are cleared so they don't bleed into the padding of new glyphs
+		page.dirtyRect = Rect2I(0, 0, mPageSize, mPageSize);
+	}
+
+	/** Copies a region of a page to a texture through a temporary texture, so only the region itself is uploaded. */
+	static void uploadGlyphPageRegion(const SPtr<ct::Texture>& texture, const SPtr<PixelData>& data, INT32 x, INT32 y)
+	{
+		SPtr<ct::Texture> regionTexture = ct::Texture::create(data);
+
+		TEXTURE_COPY_DESC copyDesc;
+		copyDesc.dstPosition = Vector3I(x, y, 0);
+
+		regionTexture->copy(texture, copyDesc);
+	}
+
+	GlyphCache::GlyphCache(const SPtr<GlyphRasterizer>& rasterizer, UINT32 pageSize, UINT32 maxPages)
+		: mRasterizer(rasterizer), mAtlas(pageSize, maxPages)
+	{
+		GlyphCacheManager::instance()._registerCache(this);
+	}
+
+	GlyphCache::~GlyphCache()
+	{
+		if (GlyphCacheManager::isStarted())
+			GlyphCacheManager::instance()._unregisterCache(this);
+	}
+
+	SPtr<FontBitmap> GlyphCache::getBitmap(UINT32 size)
+	{
+		return getSizeEntry(size).bitmap;
+	}
+
+	GlyphCache::SizeEntry& GlyphCache::getSizeEntry(UINT32 size)
+	{
+		auto iterFind = mSizes.find(size);
+		if (iterFind != mSizes.end())
+			return iterFind->second;
+
+		FontSizeMetrics metrics = mRasterizer->getSizeMetrics(size);
+
+		SizeEntry& entry = mSizes[size];
+		entry.bitmap = bs_shared_ptr_new<FontBitmap>();
+		entry.bitmap->size = size;
+		entry.bitmap->baselineOffset = metrics.baselineOffset;
+		entry.bitmap->lineHeight = metrics.lineHeight;
+		entry.bitmap->spaceWidth = metrics.spaceWidth;
+		entry.bitmap->missingGlyph = CharDesc();
+		entry.bitmap->texturePages = mTextures;
+
+		// Text is only generated if the font has at least one page
+		if (mAtlas.getNumPages() == 0)
+		{
+			mAtlas.addPage(gTime().getFrameIdx());
+			addPage();
+		}
+
+		return entry;
+	}
+
+	void GlyphCache::cacheGlyphs(UINT32 size, const U32String& text)
+	{
+		SizeEntry& entry = getSizeEntry(size);
+		FontBitmap& bitmap = *entry.bitmap;
+
+		const UINT64 frameIdx = gTime().getFrameIdx();
+
+		if (!entry.hasMissingGlyph)
+			entry.hasMissingGlyph = addGlyph(size, bitmap, GlyphRasterizer::MISSING_GLYPH_ID);
+		else
+			mAtlas.markUsed(bitmap.missingGlyph.page, frameIdx);
+
+		for (auto& charId : text)
+		{
+			// Whitespace is handled by the text layout and doesn't need a glyph
+			if (charId == ' ' || charId == '\t' || charId == '\n' || charId == '\r')
+				continue;
+
+			auto iterFind = bitmap.characters.find(charId);
+			if (iterFind != bitmap.characters.end())
+			{
+				mAtlas.markUsed(iterFind->second.page, frameIdx);
+				continue;
+			}
+
+			if (entry.unsupportedChars.find(charId) != entry.unsupportedChars.end())
+				continue;
+
+			if (!addGlyph(size, bitmap, charId))
+				entry.unsupportedChars.insert(charId);
+		}
+	}
+
+	void GlyphCache::markPagesUsed(const Vector<UINT32>& pages)
+	{
+		const UINT64 frameIdx = gTime().getFrameIdx();
+		for (auto& pageIdx : pages)
+			mAtlas.markUsed(pageIdx, frameIdx);
+	}
+
+	bool GlyphCache::addGlyph(UINT32 size, FontBitmap& bitmap, UINT32 charId)
+	{
+		RasterizedGlyph glyph;
+		if (!mRasterizer->rasterize(charId, size, glyph))
+			return false;
+
+		// Leave a pixel of padding between glyphs so they don't bleed into each other when filtered
+		UINT32 pageIdx = 0, x = 0, y = 0;
+		Vector<GlyphAtlas::GlyphKey> evictedGlyphs;
+		GlyphAllocResult result = mAtlas.allocate(std::make_pair(size, charId), glyph.width + 1, glyph.height + 1,
+			gTime().getFrameIdx(), pageIdx, x, y, evictedGlyphs);
+
+		switch (result)
+		{
+		case GlyphAllocResult::Failed:
+			LOGWRN("Glyph of size " + toString(glyph.width) + "x" + toString(glyph.height) + " doesn't fit in a glyph "
+				"cache page.");
+			return false;
+		case GlyphAllocResult::EvictedPage:
+			evictGlyphs(pageIdx, evictedGlyphs);
+			break;
+		case GlyphAllocResult::AddedPage:
+			addPage();
+			break;
+		default:
+			break;
+		}
+
+		// Pages are stored in two channel format, same as imported fonts
+		const UINT32 pageSize = mAtlas.getPageSize();
+		const UINT32 rowPitch = pageSize * 2;
+		UINT8* dst = mPixels[pageIdx]->getData() + y * rowPitch + x * 2;
+		const UINT8* src = glyph.pixels.data();
+		for (UINT32 row = 0; row < glyph.height; row++)
+		{
+			for (UINT32 column = 0; column < glyph.width; column++)
+			{
+				dst[column * 2 + 0] = src[column];
+				dst[column * 2 + 1] = src[column];
+			}
+
+			dst += rowPitch;
+			src += glyph.width;
+		}
+
+		const float invPageSize = 1.0f / pageSize;
+
+		CharDesc charDesc;
+		charDesc.charId = charId;
+		charDesc.page = pageIdx;
+		charDesc.uvX = x * invPageSize;
+		charDesc.uvY = y * invPageSize;
+		charDesc.uvWidth = glyph.width * invPageSize;
+		charDesc.uvHeight = glyph.height * invPageSize;
+		charDesc.width = glyph.width;
+		charDesc.height = glyph.height;
+		charDesc.xOffset = glyph.xOffset;
+		charDesc.yOffset = glyph.yOffset;
+		charDesc.xAdvance = glyph.xAdvance;
+		charDesc.yAdvance = glyph.yAdvance;
+
+		if (charId == GlyphRasterizer::MISSING_GLYPH_ID)
+			bitmap.missingGlyph = charDesc;
+		else
+			bitmap.characters[charId] = charDesc;
+
+		return true;
+	}
+
+	void GlyphCache::evictGlyphs(UINT32 pageIdx, const Vector<GlyphAtlas::GlyphKey>& glyphs)
+	{
+		for (auto& glyph : glyphs)
+		{
+			SizeEntry& entry = mSizes[glyph.first];
+			if (glyph.second == GlyphRasterizer::MISSING_GLYPH_ID)
+			{
+				entry.bitmap->missingGlyph = CharDesc();
+				entry.hasMissingGlyph = false;
+			}
+			else
+				entry.bitmap->characters.erase(glyph.second);
+		}
+
+		memset(mPixels[pageIdx]->getData(), 0, mPixels[pageIdx]->getSize());
+
+		GlyphCacheManager::instance()._notifyEvicted(mTextures[pageIdx]);
+	}
+
+	void GlyphCache::addPage()
+	{
+		const UINT32 pageSize = mAtlas.getPageSize();
+		const UINT32 pageIdx = (UINT32)mTextures.size();
+
+		SPtr<PixelData> pixels = bs_shared_ptr_new<PixelData>(pageSize, pageSize, 1, PF_RG8);
+		pixels->allocateInternalBuffer();
+		memset(pixels->getData(), 0, pixels->getSize());
+
+		TEXTURE_DESC texDesc;
+		texDesc.width = pageSize;
+		texDesc.height = pageSize;
+		texDesc.format = PF_RG8;
+		texDesc.usage = TU_DYNAMIC;
+
+		HTexture texture = Texture::create(texDesc);
+		texture->setName(u8"GlyphCachePage" + toString(pageIdx));
+
+		for (auto& entry : mSizes)
+			entry.second.bitmap->texturePages.push_back(texture);
+
+		mTextures.push_back(texture);
+		mPixels.push_back(pixels);
+	}
+
+	void GlyphCache::_update()
+	{
+		// Trim pages added above the limit, once they are no longer in use
+		const UINT64 frameIdx = gTime().getFrameIdx();
+
+		Vector<GlyphAtlas::GlyphKey> evictedGlyphs;
+		while (mAtlas.removeExcessPage(frameIdx, evictedGlyphs))
+		{
+			const UINT32 pageIdx = (UINT32)mTextures.size() - 1;
+			evictGlyphs(pageIdx, evictedGlyphs);
+			evictedGlyphs.clear();
+
+			mTextures.pop_back();
+			mPixels.pop_back();
+
+			for (auto& entry : mSizes)
+				entry.second.bitmap->texturePages.pop_back();
+		}
+
+		// Upload the modified regions of all pages in one go
+		const UINT32 pageSize = mAtlas.getPageSize();
+		for (UINT32 i = 0; i < mAtlas.getNumPages(); i++)
+		{
+			const Rect2I& dirtyRect = mAtlas.getDirtyRect(i);
+			if (dirtyRect.width == 0 || dirtyRect.height == 0)
+				continue;
+
+			// Texture keeps the provided buffer locked until the write completes, so make a copy as the page might get
+			// modified before that
+			const PixelData& pixels = *mPixels[i];
+			const TextureProperties& texProps = mTextures[i]->getProperties();
+
+			if (dirtyRect.width == pageSize && dirtyRect.height == pageSize)
+			{
+				SPtr<PixelData> uploadData = texProps.allocBuffer(0, 0);
+
+				if (texProps.getFormat() != pixels.getFormat())
+					PixelUtil::bulkPixelConversion(pixels, *uploadData);
+				else
+					memcpy(uploadData->getData(), pixels.getData(), pixels.getSize());
+
+				mTextures[i]->writeData(uploadData, 0, 0, true);
+			}
+			else
+			{
+				// Only a part of the page was modified, most commonly by a few newly added glyphs
+				SPtr<PixelData> region = bs_shared_ptr_new<PixelData>(dirtyRect.width, dirtyRect.height, 1,
+					pixels.getFormat());
+				region->allocateInternalBuffer();
+
+				const UINT32 pixelSize = PixelUtil::getNumElemBytes(pixels.getFormat());
+				const UINT32 srcRowPitch = pageSize * pixelSize;
+				const UINT32 dstRowPitch = dirtyRect.width * pixelSize;
+
+				const UINT8* src = pixels.getData() + dirtyRect.y * srcRowPitch + dirtyRect.x * pixelSize;
+				UINT8* dst = region->getData();
+				for (UINT32 row = 0; row < dirtyRect.height; row++)
+				{
+					memcpy(dst, src, dstRowPitch);
+
+					src += srcRowPitch;
+					dst += dstRowPitch;
+				}
+
+				SPtr<PixelData> uploadData = region;
+				if (texProps.getFormat() != pixels.getFormat())
+				{
+					uploadData = bs_shared_ptr_new<PixelData>(dirtyRect.width, dirtyRect.height, 1, texProps.getFormat());
+					uploadData->allocateInternalBuffer();
+
+					PixelUtil::bulkPixelConversion(*region, *uploadData);
+				}
+
+				gCoreThread().queueCommand(std::bind(&uploadGlyphPageRegion, mTextures[i]->getCore(), uploadData,
+					dirtyRect.x, dirtyRect.y));
+			}
+
+			mAtlas.clearDirtyRect(i);
+		}
+	}
+
+	GlyphPageRefs::GlyphPageRefs(const SPtr<GlyphCache>& cache, Vector<UINT32> pages)
+		: mCache(cache), mPages(std::move(pages))
+	{
+		for (auto& pageIdx : mPages)
+			cache->mAtlas.addRef(pageIdx);
+	}
+
+	GlyphPageRefs::~GlyphPageRefs()
+	{
+		// Cache might have been destroyed along with its font before the text referencing it
+		SPtr<GlyphCache> cache = mCache.lock();
+		if (cache == nullptr)
+			return;
+
+		for (auto& pageIdx : mPages)
+			cache->mAtlas.removeRef(pageIdx);
+	}
+
+	SPtr<GlyphCache> GlyphCacheManager::createCache(const UINT8* data, UINT32 size, UINT32 dpi,
+		FontRenderMode renderMode)
+	{
+		if (mRasterizerFactory == nullptr)
+		{
+			LOGWRN("Cannot create a glyph cache for a dynamic font because no glyph rasterizer is available. Make sure "
+				"the font importer plugin is loaded.");
+			return nullptr;
+		}
+
+		SPtr<GlyphRasterizer> rasterizer = mRasterizerFactory->create(data, size, dpi, renderMode);
+		if (rasterizer == nullptr)
+			return nullptr;
+
+		return bs_shared_ptr_new<GlyphCache>(rasterizer);
+	}
+
+	void GlyphCacheManager::_notifyEvicted(const HTexture& page)
+	{
+		mEvictionCount++;
+		mEvictedPages.push_back(std::make_pair(mEvictionCount, page));
+	}
+
+	void GlyphCacheManager::_update()
+	{
+		for (auto& cache : mCaches)
+			cache->_update();
+
+		// Keep the pages evicted during this frame, so they can be seen by systems updated before the evictions happened
+		auto iterEnd = std::remove_if(mEvictedPages.begin(), mEvictedPages.end(),
+			[this](const std::pair<UINT64, HTexture>& entry) { return entry.first <= mPrevFrameEvictionCount; });
+		mEvictedPages.erase(iterEnd, mEvictedPages.end());
+
+		mPrevFrameEvictionCount = mEvictionCount;
+	}
+}
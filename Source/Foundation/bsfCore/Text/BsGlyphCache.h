@@ -0,0 +1,328 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Text/BsFontDesc.h"
+#include "Image/BsTextureAtlasLayout.h"
+#include "Math/BsRect2I.h"
+#include "Utility/BsModule.h"
+
+namespace bs
+{
+	/** @addtogroup Text-Internal
+	 *  @{
+	 */
+
+	/** Pixels and placement information of a single rasterized glyph. */
+	struct RasterizedGlyph
+	{
+		UINT32 width = 0; /**< Width of the glyph bitmap, in pixels. */
+		UINT32 height = 0; /**< Height of the glyph bitmap, in pixels. */
+		INT32 xOffset = 0, yOffset = 0; /**< Offset for the visible portion of the glyph, in pixels. */
+		INT32 xAdvance = 0, yAdvance = 0; /**< How much to advance the pen after writing this glyph, in pixels. */
+
+		/** Glyph coverage with one byte per pixel, in rows from top to bottom. Contains width * height entries. */
+		Vector<UINT8> pixels;
+	};
+
+	/** Information that applies to all glyphs of a font of a specific size. */
+	struct FontSizeMetrics
+	{
+		INT32 baselineOffset = 0; /**< Y offset to the baseline on which the characters are placed, in pixels. */
+		UINT32 lineHeight = 0; /**< Height of a single line of the font, in pixels. */
+		UINT32 spaceWidth = 0; /**< Width of a space in pixels. */
+	};
+
+	/** Renders individual font glyphs on demand. Implementation is provided by a plugin capable of parsing font files. */
+	class BS_CORE_EXPORT GlyphRasterizer
+	{
+	public:
+		virtual ~GlyphRasterizer() = default;
+
+		/** Returns information that applies to all glyphs of the specified font size (in points). */
+		virtual FontSizeMetrics getSizeMetrics(UINT32 size) = 0;
+
+		/**
+		 * Renders a single glyph.
+		 *
+		 * @param[in]	charId		Unicode key of the character to render, or MISSING_GLYPH_ID to render the glyph used for
+		 *							characters not present in the font.
+		 * @param[in]	size		Size of the font, in points.
+		 * @param[out]	output		Rendered glyph.
+		 * @return					False if the font doesn't contain a glyph for the specified character.
+		 */
+		virtual bool rasterize(UINT32 charId, UINT32 size, RasterizedGlyph& output) = 0;
+
+		/** Character ID that can be provided to rasterize() in order to render the glyph for missing characters. */
+		static constexpr UINT32 MISSING_GLYPH_ID = std::numeric_limits<UINT32>::max();
+	};
+
+	/** Creates glyph rasterizers from font file data. */
+	class BS_CORE_EXPORT GlyphRasterizerFactory
+	{
+	public:
+		virtual ~GlyphRasterizerFactory() = default;
+
+		/**
+		 * Creates a new rasterizer for the provided font file.
+		 *
+		 * @param[in]	data		Contents of the font file. Must remain valid for the lifetime of the rasterizer.
+		 * @param[in]	size		Size of @p data, in bytes.
+		 * @param[in]	dpi			Dots per inch resolution to render the glyphs at.
+		 * @param[in]	renderMode	Determines how are glyphs rendered.
+		 * @return					New rasterizer, or null if the font file cannot be parsed.
+		 */
+		virtual SPtr<GlyphRasterizer> create(const UINT8* data, UINT32 size, UINT32 dpi, FontRenderMode renderMode) = 0;
+	};
+
+	/** Result of GlyphAtlas::allocate(). */
+	enum class GlyphAllocResult
+	{
+		Failed, /**< Glyph is larger than a page. */
+		Allocated, /**< Glyph was placed in free space of an existing page. */
+		EvictedPage, /**< All glyphs of a page were evicted, and the glyph was placed on the emptied page. */
+		AddedPage /**< Glyph was placed on a newly added page. */
+	};
+
+	/**
+	 * Packs glyphs into a set of equally sized pages and decides which pages get evicted once the page limit is reached.
+	 * Only keeps track of the glyph placement and page usage, while the pixels and textures of the pages are stored
+	 * by the owner (see GlyphCache).
+	 */
+	class BS_CORE_EXPORT GlyphAtlas
+	{
+	public:
+		/** Identifies a glyph stored in the atlas by its font size and character ID. */
+		typedef std::pair<UINT32, UINT32> GlyphKey;
+
+		/**
+		 * @param[in]	pageSize	Width and height of a single page, in pixels.
+		 * @param[in]	maxPages	Maximum number of pages to keep. Once reached, least recently used pages are evicted. The
+		 *							limit can be temporarily exceeded if all pages are in use.
+		 */
+		GlyphAtlas(UINT32 pageSize, UINT32 maxPages);
+
+		/**
+		 * Finds room for a glyph of the specified size. If none of the pages have room and the page limit was reached, the
+		 * least recently used page is evicted and reused. Pages referenced through addRef(), or used during the current
+		 * frame, are never evicted, and a new page is added instead.
+		 *
+		 * @param[in]	glyph			Glyph to allocate the room for.
+		 * @param[in]	width			Width of the glyph, in pixels.
+		 * @param[in]	height			Height of the glyph, in pixels.
+		 * @param[in]	frameIdx		Index of the current frame.
+		 * @param[out]	pageIdx			Index of the page the glyph was placed on.
+		 * @param[out]	x				Horizontal position of the glyph on the page, in pixels.
+		 * @param[out]	y				Vertical position of the glyph on the page, in pixels.
+		 * @param[out]	evictedGlyphs	Glyphs that were stored on the evicted page, if a page was evicted.
+		 * @return						Determines where the glyph was placed, or if it doesn't fit on a page.
+		 */
+		GlyphAllocResult allocate(const GlyphKey& glyph, UINT32 width, UINT32 height, UINT64 frameIdx, UINT32& pageIdx,
+			UINT32& x, UINT32& y, Vector<GlyphKey>& evictedGlyphs);
+
+		/** Adds a new empty page. */
+		void addPage(UINT64 frameIdx);
+
+		/**
+		 * Removes the last page if it is above the page limit and no longer in use. Only the last page can be removed so
+		 * the indices of the other pages don't change.
+		 *
+		 * @param[in]	frameIdx		Index of the current frame.
+		 * @param[out]	evictedGlyphs	Glyphs that were stored on the removed page.
+		 * @return						True if the page was removed.
+		 */
+		bool removeExcessPage(UINT64 frameIdx, Vector<GlyphKey>& evictedGlyphs);
+
+		/** Marks the page as used during the specified frame, preventing its eviction during that frame. */
+		void markUsed(UINT32 pageIdx, UINT64 frameIdx) { mPages[pageIdx].lastUsedFrame = frameIdx; }
+
+		/** Prevents the page from being evicted until a matching call to removeRef(). */
+		void addRef(UINT32 pageIdx) { mPages[pageIdx].numRefs++; }
+
+		/** Releases a reference previously added with addRef(). */
+		void removeRef(UINT32 pageIdx);
+
+		/** Returns the region of the page modified since the last call to clearDirtyRect(), or an empty area if none. */
+		const Rect2I& getDirtyRect(UINT32 pageIdx) const { return mPages[pageIdx].dirtyRect; }
+
+		/** Marks the page as unmodified, normally called once the page was uploaded. */
+		void clearDirtyRect(UINT32 pageIdx) { mPages[pageIdx].dirtyRect = Rect2I(); }
+
+		/** Returns the number of pages currently in the atlas. */
+		UINT32 getNumPages() const { return (UINT32)mPages.size(); }
+
+		/** Returns the width and height of a single page, in pixels. */
+		UINT32 getPageSize() const { return mPageSize; }
+
+	private:
+		/** Information about a single page. */
+		struct Page
+		{
+			TextureAtlasLayout layout;
+			Vector<GlyphKey> glyphs;
+			UINT64 lastUsedFrame = 0;
+			UINT32 numRefs = 0;
+			Rect2I dirtyRect;
+		};
+
+		/** Adds the provided area to the modified region of the page. */
+		void markDirty(Page& page, const Rect2I& area);
+
+		/** Removes all glyphs from the page, leaving it empty. */
+		void clearPage(Page& page, Vector<GlyphKey>& evictedGlyphs);
+
+		UINT32 mPageSize;
+		UINT32 mMaxPages;
+		Vector<Page> mPages;
+	};
+
+	/**
+	 * Contains glyphs of a single font that are rasterized on demand. Glyphs of all sizes are packed into a shared set of
+	 * atlas pages. Modified regions of the pages are uploaded to the GPU at most once per frame, and when the cache runs
+	 * out of pages the least recently used page is evicted. Pages referenced through GlyphPageRefs, or used during the
+	 * current frame, are never evicted.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_CORE_EXPORT GlyphCache
+	{
+		/** Glyphs and information about a single font size. */
+		struct SizeEntry
+		{
+			SPtr<FontBitmap> bitmap;
+			UnorderedSet<UINT32> unsupportedChars;
+			bool hasMissingGlyph = false;
+		};
+
+	public:
+		/**
+		 * Constructs a new glyph cache.
+		 *
+		 * @param[in]	rasterizer	Rasterizer used for rendering glyphs.
+		 * @param[in]	pageSize	Width and height of a single atlas page, in pixels.
+		 * @param[in]	maxPages	Maximum number of atlas pages to keep. Once reached, least recently used pages are
+		 *							evicted. The limit can be temporarily exceeded if all pages are used in a single frame.
+		 */
+		GlyphCache(const SPtr<GlyphRasterizer>& rasterizer, UINT32 pageSize = 1024, UINT32 maxPages = 4);
+		~GlyphCache();
+
+		/**
+		 * Returns a bitmap containing glyphs of the specified font size, creating it if it doesn't exist. The bitmap will
+		 * only contain characters previously requested through cacheGlyphs().
+		 */
+		SPtr<FontBitmap> getBitmap(UINT32 size);
+
+		/**
+		 * Makes sure that glyphs for all characters in the provided text are present in the bitmap of the specified size,
+		 * and marks them as used in the current frame.
+		 */
+		void cacheGlyphs(UINT32 size, const U32String& text);
+
+		/** Marks the pages with the provided indices as used in the current frame, as stored in CharDesc::page. */
+		void markPagesUsed(const Vector<UINT32>& pages);
+
+		/** Uploads modified pages to the GPU and releases pages above the limit. Called once per frame. */
+		void _update();
+
+	private:
+		friend class GlyphPageRefs;
+
+		/** Returns the entry for the specified size, creating it if it doesn't exist. */
+		SizeEntry& getSizeEntry(UINT32 size);
+
+		/**
+		 * Rasterizes a glyph and packs it into one of the pages. Returns false if the font doesn't contain the glyph or
+		 * it doesn't fit.
+		 */
+		bool addGlyph(UINT32 size, FontBitmap& bitmap, UINT32 charId);
+
+		/** Removes the provided glyphs from the font bitmaps, and clears the pixels of the page they were stored on. */
+		void evictGlyphs(UINT32 pageIdx, const Vector<GlyphAtlas::GlyphKey>& glyphs);
+
+		/** Creates the pixels and the texture of a page newly added to the atlas, and registers it with all font bitmaps. */
+		void addPage();
+
+		SPtr<GlyphRasterizer> mRasterizer;
+		GlyphAtlas mAtlas;
+
+		Vector<HTexture> mTextures;
+		Vector<SPtr<PixelData>> mPixels;
+		Map<UINT32, SizeEntry> mSizes;
+	};
+
+	/**
+	 * Prevents a set of glyph cache pages from being evicted for as long as the object exists. Text geometry referencing
+	 * glyphs of a dynamic font must hold one for as long as it is displayed, since the geometry isn't regenerated every
+	 * frame and therefore doesn't mark its glyphs as used.
+	 */
+	class BS_CORE_EXPORT GlyphPageRefs
+	{
+	public:
+		/**
+		 * Creates references to the provided pages.
+		 *
+		 * @param[in]	cache	Cache containing the pages.
+		 * @param[in]	pages	Indices of the pages to reference, as stored in CharDesc::page.
+		 */
+		GlyphPageRefs(const SPtr<GlyphCache>& cache, Vector<UINT32> pages);
+		~GlyphPageRefs();
+
+		GlyphPageRefs(const GlyphPageRefs&) = delete;
+		GlyphPageRefs& operator=(const GlyphPageRefs&) = delete;
+
+	private:
+		std::weak_ptr<GlyphCache> mCache;
+		Vector<UINT32> mPages;
+	};
+
+	/** Keeps track of all active glyph caches and updates them once per frame. */
+	class BS_CORE_EXPORT GlyphCacheManager : public Module<GlyphCacheManager>
+	{
+	public:
+		/**
+		 * Creates a new glyph cache from the provided font file data. Returns null if no rasterizer factory is registered
+		 * or the font file cannot be parsed.
+		 *
+		 * @copydetails GlyphRasterizerFactory::create
+		 */
+		SPtr<GlyphCache> createCache(const UINT8* data, UINT32 size, UINT32 dpi, FontRenderMode renderMode);
+
+		/**
+		 * Returns a counter that increments every time glyphs are evicted from any of the caches. Any text layouts
+		 * generated before the counter changed might reference evicted glyphs.
+		 */
+		UINT64 getEvictionCount() const { return mEvictionCount; }
+
+		/**
+		 * Returns the textures of pages whose glyphs were evicted during the previous or the current frame, along with the
+		 * value of getEvictionCount() right after each eviction. Text geometry referencing one of these textures needs
+		 * to be regenerated.
+		 */
+		const Vector<std::pair<UINT64, HTexture>>& getEvictedPages() const { return mEvictedPages; }
+
+		/** Updates all active caches. Should be called once per frame, after all text geometry has been generated. */
+		void _update();
+
+		/** Registers a factory used for creating glyph rasterizers. Called by the plugin that provides the rasterizer. */
+		void _setRasterizerFactory(const SPtr<GlyphRasterizerFactory>& factory) { mRasterizerFactory = factory; }
+
+		/** Notifies the manager that glyphs were evicted from a page of a cache. */
+		void _notifyEvicted(const HTexture& page);
+
+		/** Registers a new cache that needs to be updated every frame. */
+		void _registerCache(GlyphCache* cache) { mCaches.insert(cache); }
+
+		/** Unregisters a cache previously registered with _registerCache(). */
+		void _unregisterCache(GlyphCache* cache) { mCaches.erase(cache); }
+
+	private:
+		SPtr<GlyphRasterizerFactory> mRasterizerFactory;
+		UnorderedSet<GlyphCache*> mCaches;
+		UINT64 mEvictionCount = 0;
+		UINT64 mPrevFrameEvictionCount = 0;
+		Vector<std::pair<UINT64, HTexture>> mEvictedPages;
+	};
+
+	/** @} */
+}
@@ -361,6 +361,9 @@ namespace bs
 		if(font != nullptr)
 		{
 			UINT32 nearestSize = font->getClosestSize(fontSize);
+
+			// Dynamic fonts rasterize their glyphs on demand
+			font->_cacheGlyphs(nearestSize, text);
 			mFontData = font->getBitmap(nearestSize);
 		}
 
@@ -549,6 +552,11 @@ namespace bs
 			MemBuffer->deallocAll();
 	}
 
+	bool TextDataBase::isDistanceField() const
+	{
+		return mFontData != nullptr && mFontData->distanceField;
+	}
+
 	const HTexture& TextDataBase::getTextureForPage(UINT32 page) const 
 	{ 
 		return mFontData->texturePages[page]; 
@@ -233,6 +233,12 @@ namespace bs
 		/**	Gets information describing a single line at the specified index. */
 		BS_CORE_EXPORT const TextLine& getLine(UINT32 idx) const { return mLines[idx]; }
 
+		/**
+		 * Checks if the font textures contain signed distance fields, in which case the text must be rendered with a
+		 * material that reconstructs the glyph edges.
+		 */
+		BS_CORE_EXPORT bool isDistanceField() const;
+
 		/**	Returns font texture for the provided page index.  */
 		BS_CORE_EXPORT const HTexture& getTextureForPage(UINT32 page) const;
 
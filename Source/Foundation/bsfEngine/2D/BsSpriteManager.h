@@ -22,6 +22,7 @@ namespace bs
 			ImageOpaque,
 			Text,
 			Line,
+			TextSDF,
 			Count // Keep at end
 		};
 
@@ -41,6 +42,10 @@ namespace bs
 		SpriteMaterial* getTextMaterial() const
 			{ return getMaterial(builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::Text]); }
 
+		/** Returns the material used for rendering text sprites using signed distance field fonts. */
+		SpriteMaterial* getTextSDFMaterial() const
+			{ return getMaterial(builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::TextSDF]); }
+
 		/** Returns the material used for rendering antialiased lines. */
 		SpriteMaterial* getLineMaterial() const
 			{ return getMaterial(builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::Line]); }
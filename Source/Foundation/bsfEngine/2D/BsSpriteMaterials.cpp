@@ -22,4 +22,8 @@ namespace bs
 	SpriteLineMaterial::SpriteLineMaterial()
 		: SpriteMaterial(3, BuiltinResources::instance().createSpriteLineMaterial())
 	{ }
+
+	SpriteTextSDFMaterial::SpriteTextSDFMaterial()
+		: SpriteMaterial(4, BuiltinResources::instance().createSpriteTextSDFMaterial())
+	{ }
 }
\ No newline at end of file
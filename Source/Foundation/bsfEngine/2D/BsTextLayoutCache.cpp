@@ -0,0 +1,169 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "2D/BsTextLayoutCache.h"
+#include "Text/BsTextData.h"
+#include "Text/BsFont.h"
+#include "Text/BsGlyphCache.h"
+#include "String/BsUnicode.h"
+
+namespace bs
+{
+	bool TextLayoutCache::Key::matches(const TEXT_SPRITE_DESC& desc, UINT64 fontId, UINT64 glyphVersion) const
+	{
+		return this->fontId == fontId && this->glyphVersion == glyphVersion && fontSize == desc.fontSize &&
+			width == desc.width && height == desc.height && horzAlign == desc.horzAlign &&
+			vertAlign == desc.vertAlign && anchor == desc.anchor && wordWrap == desc.wordWrap &&
+			wordBreak == desc.wordBreak && text == desc.text;
+	}
+
+	TextLayoutCache::TextLayoutCache(UINT32 maxEntries)
+		:mMaxEntries(std::max(1U, maxEntries))
+	{ }
+
+	SPtr<const TextLayout> TextLayoutCache::getLayout(const TEXT_SPRITE_DESC& desc)
+	{
+		UINT64 fontId = 0;
+		UINT64 glyphVersion = 0;
+		bool isDynamic = false;
+		if (desc.font != nullptr)
+		{
+			// Internal ID changes if the font is reloaded, unlike the resource handle
+			fontId = desc.font->getInternalID();
+
+			// Glyphs of dynamic fonts can be evicted and later re-added at a different location, invalidating any
+			// layouts referencing them
+			isDynamic = desc.font->isDynamic();
+			if (isDynamic)
+				glyphVersion = GlyphCacheManager::instance().getEvictionCount();
+		}
+
+		// Looked up without constructing a key, so a hit doesn't need to copy the text
+		size_t hash = getHash(desc, fontId, glyphVersion);
+		const auto range = mLookup.equal_range(hash);
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			const Entry& entry = *iter->second;
+			if (!entry.key.matches(desc, fontId, glyphVersion))
+				continue;
+
+			// Nothing was evicted since the layout was generated, so its glyphs are still cached. They only need to be
+			// marked as used, so they don't get evicted while displayed.
+			if (isDynamic)
+				desc.font->_markGlyphPagesUsed(entry.layout->usedPages);
+
+			mEntries.splice(mEntries.begin(), mEntries, iter->second);
+			return entry.layout;
+		}
+
+		if (isDynamic)
+		{
+			UINT32 nearestSize = desc.font->getClosestSize(desc.fontSize);
+			desc.font->_cacheGlyphs(nearestSize, UTF8::toUTF32(desc.text));
+
+			// Caching the glyphs might have evicted others, including ones from the same text
+			const UINT64 newGlyphVersion = GlyphCacheManager::instance().getEvictionCount();
+			if (newGlyphVersion != glyphVersion)
+			{
+				glyphVersion = newGlyphVersion;
+				hash = getHash(desc, fontId, glyphVersion);
+			}
+		}
+
+		SPtr<const TextLayout> layout = generateLayout(desc);
+
+		Entry entry;
+		entry.key.fontId = fontId;
+		entry.key.glyphVersion = glyphVersion;
+		entry.key.fontSize = desc.fontSize;
+		entry.key.width = desc.width;
+		entry.key.height = desc.height;
+		entry.key.horzAlign = desc.horzAlign;
+		entry.key.vertAlign = desc.vertAlign;
+		entry.key.anchor = desc.anchor;
+		entry.key.wordWrap = desc.wordWrap;
+		entry.key.wordBreak = desc.wordBreak;
+		entry.key.text = desc.text;
+		entry.hash = hash;
+		entry.layout = layout;
+
+		mEntries.push_front(std::move(entry));
+		mLookup.insert(std::make_pair(hash, mEntries.begin()));
+
+		while ((UINT32)mEntries.size() > mMaxEntries)
+		{
+			const auto last = std::prev(mEntries.end());
+			const auto lastRange = mLookup.equal_range(last->hash);
+			for (auto iter = lastRange.first; iter != lastRange.second; ++iter)
+			{
+				if (iter->second == last)
+				{
+					mLookup.erase(iter);
+					break;
+				}
+			}
+
+			mEntries.pop_back();
+		}
+
+		return layout;
+	}
+
+	void TextLayoutCache::clear()
+	{
+		mLookup.clear();
+		mEntries.clear();
+	}
+
+	size_t TextLayoutCache::getHash(const TEXT_SPRITE_DESC& desc, UINT64 fontId, UINT64 glyphVersion)
+	{
+		size_t hash = 0;
+		bs::hash_combine(hash, fontId);
+		bs::hash_combine(hash, glyphVersion);
+		bs::hash_combine(hash, desc.fontSize);
+		bs::hash_combine(hash, desc.width);
+		bs::hash_combine(hash, desc.height);
+		bs::hash_combine(hash, (UINT32)desc.horzAlign);
+		bs::hash_combine(hash, (UINT32)desc.vertAlign);
+		bs::hash_combine(hash, (UINT32)desc.anchor);
+		bs::hash_combine(hash, desc.wordWrap);
+		bs::hash_combine(hash, desc.wordBreak);
+		bs::hash_combine(hash, desc.text);
+
+		return hash;
+	}
+
+	SPtr<TextLayout> TextLayoutCache::generateLayout(const TEXT_SPRITE_DESC& desc)
+	{
+		SPtr<TextLayout> layout = bs_shared_ptr_new<TextLayout>();
+
+		bs_frame_mark();
+		{
+			const U32String utf32text = UTF8::toUTF32(desc.text);
+			TextData<FrameAlloc> textData(utf32text, desc.font, desc.fontSize, desc.width, desc.height, desc.wordWrap,
+				desc.wordBreak);
+
+			UINT32 numPages = textData.getNumPages();
+			layout->pages.resize(numPages);
+			layout->distanceField = textData.isDistanceField();
+
+			for (UINT32 i = 0; i < numPages; i++)
+			{
+				TextLayoutPage& page = layout->pages[i];
+				page.texture = textData.getTextureForPage(i);
+				page.numQuads = textData.getNumQuadsForPage(i);
+				page.vertices.resize(page.numQuads * 4);
+				page.uvs.resize(page.numQuads * 4);
+				page.indices.resize(page.numQuads * 6);
+
+				TextSprite::genTextQuads(i, textData, desc.width, desc.height, desc.horzAlign, desc.vertAlign,
+					desc.anchor, page.vertices.data(), page.uvs.data(), page.indices.data(), page.numQuads);
+
+				if (page.numQuads > 0)
+					layout->usedPages.push_back(i);
+			}
+		}
+		bs_frame_clear();
+
+		return layout;
+	}
+}
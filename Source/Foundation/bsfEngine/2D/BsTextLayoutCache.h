@@ -0,0 +1,101 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "2D/BsTextSprite.h"
+#include "Utility/BsModule.h"
+
+namespace bs
+{
+	/** @addtogroup 2D-Internal
+	 *  @{
+	 */
+
+	/** Geometry of all characters of a laid out text string that are located on a single font page. */
+	struct TextLayoutPage
+	{
+		HTexture texture;
+		Vector<Vector2> vertices;
+		Vector<Vector2> uvs;
+		Vector<UINT32> indices;
+		UINT32 numQuads = 0;
+	};
+
+	/** Result of laying out a text string, containing quads ready to be used by a text sprite. */
+	struct TextLayout
+	{
+		Vector<TextLayoutPage> pages;
+		Vector<UINT32> usedPages; /**< Indices of pages containing at least one quad, same as font page indices. */
+		bool distanceField = false; /**< True if the font textures contain signed distance fields. */
+	};
+
+	/**
+	 * Caches the results of text layout, so text sprites with the same contents and layout properties don't need to
+	 * perform word wrapping, line building and quad generation every time they are updated. Layouts are shared between
+	 * all sprites that display identical text. Least recently used layouts are discarded once the cache is full.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_EXPORT TextLayoutCache : public Module<TextLayoutCache>
+	{
+		/** Contains all the properties that influence the text layout. */
+		struct Key
+		{
+			/** Checks if the key describes the layout of the provided text, without needing to construct a key for it. */
+			bool matches(const TEXT_SPRITE_DESC& desc, UINT64 fontId, UINT64 glyphVersion) const;
+
+			UINT64 fontId = 0;
+			UINT64 glyphVersion = 0;
+			UINT32 fontSize = 0;
+			UINT32 width = 0;
+			UINT32 height = 0;
+			TextHorzAlign horzAlign = THA_Left;
+			TextVertAlign vertAlign = TVA_Top;
+			SpriteAnchor anchor = SA_TopLeft;
+			bool wordWrap = false;
+			bool wordBreak = false;
+			String text;
+		};
+
+		/** Cached layout along with the key it was generated for. */
+		struct Entry
+		{
+			Key key;
+			size_t hash;
+			SPtr<const TextLayout> layout;
+		};
+
+		using EntryList = List<Entry>;
+
+	public:
+		/**
+		 * Constructs a new layout cache.
+		 *
+		 * @param[in]	maxEntries	Maximum number of layouts to keep in the cache.
+		 */
+		TextLayoutCache(UINT32 maxEntries = 1024);
+
+		/**
+		 * Returns the layout of the text described by the provided descriptor, generating it if it isn't cached. Color
+		 * of the descriptor is ignored as it doesn't influence the layout.
+		 */
+		SPtr<const TextLayout> getLayout(const TEXT_SPRITE_DESC& desc);
+
+		/** Removes all layouts from the cache. Layouts still referenced by sprites remain valid. */
+		void clear();
+
+	private:
+		/** Generates a hash value for the key describing the layout of the provided text. */
+		static size_t getHash(const TEXT_SPRITE_DESC& desc, UINT64 fontId, UINT64 glyphVersion);
+
+		/** Performs text layout and generates the quads for all font pages. */
+		static SPtr<TextLayout> generateLayout(const TEXT_SPRITE_DESC& desc);
+
+		UINT32 mMaxEntries;
+		EntryList mEntries; // Most recently used first
+		UnorderedMultimap<size_t, EntryList::iterator> mLookup; // Keyed by hash, entries must be compared to find a match
+	};
+
+	/** @} */
+}
@@ -4,7 +4,8 @@
 #include "Text/BsTextData.h"
 #include "Math/BsVector2.h"
 #include "2D/BsSpriteManager.h"
-#include "String/BsUnicode.h"
+#include "2D/BsTextLayoutCache.h"
+#include "Text/BsFont.h"
 
 namespace bs
 {
@@ -20,64 +21,53 @@ namespace bs
 
 	void TextSprite::update(const TEXT_SPRITE_DESC& desc, UINT64 groupId)
 	{
-		bs_frame_mark();
+		// Layout is only regenerated if some property influencing it changed, and is shared with other sprites displaying
+		// the same text
+		SPtr<const TextLayout> layout = TextLayoutCache::instance().getLayout(desc);
+		if (layout != mLayout)
 		{
-			const U32String utf32text = UTF8::toUTF32(desc.text);
-			TextData<FrameAlloc> textData(utf32text, desc.font, desc.fontSize, desc.width, desc.height, desc.wordWrap, 
-				desc.wordBreak);
-
-			UINT32 numPages = textData.getNumPages();
-
-			// Free all previous memory
-			for (auto& cachedElem : mCachedRenderElements)
-			{
-				if (cachedElem.vertices != nullptr) mAlloc.free(cachedElem.vertices);
-				if (cachedElem.uvs != nullptr) mAlloc.free(cachedElem.uvs);
-				if (cachedElem.indexes != nullptr) mAlloc.free(cachedElem.indexes);
-			}
-
-			mAlloc.clear();
-
-			// Resize cached mesh array to needed size
+			UINT32 numPages = (UINT32)layout->pages.size();
 			if (mCachedRenderElements.size() != numPages)
 				mCachedRenderElements.resize(numPages);
 
-			// Actually generate a mesh
-			UINT32 texPage = 0;
-			for (auto& cachedElem : mCachedRenderElements)
-			{
-				UINT32 newNumQuads = textData.getNumQuadsForPage(texPage);
-
-				cachedElem.vertices = (Vector2*)mAlloc.alloc(sizeof(Vector2) * newNumQuads * 4);
-				cachedElem.uvs = (Vector2*)mAlloc.alloc(sizeof(Vector2) * newNumQuads * 4);
-				cachedElem.indexes = (UINT32*)mAlloc.alloc(sizeof(UINT32) * newNumQuads * 6);
-				cachedElem.numQuads = newNumQuads;
+			// Distance field fonts provide glyph metrics scaled to the requested size, so the quads are generated the
+			// same way, but need a material that reconstructs the glyph edges
+			SpriteMaterial* material;
+			if (layout->distanceField)
+				material = SpriteManager::instance().getTextSDFMaterial();
+			else
+				material = SpriteManager::instance().getTextMaterial();
 
-				const HTexture& tex = textData.getTextureForPage(texPage);
-
-				SpriteMaterialInfo& matInfo = cachedElem.matInfo;
-				matInfo.groupId = groupId;
-				matInfo.texture = tex;
-				matInfo.tint = desc.color;
-
-				cachedElem.material = SpriteManager::instance().getTextMaterial();
-
-				texPage++;
+			// Geometry is never modified by the sprite, so it can reference the layout's buffers directly
+			for (UINT32 i = 0; i < numPages; i++)
+			{
+				const TextLayoutPage& page = layout->pages[i];
+
+				SpriteRenderElement& renderElem = mCachedRenderElements[i];
+				renderElem.vertices = const_cast<Vector2*>(page.vertices.data());
+				renderElem.uvs = const_cast<Vector2*>(page.uvs.data());
+				renderElem.indexes = const_cast<UINT32*>(page.indices.data());
+				renderElem.numQuads = page.numQuads;
+				renderElem.matInfo.texture = page.texture;
+				renderElem.material = material;
 			}
 
-			// Calc alignment and anchor offsets and set final line positions
-			for (UINT32 j = 0; j < numPages; j++)
-			{
-				SpriteRenderElement& renderElem = mCachedRenderElements[j];
+			// Static text isn't regenerated every frame, so keep the glyph cache pages of dynamic fonts from being evicted
+			// while they are displayed
+			SPtr<GlyphPageRefs> glyphPageRefs;
+			if (desc.font != nullptr && desc.font->isDynamic())
+				glyphPageRefs = desc.font->_referenceGlyphPages(layout->usedPages);
 
-				genTextQuads(j, textData, desc.width, desc.height, desc.horzAlign, desc.vertAlign, desc.anchor,
-					renderElem.vertices, renderElem.uvs, renderElem.indexes, renderElem.numQuads);
-			}
+			mGlyphPageRefs = glyphPageRefs;
+			mLayout = layout;
+			updateBounds();
 		}
 
-		bs_frame_clear();
-
-		updateBounds();
+		for (auto& renderElem : mCachedRenderElements)
+		{
+			renderElem.matInfo.groupId = groupId;
+			renderElem.matInfo.tint = desc.color;
+		}
 	}
 
 	UINT32 TextSprite::genTextQuads(UINT32 page, const TextDataBase& textData, UINT32 width, UINT32 height,
@@ -202,29 +192,9 @@ namespace bs
 
 	void TextSprite::clearMesh()
 	{
-		for (auto& renderElem : mCachedRenderElements)
-		{
-			if (renderElem.vertices != nullptr)
-			{
-				mAlloc.free(renderElem.vertices);
-				renderElem.vertices = nullptr;
-			}
-
-			if (renderElem.uvs != nullptr)
-			{
-				mAlloc.free(renderElem.uvs);
-				renderElem.uvs = nullptr;
-			}
-
-			if (renderElem.indexes != nullptr)
-			{
-				mAlloc.free(renderElem.indexes);
-				renderElem.indexes = nullptr;
-			}
-		}
-
 		mCachedRenderElements.clear();
-		mAlloc.clear();
+		mLayout = nullptr;
+		mGlyphPageRefs = nullptr;
 
 		updateBounds();
 	}
@@ -7,7 +7,6 @@
 #include "Text/BsTextData.h"
 #include "Image/BsColor.h"
 #include "Math/BsVector2.h"
-#include "Allocators/BsStaticAlloc.h"
 
 namespace bs
 {
@@ -127,13 +126,11 @@ namespace bs
 			UINT32 bufferSizeQuads);
 
 	private:
-		static const int STATIC_CHARS_TO_BUFFER = 25;
-		static const int STATIC_BUFFER_SIZE = STATIC_CHARS_TO_BUFFER * (4 * (2 * sizeof(Vector2)) + (6 * sizeof(UINT32)));
-
 		/**	Clears internal geometry buffers. */
 		void clearMesh();
 
-		mutable StaticAlloc<STATIC_BUFFER_SIZE> mAlloc;
+		SPtr<const TextLayout> mLayout;
+		SPtr<GlyphPageRefs> mGlyphPageRefs;
 	};
 
 	/** @} */
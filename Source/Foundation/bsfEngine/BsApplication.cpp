@@ -3,6 +3,7 @@
 #include "BsApplication.h"
 #include "GUI/BsGUIManager.h"
 #include "2D/BsSpriteManager.h"
+#include "2D/BsTextLayoutCache.h"
 #include "Resources/BsBuiltinResources.h"
 #include "Script/BsScriptManager.h"
 #include "Profiling/BsProfilingManager.h"
@@ -41,6 +42,7 @@ namespace bs
 		Cursor::shutDown();
 
 		GUIManager::shutDown();
+		TextLayoutCache::shutDown();
 		SpriteManager::shutDown();
 		BuiltinResources::shutDown();
 		RendererMaterialManager::shutDown();
@@ -59,6 +61,7 @@ namespace bs
 		RendererMaterialManager::startUp();
 		RendererManager::instance().initialize();
 		SpriteManager::startUp();
+		TextLayoutCache::startUp();
 		GUIManager::startUp();
 		ShortcutManager::startUp();
 
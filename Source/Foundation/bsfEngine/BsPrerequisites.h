@@ -146,6 +146,7 @@ namespace bs
 	class GUIScrollBarVert;
 	class GUIScrollBarHorz;
 	class GUIScrollArea;
+	class GUIVirtualScrollArea;
 	class GUISkin;
 	class GUIRenderTexture;
 	struct GUIElementStyle;
@@ -192,6 +193,8 @@ namespace bs
 
 	// 2D
 	class TextSprite;
+	struct TextLayout;
+	class TextLayoutCache;
 	class ImageSprite;
 	class SpriteMaterial;
 	struct SpriteMaterialInfo;
@@ -23,6 +23,7 @@ set(BS_ENGINE_SRC_GUI
 	"bsfEngine/GUI/BsGUIElement.cpp"
 	"bsfEngine/GUI/BsGUILabel.cpp"
 	"bsfEngine/GUI/BsGUIManager.cpp"
+	"bsfEngine/GUI/BsGUIMeshGroupUtility.cpp"
 	"bsfEngine/GUI/BsGUISkin.cpp"
 	"bsfEngine/GUI/BsGUILayout.cpp"
 	"bsfEngine/GUI/BsGUILayoutX.cpp"
@@ -39,6 +40,7 @@ set(BS_ENGINE_SRC_GUI
 	"bsfEngine/GUI/BsGUIScrollBarVert.cpp"
 	"bsfEngine/GUI/BsGUIScrollBarHorz.cpp"
 	"bsfEngine/GUI/BsGUIScrollArea.cpp"
+	"bsfEngine/GUI/BsGUIVirtualScrollArea.cpp"
 	"bsfEngine/GUI/BsGUIScrollBar.cpp"
 	"bsfEngine/GUI/BsGUIToggleGroup.cpp"
 	"bsfEngine/GUI/BsDragAndDropManager.cpp"
@@ -100,6 +102,7 @@ set(BS_ENGINE_SRC_2D
 	"bsfEngine/2D/BsSpriteMaterial.cpp"
 	"bsfEngine/2D/BsSpriteMaterials.cpp"
 	"bsfEngine/2D/BsSpriteManager.cpp"
+	"bsfEngine/2D/BsTextLayoutCache.cpp"
 )
 
 set(BS_ENGINE_SRC_UTILITY
@@ -125,6 +128,7 @@ set(BS_ENGINE_INC_2D
 	"bsfEngine/2D/BsSpriteMaterial.h"
 	"bsfEngine/2D/BsSpriteMaterials.h"
 	"bsfEngine/2D/BsSpriteManager.h"
+	"bsfEngine/2D/BsTextLayoutCache.h"
 )
 
 set(BS_ENGINE_INC_RTTI
@@ -193,6 +197,7 @@ set(BS_ENGINE_INC_GUI
 	"bsfEngine/GUI/BsGUIElementStyle.h"
 	"bsfEngine/GUI/BsGUILabel.h"
 	"bsfEngine/GUI/BsGUIManager.h"
+	"bsfEngine/GUI/BsGUIMeshGroupUtility.h"
 	"bsfEngine/GUI/BsGUISkin.h"
 	"bsfEngine/GUI/BsGUILayout.h"
 	"bsfEngine/GUI/BsGUILayoutX.h"
@@ -210,6 +215,7 @@ set(BS_ENGINE_INC_GUI
 	"bsfEngine/GUI/BsGUIScrollBarVert.h"
 	"bsfEngine/GUI/BsGUIScrollBarHorz.h"
 	"bsfEngine/GUI/BsGUIScrollArea.h"
+	"bsfEngine/GUI/BsGUIVirtualScrollArea.h"
 	"bsfEngine/GUI/BsGUIScrollBar.h"
 	"bsfEngine/GUI/BsGUIToggleGroup.h"
 	"bsfEngine/GUI/BsDragAndDropManager.h"
@@ -7,13 +7,11 @@
 #include "GUI/BsGUIWidget.h"
 #include "GUI/BsGUIToggle.h"
 #include "GUI/BsGUISkin.h"
-#include "GUI/BsGUIMouseEvent.h"
+#include "GUI/BsGUIVirtualScrollArea.h"
 #include "GUI/BsGUICommandEvent.h"
 
 #include <climits>
 
-using namespace std::placeholders;
-
 namespace bs
 {
 	constexpr const char* GUIDropDownContent::ENTRY_TOGGLE_STYLE_TYPE;
@@ -21,13 +19,187 @@ namespace bs
 	constexpr const char* GUIDropDownContent::ENTRY_EXP_STYLE_TYPE;
 	constexpr const char* GUIDropDownContent::SEPARATOR_STYLE_TYPE;
 
+	class GUIDropDownContent::EntryElement : public GUIElementContainer
+	{
+	public:
+		EntryElement(GUIDropDownContent* owner)
+			:GUIElementContainer(GUIDimensions::create()), mOwner(owner)
+		{ }
+
+		/** Changes the menu element displayed by this GUI element, and activates the child elements it requires. */
+		void setEntry(UINT32 idx)
+		{
+			mIdx = idx;
+			const GUIDropDownDataEntry& entry = mOwner->mDropDownData.entries[idx];
+
+			if (entry.isSeparator())
+			{
+				if (mSeparator == nullptr)
+				{
+					mSeparator = GUITexture::create(TextureScaleMode::StretchToFit, 
+						mOwner->getSubStyleName(SEPARATOR_STYLE_TYPE));
+					_registerChildElement(mSeparator);
+				}
+
+				mMainElement = mSeparator;
+				mActiveButton = nullptr;
+			}
+			else
+			{
+				GUIButtonBase*& button = entry.isSubMenu() ? mSubMenuButton : mButton;
+				if (button == nullptr)
+					button = createButton(entry.isSubMenu());
+
+				button->setContent(GUIContent(mOwner->getElementLocalizedName(idx)));
+
+				mMainElement = button;
+				mActiveButton = button;
+			}
+
+			GUIElement* mainElements[] = { mSeparator, mButton, mSubMenuButton };
+			for (auto& element : mainElements)
+			{
+				if (element != nullptr)
+					element->setActive(element == mMainElement);
+			}
+
+			const String& shortcutTag = entry.getShortcutTag();
+			if (!shortcutTag.empty())
+			{
+				if (mShortcutLabel == nullptr)
+				{
+					mShortcutLabel = GUILabel::create(HString(shortcutTag), "RightAlignedLabel");
+					_registerChildElement(mShortcutLabel);
+				}
+				else
+					mShortcutLabel->setContent(GUIContent(HString(shortcutTag)));
+
+				mShortcutLabel->setActive(true);
+			}
+			else if (mShortcutLabel != nullptr)
+				mShortcutLabel->setActive(false);
+
+			_markLayoutAsDirty();
+		}
+
+		/** Returns the index of the menu element displayed by this GUI element. */
+		UINT32 getIndex() const { return mIdx; }
+
+		/** Returns the button displaying the menu element, or null if the element is a separator. */
+		GUIButtonBase* getButton() const { return mActiveButton; }
+
+		/** Re-applies the styles of the child elements after the style of the owner changes. */
+		void updateStyles()
+		{
+			if (mSeparator != nullptr)
+				mSeparator->setStyle(mOwner->getSubStyleName(SEPARATOR_STYLE_TYPE));
+
+			if (mSubMenuButton != nullptr)
+				mSubMenuButton->setStyle(mOwner->getSubStyleName(ENTRY_EXP_STYLE_TYPE));
+
+			if (mButton != nullptr)
+			{
+				if (mOwner->mIsToggle)
+					mButton->setStyle(mOwner->getSubStyleName(ENTRY_TOGGLE_STYLE_TYPE));
+				else
+					mButton->setStyle(mOwner->getSubStyleName(ENTRY_STYLE_TYPE));
+			}
+		}
+
+		/** @copydoc GUIElementContainer::_getOptimalSize */
+		Vector2I _getOptimalSize() const override
+		{
+			Vector2I optimalSize;
+			if (mMainElement != nullptr)
+				optimalSize.x = mMainElement->_getOptimalSize().x;
+
+			optimalSize.y = (INT32)mOwner->getElementHeight(mIdx);
+			return optimalSize;
+		}
+
+	protected:
+		/** @copydoc GUIElementContainer::_updateLayoutInternal */
+		void _updateLayoutInternal(const GUILayoutData& data) override
+		{
+			if (mMainElement != nullptr)
+				mMainElement->_setLayoutData(data);
+
+			if (mShortcutLabel != nullptr && mShortcutLabel->_isActive())
+				mShortcutLabel->_setLayoutData(data);
+		}
+
+	private:
+		/** Creates a button used for displaying sub-menu or regular entries. */
+		GUIButtonBase* createButton(bool subMenu)
+		{
+			GUIButtonBase* button;
+			if (subMenu)
+			{
+				button = GUIButton::create(HString(""), mOwner->getSubStyleName(ENTRY_EXP_STYLE_TYPE));
+				button->onHover.connect([this]()
+				{
+					mOwner->setSelected(mIdx);
+					mOwner->activate(mIdx, false);
+				});
+			}
+			else
+			{
+				if (mOwner->mIsToggle)
+					button = GUIToggle::create(HString(""), mOwner->getSubStyleName(ENTRY_TOGGLE_STYLE_TYPE));
+				else
+					button = GUIButton::create(HString(""), mOwner->getSubStyleName(ENTRY_STYLE_TYPE));
+
+				button->onHover.connect([this]() { mOwner->setSelected(mIdx); });
+				button->onClick.connect([this]()
+				{
+					mOwner->setSelected(mIdx);
+
+					// Toggles change their own state when clicked
+					mOwner->activate(mIdx, false);
+				});
+			}
+
+			_registerChildElement(button);
+			return button;
+		}
+
+		GUIDropDownContent* mOwner;
+		UINT32 mIdx = 0;
+
+		GUIElement* mMainElement = nullptr;
+		GUIButtonBase* mActiveButton = nullptr;
+
+		GUITexture* mSeparator = nullptr;
+		GUIButtonBase* mButton = nullptr;
+		GUIButtonBase* mSubMenuButton = nullptr;
+		GUILabel* mShortcutLabel = nullptr;
+	};
+
 	GUIDropDownContent::GUIDropDownContent(GUIDropDownMenu::DropDownSubMenu* parent, const GUIDropDownData& dropDownData, 
 		const String& style, const GUIDimensions& dimensions)
 		: GUIElementContainer(dimensions, style), mDropDownData(dropDownData), mStates(dropDownData.states)
-		, mSelectedIdx(UINT_MAX), mRangeStart(0), mRangeEnd(0), mParent(parent), mKeyboardFocus(true)
+		, mScrollArea(nullptr), mSelectedIdx(UINT_MAX), mParent(parent), mKeyboardFocus(true)
 		, mIsToggle(parent->getType() == GUIDropDownType::MultiListBox)
 	{
+		mScrollArea = GUIVirtualScrollArea::create();
+		mScrollArea->setItemCallbacks(
+			[this]()
+			{
+				EntryElement* element = new (bs_alloc<EntryElement>()) EntryElement(this);
+				mEntryElements.push_back(element);
 
+				return element;
+			},
+			[this](GUIElement* element, UINT32 idx)
+			{
+				EntryElement* entryElement = static_cast<EntryElement*>(element);
+				entryElement->setEntry(idx);
+
+				updateEntryState(entryElement);
+			});
+
+		mScrollArea->setNumItems((UINT32)mDropDownData.entries.size());
+		_registerChildElement(mScrollArea);
 	}
 
 	GUIDropDownContent* GUIDropDownContent::create(GUIDropDownMenu::DropDownSubMenu* parent, 
@@ -53,109 +225,17 @@ namespace bs
 
 	void GUIDropDownContent::styleUpdated()
 	{
-		for (auto& visElem : mVisibleElements)
-		{
-			GUIDropDownDataEntry& element = mDropDownData.entries[visElem.idx];
+		for (auto& element : mEntryElements)
+			element->updateStyles();
 
-			if (element.isSeparator())
-				visElem.separator->setStyle(getSubStyleName(SEPARATOR_STYLE_TYPE));
-			else if (element.isSubMenu())
-				visElem.button->setStyle(getSubStyleName(ENTRY_EXP_STYLE_TYPE));
-			else
-			{
-				if (mIsToggle)
-					visElem.button->setStyle(getSubStyleName(ENTRY_TOGGLE_STYLE_TYPE));
-				else
-					visElem.button->setStyle(getSubStyleName(ENTRY_STYLE_TYPE));
-			}
-		}
-	}
-
-	void GUIDropDownContent::setRange(UINT32 start, UINT32 end)
-	{
-		std::function<void(UINT32, UINT32)> onHover = 
-			[&](UINT32 idx, UINT32 visIdx) 
-		{ 
-			setSelected(visIdx);
-			mParent->elementSelected(idx); 
-		};
-
-		std::function<void(UINT32, UINT32)> onClick =
-			[&](UINT32 idx, UINT32 visIdx)
-		{ 
-			setSelected(visIdx);
-
-			if (mIsToggle)
-				mStates[idx] = !mStates[idx];
-
-			mParent->elementActivated(idx, mVisibleElements[visIdx].button->_getLayoutData().area);
-		};
-
-		// Remove all elements
-		while (_getNumChildren() > 0)
+		// Exact heights are known once the entries are displayed, most entries have the regular entry height
+		if (_getParentWidget() != nullptr)
 		{
-			GUIElementBase* child = _getChild(_getNumChildren() - 1);
-			assert(child->_getType() == GUIElementBase::Type::Element);
+			const char* entryStyleType = mIsToggle ? ENTRY_TOGGLE_STYLE_TYPE : ENTRY_STYLE_TYPE;
+			const GUIElementStyle* entryStyle = _getParentWidget()->getSkin().getStyle(getSubStyleName(entryStyleType));
 
-			GUIElement::destroy(static_cast<GUIElement*>(child));
+			mScrollArea->setItemHeight(entryStyle->height, true);
 		}
-
-		mRangeStart = start;
-		mRangeEnd = end;
-		
-		UINT32 range = end - start;
-		if (mSelectedIdx != UINT_MAX && mSelectedIdx >= range)
-			mSelectedIdx = UINT_MAX;
-
-		mVisibleElements.clear();
-		UINT32 curVisIdx = 0;
-		for (UINT32 i = start; i < end; i++)
-		{
-			mVisibleElements.push_back(VisibleElement());
-			VisibleElement& visElem = mVisibleElements.back();
-			visElem.idx = i;
-			GUIDropDownDataEntry& element = mDropDownData.entries[i];
-
-			if (element.isSeparator())
-			{
-				visElem.separator = GUITexture::create(TextureScaleMode::StretchToFit, getSubStyleName(SEPARATOR_STYLE_TYPE));
-				_registerChildElement(visElem.separator);
-			}
-			else if (element.isSubMenu())
-			{
-				visElem.button = GUIButton::create(getElementLocalizedName(i), getSubStyleName(ENTRY_EXP_STYLE_TYPE));
-				visElem.button->onHover.connect(std::bind(onClick, i, curVisIdx));
-				_registerChildElement(visElem.button);
-			}
-			else
-			{
-				if (mIsToggle)
-				{
-					GUIToggle* toggle = GUIToggle::create(getElementLocalizedName(i), getSubStyleName(ENTRY_TOGGLE_STYLE_TYPE));
-					if (mStates[i])
-						toggle->toggleOn();
-
-					visElem.button = toggle;					
-				}
-				else
-					visElem.button = GUIButton::create(getElementLocalizedName(i), getSubStyleName(ENTRY_STYLE_TYPE));
-
-				visElem.button->onHover.connect(std::bind(onHover, i, curVisIdx));
-				visElem.button->onClick.connect(std::bind(onClick, i, curVisIdx));
-				_registerChildElement(visElem.button);
-
-				const String& shortcutTag = element.getShortcutTag();
-				if (!shortcutTag.empty())
-				{
-					visElem.shortcutLabel = GUILabel::create(HString(shortcutTag), "RightAlignedLabel");
-					_registerChildElement(visElem.shortcutLabel);
-				}
-			}
-
-			curVisIdx++;
-		}
-
-		_markLayoutAsDirty();
 	}
 
 	UINT32 GUIDropDownContent::getElementHeight(UINT32 idx) const
@@ -206,13 +286,13 @@ namespace bs
 			if (mSelectedIdx == UINT_MAX)
 				selectNext(0);
 			else
-				selectNext(mVisibleElements[mSelectedIdx].idx + 1);
+				selectNext(mSelectedIdx + 1);
 			return true;
 		case GUICommandEventType::MoveUp:
 			if (mSelectedIdx == UINT_MAX)
 				selectNext(0);
 			else
-				selectPrevious(mVisibleElements[mSelectedIdx].idx - 1);
+				selectPrevious(mSelectedIdx - 1);
 			return true;
 		case GUICommandEventType::Escape:
 		case GUICommandEventType::MoveLeft:
@@ -224,9 +304,9 @@ namespace bs
 				selectNext(0);
 			else
 			{
-				GUIDropDownDataEntry& entry = mDropDownData.entries[mVisibleElements[mSelectedIdx].idx];
+				GUIDropDownDataEntry& entry = mDropDownData.entries[mSelectedIdx];
 				if (entry.isSubMenu())
-					mParent->elementActivated(mVisibleElements[mSelectedIdx].idx, mVisibleElements[mSelectedIdx].button->_getLayoutData().area);
+					activate(mSelectedIdx, true);
 			}
 		}
 			return true;
@@ -234,12 +314,7 @@ namespace bs
 			if (mSelectedIdx == UINT_MAX)
 				selectNext(0);
 			else
-			{
-				if (mIsToggle)
-					mVisibleElements[mSelectedIdx].button->_setOn(!mVisibleElements[mSelectedIdx].button->_isOn());
-
-				mParent->elementActivated(mVisibleElements[mSelectedIdx].idx, mVisibleElements[mSelectedIdx].button->_getLayoutData().area);
-			}
+				activate(mSelectedIdx, true);
 			return true;
 		default:
 			break;
@@ -248,38 +323,67 @@ namespace bs
 		return baseReturn;
 	}
 
-	bool GUIDropDownContent::_mouseEvent(const GUIMouseEvent& ev)
+	GUIDropDownContent::EntryElement* GUIDropDownContent::getEntryElement(UINT32 idx) const
+	{
+		return static_cast<EntryElement*>(mScrollArea->getItemElement(idx));
+	}
+
+	void GUIDropDownContent::updateEntryState(EntryElement* element) const
 	{
-		if (ev.getType() == GUIMouseEventType::MouseWheelScroll)
+		GUIButtonBase* button = element->getButton();
+		if (button == nullptr)
+			return;
+
+		UINT32 idx = element->getIndex();
+		if (mIsToggle && !mDropDownData.entries[idx].isSubMenu())
 		{
-			if (ev.getWheelScrollAmount() < 0)
-				mParent->scrollDown();
+			GUIToggle* toggle = static_cast<GUIToggle*>(button);
+			if (mStates[idx])
+				toggle->toggleOn();
 			else
-				mParent->scrollUp();
-
-			return true;
+				toggle->toggleOff();
 		}
 
-		return false;
+		if (idx == mSelectedIdx)
+			button->_setState(button->_isOn() ? GUIElementState::HoverOn : GUIElementState::Hover);
+		else
+			button->_setState(button->_isOn() ? GUIElementState::NormalOn : GUIElementState::Normal);
 	}
 
 	void GUIDropDownContent::setSelected(UINT32 idx)
 	{
-		if (mSelectedIdx != UINT_MAX)
+		UINT32 prevSelectedIdx = mSelectedIdx;
+		mSelectedIdx = idx;
+
+		if (prevSelectedIdx != UINT_MAX)
 		{
-			if (mVisibleElements[mSelectedIdx].button->_isOn())
-				mVisibleElements[mSelectedIdx].button->_setState(GUIElementState::NormalOn);
-			else
-				mVisibleElements[mSelectedIdx].button->_setState(GUIElementState::Normal);
+			EntryElement* prevElement = getEntryElement(prevSelectedIdx);
+			if (prevElement != nullptr)
+				updateEntryState(prevElement);
 		}
 
-		mSelectedIdx = idx;
-		if (mVisibleElements[mSelectedIdx].button->_isOn())
-			mVisibleElements[mSelectedIdx].button->_setState(GUIElementState::HoverOn);
-		else
-			mVisibleElements[mSelectedIdx].button->_setState(GUIElementState::Hover);
+		EntryElement* element = getEntryElement(mSelectedIdx);
+		if (element != nullptr)
+			updateEntryState(element);
 
-		mParent->elementSelected(mVisibleElements[mSelectedIdx].idx);
+		mParent->elementSelected(mSelectedIdx);
+	}
+
+	void GUIDropDownContent::activate(UINT32 idx, bool updateElement)
+	{
+		EntryElement* element = getEntryElement(idx);
+
+		if (mIsToggle && !mDropDownData.entries[idx].isSubMenu())
+		{
+			mStates[idx] = !mStates[idx];
+
+			if (updateElement && element != nullptr)
+				updateEntryState(element);
+		}
+
+		// Sub-menus open next to the entry, if it's not visible use the bounds of the menu instead
+		Rect2I bounds = element != nullptr ? element->_getLayoutData().area : mLayoutData.area;
+		mParent->elementActivated(idx, bounds);
 	}
 
 	void GUIDropDownContent::selectNext(UINT32 startIdx)
@@ -305,20 +409,8 @@ namespace bs
 
 		if (gotNextIndex)
 		{
-			while (nextIdx < mRangeStart || nextIdx >= mRangeEnd)
-				mParent->scrollDown();
-
-			UINT32 visIdx = 0;
-			for (auto& visElem : mVisibleElements)
-			{
-				if (visElem.idx == nextIdx)
-				{
-					setSelected(visIdx);
-					break;
-				}
-
-				visIdx++;
-			}
+			mScrollArea->scrollToItem(nextIdx);
+			setSelected(nextIdx);
 		}
 	}
 
@@ -346,68 +438,14 @@ namespace bs
 
 		if (gotNextIndex)
 		{
-			while (prevIdx < (INT32)mRangeStart || prevIdx >= (INT32)mRangeEnd)
-				mParent->scrollUp();
-
-			UINT32 visIdx = 0;
-			for (auto& visElem : mVisibleElements)
-			{
-				if (visElem.idx == (UINT32)prevIdx)
-				{
-					setSelected(visIdx);
-					break;
-				}
-
-				visIdx++;
-			}
-		}
-	}
-
-	Vector2I GUIDropDownContent::_getOptimalSize() const
-	{
-		Vector2I optimalSize;
-		for (auto& visElem : mVisibleElements)
-		{
-			const GUIDropDownDataEntry& element = mDropDownData.entries[visElem.idx];
-
-			optimalSize.y += (INT32)getElementHeight(visElem.idx);
-
-			if (element.isSeparator())
-				optimalSize.x = std::max(optimalSize.x, visElem.separator->_getOptimalSize().x);
-			else
-				optimalSize.x = std::max(optimalSize.x, visElem.button->_getOptimalSize().x);
+			mScrollArea->scrollToItem((UINT32)prevIdx);
+			setSelected((UINT32)prevIdx);
 		}
-
-		return optimalSize;
 	}
 
 	void GUIDropDownContent::_updateLayoutInternal(const GUILayoutData& data)
 	{
-		GUILayoutData childData = data;
-		INT32 yOffset = data.area.y;
-
-		for (auto& visElem : mVisibleElements)
-		{
-			const GUIDropDownDataEntry& element = mDropDownData.entries[visElem.idx];
-
-			GUIElement* guiMainElement = nullptr;
-			if (element.isSeparator())
-				guiMainElement = visElem.separator;
-			else
-				guiMainElement = visElem.button;
-
-			childData.area.y = yOffset;
-			childData.area.height = getElementHeight(visElem.idx);
-
-			yOffset += childData.area.height;
-
-			guiMainElement->_setLayoutData(childData);
-
-			// Shortcut label
-			GUILabel* shortcutLabel = visElem.shortcutLabel;
-			if (shortcutLabel != nullptr)
-				shortcutLabel->_setLayoutData(childData);
-		}
+		updateChildLayout(mScrollArea, data);
 	}
 
 	const String& GUIDropDownContent::getGUITypeName()
@@ -12,17 +12,14 @@ namespace bs
 	 *  @{
 	 */
 
-	/**	GUI element that is used for representing entries in a drop down menu. */
+	/**
+	 * GUI element that is used for representing entries in a drop down menu. Entries are displayed in a scrollable area,
+	 * with GUI elements only existing for the visible entries.
+	 */
 	class BS_EXPORT GUIDropDownContent : public GUIElementContainer
 	{
-		/**	Contains various GUI elements used for displaying a single menu entry. */
-		struct VisibleElement
-		{
-			UINT32 idx = 0;
-			GUIButtonBase* button = nullptr;
-			GUITexture* separator = nullptr;
-			GUILabel* shortcutLabel = nullptr;
-		};
+		/**	GUI element used for displaying a single menu entry. Reused for different entries as the menu is scrolled. */
+		class EntryElement;
 
 	public:
 		/** Returns type name of the GUI element used for finding GUI element styles.  */
@@ -52,13 +49,6 @@ namespace bs
 		static GUIDropDownContent* create(GUIDropDownMenu::DropDownSubMenu* parent, const GUIDropDownData& dropDownData, 
 			const GUIOptions& options, const String& style = StringUtil::BLANK);
 
-		/**
-		 * Changes the range of the displayed elements. 
-		 *
-		 * @note	This must be called at least once after creation.
-		 */
-		void setRange(UINT32 start, UINT32 end);
-
 		/**	Returns height of a menu element at the specified index, in pixels. */
 		UINT32 getElementHeight(UINT32 idx) const;
 
@@ -78,9 +68,6 @@ namespace bs
 		/**	Get localized name of a menu item element with the specified index. */
 		HString getElementLocalizedName(UINT32 idx) const;
 
-		/** @copydoc GUIElementContainer::_getOptimalSize */
-		Vector2I _getOptimalSize() const override;
-
 		/** @copydoc GUIElementContainer::_updateLayoutInternal */
 		void _updateLayoutInternal(const GUILayoutData& data) override;
 
@@ -90,16 +77,30 @@ namespace bs
 		/** @copydoc GUIElementContainer::_commandEvent */
 		bool _commandEvent(const GUICommandEvent& ev) override;
 
-		/** @copydoc GUIElementContainer::_mouseEvent */
-		bool _mouseEvent(const GUIMouseEvent& ev) override;
-
 		/**
 		 * Marks the element with the specified index as selected.
 		 * 		
-		 * @param[in]	idx		Index of the displayed element (indexing visible elements).
+		 * @param[in]	idx		Index of the menu element.
 		 */
 		void setSelected(UINT32 idx);
 
+		/**
+		 * Activates the menu element with the specified index, toggling its state if the menu displays toggles, and
+		 * notifies the parent sub-menu.
+		 *
+		 * @param[in]	idx				Index of the menu element.
+		 * @param[in]	updateElement	If true, the GUI element displaying the menu element is updated to reflect the new
+		 *								toggle state. Should be false if the element was clicked, since toggles update
+		 *								their own state when clicked.
+		 */
+		void activate(UINT32 idx, bool updateElement);
+
+		/** Returns the GUI element displaying the menu element with the specified index, or null if it is not visible. */
+		EntryElement* getEntryElement(UINT32 idx) const;
+
+		/** Updates the visual state of the provided GUI element to match the menu element it is displaying. */
+		void updateEntryState(EntryElement* element) const;
+
 		/**
 		 * Selects the next available non-separator entry.
 		 * 			
@@ -116,9 +117,9 @@ namespace bs
 
 		GUIDropDownData mDropDownData;
 		Vector<bool> mStates;
-		Vector<VisibleElement> mVisibleElements;
+		GUIVirtualScrollArea* mScrollArea;
+		Vector<EntryElement*> mEntryElements;
 		UINT32 mSelectedIdx;
-		UINT32 mRangeStart, mRangeEnd;
 		GUIDropDownMenu::DropDownSubMenu* mParent;
 		bool mKeyboardFocus;
 		bool mIsToggle;
@@ -7,6 +7,7 @@
 #include "GUI/BsGUITexture.h"
 #include "GUI/BsGUILabel.h"
 #include "GUI/BsGUIButton.h"
+#include "GUI/BsGUIScrollArea.h"
 #include "GUI/BsGUISpace.h"
 #include "GUI/BsGUIContent.h"
 #include "GUI/BsGUISkin.h"
@@ -73,12 +74,8 @@ namespace bs
 			break;
 		}
 
-		mScrollUpStyle = stylePrefix + "ScrollUpBtn";
-		mScrollDownStyle = stylePrefix + "ScrollDownBtn";
 		mBackgroundStyle = stylePrefix + "Frame";
 		mContentStyle = stylePrefix + "Content";
-		mSideBackgroundStyle = stylePrefix + "SidebarBg";
-		mHandleStyle = stylePrefix + "Handle";
 
 		setDepth(0); // Needs to be in front of everything
 		setSkin(desc.skin);
@@ -183,30 +180,25 @@ namespace bs
 	GUIDropDownMenu::DropDownSubMenu::DropDownSubMenu(GUIDropDownMenu* owner, DropDownSubMenu* parent, 
 		const DropDownAreaPlacement& placement, const Rect2I& availableBounds, const GUIDropDownData& dropDownData, 
 		GUIDropDownType type, UINT32 depthOffset)
-		: mOwner(owner), mType(type), mData(dropDownData), mPage(0), x(0), y(0), width(0), height(0)
-		, mDepthOffset(depthOffset), mOpenedUpward(false), mContent(nullptr), mBackgroundFrame(nullptr)
-		, mBackgroundPanel(nullptr), mContentPanel(nullptr), mContentLayout(nullptr), mSidebarPanel(nullptr)
-		, mParent(parent), mSubMenu(nullptr)
+		: mOwner(owner), mType(type), mData(dropDownData), x(0), y(0), width(0), height(0), mDepthOffset(depthOffset)
+		, mContent(nullptr), mBackgroundFrame(nullptr), mBackgroundPanel(nullptr), mContentPanel(nullptr)
+		, mContentLayout(nullptr), mParent(parent), mSubMenu(nullptr)
 	{
 		mAvailableBounds = availableBounds;
 
 		const GUIElementStyle* backgroundStyle = mOwner->getSkin().getStyle(mOwner->mBackgroundStyle);
-		const GUIElementStyle* sideBarStyle = mOwner->getSkin().getStyle(mOwner->mSideBackgroundStyle);
 
 		// Create content GUI element
-		mContent = GUIDropDownContent::create(this, dropDownData, mOwner->mContentStyle);
+		mContent = GUIDropDownContent::create(this, dropDownData, 
+			GUIOptions(GUIOption::flexibleWidth(), GUIOption::flexibleHeight()), mOwner->mContentStyle);
 		mContent->setKeyboardFocus(true);
 
 		// Content area
 		mContentPanel = mOwner->getPanel()->addNewElement<GUIPanel>();
-		mContentPanel->setWidth(width);
-		mContentPanel->setHeight(height);
 		mContentPanel->setDepthRange(100 - depthOffset * 2 - 1);
 
 		// Background frame
 		mBackgroundPanel = mOwner->getPanel()->addNewElement<GUIPanel>();
-		mBackgroundPanel->setWidth(width);
-		mBackgroundPanel->setHeight(height);
 		mBackgroundPanel->setDepthRange(100 - depthOffset * 2);
 
 		GUILayout* backgroundLayout = mBackgroundPanel->addNewElement<GUILayoutX>();
@@ -218,33 +210,47 @@ namespace bs
 		mContentLayout->addElement(mContent); // Note: It's important this is added to the layout before we 
 		// use it for size calculations, in order for its skin to be assigned
 
-		UINT32 dropDownBoxWidth = DROP_DOWN_BOX_WIDTH + sideBarStyle->width;
-
 		UINT32 maxNeededHeight = backgroundStyle->margins.top + backgroundStyle->margins.bottom;
 		UINT32 numElements = (UINT32)dropDownData.entries.size();
 		for (UINT32 i = 0; i < numElements; i++)
+		{
 			maxNeededHeight += mContent->getElementHeight(i);
 
+			// Menu can never be taller than the available area, no need to go through the rest of (potentially many)
+			// entries
+			if (maxNeededHeight > (UINT32)availableBounds.height)
+				break;
+		}
+
 		DropDownAreaPlacement::HorzDir horzDir;
 		DropDownAreaPlacement::VertDir vertDir;
-		Rect2I placementBounds = placement.getOptimalBounds(dropDownBoxWidth, maxNeededHeight, availableBounds, horzDir, vertDir);
-
-		mOpenedUpward = vertDir == DropDownAreaPlacement::VertDir::Up;
+		Rect2I placementBounds = placement.getOptimalBounds(DROP_DOWN_BOX_WIDTH, maxNeededHeight, availableBounds, 
+			horzDir, vertDir);
 
-		UINT32 actualY = placementBounds.y;
-		if (mOpenedUpward)
-			y = placementBounds.y + placementBounds.height;
-		else
-			y = placementBounds.y;
+		// Entries that don't fit are scrolled, leave room for the scroll bar
+		if ((UINT32)placementBounds.height < maxNeededHeight)
+		{
+			placementBounds = placement.getOptimalBounds(DROP_DOWN_BOX_WIDTH + GUIScrollArea::ScrollBarWidth, 
+				maxNeededHeight, availableBounds, horzDir, vertDir);
+		}
 
 		x = placementBounds.x;
+		y = placementBounds.y;
 		width = placementBounds.width;
 		height = placementBounds.height;
 
-		mContentPanel->setPosition(x, actualY);
-		mBackgroundPanel->setPosition(x, actualY);
+		mVisibleBounds = placementBounds;
+
+		mBackgroundPanel->setPosition(x, y);
+		mBackgroundPanel->setWidth(width);
+		mBackgroundPanel->setHeight(height);
 
-		updateGUIElements();
+		UINT32 contentWidth = (UINT32)std::max(0, (INT32)width - (INT32)backgroundStyle->margins.left - (INT32)backgroundStyle->margins.right);
+		UINT32 contentHeight = (UINT32)std::max(0, (INT32)height - (INT32)backgroundStyle->margins.top - (INT32)backgroundStyle->margins.bottom);
+
+		mContentPanel->setPosition(x + backgroundStyle->margins.left, y + backgroundStyle->margins.top);
+		mContentPanel->setWidth(contentWidth);
+		mContentPanel->setHeight(contentHeight);
 
 		mOwner->notifySubMenuOpened(this);
 	}
@@ -261,206 +267,6 @@ namespace bs
 
 		GUILayout::destroy(mBackgroundPanel);
 		GUILayout::destroy(mContentPanel);
-
-		if (mSidebarPanel != nullptr)
-			GUIPanel::destroy(mSidebarPanel);
-	}
-
-	Vector<GUIDropDownMenu::DropDownSubMenu::PageInfo> GUIDropDownMenu::DropDownSubMenu::getPageInfos() const
-	{
-		const GUIElementStyle* backgroundStyle = mOwner->getSkin().getStyle(mOwner->mBackgroundStyle);
-
-		INT32 numElements = (INT32)mData.entries.size();
-
-		PageInfo curPageInfo;
-		curPageInfo.start = 0;
-		curPageInfo.end = 0;
-		curPageInfo.idx = 0;
-		curPageInfo.height = backgroundStyle->margins.top + backgroundStyle->margins.bottom;
-		
-		Vector<PageInfo> pageInfos;
-		for (INT32 i = 0; i < numElements; i++)
-		{
-			curPageInfo.height += mContent->getElementHeight((UINT32)i);
-			curPageInfo.end++;
-
-			if (curPageInfo.height > height)
-			{
-				// Remove last few elements until we fit again
-				while (curPageInfo.height > height && i >= 0)
-				{
-					curPageInfo.height -= mContent->getElementHeight((UINT32)i);
-					curPageInfo.end--;
-
-					i--;
-				}
-
-				// Nothing fits, break out of infinite loop
-				if (curPageInfo.start >= curPageInfo.end)
-					break;
-
-				pageInfos.push_back(curPageInfo);
-
-				curPageInfo.start = curPageInfo.end;
-				curPageInfo.height = backgroundStyle->margins.top + backgroundStyle->margins.bottom;
-
-				curPageInfo.idx++;
-			}
-		}
-
-		if (curPageInfo.start < curPageInfo.end)
-			pageInfos.push_back(curPageInfo);
-
-		return pageInfos;
-	}
-
-	void GUIDropDownMenu::DropDownSubMenu::updateGUIElements()
-	{
-		// Remove all elements from content layout
-		while(mContentLayout->getNumChildren() > 0)
-			mContentLayout->removeElementAt(mContentLayout->getNumChildren() - 1);
-
-		mContentLayout->addElement(mContent); // Note: Needs to be added first so that size calculations have proper skin to work with
-
-		const GUIElementStyle* backgroundStyle = mOwner->getSkin().getStyle(mOwner->mBackgroundStyle);
-		const GUIElementStyle* sideBarStyle = mOwner->getSkin().getStyle(mOwner->mSideBackgroundStyle);
-		const GUIElementStyle* scrollUpStyle = mOwner->getSkin().getStyle(mOwner->mScrollUpStyle);
-		const GUIElementStyle* scrollDownStyle = mOwner->getSkin().getStyle(mOwner->mScrollDownStyle);
-
-		Vector<PageInfo> pageInfos = getPageInfos();
-
-		UINT32 pageStart = 0, pageEnd = 0;
-		UINT32 pageHeight = 0;
-		UINT32 pageCount = (UINT32)pageInfos.size();
-		if (pageCount > mPage)
-		{
-			pageStart = pageInfos[mPage].start;
-			pageEnd = pageInfos[mPage].end;
-			pageHeight = pageInfos[mPage].height;
-		}
-
-		INT32 actualY = y;
-
-		if (mOpenedUpward)
-			actualY -= (INT32)pageHeight;
-
-		// Add sidebar if needed
-		UINT32 contentOffset = 0;
-		if (pageInfos.size() > 1)
-		{
-			UINT32 sidebarHeight = pageHeight - 2;
-			contentOffset = sideBarStyle->width;
-
-			if (mSidebarPanel == nullptr)
-			{
-				mSidebarPanel = mOwner->getPanel()->addNewElement<GUIPanel>();
-
-				mScrollUpBtn = GUIButton::create(HString(""), mOwner->mScrollUpStyle);
-				mScrollUpBtn->onClick.connect(std::bind(&DropDownSubMenu::scrollUp, this));
-
-				GUIElementOptions scrollUpBtnOptions = mScrollUpBtn->getOptionFlags();
-				scrollUpBtnOptions.unset(GUIElementOption::AcceptsKeyFocus);
-
-				mScrollUpBtn->setOptionFlags(scrollUpBtnOptions);
-
-				mScrollDownBtn = GUIButton::create(HString(""), mOwner->mScrollDownStyle);
-				mScrollDownBtn->onClick.connect(std::bind(&DropDownSubMenu::scrollDown, this));
-
-				GUIElementOptions scrollDownBtnOptions = mScrollDownBtn->getOptionFlags();
-				scrollDownBtnOptions.unset(GUIElementOption::AcceptsKeyFocus);
-
-				mScrollDownBtn->setOptionFlags(scrollDownBtnOptions);
-
-				mHandle = GUITexture::create(mOwner->mHandleStyle);
-				GUITexture* background = GUITexture::create(mOwner->mSideBackgroundStyle);
-				background->_setElementDepth(2);
-
-				mSidebarPanel->addElement(background);
-				mSidebarPanel->addElement(mScrollUpBtn);
-				mSidebarPanel->addElement(mScrollDownBtn);
-				mSidebarPanel->addElement(mHandle);
-			}
-
-			mScrollUpBtn->setPosition(1, 1);
-			mScrollDownBtn->setPosition(1, sidebarHeight - 1 - scrollDownStyle->height);
-
-			UINT32 maxHandleSize = std::max(0, (INT32)sidebarHeight - (INT32)scrollDownStyle->height - (INT32)scrollUpStyle->height - 2);
-			UINT32 handleSize = maxHandleSize / pageCount;
-
-			INT32 handlePos = 1 + scrollUpStyle->height + mPage * handleSize;
-
-			mHandle->setPosition(1, handlePos);
-			mHandle->setHeight(handleSize);
-
-			mSidebarPanel->setPosition(x, actualY);
-			mSidebarPanel->setWidth(sideBarStyle->width);
-			mSidebarPanel->setHeight(sidebarHeight);
-		}
-		else
-		{
-			if (mSidebarPanel != nullptr)
-			{
-				GUIPanel::destroy(mSidebarPanel);
-				mSidebarPanel = nullptr;
-			}
-		}
-
-		mContent->setRange(pageStart, pageEnd);
-
-		if (mSubMenu == nullptr)
-			mContent->setKeyboardFocus(true);
-
-		// Resize and reposition areas
-		mBackgroundPanel->setWidth(width - contentOffset);
-		mBackgroundPanel->setHeight(pageHeight);
-		mBackgroundPanel->setPosition(x + contentOffset, actualY);
-
-		mVisibleBounds = Rect2I(x, actualY, width, pageHeight);
-
-		UINT32 contentWidth = (UINT32)std::max(0, (INT32)width - (INT32)backgroundStyle->margins.left - (INT32)backgroundStyle->margins.right - (INT32)contentOffset);
-		UINT32 contentHeight = (UINT32)std::max(0, (INT32)pageHeight - (INT32)backgroundStyle->margins.top - (INT32)backgroundStyle->margins.bottom);
-
-		mContentPanel->setWidth(contentWidth);
-		mContentPanel->setHeight(contentHeight);
-		mContentPanel->setPosition(x + contentOffset + backgroundStyle->margins.left, actualY + backgroundStyle->margins.top);
-	}
-
-	void GUIDropDownMenu::DropDownSubMenu::scrollDown()
-	{
-		mPage++;
-		if (mPage == (UINT32)getPageInfos().size())
-			mPage = 0;
-
-		updateGUIElements();
-
-		closeSubMenu();
-	}
-
-	void GUIDropDownMenu::DropDownSubMenu::scrollUp()
-	{
-		if (mPage > 0)
-			mPage--;
-		else
-			mPage = (UINT32)getPageInfos().size() - 1;
-
-		updateGUIElements();
-		closeSubMenu();
-	}
-
-	void GUIDropDownMenu::DropDownSubMenu::scrollToTop()
-	{
-		mPage = 0;
-		updateGUIElements();
-
-		closeSubMenu();
-	}
-
-	void GUIDropDownMenu::DropDownSubMenu::scrollToBottom()
-	{
-		mPage = (UINT32)(getPageInfos().size() - 1);
-		updateGUIElements();
-
-		closeSubMenu();
 	}
 
 	void GUIDropDownMenu::DropDownSubMenu::closeSubMenu()
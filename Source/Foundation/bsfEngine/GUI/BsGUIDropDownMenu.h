@@ -107,15 +107,6 @@ namespace bs
 		/**	Contains data about a single drop down box sub-menu. */
 		struct DropDownSubMenu
 		{
-			/**	Represents a single sub-menu page. */
-			struct PageInfo
-			{
-				UINT32 idx;
-				UINT32 start;
-				UINT32 end;
-				UINT32 height;
-			};
-
 		public:
 			/**
 			 * Creates a new drop down box sub-menu.
@@ -134,24 +125,6 @@ namespace bs
 				const Rect2I& availableBounds, const GUIDropDownData& dropDownData, GUIDropDownType type, UINT32 depthOffset);
 			~DropDownSubMenu();
 
-			/**	Recreates all internal GUI elements for the entries of the current sub-menu page. */
-			void updateGUIElements();
-
-			/**	Moves the sub-menu to the previous page and displays its elements, if available. */
-			void scrollDown();
-
-			/**	Moves the sub-menu to the next page and displays its elements, if available. */
-			void scrollUp();
-
-			/**	Moves the sub-menu to the first page and displays its elements. */
-			void scrollToTop();
-
-			/**	Moves the sub-menu to the last page and displays its elements. */
-			void scrollToBottom();
-
-			/**	Calculates ranges for all the pages of the sub-menu. */
-			Vector<PageInfo> getPageInfos() const;
-
 			/**
 			 * Called when the user activates an element with the specified index.
 			 *
@@ -187,24 +160,18 @@ namespace bs
 
 			GUIDropDownType mType;
 			GUIDropDownData mData;
-			UINT32 mPage;
 			INT32 x, y;
 			UINT32 width, height;
 			Rect2I mVisibleBounds;
 			Rect2I mAvailableBounds;
 			UINT32 mDepthOffset;
-			bool mOpenedUpward;
 
 			GUIDropDownContent* mContent;
 			GUITexture* mBackgroundFrame;
-			GUIButton* mScrollUpBtn;
-			GUIButton* mScrollDownBtn;
-			GUITexture* mHandle;
 
 			GUIPanel* mBackgroundPanel;
 			GUIPanel* mContentPanel;
 			GUILayout* mContentLayout;
-			GUIPanel* mSidebarPanel;
 
 			DropDownSubMenu* mParent;
 			DropDownSubMenu* mSubMenu;
@@ -228,12 +195,8 @@ namespace bs
 	private:
 		static const UINT32 DROP_DOWN_BOX_WIDTH;
 
-		String mScrollUpStyle;
-		String mScrollDownStyle;
 		String mBackgroundStyle;
 		String mContentStyle;
-		String mSideBackgroundStyle;
-		String mHandleStyle;
 
 		DropDownSubMenu* mRootMenu;
 		GUIDropDownHitBox* mFrontHitBox;
@@ -97,6 +97,30 @@ namespace bs
 		_setElementDepth(elemDepth);
 
 		updateClippedBounds();
+
+		// Contents depend on element bounds, so they need to be rebuilt
+		_markContentAsDirty();
+	}
+
+	void GUIElement::_updateOptimalLayoutSizes()
+	{
+		// Optimal size can be expensive to calculate (e.g. requires text layout), so only do so if element or any of
+		// its children changed
+		if (!_isSizeDirty() && !_isLayoutDirty())
+			return;
+
+		GUIElementBase::_updateOptimalLayoutSizes();
+
+		mCachedSizeRange = _calculateLayoutSizeRange();
+		mFlags &= ~GUIElem_SizeDirty;
+	}
+
+	LayoutSizeRange GUIElement::_getLayoutSizeRange() const
+	{
+		if (_isSizeDirty())
+			return _calculateLayoutSizeRange();
+
+		return mCachedSizeRange;
 	}
 
 	void GUIElement::_changeParentWidget(GUIWidget* widget)
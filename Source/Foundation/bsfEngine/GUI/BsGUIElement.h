@@ -217,6 +217,12 @@ namespace bs
 		/** @copydoc GUIElementBase::_setLayoutData */
 		void _setLayoutData(const GUILayoutData& data) override;
 
+		/** @copydoc GUIElementBase::_updateOptimalLayoutSizes */
+		void _updateOptimalLayoutSizes() override;
+
+		/** @copydoc GUIElementBase::_getLayoutSizeRange */
+		LayoutSizeRange _getLayoutSizeRange() const override;
+
 		/** @copydoc GUIElementBase::_changeParentWidget */
 		void _changeParentWidget(GUIWidget* widget) override;
 
@@ -288,6 +294,13 @@ namespace bs
 		/**	Returns a clip rectangle relative to the element, used for clipping	the input text. */
 		virtual Rect2I _getTextInputRect() const { return Rect2I(); }
 
+		/**
+		 * Called by the parent widget after its layout has been updated, if requested through
+		 * GUIWidget::_requestPostLayoutUpdate(). Elements that need to add, remove or modify their children depending on
+		 * their layout should do so here instead of during the layout update.
+		 */
+		virtual void _postLayoutUpdate() { }
+
 		/** @} */
 
 	protected:
@@ -340,6 +353,7 @@ namespace bs
 		bool mIsDestroyed = false;
 		GUIElementOptions mOptionFlags;
 		Rect2I mClippedBounds;
+		LayoutSizeRange mCachedSizeRange;
 		
 	private:
 		static const Color DISABLED_COLOR;
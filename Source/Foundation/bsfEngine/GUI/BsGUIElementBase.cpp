@@ -170,14 +170,32 @@ namespace bs
 	
 	void GUIElementBase::_markAsClean()
 	{
-		mFlags &= ~GUIElem_Dirty;
+		mFlags &= ~(GUIElem_Dirty | GUIElem_LayoutDirty);
 	}
 
 	void GUIElementBase::_markLayoutAsDirty() 
 	{ 
+		mFlags |= GUIElem_SizeDirty | GUIElem_LayoutDirty;
+
+		// Parents of hidden elements are notified once the element is made visible again (see _setVisible)
 		if(!_isVisible())
 			return;
 
+		// Parent size depends on properties of this element that aren't part of its size range (e.g. padding or position)
+		// so it always needs to be recalculated. Parents higher up only recalculate their size if the size range of their
+		// child changes (see _updateOptimalLayoutSizes), here they're just marked so the branch can be found.
+		if (mParentElement != nullptr)
+		{
+			mParentElement->mFlags |= GUIElem_SizeDirty;
+
+			GUIElementBase* currentElem = mParentElement;
+			while (currentElem != nullptr)
+			{
+				currentElem->mFlags |= GUIElem_LayoutDirty;
+				currentElem = currentElem->mParentElement;
+			}
+		}
+
 		if (mUpdateParent != nullptr)
 			mUpdateParent->mFlags |= GUIElem_Dirty;
 		else
@@ -368,6 +386,12 @@ namespace bs
 	void GUIElementBase::_updateLayout(const GUILayoutData& data)
 	{
 		_updateOptimalLayoutSizes(); // We calculate optimal sizes of all layouts as a pre-processing step, as they are requested often during update
+
+		// Child areas need to be recalculated when laid out using new data, otherwise only if sizes changed (see
+		// _updateOptimalLayoutSizes)
+		if (data != mLayoutData)
+			mFlags |= GUIElem_ChildAreasDirty;
+
 		_updateLayoutInternal(data);
 	}
 
@@ -379,10 +403,42 @@ namespace bs
 		}
 	}
 
+	void GUIElementBase::updateChildLayout(GUIElementBase* child, const GUILayoutData& data)
+	{
+		// Element depth is not controlled by the layout (see GUIElement::_setLayoutData), so ignore it
+		UINT32 depthMask = child->_getType() == Type::Element ? 0xFFFFFF00 : 0xFFFFFFFF;
+
+		const GUILayoutData& prevData = child->mLayoutData;
+		bool dataChanged = prevData.area != data.area || prevData.clipRect != data.clipRect ||
+			(prevData.depth & depthMask) != (data.depth & depthMask) ||
+			prevData.depthRangeMin != data.depthRangeMin || prevData.depthRangeMax != data.depthRangeMax;
+
+		if (!dataChanged && !child->_isLayoutDirty())
+			return;
+
+		// Areas of the child's children are calculated from its layout data
+		if (dataChanged)
+			child->mFlags |= GUIElem_ChildAreasDirty;
+
+		child->_setLayoutData(data);
+		child->_updateLayoutInternal(data);
+	}
+
+	void GUIElementBase::updateDirtyChildLayouts()
+	{
+		for (auto& child : mChildren)
+		{
+			if (child->_isActive() && child->_isLayoutDirty())
+				updateChildLayout(child, child->mLayoutData);
+		}
+	}
+
 	void GUIElementBase::_updateLayoutInternal(const GUILayoutData& data)
 	{
 		for(auto& child : mChildren)
 		{
+			// Children are laid out using the data of this element, which might have changed
+			child->mFlags |= GUIElem_ChildAreasDirty;
 			child->_updateLayoutInternal(data);
 		}
 	}
@@ -39,7 +39,10 @@ namespace bs
 			GUIElem_HiddenSelf = 0x08,
 			GUIElem_InactiveSelf = 0x10,
 			GUIElem_Disabled = 0x20,
-			GUIElem_DisabledSelf = 0x40
+			GUIElem_DisabledSelf = 0x40,
+			GUIElem_SizeDirty = 0x80,
+			GUIElem_LayoutDirty = 0x100,
+			GUIElem_ChildAreasDirty = 0x200
 		};
 
 	public:
@@ -269,7 +272,11 @@ namespace bs
 		/**	Checks if element has been destroyed and is queued for deletion. */
 		virtual bool _isDestroyed() const { return false; }
 
-		/**	Marks the element's dimensions as dirty, triggering a layout rebuild. */
+		/**
+		 * Marks the element's dimensions as dirty, triggering a layout rebuild. Parents above the immediate parent only 
+		 * recalculate their size if the size range of their child actually changes. Hidden elements only mark themselves,
+		 * their parents are notified once the element is made visible.
+		 */
 		void _markLayoutAsDirty();
 
 		/**	Marks the element's contents as dirty, which causes the sprite meshes to be recreated from scratch. */
@@ -285,12 +292,43 @@ namespace bs
 		/**	Returns true if elements contents have changed since last update. */
 		bool _isDirty() const { return (mFlags & GUIElem_Dirty) != 0; }
 
-		/**	Marks the element contents to be up to date (meaning it's processed by the GUI system). */
+		/** 
+		 * Returns true if the element's cached size range is out of date and needs to be recalculated by 
+		 * _updateOptimalLayoutSizes(). 
+		 */
+		bool _isSizeDirty() const { return (mFlags & GUIElem_SizeDirty) != 0; }
+
+		/** 
+		 * Returns true if this element, or any of its child elements, were marked as dirty since the element's layout was 
+		 * last updated. 
+		 */
+		bool _isLayoutDirty() const { return (mFlags & GUIElem_LayoutDirty) != 0; }
+
+		/**
+		 * Returns true if the areas of child elements need to be recalculated during the next layout update, because the
+		 * element's layout data or the size ranges of its children changed.
+		 */
+		bool _isChildAreasDirty() const { return (mFlags & GUIElem_ChildAreasDirty) != 0; }
+
+		/**	Marks the element contents and layout to be up to date (meaning it's processed by the GUI system). */
 		void _markAsClean();
 
 		/** @} */
 
 	protected:
+		/**
+		 * Assigns new layout data to a child element and updates the child's layout. The update is skipped if the layout
+		 * data is the same as the one assigned during the last update, and neither the child nor any of its children were
+		 * marked as dirty since.
+		 */
+		void updateChildLayout(GUIElementBase* child, const GUILayoutData& data);
+
+		/**
+		 * Updates the layout of child elements that were marked as dirty, using their current layout data. Layouts call
+		 * this instead of recalculating child areas when the areas are known not to have changed.
+		 */
+		void updateDirtyChildLayouts();
+
 		/**	Finds anchor and update parents and recursively assigns them to all children. */
 		void _updateAUParents();
 
@@ -327,7 +365,7 @@ namespace bs
 		GUIElementBase* mParentElement = nullptr;
 
 		Vector<GUIElementBase*> mChildren;	
-		UINT8 mFlags = GUIElem_Dirty;
+		UINT16 mFlags = GUIElem_Dirty | GUIElem_SizeDirty | GUIElem_LayoutDirty | GUIElem_ChildAreasDirty;
 
 		GUIDimensions mDimensions;
 		GUILayoutData mLayoutData;
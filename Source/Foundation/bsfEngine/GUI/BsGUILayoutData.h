@@ -51,6 +51,17 @@ namespace bs
 			return (((INT32)depth >> 8) & 0xFFFF) - 32768;
 		}
 
+		bool operator== (const GUILayoutData& rhs) const
+		{
+			return area == rhs.area && clipRect == rhs.clipRect && depth == rhs.depth && 
+				depthRangeMin == rhs.depthRangeMin && depthRangeMax == rhs.depthRangeMax;
+		}
+
+		bool operator!= (const GUILayoutData& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
 		/**	Returns a clip rectangle that is relative to the current bounds. */
 		Rect2I getLocalClipRect() const
 		{
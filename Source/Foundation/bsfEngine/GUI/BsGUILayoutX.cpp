@@ -46,11 +46,20 @@ namespace bs
 
 	void GUILayoutX::_updateOptimalLayoutSizes()
 	{
+		// Cached sizes are still valid if neither this layout nor any of its children changed
+		if (!_isSizeDirty() && !_isLayoutDirty())
+			return;
+
 		// Update all children first, otherwise we can't determine our own optimal size
 		GUIElementBase::_updateOptimalLayoutSizes();
 
+		// Own size only changes if the layout itself changed, or if size of any of its children changed
+		bool sizeChanged = _isSizeDirty();
 		if(mChildren.size() != mChildSizeRanges.size())
+		{
 			mChildSizeRanges.resize(mChildren.size());
+			sizeChanged = true;
+		}
 
 		Vector2I optimalSize;
 		Vector2I minSize;
@@ -58,7 +67,7 @@ namespace bs
 		UINT32 childIdx = 0;
 		for(auto& child : mChildren)
 		{
-			LayoutSizeRange& childSizeRange = mChildSizeRanges[childIdx];
+			LayoutSizeRange childSizeRange;
 
 			if (child->_isActive())
 			{
@@ -78,15 +87,25 @@ namespace bs
 				minSize.x += childSizeRange.min.x + paddingX;
 				minSize.y = std::max((UINT32)minSize.y, childSizeRange.min.y + paddingY);
 			}
-			else
-				childSizeRange = LayoutSizeRange();
+
+			if (childSizeRange != mChildSizeRanges[childIdx])
+			{
+				mChildSizeRanges[childIdx] = childSizeRange;
+				sizeChanged = true;
+			}
 
 			childIdx++;
 		}
 
+		if (!sizeChanged)
+			return;
+
 		mSizeRange = _getDimensions().calculateSizeRange(optimalSize);
 		mSizeRange.min.x = std::max(mSizeRange.min.x, minSize.x);
 		mSizeRange.min.y = std::max(mSizeRange.min.y, minSize.y);
+
+		mFlags &= ~GUIElem_SizeDirty;
+		mFlags |= GUIElem_ChildAreasDirty;
 	}
 
 	void GUILayoutX::_getElementAreas(const Rect2I& layoutArea, Rect2I* elementAreas, UINT32 numElements,
@@ -393,6 +412,15 @@ namespace bs
 
 	void GUILayoutX::_updateLayoutInternal(const GUILayoutData& data)
 	{
+		// Child areas can only change if layout data of this layout, or size of any of its children changed
+		if (!_isChildAreasDirty())
+		{
+			updateDirtyChildLayouts();
+			return;
+		}
+
+		mFlags &= ~GUIElem_ChildAreasDirty;
+
 		UINT32 numElements = (UINT32)mChildren.size();
 		Rect2I* elementAreas = nullptr;
 
@@ -413,8 +441,7 @@ namespace bs
 				childData.clipRect = childData.area;
 				childData.clipRect.clip(data.clipRect);
 
-				child->_setLayoutData(childData);
-				child->_updateLayoutInternal(childData);
+				updateChildLayout(child, childData);
 			}
 
 			childIdx++;
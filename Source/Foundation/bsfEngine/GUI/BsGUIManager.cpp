@@ -37,37 +37,12 @@
 #include "RenderAPI/BsSamplerState.h"
 #include "Managers/BsRenderStateManager.h"
 #include "Resources/BsBuiltinResources.h"
+#include "Text/BsGlyphCache.h"
 
 using namespace std::placeholders;
 
 namespace bs
 {
-	struct GUIGroupElement
-	{
-		GUIGroupElement()
-		{ }
-
-		GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
-			:element(_element), renderElement(_renderElement)
-		{ }
-
-		GUIElement* element;
-		UINT32 renderElement;
-	};
-
-	struct GUIMaterialGroup
-	{
-		SpriteMaterial* material;
-		SpriteMaterialInfo matInfo;
-		GUIMeshType meshType;
-		UINT32 numVertices;
-		UINT32 numIndices;
-		UINT32 depth;
-		UINT32 minDepth;
-		Rect2I bounds;
-		Vector<GUIGroupElement> elements;
-	};
-
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
 	const float GUIManager::TOOLTIP_HOVER_TIME = 1.0f;
 
@@ -251,6 +226,45 @@ namespace bs
 			}
 		}
 
+		// Glyphs of dynamic fonts were evicted, any text referencing the evicted pages needs to be regenerated
+		GlyphCacheManager& glyphCacheManager = GlyphCacheManager::instance();
+		UINT64 glyphEvictionCount = glyphCacheManager.getEvictionCount();
+		if (glyphEvictionCount != mGlyphEvictionCount)
+		{
+			bs_frame_mark();
+			{
+				FrameVector<HTexture> evictedPages;
+				for (auto& entry : glyphCacheManager.getEvictedPages())
+				{
+					if (entry.first > mGlyphEvictionCount)
+						evictedPages.push_back(entry.second);
+				}
+
+				for (auto& widgetInfo : mWidgets)
+				{
+					for (auto& element : widgetInfo.widget->getElements())
+					{
+						const UINT32 numRenderElements = element->_getNumRenderElements();
+						for (UINT32 i = 0; i < numRenderElements; i++)
+						{
+							SpriteMaterial* material = nullptr;
+							const SpriteMaterialInfo& matInfo = element->_getMaterial(i, &material);
+
+							auto iterFind = std::find(evictedPages.begin(), evictedPages.end(), matInfo.texture);
+							if (iterFind != evictedPages.end())
+							{
+								element->_markContentAsDirty();
+								break;
+							}
+						}
+					}
+				}
+			}
+			bs_frame_clear();
+
+			mGlyphEvictionCount = glyphEvictionCount;
+		}
+
 		// Update layouts
 		gProfilerCPU().beginSample("UpdateLayout");
 		for(auto& widgetInfo : mWidgets)
@@ -401,7 +415,7 @@ namespace bs
 
 				for (auto& entry : renderData.cachedMeshes)
 				{
-					const SPtr<Mesh>& mesh = entry.isLine ? renderData.lineMesh : renderData.triangleMesh;
+					const SPtr<Mesh>& mesh = entry.mesh;
 					if(!mesh)
 						continue;
 
@@ -421,7 +435,7 @@ namespace bs
 					newEntry.worldTransform = entry.widget->getWorldTfrm();
 					newEntry.additionalData = entry.matInfo.additionalData;
 
-					newEntry.subMesh.indexOffset = entry.indexOffset;
+					newEntry.subMesh.indexOffset = 0;
 					newEntry.subMesh.indexCount = entry.indexCount;
 					newEntry.subMesh.drawOp = entry.isLine ? DOT_LINE_LIST : DOT_TRIANGLE_LIST;
 				}
@@ -446,285 +460,229 @@ namespace bs
 		{
 			GUIRenderData& renderData = cachedMeshData.second;
 
-			// Check if anything is dirty. If nothing is we can skip the update
-			bool isDirty = renderData.isDirty;
-			renderData.isDirty = false;
-
-			for(auto& widget : renderData.widgets)
-			{
-				if (widget->isDirty(true))
-				{
-					isDirty = true;
-				}
-			}
-
-			if(!isDirty)
-				continue;
-
-			mCoreDirty = true;
-
 			bs_frame_mark();
 			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+				// Check if anything is dirty. If nothing is we can skip the update. If any widget had elements added,
+				// removed or moved, the render elements will need to be regrouped.
+				bool isDirty = renderData.isDirty;
+				bool groupsDirty = renderData.isDirty;
+				renderData.isDirty = false;
+
+				FrameUnorderedSet<GUIElement*> dirtyElements;
+				for(auto& widget : renderData.widgets)
 				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+					if (!widget->isDirty(false))
+						continue;
 
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) || 
-						(aDepth == bDepth && a.element > b.element) || 
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-				};
+					groupsDirty |= widget->_isMeshDirty();
+					for(auto& element : widget->_getDirtyContents())
+						dirtyElements.insert(element);
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+					widget->isDirty(true);
+					isDirty = true;
+				}
 
-				for (auto& widget : renderData.widgets)
+				if(isDirty)
 				{
-					const Vector<GUIElement*>& elements = widget->getElements();
+					mCoreDirty = true;
 
-					for (auto& element : elements)
-					{
-						if (!element->_isVisible())
-							continue;
-
-						UINT32 numRenderElems = element->_getNumRenderElements();
-						for (UINT32 i = 0; i < numRenderElems; i++)
-						{
-							allElements.insert(GUIGroupElement(element, i));
-						}
-					}
+					if (groupsDirty || !updateMeshGroups(renderData, dirtyElements))
+						rebuildMeshGroups(renderData, dirtyElements);
 				}
+			}
+			bs_frame_clear();
+		}
+	}
 
-				// Group the elements in such a way so that we end up with a smallest amount of
-				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
-				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
-
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
-
-					SpriteMaterial* spriteMaterial = nullptr;
-					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
-					assert(spriteMaterial != nullptr);
-
-					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
-					
-					// Try to find a group this material will fit in:
-					//  - Group that has a depth value same or one below elements depth will always be a match
-					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-					//    overlap the current elements bounds.
-					GUIMaterialGroup* foundGroup = nullptr;
-
-					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
-					{
-						// If we separate meshes by widget, ignore any groups with widget parents other than mine
-						if (mSeparateMeshesByWidget)
-						{
-							if (groupIter->elements.size() > 0)
-							{
-								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
-									continue;
-							}
-						}
+	bool GUIManager::updateMeshGroups(GUIRenderData& renderData, const FrameUnorderedSet<GUIElement*>& dirtyElements)
+	{
+		FrameVector<GUIMeshElement> dirtyRenderElements;
+		for(auto& element : dirtyElements)
+		{
+			if (!element->_isVisible())
+				continue;
 
-						GUIMaterialGroup& group = *groupIter;
+			UINT32 numRenderElems = element->_getNumRenderElements();
+			for (UINT32 i = 0; i < numRenderElems; i++)
+				dirtyRenderElements.push_back(getMeshElement(element, i));
+		}
 
-						if (group.depth == elemDepth)
-						{
-							foundGroup = &group;
-							break;
-						}
-						else
-						{
-							UINT32 startDepth = elemDepth;
-							UINT32 endDepth = group.depth;
+		FrameVector<UINT32> dirtyGroups;
+		if (!GUIMeshGroupUtility::findDirtyGroups(renderData.cachedElements, renderData.cachedGroups, dirtyElements, 
+			dirtyRenderElements, dirtyGroups))
+			return false;
 
-							Rect2I potentialGroupBounds = group.bounds;
-							potentialGroupBounds.encapsulate(tfrmedBounds);
+		// Grouping is unchanged, only refill the meshes referencing dirty elements
+		for(auto& groupIdx : dirtyGroups)
+		{
+			const GUIMeshGroup& group = renderData.cachedGroups[groupIdx];
+			GUIMeshData& meshData = renderData.cachedMeshes[groupIdx];
+			const GUIMeshElement* elements = &renderData.cachedElements[group.elementStart];
 
-							bool foundOverlap = false;
-							for (auto& material : materialGroups)
-							{
-								for (auto& matGroup : material.second)
-								{
-									if (&matGroup == &group)
-										continue;
-
-									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
-									{
-										if (matGroup.bounds.overlaps(potentialGroupBounds))
-										{
-											foundOverlap = true;
-											break;
-										}
-									}
-								}
-							}
+			mergeMaterials(meshData, elements, group.numElements);
+			fillMesh(meshData, elements, group.numElements);
+		}
 
-							if (!foundOverlap)
-							{
-								foundGroup = &group;
-								break;
-							}
-						}
-					}
+		return true;
+	}
 
-					if (foundGroup == nullptr)
-					{
-						groupsPerMaterial.push_back(GUIMaterialGroup());
-						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+	void GUIManager::rebuildMeshGroups(GUIRenderData& renderData, const FrameUnorderedSet<GUIElement*>& dirtyElements)
+	{
+		FrameVector<GUIMeshElement> allElements;
+		for (auto& widget : renderData.widgets)
+		{
+			const Vector<GUIElement*>& elements = widget->getElements();
 
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->matInfo = matInfo.clone();
-						foundGroup->material = spriteMaterial;
+			for (auto& element : elements)
+			{
+				if (!element->_isVisible())
+					continue;
 
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
-					}
-					else
-					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
-						
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
-
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
-
-						spriteMaterial->merge(foundGroup->matInfo, matInfo);
-					}
-				}
+				UINT32 numRenderElems = element->_getNumRenderElements();
+				for (UINT32 i = 0; i < numRenderElems; i++)
+					allElements.push_back(getMeshElement(element, i));
+			}
+		}
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
-				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-				};
+		Vector<GUIMeshElement> newElements;
+		Vector<GUIMeshGroup> newGroups;
+		GUIMeshGroupUtility::group(allElements, mSeparateMeshesByWidget, newElements, newGroups);
 
-				UINT32 numMeshes = 0;
-				UINT32 numIndices[2] = { 0, 0 };
-				UINT32 numVertices[2] = { 0, 0 };
+		// Find meshes from the previous update so we can reuse them if their contents didn't change
+		FrameVector<UINT32> prevGroups;
+		FrameVector<bool> isIdentical;
+		GUIMeshGroupUtility::matchGroups(renderData.cachedElements, renderData.cachedGroups, newElements, newGroups,
+			dirtyElements, prevGroups, isIdentical);
 
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-				for(auto& material : materialGroups)
-				{
-					for(auto& group : material.second)
-					{
-						sortedGroups.insert(&group);
+		Vector<GUIMeshData> newMeshes(newGroups.size());
+		for(UINT32 i = 0; i < (UINT32)newGroups.size(); i++)
+		{
+			const GUIMeshGroup& group = newGroups[i];
+			const GUIMeshElement* elements = &newElements[group.elementStart];
 
-						UINT32 typeIdx = (UINT32)group.meshType;
-						numIndices[typeIdx] += group.numIndices;
-						numVertices[typeIdx] += group.numVertices;
+			GUIMeshData& guiMeshData = newMeshes[i];
+			guiMeshData.widget = elements[0].widget;
+			guiMeshData.isLine = elements[0].meshType == GUIMeshType::Line;
+			mergeMaterials(guiMeshData, elements, group.numElements);
 
-						numMeshes++;
-					}
-				}
+			if (prevGroups[i] != (UINT32)-1)
+			{
+				GUIMeshData& oldMeshData = renderData.cachedMeshes[prevGroups[i]];
 
-				renderData.triangleMesh = nullptr;
-				renderData.lineMesh = nullptr;
+				guiMeshData.mesh = oldMeshData.mesh;
+				oldMeshData.mesh = nullptr;
 
-				renderData.cachedMeshes.resize(numMeshes);
+				if (isIdentical[i])
+				{
+					guiMeshData.indexCount = oldMeshData.indexCount;
+					continue;
+				}
+			}
 
-				SPtr<MeshData> meshData[2];
-				SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
+			fillMesh(guiMeshData, elements, group.numElements);
+		}
 
-				UINT8* vertices[2] = { nullptr, nullptr };
-				UINT32* indices[2] = { nullptr, nullptr };
+		renderData.cachedElements = std::move(newElements);
+		renderData.cachedGroups = std::move(newGroups);
+		renderData.cachedMeshes = std::move(newMeshes);
+	}
 
-				for(UINT32 i = 0; i < 2; i++)
-				{
-					if(numVertices[i] > 0 && numIndices[i] > 0)
-					{
-						meshData[i] = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
+	void GUIManager::fillMesh(GUIMeshData& meshData, const GUIMeshElement* elements, UINT32 numElements)
+	{
+		UINT32 numVertices = 0;
+		UINT32 numIndices = 0;
+		for(UINT32 i = 0; i < numElements; i++)
+		{
+			numVertices += elements[i].numVertices;
+			numIndices += elements[i].numIndices;
+		}
 
-						vertices[i] = meshData[i]->getElementData(VES_POSITION);
-						indices[i] = meshData[i]->getIndices32();
-					}
-				}
+		meshData.indexCount = numIndices;
+		if (numVertices == 0 || numIndices == 0)
+		{
+			meshData.mesh = nullptr;
+			return;
+		}
 
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				UINT32 vertexOffset[2] = { 0, 0 };
-				UINT32 indexOffset[2] = { 0, 0 };
+		SPtr<VertexDataDesc> vertexDesc = meshData.isLine ? mLineVertexDesc : mTriangleVertexDesc;
+		SPtr<MeshData> data = MeshData::create(numVertices, numIndices, vertexDesc);
 
-				for(auto& group : sortedGroups)
-				{
-					GUIWidget* widget;
+		UINT8* vertices = data->getElementData(VES_POSITION);
+		UINT32* indices = data->getIndices32();
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
-					else
-					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
-					}
+		UINT32 vertexOffset = 0;
+		UINT32 indexOffset = 0;
+		for(UINT32 i = 0; i < numElements; i++)
+		{
+			const GUIMeshElement& entry = elements[i];
+			entry.element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, numVertices, numIndices, 
+				entry.renderElement);
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
-					guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+			UINT32 indexStart = indexOffset;
+			UINT32 indexEnd = indexStart + entry.numIndices;
 
-					UINT32 typeIdx = (UINT32)group->meshType;
-					guiMeshData.indexOffset = indexOffset[typeIdx];
+			for(UINT32 j = indexStart; j < indexEnd; j++)
+				indices[j] += vertexOffset;
 
-					UINT32 groupNumIndices = 0;
-					for(auto& matElement : group->elements)
-					{
-						matElement.element->_fillBuffer(
-							vertices[typeIdx], indices[typeIdx], 
-							vertexOffset[typeIdx], indexOffset[typeIdx], 
-							numVertices[typeIdx], numIndices[typeIdx], matElement.renderElement);
+			indexOffset += entry.numIndices;
+			vertexOffset += entry.numVertices;
+		}
 
-						UINT32 elemNumVertices;
-						UINT32 elemNumIndices;
-						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, elemNumVertices, elemNumIndices, meshType);
+		// Overwrite the existing mesh if possible, any unused space at the end is ignored since the draw call will only
+		// reference the first indexCount indices
+		if (meshData.mesh != nullptr)
+		{
+			const MeshProperties& props = meshData.mesh->getProperties();
+			if (props.getNumVertices() >= numVertices && props.getNumIndices() >= numIndices)
+			{
+				meshData.mesh->writeData(data, true);
+				return;
+			}
+		}
 
-						UINT32 indexStart = indexOffset[typeIdx];
-						UINT32 indexEnd = indexStart + elemNumIndices;
+		DrawOperationType drawOp = meshData.isLine ? DOT_LINE_LIST : DOT_TRIANGLE_LIST;
+		meshData.mesh = Mesh::_createPtr(data, MU_DYNAMIC, drawOp);
+	}
 
-						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[typeIdx][i] += vertexOffset[typeIdx];
+	void GUIManager::mergeMaterials(GUIMeshData& meshData, const GUIMeshElement* elements, UINT32 numElements)
+	{
+		for(UINT32 i = 0; i < numElements; i++)
+		{
+			SpriteMaterial* spriteMaterial = nullptr;
+			const SpriteMaterialInfo& matInfo = elements[i].element->_getMaterial(elements[i].renderElement, 
+				&spriteMaterial);
+			assert(spriteMaterial != nullptr);
 
-						indexOffset[typeIdx] += elemNumIndices;
-						vertexOffset[typeIdx] += elemNumVertices;
+			if (i == 0)
+			{
+				meshData.material = spriteMaterial;
+				meshData.matInfo = matInfo.clone();
+			}
+			else
+				spriteMaterial->merge(meshData.matInfo, matInfo);
+		}
+	}
 
-						groupNumIndices += elemNumIndices;
-					}
+	GUIMeshElement GUIManager::getMeshElement(GUIElement* element, UINT32 renderElement)
+	{
+		GUIMeshElement output;
+		output.element = element;
+		output.widget = element->_getParentWidget();
+		output.renderElement = renderElement;
+		output.depth = element->_getRenderElementDepth(renderElement);
 
-					guiMeshData.indexCount = groupNumIndices;
+		element->_getMeshInfo(renderElement, output.numVertices, output.numIndices, output.meshType);
 
-					meshIdx++;
-				}
+		SpriteMaterial* spriteMaterial = nullptr;
+		const SpriteMaterialInfo& matInfo = element->_getMaterial(renderElement, &spriteMaterial);
+		assert(spriteMaterial != nullptr);
 
-				if(meshData[0])
-					renderData.triangleMesh = Mesh::_createPtr(meshData[0], MU_STATIC, DOT_TRIANGLE_LIST);
+		output.mergeHash = spriteMaterial->getMergeHash(matInfo);
 
-				if(meshData[1])
-					renderData.lineMesh = Mesh::_createPtr(meshData[1], MU_STATIC, DOT_LINE_LIST);
-			}
+		output.bounds = element->_getClippedBounds();
+		output.bounds.transform(output.widget->getWorldTfrm());
 
-			bs_frame_clear();			
-		}
+		return output;
 	}
 
 	void GUIManager::updateCaretTexture()
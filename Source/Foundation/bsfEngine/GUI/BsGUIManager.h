@@ -12,6 +12,8 @@
 #include "Utility/BsModule.h"
 #include "Image/BsColor.h"
 #include "Math/BsMatrix4.h"
+#include "Math/BsRect2I.h"
+#include "GUI/BsGUIMeshGroupUtility.h"
 #include "Utility/BsEvent.h"
 #include "Material/BsMaterialParam.h"
 #include "Renderer/BsParamBlocks.h"
@@ -49,10 +51,13 @@ namespace bs
 			Dragging
 		};
 
-		/** Data required for rendering a single GUI mesh. */
+		/** 
+		 * Data required for rendering a single GUI mesh. Each mesh contains a group of render elements that can be 
+		 * rendered with a single material.
+		 */
 		struct GUIMeshData
 		{
-			UINT32 indexOffset = 0;
+			SPtr<Mesh> mesh;
 			UINT32 indexCount = 0;
 			SpriteMaterial* material;
 			SpriteMaterialInfo matInfo;
@@ -67,8 +72,11 @@ namespace bs
 				:isDirty(true)
 			{ }
 
-			SPtr<Mesh> triangleMesh;
-			SPtr<Mesh> lineMesh;
+			/** Render elements of the viewport, sorted so each group references a contiguous range. */
+			Vector<GUIMeshElement> cachedElements;
+
+			/** Groups of render elements, sorted from back to front. Each group is rendered using the mesh at same index. */
+			Vector<GUIMeshGroup> cachedGroups;
 			Vector<GUIMeshData> cachedMeshes;
 			Vector<GUIWidget*> widgets;
 			bool isDirty;
@@ -241,6 +249,39 @@ namespace bs
 		/**	Recreates all dirty GUI meshes and makes them ready for rendering. */
 		void updateMeshes();
 
+		/**
+		 * Attempts to update the GUI meshes of a viewport without regrouping the render elements. This is only possible if
+		 * none of the dirty elements changed in a way that affects grouping (e.g. their depth, bounds, material or number of
+		 * render elements). Only the meshes containing dirty elements are refilled.
+		 *
+		 * @param[in]	renderData		Render data of the viewport to update.
+		 * @param[in]	dirtyElements	Elements whose contents changed since the last update.
+		 * @return						True if the meshes were updated, false if the render elements need to be regrouped
+		 *								using rebuildMeshGroups().
+		 */
+		bool updateMeshGroups(GUIRenderData& renderData, const FrameUnorderedSet<GUIElement*>& dirtyElements);
+
+		/**
+		 * Groups all visible render elements of a viewport into meshes, sorted from back to front. Meshes whose contents 
+		 * are identical to a mesh from the previous update, and contain no dirty elements, are reused as is.
+		 *
+		 * @param[in]	renderData		Render data of the viewport to update.
+		 * @param[in]	dirtyElements	Elements whose contents changed since the last update.
+		 */
+		void rebuildMeshGroups(GUIRenderData& renderData, const FrameUnorderedSet<GUIElement*>& dirtyElements);
+
+		/** 
+		 * Fills the vertex and index data of the provided GUI mesh from its render elements. The existing mesh is 
+		 * overwritten if it is large enough, otherwise a new one is created.
+		 */
+		void fillMesh(GUIMeshData& meshData, const GUIMeshElement* elements, UINT32 numElements);
+
+		/** Assigns the material of the provided GUI mesh by merging the materials of all of its render elements. */
+		static void mergeMaterials(GUIMeshData& meshData, const GUIMeshElement* elements, UINT32 numElements);
+
+		/** Returns the information about a GUI element's render element used for grouping it into a mesh. */
+		static GUIMeshElement getMeshElement(GUIElement* element, UINT32 renderElement);
+
 		/**	Recreates the input caret texture. */
 		void updateCaretTexture();
 
@@ -401,6 +442,8 @@ namespace bs
 		bool mSeparateMeshesByWidget;
 		Vector2I mLastPointerScreenPos;
 
+		UINT64 mGlyphEvictionCount = 0;
+
 		DragState mDragState;
 		Vector2I mLastPointerClickPos;
 		Vector2I mDragStartPos;
@@ -0,0 +1,302 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "GUI/BsGUIMeshGroupUtility.h"
+
+namespace bs
+{
+	/** Group of render elements that is being built by GUIMeshGroupUtility::group(). */
+	struct GUIMaterialGroup
+	{
+		UINT32 depth;
+		UINT32 minDepth;
+		Rect2I bounds;
+		FrameVector<const GUIMeshElement*> elements;
+	};
+
+	void GUIMeshGroupUtility::group(const FrameVector<GUIMeshElement>& elements, bool separateByWidget,
+		Vector<GUIMeshElement>& outElements, Vector<GUIMeshGroup>& outGroups)
+	{
+		// Sort the render elements from farthest to nearest (highest depth to lowest)
+		FrameVector<const GUIMeshElement*> sortedElements;
+		sortedElements.reserve(elements.size());
+
+		for(auto& entry : elements)
+			sortedElements.push_back(&entry);
+
+		// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really
+		// matter, but it needs to be deterministic so unchanged groups can be recognized between updates
+		std::sort(sortedElements.begin(), sortedElements.end(),
+			[](const GUIMeshElement* a, const GUIMeshElement* b)
+		{
+			return (a->depth > b->depth) ||
+				(a->depth == b->depth && a->element > b->element) ||
+				(a->depth == b->depth && a->element == b->element && a->renderElement > b->renderElement);
+		});
+
+		FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
+		for (auto& elem : sortedElements)
+		{
+			const UINT32 elemDepth = elem->depth;
+			const Rect2I& tfrmedBounds = elem->bounds;
+
+			FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[elem->mergeHash];
+
+			// Try to find a group this material will fit in:
+			//  - Group that has a depth value same or one below elements depth will always be a match
+			//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
+			//    overlap the current elements bounds.
+			GUIMaterialGroup* foundGroup = nullptr;
+
+			for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+			{
+				// If we separate meshes by widget, ignore any groups with widget parents other than mine
+				if (separateByWidget)
+				{
+					if (groupIter->elements.size() > 0)
+					{
+						const GUIMeshElement* otherElem = groupIter->elements[0]; // We only need to check the first element
+						if (otherElem->widget != elem->widget)
+							continue;
+					}
+				}
+
+				GUIMaterialGroup& group = *groupIter;
+
+				if (group.depth == elemDepth)
+				{
+					foundGroup = &group;
+					break;
+				}
+				else
+				{
+					UINT32 startDepth = elemDepth;
+					UINT32 endDepth = group.depth;
+
+					Rect2I potentialGroupBounds = group.bounds;
+					potentialGroupBounds.encapsulate(tfrmedBounds);
+
+					bool foundOverlap = false;
+					for (auto& material : materialGroups)
+					{
+						for (auto& matGroup : material.second)
+						{
+							if (&matGroup == &group)
+								continue;
+
+							if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
+								|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+							{
+								if (matGroup.bounds.overlaps(potentialGroupBounds))
+								{
+									foundOverlap = true;
+									break;
+								}
+							}
+						}
+					}
+
+					if (!foundOverlap)
+					{
+						foundGroup = &group;
+						break;
+					}
+				}
+			}
+
+			if (foundGroup == nullptr)
+			{
+				groupsPerMaterial.push_back(GUIMaterialGroup());
+				foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+
+				foundGroup->depth = elemDepth;
+				foundGroup->minDepth = elemDepth;
+				foundGroup->bounds = tfrmedBounds;
+				foundGroup->elements.push_back(elem);
+			}
+			else
+			{
+				foundGroup->bounds.encapsulate(tfrmedBounds);
+				foundGroup->elements.push_back(elem);
+				foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
+
+				// It's expected that GUI element doesn't use same material for different mesh types so this should always
+				// be true
+				assert(elem->meshType == foundGroup->elements[0]->meshType);
+			}
+		}
+
+		// Sort the groups from farthest to nearest (highest depth to lowest)
+		FrameVector<GUIMaterialGroup*> sortedGroups;
+		for(auto& material : materialGroups)
+		{
+			for(auto& group : material.second)
+				sortedGroups.push_back(&group);
+		}
+
+		std::sort(sortedGroups.begin(), sortedGroups.end(),
+			[](const GUIMaterialGroup* a, const GUIMaterialGroup* b)
+		{
+			// Compare the first elements just to differentiate between two groups with the same depth, their order
+			// doesn't really matter, but it needs to be deterministic
+			const GUIMeshElement* firstA = a->elements[0];
+			const GUIMeshElement* firstB = b->elements[0];
+
+			return (a->depth > b->depth) ||
+				(a->depth == b->depth && firstA->element > firstB->element) ||
+				(a->depth == b->depth && firstA->element == firstB->element &&
+					firstA->renderElement > firstB->renderElement);
+		});
+
+		outElements.clear();
+		outElements.reserve(elements.size());
+
+		outGroups.resize(sortedGroups.size());
+		for(UINT32 i = 0; i < (UINT32)sortedGroups.size(); i++)
+		{
+			GUIMeshGroup& group = outGroups[i];
+			group.elementStart = (UINT32)outElements.size();
+			group.numElements = (UINT32)sortedGroups[i]->elements.size();
+
+			for(auto& entry : sortedGroups[i]->elements)
+				outElements.push_back(*entry);
+		}
+	}
+
+	bool GUIMeshGroupUtility::findDirtyGroups(Vector<GUIMeshElement>& elements, const Vector<GUIMeshGroup>& groups,
+		const FrameUnorderedSet<GUIElement*>& dirtyElements, const FrameVector<GUIMeshElement>& dirtyRenderElements,
+		FrameVector<UINT32>& outDirtyGroups)
+	{
+		// Find where the current state of each dirty element's render elements is stored
+		struct DirtyElementInfo
+		{
+			UINT32 start = 0;
+			UINT32 count = 0;
+			UINT32 numGrouped = 0;
+		};
+
+		FrameUnorderedMap<GUIElement*, DirtyElementInfo> dirtyInfos;
+		for(UINT32 i = 0; i < (UINT32)dirtyRenderElements.size(); i++)
+		{
+			DirtyElementInfo& info = dirtyInfos[dirtyRenderElements[i].element];
+			if (info.count == 0)
+				info.start = i;
+
+			info.count++;
+		}
+
+		for(UINT32 i = 0; i < (UINT32)groups.size(); i++)
+		{
+			const GUIMeshGroup& group = groups[i];
+
+			bool isGroupDirty = false;
+			for(UINT32 j = 0; j < group.numElements; j++)
+			{
+				const GUIMeshElement& entry = elements[group.elementStart + j];
+				if (dirtyElements.find(entry.element) == dirtyElements.end())
+					continue;
+
+				// Element is no longer visible, or lost the render element
+				auto iterFind = dirtyInfos.find(entry.element);
+				if (iterFind == dirtyInfos.end() || entry.renderElement >= iterFind->second.count)
+					return false;
+
+				// If anything relevant for grouping changed we need to regroup
+				const GUIMeshElement& current = dirtyRenderElements[iterFind->second.start + entry.renderElement];
+				if (current.depth != entry.depth || current.mergeHash != entry.mergeHash ||
+					current.meshType != entry.meshType || current.bounds != entry.bounds)
+					return false;
+
+				iterFind->second.numGrouped++;
+				isGroupDirty = true;
+			}
+
+			if (isGroupDirty)
+				outDirtyGroups.push_back(i);
+		}
+
+		// Make sure dirty elements didn't gain any render elements
+		for(auto& entry : dirtyInfos)
+		{
+			if (entry.second.count != entry.second.numGrouped)
+				return false;
+		}
+
+		// Grouping is unchanged, update the stored state of the dirty render elements (e.g. their vertex counts)
+		for(auto& groupIdx : outDirtyGroups)
+		{
+			const GUIMeshGroup& group = groups[groupIdx];
+			for(UINT32 i = 0; i < group.numElements; i++)
+			{
+				GUIMeshElement& entry = elements[group.elementStart + i];
+
+				auto iterFind = dirtyInfos.find(entry.element);
+				if (iterFind != dirtyInfos.end())
+					entry = dirtyRenderElements[iterFind->second.start + entry.renderElement];
+			}
+		}
+
+		return true;
+	}
+
+	void GUIMeshGroupUtility::matchGroups(const Vector<GUIMeshElement>& prevElements,
+		const Vector<GUIMeshGroup>& prevGroups, const Vector<GUIMeshElement>& elements, const Vector<GUIMeshGroup>& groups,
+		const FrameUnorderedSet<GUIElement*>& dirtyElements, FrameVector<UINT32>& outPrevGroups,
+		FrameVector<bool>& outIdentical)
+	{
+		auto getGroupKey = [](const GUIMeshElement& firstElement)
+		{
+			size_t key = 0;
+			hash_combine(key, firstElement.element);
+			hash_combine(key, firstElement.renderElement);
+
+			return (UINT64)key;
+		};
+
+		FrameUnorderedMap<UINT64, UINT32> prevGroupLookup;
+		for(UINT32 i = 0; i < (UINT32)prevGroups.size(); i++)
+		{
+			if (prevGroups[i].numElements > 0)
+				prevGroupLookup[getGroupKey(prevElements[prevGroups[i].elementStart])] = i;
+		}
+
+		outPrevGroups.resize(groups.size());
+		outIdentical.resize(groups.size());
+
+		for(UINT32 i = 0; i < (UINT32)groups.size(); i++)
+		{
+			const GUIMeshGroup& group = groups[i];
+			const GUIMeshElement& firstElement = elements[group.elementStart];
+
+			outPrevGroups[i] = (UINT32)-1;
+			outIdentical[i] = false;
+
+			auto iterFind = prevGroupLookup.find(getGroupKey(firstElement));
+			if (iterFind == prevGroupLookup.end())
+				continue;
+
+			// Ignore groups that only matched due to a hash collision
+			const GUIMeshGroup& prevGroup = prevGroups[iterFind->second];
+			const GUIMeshElement& prevFirstElement = prevElements[prevGroup.elementStart];
+			if (prevFirstElement.element != firstElement.element ||
+				prevFirstElement.renderElement != firstElement.renderElement)
+				continue;
+
+			outPrevGroups[i] = iterFind->second;
+
+			// Mesh can be reused as is if it contains the exact same unmodified render elements
+			bool isIdentical = prevGroup.numElements == group.numElements;
+			for(UINT32 j = 0; isIdentical && j < group.numElements; j++)
+			{
+				const GUIMeshElement& prevElem = prevElements[prevGroup.elementStart + j];
+				const GUIMeshElement& newElem = elements[group.elementStart + j];
+
+				isIdentical = prevElem.element == newElem.element && prevElem.renderElement == newElem.renderElement &&
+					prevElem.meshType == newElem.meshType && prevElem.numVertices == newElem.numVertices &&
+					prevElem.numIndices == newElem.numIndices &&
+					dirtyElements.find(newElem.element) == dirtyElements.end();
+			}
+
+			outIdentical[i] = isIdentical;
+		}
+	}
+}
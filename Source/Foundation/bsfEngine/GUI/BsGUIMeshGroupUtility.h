@@ -0,0 +1,97 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "Math/BsRect2I.h"
+
+namespace bs
+{
+	/** @addtogroup GUI-Internal
+	 *  @{
+	 */
+
+	/** Render element of a GUI element that is a part of a GUI mesh, along with the state it was grouped by. */
+	struct GUIMeshElement
+	{
+		GUIElement* element;
+		GUIWidget* widget;
+		UINT32 renderElement;
+		UINT32 depth;
+		UINT32 numVertices;
+		UINT32 numIndices;
+		GUIMeshType meshType;
+		UINT64 mergeHash;
+		Rect2I bounds;
+	};
+
+	/** Group of GUI render elements that can be rendered using a single mesh and material. */
+	struct GUIMeshGroup
+	{
+		/** Range of render elements, in the list the group was created from, that are part of this group. */
+		UINT32 elementStart = 0;
+		UINT32 numElements = 0;
+	};
+
+	/**
+	 * Helper class that groups GUI render elements into meshes, and determines which meshes need to be refilled when
+	 * the render elements change. Only operates on the render element state stored in GUIMeshElement, and never
+	 * accesses the GUI elements themselves.
+	 */
+	class BS_EXPORT GUIMeshGroupUtility
+	{
+	public:
+		/**
+		 * Groups the render elements in such a way so that we end up with a smallest amount of meshes, without breaking
+		 * back to front rendering order. Only render elements with the same merge hash can be part of the same group.
+		 *
+		 * @param[in]	elements			Render elements to group, in any order.
+		 * @param[in]	separateByWidget	If true, render elements of different widgets are never grouped together.
+		 * @param[out]	outElements			Render elements sorted in such a way that each group references a
+		 *									contiguous range.
+		 * @param[out]	outGroups			Groups sorted from farthest to nearest (highest depth to lowest).
+		 */
+		static void group(const FrameVector<GUIMeshElement>& elements, bool separateByWidget,
+			Vector<GUIMeshElement>& outElements, Vector<GUIMeshGroup>& outGroups);
+
+		/**
+		 * Finds the groups that need to be refilled because their render elements changed, if that is possible without
+		 * regrouping. This is only possible if none of the dirty elements changed in a way that affects grouping (e.g.
+		 * their depth, bounds, material or number of render elements).
+		 *
+		 * @param[in, out]	elements				Render elements the groups were created from. Entries of dirty render
+		 *											elements are updated to their current state if the method succeeds.
+		 * @param[in]		groups					Groups created from @p elements.
+		 * @param[in]		dirtyElements			GUI elements whose contents changed since the groups were created.
+		 * @param[in]		dirtyRenderElements		Current state of all render elements of visible dirty elements. Render
+		 *											elements of a single GUI element must be stored sequentially, in order.
+		 * @param[out]		outDirtyGroups			Indices of the groups that contain dirty render elements.
+		 * @return									True if the groups are still valid, false if the render elements need
+		 *											to be regrouped.
+		 */
+		static bool findDirtyGroups(Vector<GUIMeshElement>& elements, const Vector<GUIMeshGroup>& groups,
+			const FrameUnorderedSet<GUIElement*>& dirtyElements, const FrameVector<GUIMeshElement>& dirtyRenderElements,
+			FrameVector<UINT32>& outDirtyGroups);
+
+		/**
+		 * Matches newly created groups with the groups from a previous grouping, so the meshes of the previous groups can
+		 * be reused.
+		 *
+		 * @param[in]	prevElements	Render elements the previous groups were created from.
+		 * @param[in]	prevGroups		Previous groups.
+		 * @param[in]	elements		Render elements the new groups were created from.
+		 * @param[in]	groups			New groups.
+		 * @param[in]	dirtyElements	GUI elements whose contents changed since the previous groups were created.
+		 * @param[out]	outPrevGroups	For each new group, index of the previous group that starts with the same render
+		 *								element, or -1 if there is no such group.
+		 * @param[out]	outIdentical	For each new group, true if the matched previous group contains the exact same
+		 *								unmodified render elements, in which case its mesh can be used as is.
+		 */
+		static void matchGroups(const Vector<GUIMeshElement>& prevElements, const Vector<GUIMeshGroup>& prevGroups,
+			const Vector<GUIMeshElement>& elements, const Vector<GUIMeshGroup>& groups,
+			const FrameUnorderedSet<GUIElement*>& dirtyElements, FrameVector<UINT32>& outPrevGroups,
+			FrameVector<bool>& outIdentical);
+	};
+
+	/** @} */
+}
@@ -82,11 +82,20 @@ namespace bs
 
 	void GUIPanel::_updateOptimalLayoutSizes()
 	{
+		// Cached sizes are still valid if neither this layout nor any of its children changed
+		if (!_isSizeDirty() && !_isLayoutDirty())
+			return;
+
 		// Update all children first, otherwise we can't determine our own optimal size
 		GUIElementBase::_updateOptimalLayoutSizes();
 
+		// Own size only changes if the panel itself changed, or if size of any of its children changed
+		bool sizeChanged = _isSizeDirty();
 		if (mChildren.size() != mChildSizeRanges.size())
+		{
 			mChildSizeRanges.resize(mChildren.size());
+			sizeChanged = true;
+		}
 
 		Vector2I optimalSize;
 		Vector2I minSize;
@@ -94,7 +103,7 @@ namespace bs
 		UINT32 childIdx = 0;
 		for (auto& child : mChildren)
 		{
-			LayoutSizeRange& childSizeRange = mChildSizeRanges[childIdx];
+			LayoutSizeRange childSizeRange;
 
 			if (child->_isActive())
 			{
@@ -116,15 +125,25 @@ namespace bs
 				minSize.x = std::max(minSize.x, childMax.x);
 				minSize.y = std::max(minSize.y, childMax.y);
 			}
-			else
-				childSizeRange = LayoutSizeRange();
+
+			if (childSizeRange != mChildSizeRanges[childIdx])
+			{
+				mChildSizeRanges[childIdx] = childSizeRange;
+				sizeChanged = true;
+			}
 
 			childIdx++;
 		}
 
+		if (!sizeChanged)
+			return;
+
 		mSizeRange = _getDimensions().calculateSizeRange(optimalSize);
 		mSizeRange.min.x = std::max(mSizeRange.min.x, minSize.x);
 		mSizeRange.min.y = std::max(mSizeRange.min.y, minSize.y);
+
+		mFlags &= ~GUIElem_SizeDirty;
+		mFlags |= GUIElem_ChildAreasDirty;
 	}
 
 	void GUIPanel::_getElementAreas(const Rect2I& layoutArea, Rect2I* elementAreas, UINT32 numElements,
@@ -222,6 +241,15 @@ namespace bs
 
 	void GUIPanel::_updateLayoutInternal(const GUILayoutData& data)
 	{
+		// Child areas can only change if layout data of this panel, or size of any of its children changed
+		if (!_isChildAreasDirty())
+		{
+			updateDirtyChildLayouts();
+			return;
+		}
+
+		mFlags &= ~GUIElem_ChildAreasDirty;
+
 		GUILayoutData childData = data;
 		_updateDepthRange(childData);
 
@@ -258,8 +286,7 @@ namespace bs
 		childData.clipRect = data.area;
 		childData.clipRect.clip(data.clipRect);
 
-		element->_setLayoutData(childData);
-		element->_updateLayoutInternal(childData);
+		updateChildLayout(element, childData);
 	}
 
 	GUIPanel* GUIPanel::create(INT16 depth, UINT16 depthRangeMin, UINT16 depthRangeMax)
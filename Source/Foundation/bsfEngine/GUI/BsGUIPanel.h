@@ -99,7 +99,10 @@ namespace bs
 		 */
 		LayoutSizeRange _getElementSizeRange(const GUIElementBase* element) const;
 
-		/** Assigns the specified layout information to a child element of a GUI panel. */
+		/** 
+		 * Assigns the specified layout information to a child element of a GUI panel. Child layout update is skipped if
+		 * the layout information and the child are unchanged since the last update.
+		 */
 		void _updateChildLayout(GUIElementBase* element, const GUILayoutData& data);
 
 		/** @copydoc GUIElementBase::_updateLayoutInternal */
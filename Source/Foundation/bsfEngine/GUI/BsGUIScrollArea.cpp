@@ -77,6 +77,10 @@ namespace bs
 
 	void GUIScrollArea::_updateOptimalLayoutSizes()
 	{
+		// Cached sizes are still valid if neither the scroll area nor any of its children changed
+		if (!_isSizeDirty() && !_isLayoutDirty())
+			return;
+
 		// Update all children first, otherwise we can't determine our own optimal size
 		GUIElementBase::_updateOptimalLayoutSizes();
 
@@ -95,6 +99,7 @@ namespace bs
 		}
 
 		mSizeRange = mDimensions.calculateSizeRange(_getOptimalSize());
+		mFlags &= ~GUIElem_SizeDirty;
 	}
 
 	void GUIScrollArea::_getElementAreas(const Rect2I& layoutArea, Rect2I* elementAreas, UINT32 numElements,
@@ -304,8 +309,7 @@ namespace bs
 			layoutData.area = layoutBounds;
 			layoutData.clipRect = layoutClipRect;
 
-			mContentLayout->_setLayoutData(layoutData);
-			mContentLayout->_updateLayoutInternal(layoutData);
+			updateChildLayout(mContentLayout, layoutData);
 		}
 
 		// Vertical scrollbar
@@ -0,0 +1,539 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "GUI/BsGUIVirtualScrollArea.h"
+#include "GUI/BsGUIScrollArea.h"
+#include "GUI/BsGUIDimensions.h"
+#include "GUI/BsGUIScrollBarVert.h"
+#include "GUI/BsGUIMouseEvent.h"
+#include "GUI/BsGUIWidget.h"
+#include "Math/BsMath.h"
+
+using namespace std::placeholders;
+
+namespace bs
+{
+	const UINT32 GUIVirtualScrollArea::WheelScrollAmount = 50;
+
+	GUIVirtualScrollArea::GUIVirtualScrollArea(const String& scrollBarStyle, const String& scrollAreaStyle,
+		const GUIDimensions& dimensions)
+		: GUIElementContainer(dimensions, scrollAreaStyle)
+	{
+		mVertScroll = GUIScrollBarVert::create(scrollBarStyle);
+		_registerChildElement(mVertScroll);
+
+		mVertScroll->onScrollOrResize.connect(std::bind(&GUIVirtualScrollArea::vertScrollUpdate, this, _1));
+	}
+
+	void GUIVirtualScrollArea::setItemCallbacks(const CreateItemCallback& create, const UpdateItemCallback& update)
+	{
+		mCreateCallback = create;
+		mUpdateCallback = update;
+
+		refreshItems();
+	}
+
+	void GUIVirtualScrollArea::setNumItems(UINT32 numItems)
+	{
+		mNumItems = numItems;
+
+		if (mEstimateHeights)
+		{
+			// Keep heights of items that were already measured
+			mItemHeights.resize(numItems, mItemHeight);
+			rebuildHeightTree();
+		}
+
+		refreshItems();
+	}
+
+	void GUIVirtualScrollArea::setItemHeight(UINT32 height, bool estimated)
+	{
+		mItemHeight = std::max(1U, height);
+		mEstimateHeights = estimated;
+
+		if (mEstimateHeights)
+		{
+			mItemHeights.assign(mNumItems, mItemHeight);
+			rebuildHeightTree();
+		}
+		else
+		{
+			mItemHeights.clear();
+			mHeightTree.clear();
+		}
+
+		refreshItems();
+	}
+
+	void GUIVirtualScrollArea::setOverscan(UINT32 pixels)
+	{
+		mOverscan = pixels;
+
+		_markLayoutAsDirty();
+	}
+
+	void GUIVirtualScrollArea::refreshItems()
+	{
+		mRefreshItems = true;
+
+		_markLayoutAsDirty();
+	}
+
+	void GUIVirtualScrollArea::refreshItem(UINT32 idx)
+	{
+		for (auto& entry : mBoundItems)
+		{
+			if (entry.index != idx)
+				continue;
+
+			mUpdateCallback(entry.element, idx);
+			break;
+		}
+	}
+
+	void GUIVirtualScrollArea::scrollToItem(UINT32 idx)
+	{
+		if (idx >= mNumItems)
+			return;
+
+		// Delayed until layout update since visible height might not be up to date
+		mScrollToItem = (INT32)idx;
+
+		_markLayoutAsDirty();
+	}
+
+	void GUIVirtualScrollArea::getBoundRange(UINT32& start, UINT32& end) const
+	{
+		if (mBoundItems.empty())
+		{
+			start = 0;
+			end = 0;
+			return;
+		}
+
+		start = mBoundItems.front().index;
+		end = mBoundItems.back().index + 1;
+	}
+
+	GUIElement* GUIVirtualScrollArea::getItemElement(UINT32 idx) const
+	{
+		// Bound items are always a contiguous range
+		if (mBoundItems.empty() || idx < mBoundItems.front().index || idx > mBoundItems.back().index)
+			return nullptr;
+
+		return mBoundItems[idx - mBoundItems.front().index].element;
+	}
+
+	UINT32 GUIVirtualScrollArea::getItemHeight(UINT32 idx) const
+	{
+		if (mEstimateHeights)
+			return mItemHeights[idx];
+
+		return mItemHeight;
+	}
+
+	UINT32 GUIVirtualScrollArea::getItemOffset(UINT32 idx) const
+	{
+		if (!mEstimateHeights)
+			return idx * mItemHeight;
+
+		UINT32 offset = 0;
+		for (UINT32 i = idx; i > 0; i -= i & (0 - i))
+			offset += mHeightTree[i];
+
+		return offset;
+	}
+
+	UINT32 GUIVirtualScrollArea::findItem(UINT32 offset) const
+	{
+		if (mNumItems == 0)
+			return 0;
+
+		if (!mEstimateHeights)
+			return std::min(offset / mItemHeight, mNumItems - 1);
+
+		// Find the number of items whose combined height doesn't exceed the offset, by descending the tree
+		UINT32 step = 1;
+		while ((step << 1) <= mNumItems)
+			step <<= 1;
+
+		UINT32 idx = 0;
+		for (; step > 0; step >>= 1)
+		{
+			UINT32 next = idx + step;
+			if (next <= mNumItems && mHeightTree[next] <= offset)
+			{
+				idx = next;
+				offset -= mHeightTree[next];
+			}
+		}
+
+		return std::min(idx, mNumItems - 1);
+	}
+
+	UINT32 GUIVirtualScrollArea::getContentHeight() const
+	{
+		return getItemOffset(mNumItems);
+	}
+
+	void GUIVirtualScrollArea::setMeasuredHeight(UINT32 idx, UINT32 height)
+	{
+		// Zero sized items would all map to the same offset, so don't allow them
+		height = std::max(1U, height);
+
+		if (mItemHeights[idx] == height)
+			return;
+
+		// Note: Relies on unsigned overflow in case the new height is smaller
+		UINT32 delta = height - mItemHeights[idx];
+		mItemHeights[idx] = height;
+
+		for (UINT32 i = idx + 1; i <= mNumItems; i += i & (0 - i))
+			mHeightTree[i] += delta;
+	}
+
+	void GUIVirtualScrollArea::rebuildHeightTree()
+	{
+		mHeightTree.assign(mNumItems + 1, 0);
+
+		for (UINT32 i = 1; i <= mNumItems; i++)
+		{
+			mHeightTree[i] += mItemHeights[i - 1];
+
+			UINT32 parent = i + (i & (0 - i));
+			if (parent <= mNumItems)
+				mHeightTree[parent] += mHeightTree[i];
+		}
+	}
+
+	void GUIVirtualScrollArea::bindItems(UINT32 start, UINT32 end, bool refresh)
+	{
+		if (!mCreateCallback || !mUpdateCallback)
+			end = start;
+
+		// Recycle elements of items outside of the new range. Both ranges are contiguous so the remaining items are too.
+		UINT32 numKept = 0;
+		for (auto& entry : mBoundItems)
+		{
+			if (entry.index >= start && entry.index < end)
+				mBoundItems[numKept++] = entry;
+			else
+			{
+				entry.element->setActive(false);
+				mFreeElements.push_back(entry.element);
+			}
+		}
+
+		mBoundItems.resize(numKept);
+
+		const auto bindItem = [this](UINT32 idx)
+		{
+			GUIElement* element;
+			if (!mFreeElements.empty())
+			{
+				element = mFreeElements.back();
+				mFreeElements.pop_back();
+
+				element->setActive(true);
+			}
+			else
+			{
+				element = mCreateCallback();
+				_registerChildElement(element);
+			}
+
+			mUpdateCallback(element, idx);
+			return BoundItem { idx, element };
+		};
+
+		UINT32 keptStart = end;
+		UINT32 keptEnd = end;
+		if (numKept > 0)
+		{
+			keptStart = mBoundItems.front().index;
+			keptEnd = mBoundItems.back().index + 1;
+
+			if (refresh)
+			{
+				for (auto& entry : mBoundItems)
+					mUpdateCallback(entry.element, entry.index);
+			}
+		}
+
+		if (start < keptStart)
+		{
+			mBoundItems.insert(mBoundItems.begin(), keptStart - start, BoundItem());
+			for (UINT32 i = start; i < keptStart; i++)
+				mBoundItems[i - start] = bindItem(i);
+		}
+
+		for (UINT32 i = keptEnd; i < end; i++)
+			mBoundItems.push_back(bindItem(i));
+
+		if (mEstimateHeights)
+		{
+			for (auto& entry : mBoundItems)
+			{
+				entry.element->_updateOptimalLayoutSizes();
+				setMeasuredHeight(entry.index, (UINT32)entry.element->_getLayoutSizeRange().optimal.y);
+			}
+		}
+	}
+
+	void GUIVirtualScrollArea::_postLayoutUpdate()
+	{
+		bindItems(mBindStart, mBindEnd, mRefreshItems);
+		mRefreshItems = false;
+
+		// Position the newly bound elements, and find out if measured heights changed the visible range
+		_markLayoutAsDirty();
+	}
+
+	void GUIVirtualScrollArea::requestBind()
+	{
+		GUIWidget* widget = _getParentWidget();
+		if (widget != nullptr)
+			widget->_requestPostLayoutUpdate(this);
+	}
+
+	void GUIVirtualScrollArea::updateClippedBounds()
+	{
+		mClippedBounds = mLayoutData.area;
+		mClippedBounds.clip(mLayoutData.clipRect);
+	}
+
+	Vector2I GUIVirtualScrollArea::_getOptimalSize() const
+	{
+		// Width can only be estimated from items that are currently displayed
+		Vector2I optimalSize((INT32)mOptimalItemWidth, (INT32)getContentHeight());
+
+		// Provide 10x10 in case there are no items because 0 doesn't work well with the layout system
+		optimalSize.x = std::max(10, optimalSize.x);
+		optimalSize.y = std::max(10, optimalSize.y);
+
+		return optimalSize;
+	}
+
+	LayoutSizeRange GUIVirtualScrollArea::_calculateLayoutSizeRange() const
+	{
+		return mDimensions.calculateSizeRange(_getOptimalSize());
+	}
+
+	LayoutSizeRange GUIVirtualScrollArea::_getLayoutSizeRange() const
+	{
+		return mSizeRange;
+	}
+
+	void GUIVirtualScrollArea::_updateOptimalLayoutSizes()
+	{
+		if (!_isSizeDirty() && !_isLayoutDirty())
+			return;
+
+		// Only updates the scroll bar and the elements of bound items
+		GUIElementBase::_updateOptimalLayoutSizes();
+
+		mOptimalItemWidth = 0;
+		for (auto& entry : mBoundItems)
+		{
+			const LayoutSizeRange sizeRange = entry.element->_getLayoutSizeRange();
+			mOptimalItemWidth = std::max(mOptimalItemWidth, (UINT32)sizeRange.optimal.x);
+
+			// Contents of a bound element might have changed since it was measured
+			if (mEstimateHeights && entry.index < mNumItems)
+				setMeasuredHeight(entry.index, (UINT32)sizeRange.optimal.y);
+		}
+
+		mSizeRange = mDimensions.calculateSizeRange(_getOptimalSize());
+		mFlags &= ~GUIElem_SizeDirty;
+	}
+
+	void GUIVirtualScrollArea::_updateLayoutInternal(const GUILayoutData& data)
+	{
+		mVisibleHeight = data.area.height;
+
+		UINT32 contentHeight = getContentHeight();
+		bool hasScrollbar = contentHeight > mVisibleHeight;
+
+		UINT32 contentWidth = data.area.width;
+		if (hasScrollbar)
+			contentWidth = (UINT32)std::max(0, (INT32)contentWidth - (INT32)GUIScrollArea::ScrollBarWidth);
+
+		// Recalculate offsets in case scroll position got updated externally (this needs to be delayed to this point
+		// because at the time of the update content and visible sizes might be out of date).
+		UINT32 scrollableHeight = (UINT32)std::max(0, INT32(contentHeight) - INT32(mVisibleHeight));
+		if (mRecalculateVertOffset)
+		{
+			mVertOffset = scrollableHeight * Math::clamp01(mVertScroll->getScrollPos());
+			mRecalculateVertOffset = false;
+		}
+
+		if (mScrollToItem != -1)
+		{
+			UINT32 itemIdx = std::min((UINT32)mScrollToItem, mNumItems > 0 ? mNumItems - 1 : 0);
+			if (itemIdx < mNumItems)
+			{
+				float itemTop = (float)getItemOffset(itemIdx);
+				float itemBottom = itemTop + getItemHeight(itemIdx);
+
+				if (itemTop < mVertOffset)
+					mVertOffset = itemTop;
+				else if (itemBottom > mVertOffset + mVisibleHeight)
+					mVertOffset = itemBottom - mVisibleHeight;
+			}
+
+			mScrollToItem = -1;
+		}
+
+		mVertOffset = Math::clamp(mVertOffset, 0.0f, (float)scrollableHeight);
+
+		// Find items in the visible range. Elements are assigned to them after the layout update, since that requires
+		// modifying the children and calling the item callbacks.
+		INT32 vertOffset = Math::floorToInt(mVertOffset);
+
+		mBindStart = 0;
+		mBindEnd = 0;
+		if (mNumItems > 0 && mVisibleHeight > 0)
+		{
+			UINT32 visibleTop = (UINT32)std::max(0, vertOffset - (INT32)mOverscan);
+			UINT32 visibleBottom = (UINT32)vertOffset + mVisibleHeight + mOverscan;
+
+			mBindStart = findItem(visibleTop);
+			mBindEnd = std::min(findItem(visibleBottom) + 1, mNumItems);
+		}
+
+		UINT32 boundStart, boundEnd;
+		getBoundRange(boundStart, boundEnd);
+
+		if (mBindStart != boundStart || mBindEnd != boundEnd || mRefreshItems)
+			requestBind();
+
+		// Layout bound items
+		Rect2I itemClipRect(data.area.x, data.area.y, contentWidth, mVisibleHeight);
+		itemClipRect.clip(data.clipRect);
+
+		GUILayoutData itemData = data;
+		itemData.clipRect = itemClipRect;
+
+		for (auto& entry : mBoundItems)
+		{
+			// Item was removed, its element is recycled on the next bind
+			if (entry.index >= mNumItems)
+				continue;
+
+			INT32 itemY = data.area.y + (INT32)getItemOffset(entry.index) - vertOffset;
+
+			itemData.area = Rect2I(data.area.x, itemY, contentWidth, getItemHeight(entry.index));
+			updateChildLayout(entry.element, itemData);
+		}
+
+		// Vertical scrollbar
+		{
+			Rect2I vertScrollBounds;
+			if (hasScrollbar)
+			{
+				INT32 scrollBarOffset = std::max(0, (INT32)data.area.width - (INT32)GUIScrollArea::ScrollBarWidth);
+				vertScrollBounds = Rect2I(data.area.x + scrollBarOffset, data.area.y, GUIScrollArea::ScrollBarWidth,
+					data.area.height);
+			}
+			else
+				vertScrollBounds = Rect2I(data.area.x + data.area.width, data.area.y, 0, 0);
+
+			GUILayoutData vertScrollData = data;
+			vertScrollData.area = vertScrollBounds;
+
+			vertScrollData.clipRect = vertScrollBounds;
+			vertScrollData.clipRect.clip(data.clipRect);
+
+			mVertScroll->_setLayoutData(vertScrollData);
+			mVertScroll->_updateLayoutInternal(vertScrollData);
+
+			// Set new handle size and update position to match the new size
+			float newScrollPct = 0.0f;
+			if (scrollableHeight > 0)
+				newScrollPct = mVertOffset / scrollableHeight;
+
+			mVertScroll->_setHandleSize(contentHeight > 0 ? vertScrollBounds.height / (float)contentHeight : 1.0f);
+			mVertScroll->_setScrollPos(newScrollPct);
+		}
+	}
+
+	void GUIVirtualScrollArea::vertScrollUpdate(float scrollPos)
+	{
+		UINT32 scrollableHeight = (UINT32)std::max(0, INT32(getContentHeight()) - INT32(mVisibleHeight));
+		mVertOffset = scrollableHeight * Math::clamp01(scrollPos);
+
+		_markLayoutAsDirty();
+	}
+
+	void GUIVirtualScrollArea::scrollToVertical(float pct)
+	{
+		mVertScroll->_setScrollPos(pct);
+		mRecalculateVertOffset = true;
+
+		_markLayoutAsDirty();
+	}
+
+	float GUIVirtualScrollArea::getVerticalScroll() const
+	{
+		return mVertScroll->getScrollPos();
+	}
+
+	void GUIVirtualScrollArea::scrollUpPx(UINT32 pixels)
+	{
+		UINT32 scrollableHeight = (UINT32)std::max(0, INT32(getContentHeight()) - INT32(mVisibleHeight));
+
+		float offset = 0.0f;
+		if (scrollableHeight > 0)
+			offset = pixels / (float)scrollableHeight;
+
+		mVertScroll->scroll(offset);
+	}
+
+	void GUIVirtualScrollArea::scrollDownPx(UINT32 pixels)
+	{
+		UINT32 scrollableHeight = (UINT32)std::max(0, INT32(getContentHeight()) - INT32(mVisibleHeight));
+
+		float offset = 0.0f;
+		if (scrollableHeight > 0)
+			offset = pixels / (float)scrollableHeight;
+
+		mVertScroll->scroll(-offset);
+	}
+
+	bool GUIVirtualScrollArea::_mouseEvent(const GUIMouseEvent& ev)
+	{
+		if (ev.getType() == GUIMouseEventType::MouseWheelScroll)
+		{
+			UINT32 scrollableHeight = (UINT32)std::max(0, INT32(getContentHeight()) - INT32(mVisibleHeight));
+			if (scrollableHeight == 0)
+				return false;
+
+			float additionalScroll = (float)WheelScrollAmount / scrollableHeight;
+
+			mVertScroll->scroll(additionalScroll * ev.getWheelScrollAmount());
+			return true;
+		}
+
+		return false;
+	}
+
+	GUIVirtualScrollArea* GUIVirtualScrollArea::create(const String& scrollBarStyle, const String& scrollAreaStyle)
+	{
+		return new (bs_alloc<GUIVirtualScrollArea>()) GUIVirtualScrollArea(scrollBarStyle,
+			getStyleName<GUIVirtualScrollArea>(scrollAreaStyle), GUIDimensions::create());
+	}
+
+	GUIVirtualScrollArea* GUIVirtualScrollArea::create(const GUIOptions& options, const String& scrollBarStyle,
+		const String& scrollAreaStyle)
+	{
+		return new (bs_alloc<GUIVirtualScrollArea>()) GUIVirtualScrollArea(scrollBarStyle,
+			getStyleName<GUIVirtualScrollArea>(scrollAreaStyle), GUIDimensions::create(options));
+	}
+
+	const String& GUIVirtualScrollArea::getGUITypeName()
+	{
+		// Uses the same styles as the regular scroll area
+		static String typeName = "ScrollArea";
+		return typeName;
+	}
+}
@@ -0,0 +1,247 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "GUI/BsGUIElementContainer.h"
+
+namespace bs
+{
+	/** @addtogroup GUI
+	 *  @{
+	 */
+
+	/**
+	 * A vertically scrolling GUI element container meant for displaying a large number of similar items (e.g. list
+	 * entries). Unlike GUIScrollArea it doesn't require a GUI element for each item. Instead GUI elements are only
+	 * created for items in the visible area (plus a small margin), and are recycled as the area is scrolled. This keeps
+	 * the cost of layout and rendering proportional to the visible area, rather than to the number of items.
+	 *
+	 * Items can either all have the same fixed height, or the provided height can be used as an estimate, in which case
+	 * the actual height of each item is determined from its optimal size when it first becomes visible.
+	 *
+	 * GUI elements are assigned to items after the layout of the parent widget is updated, so the item callbacks are
+	 * never called while the layout is being updated.
+	 */
+	class BS_EXPORT GUIVirtualScrollArea : public GUIElementContainer
+	{
+		/** Item that currently has a GUI element assigned to it. */
+		struct BoundItem
+		{
+			UINT32 index;
+			GUIElement* element;
+		};
+
+	public:
+		/** Callback used for creating a new GUI element that will be used for displaying items. */
+		typedef std::function<GUIElement*()> CreateItemCallback;
+
+		/**
+		 * Callback used for assigning the contents of an item with the provided index to a GUI element previously
+		 * created through CreateItemCallback. The element may have been previously used for displaying a different item.
+		 */
+		typedef std::function<void(GUIElement*, UINT32)> UpdateItemCallback;
+
+		/** Returns type name of the GUI element used for finding GUI element styles. */
+		static const String& getGUITypeName();
+
+		/**
+		 * Creates a new empty virtual scroll area.
+		 *
+		 * @param[in]	scrollBarStyle	Style used by the scroll bar.
+		 * @param[in]	scrollAreaStyle	Style used by the scroll content area.
+		 */
+		static GUIVirtualScrollArea* create(const String& scrollBarStyle = StringUtil::BLANK,
+			const String& scrollAreaStyle = StringUtil::BLANK);
+
+		/**
+		 * Creates a new empty virtual scroll area.
+		 *
+		 * @param[in]	options			Options that allow you to control how is the element positioned and sized. This will
+		 *								override any similar options set by style.
+		 * @param[in]	scrollBarStyle	Style used by the scroll bar.
+		 * @param[in]	scrollAreaStyle	Style used by the scroll content area.
+		 */
+		static GUIVirtualScrollArea* create(const GUIOptions& options, const String& scrollBarStyle = StringUtil::BLANK,
+			const String& scrollAreaStyle = StringUtil::BLANK);
+
+		/**
+		 * Sets callbacks used for creating and populating GUI elements that display the items. Must be set before the
+		 * area can display any items.
+		 */
+		void setItemCallbacks(const CreateItemCallback& create, const UpdateItemCallback& update);
+
+		/** Changes the number of items displayed by the scroll area. All visible items will be refreshed. */
+		void setNumItems(UINT32 numItems);
+
+		/** Returns the number of items displayed by the scroll area. */
+		UINT32 getNumItems() const { return mNumItems; }
+
+		/**
+		 * Sets the height of a single item, in pixels.
+		 *
+		 * @param[in]	height		Height of an item.
+		 * @param[in]	estimated	If false all items are assumed to have exactly the provided height. If true the height
+		 *							is only used for items that haven't been displayed yet, and the actual height of each
+		 *							item is determined from its optimal size once it becomes visible.
+		 */
+		void setItemHeight(UINT32 height, bool estimated = false);
+
+		/** Returns the fixed or estimated height of a single item, in pixels. */
+		UINT32 getItemHeight() const { return mItemHeight; }
+
+		/**
+		 * Determines how many pixels above and below the visible area should also have GUI elements assigned. Larger
+		 * values reduce the number of elements that need to be updated when scrolling in small increments.
+		 */
+		void setOverscan(UINT32 pixels);
+
+		/** Re-populates the GUI elements of all visible items by calling the update callback. */
+		void refreshItems();
+
+		/** Re-populates the GUI element of the item with the specified index, if it is visible. */
+		void refreshItem(UINT32 idx);
+
+		/** Scrolls the area so that the item with the specified index is visible. */
+		void scrollToItem(UINT32 idx);
+
+		/**	Scrolls the area up by specified amount of pixels, if possible. */
+		void scrollUpPx(UINT32 pixels);
+
+		/**	Scrolls the area down by specified amount of pixels, if possible. */
+		void scrollDownPx(UINT32 pixels);
+
+		/**
+		 * Scrolls the contents to the specified position (0 meaning top-most part of the content is visible, and 1 meaning
+		 * bottom-most part is visible).
+		 */
+		void scrollToVertical(float pct);
+
+		/**
+		 * Returns how much is the scroll area scrolled in the vertical direction. Returned value represents percentage
+		 * where 0 means no scrolling is happening, and 1 means area is fully scrolled to the bottom.
+		 */
+		float getVerticalScroll() const;
+
+		/**
+		 * Returns the range of items that currently have GUI elements assigned to them, as a [start, end) range. Includes
+		 * items in the overscan area.
+		 */
+		void getBoundRange(UINT32& start, UINT32& end) const;
+
+		/**
+		 * Returns the GUI element currently assigned to the item with the specified index, or null if the item doesn't
+		 * have an element assigned.
+		 */
+		GUIElement* getItemElement(UINT32 idx) const;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Assigns GUI elements to the items in the visible area, as determined by the last layout update. Normally called
+		 * by the parent widget after its layout is updated.
+		 */
+		void _postLayoutUpdate() override;
+
+		/** @copydoc GUIElementContainer::_getElementType */
+		ElementType _getElementType() const override { return ElementType::ScrollArea; }
+
+		/** @} */
+	protected:
+		~GUIVirtualScrollArea() = default;
+
+		/** @copydoc GUIElementContainer::_getLayoutSizeRange */
+		LayoutSizeRange _getLayoutSizeRange() const override;
+
+		/** @copydoc GUIElementContainer::updateClippedBounds */
+		void updateClippedBounds() override;
+
+		/** @copydoc GUIElementBase::_calculateLayoutSizeRange */
+		LayoutSizeRange _calculateLayoutSizeRange() const override;
+
+		/** @copydoc GUIElementBase::_updateOptimalLayoutSizes */
+		void _updateOptimalLayoutSizes() override;
+
+		/** @copydoc GUIElementContainer::_getOptimalSize */
+		Vector2I _getOptimalSize() const override;
+
+	private:
+		GUIVirtualScrollArea(const String& scrollBarStyle, const String& scrollAreaStyle, const GUIDimensions& dimensions);
+
+		/** @copydoc GUIElementContainer::_mouseEvent */
+		bool _mouseEvent(const GUIMouseEvent& ev) override;
+
+		/** @copydoc GUIElementContainer::_updateLayoutInternal */
+		void _updateLayoutInternal(const GUILayoutData& data) override;
+
+		/**
+		 * Called when the vertical scrollbar moves.
+		 *
+		 * @param[in]	pct	Scrollbar position ranging [0, 1].
+		 */
+		void vertScrollUpdate(float pct);
+
+		/**
+		 * Assigns GUI elements to all items in the [start, end) range, recycling elements of items outside of the range.
+		 * If @p refresh is true, all items are re-populated even if they already had an element assigned.
+		 */
+		void bindItems(UINT32 start, UINT32 end, bool refresh);
+
+		/** Requests a call to _postLayoutUpdate() from the parent widget, so the items can be re-bound. */
+		void requestBind();
+
+		/** Returns the height of the item with the specified index, in pixels. */
+		UINT32 getItemHeight(UINT32 idx) const;
+
+		/** Returns the offset of the top of the item with the specified index, relative to the top of the content. */
+		UINT32 getItemOffset(UINT32 idx) const;
+
+		/** Returns the index of the item at the specified offset relative to the top of the content. */
+		UINT32 findItem(UINT32 offset) const;
+
+		/** Returns the height of all the items combined, in pixels. */
+		UINT32 getContentHeight() const;
+
+		/** Records a measured item height and updates the tree used for offset queries. */
+		void setMeasuredHeight(UINT32 idx, UINT32 height);
+
+		/** Rebuilds the tree used for offset queries from the individual item heights. */
+		void rebuildHeightTree();
+
+		GUIScrollBarVert* mVertScroll;
+		CreateItemCallback mCreateCallback;
+		UpdateItemCallback mUpdateCallback;
+
+		UINT32 mNumItems = 0;
+		UINT32 mItemHeight = 20;
+		UINT32 mOverscan = 0;
+		bool mEstimateHeights = false;
+		bool mRefreshItems = false;
+
+		// Only populated when heights are estimated. Heights are stored in a binary indexed tree so that offset and item
+		// lookups remain logarithmic regardless of the number of items.
+		Vector<UINT32> mItemHeights;
+		Vector<UINT32> mHeightTree;
+
+		Vector<BoundItem> mBoundItems;
+		Vector<GUIElement*> mFreeElements;
+
+		// Range of items that need to have elements assigned, as determined by the last layout update
+		UINT32 mBindStart = 0;
+		UINT32 mBindEnd = 0;
+
+		float mVertOffset = 0.0f;
+		bool mRecalculateVertOffset = false;
+		INT32 mScrollToItem = -1;
+		UINT32 mVisibleHeight = 0;
+		UINT32 mOptimalItemWidth = 0;
+
+		LayoutSizeRange mSizeRange;
+
+		static const UINT32 WheelScrollAmount;
+	};
+
+	/** @} */
+}
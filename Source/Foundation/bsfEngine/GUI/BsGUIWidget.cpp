@@ -14,6 +14,8 @@
 
 namespace bs
 {
+	const UINT32 GUIWidget::MAX_POST_LAYOUT_PASSES = 4;
+
 	GUIWidget::GUIWidget(const SPtr<Camera>& camera)
 		: mCamera(camera), mPanel(nullptr), mDepth(128), mIsActive(true), mPosition(BsZero), mRotation(BsIdentity)
 		, mScale(Vector3::ONE), mTransform(BsIdentity), mCachedRTId(0), mWidgetIsDirty(false)
@@ -83,6 +85,7 @@ namespace bs
 
 		mElements.clear();
 		mDirtyContents.clear();
+		mPostLayoutElements.clear();
 	}
 
 	void GUIWidget::setDepth(UINT8 depth)
@@ -122,7 +125,7 @@ namespace bs
 					mWidgetIsDirty = true;
 				else
 				{
-					if(Math::approxEquals(mScale, scale))
+					if(!Math::approxEquals(mScale, scale))
 						mWidgetIsDirty = true;
 				}
 			}
@@ -158,12 +161,36 @@ namespace bs
 	}
 
 	void GUIWidget::_updateLayout()
+	{
+		updateDirtyLayouts();
+
+		// Elements that modify their children depending on their layout do so once the layout is done, after which the
+		// layout needs to be updated again. Limit the number of passes in case the elements keep requesting updates, any
+		// remaining requests are handled on the next update.
+		for (UINT32 i = 0; i < MAX_POST_LAYOUT_PASSES && !mPostLayoutElements.empty(); i++)
+		{
+			Set<GUIElement*> elements;
+			std::swap(elements, mPostLayoutElements);
+
+			for (auto& element : elements)
+			{
+				if (!element->_isDestroyed())
+					element->_postLayoutUpdate();
+			}
+
+			updateDirtyLayouts();
+		}
+	}
+
+	void GUIWidget::updateDirtyLayouts()
 	{
 		bs_frame_mark();
 
-		// Determine dirty contents and layouts
+		// Determine dirty contents and layouts. Only branches containing elements marked as dirty since the last update
+		// need to be searched.
 		FrameStack<GUIElementBase*> todo;
-		todo.push(mPanel);
+		if (mPanel->_isLayoutDirty())
+			todo.push(mPanel);
 
 		while (!todo.empty())
 		{
@@ -182,9 +209,17 @@ namespace bs
 			}
 			else
 			{
+				// Layout of this element is not affected by its dirty children (they have their own update parents),
+				// so it can be marked as clean once the children are processed
+				currentElem->_markAsClean();
+
 				UINT32 numChildren = currentElem->_getNumChildren();
 				for (UINT32 i = 0; i < numChildren; i++)
-					todo.push(currentElem->_getChild(i));
+				{
+					GUIElementBase* child = currentElem->_getChild(i);
+					if (child->_isLayoutDirty())
+						todo.push(child);
+				}
 			}
 		}
 
@@ -227,7 +262,8 @@ namespace bs
 			updateParent->_updateLayout(childLayoutData);
 		}
 		
-		// Mark dirty contents
+		// Mark updated elements as clean. Elements whose layout changed will have marked their contents as dirty during
+		// the update, while the branches that weren't dirty were skipped and don't need to be visited.
 		bs_frame_mark();
 		{
 			FrameStack<GUIElementBase*> todo;
@@ -238,14 +274,15 @@ namespace bs
 				GUIElementBase* currentElem = todo.top();
 				todo.pop();
 
-				if (currentElem->_getType() == GUIElementBase::Type::Element)
-					mDirtyContents.insert(static_cast<GUIElement*>(currentElem));
-
 				currentElem->_markAsClean();
 
 				UINT32 numChildren = currentElem->_getNumChildren();
 				for (UINT32 i = 0; i < numChildren; i++)
-					todo.push(currentElem->_getChild(i));
+				{
+					GUIElementBase* child = currentElem->_getChild(i);
+					if (child->_isLayoutDirty())
+						todo.push(child);
+				}
 			}
 		}
 		bs_frame_clear();
@@ -275,7 +312,10 @@ namespace bs
 		}
 
 		if (elem->_getType() == GUIElementBase::Type::Element)
+		{
 			mDirtyContents.erase(static_cast<GUIElement*>(elem));
+			mPostLayoutElements.erase(static_cast<GUIElement*>(elem));
+		}
 	}
 
 	void GUIWidget::_markMeshDirty(GUIElementBase* elem)
@@ -283,6 +323,11 @@ namespace bs
 		mWidgetIsDirty = true;
 	}
 
+	void GUIWidget::_requestPostLayoutUpdate(GUIElement* elem)
+	{
+		mPostLayoutElements.insert(elem);
+	}
+
 	void GUIWidget::_markContentDirty(GUIElementBase* elem)
 	{
 		if (elem->_getType() == GUIElementBase::Type::Element)
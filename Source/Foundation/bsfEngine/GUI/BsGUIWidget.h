@@ -133,12 +133,27 @@ namespace bs
 		 */
 		void _markContentDirty(GUIElementBase* elem);
 
+		/** 
+		 * Returns true if the set of elements in the widget, or their placement, changed since the last call to
+		 * isDirty(true). 
+		 */
+		bool _isMeshDirty() const { return mWidgetIsDirty; }
+
+		/** Returns a list of elements whose contents changed since the last call to isDirty(true). */
+		const Set<GUIElement*>& _getDirtyContents() const { return mDirtyContents; }
+
 		/**	Updates the layout of all child elements, repositioning and resizing them as needed. */
 		void _updateLayout();
 
 		/**	Updates the layout of the provided element, and queues content updates. */
 		void _updateLayout(GUIElementBase* elem);
 
+		/**
+		 * Queues a call to GUIElement::_postLayoutUpdate() for the provided element, once the layout of the widget is
+		 * updated. Any layout changes made by the element are then processed during the same update.
+		 */
+		void _requestPostLayoutUpdate(GUIElement* elem);
+
 		/**
 		 * Updates internal transform values from the specified scene object, in case that scene object's transform changed
 		 * since the last call.
@@ -185,6 +200,9 @@ namespace bs
 		/**	Updates the size of the primary GUI panel based on the viewport. */
 		void updateRootPanel();
 
+		/** Updates the layout of all branches containing elements marked as dirty. */
+		void updateDirtyLayouts();
+
 		SPtr<Camera> mCamera;
 		Vector<GUIElement*> mElements;
 		GUIPanel* mPanel;
@@ -200,6 +218,9 @@ namespace bs
 		HEvent mOwnerTargetResizedConn;
 
 		Set<GUIElement*> mDirtyContents;
+		Set<GUIElement*> mPostLayoutElements;
+
+		static const UINT32 MAX_POST_LAYOUT_PASSES;
 
 		mutable UINT64 mCachedRTId;
 		mutable bool mWidgetIsDirty;
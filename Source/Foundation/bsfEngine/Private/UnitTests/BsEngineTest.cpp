@@ -0,0 +1,588 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+#include "GUI/BsGUIMeshGroupUtility.h"
+#include "GUI/BsGUILayoutX.h"
+#include "GUI/BsGUILayoutY.h"
+#include "GUI/BsGUIVirtualScrollArea.h"
+#include "GUI/BsGUIElementContainer.h"
+#include "2D/BsTextLayoutCache.h"
+#include "Resources/BsResources.h"
+#include "Localization/BsStringTableManager.h"
+#include "CoreThread/BsCoreObjectManager.h"
+
+namespace bs
+{
+	/**
+	 * Creates the grouping state of a GUI render element. Element and widget pointers are only used as identifiers by
+	 * GUIMeshGroupUtility, so tests can use arbitrary addresses.
+	 */
+	GUIMeshElement createMeshElement(UINT8* element, UINT32 renderElement, UINT32 depth, UINT64 mergeHash,
+		const Rect2I& bounds, UINT32 numVertices = 4)
+	{
+		GUIMeshElement output;
+		output.element = (GUIElement*)element;
+		output.widget = nullptr;
+		output.renderElement = renderElement;
+		output.depth = depth;
+		output.numVertices = numVertices;
+		output.numIndices = numVertices / 2 * 3;
+		output.meshType = GUIMeshType::Triangle;
+		output.mergeHash = mergeHash;
+		output.bounds = bounds;
+
+		return output;
+	}
+
+	/** GUI element with a configurable optimal size, that counts how many times its layout was updated. */
+	class TestGUILeaf : public GUIElementBase
+	{
+	public:
+		TestGUILeaf(const Vector2I& optimalSize)
+			:GUIElementBase(GUIDimensions::create()), mOptimalSize(optimalSize)
+		{ }
+
+		/** Changes the optimal size of the element and marks its layout as dirty. */
+		void setOptimalSize(const Vector2I& optimalSize)
+		{
+			mOptimalSize = optimalSize;
+			_markLayoutAsDirty();
+		}
+
+		Vector2I _getOptimalSize() const override { return mOptimalSize; }
+		const RectOffset& _getPadding() const override { return mPadding; }
+		Type _getType() const override { return Type::Layout; }
+
+		void _updateLayoutInternal(const GUILayoutData& data) override
+		{
+			numLayoutUpdates++;
+			GUIElementBase::_updateLayoutInternal(data);
+		}
+
+		UINT32 numLayoutUpdates = 0;
+
+	private:
+		Vector2I mOptimalSize;
+		RectOffset mPadding;
+	};
+
+	/** GUI layout that counts how many times it calculated the areas of its children. */
+	template<class T>
+	class TestGUILayout : public T
+	{
+	public:
+		void _getElementAreas(const Rect2I& layoutArea, Rect2I* elementAreas, UINT32 numElements,
+			const Vector<LayoutSizeRange>& sizeRanges, const LayoutSizeRange& mySizeRange) const override
+		{
+			numAreaUpdates++;
+			T::_getElementAreas(layoutArea, elementAreas, numElements, sizeRanges, mySizeRange);
+		}
+
+		mutable UINT32 numAreaUpdates = 0;
+	};
+
+	/** Updates the layout of the provided root element, and marks the updated elements as clean, same as GUIWidget. */
+	void updateLayout(GUIElementBase* root)
+	{
+		root->_updateLayout(root->_getLayoutData());
+
+		Stack<GUIElementBase*> todo;
+		todo.push(root);
+
+		while (!todo.empty())
+		{
+			GUIElementBase* currentElem = todo.top();
+			todo.pop();
+
+			currentElem->_markAsClean();
+
+			for (UINT32 i = 0; i < currentElem->_getNumChildren(); i++)
+			{
+				GUIElementBase* child = currentElem->_getChild(i);
+				if (child->_isLayoutDirty())
+					todo.push(child);
+			}
+		}
+	}
+
+	/** GUI element with a configurable height, used for displaying items of a virtual scroll area. */
+	class TestGUIItem : public GUIElementContainer
+	{
+	public:
+		TestGUIItem()
+			:GUIElementContainer(GUIDimensions::create())
+		{ }
+
+		/** Changes the height of the element and marks its layout as dirty. */
+		void setHeight(UINT32 height)
+		{
+			mHeight = height;
+			_markLayoutAsDirty();
+		}
+
+		Vector2I _getOptimalSize() const override { return Vector2I(50, (INT32)mHeight); }
+
+		UINT32 index = (UINT32)-1;
+
+	private:
+		UINT32 mHeight = 20;
+	};
+
+	/**
+	 * Updates the layout of a virtual scroll area, and lets it assign elements to the visible items after each layout
+	 * update, same as GUIWidget.
+	 */
+	void updateVirtualScrollArea(GUIVirtualScrollArea* area)
+	{
+		updateLayout(area);
+
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			area->_postLayoutUpdate();
+			updateLayout(area);
+		}
+	}
+
+	/** Deletes a GUI element hierarchy immediately, as GUIManager that normally destroys GUI elements isn't running. */
+	void deleteGUIElements(GUIElementBase* element)
+	{
+		while (element->_getNumChildren() > 0)
+		{
+			GUIElementBase* child = element->_getChild(element->_getNumChildren() - 1);
+			element->_unregisterChildElement(child);
+
+			deleteGUIElements(child);
+		}
+
+		bs_delete(element);
+	}
+
+	class EngineTestSuite : public TestSuite
+	{
+	public:
+		EngineTestSuite();
+
+	private:
+		void testGUIMeshGroups();
+		void testGUILayoutDirtyPropagation();
+		void testTextLayoutCache();
+		void testGUIVirtualScrollArea();
+	};
+
+	EngineTestSuite::EngineTestSuite()
+	{
+		BS_ADD_TEST(EngineTestSuite::testGUIMeshGroups);
+		BS_ADD_TEST(EngineTestSuite::testGUILayoutDirtyPropagation);
+		BS_ADD_TEST(EngineTestSuite::testTextLayoutCache);
+		BS_ADD_TEST(EngineTestSuite::testGUIVirtualScrollArea);
+	}
+
+	void EngineTestSuite::testGUIMeshGroups()
+	{
+		bs_frame_mark();
+		{
+			// Background panel, two labels on top of it, and an image with the same material as the background overlapping
+			// the first label
+			UINT8 elementIds[4];
+			UINT8* background = &elementIds[0];
+			UINT8* labelA = &elementIds[1];
+			UINT8* labelB = &elementIds[2];
+			UINT8* image = &elementIds[3];
+
+			FrameVector<GUIMeshElement> renderElements;
+			renderElements.push_back(createMeshElement(labelB, 0, 2, 2, Rect2I(40, 10, 20, 20)));
+			renderElements.push_back(createMeshElement(image, 0, 1, 1, Rect2I(10, 10, 20, 20)));
+			renderElements.push_back(createMeshElement(background, 0, 3, 1, Rect2I(0, 0, 100, 100)));
+			renderElements.push_back(createMeshElement(labelA, 0, 2, 2, Rect2I(10, 10, 20, 20)));
+
+			Vector<GUIMeshElement> elements;
+			Vector<GUIMeshGroup> groups;
+			GUIMeshGroupUtility::group(renderElements, false, elements, groups);
+
+			auto getGroupDepth = [](const Vector<GUIMeshElement>& elements, const GUIMeshGroup& group)
+			{
+				return elements[group.elementStart].depth;
+			};
+
+			auto findGroup = [](const Vector<GUIMeshElement>& elements, const Vector<GUIMeshGroup>& groups, UINT8* element)
+			{
+				for(UINT32 i = 0; i < (UINT32)groups.size(); i++)
+				{
+					for(UINT32 j = 0; j < groups[i].numElements; j++)
+					{
+						if(elements[groups[i].elementStart + j].element == (GUIElement*)element)
+							return i;
+					}
+				}
+
+				return (UINT32)-1;
+			};
+
+			// Labels share a group, while the image can't join the background since the label is in between them
+			BS_TEST_ASSERT(groups.size() == 3);
+			BS_TEST_ASSERT(findGroup(elements, groups, labelA) == findGroup(elements, groups, labelB));
+			BS_TEST_ASSERT(findGroup(elements, groups, background) != findGroup(elements, groups, image));
+
+			for(UINT32 i = 1; i < (UINT32)groups.size(); i++)
+				BS_TEST_ASSERT(getGroupDepth(elements, groups[i - 1]) > getGroupDepth(elements, groups[i]));
+
+			for(auto& group : groups)
+			{
+				for(UINT32 i = 0; i < group.numElements; i++)
+					BS_TEST_ASSERT(elements[group.elementStart + i].mergeHash == elements[group.elementStart].mergeHash);
+			}
+
+			const UINT32 backgroundGroup = findGroup(elements, groups, background);
+			const UINT32 labelGroup = findGroup(elements, groups, labelB);
+			const UINT32 imageGroup = findGroup(elements, groups, image);
+
+			// Changing the contents of a label without affecting its grouping only dirties the group of that label
+			FrameUnorderedSet<GUIElement*> dirtyElements = { (GUIElement*)labelB };
+			FrameVector<GUIMeshElement> dirtyRenderElements =
+				{ createMeshElement(labelB, 0, 2, 2, Rect2I(40, 10, 20, 20), 8) };
+
+			FrameVector<UINT32> dirtyGroups;
+			BS_TEST_ASSERT(GUIMeshGroupUtility::findDirtyGroups(elements, groups, dirtyElements, dirtyRenderElements,
+				dirtyGroups));
+			BS_TEST_ASSERT(dirtyGroups.size() == 1 && dirtyGroups[0] == labelGroup);
+
+			for(UINT32 i = 0; i < groups[labelGroup].numElements; i++)
+			{
+				const GUIMeshElement& entry = elements[groups[labelGroup].elementStart + i];
+				const UINT32 expectedNumVertices = entry.element == (GUIElement*)labelB ? 8 : 4;
+				BS_TEST_ASSERT(entry.numVertices == expectedNumVertices);
+			}
+
+			// Moving a label in front of the image requires regrouping
+			dirtyRenderElements = { createMeshElement(labelB, 0, 0, 2, Rect2I(40, 10, 20, 20), 8) };
+			dirtyGroups.clear();
+			BS_TEST_ASSERT(!GUIMeshGroupUtility::findDirtyGroups(elements, groups, dirtyElements, dirtyRenderElements,
+				dirtyGroups));
+
+			// Hiding a label (no render elements) requires regrouping as well
+			dirtyRenderElements.clear();
+			dirtyGroups.clear();
+			BS_TEST_ASSERT(!GUIMeshGroupUtility::findDirtyGroups(elements, groups, dirtyElements, dirtyRenderElements,
+				dirtyGroups));
+
+			// After regrouping, groups without the moved label keep their meshes as is, and stay in the same order
+			for(auto& entry : renderElements)
+			{
+				if(entry.element == (GUIElement*)labelB)
+					entry = createMeshElement(labelB, 0, 0, 2, Rect2I(40, 10, 20, 20), 8);
+			}
+
+			Vector<GUIMeshElement> newElements;
+			Vector<GUIMeshGroup> newGroups;
+			GUIMeshGroupUtility::group(renderElements, false, newElements, newGroups);
+
+			FrameVector<UINT32> prevGroups;
+			FrameVector<bool> isIdentical;
+			GUIMeshGroupUtility::matchGroups(elements, groups, newElements, newGroups, dirtyElements, prevGroups,
+				isIdentical);
+
+			BS_TEST_ASSERT(newGroups.size() == 4);
+
+			for(UINT32 i = 1; i < (UINT32)newGroups.size(); i++)
+				BS_TEST_ASSERT(getGroupDepth(newElements, newGroups[i - 1]) > getGroupDepth(newElements, newGroups[i]));
+
+			const UINT32 newBackgroundGroup = findGroup(newElements, newGroups, background);
+			const UINT32 newImageGroup = findGroup(newElements, newGroups, image);
+			const UINT32 newLabelAGroup = findGroup(newElements, newGroups, labelA);
+			const UINT32 newLabelBGroup = findGroup(newElements, newGroups, labelB);
+
+			BS_TEST_ASSERT(isIdentical[newBackgroundGroup] && prevGroups[newBackgroundGroup] == backgroundGroup);
+			BS_TEST_ASSERT(isIdentical[newImageGroup] && prevGroups[newImageGroup] == imageGroup);
+			BS_TEST_ASSERT(!isIdentical[newLabelAGroup]);
+			BS_TEST_ASSERT(!isIdentical[newLabelBGroup]);
+
+			BS_TEST_ASSERT(newBackgroundGroup < newLabelAGroup && newLabelAGroup < newImageGroup);
+			BS_TEST_ASSERT(newImageGroup < newLabelBGroup);
+		}
+		bs_frame_clear();
+	}
+
+	void EngineTestSuite::testGUILayoutDirtyPropagation()
+	{
+		// Two rows, first one with two elements and second one with a single element
+		auto root = bs_new<TestGUILayout<GUILayoutY>>();
+		auto rowA = bs_new<TestGUILayout<GUILayoutX>>();
+		auto rowB = bs_new<TestGUILayout<GUILayoutX>>();
+		root->addElement(rowA);
+		root->addElement(rowB);
+
+		TestGUILeaf leafA1(Vector2I(50, 20));
+		TestGUILeaf leafA2(Vector2I(50, 20));
+		TestGUILeaf leafB(Vector2I(50, 20));
+		rowA->addElement(&leafA1);
+		rowA->addElement(&leafA2);
+		rowB->addElement(&leafB);
+
+		GUILayoutData rootData;
+		rootData.area = Rect2I(0, 0, 300, 200);
+		rootData.clipRect = rootData.area;
+		root->_setLayoutData(rootData);
+
+		updateLayout(root);
+
+		auto resetCounters = [&]()
+		{
+			root->numAreaUpdates = rowA->numAreaUpdates = rowB->numAreaUpdates = 0;
+			leafA1.numLayoutUpdates = leafA2.numLayoutUpdates = leafB.numLayoutUpdates = 0;
+		};
+
+		// Change that doesn't affect the element size only needs to update the element and its immediate parent
+		resetCounters();
+		leafA1.setOptimalSize(Vector2I(50, 20));
+
+		BS_TEST_ASSERT(rowA->_isSizeDirty() && !root->_isSizeDirty());
+		BS_TEST_ASSERT(root->_isLayoutDirty() && !rowB->_isLayoutDirty());
+
+		updateLayout(root);
+
+		BS_TEST_ASSERT(leafA1.numLayoutUpdates == 1);
+		BS_TEST_ASSERT(leafA2.numLayoutUpdates == 0 && leafB.numLayoutUpdates == 0);
+		BS_TEST_ASSERT(rowA->numAreaUpdates == 1);
+		BS_TEST_ASSERT(root->numAreaUpdates == 0 && rowB->numAreaUpdates == 0);
+		BS_TEST_ASSERT(!root->_isLayoutDirty() && !rowA->_isLayoutDirty() && !rowA->_isSizeDirty());
+
+		// Size change propagates to the parents whose size changes, but leaves other rows as is
+		resetCounters();
+		leafA1.setOptimalSize(Vector2I(80, 20));
+		updateLayout(root);
+
+		BS_TEST_ASSERT(rowA->_getCachedSizeRange().optimal == Vector2I(130, 20));
+		BS_TEST_ASSERT(root->_getCachedSizeRange().optimal == Vector2I(130, 40));
+		BS_TEST_ASSERT(rowA->numAreaUpdates == 1 && root->numAreaUpdates == 1);
+		BS_TEST_ASSERT(rowB->numAreaUpdates == 0 && leafB.numLayoutUpdates == 0);
+
+		// Hidden elements update their own size, but parents are only notified once the element is visible
+		leafB.setVisible(false);
+		updateLayout(root);
+
+		resetCounters();
+		leafB.setOptimalSize(Vector2I(100, 40));
+
+		BS_TEST_ASSERT(leafB._isSizeDirty());
+		BS_TEST_ASSERT(!rowB->_isSizeDirty() && !rowB->_isLayoutDirty());
+
+		leafB.setVisible(true);
+		updateLayout(root);
+
+		BS_TEST_ASSERT(rowB->_getCachedSizeRange().optimal == Vector2I(100, 40));
+		BS_TEST_ASSERT(root->_getCachedSizeRange().optimal == Vector2I(130, 60));
+		BS_TEST_ASSERT(leafB.numLayoutUpdates == 1);
+
+		rowA->removeElement(&leafA1);
+		rowA->removeElement(&leafA2);
+		rowB->removeElement(&leafB);
+		GUILayout::destroy(root);
+	}
+
+	void EngineTestSuite::testTextLayoutCache()
+	{
+		TextLayoutCache cache(2);
+
+		TEXT_SPRITE_DESC desc;
+		desc.text = "Hello";
+		desc.fontSize = 12;
+		desc.width = 100;
+
+		// Same text, font, size and width returns the cached layout
+		SPtr<const TextLayout> layout = cache.getLayout(desc);
+		BS_TEST_ASSERT(layout != nullptr);
+		BS_TEST_ASSERT(cache.getLayout(desc) == layout);
+
+		// Color doesn't influence the layout
+		desc.color = Color::Red;
+		BS_TEST_ASSERT(cache.getLayout(desc) == layout);
+
+		// Different width requires a new layout, while the previous one remains cached
+		TEXT_SPRITE_DESC wideDesc = desc;
+		wideDesc.width = 200;
+
+		SPtr<const TextLayout> wideLayout = cache.getLayout(wideDesc);
+		BS_TEST_ASSERT(wideLayout != nullptr && wideLayout != layout);
+		BS_TEST_ASSERT(cache.getLayout(wideDesc) == wideLayout);
+		BS_TEST_ASSERT(cache.getLayout(desc) == layout);
+
+		// Once the cache is full, the least recently used layout is evicted
+		TEXT_SPRITE_DESC otherDesc = desc;
+		otherDesc.text = "World";
+
+		SPtr<const TextLayout> otherLayout = cache.getLayout(otherDesc);
+		BS_TEST_ASSERT(otherLayout != layout && otherLayout != wideLayout);
+		BS_TEST_ASSERT(cache.getLayout(desc) == layout);
+		BS_TEST_ASSERT(cache.getLayout(otherDesc) == otherLayout);
+
+		SPtr<const TextLayout> newWideLayout = cache.getLayout(wideDesc);
+		BS_TEST_ASSERT(newWideLayout != wideLayout);
+
+		// Regenerating the evicted layout evicted the least recently used one in turn
+		BS_TEST_ASSERT(cache.getLayout(otherDesc) == otherLayout);
+		BS_TEST_ASSERT(cache.getLayout(desc) != layout);
+
+		// Layouts that are still referenced remain valid after eviction or clearing
+		cache.clear();
+		BS_TEST_ASSERT(wideLayout->pages.empty() && layout->pages.empty());
+		BS_TEST_ASSERT(cache.getLayout(otherDesc) != otherLayout);
+
+#if BS_PROFILING_ENABLED
+		// Cache hits don't allocate, even for text too long to be stored inline in a string
+		TEXT_SPRITE_DESC longDesc = desc;
+		longDesc.text = "Text long enough to require its own allocation when copied";
+
+		SPtr<const TextLayout> longLayout = cache.getLayout(longDesc);
+
+		// Assertions allocate the names of the function and the file, so the result is only checked afterwards
+		const UINT64 numAllocs = MemoryCounter::getNumAllocs();
+		const bool isHit = cache.getLayout(longDesc) == longLayout;
+		const UINT64 numHitAllocs = MemoryCounter::getNumAllocs() - numAllocs;
+
+		BS_TEST_ASSERT(isHit);
+		BS_TEST_ASSERT(numHitAllocs == 0);
+#endif
+	}
+
+	void EngineTestSuite::testGUIVirtualScrollArea()
+	{
+		static constexpr UINT32 NUM_ITEMS = 10000;
+		static constexpr UINT32 ITEM_HEIGHT = 20;
+		static constexpr UINT32 AREA_HEIGHT = 200;
+
+		// At most one partially visible item above and below the fully visible ones
+		static constexpr UINT32 MAX_BOUND_ITEMS = AREA_HEIGHT / ITEM_HEIGHT + 1;
+
+		// Scroll bar buttons use localized strings, whose string tables are resources
+		CoreObjectManager::startUp();
+		Resources::startUp();
+		StringTableManager::startUp();
+
+		GUIVirtualScrollArea* area = GUIVirtualScrollArea::create();
+
+		UINT32 numCreated = 0;
+		UINT32 numUpdated = 0;
+		area->setItemCallbacks(
+			[&numCreated]() -> GUIElement*
+			{
+				numCreated++;
+				return new (bs_alloc<TestGUIItem>()) TestGUIItem();
+			},
+			[&numUpdated](GUIElement* element, UINT32 idx)
+			{
+				numUpdated++;
+
+				TestGUIItem* item = static_cast<TestGUIItem*>(element);
+				item->index = idx;
+				item->setHeight(idx % 2 == 0 ? ITEM_HEIGHT : ITEM_HEIGHT * 2);
+			});
+
+		area->setNumItems(NUM_ITEMS);
+		area->setItemHeight(ITEM_HEIGHT);
+
+		GUILayoutData areaData;
+		areaData.area = Rect2I(0, 0, 300, AREA_HEIGHT);
+		areaData.clipRect = areaData.area;
+		area->_setLayoutData(areaData);
+
+		// Layout update only determines the visible items, without modifying the area or calling the callbacks
+		updateLayout(area);
+
+		UINT32 boundStart, boundEnd;
+		area->getBoundRange(boundStart, boundEnd);
+		BS_TEST_ASSERT(boundStart == 0 && boundEnd == 0);
+		BS_TEST_ASSERT(numCreated == 0 && numUpdated == 0);
+
+		// Elements are assigned after the layout update, and only for the visible items
+		updateVirtualScrollArea(area);
+
+		area->getBoundRange(boundStart, boundEnd);
+		BS_TEST_ASSERT(boundStart == 0 && boundEnd == MAX_BOUND_ITEMS);
+		BS_TEST_ASSERT(numCreated == MAX_BOUND_ITEMS && numUpdated == MAX_BOUND_ITEMS);
+
+		TestGUIItem* item = static_cast<TestGUIItem*>(area->getItemElement(3));
+		BS_TEST_ASSERT(item != nullptr && item->index == 3);
+		BS_TEST_ASSERT(item != nullptr && item->_getLayoutData().area.y == (INT32)(3 * ITEM_HEIGHT));
+		BS_TEST_ASSERT(area->getItemElement(MAX_BOUND_ITEMS) == nullptr);
+
+		// Scroll through the entire list, only the items that become visible are updated and elements are recycled
+		for (UINT32 i = 0; i < NUM_ITEMS; i += 7)
+		{
+			numUpdated = 0;
+
+			area->scrollToItem(i);
+			updateVirtualScrollArea(area);
+
+			area->getBoundRange(boundStart, boundEnd);
+			BS_TEST_ASSERT(boundStart <= i && i < boundEnd);
+			BS_TEST_ASSERT(boundEnd - boundStart <= MAX_BOUND_ITEMS);
+			BS_TEST_ASSERT(numUpdated <= 8);
+
+			item = static_cast<TestGUIItem*>(area->getItemElement(i));
+			BS_TEST_ASSERT(item != nullptr && item->index == i);
+
+			if (item != nullptr)
+			{
+				const Rect2I& itemArea = item->_getLayoutData().area;
+				BS_TEST_ASSERT(itemArea.y >= 0 && itemArea.y + (INT32)itemArea.height <= (INT32)AREA_HEIGHT);
+			}
+		}
+
+		BS_TEST_ASSERT(numCreated <= MAX_BOUND_ITEMS + 1);
+
+		// Last item is aligned with the bottom of the area
+		area->scrollToItem(NUM_ITEMS - 1);
+		updateVirtualScrollArea(area);
+
+		area->getBoundRange(boundStart, boundEnd);
+		BS_TEST_ASSERT(boundEnd == NUM_ITEMS);
+
+		item = static_cast<TestGUIItem*>(area->getItemElement(NUM_ITEMS - 1));
+		BS_TEST_ASSERT(item != nullptr && item->_getLayoutData().area.y == (INT32)(AREA_HEIGHT - ITEM_HEIGHT));
+
+		// Items measured from their elements, odd items being twice as tall
+		area->setItemHeight(ITEM_HEIGHT, true);
+		area->scrollToItem(0);
+		updateVirtualScrollArea(area);
+
+		item = static_cast<TestGUIItem*>(area->getItemElement(3));
+		BS_TEST_ASSERT(item != nullptr && item->_getLayoutData().area.y == (INT32)(4 * ITEM_HEIGHT));
+		BS_TEST_ASSERT(item != nullptr && item->_getLayoutData().area.height == ITEM_HEIGHT * 2);
+
+		// Items up to and including the one starting at the bottom edge of the area
+		area->getBoundRange(boundStart, boundEnd);
+		BS_TEST_ASSERT(boundStart == 0 && boundEnd == 8);
+
+		// Removing items recycles the elements of the removed items
+		numCreated = 0;
+		area->setNumItems(5);
+		updateVirtualScrollArea(area);
+
+		area->getBoundRange(boundStart, boundEnd);
+		BS_TEST_ASSERT(boundStart == 0 && boundEnd == 5);
+		BS_TEST_ASSERT(numCreated == 0);
+
+		deleteGUIElements(area);
+
+		StringTableManager::shutDown();
+		Resources::shutDown();
+		CoreObjectManager::shutDown();
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	// Some of the tested systems use the stack allocator, normally set up by the application
+	MemStack::beginThread();
+
+	SPtr<TestSuite> tests = EngineTestSuite::create<EngineTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	MemStack::endThread();
+	return 0;
+}
@@ -22,16 +22,18 @@ namespace bs { namespace ct
 		mSortableElements.clear();
 		mSortableElementIdx.clear();
 		mElements.clear();
+		mElementSubMeshes.clear();
 
 		mSortedRenderElements.clear();
 	}
 
-	void RenderQueue::add(const RenderElement* element, float distFromCamera)
+	void RenderQueue::add(const RenderElement* element, float distFromCamera, const SubMesh* subMesh)
 	{
 		SPtr<Material> material = element->material;
 		SPtr<Shader> shader = material->getShader();
 
 		mElements.push_back(element);
+		mElementSubMeshes.push_back(subMesh != nullptr ? subMesh : &element->subMesh);
 		
 		UINT32 queuePriority = shader->getQueuePriority();
 		QueueSortType sortType = shader->getQueueSortType();
@@ -93,6 +95,7 @@ namespace bs { namespace ct
 		UINT32 prevShaderId = (UINT32)-1;
 		UINT32 prevPassIdx = (UINT32)-1;
 		const RenderElement* renderElem = nullptr;
+		const SubMesh* subMesh = nullptr;
 		INT32 currentElementIdx = -1;
 		UINT32 numPassesInCurrentElement = 0;
 		bool separablePasses = true;
@@ -104,6 +107,7 @@ namespace bs { namespace ct
 			{
 				currentElementIdx++;
 				renderElem = mElements[currentElementIdx];
+				subMesh = mElementSubMeshes[currentElementIdx];
 				numPassesInCurrentElement = renderElem->material->getNumPasses();
 				separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
 			}
@@ -115,6 +119,7 @@ namespace bs { namespace ct
 
 				RenderQueueElement& sortedElem = mSortedRenderElements.back();
 				sortedElem.renderElem = renderElem;
+				sortedElem.subMesh = subMesh;
 				sortedElem.passIdx = elem.passIdx;
 
 				if (prevShaderId != elem.shaderId || prevPassIdx != elem.passIdx)
@@ -136,6 +141,7 @@ namespace bs { namespace ct
 
 					RenderQueueElement& sortedElem = mSortedRenderElements.back();
 					sortedElem.renderElem = renderElem;
+					sortedElem.subMesh = subMesh;
 					sortedElem.passIdx = j;
 					sortedElem.applyPass = true;
 
@@ -26,6 +26,7 @@ namespace bs { namespace ct
 	struct RenderQueueElement
 	{
 		const RenderElement* renderElem = nullptr;
+		const SubMesh* subMesh = nullptr; /**< Portion of the element's mesh to render. */
 		UINT32 passIdx = 0;
 		bool applyPass = true;
 	};
@@ -56,8 +57,11 @@ namespace bs { namespace ct
 		 *
 		 * @param[in]	element			Renderable element to add to the queue.
 		 * @param[in]	distFromCamera	Distance of this object from the camera. Used for distance sorting.
+		 * @param[in]	subMesh			Portion of the element's mesh to render, allowing a different level of detail to be
+		 *								rendered per queue. If null, RenderElement::subMesh is used. Must remain valid
+		 *								until the queue is cleared.
 		 */
-		void add(const RenderElement* element, float distFromCamera);
+		void add(const RenderElement* element, float distFromCamera, const SubMesh* subMesh = nullptr);
 
 		/**	Clears all render operations from the queue. */
 		void clear();
@@ -87,6 +91,7 @@ namespace bs { namespace ct
 		Vector<SortableElement> mSortableElements;
 		Vector<UINT32> mSortableElementIdx;
 		Vector<const RenderElement*> mElements;
+		Vector<const SubMesh*> mElementSubMeshes;
 
 		Vector<RenderQueueElement> mSortedRenderElements;
 		StateReduction mStateReductionMode;
@@ -24,7 +24,7 @@ namespace bs
 	{
 		WString textData;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
 
 			SPtr<DataStream> stream = FileSystem::openFile(filePath);
 			textData = stream->getAsWString();
@@ -40,6 +40,10 @@ namespace bs
 
 	UINT8* FrameAlloc::alloc(UINT32 amount)
 	{
+#if BS_PROFILING_ENABLED
+		MemoryCounter::addAllocBytes(amount, MemoryCategory::Frame);
+#endif
+
 #if BS_DEBUG_MODE
 		amount += sizeof(UINT32);
 #endif
@@ -66,6 +70,10 @@ namespace bs
 
 	UINT8* FrameAlloc::allocAligned(UINT32 amount, UINT32 alignment)
 	{
+#if BS_PROFILING_ENABLED
+		MemoryCounter::addAllocBytes(amount, MemoryCategory::Frame);
+#endif
+
 #if BS_DEBUG_MODE
 		amount += sizeof(UINT32);
 #endif
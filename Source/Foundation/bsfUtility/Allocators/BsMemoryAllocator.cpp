@@ -1,9 +1,27 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Debug/BsHeapProfiler.h"
+
+#if BS_COMPILER == BS_COMPILER_MSVC
+#include <intrin.h>
+#define BS_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define BS_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
 
 namespace bs
 {
-	UINT64 BS_THREADLOCAL MemoryCounter::Allocs = 0;
-	UINT64 BS_THREADLOCAL MemoryCounter::Frees = 0;
+	MemoryCounts BS_THREADLOCAL MemoryCounter::Counts = { };
+	std::atomic<bool> MemoryCounter::HeapSamplingEnabled { false };
+
+	void MemoryCounter::sampleAlloc(void* ptr, size_t bytes)
+	{
+		HeapProfiler::recordAlloc(ptr, bytes, BS_RETURN_ADDRESS());
+	}
+
+	void MemoryCounter::sampleFree(void* ptr)
+	{
+		HeapProfiler::recordFree(ptr);
+	}
 }
\ No newline at end of file
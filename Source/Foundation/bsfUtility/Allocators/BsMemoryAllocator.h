@@ -8,6 +8,7 @@
 #include <limits>
 #include <cstdint>
 #include <utility>
+#include <atomic>
 
 #if BS_PLATFORM == BS_PLATFORM_LINUX
 #  include <malloc.h>
@@ -96,6 +97,23 @@ namespace bs
 	}
 #endif
 
+	/** Types of allocators memory allocations are attributed to, for statistics purposes. */
+	enum class MemoryCategory
+	{
+		General, /**< Allocations made through MemoryAllocator, by default directly from the OS heap. */
+		Frame, /**< Allocations from a FrameAlloc. */
+		Pool, /**< Allocations from a PoolAlloc. */
+		Count // Keep at end
+	};
+
+	/** Numbers of memory allocations and deallocations performed by a single thread. */
+	struct MemoryCounts
+	{
+		uint64_t numAllocs;
+		uint64_t numFrees;
+		uint64_t numAllocBytes[(int)MemoryCategory::Count]; /**< Number of allocated bytes, per allocator category. */
+	};
+
 	/**
 	 * Thread safe class used for storing total number of memory allocations and deallocations, primarily for statistic
 	 * purposes.
@@ -105,23 +123,58 @@ namespace bs
 	public:
 		static BS_UTILITY_EXPORT uint64_t getNumAllocs()
 		{
-			return Allocs;
+			return Counts.numAllocs;
 		}
 
 		static BS_UTILITY_EXPORT uint64_t getNumFrees()
 		{
-			return Frees;
+			return Counts.numFrees;
+		}
+
+		/** Returns the total number of bytes allocated on the calling thread, by allocators of the provided category. */
+		static BS_UTILITY_EXPORT uint64_t getNumAllocBytes(MemoryCategory category)
+		{
+			return Counts.numAllocBytes[(int)category];
+		}
+
+		/** Returns all the counters of the calling thread at once. Cheaper than querying them individually. */
+		static BS_UTILITY_EXPORT MemoryCounts getCounts()
+		{
+			return Counts;
+		}
+
+		/** 
+		 * Returns true if individual general allocations should be reported to HeapProfiler. Checked on every
+		 * allocation, so it needs to be cheap.
+		 */
+		static bool isHeapSamplingEnabled()
+		{
+			return HeapSamplingEnabled.load(std::memory_order_relaxed);
 		}
 
 	private:
 		friend class MemoryAllocatorBase;
+		friend class FrameAlloc;
+		friend class HeapProfiler;
+		template <int, int, int, bool> friend class PoolAlloc;
+		template <int, int, int, int> friend class ThreadCachedPoolAlloc;
 
 		// Threadlocal data can't be exported, so some magic to make it accessible from MemoryAllocator
-		static BS_UTILITY_EXPORT void incAllocCount() { ++Allocs; }
-		static BS_UTILITY_EXPORT void incFreeCount() { ++Frees; }
+		static BS_UTILITY_EXPORT void incAllocCount() { ++Counts.numAllocs; }
+		static BS_UTILITY_EXPORT void incFreeCount() { ++Counts.numFrees; }
+		static BS_UTILITY_EXPORT void addAllocBytes(size_t bytes, MemoryCategory category)
+		{
+			Counts.numAllocBytes[(int)category] += bytes;
+		}
+
+		/** Reports a general allocation to HeapProfiler. Only called when heap sampling is enabled. */
+		static BS_UTILITY_EXPORT void sampleAlloc(void* ptr, size_t bytes);
+
+		/** Reports a general deallocation to HeapProfiler. Only called when heap sampling is enabled. */
+		static BS_UTILITY_EXPORT void sampleFree(void* ptr);
 
-		static BS_THREADLOCAL uint64_t Allocs;
-		static BS_THREADLOCAL uint64_t Frees;
+		static BS_THREADLOCAL MemoryCounts Counts;
+		static BS_UTILITY_EXPORT std::atomic<bool> HeapSamplingEnabled;
 	};
 
 	/** Base class all memory allocators need to inherit. Provides allocation and free counting. */
@@ -130,6 +183,25 @@ namespace bs
 	protected:
 		static void incAllocCount() { MemoryCounter::incAllocCount(); }
 		static void incFreeCount() { MemoryCounter::incFreeCount(); }
+
+		/** Records statistics about a general allocation. */
+		static void trackAlloc(void* ptr, size_t bytes)
+		{
+			MemoryCounter::incAllocCount();
+			MemoryCounter::addAllocBytes(bytes, MemoryCategory::General);
+
+			if(MemoryCounter::isHeapSamplingEnabled())
+				MemoryCounter::sampleAlloc(ptr, bytes);
+		}
+
+		/** Records statistics about a general deallocation. */
+		static void trackFree(void* ptr)
+		{
+			MemoryCounter::incFreeCount();
+
+			if(MemoryCounter::isHeapSamplingEnabled())
+				MemoryCounter::sampleFree(ptr);
+		}
 	};
 
 	/**
@@ -145,11 +217,13 @@ namespace bs
 		/** Allocates @p bytes bytes. */
 		static void* allocate(size_t bytes)
 		{
+			void* ptr = malloc(bytes);
+
 #if BS_PROFILING_ENABLED
-			incAllocCount();
+			trackAlloc(ptr, bytes);
 #endif
 
-			return malloc(bytes);
+			return ptr;
 		}
 
 		/**
@@ -158,28 +232,32 @@ namespace bs
 		 */
 		static void* allocateAligned(size_t bytes, size_t alignment)
 		{
+			void* ptr = platformAlignedAlloc(bytes, alignment);
+
 #if BS_PROFILING_ENABLED
-			incAllocCount();
+			trackAlloc(ptr, bytes);
 #endif
 
-			return platformAlignedAlloc(bytes, alignment);
+			return ptr;
 		}
 
 		/** Allocates @p bytes and aligns them to a 16 byte boundary. */
 		static void* allocateAligned16(size_t bytes)
 		{
+			void* ptr = platformAlignedAlloc16(bytes);
+
 #if BS_PROFILING_ENABLED
-			incAllocCount();
+			trackAlloc(ptr, bytes);
 #endif
 
-			return platformAlignedAlloc16(bytes);
+			return ptr;
 		}
 
 		/** Frees the memory at the specified location. */
 		static void free(void* ptr)
 		{
 #if BS_PROFILING_ENABLED
-			incFreeCount();
+			trackFree(ptr);
 #endif
 
 			::free(ptr);
@@ -189,7 +267,7 @@ namespace bs
 		static void freeAligned(void* ptr)
 		{
 #if BS_PROFILING_ENABLED
-			incFreeCount();
+			trackFree(ptr);
 #endif
 
 			platformAlignedFree(ptr);
@@ -199,7 +277,7 @@ namespace bs
 		static void freeAligned16(void* ptr)
 		{
 #if BS_PROFILING_ENABLED
-			incFreeCount();
+			trackFree(ptr);
 #endif
 
 			platformAlignedFree16(ptr);
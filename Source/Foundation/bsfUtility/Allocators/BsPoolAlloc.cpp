@@ -0,0 +1,152 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsPoolAlloc.h"
+
+namespace bs
+{
+	/** Cache of a single pool, in the per-thread table of pool caches. */
+	struct PoolThreadCacheEntry
+	{
+		UINT64 poolId;
+		void* cache;
+	};
+
+	/** Pool assigned to a slot in the pool registry. */
+	struct PoolRegistryEntry
+	{
+		UINT64 poolId;
+		ThreadCachedPoolAllocBase* pool;
+	};
+
+	/** Keeps track of all thread cached pools that are alive. */
+	struct PoolRegistry
+	{
+		Mutex mutex;
+		Vector<PoolRegistryEntry> slots;
+		UINT64 nextId = 1;
+	};
+
+	/**
+	 * Returns the global pool registry. The registry is never destroyed, since global pools can get destroyed during
+	 * static de-initialization in any order.
+	 */
+	static PoolRegistry& getPoolRegistry()
+	{
+		static PoolRegistry* registry = bs_new<PoolRegistry>();
+		return *registry;
+	}
+
+	// Indexed by pool slot. Entries are validated by pool ID, since slots are re-used once pools are destroyed.
+	static BS_THREADLOCAL PoolThreadCacheEntry* sThreadCaches = nullptr;
+	static BS_THREADLOCAL UINT32 sNumThreadCaches = 0;
+
+	/** Releases the pool caches of its thread once the thread exits. */
+	struct PoolThreadCacheReleaser
+	{
+		~PoolThreadCacheReleaser()
+		{
+			ThreadCachedPoolAllocBase::releaseThreadCaches();
+		}
+
+		bool active = false;
+	};
+
+	static thread_local PoolThreadCacheReleaser sThreadCacheReleaser;
+
+	ThreadCachedPoolAllocBase::ThreadCachedPoolAllocBase()
+	{
+		PoolRegistry& registry = getPoolRegistry();
+		Lock lock(registry.mutex);
+
+		mId = registry.nextId++;
+
+		auto iterFind = std::find_if(registry.slots.begin(), registry.slots.end(),
+			[](const PoolRegistryEntry& entry) { return entry.pool == nullptr; });
+
+		mSlot = (UINT32)(iterFind - registry.slots.begin());
+		if(iterFind == registry.slots.end())
+			registry.slots.push_back(PoolRegistryEntry());
+
+		registry.slots[mSlot] = { mId, this };
+	}
+
+	ThreadCachedPoolAllocBase::~ThreadCachedPoolAllocBase()
+	{
+		unregisterPool();
+	}
+
+	void ThreadCachedPoolAllocBase::unregisterPool()
+	{
+		if(mSlot == INVALID_SLOT)
+			return;
+
+		PoolRegistry& registry = getPoolRegistry();
+		Lock lock(registry.mutex);
+
+		registry.slots[mSlot] = { 0, nullptr };
+		mSlot = INVALID_SLOT;
+	}
+
+	void* ThreadCachedPoolAllocBase::getThreadCache() const
+	{
+		if(mSlot < sNumThreadCaches && sThreadCaches[mSlot].poolId == mId)
+			return sThreadCaches[mSlot].cache;
+
+		return nullptr;
+	}
+
+	void ThreadCachedPoolAllocBase::setThreadCache(void* cache)
+	{
+		assert(mSlot != INVALID_SLOT);
+
+		if(mSlot >= sNumThreadCaches)
+		{
+			UINT32 newNumThreadCaches = std::max(std::max(mSlot + 1, sNumThreadCaches * 2), 16U);
+
+			auto newThreadCaches = bs_allocN<PoolThreadCacheEntry>(newNumThreadCaches);
+			memset(newThreadCaches, 0, sizeof(PoolThreadCacheEntry) * newNumThreadCaches);
+
+			if(sThreadCaches != nullptr)
+			{
+				memcpy(newThreadCaches, sThreadCaches, sizeof(PoolThreadCacheEntry) * sNumThreadCaches);
+				bs_free(sThreadCaches);
+			}
+			else // First cache of this thread, make sure they get released when the thread exits
+				sThreadCacheReleaser.active = true;
+
+			sThreadCaches = newThreadCaches;
+			sNumThreadCaches = newNumThreadCaches;
+		}
+
+		sThreadCaches[mSlot] = { mId, cache };
+	}
+
+	void ThreadCachedPoolAllocBase::releaseThreadCaches()
+	{
+		if(sThreadCaches == nullptr)
+			return;
+
+		{
+			// Holding the registry lock ensures none of the pools get destroyed while their caches are being released
+			PoolRegistry& registry = getPoolRegistry();
+			Lock lock(registry.mutex);
+
+			UINT32 numSlots = std::min(sNumThreadCaches, (UINT32)registry.slots.size());
+			for(UINT32 i = 0; i < numSlots; i++)
+			{
+				const PoolThreadCacheEntry& entry = sThreadCaches[i];
+				if(entry.cache == nullptr)
+					continue;
+
+				const PoolRegistryEntry& slot = registry.slots[i];
+				if(slot.poolId == entry.poolId)
+					slot.pool->releaseThreadCache(entry.cache);
+			}
+		}
+
+		bs_free(sThreadCaches);
+		sThreadCaches = nullptr;
+		sNumThreadCaches = 0;
+	}
+}
@@ -4,6 +4,7 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include <climits>
+#include <atomic>
 
 namespace bs
 {
@@ -11,6 +12,22 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Information about the number of elements allocated from a pool allocator. */
+	struct PoolAllocStats
+	{
+		/** Number of elements currently allocated. */
+		UINT64 numLive = 0;
+
+		/**
+		 * Highest number of elements that were allocated at once since the pool was created. See ThreadCachedPoolAlloc
+		 * for how this value is determined by thread cached pools.
+		 */
+		UINT64 highWaterMark = 0;
+
+		/** Number of elements the pool currently has memory reserved for. */
+		UINT64 numReserved = 0;
+	};
+
 	/**
 	 * A memory allocator that allocates elements of the same size. Allows for fairly quick allocations and deallocations.
 	 * 
@@ -109,8 +126,13 @@ namespace bs
 				allocBlock();
 
 			mTotalNumElems++;
+			mMaxNumElems = std::max(mMaxNumElems, mTotalNumElems);
 			UINT8* output = mFreeBlock->alloc();
 
+#if BS_PROFILING_ENABLED
+			MemoryCounter::addAllocBytes(ElemSize, MemoryCategory::Pool);
+#endif
+
 			return output;
 		}
 
@@ -168,6 +190,19 @@ namespace bs
 			free(data);
 		}
 
+		/** Returns information about the number of elements allocated from the pool. */
+		PoolAllocStats getStats()
+		{
+			ScopedLock<Lock> lock(mLockPolicy);
+
+			PoolAllocStats stats;
+			stats.numLive = mTotalNumElems;
+			stats.highWaterMark = mMaxNumElems;
+			stats.numReserved = mNumBlocks * (UINT64)ElemsPerBlock;
+
+			return stats;
+		}
+
 	private:
 		/** Allocates a new block of memory using a heap allocator. */
 		MemBlock* allocBlock()
@@ -226,7 +261,445 @@ namespace bs
 		LockingPolicy<Lock> mLockPolicy;
 		MemBlock* mFreeBlock = nullptr;
 		UINT32 mTotalNumElems = 0;
+		UINT32 mMaxNumElems = 0;
+		UINT32 mNumBlocks = 0;
+	};
+
+	/** Base class for all ThreadCachedPoolAlloc instantiations. Keeps track of the per-thread caches of the pools. */
+	class BS_UTILITY_EXPORT ThreadCachedPoolAllocBase
+	{
+	public:
+		/**
+		 * Returns the free elements cached by the calling thread back to the shared storage of their pools, for all thread
+		 * cached pools. Called automatically when a thread that used such pools exits. Threads can call this earlier to
+		 * make the elements available to other threads sooner, e.g. before idling for a long time.
+		 */
+		static void releaseThreadCaches();
+
+	protected:
+		ThreadCachedPoolAllocBase();
+		virtual ~ThreadCachedPoolAllocBase();
+
+		/** Returns the calling thread's cache for this pool, or null if the thread didn't create one yet. */
+		void* getThreadCache() const;
+
+		/** Assigns the calling thread's cache for this pool. */
+		void setThreadCache(void* cache);
+
+		/**
+		 * Stops the pool from receiving releaseThreadCache() calls. Must be called at the start of the derived class'
+		 * destructor.
+		 */
+		void unregisterPool();
+
+		/**
+		 * Returns the elements held by the provided thread cache back to the shared storage, and destroys the cache.
+		 * Called by the thread owning the cache.
+		 */
+		virtual void releaseThreadCache(void* cache) = 0;
+
+	private:
+		static constexpr UINT32 INVALID_SLOT = (UINT32)-1;
+
+		UINT64 mId = 0;
+		UINT32 mSlot = INVALID_SLOT;
+	};
+
+	/**
+	 * A pool allocator that keeps a cache of free elements for every thread using it, so that most allocations and
+	 * deallocations don't require any synchronization. Threads exchange free elements with the shared storage in groups
+	 * of MagazineSize elements (magazines), using lock-free stacks. A lock is only taken when the pool needs to reserve
+	 * more memory, or the first time a thread uses the pool. Elements may be freed by a different thread than the one
+	 * that allocated them.
+	 *
+	 * Each thread caches at most two magazines of free elements. Unlike PoolAlloc, reserved memory is only released when
+	 * the pool is destroyed.
+	 *
+	 * The high-water mark reported by getStats() counts the elements that were allocated or cached by threads at once.
+	 * It is therefore an upper bound on the highest number of live elements, exceeding it by at most the capacity of the
+	 * thread caches.
+	 *
+	 * @tparam	ElemSize		Size of a single element in the pool. Elements smaller than a pointer will use pointer size.
+	 * @tparam	ElemsPerBlock	Number of elements to reserve memory for, every time the pool runs out of free elements.
+	 * @tparam	Alignment		Memory alignment of each allocated element. At least pointer alignment is always used.
+	 * @tparam	MagazineSize	Number of free elements moved between a thread cache and the shared storage at once.
+	 *
+	 * @note	Thread safe.
+	 */
+	template <int ElemSize, int ElemsPerBlock = 512, int Alignment = 4, int MagazineSize = 32>
+	class ThreadCachedPoolAlloc : public ThreadCachedPoolAllocBase
+	{
+	private:
+		/** List of free elements, linked through the first bytes of each element. */
+		struct FreeList
+		{
+			void* head = nullptr;
+			UINT32 count = 0;
+		};
+
+		/** Free elements cached by a single thread, along with its allocation counters. */
+		struct ThreadCache
+		{
+			FreeList loaded;
+			FreeList previous;
+
+			// Only written by the owning thread, but read by getStats()
+			std::atomic<UINT64> numAllocs { 0 };
+			std::atomic<UINT64> numFrees { 0 };
+		};
+
+		/** A list of free elements stored in the shared storage. */
+		struct Magazine
+		{
+			std::atomic<UINT32> next { 0 };
+			FreeList elems;
+		};
+
+	public:
+		ThreadCachedPoolAlloc()
+		{
+			static_assert(ElemsPerBlock > 0, "Number of elements per block must be at least 1.");
+			static_assert(MagazineSize > 0, "Magazine size must be at least 1.");
+		}
+
+		~ThreadCachedPoolAlloc()
+		{
+			unregisterPool();
+
+			for(auto& cache : mThreadCaches)
+				bs_delete(cache);
+
+			for(UINT32 i = 0; i < MAX_MAGAZINE_CHUNKS; i++)
+			{
+				if(mMagazineChunks[i] != nullptr)
+					bs_deleteN(mMagazineChunks[i], FIRST_CHUNK_SIZE << i);
+			}
+
+			UINT8* curBlock = mBlocks;
+			while(curBlock != nullptr)
+			{
+				UINT8* nextBlock = *(UINT8**)curBlock;
+				bs_free(curBlock);
+
+				curBlock = nextBlock;
+			}
+		}
+
+		/** Allocates enough memory for a single element in the pool. */
+		UINT8* alloc()
+		{
+			ThreadCache* cache = getOrCreateThreadCache();
+
+			FreeList& loaded = cache->loaded;
+			if(loaded.count == 0)
+			{
+				if(cache->previous.count > 0)
+					std::swap(loaded, cache->previous);
+				else
+					loaded = popMagazine();
+			}
+
+			void* output = loaded.head;
+			loaded.head = *(void**)output;
+			loaded.count--;
+
+			cache->numAllocs.store(cache->numAllocs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+#if BS_PROFILING_ENABLED
+			MemoryCounter::addAllocBytes(ElemSize, MemoryCategory::Pool);
+#endif
+
+			return (UINT8*)output;
+		}
+
+		/** Deallocates an element from the pool. */
+		void free(void* data)
+		{
+			ThreadCache* cache = getOrCreateThreadCache();
+
+			FreeList& loaded = cache->loaded;
+			if(loaded.count == MagazineSize)
+			{
+				// Keep one full magazine around so alternating allocs and frees don't keep hitting the shared storage
+				if(cache->previous.count > 0)
+					pushMagazine(cache->previous);
+
+				cache->previous = loaded;
+				loaded = FreeList();
+			}
+
+			*(void**)data = loaded.head;
+			loaded.head = data;
+			loaded.count++;
+
+			cache->numFrees.store(cache->numFrees.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		/** Allocates and constructs a single pool element. */
+		template<class T, class... Args>
+		T* construct(Args &&...args)
+		{
+			T* data = (T*)alloc();
+			new ((void*)data) T(std::forward<Args>(args)...);
+
+			return data;
+		}
+
+		/** Destructs and deallocates a single pool element. */
+		template<class T>
+		void destruct(T* data)
+		{
+			data->~T();
+			free(data);
+		}
+
+		/**
+		 * Returns information about the number of elements allocated from the pool. Values are only approximate while
+		 * other threads are using the pool.
+		 */
+		PoolAllocStats getStats()
+		{
+			Lock lock(mMutex);
+
+			INT64 numLive = mNumReleasedLive;
+			for(auto& cache : mThreadCaches)
+			{
+				numLive += (INT64)cache->numAllocs.load(std::memory_order_relaxed);
+				numLive -= (INT64)cache->numFrees.load(std::memory_order_relaxed);
+			}
+
+			PoolAllocStats stats;
+			stats.numLive = (UINT64)std::max(numLive, (INT64)0);
+			stats.highWaterMark = std::max(stats.numLive, (UINT64)mHighWaterMark.load(std::memory_order_relaxed));
+			stats.numReserved = mNumBlocks * (UINT64)ElemsPerBlock;
+
+			return stats;
+		}
+
+	protected:
+		/** @copydoc ThreadCachedPoolAllocBase::releaseThreadCache */
+		void releaseThreadCache(void* data) override
+		{
+			ThreadCache* cache = (ThreadCache*)data;
+
+			if(cache->loaded.count > 0)
+				pushMagazine(cache->loaded);
+
+			if(cache->previous.count > 0)
+				pushMagazine(cache->previous);
+
+			Lock lock(mMutex);
+
+			mNumReleasedLive += (INT64)cache->numAllocs.load(std::memory_order_relaxed);
+			mNumReleasedLive -= (INT64)cache->numFrees.load(std::memory_order_relaxed);
+
+			auto iterFind = std::find(mThreadCaches.begin(), mThreadCaches.end(), cache);
+			if(iterFind != mThreadCaches.end())
+			{
+				std::swap(*iterFind, mThreadCaches.back());
+				mThreadCaches.pop_back();
+			}
+
+			bs_delete(cache);
+		}
+
+	private:
+		/** Returns the calling thread's cache, creating one if this is the first time the thread uses the pool. */
+		ThreadCache* getOrCreateThreadCache()
+		{
+			ThreadCache* cache = (ThreadCache*)getThreadCache();
+			if(cache != nullptr)
+				return cache;
+
+			cache = bs_new<ThreadCache>();
+
+			{
+				Lock lock(mMutex);
+				mThreadCaches.push_back(cache);
+			}
+
+			setThreadCache(cache);
+			return cache;
+		}
+
+		/**
+		 * Takes a magazine of free elements from the shared storage. If the storage is empty, reserves new elements
+		 * instead.
+		 */
+		FreeList popMagazine()
+		{
+			FreeList output;
+
+			UINT32 magazineIdx = popFromStack(mFullMagazines);
+			if(magazineIdx != INVALID_MAGAZINE)
+			{
+				Magazine* magazine = getMagazine(magazineIdx);
+				output = magazine->elems;
+				magazine->elems = FreeList();
+
+				pushToStack(mEmptyMagazines, magazineIdx);
+			}
+			else
+				output = reserveElements();
+
+			INT64 numCheckedOut = mNumCheckedOut.fetch_add(output.count, std::memory_order_relaxed) + output.count;
+			INT64 highWaterMark = mHighWaterMark.load(std::memory_order_relaxed);
+			while(numCheckedOut > highWaterMark &&
+				!mHighWaterMark.compare_exchange_weak(highWaterMark, numCheckedOut, std::memory_order_relaxed))
+			{ }
+
+			return output;
+		}
+
+		/** Moves the provided list of free elements to the shared storage, and clears the list. */
+		void pushMagazine(FreeList& elems)
+		{
+			UINT32 magazineIdx = popFromStack(mEmptyMagazines);
+			if(magazineIdx == INVALID_MAGAZINE)
+				magazineIdx = createMagazine();
+
+			mNumCheckedOut.fetch_sub(elems.count, std::memory_order_relaxed);
+
+			getMagazine(magazineIdx)->elems = elems;
+			elems = FreeList();
+
+			pushToStack(mFullMagazines, magazineIdx);
+		}
+
+		/**
+		 * Pushes a magazine on a lock-free stack. Stack heads store the index of the top magazine (plus one) in the lower
+		 * 32 bits and a counter in the upper 32 bits, incremented on every change so a pop can't succeed using a stale
+		 * head (ABA problem).
+		 */
+		void pushToStack(std::atomic<UINT64>& stack, UINT32 magazineIdx)
+		{
+			Magazine* magazine = getMagazine(magazineIdx);
+
+			UINT64 oldHead = stack.load(std::memory_order_relaxed);
+			UINT64 newHead;
+			do
+			{
+				magazine->next.store((UINT32)oldHead, std::memory_order_relaxed);
+				newHead = (((oldHead >> 32) + 1) << 32) | (magazineIdx + 1);
+			} while(!stack.compare_exchange_weak(oldHead, newHead, std::memory_order_release,
+				std::memory_order_relaxed));
+		}
+
+		/** Pops a magazine from a lock-free stack. Returns INVALID_MAGAZINE if the stack is empty. */
+		UINT32 popFromStack(std::atomic<UINT64>& stack)
+		{
+			UINT64 oldHead = stack.load(std::memory_order_acquire);
+			while((UINT32)oldHead != 0)
+			{
+				// Magazines are never freed while the pool is alive, so this is safe even if another thread pops it first
+				UINT32 next = getMagazine((UINT32)oldHead - 1)->next.load(std::memory_order_relaxed);
+				UINT64 newHead = (((oldHead >> 32) + 1) << 32) | next;
+
+				if(stack.compare_exchange_weak(oldHead, newHead, std::memory_order_acquire, std::memory_order_acquire))
+					return (UINT32)oldHead - 1;
+			}
+
+			return INVALID_MAGAZINE;
+		}
+
+		/**
+		 * Returns the magazine with the provided index. Magazines are stored in chunks, each chunk twice the size of the
+		 * previous one.
+		 */
+		Magazine* getMagazine(UINT32 magazineIdx) const
+		{
+			UINT64 position = (UINT64)magazineIdx + FIRST_CHUNK_SIZE;
+
+			UINT32 chunkIdx = 0;
+			while(position >= ((UINT64)FIRST_CHUNK_SIZE << (chunkIdx + 1)))
+				chunkIdx++;
+
+			return &mMagazineChunks[chunkIdx][position - ((UINT64)FIRST_CHUNK_SIZE << chunkIdx)];
+		}
+
+		/** Creates a new magazine and returns its index. */
+		UINT32 createMagazine()
+		{
+			Lock lock(mMutex);
+
+			UINT32 magazineIdx = mNumMagazines++;
+			UINT64 position = (UINT64)magazineIdx + FIRST_CHUNK_SIZE;
+
+			UINT32 chunkIdx = 0;
+			while(position >= ((UINT64)FIRST_CHUNK_SIZE << (chunkIdx + 1)))
+				chunkIdx++;
+
+			assert(chunkIdx < MAX_MAGAZINE_CHUNKS);
+			if(mMagazineChunks[chunkIdx] == nullptr)
+				mMagazineChunks[chunkIdx] = bs_newN<Magazine>(FIRST_CHUNK_SIZE << chunkIdx);
+
+			return magazineIdx;
+		}
+
+		/** Reserves a magazine worth of new elements, allocating new blocks of memory if needed. */
+		FreeList reserveElements()
+		{
+			Lock lock(mMutex);
+
+			FreeList output;
+			while(output.count < MagazineSize)
+			{
+				if(mBlockPtr == mBlockEnd)
+					allocBlock();
+
+				*(void**)mBlockPtr = output.head;
+				output.head = mBlockPtr;
+				output.count++;
+
+				mBlockPtr += ActualElemSize;
+			}
+
+			return output;
+		}
+
+		/** Allocates a new block of memory using a heap allocator. Caller must hold the lock. */
+		void allocBlock()
+		{
+			constexpr size_t blockDataSize = ActualElemSize * (size_t)ElemsPerBlock;
+			size_t paddedBlockDataSize = blockDataSize + (ActualAlignment - 1); // Padding for potential alignment correction
+
+			// Blocks are linked through a pointer at their start, so they can be freed on destruction
+			UINT8* data = (UINT8*)bs_alloc(sizeof(UINT8*) + paddedBlockDataSize);
+			*(UINT8**)data = mBlocks;
+			mBlocks = data;
+
+			void* blockData = data + sizeof(UINT8*);
+			blockData = std::align(ActualAlignment, blockDataSize, blockData, paddedBlockDataSize);
+
+			mBlockPtr = (UINT8*)blockData;
+			mBlockEnd = mBlockPtr + blockDataSize;
+			mNumBlocks++;
+		}
+
+		static constexpr int ActualAlignment = Alignment > (int)alignof(void*) ? Alignment : (int)alignof(void*);
+		static constexpr int MinElemSize = ElemSize > (int)sizeof(void*) ? ElemSize : (int)sizeof(void*);
+		static constexpr int ActualElemSize = ((MinElemSize + ActualAlignment - 1) / ActualAlignment) * ActualAlignment;
+
+		static constexpr UINT32 INVALID_MAGAZINE = (UINT32)-1;
+		static constexpr UINT32 FIRST_CHUNK_SIZE = 32;
+		static constexpr UINT32 MAX_MAGAZINE_CHUNKS = 26;
+
+		std::atomic<UINT64> mFullMagazines { 0 };
+		std::atomic<UINT64> mEmptyMagazines { 0 };
+		std::atomic<INT64> mNumCheckedOut { 0 };
+		std::atomic<INT64> mHighWaterMark { 0 };
+
+		Mutex mMutex;
+		Magazine* mMagazineChunks[MAX_MAGAZINE_CHUNKS] = { };
+		UINT32 mNumMagazines = 0;
+
+		UINT8* mBlocks = nullptr;
+		UINT8* mBlockPtr = nullptr;
+		UINT8* mBlockEnd = nullptr;
 		UINT32 mNumBlocks = 0;
+
+		Vector<ThreadCache*> mThreadCaches;
+		INT64 mNumReleasedLive = 0;
 	};
 
 	/** 
@@ -244,6 +717,17 @@ namespace bs
 	template <class T, int ElemsPerBlock, int Alignment, bool Lock>
 	PoolAlloc<sizeof(T), ElemsPerBlock, Alignment, Lock> StaticPoolAlloc<T, ElemsPerBlock, Alignment, Lock>::m;
 
+	/** Equivalent to StaticPoolAlloc, except it allocates a ThreadCachedPoolAlloc. */
+	template <class T, int ElemsPerBlock = 512, int Alignment = (int)alignof(T)>
+	class StaticThreadCachedPoolAlloc
+	{
+	public:
+		static ThreadCachedPoolAlloc<sizeof(T), ElemsPerBlock, Alignment> m;
+	};
+
+	template <class T, int ElemsPerBlock, int Alignment>
+	ThreadCachedPoolAlloc<sizeof(T), ElemsPerBlock, Alignment> StaticThreadCachedPoolAlloc<T, ElemsPerBlock, Alignment>::m;
+
 	/** Specializable template that allows users to implement globally accessible pool allocators for custom types. */
 	template<class T>
 	class GlobalPoolAlloc : std::false_type
@@ -256,10 +740,12 @@ namespace bs
 
 	/** 
 	 * Implements a global pool for the specified type. The pool will initially have enough room for ElemsPerBlock and
-	 * will grow by that amount when exceeded. Global pools are thread safe by default.
+	 * will grow by that amount when exceeded. Global pools are thread safe, and use a ThreadCachedPoolAlloc so threads
+	 * don't contend when allocating from the same pool. Pool statistics can be retrieved through
+	 * GlobalPoolAlloc<Type>::m.getStats().
 	 */
 #define IMPLEMENT_GLOBAL_POOL(Type, ElemsPerBlock)									\
-	template<> class GlobalPoolAlloc<Type> : public StaticPoolAlloc<Type> { };
+	template<> class GlobalPoolAlloc<Type> : public StaticThreadCachedPoolAlloc<Type, ElemsPerBlock> { };
 
 	/** Allocates a new object of type T using the global pool allocator, without constructing it. */
 	template<class T>
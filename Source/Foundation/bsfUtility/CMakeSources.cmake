@@ -55,7 +55,9 @@ set(BS_UTILITY_SRC_UTILITY
 set(BS_UTILITY_INC_DEBUG
 	"bsfUtility/Debug/BsBitmapWriter.h"
 	"bsfUtility/Debug/BsDebug.h"
+	"bsfUtility/Debug/BsHeapProfiler.h"
 	"bsfUtility/Debug/BsLog.h"
+	"bsfUtility/Debug/BsProfilerTimeline.h"
 )
 
 set(BS_UTILITY_INC_FILESYSTEM
@@ -103,6 +105,7 @@ set(BS_UTILITY_SRC_ALLOCATORS
 	"bsfUtility/Allocators/BsFrameAlloc.cpp"
 	"bsfUtility/Allocators/BsStackAlloc.cpp"
 	"bsfUtility/Allocators/BsMemoryAllocator.cpp"
+	"bsfUtility/Allocators/BsPoolAlloc.cpp"
 )
 
 set(BS_UTILITY_SRC_REFLECTION
@@ -115,6 +118,8 @@ set(BS_UTILITY_SRC_DEBUG
 	"bsfUtility/Debug/BsBitmapWriter.cpp"
 	"bsfUtility/Debug/BsLog.cpp"
 	"bsfUtility/Debug/BsDebug.cpp"
+	"bsfUtility/Debug/BsHeapProfiler.cpp"
+	"bsfUtility/Debug/BsProfilerTimeline.cpp"
 )
 
 set(BS_UTILITY_INC_RTTI
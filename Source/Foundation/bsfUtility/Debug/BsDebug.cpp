@@ -28,28 +28,40 @@ void logToIDEConsole(const bs::String& message)
 
 namespace bs
 {
+	Debug::Debug()
+	{
+		// Console output is slow, so it's performed by the log when processing entries, potentially on a background thread
+		mLog.setOutputCallback([](const LogEntry& entry)
+		{
+			if (entry.getNumSuppressed() > 0)
+				logToIDEConsole("(" + toString(entry.getNumSuppressed()) + " identical messages suppressed) " + entry.getMessage());
+			else
+				logToIDEConsole(entry.getMessage());
+		});
+
+		// Errors are rare and often important for diagnosing a problem, never discard them
+		mLog.setRateLimited((UINT32)DebugChannel::Error, false);
+		mLog.setRateLimited((UINT32)DebugChannel::CompilerError, false);
+	}
+
 	void Debug::logDebug(const String& msg)
 	{
 		mLog.logMsg(msg, (UINT32)DebugChannel::Debug);
-		logToIDEConsole(msg);
 	}
 
 	void Debug::logWarning(const String& msg)
 	{
 		mLog.logMsg(msg, (UINT32)DebugChannel::Warning);
-		logToIDEConsole(msg);
 	}
 
 	void Debug::logError(const String& msg)
 	{
 		mLog.logMsg(msg, (UINT32)DebugChannel::Error);
-		logToIDEConsole(msg);
 	}
 
 	void Debug::log(const String& msg, UINT32 channel)
 	{
 		mLog.logMsg(msg, channel);
-		logToIDEConsole(msg);
 	}
 
 	void Debug::writeAsBMP(UINT8* rawPixels, UINT32 bytesPerPixel, UINT32 width, UINT32 height, const Path& filePath, 
@@ -78,6 +90,9 @@ namespace bs
 
 	void Debug::_triggerCallbacks()
 	{
+		// Make sure entries still queued (e.g. by the background thread) get reported this frame
+		mLog.flush();
+
 		LogEntry entry;
 		while (mLog.getUnreadEntry(entry))
 		{
@@ -92,8 +107,11 @@ namespace bs
 		}
 	}
 
-	void Debug::saveLog(const Path& path) const
+	void Debug::saveLog(const Path& path)
 	{
+		// Entries might still be queued, including the error that triggered a crash report
+		mLog.flush();
+
 		static const char* style =
 			R"(html {
   font-family: sans-serif;
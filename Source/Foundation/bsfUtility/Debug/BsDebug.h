@@ -27,7 +27,7 @@ namespace bs
 	class BS_UTILITY_EXPORT Debug
 	{
 	public:
-		Debug() = default;
+		Debug();
 
 		/** Adds a log entry in the "Debug" channel. */
 		void logDebug(const String& msg);
@@ -53,7 +53,7 @@ namespace bs
 		 * 
 		 * @param	path	Absolute path to the log filename.
 		 */
-		void saveLog(const Path& path) const;
+		void saveLog(const Path& path);
 
 		/**
 		 * Triggered when a new entry in the log is added.
@@ -0,0 +1,381 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Debug/BsHeapProfiler.h"
+#include "Debug/BsDebug.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include <cmath>
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+#include "windows.h"
+#elif BS_PLATFORM == BS_PLATFORM_LINUX || BS_PLATFORM == BS_PLATFORM_OSX
+#include <execinfo.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#endif
+
+namespace bs
+{
+	// Profiler's own containers must not go through MemoryAllocator, or they would end up recording themselves
+	template <typename T>
+	using HeapProfilerVector = Vector<T, StdAlloc<T, ProfilerAlloc>>;
+
+	template <typename K, typename V>
+	using HeapProfilerMap = UnorderedMap<K, V, HashType<K>, std::equal_to<K>, StdAlloc<std::pair<const K, V>, ProfilerAlloc>>;
+
+	/** Sampled allocations grouped by the call stack they were made from. */
+	struct HeapStackEntry
+	{
+		void* frames[HeapProfiler::MAX_STACK_DEPTH];
+		UINT32 numFrames = 0;
+
+		UINT64 liveBytes = 0; /**< Estimated. */
+		UINT64 totalBytes = 0; /**< Estimated. */
+		UINT32 numLiveSamples = 0;
+		UINT32 numTotalSamples = 0;
+	};
+
+	/** Sampled allocation that wasn't freed yet. */
+	struct HeapLiveSample
+	{
+		UINT32 stackIdx;
+		UINT64 weight;
+	};
+
+	/** Sampled allocations that weren't freed yet, split into multiple shards to reduce lock contention. */
+	struct HeapLiveShard
+	{
+		HeapProfilerMap<void*, HeapLiveSample> samples;
+		Mutex mutex;
+	};
+
+	static constexpr UINT32 NUM_LIVE_SHARDS = 16;
+
+	struct HeapProfilerState
+	{
+		HeapProfilerVector<HeapStackEntry> stacks;
+		HeapProfilerMap<UINT64, UINT32> stackLookup; /**< Stack hash to index into stacks. Collisions are probed linearly. */
+		Mutex stackMutex;
+
+		HeapLiveShard liveShards[NUM_LIVE_SHARDS];
+
+		std::atomic<UINT32> sampleInterval { 0 };
+		std::atomic<UINT32> generation { 0 };
+	};
+
+	/** Returns the global state, constructed on first use since allocations can happen during static initialization. */
+	static HeapProfilerState& getState()
+	{
+		static HeapProfilerState state;
+		return state;
+	}
+
+	/** Per-thread state of the sampler. Zero initialized. */
+	struct HeapThreadState
+	{
+		INT64 bytesUntilSample;
+		UINT64 random;
+		UINT32 generation; /**< Profiler generation bytesUntilSample was picked for. Generation 0 is never active. */
+		bool inProfiler;
+	};
+
+	static BS_THREADLOCAL HeapThreadState gHeapThreadState;
+
+	/** Returns a random number of bytes until the next sample, exponentially distributed around the sample interval. */
+	static INT64 pickNextSample(HeapThreadState& thread, UINT32 sampleInterval)
+	{
+		// Xorshift, seeded from the address of the thread state so each thread gets a different sequence
+		if(thread.random == 0)
+			thread.random = (UINT64)(size_t)&thread | 1;
+
+		thread.random ^= thread.random << 13;
+		thread.random ^= thread.random >> 7;
+		thread.random ^= thread.random << 17;
+
+		const double uniform = ((thread.random >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+		return (INT64)(-std::log(uniform) * sampleInterval) + 1;
+	}
+
+	/** Returns the shard responsible for tracking the provided pointer. */
+	static HeapLiveShard& getShard(HeapProfilerState& state, void* ptr)
+	{
+		const size_t key = (size_t)ptr >> 4;
+		return state.liveShards[(key ^ (key >> 8)) % NUM_LIVE_SHARDS];
+	}
+
+	/** 
+	 * Records the call stack of the calling thread. Entries above @p caller belong to the profiler itself and are
+	 * skipped. Returns the number of recorded entries.
+	 */
+	static UINT32 captureStack(void* caller, void** frames, UINT32 maxFrames)
+	{
+		// Some extra room for the profiler's own entries. Their exact number depends on inlining and tail calls.
+		static constexpr UINT32 MAX_PROFILER_FRAMES = 8;
+
+		void* allFrames[HeapProfiler::MAX_STACK_DEPTH + MAX_PROFILER_FRAMES];
+		const UINT32 maxAllFrames = std::min(maxFrames + MAX_PROFILER_FRAMES, (UINT32)bs_size(allFrames));
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+		const UINT32 numFrames = (UINT32)CaptureStackBackTrace(0, maxAllFrames, allFrames, nullptr);
+#elif BS_PLATFORM == BS_PLATFORM_LINUX || BS_PLATFORM == BS_PLATFORM_OSX
+		const UINT32 numFrames = (UINT32)backtrace(allFrames, (int)maxAllFrames);
+#else
+		const UINT32 numFrames = 0;
+#endif
+
+		UINT32 first = 0;
+		for(UINT32 i = 0; i < std::min(numFrames, MAX_PROFILER_FRAMES); i++)
+		{
+			if(allFrames[i] == caller)
+			{
+				first = i;
+				break;
+			}
+		}
+
+		const UINT32 numOutputFrames = std::min(numFrames - first, maxFrames);
+		memcpy(frames, allFrames + first, numOutputFrames * sizeof(void*));
+
+		return numOutputFrames;
+	}
+
+	/** Converts a single call stack entry into a human readable string. */
+	static String getFrameName(void* frame)
+	{
+		StringStream addressStream;
+		addressStream << "0x" << std::hex << (UINT64)(size_t)frame;
+		String address = addressStream.str();
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX || BS_PLATFORM == BS_PLATFORM_OSX
+		Dl_info info;
+		if(dladdr(frame, &info) && info.dli_sname)
+		{
+			int status = -1;
+			char* demangledName = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+
+			String name = status == 0 ? String(demangledName) : String(info.dli_sname);
+			free(demangledName);
+
+			return address + " " + name;
+		}
+#endif
+
+		return address;
+	}
+
+	/** Returns the index of the entry for the provided call stack, creating a new one if needed. */
+	static UINT32 findOrAddStack(HeapProfilerState& state, void** frames, UINT32 numFrames)
+	{
+		UINT64 hash = 14695981039346656037ULL;
+		for(UINT32 i = 0; i < numFrames; i++)
+		{
+			hash ^= (UINT64)(size_t)frames[i];
+			hash *= 1099511628211ULL;
+		}
+
+		while(true)
+		{
+			auto iterFind = state.stackLookup.find(hash);
+			if(iterFind == state.stackLookup.end())
+				break;
+
+			const HeapStackEntry& entry = state.stacks[iterFind->second];
+			if(entry.numFrames == numFrames && memcmp(entry.frames, frames, numFrames * sizeof(void*)) == 0)
+				return iterFind->second;
+
+			hash++;
+		}
+
+		const UINT32 idx = (UINT32)state.stacks.size();
+		state.stacks.push_back(HeapStackEntry());
+
+		HeapStackEntry& entry = state.stacks.back();
+		memcpy(entry.frames, frames, numFrames * sizeof(void*));
+		entry.numFrames = numFrames;
+
+		state.stackLookup[hash] = idx;
+		return idx;
+	}
+
+	void HeapProfiler::start(UINT32 sampleInterval)
+	{
+		stop();
+
+		HeapProfilerState& state = getState();
+		state.sampleInterval.store(std::max(sampleInterval, 1U), std::memory_order_relaxed);
+
+		// Makes all threads pick a new sampling point using the new interval
+		state.generation.fetch_add(1, std::memory_order_relaxed);
+
+		MemoryCounter::HeapSamplingEnabled.store(true, std::memory_order_release);
+	}
+
+	void HeapProfiler::stop()
+	{
+		MemoryCounter::HeapSamplingEnabled.store(false, std::memory_order_release);
+
+		HeapProfilerState& state = getState();
+		for(auto& shard : state.liveShards)
+		{
+			Lock lock(shard.mutex);
+			shard.samples.clear();
+		}
+
+		Lock lock(state.stackMutex);
+		state.stacks.clear();
+		state.stackLookup.clear();
+	}
+
+	bool HeapProfiler::isRunning()
+	{
+		return MemoryCounter::isHeapSamplingEnabled();
+	}
+
+	void HeapProfiler::recordAlloc(void* ptr, size_t bytes, void* caller)
+	{
+		HeapThreadState& thread = gHeapThreadState;
+		if(thread.inProfiler || ptr == nullptr)
+			return;
+
+		HeapProfilerState& state = getState();
+		const UINT32 sampleInterval = state.sampleInterval.load(std::memory_order_relaxed);
+
+		const UINT32 generation = state.generation.load(std::memory_order_relaxed);
+		if(thread.generation != generation)
+		{
+			thread.generation = generation;
+			thread.bytesUntilSample = pickNextSample(thread, sampleInterval);
+		}
+
+		thread.bytesUntilSample -= (INT64)bytes;
+		if(thread.bytesUntilSample > 0)
+			return;
+
+		thread.inProfiler = true;
+		thread.bytesUntilSample = pickNextSample(thread, sampleInterval);
+
+		// Each sample stands in for all the bytes allocated since the previous one. This is the unbiased estimate for
+		// Poisson sampling, so large allocations (which are almost always sampled) aren't over-counted.
+		const double ratio = bytes / (double)sampleInterval;
+		const UINT64 weight = (UINT64)(bytes / (1.0 - std::exp(-ratio)));
+
+		void* frames[MAX_STACK_DEPTH];
+		const UINT32 numFrames = captureStack(caller, frames, MAX_STACK_DEPTH);
+
+		UINT32 stackIdx;
+		{
+			Lock lock(state.stackMutex);
+
+			stackIdx = findOrAddStack(state, frames, numFrames);
+
+			HeapStackEntry& entry = state.stacks[stackIdx];
+			entry.liveBytes += weight;
+			entry.totalBytes += weight;
+			entry.numLiveSamples++;
+			entry.numTotalSamples++;
+		}
+
+		{
+			HeapLiveShard& shard = getShard(state, ptr);
+
+			Lock lock(shard.mutex);
+			shard.samples[ptr] = { stackIdx, weight };
+		}
+
+		thread.inProfiler = false;
+	}
+
+	void HeapProfiler::recordFree(void* ptr)
+	{
+		HeapThreadState& thread = gHeapThreadState;
+		if(thread.inProfiler || ptr == nullptr)
+			return;
+
+		HeapProfilerState& state = getState();
+		HeapLiveShard& shard = getShard(state, ptr);
+
+		HeapLiveSample sample;
+		{
+			Lock lock(shard.mutex);
+
+			auto iterFind = shard.samples.find(ptr);
+			if(iterFind == shard.samples.end())
+				return;
+
+			sample = iterFind->second;
+			shard.samples.erase(iterFind);
+		}
+
+		Lock lock(state.stackMutex);
+
+		// Profiler might have been restarted in the meantime
+		if(sample.stackIdx >= state.stacks.size())
+			return;
+
+		HeapStackEntry& entry = state.stacks[sample.stackIdx];
+		entry.liveBytes -= std::min(entry.liveBytes, sample.weight);
+		entry.numLiveSamples -= std::min(entry.numLiveSamples, 1U);
+	}
+
+	String HeapProfiler::report()
+	{
+		HeapProfilerState& state = getState();
+
+		// Copy the data so no locks are held while formatting, as that allocates memory
+		HeapProfilerVector<HeapStackEntry> stacks;
+		{
+			Lock lock(state.stackMutex);
+			stacks = state.stacks;
+		}
+
+		std::sort(stacks.begin(), stacks.end(),
+			[](const HeapStackEntry& a, const HeapStackEntry& b)
+		{
+			if(a.liveBytes != b.liveBytes)
+				return a.liveBytes > b.liveBytes;
+
+			return a.totalBytes > b.totalBytes;
+		});
+
+		UINT64 liveBytes = 0;
+		UINT64 totalBytes = 0;
+		for(auto& entry : stacks)
+		{
+			liveBytes += entry.liveBytes;
+			totalBytes += entry.totalBytes;
+		}
+
+		StringStream output;
+		output << "Heap profile. Sampling interval: " << state.sampleInterval.load(std::memory_order_relaxed)
+			<< " bytes." << std::endl;
+		output << "Estimated bytes in use: " << liveBytes << ". Estimated bytes allocated: " << totalBytes << "."
+			<< std::endl;
+
+		for(auto& entry : stacks)
+		{
+			output << std::endl;
+			output << entry.liveBytes << " bytes in use (" << entry.numLiveSamples << " samples), " << entry.totalBytes
+				<< " bytes allocated (" << entry.numTotalSamples << " samples)" << std::endl;
+
+			for(UINT32 i = 0; i < entry.numFrames; i++)
+				output << "\t#" << i << " " << getFrameName(entry.frames[i]) << std::endl;
+		}
+
+		return output.str();
+	}
+
+	bool HeapProfiler::dump(const Path& path)
+	{
+		SPtr<DataStream> output = FileSystem::createAndOpenFile(path);
+		if(output == nullptr)
+		{
+			LOGERR("Unable to save heap profile. Failed to open file: " + path.toString());
+			return false;
+		}
+
+		output->writeString(report());
+		output->close();
+
+		return true;
+	}
+}
@@ -0,0 +1,76 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Debug
+	 *  @{
+	 */
+
+	/**
+	 * Samples general memory allocations (those made through MemoryAllocator) along with the call stack they were made
+	 * from, so the sources of memory usage and allocation churn can be found at runtime.
+	 *
+	 * Only a subset of allocations is recorded: on average one allocation per sampling interval worth of allocated bytes,
+	 * with larger allocations being more likely to get sampled. Byte counts in the report are estimates extrapolated from
+	 * the samples. Sampled allocations are tracked until freed, so the report shows both memory still in use and the
+	 * total amount allocated since the profiler was started.
+	 *
+	 * When not running, the profiler costs a single atomic load per allocation and deallocation. Requires
+	 * BS_PROFILING_ENABLED.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT HeapProfiler
+	{
+	public:
+		/** Maximum number of call stack entries recorded for a single allocation. */
+		static constexpr UINT32 MAX_STACK_DEPTH = 32;
+
+		/**
+		 * Starts sampling allocations. Any previously recorded samples are discarded.
+		 *
+		 * @param[in]	sampleInterval	Average number of bytes allocated between two samples. Lower values produce more
+		 *								accurate reports at the cost of higher overhead.
+		 */
+		static void start(UINT32 sampleInterval = 512 * 1024);
+
+		/** Stops sampling allocations and discards all recorded samples. */
+		static void stop();
+
+		/** Returns true if allocations are currently being sampled. */
+		static bool isRunning();
+
+		/**
+		 * Generates a report of sampled allocations grouped by the call stack they were made from, sorted by the
+		 * estimated number of bytes still in use.
+		 */
+		static String report();
+
+		/**
+		 * Saves the report returned by report() in a text file.
+		 *
+		 * @param[in]	path	Path of the file to save the report to. Existing files are overwritten.
+		 * @return				True if the file was written successfully.
+		 */
+		static bool dump(const Path& path);
+
+	private:
+		friend class MemoryCounter;
+
+		/**
+		 * Potentially samples a new allocation, depending on how many bytes were allocated since the last sample.
+		 * @p caller is the return address into the code that requested the allocation, where the recorded call stack
+		 * starts.
+		 */
+		static void recordAlloc(void* ptr, size_t bytes, void* caller);
+
+		/** Stops tracking an allocation, if it was sampled. */
+		static void recordFree(void* ptr);
+	};
+
+	/** @} */
+}
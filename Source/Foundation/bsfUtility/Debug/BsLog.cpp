@@ -2,19 +2,465 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Debug/BsLog.h"
 #include "Error/BsException.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include <chrono>
 
 namespace bs
 {
+	/**
+	 * Fixed size queue of messages logged by a single thread. Lock-free as long as only the owning thread pushes, and
+	 * only one thread at a time pops.
+	 */
+	struct LogThreadQueue
+	{
+		static constexpr UINT32 CAPACITY = 256;
+
+		/** Adds a new entry to the queue. Returns false if the queue is full. Logging thread only. */
+		bool push(QueuedLogEntry& entry)
+		{
+			const UINT32 tail = mTail.load(std::memory_order_relaxed);
+			if (tail - mHead.load(std::memory_order_acquire) == CAPACITY)
+				return false;
+
+			mEntries[tail % CAPACITY] = std::move(entry);
+			mTail.store(tail + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		/** Removes all entries from the queue and appends them to the provided array. */
+		void popAll(Vector<QueuedLogEntry>& output)
+		{
+			const UINT32 head = mHead.load(std::memory_order_relaxed);
+			const UINT32 tail = mTail.load(std::memory_order_acquire);
+
+			for (UINT32 i = head; i != tail; i++)
+				output.push_back(std::move(mEntries[i % CAPACITY]));
+
+			mHead.store(tail, std::memory_order_release);
+		}
+
+		UINT32 threadIdx = 0;
+		std::atomic<bool> threadExited { false };
+
+	private:
+		QueuedLogEntry mEntries[CAPACITY];
+		std::atomic<UINT32> mHead { 0 };
+		std::atomic<UINT32> mTail { 0 };
+	};
+
+	/** Identifier of a log, used for matching the log against the thread local queue. Zero is never used. */
+	static std::atomic<UINT64> sNextLogId { 1 };
+
+	/** Queue of the log last used by the current thread, and the ID of that log. */
+	static BS_THREADLOCAL LogThreadQueue* sThreadQueue = nullptr;
+	static BS_THREADLOCAL UINT64 sThreadQueueLogId = 0;
+
+	/** Marks the queues created by a thread once the thread exits, so the logs know they can free them. */
+	struct LogThreadQueueOwner
+	{
+		~LogThreadQueueOwner()
+		{
+			for (auto& queue : queues)
+				queue->threadExited.store(true, std::memory_order_release);
+		}
+
+		Vector<SPtr<LogThreadQueue>> queues;
+	};
+
+	static thread_local LogThreadQueueOwner sThreadQueueOwner;
+
+	/** Magic number and version at the start of binary log files. */
+	static constexpr UINT32 BINARY_LOG_MAGIC = 0x474C5342; // "BSLG"
+	static constexpr UINT32 BINARY_LOG_VERSION = 1;
+
+	/** Returns the current time in microseconds since the UNIX epoch. */
+	static UINT64 getCurrentTime()
+	{
+		using namespace std::chrono;
+		return (UINT64)duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+	}
+
+	Log::Log()
+		:mId(sNextLogId++)
+	{ }
+
 	Log::~Log()
 	{
+		setAsync(false);
+		flush();
+
+		{
+			RecursiveLock lock(mProcessMutex);
+			reportSuppressed(std::numeric_limits<UINT64>::max());
+		}
+
+		closeBinaryOutput();
 		clear();
 	}
 
 	void Log::logMsg(const String& message, UINT32 channel)
+	{
+		QueuedLogEntry entry;
+		entry.message = message;
+		entry.channel = channel;
+		entry.time = getCurrentTime();
+		entry.sequence = mNextSequence.fetch_add(1, std::memory_order_relaxed);
+
+		LogThreadQueue& queue = getThreadQueue();
+		entry.threadIdx = queue.threadIdx;
+
+		if (!queue.push(entry))
+		{
+			// Producing faster than the messages are processed, fall back to the locked path and wake up the
+			// processing thread
+			{
+				Lock lock(mThreadQueuesMutex);
+				mOverflowEntries.push_back(std::move(entry));
+			}
+
+			if (mSinkThreadRunning)
+			{
+				{
+					Lock lock(mSinkThreadMutex);
+					mSinkThreadWake = true;
+				}
+
+				mSinkThreadSignal.notify_one();
+			}
+		}
+
+		if (!mSinkThreadRunning)
+			flush();
+	}
+
+	void Log::flush()
+	{
+		RecursiveLock lock(mProcessMutex);
+		processQueued();
+	}
+
+	void Log::setAsync(bool async)
+	{
+		if (async == mSinkThreadRunning)
+			return;
+
+		if (async)
+		{
+			{
+				Lock lock(mSinkThreadMutex);
+				mSinkThreadStop = false;
+			}
+
+			mSinkThreadRunning = true;
+			mSinkThread = Thread(std::bind(&Log::sinkThreadMain, this));
+		}
+		else
+		{
+			{
+				Lock lock(mSinkThreadMutex);
+				mSinkThreadStop = true;
+			}
+
+			mSinkThreadSignal.notify_one();
+			mSinkThread.join();
+
+			mSinkThreadRunning = false;
+			flush();
+		}
+	}
+
+	void Log::setMaxEntries(UINT32 maxEntries)
 	{
 		RecursiveLock lock(mMutex);
 
-		mUnreadEntries.push(LogEntry(message, channel));
+		mMaxEntries = std::max(1U, maxEntries);
+
+		while (mEntries.size() > mMaxEntries)
+			mEntries.pop_front();
+
+		while (mUnreadEntries.size() > mMaxEntries)
+			mUnreadEntries.pop();
+
+		mHash++;
+	}
+
+	UINT32 Log::getMaxEntries() const
+	{
+		RecursiveLock lock(mMutex);
+		return mMaxEntries;
+	}
+
+	void Log::setRateLimit(UINT32 maxRepeats, UINT32 intervalMs)
+	{
+		RecursiveLock lock(mProcessMutex);
+
+		reportSuppressed(std::numeric_limits<UINT64>::max());
+
+		mRateLimitRepeats = maxRepeats;
+		mRateLimitInterval = intervalMs * 1000ULL;
+		mRepeats.clear();
+	}
+
+	void Log::setRateLimited(UINT32 channel, bool enabled)
+	{
+		RecursiveLock lock(mProcessMutex);
+
+		if (enabled)
+			mRateLimitExempt.erase(channel);
+		else
+			mRateLimitExempt.insert(channel);
+	}
+
+	void Log::setOutputCallback(std::function<void(const LogEntry&)> callback)
+	{
+		RecursiveLock lock(mProcessMutex);
+		mOutputCallback = std::move(callback);
+	}
+
+	bool Log::openBinaryOutput(const Path& path)
+	{
+		RecursiveLock lock(mProcessMutex);
+
+		closeBinaryOutput();
+
+		mBinaryOutput = FileSystem::createAndOpenFile(path);
+		if (mBinaryOutput == nullptr)
+			return false;
+
+		mBinaryOutput->write(&BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+		mBinaryOutput->write(&BINARY_LOG_VERSION, sizeof(BINARY_LOG_VERSION));
+
+		return true;
+	}
+
+	void Log::closeBinaryOutput()
+	{
+		RecursiveLock lock(mProcessMutex);
+
+		if (mBinaryOutput != nullptr)
+		{
+			mBinaryOutput->close();
+			mBinaryOutput = nullptr;
+		}
+	}
+
+	LogThreadQueue& Log::getThreadQueue()
+	{
+		if (sThreadQueueLogId == mId)
+			return *sThreadQueue;
+
+		Lock lock(mThreadQueuesMutex);
+
+		SPtr<LogThreadQueue>& queue = mThreadQueues[BS_THREAD_CURRENT_ID];
+		if (queue != nullptr && queue->threadExited.load(std::memory_order_acquire))
+		{
+			// ID of an exited thread got re-used before its queue was freed
+			queue->popAll(mOverflowEntries);
+			queue = nullptr;
+		}
+
+		if (queue == nullptr)
+		{
+			queue = bs_shared_ptr_new<LogThreadQueue>();
+			queue->threadIdx = mNextThreadIdx++;
+
+			sThreadQueueOwner.queues.push_back(queue);
+		}
+
+		sThreadQueue = queue.get();
+		sThreadQueueLogId = mId;
+
+		return *queue;
+	}
+
+	void Log::processQueued()
+	{
+		Vector<QueuedLogEntry> queuedEntries;
+		{
+			Lock lock(mThreadQueuesMutex);
+
+			for (auto iter = mThreadQueues.begin(); iter != mThreadQueues.end();)
+			{
+				// Checked before popping, so entries pushed before the thread exited aren't missed
+				const bool threadExited = iter->second->threadExited.load(std::memory_order_acquire);
+				iter->second->popAll(queuedEntries);
+
+				if (threadExited)
+					iter = mThreadQueues.erase(iter);
+				else
+					++iter;
+			}
+
+			for (auto& entry : mOverflowEntries)
+				queuedEntries.push_back(std::move(entry));
+
+			mOverflowEntries.clear();
+		}
+
+		// Restore the order in which the messages were logged across all threads
+		std::sort(queuedEntries.begin(), queuedEntries.end(),
+			[](const QueuedLogEntry& a, const QueuedLogEntry& b) { return a.sequence < b.sequence; });
+
+		for (auto& queuedEntry : queuedEntries)
+		{
+			reportSuppressed(queuedEntry.time);
+
+			if (isRateLimited(queuedEntry))
+				continue;
+
+			addEntry(LogEntry(std::move(queuedEntry.message), queuedEntry.channel, queuedEntry.time),
+				queuedEntry.threadIdx);
+		}
+
+		reportSuppressed(getCurrentTime());
+	}
+
+	void Log::addEntry(LogEntry entry, UINT32 threadIdx)
+	{
+		if (mBinaryOutput != nullptr)
+		{
+			const UINT64 time = entry.getTime();
+			const UINT32 channel = entry.getChannel();
+			const UINT32 numSuppressed = entry.getNumSuppressed();
+			const UINT32 msgLength = (UINT32)entry.getMessage().size();
+
+			mBinaryOutput->write(&time, sizeof(time));
+			mBinaryOutput->write(&channel, sizeof(channel));
+			mBinaryOutput->write(&threadIdx, sizeof(threadIdx));
+			mBinaryOutput->write(&numSuppressed, sizeof(numSuppressed));
+			mBinaryOutput->write(&msgLength, sizeof(msgLength));
+			mBinaryOutput->write(entry.getMessage().data(), msgLength);
+		}
+
+		if (mOutputCallback)
+			mOutputCallback(entry);
+
+		RecursiveLock lock(mMutex);
+
+		mUnreadEntries.push(std::move(entry));
+		if (mUnreadEntries.size() > mMaxEntries)
+			mUnreadEntries.pop();
+	}
+
+	bool Log::isRateLimited(const QueuedLogEntry& entry)
+	{
+		if (mRateLimitRepeats == 0 || mRateLimitExempt.find(entry.channel) != mRateLimitExempt.end())
+			return false;
+
+		size_t hash = 0;
+		bs::hash_combine(hash, entry.message);
+		bs::hash_combine(hash, entry.channel);
+
+		// Forget about messages not seen in a while, so the lookup doesn't keep growing
+		if (mRepeats.size() > 1024)
+		{
+			for (auto iter = mRepeats.begin(); iter != mRepeats.end();)
+			{
+				if ((entry.time - iter->second.intervalStart) >= mRateLimitInterval && iter->second.numSuppressed == 0)
+					iter = mRepeats.erase(iter);
+				else
+					++iter;
+			}
+		}
+
+		// Different messages can have the same hash, so the messages themselves are compared as well. Message is only copied
+		// the first time it is encountered.
+		RepeatInfo* foundInfo = nullptr;
+		const auto range = mRepeats.equal_range(hash);
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			if (iter->second.channel == entry.channel && iter->second.message == entry.message)
+			{
+				foundInfo = &iter->second;
+				break;
+			}
+		}
+
+		if (foundInfo == nullptr)
+		{
+			RepeatInfo newInfo;
+			newInfo.message = entry.message;
+			newInfo.channel = entry.channel;
+
+			foundInfo = &mRepeats.insert(std::make_pair(hash, std::move(newInfo)))->second;
+		}
+
+		RepeatInfo& info = *foundInfo;
+		if (info.count == 0 || (entry.time - info.intervalStart) >= mRateLimitInterval)
+		{
+			info.intervalStart = entry.time;
+			info.count = 0;
+		}
+
+		if (info.count >= mRateLimitRepeats)
+		{
+			if (info.numSuppressed == 0)
+			{
+				info.threadIdx = entry.threadIdx;
+
+				mNumPendingSuppressed++;
+				mNextSuppressedReport = std::min(mNextSuppressedReport, info.intervalStart + mRateLimitInterval);
+			}
+
+			info.numSuppressed++;
+			return true;
+		}
+
+		info.count++;
+		return false;
+	}
+
+	void Log::reportSuppressed(UINT64 time)
+	{
+		if (mNumPendingSuppressed == 0 || time < mNextSuppressedReport)
+			return;
+
+		mNextSuppressedReport = std::numeric_limits<UINT64>::max();
+		for (auto& entry : mRepeats)
+		{
+			RepeatInfo& info = entry.second;
+			if (info.numSuppressed == 0)
+				continue;
+
+			const UINT64 intervalEnd = info.intervalStart + mRateLimitInterval;
+			if (time >= intervalEnd)
+				reportSuppressed(info);
+			else
+				mNextSuppressedReport = std::min(mNextSuppressedReport, intervalEnd);
+		}
+	}
+
+	void Log::reportSuppressed(RepeatInfo& info)
+	{
+		LogEntry entry(info.message, info.channel, info.intervalStart + mRateLimitInterval, info.numSuppressed);
+
+		info.numSuppressed = 0;
+		mNumPendingSuppressed--;
+
+		addEntry(std::move(entry), info.threadIdx);
+	}
+
+	void Log::sinkThreadMain()
+	{
+		while (true)
+		{
+			bool stop;
+			{
+				Lock lock(mSinkThreadMutex);
+				mSinkThreadSignal.wait_for(lock, std::chrono::milliseconds(10),
+					[this]() { return mSinkThreadStop || mSinkThreadWake; });
+
+				stop = mSinkThreadStop;
+				mSinkThreadWake = false;
+			}
+
+			flush();
+
+			if (stop)
+				break;
+		}
 	}
 
 	void Log::clear()
@@ -33,7 +479,7 @@ namespace bs
 	{
 		RecursiveLock lock(mMutex);
 
-		Vector<LogEntry> newEntries;
+		Deque<LogEntry> newEntries;
 		for(auto& entry : mEntries)
 		{
 			if (entry.getChannel() == channel)
@@ -72,11 +518,16 @@ namespace bs
 		mEntries.push_back(entry);
 		mHash++;
 
+		while (mEntries.size() > mMaxEntries)
+			mEntries.pop_front();
+
 		return true;
 	}
 
 	bool Log::getLastEntry(LogEntry& entry)
 	{
+		RecursiveLock lock(mMutex);
+
 		if (mEntries.size() == 0)
 			return false;
 
@@ -88,11 +539,13 @@ namespace bs
 	{
 		RecursiveLock lock(mMutex);
 
-		return mEntries;
+		return Vector<LogEntry>(mEntries.begin(), mEntries.end());
 	}
 
-	Vector<LogEntry> Log::getAllEntries() const
+	Vector<LogEntry> Log::getAllEntries()
 	{
+		flush();
+
 		Vector<LogEntry> entries;
 		{
 			RecursiveLock lock(mMutex);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include <atomic>
 
 namespace bs
 {
@@ -10,13 +11,15 @@ namespace bs
 	 *  @{
 	 */
 
+	struct LogThreadQueue;
+
 	/** A single log entry, containing a message and a channel the message was recorded on. */
 	class BS_UTILITY_EXPORT LogEntry
 	{
 	public:
 		LogEntry() = default;
-		LogEntry(String msg, UINT32 channel)
-			:mMsg(std::move(msg)), mChannel(channel)
+		LogEntry(String msg, UINT32 channel, UINT64 time = 0, UINT32 numSuppressed = 0)
+			:mMsg(std::move(msg)), mChannel(channel), mTime(time), mNumSuppressed(numSuppressed)
 		{ }
 
 		/** Channel the message was recorded on. */
@@ -25,21 +28,47 @@ namespace bs
 		/** Text of the message. */
 		const String& getMessage() const { return mMsg; }
 
+		/** Time at which the message was logged, in microseconds since the UNIX epoch. */
+		UINT64 getTime() const { return mTime; }
+
+		/** 
+		 * If non-zero, this entry doesn't represent a new message. Instead it reports the number of times the message was
+		 * discarded due to rate limiting during the rate limit interval that just ended.
+		 */
+		UINT32 getNumSuppressed() const { return mNumSuppressed; }
+
 	private:
 		String mMsg;
-		UINT32 mChannel;
+		UINT32 mChannel = 0;
+		UINT64 mTime = 0;
+		UINT32 mNumSuppressed = 0;
+	};
+
+	/** Message logged to a Log, waiting to be processed. */
+	struct QueuedLogEntry
+	{
+		String message;
+		UINT32 channel = 0;
+		UINT32 threadIdx = 0;
+		UINT64 time = 0;
+		UINT64 sequence = 0;
 	};
 
 	/**
 	 * Used for logging messages. Can categorize messages according to channels, save the log to a file
 	 * and send out callbacks when a new message is added.
+	 *
+	 * Messages are first placed in a lock-free queue owned by the logging thread, and are processed (added to the
+	 * history, output and written to the binary log) either immediately on the logging thread, or by a background thread
+	 * if asynchronous output is enabled through setAsync(). Identical messages repeated too often are rate limited, and
+	 * only a limited number of entries is kept in the history.
 	 * 			
 	 * @note	Thread safe.
 	 */
 	class BS_UTILITY_EXPORT Log
 	{
 	public:
-		Log() = default;
+		Log();
 		~Log();
 
 		/**
@@ -50,6 +79,56 @@ namespace bs
 		 */
 		void logMsg(const String& message, UINT32 channel);
 
+		/** Processes all messages logged so far, that haven't yet been processed by the background thread. */
+		void flush();
+
+		/** 
+		 * Determines should messages be processed by a background thread (true), or immediately on the thread that logged
+		 * them (false). Disabling asynchronous output processes all queued messages before returning.
+		 */
+		void setAsync(bool async);
+
+		/** Checks are messages being processed by a background thread. See setAsync(). */
+		bool isAsync() const { return mSinkThreadRunning; }
+
+		/** 
+		 * Sets the maximum number of entries to keep in the history. Oldest entries are removed once the limit is
+		 * exceeded. Unread entries are limited separately, to the same number.
+		 */
+		void setMaxEntries(UINT32 maxEntries);
+
+		/** Returns the maximum number of entries kept in the history. See setMaxEntries(). */
+		UINT32 getMaxEntries() const;
+
+		/** 
+		 * Limits how often can the identical message on the same channel be logged. Once a message is logged 
+		 * @p maxRepeats times within @p intervalMs milliseconds, all further identical messages are discarded until the
+		 * interval elapses. Set @p maxRepeats to zero to disable rate limiting. Once the interval ends, the number of
+		 * discarded messages is reported through an entry with a non-zero LogEntry::getNumSuppressed().
+		 */
+		void setRateLimit(UINT32 maxRepeats, UINT32 intervalMs);
+
+		/** Determines should messages on the specified channel be rate limited (true by default). See setRateLimit(). */
+		void setRateLimited(UINT32 channel, bool enabled);
+
+		/** 
+		 * Sets a callback that will be triggered for every processed entry, intended for writing the entries to an
+		 * external output (e.g. a console). Called on the thread processing the entries.
+		 */
+		void setOutputCallback(std::function<void(const LogEntry&)> callback);
+
+		/**
+		 * Starts writing all processed entries to the specified file, in binary form. Each record contains the time,
+		 * channel, logging thread index, number of suppressed repeats, and the message length followed by the message.
+		 *
+		 * @param[in]	path	Path to the file to write the log to. Existing file will be overwritten.
+		 * @return				True if the file was opened successfully.
+		 */
+		bool openBinaryOutput(const Path& path);
+
+		/** Stops writing entries to the binary file opened by openBinaryOutput(). */
+		void closeBinaryOutput();
+
 		/** Removes all log entries. */
 		void clear();
 
@@ -84,11 +163,75 @@ namespace bs
 	private:
 		friend class Debug;
 
-		/** Returns all log entries, including those marked as unread. */
-		Vector<LogEntry> getAllEntries() const;
-
-		Vector<LogEntry> mEntries;
+		/** Information about recent occurrences of a message, used for rate limiting. */
+		struct RepeatInfo
+		{
+			UINT64 intervalStart = 0;
+			UINT32 count = 0;
+			UINT32 numSuppressed = 0;
+
+			// Message the information is about, compared against when hashes of two messages match
+			String message;
+			UINT32 channel = 0;
+			UINT32 threadIdx = 0;
+		};
+
+		/** Returns the message queue of the calling thread, creating it if it doesn't exist. */
+		LogThreadQueue& getThreadQueue();
+
+		/** Removes all messages from the thread queues and processes them. */
+		void processQueued();
+
+		/** Checks should the provided message be discarded due to rate limiting. */
+		bool isRateLimited(const QueuedLogEntry& entry);
+
+		/** Reports the number of suppressed messages, for all messages whose rate limit interval ended before @p time. */
+		void reportSuppressed(UINT64 time);
+
+		/** Reports the number of times the message described by @p info was suppressed, and resets the count. */
+		void reportSuppressed(RepeatInfo& info);
+
+		/** Outputs a processed entry and adds it to the list of unread entries. */
+		void addEntry(LogEntry entry, UINT32 threadIdx);
+
+		/** Entry point of the background thread processing queued messages. */
+		void sinkThreadMain();
+
+		/** Processes any queued messages, and returns all log entries, including those marked as unread. */
+		Vector<LogEntry> getAllEntries();
+
+		const UINT64 mId;
+
+		// Message queues, written by the logging threads and read by the thread processing the messages
+		UnorderedMap<ThreadId, SPtr<LogThreadQueue>> mThreadQueues;
+		Vector<QueuedLogEntry> mOverflowEntries;
+		UINT32 mNextThreadIdx = 0;
+		std::atomic<UINT64> mNextSequence { 0 };
+		Mutex mThreadQueuesMutex;
+
+		// Message processing, only accessed by the thread processing the messages
+		std::function<void(const LogEntry&)> mOutputCallback;
+		SPtr<DataStream> mBinaryOutput;
+		UnorderedMultimap<size_t, RepeatInfo> mRepeats;
+		UnorderedSet<UINT32> mRateLimitExempt;
+		UINT32 mRateLimitRepeats = 10;
+		UINT64 mRateLimitInterval = 1000000;
+		UINT32 mNumPendingSuppressed = 0;
+		UINT64 mNextSuppressedReport = std::numeric_limits<UINT64>::max();
+		RecursiveMutex mProcessMutex;
+
+		// Background processing thread
+		Thread mSinkThread;
+		std::atomic<bool> mSinkThreadRunning { false };
+		bool mSinkThreadStop = false;
+		bool mSinkThreadWake = false;
+		Signal mSinkThreadSignal;
+		Mutex mSinkThreadMutex;
+
+		// Processed entries
+		Deque<LogEntry> mEntries;
 		Queue<LogEntry> mUnreadEntries;
+		UINT32 mMaxEntries = 10000;
 		UINT64 mHash = 0;
 		mutable RecursiveMutex mMutex;
 	};
@@ -0,0 +1,541 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Debug/BsProfilerTimeline.h"
+#include "Debug/BsDebug.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include <chrono>
+
+namespace bs
+{
+	/** A single begin or end event recorded by a thread. */
+	struct TimelineEvent
+	{
+		UINT64 time; /**< Nanoseconds, relative to an arbitrary point. */
+		bool begin;
+		char name[ProfilerTimeline::MAX_NAME_LENGTH + 1]; /**< Only valid for begin events. */
+	};
+
+	/**
+	 * Fixed size queue of events recorded by a single thread. Lock-free as long as only the owning thread pushes, and
+	 * only one thread at a time pops.
+	 */
+	struct TimelineThreadQueue
+	{
+		static constexpr UINT32 CAPACITY = ProfilerTimeline::THREAD_CAPACITY;
+
+		/** Adds a new event to the queue. Returns false if the queue is full. Owning thread only. */
+		bool push(UINT64 time, const char* name, bool begin)
+		{
+			const UINT32 tail = mTail.load(std::memory_order_relaxed);
+			if (tail - mHead.load(std::memory_order_acquire) == CAPACITY)
+				return false;
+
+			TimelineEvent& event = mEvents[tail % CAPACITY];
+			event.time = time;
+			event.begin = begin;
+
+			if (begin)
+			{
+				strncpy(event.name, name, ProfilerTimeline::MAX_NAME_LENGTH);
+				event.name[ProfilerTimeline::MAX_NAME_LENGTH] = '\0';
+			}
+
+			mTail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** Removes all events from the queue and appends them to the provided array. */
+		void popAll(Vector<TimelineEvent>& output)
+		{
+			const UINT32 head = mHead.load(std::memory_order_relaxed);
+			const UINT32 tail = mTail.load(std::memory_order_acquire);
+
+			for (UINT32 i = head; i != tail; i++)
+				output.push_back(mEvents[i % CAPACITY]);
+
+			mHead.store(tail, std::memory_order_release);
+		}
+
+		/** Removes all events from the queue. */
+		void discard()
+		{
+			mHead.store(mTail.load(std::memory_order_acquire), std::memory_order_release);
+		}
+
+		UINT32 threadIdx = 0;
+		std::atomic<UINT32> numDropped { 0 };
+		std::atomic<bool> threadExited { false };
+
+	private:
+		TimelineEvent mEvents[CAPACITY];
+		std::atomic<UINT32> mHead { 0 };
+		std::atomic<UINT32> mTail { 0 };
+	};
+
+	/** Events collected from a single thread. */
+	struct TimelineThreadData
+	{
+		String name;
+		Vector<TimelineEvent> events;
+		UINT32 numDropped = 0;
+	};
+
+	/** Shared state of all timeline recording. */
+	struct TimelineState
+	{
+		Vector<SPtr<TimelineThreadQueue>> queues;
+		Vector<TimelineThreadData> threads; // Indexed by TimelineThreadQueue::threadIdx
+		UINT64 startTime = 0;
+		Mutex mutex;
+	};
+
+	/** Queue of the current thread, created on the first recorded event. */
+	static BS_THREADLOCAL TimelineThreadQueue* sThreadQueue = nullptr;
+
+	/**
+	 * Marks the queue of its thread once the thread exits. The queue is freed once the events left in it are collected.
+	 */
+	struct TimelineThreadQueueOwner
+	{
+		~TimelineThreadQueueOwner()
+		{
+			if (queue != nullptr)
+				queue->threadExited.store(true, std::memory_order_release);
+
+			sThreadQueue = nullptr;
+		}
+
+		TimelineThreadQueue* queue = nullptr;
+	};
+
+	static thread_local TimelineThreadQueueOwner sThreadQueueOwner;
+
+	/** Name of the current thread, as set by ProfilerTimeline::setThreadName. */
+	static BS_THREADLOCAL char sThreadName[ProfilerTimeline::MAX_NAME_LENGTH + 1];
+
+	/** Returns the state shared by all threads. Constructed on first use so it is available before any module. */
+	static TimelineState& getState()
+	{
+		static TimelineState state;
+		return state;
+	}
+
+	/** Returns the current time in nanoseconds, relative to an arbitrary point. */
+	static UINT64 getCurrentTime()
+	{
+		using namespace std::chrono;
+		return (UINT64)duration_cast<nanoseconds>(high_resolution_clock::now().time_since_epoch()).count();
+	}
+
+	/** Returns the name to display for a thread with no name set. */
+	static String getDefaultThreadName(UINT32 threadIdx)
+	{
+		return "Thread " + toString(threadIdx);
+	}
+
+	/**
+	 * Frees the queues of all threads that have exited. Any events still in the queues are lost, so they should be
+	 * collected first. Caller must hold the state mutex.
+	 */
+	static void releaseExitedQueues(TimelineState& state)
+	{
+		// Exited threads can't record any more events, so checking the flag before freeing is enough
+		auto iterRemove = std::remove_if(state.queues.begin(), state.queues.end(),
+			[](const SPtr<TimelineThreadQueue>& queue) { return queue->threadExited.load(std::memory_order_acquire); });
+
+		state.queues.erase(iterRemove, state.queues.end());
+	}
+
+	std::atomic<bool> ProfilerTimeline::sRecording { false };
+
+	void ProfilerTimeline::recordEvent(const char* name, bool begin)
+	{
+		const UINT64 time = getCurrentTime();
+
+		if (sThreadQueue == nullptr)
+		{
+			TimelineState& state = getState();
+			Lock lock(state.mutex);
+
+			SPtr<TimelineThreadQueue> queue = bs_shared_ptr_new<TimelineThreadQueue>();
+			queue->threadIdx = (UINT32)state.threads.size();
+
+			TimelineThreadData threadData;
+			if (sThreadName[0] != '\0')
+				threadData.name = sThreadName;
+			else
+				threadData.name = getDefaultThreadName(queue->threadIdx);
+
+			state.threads.push_back(threadData);
+			state.queues.push_back(queue);
+
+			sThreadQueue = queue.get();
+			sThreadQueueOwner.queue = sThreadQueue;
+		}
+
+		if (!sThreadQueue->push(time, name, begin))
+			sThreadQueue->numDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void ProfilerTimeline::setThreadName(const char* name)
+	{
+		if (strncmp(sThreadName, name, MAX_NAME_LENGTH) == 0)
+			return;
+
+		strncpy(sThreadName, name, MAX_NAME_LENGTH);
+		sThreadName[MAX_NAME_LENGTH] = '\0';
+
+		if (sThreadQueue != nullptr)
+		{
+			TimelineState& state = getState();
+			Lock lock(state.mutex);
+
+			state.threads[sThreadQueue->threadIdx].name = sThreadName;
+		}
+	}
+
+	void ProfilerTimeline::startRecording()
+	{
+		TimelineState& state = getState();
+		Lock lock(state.mutex);
+
+		// Discard anything recorded after the last collect of the previous recording
+		for (auto& queue : state.queues)
+		{
+			queue->discard();
+			queue->numDropped.store(0, std::memory_order_relaxed);
+		}
+
+		releaseExitedQueues(state);
+
+		for (auto& thread : state.threads)
+		{
+			thread.events.clear();
+			thread.numDropped = 0;
+		}
+
+		state.startTime = getCurrentTime();
+		sRecording.store(true, std::memory_order_relaxed);
+	}
+
+	void ProfilerTimeline::stopRecording()
+	{
+		sRecording.store(false, std::memory_order_relaxed);
+		collect();
+	}
+
+	void ProfilerTimeline::collect()
+	{
+		TimelineState& state = getState();
+		Lock lock(state.mutex);
+
+		for (auto& entry : state.queues)
+		{
+			TimelineThreadQueue& queue = *entry;
+			TimelineThreadData& thread = state.threads[queue.threadIdx];
+
+			queue.popAll(thread.events);
+			thread.numDropped += queue.numDropped.exchange(0, std::memory_order_relaxed);
+		}
+
+		releaseExitedQueues(state);
+	}
+
+	UINT32 ProfilerTimeline::_getNumThreadQueues()
+	{
+		TimelineState& state = getState();
+		Lock lock(state.mutex);
+
+		return (UINT32)state.queues.size();
+	}
+
+	void ProfilerTimeline::clear()
+	{
+		TimelineState& state = getState();
+		Lock lock(state.mutex);
+
+		for (auto& thread : state.threads)
+		{
+			thread.events.clear();
+			thread.events.shrink_to_fit();
+			thread.numDropped = 0;
+		}
+	}
+
+	/** Event ready to be written to a trace, with matching begin and end events. */
+	struct TraceEvent
+	{
+		UINT64 time; /**< Nanoseconds since recording started. */
+		bool begin;
+		const char* name;
+	};
+
+	/**
+	 * Converts events recorded by a thread into a list where every end event has a matching begin event, and every begin
+	 * event is eventually ended. Recording can start or stop in the middle of an event, and events can be dropped if the
+	 * thread queue overflows, both of which leave unmatched events.
+	 */
+	static void getTraceEvents(const TimelineThreadData& thread, UINT64 startTime, Vector<TraceEvent>& output)
+	{
+		output.clear();
+
+		UINT32 depth = 0;
+		UINT64 lastTime = 0;
+		for (auto& event : thread.events)
+		{
+			const UINT64 time = event.time > startTime ? event.time - startTime : 0;
+			lastTime = std::max(lastTime, time);
+
+			if (event.begin)
+			{
+				output.push_back({ time, true, event.name });
+				depth++;
+			}
+			else if (depth > 0)
+			{
+				output.push_back({ time, false, nullptr });
+				depth--;
+			}
+		}
+
+		for (; depth > 0; depth--)
+			output.push_back({ lastTime, false, nullptr });
+	}
+
+	/** Appends a string to a JSON document, escaping any characters as required. */
+	static void writeJSONString(StringStream& stream, const String& value)
+	{
+		stream << '"';
+		for (auto& entry : value)
+		{
+			if (entry == '"' || entry == '\\')
+				stream << '\\' << entry;
+			else if ((UINT8)entry < 0x20)
+				stream << ' ';
+			else
+				stream << entry;
+		}
+		stream << '"';
+	}
+
+	/** Writes the events in the trace event JSON format. */
+	static void writeChromeJSON(const TimelineState& state, DataStream& output)
+	{
+		StringStream stream;
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool first = true;
+		Vector<TraceEvent> events;
+		for (UINT32 i = 0; i < (UINT32)state.threads.size(); i++)
+		{
+			const TimelineThreadData& thread = state.threads[i];
+			getTraceEvents(thread, state.startTime, events);
+
+			if (events.empty())
+				continue;
+
+			if (!first)
+				stream << ',';
+
+			first = false;
+
+			stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":";
+			writeJSONString(stream, thread.name);
+			stream << "}}";
+
+			// Timestamps are in microseconds
+			for (auto& event : events)
+			{
+				stream << ",\n{\"ph\":\"" << (event.begin ? 'B' : 'E') << "\",\"pid\":1,\"tid\":" << i << ",\"ts\":";
+				stream << (event.time / 1000) << '.';
+
+				const UINT64 fraction = event.time % 1000;
+				stream << (char)('0' + fraction / 100) << (char)('0' + (fraction / 10) % 10) << (char)('0' + fraction % 10);
+
+				if (event.begin)
+				{
+					stream << ",\"name\":";
+					writeJSONString(stream, event.name);
+				}
+
+				stream << '}';
+			}
+		}
+
+		stream << "\n]}\n";
+
+		const String data = stream.str();
+		output.write(data.data(), data.size());
+	}
+
+	/** Minimal writer for the protobuf wire format, supporting only the types used by Perfetto traces. */
+	class ProtobufWriter
+	{
+	public:
+		/** Writes a variable length integer field. */
+		void writeVarInt(UINT32 field, UINT64 value)
+		{
+			writeRawVarInt((UINT64)field << 3);
+			writeRawVarInt(value);
+		}
+
+		/** Writes a length delimited field containing a string. */
+		void writeString(UINT32 field, const char* value)
+		{
+			const UINT32 length = (UINT32)strlen(value);
+
+			writeRawVarInt(((UINT64)field << 3) | 2);
+			writeRawVarInt(length);
+			mData.insert(mData.end(), (const UINT8*)value, (const UINT8*)value + length);
+		}
+
+		/** Writes a length delimited field containing a nested message. */
+		void writeMessage(UINT32 field, const ProtobufWriter& message)
+		{
+			writeRawVarInt(((UINT64)field << 3) | 2);
+			writeRawVarInt(message.mData.size());
+			mData.insert(mData.end(), message.mData.begin(), message.mData.end());
+		}
+
+		/** Removes all written data. */
+		void clear() { mData.clear(); }
+
+		/** Returns all data written so far. */
+		const Vector<UINT8>& getData() const { return mData; }
+
+	private:
+		/** Writes a variable length integer without a field tag. */
+		void writeRawVarInt(UINT64 value)
+		{
+			do
+			{
+				UINT8 byte = value & 0x7F;
+				value >>= 7;
+
+				if (value != 0)
+					byte |= 0x80;
+
+				mData.push_back(byte);
+			} while (value != 0);
+		}
+
+		Vector<UINT8> mData;
+	};
+
+	/** Writes the events as a Perfetto trace, using one track per thread. */
+	static void writePerfetto(const TimelineState& state, DataStream& output)
+	{
+		// Field numbers from perfetto/trace/trace.proto and perfetto/trace/track_event/*.proto
+		constexpr UINT32 TRACE_PACKET = 1;
+
+		constexpr UINT32 PACKET_TIMESTAMP = 8;
+		constexpr UINT32 PACKET_SEQUENCE_ID = 10;
+		constexpr UINT32 PACKET_TRACK_EVENT = 11;
+		constexpr UINT32 PACKET_TRACK_DESCRIPTOR = 60;
+
+		constexpr UINT32 TRACK_UUID = 1;
+		constexpr UINT32 TRACK_THREAD = 4;
+
+		constexpr UINT32 THREAD_PID = 1;
+		constexpr UINT32 THREAD_TID = 2;
+		constexpr UINT32 THREAD_NAME = 5;
+
+		constexpr UINT32 EVENT_TYPE = 9;
+		constexpr UINT32 EVENT_TRACK_UUID = 11;
+		constexpr UINT32 EVENT_NAME = 23;
+
+		constexpr UINT32 EVENT_TYPE_SLICE_BEGIN = 1;
+		constexpr UINT32 EVENT_TYPE_SLICE_END = 2;
+
+		constexpr UINT32 SEQUENCE_ID = 1;
+		constexpr UINT32 PID = 1;
+
+		ProtobufWriter trace;
+		ProtobufWriter packet;
+		ProtobufWriter message;
+		ProtobufWriter nested;
+
+		Vector<TraceEvent> events;
+		for (UINT32 i = 0; i < (UINT32)state.threads.size(); i++)
+		{
+			const TimelineThreadData& thread = state.threads[i];
+			getTraceEvents(thread, state.startTime, events);
+
+			if (events.empty())
+				continue;
+
+			// Zero is not a valid track UUID
+			const UINT32 uuid = i + 1;
+
+			nested.clear();
+			nested.writeVarInt(THREAD_PID, PID);
+			nested.writeVarInt(THREAD_TID, uuid);
+			nested.writeString(THREAD_NAME, thread.name.c_str());
+
+			message.clear();
+			message.writeVarInt(TRACK_UUID, uuid);
+			message.writeMessage(TRACK_THREAD, nested);
+
+			packet.clear();
+			packet.writeMessage(PACKET_TRACK_DESCRIPTOR, message);
+			packet.writeVarInt(PACKET_SEQUENCE_ID, SEQUENCE_ID);
+			trace.writeMessage(TRACE_PACKET, packet);
+
+			for (auto& event : events)
+			{
+				message.clear();
+				message.writeVarInt(EVENT_TYPE, event.begin ? EVENT_TYPE_SLICE_BEGIN : EVENT_TYPE_SLICE_END);
+				message.writeVarInt(EVENT_TRACK_UUID, uuid);
+
+				if (event.begin)
+					message.writeString(EVENT_NAME, event.name);
+
+				packet.clear();
+				packet.writeVarInt(PACKET_TIMESTAMP, event.time);
+				packet.writeMessage(PACKET_TRACK_EVENT, message);
+				packet.writeVarInt(PACKET_SEQUENCE_ID, SEQUENCE_ID);
+				trace.writeMessage(TRACE_PACKET, packet);
+			}
+		}
+
+		const Vector<UINT8>& data = trace.getData();
+		output.write(data.data(), data.size());
+	}
+
+	bool ProfilerTimeline::save(const Path& path, TimelineFormat format)
+	{
+		TimelineState& state = getState();
+		Lock lock(state.mutex);
+
+		SPtr<DataStream> output = FileSystem::createAndOpenFile(path);
+		if (output == nullptr)
+		{
+			LOGERR("Unable to save timeline. Failed to open file: " + path.toString());
+			return false;
+		}
+
+		UINT32 numDropped = 0;
+		for (auto& thread : state.threads)
+			numDropped += thread.numDropped;
+
+		if (numDropped > 0)
+		{
+			LOGWRN("Timeline is missing " + toString(numDropped) + " events because threads recorded them faster than "
+				"they were collected. The trace might contain incorrectly nested events.");
+		}
+
+		switch (format)
+		{
+		case TimelineFormat::ChromeJSON:
+			writeChromeJSON(state, *output);
+			break;
+		case TimelineFormat::Perfetto:
+			writePerfetto(state, *output);
+			break;
+		}
+
+		output->close();
+		return true;
+	}
+}
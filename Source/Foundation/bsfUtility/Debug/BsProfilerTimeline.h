@@ -0,0 +1,106 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Debug
+	 *  @{
+	 */
+
+	/** File formats a recorded timeline can be saved in. */
+	enum class TimelineFormat
+	{
+		/** JSON trace event format, viewable in chrome://tracing or the Perfetto UI. */
+		ChromeJSON,
+		/** Perfetto protobuf trace format, viewable in the Perfetto UI or processed with Perfetto trace processor. */
+		Perfetto
+	};
+
+	/**
+	 * Records begin/end events with timestamps from any number of threads, which can then be saved as a trace and viewed
+	 * on a timeline. Unlike ProfilerCPU which aggregates samples, this preserves exactly when and on which thread each
+	 * event happened.
+	 *
+	 * Each thread records into its own fixed size queue without any locking. Queues are drained by collect(), which
+	 * should be called often enough (normally once per frame) for the queues not to overflow. Events that don't fit are
+	 * dropped. Queues of threads that have exited are freed once they're drained. When not recording, recording an event
+	 * costs a single atomic load.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT ProfilerTimeline
+	{
+	public:
+		/** Maximum length of an event name, longer names are truncated. */
+		static constexpr UINT32 MAX_NAME_LENGTH = 47;
+
+		/** Maximum number of events a single thread can record between two calls to collect(). */
+		static constexpr UINT32 THREAD_CAPACITY = 8192;
+
+		/**
+		 * Records the start of an event on the current thread. Must be followed by endEvent() on the same thread. Nested
+		 * events are allowed.
+		 */
+		static void beginEvent(const char* name)
+		{
+			if (sRecording.load(std::memory_order_relaxed))
+				recordEvent(name, true);
+		}
+
+		/** Records the end of the most recently started event on the current thread. */
+		static void endEvent()
+		{
+			if (sRecording.load(std::memory_order_relaxed))
+				recordEvent(nullptr, false);
+		}
+
+		/** Sets the name the current thread will be displayed with in saved traces. */
+		static void setThreadName(const char* name);
+
+		/** Returns true if events are currently being recorded. */
+		static bool isRecording() { return sRecording.load(std::memory_order_relaxed); }
+
+		/** Discards any previously recorded events and starts recording new ones. */
+		static void startRecording();
+
+		/** Stops recording events. Events recorded so far are collected and kept until saved or cleared. */
+		static void stopRecording();
+
+		/** Moves events recorded by all threads so far into the internal storage, making room for new events. */
+		static void collect();
+
+		/** Discards all collected events. */
+		static void clear();
+
+		/**
+		 * Saves all collected events in a file. Events that were started but never ended are closed at the time of the
+		 * last recorded event.
+		 *
+		 * @param[in]	path	Path of the file to save the trace to. Existing files are overwritten.
+		 * @param[in]	format	Format to save the trace in.
+		 * @return				True if the file was written successfully.
+		 */
+		static bool save(const Path& path, TimelineFormat format);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Returns the number of per-thread event queues currently allocated. */
+		static UINT32 _getNumThreadQueues();
+
+		/** @} */
+
+	private:
+		/** Adds a new event to the current thread's queue. */
+		static void recordEvent(const char* name, bool begin);
+
+		static std::atomic<bool> sRecording;
+	};
+
+	/** @} */
+}
@@ -295,7 +295,12 @@ namespace bs
 		if (!copyData)
 			return bs_shared_ptr_new<MemoryDataStream>(mData, mSize, false);
 
-		return bs_shared_ptr_new<MemoryDataStream>(*this);
+		// Note: Not using the copy constructor, since it would share (and eventually double-free) the same buffer
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>(mSize);
+		memcpy(output->mData, mData, mSize);
+		output->mPos = output->mData + (mPos - mData);
+
+		return output;
 	}
 
 	void MemoryDataStream::close()
@@ -107,5 +107,185 @@ namespace bs
 		FileSystem::moveFile(oldPath, newPath);
 	}
 
+	FileScheduler::Slot::Slot(String file)
+		:mFile(std::move(file)), mAcquired(true)
+	{ }
+
+	FileScheduler::Slot::Slot(Slot&& other) noexcept
+		:mFile(std::move(other.mFile)), mAcquired(other.mAcquired)
+	{
+		other.mAcquired = false;
+	}
+
+	FileScheduler::Slot::~Slot()
+	{
+		release();
+	}
+
+	FileScheduler::Slot& FileScheduler::Slot::operator=(Slot&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+
+			mFile = std::move(other.mFile);
+			mAcquired = other.mAcquired;
+			other.mAcquired = false;
+		}
+
+		return *this;
+	}
+
+	void FileScheduler::Slot::release()
+	{
+		if (!mAcquired)
+			return;
+
+		FileScheduler::release(mFile);
+		mAcquired = false;
+	}
+
+	void FileScheduler::lock(const Path& path)
+	{
+		acquire(path);
+	}
+
+	void FileScheduler::unlock(const Path& path)
+	{
+		Path absPath = path;
+		if (!absPath.isAbsolute())
+			absPath.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+
+		release(absPath.toString());
+	}
+
+	FileScheduler::Slot FileScheduler::getLock(const Path& path)
+	{
+		return Slot(acquire(path));
+	}
+
+	void FileScheduler::setDeviceType(const Path& root, StorageDeviceType type)
+	{
+		Path absRoot = root;
+		if (!absRoot.isAbsolute())
+			absRoot.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+
+		Lock lock(mMutex);
+		for (auto& entry : mDeviceRoots)
+		{
+			if (entry.root.equals(absRoot))
+			{
+				entry.type = type;
+				return;
+			}
+		}
+
+		mDeviceRoots.push_back({ absRoot, type });
+	}
+
+	void FileScheduler::setDefaultDeviceType(StorageDeviceType type)
+	{
+		Lock lock(mMutex);
+		mDefaultType = type;
+	}
+
+	void FileScheduler::setMaxConcurrentAccesses(StorageDeviceType type, UINT32 count)
+	{
+		{
+			Lock lock(mMutex);
+			mMaxConcurrentAccesses[(UINT32)type] = std::max(1U, count);
+		}
+
+		// Waiting threads might be able to proceed with the new limit
+		mSlotReleased.notify_all();
+	}
+
+	UINT32 FileScheduler::getMaxConcurrentAccesses(StorageDeviceType type)
+	{
+		Lock lock(mMutex);
+		return mMaxConcurrentAccesses[(UINT32)type];
+	}
+
+	String FileScheduler::getDevice(const Path& path, StorageDeviceType& type)
+	{
+		Path absPath = path;
+		if (!absPath.isAbsolute())
+			absPath.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+
+		// Find the most specific registered root containing the path
+		const DeviceRoot* bestRoot = nullptr;
+		for (auto& entry : mDeviceRoots)
+		{
+			if (!entry.root.includes(absPath))
+				continue;
+
+			if (bestRoot == nullptr || entry.root.getNumDirectories() > bestRoot->root.getNumDirectories())
+				bestRoot = &entry;
+		}
+
+		if (bestRoot != nullptr)
+		{
+			type = bestRoot->type;
+			return bestRoot->root.toString();
+		}
+
+		type = mDefaultType;
+		if (!absPath.getNode().empty())
+			return "\\\\" + absPath.getNode();
+
+		return absPath.getDevice();
+	}
+
+	String FileScheduler::acquire(const Path& path)
+	{
+		Path absPath = path;
+		if (!absPath.isAbsolute())
+			absPath.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+
+		String file = absPath.toString();
+
+		Lock lock(mMutex);
+
+		StorageDeviceType type;
+		String device = getDevice(absPath, type);
+
+		// Also wait for any other access to the same file to finish, so e.g. a load can't read a partially saved file
+		UINT32& numActive = mNumActive[device];
+		while (numActive >= mMaxConcurrentAccesses[(UINT32)type] || mActiveFiles.find(file) != mActiveFiles.end())
+			mSlotReleased.wait(lock);
+
+		numActive++;
+
+		// Remember the device, as device roots might change before the slot is released
+		mActiveFiles[file] = std::move(device);
+
+		return file;
+	}
+
+	void FileScheduler::release(const String& file)
+	{
+		{
+			Lock lock(mMutex);
+
+			auto iterFindFile = mActiveFiles.find(file);
+			if (iterFindFile == mActiveFiles.end())
+			{
+				LOGWRN("Releasing a file access slot that wasn't acquired.");
+				return;
+			}
+
+			mNumActive[iterFindFile->second]--;
+			mActiveFiles.erase(iterFindFile);
+		}
+
+		mSlotReleased.notify_all();
+	}
+
 	Mutex FileScheduler::mMutex;
+	Signal FileScheduler::mSlotReleased;
+	UnorderedMap<String, UINT32> FileScheduler::mNumActive;
+	UnorderedMap<String, String> FileScheduler::mActiveFiles;
+	Vector<FileScheduler::DeviceRoot> FileScheduler::mDeviceRoots;
+	StorageDeviceType FileScheduler::mDefaultType = StorageDeviceType::SSD;
+	UINT32 FileScheduler::mMaxConcurrentAccesses[2] = { 4, 1 };
 }
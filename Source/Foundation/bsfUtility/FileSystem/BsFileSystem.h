@@ -140,45 +140,131 @@ namespace bs
 		static void moveFile(const Path& oldPath, const Path& newPath);
 	};
 
+	/** Type of the storage device a file resides on. Determines how many files can be accessed on it concurrently. */
+	enum class StorageDeviceType
+	{
+		/** Solid state drive, handles multiple concurrent reads well. */
+		SSD,
+		/** Mechanical drive, performance degrades heavily when multiple files are accessed at once due to seeking. */
+		HDD
+	};
+
 	/** 
-	 * Locks access to files on the same drive, allowing only one file to be read at a time, per drive. This prevents
-	 * multiple threads accessing multiple files on the same drive at once, ruining performance on mechanical drives.
+	 * Limits the number of files that may be accessed at once on the same storage device. Each device has a number of
+	 * access slots determined by its type, and threads wanting to access a file on a device whose slots are all in use
+	 * wait until one is released. This prevents multiple threads from thrashing a mechanical drive, while still allowing
+	 * files on different devices (or on solid state drives) to be read in parallel.
+	 *
+	 * Paths are mapped to devices by checking the device roots registered through setDeviceType(), using the most
+	 * specific root containing the path. Paths outside of any registered root are mapped to a device by their drive
+	 * letter or network node, and are considered to be of the default device type.
+	 *
+	 * Slots should only be held while data is transferred to or from the device, and released before any processing of
+	 * that data, so processing can happen in parallel with other file access.
 	 */
 	class BS_UTILITY_EXPORT FileScheduler final
 	{
 	public:
+		/** Holds an access slot on a device and exclusive access to a file, and releases them when it goes out of scope. */
+		class BS_UTILITY_EXPORT Slot final
+		{
+		public:
+			Slot() = default;
+			Slot(const Slot&) = delete;
+			Slot(Slot&& other) noexcept;
+			~Slot();
+
+			Slot& operator=(const Slot&) = delete;
+			Slot& operator=(Slot&& other) noexcept;
+
+			/** Releases the slot before the object goes out of scope. Does nothing if already released. */
+			void release();
+
+		private:
+			friend class FileScheduler;
+
+			Slot(String file);
+
+			String mFile;
+			bool mAcquired = false;
+		};
+
 		/** 
-		 * Locks access and doesn't allow other threads to get past this point until access is unlocked. Any scheduled
-		 * file access should happen past this point.
+		 * Acquires an access slot on the device the path belongs to, waiting if all slots on the device are in use, or if
+		 * another thread holds a slot for the same path. Any scheduled file access should happen past this point. Slots
+		 * are not re-entrant, a thread must release its slot for a path before acquiring another one for the same path.
 		 */
-		static void lock(const Path& path)
-		{
-			// Note: File path should be analyzed and determined on which drive does the path belong to. Locks can then
-			// be issued on a per-drive basis, instead of having one global lock. This would allow multiple files to be
-			// accessed at the same time, as long as they're on different drives.
-			mMutex.lock();
-		}
+		static void lock(const Path& path);
 
 		/** 
-		 * Unlocks access and allows another thread to lock file access. Must be provided with the same file path as
-		 * lock().
+		 * Releases an access slot acquired with lock(), allowing another thread to access the device. Must be provided
+		 * with the same file path as lock().
 		 */
-		static void unlock(const Path& path)
-		{
-			mMutex.unlock();
-		}
+		static void unlock(const Path& path);
 
 		/**
-		 * Returns a lock object that immediately locks access (same as lock()), and then calls unlock() when it goes
-		 * out of scope.
+		 * Returns an object that immediately acquires an access slot (same as lock()), and then releases it when it goes
+		 * out of scope or when Slot::release() is called.
 		 */
-		static Lock getLock(const Path& path)
-		{
-			return Lock(mMutex);
-		}
+		static Slot getLock(const Path& path);
+
+		/** 
+		 * Registers the type of the storage device located at the provided root path (e.g. a drive letter or a mount
+		 * point). All files within the root will share the access slots of that device.
+		 */
+		static void setDeviceType(const Path& root, StorageDeviceType type);
+
+		/** Sets the type assumed for devices that weren't registered through setDeviceType(). Default is SSD. */
+		static void setDefaultDeviceType(StorageDeviceType type);
+
+		/** 
+		 * Sets the maximum number of files that may be accessed concurrently on a single device of the specified type.
+		 * Defaults are 4 for SSD and 1 for HDD.
+		 */
+		static void setMaxConcurrentAccesses(StorageDeviceType type, UINT32 count);
+
+		/** Returns the maximum number of files that may be accessed concurrently on a single device of the specified type. */
+		static UINT32 getMaxConcurrentAccesses(StorageDeviceType type);
 
 	private:
+		/** Storage device registered with setDeviceType(). */
+		struct DeviceRoot
+		{
+			Path root;
+			StorageDeviceType type;
+		};
+
+		/** 
+		 * Returns the name and type of the device the provided path belongs to. Caller must hold the mutex.
+		 *
+		 * @param[in]	path	Path to a file or a folder.
+		 * @param[out]	type	Type of the device the path belongs to.
+		 * @return				Unique name of the device.
+		 */
+		static String getDevice(const Path& path, StorageDeviceType& type);
+
+		/** 
+		 * Acquires an access slot on the device the path belongs to, waiting if none are available or if the path is
+		 * already being accessed.
+		 *
+		 * @param[in]	path	Path to the file to access.
+		 * @return				Absolute path of the file, as stored in the set of files being accessed.
+		 */
+		static String acquire(const Path& path);
+
+		/** 
+		 * Releases an access slot for a file previously acquired through acquire(). The slot is released on the device
+		 * it was acquired on, even if device roots have changed since.
+		 */
+		static void release(const String& file);
+
 		static Mutex mMutex;
+		static Signal mSlotReleased;
+		static UnorderedMap<String, UINT32> mNumActive;
+		static UnorderedMap<String, String> mActiveFiles; // Files being accessed, mapped to their device
+		static Vector<DeviceRoot> mDeviceRoots;
+		static StorageDeviceType mDefaultType;
+		static UINT32 mMaxConcurrentAccesses[2];
 	};
 
 	/** @} */
@@ -5,6 +5,7 @@
 #include "Debug/BsDebug.h"
 #include "Error/BsException.h"
 #include "FileSystem/BsFileSystem.h"
+#include "Threading/BsThreading.h"
 
 #include <algorithm>
 #include <fstream>
@@ -84,6 +85,8 @@ namespace bs
 		BS_ADD_TEST(FileSystemTestSuite::testGetChildren);
 		BS_ADD_TEST(FileSystemTestSuite::testGetLastModifiedTime);
 		BS_ADD_TEST(FileSystemTestSuite::testGetTempDirectoryPath);
+		BS_ADD_TEST(FileSystemTestSuite::testFileScheduler_same_path_exclusive);
+		BS_ADD_TEST(FileSystemTestSuite::testFileScheduler_device_change);
 	}
 
 	void FileSystemTestSuite::testExists_yes_file()
@@ -299,4 +302,68 @@ namespace bs
 		/* No judging. */
 		BS_TEST_ASSERT(!path.toString().empty());
 	}
+
+	void FileSystemTestSuite::testFileScheduler_same_path_exclusive()
+	{
+		Path path = mTestDirectory + "scheduled";
+		Path otherPath = mTestDirectory + "scheduledOther";
+
+		FileScheduler::Slot slot = FileScheduler::getLock(path);
+
+		std::atomic<bool> acquired(false);
+		Thread thread([&path, &acquired]()
+		{
+			FileScheduler::Slot otherSlot = FileScheduler::getLock(path);
+			acquired = true;
+		});
+
+		// Other files on the same device can still be accessed, while the same file must wait
+		{
+			FileScheduler::Slot otherSlot = FileScheduler::getLock(otherPath);
+		}
+
+		BS_THREAD_SLEEP(50);
+		BS_TEST_ASSERT(!acquired);
+
+		slot.release();
+		thread.join();
+		BS_TEST_ASSERT(acquired);
+	}
+
+	void FileSystemTestSuite::testFileScheduler_device_change()
+	{
+		Path path = mTestDirectory + "deviceChange/scheduled";
+		Path otherPath = mTestDirectory + "scheduledOther";
+
+		const UINT32 maxAccesses = FileScheduler::getMaxConcurrentAccesses(StorageDeviceType::SSD);
+		FileScheduler::setDefaultDeviceType(StorageDeviceType::SSD);
+		FileScheduler::setMaxConcurrentAccesses(StorageDeviceType::SSD, 1);
+
+		// Path is moved to a different device while its slot is held, but the slot must still be released on the device
+		// it was acquired on
+		FileScheduler::lock(path);
+		FileScheduler::setDeviceType(mTestDirectory + "deviceChange/", StorageDeviceType::SSD);
+		FileScheduler::unlock(path);
+
+		std::atomic<bool> acquired(false);
+		Thread thread([&otherPath, &acquired]()
+		{
+			// Matching paths against registered device roots uses the stack allocator
+			MemStack::beginThread();
+
+			{
+				FileScheduler::Slot otherSlot = FileScheduler::getLock(otherPath);
+				acquired = true;
+			}
+
+			MemStack::endThread();
+		});
+
+		BS_THREAD_SLEEP(50);
+		BS_TEST_ASSERT(acquired);
+
+		// Unblocks the thread if the slot leaked
+		FileScheduler::setMaxConcurrentAccesses(StorageDeviceType::SSD, maxAccesses);
+		thread.join();
+	}
 }
@@ -35,6 +35,8 @@ namespace bs
 		void testGetChildren();
 		void testGetLastModifiedTime();
 		void testGetTempDirectoryPath();
+		void testFileScheduler_same_path_exclusive();
+		void testFileScheduler_device_change();
 
 		Path mTestDirectory;
 	};
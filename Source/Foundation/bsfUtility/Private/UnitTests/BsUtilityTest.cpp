@@ -7,10 +7,14 @@ using namespace bs;
 
 int main()
 {
+	// Some of the tested systems use the stack allocator, normally set up by the application
+	MemStack::beginThread();
+
 	SPtr<TestSuite> tests = UtilityTestSuite::create<UtilityTestSuite>();
 
 	ConsoleTestOutput testOutput;
 	tests->run(testOutput);
 
+	MemStack::endThread();
 	return 0;
 }
\ No newline at end of file
@@ -3,6 +3,13 @@
 #include "Private/UnitTests/BsUtilityTestSuite.h"
 #include "Private/UnitTests/BsFileSystemTestSuite.h"
 #include "Utility/BsOctree.h"
+#include "Debug/BsProfilerTimeline.h"
+#include "Debug/BsHeapProfiler.h"
+#include "Debug/BsLog.h"
+#include "Allocators/BsPoolAlloc.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "ThirdParty/json.hpp"
 
 namespace bs
 {
@@ -38,6 +45,66 @@ namespace bs
 	};
 
 	typedef Octree<UINT32, DebugOctreeOptions> DebugOctree;
+
+	/** Single field of a protobuf message. Only varint and length delimited fields are supported. */
+	struct ProtobufField
+	{
+		UINT32 number;
+		UINT64 value; /**< Value of a varint field, or length of a length delimited field. */
+		const UINT8* data; /**< Contents of a length delimited field, null for varint fields. */
+	};
+
+	/** Reads a varint from the buffer and advances the read position. Returns false if the buffer ends first. */
+	bool readProtobufVarint(const UINT8*& data, const UINT8* end, UINT64& value)
+	{
+		value = 0;
+		for (UINT32 shift = 0; data < end && shift < 64; shift += 7)
+		{
+			const UINT8 byte = *data++;
+			value |= (UINT64)(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	/** Splits a protobuf message into its fields. Returns false if the message is malformed. */
+	bool readProtobufMessage(const UINT8* data, UINT64 size, Vector<ProtobufField>& fields)
+	{
+		const UINT8* end = data + size;
+		while (data < end)
+		{
+			UINT64 key;
+			if (!readProtobufVarint(data, end, key))
+				return false;
+
+			ProtobufField field;
+			field.number = (UINT32)(key >> 3);
+			field.data = nullptr;
+
+			if (!readProtobufVarint(data, end, field.value))
+				return false;
+
+			const UINT32 wireType = (UINT32)(key & 0x7);
+			if (wireType == 2)
+			{
+				if (field.value > (UINT64)(end - data))
+					return false;
+
+				field.data = data;
+				data += field.value;
+			}
+			else if (wireType != 0)
+				return false;
+
+			fields.push_back(field);
+		}
+
+		return true;
+	}
+
 	void UtilityTestSuite::startUp()
 	{
 		SPtr<TestSuite> fileSystemTests = create<FileSystemTestSuite>();
@@ -51,6 +118,10 @@ namespace bs
 	UtilityTestSuite::UtilityTestSuite()
 	{
 		BS_ADD_TEST(UtilityTestSuite::testOctree);
+		BS_ADD_TEST(UtilityTestSuite::testProfilerTimeline);
+		BS_ADD_TEST(UtilityTestSuite::testAllocationTracking);
+		BS_ADD_TEST(UtilityTestSuite::testThreadCachedPoolAlloc);
+		BS_ADD_TEST(UtilityTestSuite::testLogRateLimit);
 	}
 
 	void UtilityTestSuite::testOctree()
@@ -143,4 +214,440 @@ namespace bs
 		for(auto& entry : octreeData.elements)
 			octree.removeElement(entry.octreeId);
 	}
+
+	void UtilityTestSuite::testProfilerTimeline()
+	{
+		using json = nlohmann::json;
+
+		// Events outside of a recording are ignored
+		ProfilerTimeline::beginEvent("Ignored");
+
+		ProfilerTimeline::startRecording();
+		ProfilerTimeline::setThreadName("Main");
+
+		// End of an event started before recording, must not appear in the trace
+		ProfilerTimeline::endEvent();
+
+		ProfilerTimeline::beginEvent("Outer");
+		ProfilerTimeline::beginEvent("Inner");
+		ProfilerTimeline::endEvent();
+
+		const UINT32 numQueues = ProfilerTimeline::_getNumThreadQueues();
+
+		Thread thread([]()
+		{
+			ProfilerTimeline::setThreadName("Other");
+
+			for (UINT32 i = 0; i < 10; i++)
+			{
+				ProfilerTimeline::beginEvent("Work");
+				ProfilerTimeline::endEvent();
+			}
+		});
+		thread.join();
+
+		// "Outer" is never ended, and should get closed automatically
+		ProfilerTimeline::stopRecording();
+
+		// Queue of the finished thread is freed once drained, while its events are kept
+		BS_TEST_ASSERT(ProfilerTimeline::_getNumThreadQueues() == numQueues);
+
+		const Path path = FileSystem::getWorkingDirectoryPath() + "TimelineTest.json";
+		BS_TEST_ASSERT(ProfilerTimeline::save(path, TimelineFormat::ChromeJSON));
+
+		SPtr<DataStream> stream = FileSystem::openFile(path);
+		json trace = json::parse(stream->getAsString().c_str());
+		stream->close();
+		FileSystem::remove(path);
+
+		Map<String, INT32> threadIds;
+		Map<INT32, INT32> depths;
+		Map<String, UINT32> numBegins;
+		for (auto& event : trace["traceEvents"])
+		{
+			const String type = event["ph"].get<std::string>().c_str();
+			const INT32 tid = event["tid"].get<INT32>();
+
+			if (type == "M")
+				threadIds[event["args"]["name"].get<std::string>().c_str()] = tid;
+			else if (type == "B")
+			{
+				numBegins[event["name"].get<std::string>().c_str()]++;
+				depths[tid]++;
+			}
+			else if (type == "E")
+			{
+				BS_TEST_ASSERT(depths[tid] > 0);
+				depths[tid]--;
+			}
+		}
+
+		BS_TEST_ASSERT(threadIds.size() == 2);
+		BS_TEST_ASSERT(threadIds.find("Main") != threadIds.end() && threadIds.find("Other") != threadIds.end());
+
+		for (auto& entry : depths)
+			BS_TEST_ASSERT(entry.second == 0);
+
+		BS_TEST_ASSERT(numBegins.size() == 3);
+		BS_TEST_ASSERT(numBegins["Outer"] == 1 && numBegins["Inner"] == 1 && numBegins["Work"] == 10);
+
+		// Same events in the Perfetto format, parsed back from the protobuf encoded packets
+		const Path perfettoPath = FileSystem::getWorkingDirectoryPath() + "TimelineTest.perfetto-trace";
+		BS_TEST_ASSERT(ProfilerTimeline::save(perfettoPath, TimelineFormat::Perfetto));
+
+		stream = FileSystem::openFile(perfettoPath);
+		Vector<UINT8> perfettoData((size_t)stream->size());
+		stream->read(perfettoData.data(), perfettoData.size());
+		stream->close();
+		FileSystem::remove(perfettoPath);
+
+		Vector<ProtobufField> packets;
+		BS_TEST_ASSERT(readProtobufMessage(perfettoData.data(), perfettoData.size(), packets));
+
+		Map<String, UINT64> trackUuids;
+		Map<UINT64, INT32> trackDepths;
+		Map<UINT64, UINT64> trackTimes;
+		Map<String, UINT32> numPerfettoBegins;
+		for (auto& packet : packets)
+		{
+			BS_TEST_ASSERT(packet.number == 1 && packet.data != nullptr);
+
+			Vector<ProtobufField> packetFields;
+			BS_TEST_ASSERT(readProtobufMessage(packet.data, packet.value, packetFields));
+
+			UINT64 timestamp = 0;
+			const ProtobufField* trackEvent = nullptr;
+			const ProtobufField* trackDescriptor = nullptr;
+			for (auto& field : packetFields)
+			{
+				if (field.number == 8)
+					timestamp = field.value;
+				else if (field.number == 11)
+					trackEvent = &field;
+				else if (field.number == 60)
+					trackDescriptor = &field;
+			}
+
+			if (trackDescriptor != nullptr)
+			{
+				Vector<ProtobufField> descriptorFields;
+				BS_TEST_ASSERT(readProtobufMessage(trackDescriptor->data, trackDescriptor->value, descriptorFields));
+
+				UINT64 uuid = 0;
+				String threadName;
+				for (auto& field : descriptorFields)
+				{
+					if (field.number == 1)
+						uuid = field.value;
+					else if (field.number == 4)
+					{
+						Vector<ProtobufField> threadFields;
+						BS_TEST_ASSERT(readProtobufMessage(field.data, field.value, threadFields));
+
+						for (auto& threadField : threadFields)
+						{
+							if (threadField.number == 5)
+								threadName = String((const char*)threadField.data, (size_t)threadField.value);
+						}
+					}
+				}
+
+				trackUuids[threadName] = uuid;
+			}
+
+			if (trackEvent != nullptr)
+			{
+				Vector<ProtobufField> eventFields;
+				BS_TEST_ASSERT(readProtobufMessage(trackEvent->data, trackEvent->value, eventFields));
+
+				UINT64 type = 0;
+				UINT64 uuid = 0;
+				String name;
+				for (auto& field : eventFields)
+				{
+					if (field.number == 9)
+						type = field.value;
+					else if (field.number == 11)
+						uuid = field.value;
+					else if (field.number == 23)
+						name = String((const char*)field.data, (size_t)field.value);
+				}
+
+				// Events on a single track are written in order
+				BS_TEST_ASSERT(timestamp >= trackTimes[uuid]);
+				trackTimes[uuid] = timestamp;
+
+				if (type == 1)
+				{
+					numPerfettoBegins[name]++;
+					trackDepths[uuid]++;
+				}
+				else if (type == 2)
+				{
+					BS_TEST_ASSERT(trackDepths[uuid] > 0);
+					trackDepths[uuid]--;
+				}
+			}
+		}
+
+		BS_TEST_ASSERT(trackUuids.size() == 2);
+		BS_TEST_ASSERT(trackUuids.find("Main") != trackUuids.end() && trackUuids.find("Other") != trackUuids.end());
+		BS_TEST_ASSERT(trackUuids["Main"] != trackUuids["Other"]);
+
+		for (auto& entry : trackDepths)
+		{
+			BS_TEST_ASSERT(trackUuids["Main"] == entry.first || trackUuids["Other"] == entry.first);
+			BS_TEST_ASSERT(entry.second == 0);
+		}
+
+		BS_TEST_ASSERT(numPerfettoBegins.size() == 3);
+		BS_TEST_ASSERT(numPerfettoBegins["Outer"] == 1 && numPerfettoBegins["Inner"] == 1 &&
+			numPerfettoBegins["Work"] == 10);
+
+		ProfilerTimeline::clear();
+	}
+
+	void UtilityTestSuite::testAllocationTracking()
+	{
+		// Bytes are attributed to the category of the allocator that allocated them
+		UINT64 startBytes[(int)MemoryCategory::Count];
+		for (int i = 0; i < (int)MemoryCategory::Count; i++)
+			startBytes[i] = MemoryCounter::getNumAllocBytes((MemoryCategory)i);
+
+		void* general = bs_alloc(100);
+
+		FrameAlloc frameAlloc;
+		UINT8* frame = frameAlloc.alloc(64);
+
+		PoolAlloc<32, 16> poolAlloc;
+		UINT8* pool = poolAlloc.alloc();
+
+		BS_TEST_ASSERT(MemoryCounter::getNumAllocBytes(MemoryCategory::Frame) - startBytes[(int)MemoryCategory::Frame] == 64);
+		BS_TEST_ASSERT(MemoryCounter::getNumAllocBytes(MemoryCategory::Pool) - startBytes[(int)MemoryCategory::Pool] == 32);
+
+		// Frame and pool allocators allocate their blocks from the general allocator as well
+		BS_TEST_ASSERT(MemoryCounter::getNumAllocBytes(MemoryCategory::General) - startBytes[(int)MemoryCategory::General] >= 100);
+
+		poolAlloc.free(pool);
+		frameAlloc.free(frame);
+		bs_free(general);
+
+		// With an interval of one byte every allocation gets sampled
+		HeapProfiler::start(1);
+		BS_TEST_ASSERT(HeapProfiler::isRunning());
+
+		const UINT32 trackedSize = 123457;
+		void* tracked = bs_alloc(trackedSize);
+
+		String report = HeapProfiler::report();
+		BS_TEST_ASSERT(report.find(toString(trackedSize) + " bytes in use (1 samples)") != String::npos);
+
+		bs_free(tracked);
+
+		report = HeapProfiler::report();
+		BS_TEST_ASSERT(report.find(toString(trackedSize) + " bytes in use") == String::npos);
+		BS_TEST_ASSERT(report.find(toString(trackedSize) + " bytes allocated (1 samples)") != String::npos);
+
+		HeapProfiler::stop();
+		BS_TEST_ASSERT(!HeapProfiler::isRunning());
+	}
+
+	void UtilityTestSuite::testThreadCachedPoolAlloc()
+	{
+		ThreadCachedPoolAlloc<24, 64, 8, 16> poolAlloc;
+
+		Vector<UINT8*> elems;
+		for (UINT32 i = 0; i < 100; i++)
+			elems.push_back(poolAlloc.alloc());
+
+		for (UINT32 i = 0; i < 100; i++)
+			BS_TEST_ASSERT(((size_t)elems[i] % 8) == 0);
+
+		std::sort(elems.begin(), elems.end());
+		BS_TEST_ASSERT(std::unique(elems.begin(), elems.end()) == elems.end());
+
+		PoolAllocStats stats = poolAlloc.getStats();
+		BS_TEST_ASSERT(stats.numLive == 100);
+		BS_TEST_ASSERT(stats.highWaterMark >= 100);
+		BS_TEST_ASSERT(stats.numReserved >= 100);
+
+		// Free the elements on another thread, which then returns them to the shared storage for re-use
+		Thread thread([&poolAlloc, &elems]()
+		{
+			for (auto& elem : elems)
+				poolAlloc.free(elem);
+
+			ThreadCachedPoolAllocBase::releaseThreadCaches();
+		});
+		thread.join();
+
+		stats = poolAlloc.getStats();
+		BS_TEST_ASSERT(stats.numLive == 0);
+		UINT64 numReserved = stats.numReserved;
+
+		// Threads allocating and freeing concurrently should be able to re-use the existing elements
+		Vector<Thread> threads;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			threads.push_back(Thread([&poolAlloc]()
+			{
+				for (UINT32 j = 0; j < 1000; j++)
+				{
+					UINT32* elem = poolAlloc.construct<UINT32>(j);
+					if (*elem == j)
+						poolAlloc.destruct(elem);
+				}
+
+				ThreadCachedPoolAllocBase::releaseThreadCaches();
+			}));
+		}
+
+		for (auto& entry : threads)
+			entry.join();
+
+		stats = poolAlloc.getStats();
+		BS_TEST_ASSERT(stats.numLive == 0);
+		BS_TEST_ASSERT(stats.numReserved == numReserved);
+
+		// Elements allocated by producers and freed by consumers should flow back to the producers through the shared
+		// storage, once they overflow the consumers' caches. Threads don't release their caches explicitly, which should
+		// happen automatically when they exit.
+		const UINT32 numProducers = 2;
+		const UINT32 numElemsPerProducer = 20000;
+		const UINT32 maxQueued = 256;
+
+		Mutex queueMutex;
+		Signal queueSignal;
+		Deque<UINT8*> queue;
+		UINT32 numConsumed = 0;
+
+		threads.clear();
+		for (UINT32 i = 0; i < numProducers; i++)
+		{
+			threads.push_back(Thread([&]()
+			{
+				for (UINT32 j = 0; j < numElemsPerProducer; j++)
+				{
+					UINT8* elem = poolAlloc.alloc();
+
+					Lock lock(queueMutex);
+					while (queue.size() >= maxQueued)
+						queueSignal.wait(lock);
+
+					queue.push_back(elem);
+					queueSignal.notify_all();
+				}
+			}));
+
+			threads.push_back(Thread([&]()
+			{
+				Lock lock(queueMutex);
+				while (true)
+				{
+					while (queue.empty() && numConsumed < numProducers * numElemsPerProducer)
+						queueSignal.wait(lock);
+
+					if (queue.empty())
+						break;
+
+					UINT8* elem = queue.front();
+					queue.pop_front();
+					numConsumed++;
+					queueSignal.notify_all();
+
+					lock.unlock();
+					poolAlloc.free(elem);
+					lock.lock();
+				}
+			}));
+		}
+
+		for (auto& entry : threads)
+			entry.join();
+
+		// Only the queued elements and the thread caches should ever be reserved, far less than the total allocated
+		stats = poolAlloc.getStats();
+		BS_TEST_ASSERT(stats.numLive == 0);
+		BS_TEST_ASSERT(stats.numReserved <= 1024);
+
+		// All the free elements cached by the exited threads should be available again
+		numReserved = stats.numReserved;
+
+		elems.clear();
+		for (UINT64 i = 0; i < numReserved; i++)
+			elems.push_back(poolAlloc.alloc());
+
+		stats = poolAlloc.getStats();
+		BS_TEST_ASSERT(stats.numReserved == numReserved);
+
+		for (auto& elem : elems)
+			poolAlloc.free(elem);
+	}
+
+	void UtilityTestSuite::testLogRateLimit()
+	{
+		Log log;
+		log.setRateLimit(2, 50);
+		log.setRateLimited(1, false);
+
+		for (UINT32 i = 0; i < 5; i++)
+		{
+			log.logMsg("Repeated", 0);
+			log.logMsg("Exempt", 1);
+		}
+
+		UINT32 numRepeated = 0;
+		UINT32 numExempt = 0;
+		LogEntry entry;
+		while (log.getUnreadEntry(entry))
+		{
+			BS_TEST_ASSERT(entry.getNumSuppressed() == 0);
+
+			if (entry.getChannel() == 0)
+				numRepeated++;
+			else
+				numExempt++;
+		}
+
+		BS_TEST_ASSERT(numRepeated == 2);
+		BS_TEST_ASSERT(numExempt == 5);
+
+		// Suppressed messages are reported once the interval ends, without waiting for the message to repeat
+		BS_THREAD_SLEEP(60);
+		log.flush();
+
+		BS_TEST_ASSERT(log.getUnreadEntry(entry));
+		BS_TEST_ASSERT(entry.getMessage() == "Repeated");
+		BS_TEST_ASSERT(entry.getNumSuppressed() == 3);
+		BS_TEST_ASSERT(!log.getUnreadEntry(entry));
+
+		// Messages logged by threads that have exited must not get lost
+		Thread thread([&log]() { log.logMsg("Other thread", 0); });
+		thread.join();
+		log.flush();
+
+		BS_TEST_ASSERT(log.getUnreadEntry(entry));
+		BS_TEST_ASSERT(entry.getMessage() == "Other thread");
+
+		// Messages are limited separately per message and channel
+		for (UINT32 i = 0; i < 5; i++)
+		{
+			log.logMsg("Shared", 2);
+			log.logMsg("Shared", 3);
+			log.logMsg("Different", 2);
+		}
+
+		UINT32 numShared[2] = { 0, 0 };
+		UINT32 numDifferent = 0;
+		while (log.getUnreadEntry(entry))
+		{
+			if (entry.getMessage() == "Different")
+				numDifferent++;
+			else
+				numShared[entry.getChannel() - 2]++;
+		}
+
+		BS_TEST_ASSERT(numShared[0] == 2 && numShared[1] == 2);
+		BS_TEST_ASSERT(numDifferent == 2);
+	}
 }
@@ -15,5 +15,9 @@ namespace bs
 
 	private:
 		void testOctree();
+		void testProfilerTimeline();
+		void testAllocationTracking();
+		void testThreadCachedPoolAlloc();
+		void testLogRateLimit();
 	};
 }
@@ -67,7 +67,13 @@ namespace bs
 		 * would not contribute to the reference search anyway. Whether or not a field contributes to the reference
 		 * search depends on the search and should be handled on a case by case basis.
 		 */
-		RTTI_Flag_SkipInReferenceSearch = 0x02
+		RTTI_Flag_SkipInReferenceSearch = 0x02,
+		/**
+		 * Only used on data block fields. Signals that the field keeps a reference to the provided stream in order to
+		 * stream the data later, instead of reading it during deserialization. When decoding data that was read into
+		 * memory from a file, such fields are provided with the file instead of the in-memory copy.
+		 */
+		RTTI_Flag_StreamedDataBlock = 0x04
 	};
 
 	/**
@@ -131,6 +131,21 @@ namespace bs
 		return _decodeFromIntermediate(intermediateObject);
 	}
 
+	SPtr<IReflectable> BinarySerializer::decode(const SPtr<DataStream>& data, UINT32 dataLength,
+		const SPtr<DataStream>& file, UINT32 fileOffset, const UnorderedMap<String, UINT64>& params)
+	{
+		// Offset of the data within the file, minus its current position in the buffer
+		mDataBlockFile = file;
+		mDataBlockFileOffset = fileOffset - (UINT32)data->tell();
+
+		SPtr<IReflectable> output = decode(data, dataLength, params);
+
+		mDataBlockFile = nullptr;
+		mDataBlockFileOffset = 0;
+
+		return output;
+	}
+
 	SPtr<IReflectable> BinarySerializer::_decodeFromIntermediate(const SPtr<SerializedObject>& serializedObject)
 	{
 		mObjectMap.clear();
@@ -828,7 +843,14 @@ namespace bs
 					{
 						SPtr<SerializedDataBlock> serializedDataBlock = bs_shared_ptr_new<SerializedDataBlock>();
 
-						if (streamDataBlock || !copyData)
+						if (mDataBlockFile != nullptr && (curField->getFlags() & RTTI_Flag_StreamedDataBlock) != 0)
+						{
+							serializedDataBlock->stream = mDataBlockFile;
+							serializedDataBlock->offset = mDataBlockFileOffset + (UINT32)data->tell();
+
+							data->skip(dataBlockSize);
+						}
+						else if (streamDataBlock || !copyData)
 						{
 							serializedDataBlock->stream = data;
 							serializedDataBlock->offset = (UINT32)data->tell();
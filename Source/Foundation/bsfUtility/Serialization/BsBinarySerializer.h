@@ -77,6 +77,21 @@ namespace bs
 		SPtr<IReflectable> decode(const SPtr<DataStream>& data, UINT32 dataLength, 
 			const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
 
+		/**
+		 * Decodes an object from binary data that was read into memory from a file. Same as decode(), except that data
+		 * blocks of fields flagged with RTTI_Flag_StreamedDataBlock reference the file directly, so the in-memory copy
+		 * doesn't need to be kept around for them to be streamed. Other data blocks are read from the in-memory copy.
+		 *
+		 * @param[in]	data  		Binary data to decode.
+		 * @param[in]	dataLength	Length of the data in bytes.
+		 * @param[in]	file		File stream the data was read from.
+		 * @param[in]	fileOffset	Offset in the file at which the data starts.
+		 * @param[in]	params		Optional parameters to be passed to the serialization callbacks on the objects being
+		 *							serialized.
+		 */
+		SPtr<IReflectable> decode(const SPtr<DataStream>& data, UINT32 dataLength, const SPtr<DataStream>& file,
+			UINT32 fileOffset, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
+
 		/** @name Internal 
 		 *  @{
 		 */
@@ -203,6 +218,10 @@ namespace bs
 
 		UnorderedMap<String, UINT64> mParams;
 
+		// File that streamed data blocks reference, and the offset of the decoded data within it
+		SPtr<DataStream> mDataBlockFile;
+		UINT32 mDataBlockFileOffset = 0;
+
 		static constexpr const int META_SIZE = 4; // Meta field size
 		static constexpr const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static constexpr const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsTaskScheduler.h"
 #include "Threading/BsThreadPool.h"
+#include "Debug/BsProfilerTimeline.h"
 
 namespace bs
 {
@@ -200,6 +201,7 @@ namespace bs
 
 				curTask->mState.store(1);
 				mActiveTasks.push_back(curTask);
+				mNumActiveTasks.fetch_add(1, std::memory_order_relaxed);
 
 				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
 			}
@@ -208,14 +210,22 @@ namespace bs
 
 	void TaskScheduler::runTask(SPtr<Task> task)
 	{
+		ProfilerTimeline::setThreadName("Worker");
+		ProfilerTimeline::beginEvent(task->mName.c_str());
+
 		task->mTaskWorker();
 
+		ProfilerTimeline::endEvent();
+
 		{
 			Lock lock(mReadyMutex);
 
 			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
 			if (findIter != mActiveTasks.end())
+			{
 				mActiveTasks.erase(findIter);
+				mNumActiveTasks.fetch_sub(1, std::memory_order_relaxed);
+			}
 		}
 
 		{
@@ -161,6 +161,12 @@ namespace bs
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/** 
+		 * Returns the number of tasks currently being executed. The value can be out of date as soon as it is returned, so
+		 * it should only be used as a hint (e.g. to avoid busy-waiting while workers are occupied).
+		 */
+		UINT32 getNumActiveTasks() const { return mNumActiveTasks.load(std::memory_order_relaxed); }
 	protected:
 		friend class Task;
 		friend class TaskGroup;
@@ -183,6 +189,7 @@ namespace bs
 		HThread mTaskSchedulerThread;
 		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
 		Vector<SPtr<Task>> mActiveTasks;
+		std::atomic<UINT32> mNumActiveTasks { 0 };
 		UINT32 mMaxActiveTasks = 0;
 		UINT32 mNextTaskId = 0;
 		bool mShutdown = false;
@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsThreadPool.h"
+#include "Allocators/BsPoolAlloc.h"
 #include "Debug/BsDebug.h"
 
 #if BS_PLATFORM == BS_PLATFORM_WIN32
@@ -105,6 +106,7 @@ namespace bs
 				if (worker == nullptr)
 				{
 					onThreadEnded(mName);
+					ThreadCachedPoolAllocBase::releaseThreadCaches();
 					return;
 				}
 			}
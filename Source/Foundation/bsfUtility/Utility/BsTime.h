@@ -52,6 +52,12 @@ namespace bs
 		/** Returns the time (in seconds) the latest fixed update has started. */
 		float getLastFixedUpdateTime() const { return (float)(mLastFixedUpdateTime * MICROSEC_TO_SEC); }
 
+		/** 
+		 * Returns the time (in microseconds) the latest fixed update has started. Uses the same time base as
+		 * getTimePrecise().
+		 */
+		UINT64 getLastFixedUpdateTimePrecise() const { return mLastFixedUpdateTime; }
+
 		/**
 		 * Returns the sequential index of the current frame. First frame is 0.
 		 *
@@ -10,6 +10,7 @@
 #include "Math/BsVector2.h"
 #include "Math/BsVector3.h"
 #include "Math/BsVector4.h"
+#include "Math/BsMath.h"
 #include "RenderAPI/BsVertexDataDesc.h"
 #include "BsFBXUtility.h"
 #include "Mesh/BsMeshUtility.h"
@@ -126,7 +127,8 @@ namespace bs
 		if (meshImportOptions->getCPUCached())
 			desc.usage |= MU_CPUCACHED;
 
-		SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->getData(), desc);
+		SPtr<MeshData> meshData = generateLODs(filePath, rendererMeshData->getData(), *meshImportOptions, desc);
+		SPtr<Mesh> mesh = Mesh::_createPtr(meshData, desc);
 
 		const String fileName = filePath.getFilename(false);
 		mesh->setName(fileName);
@@ -148,7 +150,8 @@ namespace bs
 		if (meshImportOptions->getCPUCached())
 			desc.usage |= MU_CPUCACHED;
 
-		SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->getData(), desc);
+		SPtr<MeshData> meshData = generateLODs(filePath, rendererMeshData->getData(), *meshImportOptions, desc);
+		SPtr<Mesh> mesh = Mesh::_createPtr(meshData, desc);
 
 		const String fileName = filePath.getFilename(false);
 		mesh->setName(fileName);
@@ -248,13 +251,60 @@ namespace bs
 			convertAnimations(importedScene.clips, splits, skeleton, meshImportOptions->getImportRootMotion(), animation);
 		}
 
-		// TODO - Later: Optimize mesh: Remove bad and degenerate polygons, weld nearby vertices, optimize for vertex cache
+		// TODO - Later: Optimize mesh: Remove bad and degenerate polygons, weld nearby vertices
+		if (meshImportOptions->getOptimize() && rendererMeshData != nullptr)
+		{
+			// Morph shapes reference vertices by index, so only the triangles can be reordered
+			MeshOptimizationStats stats = MeshUtility::optimize(*rendererMeshData->getData(), subMeshes, 
+				morphShapes == nullptr);
+
+			LOGDBG("Optimized mesh \"" + filePath.toString() + "\". ACMR before: " + toString(stats.acmrBefore) + 
+				", after: " + toString(stats.acmrAfter) + ".");
+		}
 
 		shutDownSdk();
 
 		return rendererMeshData;
 	}
 
+	SPtr<MeshData> FBXImporter::generateLODs(const Path& filePath, const SPtr<MeshData>& meshData, 
+		const MeshImportOptions& importOptions, MESH_DESC& desc)
+	{
+		// Maximum error introduced by the first level of detail, relative to the mesh size
+		static constexpr float LOD_MAX_ERROR = 0.01f;
+
+		if (importOptions.getLODCount() == 0 || meshData == nullptr)
+			return meshData;
+
+		float reduction = Math::clamp(importOptions.getLODReduction(), 0.05f, 0.95f);
+		SPtr<MeshData> output = MeshUtility::generateLODs(meshData, desc.subMeshes, importOptions.getLODCount(), 
+			reduction, LOD_MAX_ERROR, desc.lods);
+
+		// Original indices are already optimized, if requested, but the newly generated ones are not
+		if (importOptions.getOptimize())
+		{
+			UINT8* indices = output->getIndexData();
+			const UINT32 indexSize = output->getIndexElementSize();
+
+			for (auto& lod : desc.lods)
+			{
+				for (auto& subMesh : lod.subMeshes)
+				{
+					if (subMesh.drawOp != DOT_TRIANGLE_LIST || subMesh.indexOffset < meshData->getNumIndices())
+						continue;
+
+					MeshUtility::optimizeVertexCache(indices + subMesh.indexOffset * indexSize, subMesh.indexCount,
+						output->getNumVertices(), indexSize);
+				}
+			}
+		}
+
+		LOGDBG("Generated " + toString((UINT32)desc.lods.size()) + " levels of detail for mesh \"" + 
+			filePath.toString() + "\".");
+
+		return output;
+	}
+
 	SPtr<Skeleton> FBXImporter::createSkeleton(const FBXImportScene& scene, bool sharedRoot)
 	{
 		Vector<BONE_DESC> allBones;
@@ -494,7 +544,7 @@ namespace bs
 		int lSDKMajor,  lSDKMinor,  lSDKRevision;
 		FbxManager::GetFileFormatVersion(lSDKMajor, lSDKMinor, lSDKRevision);
 
-		Lock fileLock = FileScheduler::getLock(filePath);
+		FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
 		FbxImporter* importer = FbxImporter::Create(mFBXManager, "");
 		bool importStatus = importer->Initialize(filePath.toString().c_str(), -1, mFBXManager->GetIOSettings());
 		
@@ -17,6 +17,7 @@ namespace bs
 
 	struct AnimationSplitInfo;
 	class MorphShapes;
+	struct MESH_DESC;
 
 	/** Importer implementation that handles FBX/OBJ/DAE/3DS file import by using the FBX SDK. */
 	class FBXImporter : public SpecificImporter
@@ -59,6 +60,13 @@ namespace bs
 			Vector<SubMesh>& subMeshes, Vector<FBXAnimationClipData>& animationClips, SPtr<Skeleton>& skeleton, 
 			SPtr<MorphShapes>& morphShapes);
 
+		/**
+		 * Generates levels of detail for the mesh if requested by the import options. Returns mesh data containing the
+		 * indices of all levels, and outputs their sub-meshes in @p desc.
+		 */
+		SPtr<MeshData> generateLODs(const Path& filePath, const SPtr<MeshData>& meshData, 
+			const MeshImportOptions& importOptions, MESH_DESC& desc);
+
 		/**
 		 * Loads the data from the file at the provided path into the provided FBX scene. Returns false if the file
 		 * couldn't be loaded.
@@ -50,7 +50,7 @@ namespace bs
 
 		FMOD::Sound* sound;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
 
 			String pathStr = filePath.toString();
 			if (gFMODAudio()._getFMOD()->createSound(pathStr.c_str(), FMOD_CREATESAMPLE, nullptr, &sound) != FMOD_OK)
@@ -125,7 +125,8 @@ namespace bs
 			UINT32 monoBufferSize = numSamplesPerChannel * bytesPerSample;
 			UINT8* monoBuffer = (UINT8*)bs_alloc(monoBufferSize);
 
-			AudioUtility::convertToMono(sampleBuffer, monoBuffer, info.bitDepth, numSamplesPerChannel, info.numChannels);
+			AudioUtility::convertToMono(sampleBuffer, monoBuffer, info.bitDepth, numSamplesPerChannel, info.numChannels,
+				AudioConversionMode::Parallel);
 
 			info.numSamples = numSamplesPerChannel;
 			info.numChannels = 1;
@@ -142,7 +143,8 @@ namespace bs
 			UINT32 outBufferSize = info.numSamples * (clipIO->getBitDepth() / 8);
 			UINT8* outBuffer = (UINT8*)bs_alloc(outBufferSize);
 
-			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, clipIO->getBitDepth(), info.numSamples);
+			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, clipIO->getBitDepth(), info.numSamples,
+				AudioConversionMode::Parallel);
 
 			info.bitDepth = clipIO->getBitDepth();
 
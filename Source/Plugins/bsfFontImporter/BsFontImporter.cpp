@@ -8,10 +8,9 @@
 #include "BsCoreApplication.h"
 #include "CoreThread/BsCoreThread.h"
 
-#include <ft2build.h>
-#include <freetype/freetype.h>
-#include FT_FREETYPE_H
+#include "BsFontRasterizer.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 
 using namespace std::placeholders;
 
@@ -47,6 +46,35 @@ namespace bs
 	{
 		const FontImportOptions* fontImportOptions = static_cast<const FontImportOptions*>(importOptions.get());
 
+		// Dynamic fonts just store the font file and render glyphs at runtime
+		if (fontImportOptions->getDynamic())
+		{
+			// Glyphs are cached per size and character only, so all of them must share the same style
+			if (fontImportOptions->getBold() || fontImportOptions->getItalic())
+			{
+				LOGWRN("Bold and italic styles are not supported for dynamic fonts and will be ignored. Import a font "
+					"file with the desired style instead: " + filePath.toString());
+			}
+
+			Vector<UINT8> fontFileData;
+			{
+				FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
+
+				SPtr<DataStream> stream = FileSystem::openFile(filePath);
+				if (stream == nullptr)
+					BS_EXCEPT(InternalErrorException, "Failed to load font file: " + filePath.toString() + ".");
+
+				fontFileData.resize(stream->size());
+				stream->read(fontFileData.data(), fontFileData.size());
+			}
+
+			SPtr<Font> newFont = Font::_createDynamicPtr(fontFileData, fontImportOptions->getDPI(), 
+				fontImportOptions->getRenderMode());
+
+			newFont->setName(filePath.getFilename(false));
+			return newFont;
+		}
+
 		FT_Library library;
 
 		FT_Error error = FT_Init_FreeType(&library);
@@ -56,7 +84,7 @@ namespace bs
 		FT_Face face;
 
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
 			error = FT_New_Face(library, filePath.toString().c_str(), 0, &face);
 		}
 
@@ -73,26 +101,12 @@ namespace bs
 		Vector<UINT32> fontSizes = fontImportOptions->getFontSizes();
 		UINT32 dpi = fontImportOptions->getDPI();
 
-		FT_Int32 loadFlags;
-		switch (fontImportOptions->getRenderMode())
-		{
-		case FontRenderMode::Smooth:
-			loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
-			break;
-		case FontRenderMode::Raster:
-			loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_HINTING;
-			break;
-		case FontRenderMode::HintedSmooth:
-			loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_AUTOHINT;
-			break;
-		case FontRenderMode::HintedRaster:
-			loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_AUTOHINT;
-			break;
-		default:
-			loadFlags = FT_LOAD_TARGET_NORMAL;
-			break;
-		}
+		// Distance field fonts only need a single bitmap, which is scaled to any size at runtime
+		bool distanceField = fontImportOptions->getDistanceField();
+		if (distanceField && !fontSizes.empty())
+			fontSizes = { *std::max_element(fontSizes.begin(), fontSizes.end()) };
 
+		FT_Int32 loadFlags = getFreeTypeLoadFlags(fontImportOptions->getRenderMode());
 		FT_Render_Mode renderMode = FT_LOAD_TARGET_MODE(loadFlags);
 
 		Vector<SPtr<FontBitmap>> dataPerSize;
@@ -121,6 +135,11 @@ namespace bs
 
 			SPtr<FontBitmap> fontData = bs_shared_ptr_new<FontBitmap>();
 
+			// Distance fields need room around the glyph to fade out, scaled with the font size so the edge quality
+			// remains consistent
+			UINT32 spread = distanceField ? std::max(2U, fontSizes[i] / 8) : 0;
+			auto getPaddedSize = [spread](UINT32 size) { return size > 0 ? size + spread * 2 : 0; };
+
 			// Get all char sizes so we can generate texture layout
 			Vector<TextureAtlasUtility::Element> atlasElements;
 			Map<UINT32, UINT32> seqIdxToCharIdx;
@@ -141,8 +160,8 @@ namespace bs
 					FT_GlyphSlot slot = face->glyph;
 
 					TextureAtlasUtility::Element atlasElement;
-					atlasElement.input.width = slot->bitmap.width;
-					atlasElement.input.height = slot->bitmap.rows;
+					atlasElement.input.width = getPaddedSize(slot->bitmap.width);
+					atlasElement.input.height = getPaddedSize(slot->bitmap.rows);
 
 					atlasElements.push_back(atlasElement);
 					seqIdxToCharIdx[(UINT32)atlasElements.size() - 1] = charIdx;
@@ -164,8 +183,8 @@ namespace bs
 				FT_GlyphSlot slot = face->glyph;
 
 				TextureAtlasUtility::Element atlasElement;
-				atlasElement.input.width = slot->bitmap.width;
-				atlasElement.input.height = slot->bitmap.rows;
+				atlasElement.input.width = getPaddedSize(slot->bitmap.width);
+				atlasElement.input.height = getPaddedSize(slot->bitmap.rows);
 
 				atlasElements.push_back(atlasElement);
 			}
@@ -226,43 +245,21 @@ namespace bs
 					if(slot->bitmap.buffer == nullptr && slot->bitmap.rows > 0 && slot->bitmap.width > 0)
 						BS_EXCEPT(InternalErrorException, "Failed to render glyph bitmap");
 
-					UINT8* sourceBuffer = slot->bitmap.buffer;
 					UINT8* dstBuffer = pixelBuffer + (curElement.output.y * pageIter->width * 2) + curElement.output.x * 2;
-
-					if(slot->bitmap.pixel_mode == ft_pixel_mode_grays)
+					if (distanceField)
 					{
-						for(INT32 bitmapRow = 0; bitmapRow < slot->bitmap.rows; bitmapRow++)
+						UINT32 glyphWidth = slot->bitmap.width;
+						UINT32 glyphHeight = slot->bitmap.rows;
+						if (glyphWidth > 0 && glyphHeight > 0)
 						{
-							for(INT32 bitmapColumn = 0; bitmapColumn < slot->bitmap.width; bitmapColumn++)
-							{
-								dstBuffer[bitmapColumn * 2 + 0] = sourceBuffer[bitmapColumn];
-								dstBuffer[bitmapColumn * 2 + 1] = sourceBuffer[bitmapColumn];
-							}
-
-							dstBuffer += pageIter->width * 2;
-							sourceBuffer += slot->bitmap.pitch;
-						}
-					}
-					else if(slot->bitmap.pixel_mode == ft_pixel_mode_mono)
-					{
-						// 8 pixels are packed into a byte, so do some unpacking
-						for(INT32 bitmapRow = 0; bitmapRow < slot->bitmap.rows; bitmapRow++)
-						{
-							for(INT32 bitmapColumn = 0; bitmapColumn < slot->bitmap.width; bitmapColumn++)
-							{
-								UINT8 srcValue = sourceBuffer[bitmapColumn >> 3];
-								UINT8 dstValue = (srcValue & (128 >> (bitmapColumn & 7))) != 0 ? 255 : 0;
-
-								dstBuffer[bitmapColumn * 2 + 0] = dstValue;
-								dstBuffer[bitmapColumn * 2 + 1] = dstValue;
-							}
-
-							dstBuffer += pageIter->width * 2;
-							sourceBuffer += slot->bitmap.pitch;
+							Vector<UINT8> coverage(glyphWidth * glyphHeight);
+							copyFreeTypeBitmap(slot, coverage.data(), 1, glyphWidth, 1);
+							generateDistanceField(coverage.data(), glyphWidth, glyphHeight, spread, dstBuffer, 2,
+								pageIter->width * 2, 2);
 						}
 					}
 					else
-						BS_EXCEPT(InternalErrorException, "Unsupported pixel mode for a FreeType bitmap.");
+						copyFreeTypeBitmap(slot, dstBuffer, 2, pageIter->width * 2, 2);
 
 					// Store character information
 					CharDesc charDesc;
@@ -278,13 +275,13 @@ namespace bs
 					charDesc.uvHeight = invTexHeight * curElement.input.height;
 					charDesc.uvX = invTexWidth * curElement.output.x;
 					charDesc.uvY = invTexHeight * curElement.output.y;
-					charDesc.xOffset = slot->bitmap_left;
-					charDesc.yOffset = slot->bitmap_top;
+					charDesc.xOffset = slot->bitmap_left - (curElement.input.width > 0 ? (INT32)spread : 0);
+					charDesc.yOffset = slot->bitmap_top + (curElement.input.height > 0 ? (INT32)spread : 0);
 					charDesc.xAdvance = slot->advance.x >> 6;
 					charDesc.yAdvance = slot->advance.y >> 6;
 
 					baselineOffset = std::max(baselineOffset, (INT32)(slot->metrics.horiBearingY >> 6));
-					lineHeight = std::max(lineHeight, charDesc.height);
+					lineHeight = std::max(lineHeight, (UINT32)slot->bitmap.rows);
 
 					// Load kerning and store char
 					if(!isMissingGlypth)
@@ -351,6 +348,7 @@ namespace bs
 			fontData->size = fontSizes[i];
 			fontData->baselineOffset = baselineOffset;
 			fontData->lineHeight = lineHeight;
+			fontData->distanceField = distanceField;
 
 			// Get space size
 			error = FT_Load_Char(face, 32, loadFlags);
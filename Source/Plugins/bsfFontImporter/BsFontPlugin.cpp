@@ -3,6 +3,7 @@
 #include "BsFontPrerequisites.h"
 #include "Importer/BsImporter.h"
 #include "BsFontImporter.h"
+#include "BsFontRasterizer.h"
 
 namespace bs
 {
@@ -19,6 +20,9 @@ namespace bs
 		FontImporter* importer = bs_new<FontImporter>();
 		Importer::instance()._registerAssetImporter(importer);
 
+		// Allows dynamic fonts to rasterize their glyphs at runtime
+		GlyphCacheManager::instance()._setRasterizerFactory(bs_shared_ptr_new<FreeTypeGlyphRasterizerFactory>());
+
 		return nullptr;
 	}
 }
\ No newline at end of file
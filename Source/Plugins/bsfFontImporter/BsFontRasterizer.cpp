@@ -0,0 +1,284 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsFontRasterizer.h"
+#include "Debug/BsDebug.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	FT_Int32 getFreeTypeLoadFlags(FontRenderMode renderMode)
+	{
+		switch (renderMode)
+		{
+		case FontRenderMode::Smooth:
+			return FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
+		case FontRenderMode::Raster:
+			return FT_LOAD_TARGET_MONO | FT_LOAD_NO_HINTING;
+		case FontRenderMode::HintedSmooth:
+			return FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_AUTOHINT;
+		case FontRenderMode::HintedRaster:
+			return FT_LOAD_TARGET_MONO | FT_LOAD_NO_AUTOHINT;
+		default:
+			return FT_LOAD_TARGET_NORMAL;
+		}
+	}
+
+	void copyFreeTypeBitmap(FT_GlyphSlot slot, UINT8* dst, UINT32 dstStride, UINT32 dstPitch, UINT32 numChannels)
+	{
+		UINT8* sourceBuffer = slot->bitmap.buffer;
+
+		if(slot->bitmap.pixel_mode == ft_pixel_mode_grays)
+		{
+			for(INT32 bitmapRow = 0; bitmapRow < (INT32)slot->bitmap.rows; bitmapRow++)
+			{
+				for(INT32 bitmapColumn = 0; bitmapColumn < (INT32)slot->bitmap.width; bitmapColumn++)
+				{
+					for(UINT32 channel = 0; channel < numChannels; channel++)
+						dst[bitmapColumn * dstStride + channel] = sourceBuffer[bitmapColumn];
+				}
+
+				dst += dstPitch;
+				sourceBuffer += slot->bitmap.pitch;
+			}
+		}
+		else if(slot->bitmap.pixel_mode == ft_pixel_mode_mono)
+		{
+			// 8 pixels are packed into a byte, so do some unpacking
+			for(INT32 bitmapRow = 0; bitmapRow < (INT32)slot->bitmap.rows; bitmapRow++)
+			{
+				for(INT32 bitmapColumn = 0; bitmapColumn < (INT32)slot->bitmap.width; bitmapColumn++)
+				{
+					UINT8 srcValue = sourceBuffer[bitmapColumn >> 3];
+					UINT8 dstValue = (srcValue & (128 >> (bitmapColumn & 7))) != 0 ? 255 : 0;
+
+					for(UINT32 channel = 0; channel < numChannels; channel++)
+						dst[bitmapColumn * dstStride + channel] = dstValue;
+				}
+
+				dst += dstPitch;
+				sourceBuffer += slot->bitmap.pitch;
+			}
+		}
+		else
+			BS_EXCEPT(InternalErrorException, "Unsupported pixel mode for a FreeType bitmap.");
+	}
+
+	/** Offset from a pixel to the nearest pixel of the opposite set, used by the distance transform. */
+	struct DistanceOffset
+	{
+		INT32 x, y;
+
+		INT32 distanceSq() const { return x * x + y * y; }
+	};
+
+	/** 
+	 * Calculates the offset from every pixel to the nearest pixel marked as a seed (i.e. with a zero offset), using the
+	 * 8-point sequential signed Euclidean distance transform.
+	 */
+	static void calculateDistanceOffsets(Vector<DistanceOffset>& grid, INT32 width, INT32 height)
+	{
+		auto compare = [&grid, width, height](INT32 x, INT32 y, INT32 offsetX, INT32 offsetY)
+		{
+			INT32 otherX = x + offsetX;
+			INT32 otherY = y + offsetY;
+			if (otherX < 0 || otherY < 0 || otherX >= width || otherY >= height)
+				return;
+
+			DistanceOffset& current = grid[y * width + x];
+			DistanceOffset other = grid[otherY * width + otherX];
+			other.x += offsetX;
+			other.y += offsetY;
+
+			if (other.distanceSq() < current.distanceSq())
+				current = other;
+		};
+
+		for (INT32 y = 0; y < height; y++)
+		{
+			for (INT32 x = 0; x < width; x++)
+			{
+				compare(x, y, -1, 0);
+				compare(x, y, 0, -1);
+				compare(x, y, -1, -1);
+				compare(x, y, 1, -1);
+			}
+
+			for (INT32 x = width - 1; x >= 0; x--)
+				compare(x, y, 1, 0);
+		}
+
+		for (INT32 y = height - 1; y >= 0; y--)
+		{
+			for (INT32 x = width - 1; x >= 0; x--)
+			{
+				compare(x, y, 1, 0);
+				compare(x, y, 0, 1);
+				compare(x, y, -1, 1);
+				compare(x, y, 1, 1);
+			}
+
+			for (INT32 x = 0; x < width; x++)
+				compare(x, y, -1, 0);
+		}
+	}
+
+	void generateDistanceField(const UINT8* coverage, UINT32 width, UINT32 height, UINT32 spread, UINT8* dst,
+		UINT32 dstStride, UINT32 dstPitch, UINT32 numChannels)
+	{
+		const INT32 fieldWidth = (INT32)(width + spread * 2);
+		const INT32 fieldHeight = (INT32)(height + spread * 2);
+		const UINT32 numPixels = (UINT32)(fieldWidth * fieldHeight);
+
+		// Large enough to never be the nearest, yet small enough for its squared length not to overflow
+		static constexpr INT32 FAR_AWAY = 10000;
+
+		// Find distances from outside pixels to the glyph, and from inside pixels to the outside
+		Vector<DistanceOffset> toInside(numPixels, { FAR_AWAY, FAR_AWAY });
+		Vector<DistanceOffset> toOutside(numPixels, { FAR_AWAY, FAR_AWAY });
+		for (INT32 y = 0; y < fieldHeight; y++)
+		{
+			for (INT32 x = 0; x < fieldWidth; x++)
+			{
+				INT32 coverageX = x - (INT32)spread;
+				INT32 coverageY = y - (INT32)spread;
+
+				bool inside = false;
+				if (coverageX >= 0 && coverageY >= 0 && coverageX < (INT32)width && coverageY < (INT32)height)
+					inside = coverage[coverageY * width + coverageX] >= 128;
+
+				if (inside)
+					toInside[y * fieldWidth + x] = { 0, 0 };
+				else
+					toOutside[y * fieldWidth + x] = { 0, 0 };
+			}
+		}
+
+		calculateDistanceOffsets(toInside, fieldWidth, fieldHeight);
+		calculateDistanceOffsets(toOutside, fieldWidth, fieldHeight);
+
+		const float invRange = 0.5f / std::max(1U, spread);
+		for (INT32 y = 0; y < fieldHeight; y++)
+		{
+			for (INT32 x = 0; x < fieldWidth; x++)
+			{
+				const UINT32 idx = y * fieldWidth + x;
+
+				// The edge lies halfway between neighbouring inside and outside pixels
+				float distance;
+				if (toInside[idx].distanceSq() == 0)
+					distance = std::sqrt((float)toOutside[idx].distanceSq()) - 0.5f;
+				else
+					distance = 0.5f - std::sqrt((float)toInside[idx].distanceSq());
+
+				float value = Math::clamp01(0.5f + distance * invRange);
+				UINT8 dstValue = (UINT8)Math::roundToPosInt(value * 255.0f);
+
+				for (UINT32 channel = 0; channel < numChannels; channel++)
+					dst[x * dstStride + channel] = dstValue;
+			}
+
+			dst += dstPitch;
+		}
+	}
+
+	FreeTypeGlyphRasterizer::FreeTypeGlyphRasterizer(FT_Library library, FT_Face face, UINT32 dpi, FT_Int32 loadFlags)
+		: mLibrary(library), mFace(face), mDPI(dpi), mLoadFlags(loadFlags)
+	{ }
+
+	FreeTypeGlyphRasterizer::~FreeTypeGlyphRasterizer()
+	{
+		FT_Done_Face(mFace);
+		FT_Done_FreeType(mLibrary);
+	}
+
+	bool FreeTypeGlyphRasterizer::setSize(UINT32 size)
+	{
+		if (mCurrentSize == size)
+			return true;
+
+		FT_F26Dot6 ftSize = (FT_F26Dot6)(size * (1 << 6));
+		if (FT_Set_Char_Size(mFace, ftSize, 0, mDPI, mDPI))
+		{
+			LOGERR("Could not set character size: " + toString(size));
+			return false;
+		}
+
+		mCurrentSize = size;
+		return true;
+	}
+
+	FontSizeMetrics FreeTypeGlyphRasterizer::getSizeMetrics(UINT32 size)
+	{
+		FontSizeMetrics metrics;
+		if (!setSize(size))
+			return metrics;
+
+		metrics.baselineOffset = (INT32)(mFace->size->metrics.ascender >> 6);
+		metrics.lineHeight = (UINT32)(mFace->size->metrics.height >> 6);
+
+		if (!FT_Load_Char(mFace, 32, mLoadFlags))
+			metrics.spaceWidth = (UINT32)(mFace->glyph->advance.x >> 6);
+
+		return metrics;
+	}
+
+	bool FreeTypeGlyphRasterizer::rasterize(UINT32 charId, UINT32 size, RasterizedGlyph& output)
+	{
+		if (!setSize(size))
+			return false;
+
+		FT_UInt glyphIdx = 0;
+		if (charId != MISSING_GLYPH_ID)
+		{
+			glyphIdx = FT_Get_Char_Index(mFace, (FT_ULong)charId);
+
+			// Character not present in the font, missing glyph will be used instead
+			if (glyphIdx == 0)
+				return false;
+		}
+
+		if (FT_Load_Glyph(mFace, glyphIdx, mLoadFlags))
+			return false;
+
+		if (FT_Render_Glyph(mFace->glyph, FT_LOAD_TARGET_MODE(mLoadFlags)))
+			return false;
+
+		FT_GlyphSlot slot = mFace->glyph;
+		if(slot->bitmap.buffer == nullptr && slot->bitmap.rows > 0 && slot->bitmap.width > 0)
+			return false;
+
+		output.width = slot->bitmap.width;
+		output.height = slot->bitmap.rows;
+		output.xOffset = slot->bitmap_left;
+		output.yOffset = slot->bitmap_top;
+		output.xAdvance = (INT32)(slot->advance.x >> 6);
+		output.yAdvance = (INT32)(slot->advance.y >> 6);
+		output.pixels.resize(output.width * output.height);
+
+		if (!output.pixels.empty())
+			copyFreeTypeBitmap(slot, output.pixels.data(), 1, output.width, 1);
+
+		return true;
+	}
+
+	SPtr<GlyphRasterizer> FreeTypeGlyphRasterizerFactory::create(const UINT8* data, UINT32 size, UINT32 dpi,
+		FontRenderMode renderMode)
+	{
+		FT_Library library;
+		if (FT_Init_FreeType(&library))
+		{
+			LOGERR("Error occurred during FreeType library initialization.");
+			return nullptr;
+		}
+
+		FT_Face face;
+		if (FT_New_Memory_Face(library, (const FT_Byte*)data, (FT_Long)size, 0, &face))
+		{
+			LOGERR("Failed to load font data for glyph rasterization.");
+			FT_Done_FreeType(library);
+			return nullptr;
+		}
+
+		return bs_shared_ptr_new<FreeTypeGlyphRasterizer>(library, face, dpi, getFreeTypeLoadFlags(renderMode));
+	}
+}
@@ -0,0 +1,83 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsFontPrerequisites.h"
+#include "Text/BsGlyphCache.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+namespace bs
+{
+	/** @addtogroup Font
+	 *  @{
+	 */
+
+	/** Returns FreeType glyph load flags that correspond to the provided render mode. */
+	FT_Int32 getFreeTypeLoadFlags(FontRenderMode renderMode);
+
+	/**
+	 * Copies the bitmap of the glyph currently loaded in the provided slot into a buffer with one byte per pixel. Monochrome
+	 * bitmaps are expanded so each pixel is either 0 or 255.
+	 *
+	 * @param[in]	slot		Slot containing a rendered glyph.
+	 * @param[out]	dst			Buffer to write the pixels to.
+	 * @param[in]	dstStride	Distance between two consecutive pixels in the destination buffer, in bytes.
+	 * @param[in]	dstPitch	Distance between two consecutive rows in the destination buffer, in bytes.
+	 * @param[in]	numChannels	Number of consecutive bytes each pixel value is written to.
+	 */
+	void copyFreeTypeBitmap(FT_GlyphSlot slot, UINT8* dst, UINT32 dstStride, UINT32 dstPitch, UINT32 numChannels);
+
+	/**
+	 * Generates a signed distance field from glyph coverage. Output is larger than the input by @p spread pixels on each
+	 * side. Values of 128 and above are inside the glyph, with the edge at the middle of the range and values reaching
+	 * 0 or 255 at @p spread pixels away from the edge.
+	 *
+	 * @param[in]	coverage	Glyph coverage with one byte per pixel, as output by copyFreeTypeBitmap().
+	 * @param[in]	width		Width of the coverage bitmap, in pixels.
+	 * @param[in]	height		Height of the coverage bitmap, in pixels.
+	 * @param[in]	spread		Maximum distance from the edge encoded in the field, in pixels.
+	 * @param[out]	dst			Buffer to write the distance field to, of size (width + 2 * spread) by
+	 *							(height + 2 * spread).
+	 * @param[in]	dstStride	Distance between two consecutive pixels in the destination buffer, in bytes.
+	 * @param[in]	dstPitch	Distance between two consecutive rows in the destination buffer, in bytes.
+	 * @param[in]	numChannels	Number of consecutive bytes each pixel value is written to.
+	 */
+	void generateDistanceField(const UINT8* coverage, UINT32 width, UINT32 height, UINT32 spread, UINT8* dst,
+		UINT32 dstStride, UINT32 dstPitch, UINT32 numChannels);
+
+	/** Rasterizes glyphs on demand from font file data in memory, using FreeType. */
+	class FreeTypeGlyphRasterizer : public GlyphRasterizer
+	{
+	public:
+		FreeTypeGlyphRasterizer(FT_Library library, FT_Face face, UINT32 dpi, FT_Int32 loadFlags);
+		~FreeTypeGlyphRasterizer();
+
+		/** @copydoc GlyphRasterizer::getSizeMetrics */
+		FontSizeMetrics getSizeMetrics(UINT32 size) override;
+
+		/** @copydoc GlyphRasterizer::rasterize */
+		bool rasterize(UINT32 charId, UINT32 size, RasterizedGlyph& output) override;
+
+	private:
+		/** Changes the size the face renders glyphs at, if not already set. */
+		bool setSize(UINT32 size);
+
+		FT_Library mLibrary;
+		FT_Face mFace;
+		UINT32 mDPI;
+		FT_Int32 mLoadFlags;
+		UINT32 mCurrentSize = 0;
+	};
+
+	/** Creates FreeType glyph rasterizers. */
+	class FreeTypeGlyphRasterizerFactory : public GlyphRasterizerFactory
+	{
+	public:
+		/** @copydoc GlyphRasterizerFactory::create */
+		SPtr<GlyphRasterizer> create(const UINT8* data, UINT32 size, UINT32 dpi, FontRenderMode renderMode) override;
+	};
+
+	/** @} */
+}
@@ -1,11 +1,13 @@
 set(BS_FONTIMPORTER_INC_NOFILTER
 	"BsFontPrerequisites.h"
 	"BsFontImporter.h"
+	"BsFontRasterizer.h"
 )
 
 set(BS_FONTIMPORTER_SRC_NOFILTER
 	"BsFontPlugin.cpp"
 	"BsFontImporter.cpp"
+	"BsFontRasterizer.cpp"
 )
 
 source_group("" FILES ${BS_FONTIMPORTER_INC_NOFILTER} ${BS_FONTIMPORTER_SRC_NOFILTER})
@@ -0,0 +1,155 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsFontRasterizer.h"
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+
+#include FT_OUTLINE_H
+
+namespace bs
+{
+	/**
+	 * Rasterizes a square glyph with a square hole, with all edges aligned to pixel boundaries. The glyph covers
+	 * pixels [2, 14) and the hole pixels [6, 10) on both axes, of a 16x16 bitmap.
+	 */
+	bool rasterizeSquareGlyph(FT_Library library, Vector<UINT8>& coverage)
+	{
+		static constexpr UINT32 SIZE = 16;
+
+		// Outer contour is clockwise and the inner one counter-clockwise, in 26.6 fixed point coordinates
+		FT_Vector points[] =
+		{
+			{ 2 << 6, 2 << 6 }, { 2 << 6, 14 << 6 }, { 14 << 6, 14 << 6 }, { 14 << 6, 2 << 6 },
+			{ 6 << 6, 6 << 6 }, { 10 << 6, 6 << 6 }, { 10 << 6, 10 << 6 }, { 6 << 6, 10 << 6 }
+		};
+
+		char tags[] =
+		{
+			FT_CURVE_TAG_ON, FT_CURVE_TAG_ON, FT_CURVE_TAG_ON, FT_CURVE_TAG_ON,
+			FT_CURVE_TAG_ON, FT_CURVE_TAG_ON, FT_CURVE_TAG_ON, FT_CURVE_TAG_ON
+		};
+
+		short contours[] = { 3, 7 };
+
+		FT_Outline outline;
+		outline.n_points = 8;
+		outline.n_contours = 2;
+		outline.points = points;
+		outline.tags = tags;
+		outline.contours = contours;
+		outline.flags = FT_OUTLINE_NONE;
+
+		coverage.resize(SIZE * SIZE);
+
+		FT_Bitmap bitmap = {};
+		bitmap.rows = SIZE;
+		bitmap.width = SIZE;
+		bitmap.pitch = SIZE;
+		bitmap.buffer = coverage.data();
+		bitmap.num_grays = 256;
+		bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+
+		if (FT_Outline_Get_Bitmap(library, &outline, &bitmap))
+			return false;
+
+		// Rasterizer output has the origin at the bottom left, while glyph bitmaps start at the top, however the glyph is
+		// symmetrical so the order doesn't matter. Copy through the slot the same way the importer does.
+		FT_GlyphSlotRec slot = {};
+		slot.bitmap = bitmap;
+
+		Vector<UINT8> rendered(SIZE * SIZE);
+		copyFreeTypeBitmap(&slot, rendered.data(), 1, SIZE, 1);
+		coverage = rendered;
+
+		return true;
+	}
+
+	class FontRasterizerTestSuite : public TestSuite
+	{
+	public:
+		FontRasterizerTestSuite();
+
+	private:
+		void testDistanceField();
+	};
+
+	FontRasterizerTestSuite::FontRasterizerTestSuite()
+	{
+		BS_ADD_TEST(FontRasterizerTestSuite::testDistanceField);
+	}
+
+	void FontRasterizerTestSuite::testDistanceField()
+	{
+		FT_Library library;
+		BS_TEST_ASSERT(FT_Init_FreeType(&library) == 0);
+
+		Vector<UINT8> coverage;
+		BS_TEST_ASSERT(rasterizeSquareGlyph(library, coverage));
+		FT_Done_FreeType(library);
+
+		if (coverage.size() != 16 * 16)
+			return;
+
+		// Pixel aligned edges are fully covered or fully empty
+		BS_TEST_ASSERT(coverage[8 * 16 + 1] == 0);
+		BS_TEST_ASSERT(coverage[8 * 16 + 2] == 255);
+		BS_TEST_ASSERT(coverage[8 * 16 + 5] == 255);
+		BS_TEST_ASSERT(coverage[8 * 16 + 6] == 0);
+
+		const UINT32 spread = 4;
+		const UINT32 fieldSize = 16 + spread * 2;
+
+		Vector<UINT8> field(fieldSize * fieldSize * 2);
+		generateDistanceField(coverage.data(), 16, 16, spread, field.data(), 2, fieldSize * 2, 2);
+
+		auto sample = [&](INT32 x, INT32 y) -> INT32
+		{
+			// Coordinates relative to the glyph bitmap
+			return field[((y + spread) * fieldSize + (x + spread)) * 2];
+		};
+
+		// All channels are written
+		BS_TEST_ASSERT(field[(spread * fieldSize + spread) * 2] == field[(spread * fieldSize + spread) * 2 + 1]);
+
+		// Edge lies halfway between the last outside and the first inside pixel, which are half a pixel away from it,
+		// with each pixel of distance covering 1 / (2 * spread) of the value range
+		const INT32 halfPixel = Math::roundToInt(255.0f * 0.5f / (2 * spread));
+		BS_TEST_ASSERT(sample(2, 8) >= 128 && sample(1, 8) < 128);
+		BS_TEST_ASSERT(std::abs(sample(2, 8) - (128 + halfPixel)) <= 1);
+		BS_TEST_ASSERT(std::abs(sample(1, 8) - (127 - halfPixel)) <= 1);
+
+		// Edge is at the same distance along both axes and on all sides
+		BS_TEST_ASSERT(sample(8, 2) == sample(2, 8));
+		BS_TEST_ASSERT(sample(13, 8) == sample(2, 8));
+		BS_TEST_ASSERT(sample(8, 14) == sample(1, 8));
+
+		// Inside the glyph the values increase away from the edge, reaching the middle of the stroke
+		BS_TEST_ASSERT(sample(3, 8) > sample(2, 8));
+		BS_TEST_ASSERT(std::abs(sample(3, 8) - (128 + halfPixel * 3)) <= 1);
+
+		// Outside the glyph, including inside the hole, the values decrease away from the edge
+		BS_TEST_ASSERT(sample(0, 8) < sample(1, 8));
+		BS_TEST_ASSERT(sample(7, 8) < 128 && sample(7, 8) < sample(6, 8));
+		BS_TEST_ASSERT(std::abs(sample(7, 8) - (127 - halfPixel * 3)) <= 1);
+
+		// Values are clamped at spread pixels away from the edge
+		BS_TEST_ASSERT(sample(-(INT32)spread, -(INT32)spread) == 0);
+		BS_TEST_ASSERT(sample(-(INT32)spread, 8) == 0);
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	// Test failures are reported through the stack allocator, normally set up by the application
+	MemStack::beginThread();
+
+	SPtr<TestSuite> tests = FontRasterizerTestSuite::create<FontRasterizerTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	MemStack::endThread();
+	return 0;
+}
@@ -222,7 +222,7 @@ namespace bs
 		UPtr<MemoryDataStream> memStream(nullptr, nullptr);
 		FREE_IMAGE_FORMAT imageFormat;
 		{
-			Lock lock = FileScheduler::getLock(filePath);
+			FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
 
 			SPtr<DataStream> fileData = FileSystem::openFile(filePath, true);
 			if (fileData->size() > std::numeric_limits<UINT32>::max())
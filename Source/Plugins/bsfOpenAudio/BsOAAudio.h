@@ -4,6 +4,7 @@
 
 #include "BsOAPrerequisites.h"
 #include "Audio/BsAudio.h"
+#include "BsOAStreamCache.h"
 #include "AL/alc.h"
 
 namespace bs
@@ -83,6 +84,9 @@ namespace bs
 		 */
 		void _writeToOpenALBuffer(UINT32 bufferId, UINT8* samples, const AudioDataInfo& info);
 
+		/** Returns the cache of decoded data used by all streaming audio sources. */
+		OAStreamCache& _getStreamCache() { return mStreamCache; }
+
 		/** @} */
 
 	private:
@@ -149,6 +153,7 @@ namespace bs
 		UnorderedSet<OAAudioSource*> mStreamingSources;
 		UnorderedSet<OAAudioSource*> mDestroyedSources;
 		SPtr<Task> mStreamingTask;
+		OAStreamCache mStreamCache;
 		mutable Mutex mMutex;
 	};
 
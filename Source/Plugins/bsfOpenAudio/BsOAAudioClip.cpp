@@ -17,6 +17,8 @@ namespace bs
 	{
 		if (mBufferId != (UINT32)-1)
 			alDeleteBuffers(1, &mBufferId);
+
+		gOAAudio()._getStreamCache().evict(this);
 	}
 
 	void OAAudioClip::initialize()
@@ -172,6 +174,22 @@ namespace bs
 		LOGWRN("Attempting to read samples while sample data is not available.");
 	}
 
+	AudioDataInfo OAAudioClip::getStreamInfo() const
+	{
+		AudioDataInfo info;
+		info.bitDepth = mDesc.bitDepth;
+		info.numChannels = mDesc.numChannels;
+		info.numSamples = mNumSamples;
+		info.sampleRate = mDesc.frequency;
+
+		return info;
+	}
+
+	void OAAudioClip::readStreamSamples(UINT8* samples, UINT32 offset, UINT32 count) const
+	{
+		getSamples(samples, offset, count);
+	}
+
 	SPtr<DataStream> OAAudioClip::getSourceStream(UINT32& size)
 	{
 		Lock lock(mMutex);
@@ -5,6 +5,7 @@
 #include "BsOAPrerequisites.h"
 #include "Audio/BsAudioClip.h"
 #include "BsOggVorbisDecoder.h"
+#include "BsOAStreamCache.h"
 
 namespace bs
 {
@@ -13,7 +14,7 @@ namespace bs
 	 */
 	
 	/** OpenAudio implementation of an AudioClip. */
-	class OAAudioClip : public AudioClip
+	class OAAudioClip : public AudioClip, public OAStreamSource
 	{
 	public:
 		OAAudioClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples, const AUDIO_CLIP_DESC& desc);
@@ -40,6 +41,12 @@ namespace bs
 		/** Returns the internal OpenAL buffer. Only valid if the audio clip was created without AudioReadMode::Stream. */
 		UINT32 _getOpenALBuffer() const { return mBufferId; }
 
+		/** @copydoc OAStreamSource::getStreamInfo */
+		AudioDataInfo getStreamInfo() const override;
+
+		/** @copydoc OAStreamSource::readStreamSamples */
+		void readStreamSamples(UINT8* samples, UINT32 offset, UINT32 count) const override;
+
 		/** @} */
 	protected:
 		/** @copydoc Resource::initialize */
@@ -599,9 +599,9 @@ namespace bs
 
 		UINT8* samples = (UINT8*)bs_stack_alloc(sampleBufferSize);
 
-		OAAudioClip* audioClip = static_cast<OAAudioClip*>(mAudioClip.get());
-
-		audioClip->getSamples(samples, mStreamQueuedPosition, numSamples);
+		// Decoded data is shared between all sources playing the same clip
+		SPtr<OAAudioClip> audioClip = std::static_pointer_cast<OAAudioClip>(mAudioClip.getInternalPtr());
+		gOAAudio()._getStreamCache().read(audioClip, mStreamQueuedPosition, numSamples, samples, mLoop);
 		mStreamQueuedPosition += numSamples;
 
 		info.numSamples = numSamples;
@@ -49,7 +49,7 @@ namespace bs
 		UINT32 bufferSize;
 		UINT8* sampleBuffer;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileScheduler::Slot fileSlot = FileScheduler::getLock(filePath);
 			SPtr<DataStream> stream = FileSystem::openFile(filePath);
 
 			String extension = filePath.getExtension();
@@ -89,7 +89,8 @@ namespace bs
 			UINT32 monoBufferSize = numSamplesPerChannel * bytesPerSample;
 			UINT8* monoBuffer = (UINT8*)bs_alloc(monoBufferSize);
 
-			AudioUtility::convertToMono(sampleBuffer, monoBuffer, info.bitDepth, numSamplesPerChannel, info.numChannels);
+			AudioUtility::convertToMono(sampleBuffer, monoBuffer, info.bitDepth, numSamplesPerChannel, info.numChannels,
+				AudioConversionMode::Parallel);
 
 			info.numSamples = numSamplesPerChannel;
 			info.numChannels = 1;
@@ -106,7 +107,8 @@ namespace bs
 			UINT32 outBufferSize = info.numSamples * (clipIO->getBitDepth() / 8);
 			UINT8* outBuffer = (UINT8*)bs_alloc(outBufferSize);
 
-			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, clipIO->getBitDepth(), info.numSamples);
+			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, clipIO->getBitDepth(), info.numSamples,
+				AudioConversionMode::Parallel);
 
 			info.bitDepth = clipIO->getBitDepth();
 
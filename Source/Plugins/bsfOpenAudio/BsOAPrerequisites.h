@@ -6,6 +6,7 @@
 
 namespace bs
 {
+	class OAAudioClip;
 	class OAAudioListener;
 	class OAAudioSource;
 }
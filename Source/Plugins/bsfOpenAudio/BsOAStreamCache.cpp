@@ -0,0 +1,276 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsOAStreamCache.h"
+#include "Math/BsMath.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	size_t OAStreamCache::BlockKeyHash::operator()(const BlockKey& key) const
+	{
+		size_t hash = 0;
+		bs::hash_combine(hash, key.clip);
+		bs::hash_combine(hash, key.index);
+
+		return hash;
+	}
+
+	OAStreamCache::~OAStreamCache()
+	{
+		waitForPrefetch();
+	}
+
+	void OAStreamCache::read(const SPtr<OAStreamSource>& clip, UINT32 offset, UINT32 count, UINT8* samples, bool loop)
+	{
+		Lock lock(mMutex);
+
+		if (mMaxSize == 0)
+		{
+			lock.unlock();
+			clip->readStreamSamples(samples, offset, count);
+			return;
+		}
+
+		const AudioDataInfo info = clip->getStreamInfo();
+		const UINT32 bytesPerSample = info.bitDepth / 8;
+		const UINT32 blockSize = getBlockSize(info);
+		const UINT32 end = offset + count;
+
+		UINT32 index = offset / blockSize;
+		while (offset < end)
+		{
+			const Block& block = acquireBlock(clip, index, lock);
+
+			UINT32 numBlockSamples = (UINT32)block.data.size() / bytesPerSample;
+			UINT32 blockOffset = offset - index * blockSize;
+
+			if (blockOffset < numBlockSamples)
+			{
+				UINT32 numSamples = std::min(end - offset, numBlockSamples - blockOffset);
+				memcpy(samples, block.data.data() + blockOffset * bytesPerSample, numSamples * bytesPerSample);
+
+				samples += numSamples * bytesPerSample;
+				offset += numSamples;
+			}
+
+			index++;
+
+			// Read past the end of the clip, or the decoder returned less data than expected. Output silence for the
+			// remainder.
+			if (numBlockSamples < blockSize && offset < end)
+			{
+				memset(samples, 0, (end - offset) * bytesPerSample);
+				break;
+			}
+		}
+
+		lock.unlock();
+		prefetch(clip, index, loop);
+	}
+
+	void OAStreamCache::evict(const OAStreamSource* clip)
+	{
+		Lock lock(mMutex);
+
+		for (auto iter = mBlocks.begin(); iter != mBlocks.end();)
+		{
+			// Pending blocks cannot belong to a clip being evicted, as their decoder keeps a reference to the clip
+			if (iter->first.clip == clip && iter->second.ready)
+			{
+				mSize -= (UINT32)iter->second.data.size();
+				mLRU.erase(iter->second.lruIter);
+
+				iter = mBlocks.erase(iter);
+			}
+			else
+				++iter;
+		}
+	}
+
+	void OAStreamCache::setMaxSize(UINT32 size)
+	{
+		Lock lock(mMutex);
+
+		mMaxSize = size;
+		trim();
+	}
+
+	UINT32 OAStreamCache::getMaxSize() const
+	{
+		Lock lock(mMutex);
+		return mMaxSize;
+	}
+
+	void OAStreamCache::setPrefetchCount(UINT32 count)
+	{
+		Lock lock(mMutex);
+		mPrefetchCount = count;
+	}
+
+	UINT32 OAStreamCache::getPrefetchCount() const
+	{
+		Lock lock(mMutex);
+		return mPrefetchCount;
+	}
+
+	UINT32 OAStreamCache::getSize() const
+	{
+		Lock lock(mMutex);
+		return mSize;
+	}
+
+	bool OAStreamCache::isCached(const OAStreamSource* clip, UINT32 index) const
+	{
+		Lock lock(mMutex);
+
+		auto iterFind = mBlocks.find({ clip, index });
+		return iterFind != mBlocks.end() && iterFind->second.ready;
+	}
+
+	void OAStreamCache::waitForPrefetch()
+	{
+		Lock lock(mMutex);
+		mBlockReadySignal.wait(lock, [this]() { return mNumPrefetchTasks == 0; });
+	}
+
+	UINT32 OAStreamCache::getBlockSize(const AudioDataInfo& info)
+	{
+		return std::max(info.sampleRate * info.numChannels, 1U);
+	}
+
+	OAStreamCache::Block& OAStreamCache::acquireBlock(const SPtr<OAStreamSource>& clip, UINT32 index, Lock& lock)
+	{
+		const BlockKey key = { clip.get(), index };
+
+		while (true)
+		{
+			auto iterFind = mBlocks.find(key);
+			if (iterFind == mBlocks.end())
+			{
+				// Register as pending so other readers wait for this decode instead of starting their own
+				mBlocks[key];
+
+				lock.unlock();
+
+				Vector<UINT8> data;
+				decodeBlock(*clip, index, data);
+
+				lock.lock();
+				finishBlock(key, data);
+
+				return mBlocks[key];
+			}
+
+			Block& block = iterFind->second;
+			if (block.ready)
+			{
+				mLRU.splice(mLRU.begin(), mLRU, block.lruIter);
+				return block;
+			}
+
+			// Block might get evicted by the time it's ready (if the cache is very small), so look it up again
+			mBlockReadySignal.wait(lock);
+		}
+	}
+
+	void OAStreamCache::decodeBlock(const OAStreamSource& clip, UINT32 index, Vector<UINT8>& data)
+	{
+		const AudioDataInfo info = clip.getStreamInfo();
+		const UINT32 blockSize = getBlockSize(info);
+		const UINT32 start = index * blockSize;
+
+		UINT32 numSamples = 0;
+		if (start < info.numSamples)
+			numSamples = std::min(blockSize, info.numSamples - start);
+
+		data.resize(numSamples * (info.bitDepth / 8));
+
+		if (numSamples > 0)
+			clip.readStreamSamples(data.data(), start, numSamples);
+	}
+
+	void OAStreamCache::finishBlock(const BlockKey& key, Vector<UINT8>& data)
+	{
+		Block& block = mBlocks[key];
+		block.data = std::move(data);
+		block.ready = true;
+
+		mLRU.push_front(key);
+		block.lruIter = mLRU.begin();
+		mSize += (UINT32)block.data.size();
+
+		trim();
+		mBlockReadySignal.notify_all();
+	}
+
+	void OAStreamCache::prefetch(const SPtr<OAStreamSource>& clip, UINT32 index, bool loop)
+	{
+		const AudioDataInfo info = clip->getStreamInfo();
+		const UINT32 numBlocks = Math::divideAndRoundUp(info.numSamples, getBlockSize(info));
+
+		Vector<UINT32> indices;
+		{
+			Lock lock(mMutex);
+
+			for (UINT32 i = 0; i < mPrefetchCount; i++, index++)
+			{
+				if (index >= numBlocks)
+				{
+					if (!loop)
+						break;
+
+					index = 0;
+				}
+
+				BlockKey key = { clip.get(), index };
+				if (mBlocks.find(key) != mBlocks.end())
+					continue;
+
+				mBlocks[key];
+				indices.push_back(index);
+			}
+
+			if (indices.empty())
+				return;
+
+			mNumPrefetchTasks++;
+		}
+
+		// All blocks of a clip are decoded in order on a single worker, since the clip's decoder can only be used by one
+		// thread at a time. Different clips decode in parallel.
+		auto worker = [this, decodeClip = clip, indices]() mutable
+		{
+			for (auto& blockIdx : indices)
+			{
+				Vector<UINT8> data;
+				decodeBlock(*decodeClip, blockIdx, data);
+
+				Lock lock(mMutex);
+				finishBlock({ decodeClip.get(), blockIdx }, data);
+			}
+
+			// Release the clip before signaling completion, so its destruction cannot outlive the cache
+			decodeClip = nullptr;
+
+			Lock lock(mMutex);
+			mNumPrefetchTasks--;
+			mBlockReadySignal.notify_all();
+		};
+
+		SPtr<Task> task = Task::create("AudioPrefetch", worker, TaskPriority::High);
+		TaskScheduler::instance().addTask(task);
+	}
+
+	void OAStreamCache::trim()
+	{
+		// Always keep the most recently used block, it is the one that was just requested
+		while (mSize > mMaxSize && mLRU.size() > 1)
+		{
+			auto iterFind = mBlocks.find(mLRU.back());
+			mSize -= (UINT32)iterFind->second.data.size();
+
+			mBlocks.erase(iterFind);
+			mLRU.pop_back();
+		}
+	}
+}
@@ -0,0 +1,155 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsOAPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup OpenAudio
+	 *  @{
+	 */
+
+	/** Provides decoded samples to OAStreamCache. Implemented by audio clips whose data gets streamed. */
+	class OAStreamSource
+	{
+	public:
+		virtual ~OAStreamSource() = default;
+
+		/** Returns the format of the decoded samples, and the total number of samples. */
+		virtual AudioDataInfo getStreamInfo() const = 0;
+
+		/**
+		 * Decodes samples in PCM format, channel data interleaved.
+		 *
+		 * @param[in]	samples		Previously allocated buffer to contain the samples.
+		 * @param[in]	offset		Offset in number of samples at which to start reading (should be a multiple of number
+		 *							of channels).
+		 * @param[in]	count		Number of samples to read (should be a multiple of number of channels).
+		 *
+		 * @note	Must be thread safe, as it gets called from the worker threads decoding ahead.
+		 */
+		virtual void readStreamSamples(UINT8* samples, UINT32 offset, UINT32 count) const = 0;
+	};
+
+	/**
+	 * Cache of decoded PCM data of streamed audio clips, shared between all audio sources. Clip data is split into blocks
+	 * of one second each. Blocks are decoded when first read, and the blocks following a read are decoded ahead of time
+	 * on worker threads. Once the cache grows over its budget, least recently used blocks are evicted.
+	 *
+	 * @note	Thread safe.
+	 */
+	class OAStreamCache
+	{
+	public:
+		/** Default value for setMaxSize(). */
+		static constexpr UINT32 DEFAULT_MAX_SIZE = 32 * 1024 * 1024;
+
+		/** Default value for setPrefetchCount(). */
+		static constexpr UINT32 DEFAULT_PREFETCH_COUNT = 2;
+
+		OAStreamCache() = default;
+		~OAStreamCache();
+
+		/**
+		 * Reads decoded samples of the provided clip. Blocks not yet in the cache are decoded on the calling thread, after
+		 * which the blocks following the read range are queued for decoding on worker threads.
+		 *
+		 * @param[in]	clip		Clip to read the samples from. Referenced until all of its queued blocks decode.
+		 * @param[in]	offset		Offset in number of samples at which to start reading (should be a multiple of number
+		 *							of channels).
+		 * @param[in]	count		Number of samples to read (should be a multiple of number of channels).
+		 * @param[out]	samples		Previously allocated buffer to contain the samples.
+		 * @param[in]	loop		If true, prefetching wraps around to the start of the clip once it reaches the end.
+		 */
+		void read(const SPtr<OAStreamSource>& clip, UINT32 offset, UINT32 count, UINT8* samples, bool loop);
+
+		/** Removes all cached data of the provided clip. Should be called when the clip is destroyed. */
+		void evict(const OAStreamSource* clip);
+
+		/**
+		 * Sets the maximum amount of decoded data to keep in the cache, in bytes. Setting this to zero disables the cache,
+		 * in which case all reads decode directly from the clip.
+		 */
+		void setMaxSize(UINT32 size);
+
+		/** @copydoc setMaxSize */
+		UINT32 getMaxSize() const;
+
+		/** Sets the number of blocks to decode ahead of the last read position. */
+		void setPrefetchCount(UINT32 count);
+
+		/** @copydoc setPrefetchCount */
+		UINT32 getPrefetchCount() const;
+
+		/** Returns the amount of decoded data currently in the cache, in bytes. */
+		UINT32 getSize() const;
+
+		/** Returns true if the provided block of the clip has been decoded and is in the cache. */
+		bool isCached(const OAStreamSource* clip, UINT32 index) const;
+
+		/** Blocks the calling thread until all blocks queued for decoding ahead have been decoded. */
+		void waitForPrefetch();
+
+	private:
+		/** Identifies a single block of decoded data. */
+		struct BlockKey
+		{
+			bool operator==(const BlockKey& other) const { return clip == other.clip && index == other.index; }
+
+			const OAStreamSource* clip;
+			UINT32 index;
+		};
+
+		/** Hash function for BlockKey. */
+		struct BlockKeyHash
+		{
+			size_t operator()(const BlockKey& key) const;
+		};
+
+		/** Decoded data of a single block. */
+		struct Block
+		{
+			Vector<UINT8> data;
+			bool ready = false;
+			List<BlockKey>::iterator lruIter;
+		};
+
+		/** Returns the number of samples in a single block of a clip with the provided format. */
+		static UINT32 getBlockSize(const AudioDataInfo& info);
+
+		/**
+		 * Returns a ready block, decoding it on the calling thread if needed, or waiting on another thread that is already
+		 * decoding it. Marks the block as most recently used. Caller must hold the lock, which might get released
+		 * temporarily.
+		 */
+		Block& acquireBlock(const SPtr<OAStreamSource>& clip, UINT32 index, Lock& lock);
+
+		/** Decodes the provided block of the clip. Must be called without holding the lock. */
+		static void decodeBlock(const OAStreamSource& clip, UINT32 index, Vector<UINT8>& data);
+
+		/**
+		 * Stores decoded data for a block previously registered as pending, and notifies any waiting readers. Caller
+		 * must hold the lock.
+		 */
+		void finishBlock(const BlockKey& key, Vector<UINT8>& data);
+
+		/** Queues decoding of up to the prefetch count blocks starting at the provided index. */
+		void prefetch(const SPtr<OAStreamSource>& clip, UINT32 index, bool loop);
+
+		/** Evicts least recently used blocks until the cache fits its budget. Caller must hold the lock. */
+		void trim();
+
+		UnorderedMap<BlockKey, Block, BlockKeyHash> mBlocks;
+		List<BlockKey> mLRU; // Most recently used first, only contains ready blocks
+		UINT32 mSize = 0;
+		UINT32 mMaxSize = DEFAULT_MAX_SIZE;
+		UINT32 mPrefetchCount = DEFAULT_PREFETCH_COUNT;
+		UINT32 mNumPrefetchTasks = 0;
+
+		mutable Mutex mMutex;
+		Signal mBlockReadySignal;
+	};
+
+	/** @} */
+}
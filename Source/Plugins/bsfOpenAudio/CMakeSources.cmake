@@ -10,6 +10,7 @@ set(BS_OPENAUDIO_INC_NOFILTER
 	"BsOAAudio.h"
 	"BsOAAudioSource.h"
 	"BsOAAudioListener.h"
+	"BsOAStreamCache.h"
 )
 
 set(BS_OPENAUDIO_SRC_NOFILTER
@@ -23,6 +24,7 @@ set(BS_OPENAUDIO_SRC_NOFILTER
 	"BsOAAudio.cpp"
 	"BsOAAudioSource.cpp"
 	"BsOAAudioListener.cpp"
+	"BsOAStreamCache.cpp"
 )
 
 source_group("" FILES ${BS_OPENAUDIO_INC_NOFILTER} ${BS_OPENAUDIO_SRC_NOFILTER})
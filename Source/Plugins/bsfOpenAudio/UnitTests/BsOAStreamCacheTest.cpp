@@ -0,0 +1,270 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsOAPrerequisites.h"
+#include "BsOAStreamCache.h"
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Number of samples per second of TestStreamSource, which is also the number of samples in a cache block. */
+	static constexpr UINT32 TEST_BLOCK_SIZE = 1000;
+
+	/** Size of a single cache block of TestStreamSource, in bytes. */
+	static constexpr UINT32 TEST_BLOCK_BYTES = TEST_BLOCK_SIZE * sizeof(INT16);
+
+	/** Returns the value TestStreamSource generates for the sample at the provided offset. */
+	INT16 getTestSample(UINT32 offset)
+	{
+		return (INT16)(offset % 30000);
+	}
+
+	/**
+	 * Mono 16-bit stream that generates its samples instead of decoding them, and keeps track of how many samples were
+	 * requested from it. Evicts itself from the cache when destroyed, same as OAAudioClip.
+	 */
+	class TestStreamSource : public OAStreamSource
+	{
+	public:
+		TestStreamSource(OAStreamCache& cache, UINT32 numSamples)
+			:mCache(cache), mNumSamples(numSamples)
+		{ }
+
+		~TestStreamSource()
+		{
+			mCache.evict(this);
+		}
+
+		AudioDataInfo getStreamInfo() const override
+		{
+			AudioDataInfo info;
+			info.bitDepth = 16;
+			info.numChannels = 1;
+			info.numSamples = mNumSamples;
+			info.sampleRate = TEST_BLOCK_SIZE;
+
+			return info;
+		}
+
+		void readStreamSamples(UINT8* samples, UINT32 offset, UINT32 count) const override
+		{
+			INT16* output = (INT16*)samples;
+			for (UINT32 i = 0; i < count; i++)
+				output[i] = getTestSample(offset + i);
+
+			mNumReadSamples += count;
+		}
+
+		mutable std::atomic<UINT32> mNumReadSamples { 0 };
+
+	private:
+		OAStreamCache& mCache;
+		UINT32 mNumSamples;
+	};
+
+	/** Reads the samples through the cache and checks they match the ones generated by TestStreamSource. */
+	bool readAndVerify(OAStreamCache& cache, const SPtr<TestStreamSource>& stream, UINT32 offset, UINT32 count,
+		bool loop = false)
+	{
+		Vector<INT16> samples(count);
+		cache.read(stream, offset, count, (UINT8*)samples.data(), loop);
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			if (samples[i] != getTestSample(offset + i))
+				return false;
+		}
+
+		return true;
+	}
+
+	class OAStreamCacheTestSuite : public TestSuite
+	{
+	public:
+		OAStreamCacheTestSuite();
+
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testHitAndMiss();
+		void testPrefetch();
+		void testEviction();
+		void testEvictOnDestroy();
+	};
+
+	OAStreamCacheTestSuite::OAStreamCacheTestSuite()
+	{
+		BS_ADD_TEST(OAStreamCacheTestSuite::testHitAndMiss);
+		BS_ADD_TEST(OAStreamCacheTestSuite::testPrefetch);
+		BS_ADD_TEST(OAStreamCacheTestSuite::testEviction);
+		BS_ADD_TEST(OAStreamCacheTestSuite::testEvictOnDestroy);
+	}
+
+	void OAStreamCacheTestSuite::startUp()
+	{
+		// Prefetching queues tasks on the task scheduler
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(2);
+		TaskScheduler::startUp();
+	}
+
+	void OAStreamCacheTestSuite::shutDown()
+	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	void OAStreamCacheTestSuite::testHitAndMiss()
+	{
+		OAStreamCache cache;
+		cache.setPrefetchCount(0);
+
+		SPtr<TestStreamSource> stream = bs_shared_ptr_new<TestStreamSource>(cache, TEST_BLOCK_SIZE * 3 + 500);
+
+		// Misses decode whole blocks, even if only a part of one is read
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 0, 1500));
+		BS_TEST_ASSERT(stream->mNumReadSamples == TEST_BLOCK_SIZE * 2);
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 0));
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 1));
+		BS_TEST_ASSERT(!cache.isCached(stream.get(), 2));
+		BS_TEST_ASSERT(cache.getSize() == TEST_BLOCK_BYTES * 2);
+
+		// Hits don't decode again, regardless of how the read range is aligned to blocks
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 200, 1600));
+		BS_TEST_ASSERT(stream->mNumReadSamples == TEST_BLOCK_SIZE * 2);
+
+		// Last block is partial, reads past the end of the stream return silence
+		Vector<INT16> samples(1000, 1);
+		cache.read(stream, TEST_BLOCK_SIZE * 3, 1000, (UINT8*)samples.data(), false);
+		BS_TEST_ASSERT(stream->mNumReadSamples == TEST_BLOCK_SIZE * 2 + 500);
+		BS_TEST_ASSERT(cache.getSize() == TEST_BLOCK_BYTES * 2 + 500 * sizeof(INT16));
+		BS_TEST_ASSERT(samples[499] == getTestSample(TEST_BLOCK_SIZE * 3 + 499));
+		BS_TEST_ASSERT(samples[500] == 0 && samples[999] == 0);
+	}
+
+	void OAStreamCacheTestSuite::testPrefetch()
+	{
+		OAStreamCache cache;
+		cache.setPrefetchCount(2);
+
+		SPtr<TestStreamSource> stream = bs_shared_ptr_new<TestStreamSource>(cache, TEST_BLOCK_SIZE * 5);
+
+		// Blocks following the read are decoded ahead of time
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 0, 100));
+		cache.waitForPrefetch();
+
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 1));
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 2));
+		BS_TEST_ASSERT(!cache.isCached(stream.get(), 3));
+		BS_TEST_ASSERT(stream->mNumReadSamples == TEST_BLOCK_SIZE * 3);
+
+		// Reading prefetched blocks doesn't decode them again
+		BS_TEST_ASSERT(readAndVerify(cache, stream, TEST_BLOCK_SIZE, TEST_BLOCK_SIZE * 2));
+		cache.waitForPrefetch();
+
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 3));
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 4));
+		BS_TEST_ASSERT(stream->mNumReadSamples == TEST_BLOCK_SIZE * 5);
+
+		// Prefetch stops at the end of the stream, unless looping
+		SPtr<TestStreamSource> other = bs_shared_ptr_new<TestStreamSource>(cache, TEST_BLOCK_SIZE * 5);
+		BS_TEST_ASSERT(readAndVerify(cache, other, TEST_BLOCK_SIZE * 4, 100));
+		cache.waitForPrefetch();
+
+		BS_TEST_ASSERT(!cache.isCached(other.get(), 0));
+		BS_TEST_ASSERT(other->mNumReadSamples == TEST_BLOCK_SIZE);
+
+		BS_TEST_ASSERT(readAndVerify(cache, other, TEST_BLOCK_SIZE * 4, 100, true));
+		cache.waitForPrefetch();
+
+		BS_TEST_ASSERT(cache.isCached(other.get(), 0));
+		BS_TEST_ASSERT(cache.isCached(other.get(), 1));
+		BS_TEST_ASSERT(other->mNumReadSamples == TEST_BLOCK_SIZE * 3);
+	}
+
+	void OAStreamCacheTestSuite::testEviction()
+	{
+		OAStreamCache cache;
+		cache.setPrefetchCount(0);
+		cache.setMaxSize(TEST_BLOCK_BYTES * 3);
+
+		SPtr<TestStreamSource> stream = bs_shared_ptr_new<TestStreamSource>(cache, TEST_BLOCK_SIZE * 10);
+
+		// Least recently used blocks are evicted once over budget
+		for (UINT32 i = 0; i < 5; i++)
+			BS_TEST_ASSERT(readAndVerify(cache, stream, i * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE));
+
+		BS_TEST_ASSERT(cache.getSize() == TEST_BLOCK_BYTES * 3);
+		BS_TEST_ASSERT(!cache.isCached(stream.get(), 0));
+		BS_TEST_ASSERT(!cache.isCached(stream.get(), 1));
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 2));
+
+		// Hits count as uses
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 2 * TEST_BLOCK_SIZE, 10));
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 5 * TEST_BLOCK_SIZE, 10));
+
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 2));
+		BS_TEST_ASSERT(!cache.isCached(stream.get(), 3));
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 4));
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 5));
+
+		// Evicted blocks decode again when read
+		UINT32 numReadSamples = stream->mNumReadSamples;
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 0, 10));
+		BS_TEST_ASSERT(stream->mNumReadSamples == numReadSamples + TEST_BLOCK_SIZE);
+
+		// Lowering the budget evicts immediately, keeping only the most recently used block
+		cache.setMaxSize(TEST_BLOCK_BYTES);
+		BS_TEST_ASSERT(cache.getSize() == TEST_BLOCK_BYTES);
+		BS_TEST_ASSERT(cache.isCached(stream.get(), 0));
+
+		// Without a budget reads bypass the cache
+		cache.setMaxSize(0);
+		numReadSamples = stream->mNumReadSamples;
+
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 100, 10));
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 100, 10));
+		BS_TEST_ASSERT(stream->mNumReadSamples == numReadSamples + 20);
+	}
+
+	void OAStreamCacheTestSuite::testEvictOnDestroy()
+	{
+		OAStreamCache cache;
+		cache.setPrefetchCount(0);
+
+		SPtr<TestStreamSource> stream = bs_shared_ptr_new<TestStreamSource>(cache, TEST_BLOCK_SIZE * 4);
+		SPtr<TestStreamSource> other = bs_shared_ptr_new<TestStreamSource>(cache, TEST_BLOCK_SIZE * 4);
+
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 0, TEST_BLOCK_SIZE * 2));
+		BS_TEST_ASSERT(readAndVerify(cache, other, 0, TEST_BLOCK_SIZE));
+		BS_TEST_ASSERT(cache.getSize() == TEST_BLOCK_BYTES * 3);
+
+		stream = nullptr;
+		BS_TEST_ASSERT(cache.getSize() == TEST_BLOCK_BYTES);
+		BS_TEST_ASSERT(cache.isCached(other.get(), 0));
+
+		// Queued decodes keep the stream alive, its blocks get evicted once they finish and release it
+		cache.setPrefetchCount(2);
+		stream = bs_shared_ptr_new<TestStreamSource>(cache, TEST_BLOCK_SIZE * 4);
+
+		BS_TEST_ASSERT(readAndVerify(cache, stream, 0, 10));
+		stream = nullptr;
+
+		cache.waitForPrefetch();
+		BS_TEST_ASSERT(cache.getSize() == TEST_BLOCK_BYTES);
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	SPtr<TestSuite> tests = OAStreamCacheTestSuite::create<OAStreamCacheTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	return 0;
+}
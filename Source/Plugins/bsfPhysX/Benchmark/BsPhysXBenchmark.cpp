@@ -0,0 +1,189 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysXPrerequisites.h"
+#include "BsPhysXCPUDispatcher.h"
+#include "PxPhysicsAPI.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Physics/BsPhysics.h"
+#include "Utility/BsTimer.h"
+#include <iostream>
+
+using namespace physx;
+
+namespace bs
+{
+	/** Number of stacks along each horizontal axis. */
+	static constexpr UINT32 NUM_STACKS_PER_AXIS = 25;
+
+	/** Number of boxes in a single stack. */
+	static constexpr UINT32 STACK_HEIGHT = 16;
+
+	/** Number of simulation steps to measure. */
+	static constexpr UINT32 NUM_STEPS = 300;
+
+	static constexpr float TIME_STEP = 1.0f / 60.0f;
+
+	/** Spin counts to measure the dispatcher with, before its workers go to sleep. */
+	static constexpr UINT32 SPIN_COUNTS[] = { 0, 16, 64, 256 };
+
+	class BenchmarkAllocator : public PxAllocatorCallback
+	{
+	public:
+		void* allocate(size_t size, const char*, const char*, int) override
+		{
+			return bs_alloc_aligned16((UINT32)size);
+		}
+
+		void deallocate(void* ptr) override
+		{
+			bs_free_aligned16(ptr);
+		}
+	};
+
+	class BenchmarkErrorCallback : public PxErrorCallback
+	{
+	public:
+		void reportError(PxErrorCode::Enum code, const char* message, const char* file, int line) override
+		{
+			std::cout << "PhysX error: " << message << std::endl;
+		}
+	};
+
+	/** Dispatcher that runs PhysX tasks through the TaskScheduler, as done before PhysXCPUDispatcher was introduced. */
+	class TaskSchedulerDispatcher : public PxCpuDispatcher
+	{
+	public:
+		void submitTask(PxBaseTask& physxTask) override
+		{
+			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
+			SPtr<Task> task = Task::create("PhysX", runTask);
+
+			TaskScheduler::instance().addTask(task);
+		}
+
+		PxU32 getWorkerCount() const override
+		{
+			return (PxU32)TaskScheduler::instance().getNumWorkers();
+		}
+	};
+
+	PxFilterFlags benchmarkFilterShader(PxFilterObjectAttributes attr0, PxFilterData data0, 
+		PxFilterObjectAttributes attr1, PxFilterData data1, PxPairFlags& pairFlags, const void* constantBlock, 
+		PxU32 constantBlockSize)
+	{
+		pairFlags = PxPairFlag::eSOLVE_CONTACT | PxPairFlag::eDETECT_DISCRETE_CONTACT;
+		return PxFilterFlags();
+	}
+
+	/** 
+	 * Creates a scene containing a grid of box stacks, simulates it using the provided dispatcher and returns the average
+	 * time of a single simulation step, in milliseconds.
+	 */
+	double runStackBenchmark(PxPhysics& physics, PxCpuDispatcher& dispatcher)
+	{
+		PxTolerancesScale scale;
+
+		PxSceneDesc sceneDesc(scale);
+		sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+		sceneDesc.cpuDispatcher = &dispatcher;
+		sceneDesc.filterShader = benchmarkFilterShader;
+		sceneDesc.flags = PxSceneFlag::eENABLE_ACTIVETRANSFORMS;
+		sceneDesc.broadPhaseType = PxBroadPhaseType::eSAP;
+
+		PxScene* scene = physics.createScene(sceneDesc);
+		PxMaterial* material = physics.createMaterial(0.5f, 0.5f, 0.1f);
+
+		PxRigidStatic* ground = physics.createRigidStatic(PxTransform(PxVec3(0.0f, -1.0f, 0.0f)));
+		PxShape* groundShape = physics.createShape(PxBoxGeometry(100.0f, 1.0f, 100.0f), *material, true);
+		ground->attachShape(*groundShape);
+		groundShape->release();
+		scene->addActor(*ground);
+
+		const float halfExtent = 0.5f;
+		PxShape* boxShape = physics.createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *material, true);
+
+		const float offset = (NUM_STACKS_PER_AXIS - 1) * 1.5f;
+		for (UINT32 x = 0; x < NUM_STACKS_PER_AXIS; x++)
+		{
+			for (UINT32 z = 0; z < NUM_STACKS_PER_AXIS; z++)
+			{
+				for (UINT32 y = 0; y < STACK_HEIGHT; y++)
+				{
+					PxVec3 position(x * 3.0f - offset, halfExtent + y * (halfExtent * 2.0f), z * 3.0f - offset);
+
+					PxRigidDynamic* box = physics.createRigidDynamic(PxTransform(position));
+					box->attachShape(*boxShape);
+					box->setMass(1.0f);
+					box->setMassSpaceInertiaTensor(PxVec3(1.0f / 6.0f));
+
+					scene->addActor(*box);
+				}
+			}
+		}
+
+		boxShape->release();
+
+		Timer timer;
+		for (UINT32 i = 0; i < NUM_STEPS; i++)
+		{
+			scene->simulate(TIME_STEP);
+			scene->fetchResults(true);
+		}
+
+		const double avgStepTime = timer.getMicroseconds() / (double)NUM_STEPS / 1000.0;
+
+		scene->release();
+		material->release();
+
+		return avgStepTime;
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	ThreadPool::startUp<TThreadPool<>>(std::max(1U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY - 1));
+	TaskScheduler::startUp();
+
+	// Sized the same way as by the PhysX plugin
+	PHYSICS_INIT_DESC desc;
+	const UINT32 numSchedulerWorkers = TaskScheduler::instance().getNumWorkers();
+	const UINT32 numWorkers = numSchedulerWorkers > desc.numReservedWorkers ? 
+		numSchedulerWorkers - desc.numReservedWorkers : 1;
+
+	BenchmarkAllocator allocator;
+	BenchmarkErrorCallback errorCallback;
+
+	PxTolerancesScale scale;
+	PxFoundation* foundation = PxCreateFoundation(PX_PHYSICS_VERSION, allocator, errorCallback);
+	PxPhysics* physics = PxCreateBasePhysics(PX_PHYSICS_VERSION, *foundation, scale);
+
+	const UINT32 numBodies = NUM_STACKS_PER_AXIS * NUM_STACKS_PER_AXIS * STACK_HEIGHT;
+	std::cout << "Simulating " << numBodies << " rigidbodies for " << NUM_STEPS << " steps, using " << numWorkers 
+		<< " workers (" << numSchedulerWorkers << " for the TaskScheduler)." << std::endl;
+
+	{
+		TaskSchedulerDispatcher dispatcher;
+		double stepTime = runStackBenchmark(*physics, dispatcher);
+
+		std::cout << "TaskScheduler dispatcher: " << stepTime << " ms per step" << std::endl;
+	}
+
+	for (auto numSpins : SPIN_COUNTS)
+	{
+		PhysXCPUDispatcher dispatcher(numWorkers, numSpins);
+		double stepTime = runStackBenchmark(*physics, dispatcher);
+
+		std::cout << "PhysXCPUDispatcher (" << numSpins << " spins): " << stepTime << " ms per step" << std::endl;
+	}
+
+	physics->release();
+	foundation->release();
+
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+
+	return 0;
+}
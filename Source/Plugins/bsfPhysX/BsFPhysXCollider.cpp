@@ -25,6 +25,9 @@ namespace bs
 
 	FPhysXCollider::~FPhysXCollider()
 	{
+		gPhysX()._waitForSimulation();
+		gPhysX()._notifyColliderDestroyed((Collider*)mShape->userData);
+
 		if (mStaticBody != nullptr)
 			mStaticBody->release();
 
@@ -34,6 +37,8 @@ namespace bs
 
 	void FPhysXCollider::_setShape(PxShape* shape)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (mShape != nullptr)
 		{
 			shape->setLocalPose(mShape->getLocalPose());
@@ -80,11 +85,14 @@ namespace bs
 
 	void FPhysXCollider::setTransform(const Vector3& pos, const Quaternion& rotation)
 	{
+		gPhysX()._waitForSimulation();
 		mShape->setLocalPose(toPxTransform(pos, rotation));
 	}
 
 	void FPhysXCollider::setIsTrigger(bool value)
 	{
+		gPhysX()._waitForSimulation();
+
 		if(value)
 		{
 			mShape->setFlag(PxShapeFlag::eSIMULATION_SHAPE, false);
@@ -108,6 +116,8 @@ namespace bs
 
 	void FPhysXCollider::setIsStatic(bool value)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (mIsStatic == value)
 			return;
 
@@ -138,6 +148,7 @@ namespace bs
 
 	void FPhysXCollider::setContactOffset(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mShape->setContactOffset(value);
 	}
 
@@ -148,6 +159,7 @@ namespace bs
 
 	void FPhysXCollider::setRestOffset(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mShape->setRestOffset(value);
 	}
 
@@ -158,6 +170,8 @@ namespace bs
 
 	void FPhysXCollider::setMaterial(const HPhysicsMaterial& material)
 	{
+		gPhysX()._waitForSimulation();
+
 		FCollider::setMaterial(material);
 
 		PhysXMaterial* physXmaterial = nullptr;
@@ -180,6 +194,7 @@ namespace bs
 
 	void FPhysXCollider::setLayer(UINT64 layer)
 	{
+		gPhysX()._waitForSimulation();
 		mLayer = layer;
 		updateFilter();
 	}
@@ -191,12 +206,14 @@ namespace bs
 
 	void FPhysXCollider::setCollisionReportMode(CollisionReportMode mode)
 	{
+		gPhysX()._waitForSimulation();
 		mCollisionReportMode = mode;
 		updateFilter();
 	}
 
 	void FPhysXCollider::_setCCD(bool enabled)
 	{
+		gPhysX()._waitForSimulation();
 		mCCD = enabled;
 		updateFilter();
 	}
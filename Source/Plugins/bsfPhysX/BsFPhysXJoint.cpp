@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsFPhysXJoint.h"
+#include "BsPhysX.h"
 #include "BsPhysXRigidbody.h"
 #include "Physics/BsJoint.h"
 #include "PxRigidDynamic.h"
@@ -26,6 +27,9 @@ namespace bs
 
 	FPhysXJoint::~FPhysXJoint()
 	{
+		gPhysX()._waitForSimulation();
+		gPhysX()._notifyJointDestroyed((Joint*)mJoint->userData);
+
 		mJoint->userData = nullptr;
 		mJoint->release();
 	}
@@ -46,6 +50,8 @@ namespace bs
 
 	void FPhysXJoint::setBody(JointBody body, Rigidbody* value)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxRigidActor* actorA = nullptr;
 		PxRigidActor* actorB = nullptr;
 
@@ -79,6 +85,8 @@ namespace bs
 
 	void FPhysXJoint::setTransform(JointBody body, const Vector3& position, const Quaternion& rotation)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxTransform transform = toPxTransform(position, rotation);
 
 		mJoint->setLocalPose(toJointActor(body), transform);
@@ -95,6 +103,8 @@ namespace bs
 
 	void FPhysXJoint::setBreakForce(float force)
 	{
+		gPhysX()._waitForSimulation();
+
 		float dummy = 0.0f;
 		float torque = 0.0f;
 
@@ -113,6 +123,8 @@ namespace bs
 
 	void FPhysXJoint::setBreakTorque(float torque)
 	{
+		gPhysX()._waitForSimulation();
+
 		float force = 0.0f;
 		float dummy = 0.0f;
 
@@ -127,6 +139,7 @@ namespace bs
 
 	void FPhysXJoint::setEnableCollision(bool value)
 	{
+		gPhysX()._waitForSimulation();
 		mJoint->setConstraintFlag(PxConstraintFlag::eCOLLISION_ENABLED, value);
 	}
 }
\ No newline at end of file
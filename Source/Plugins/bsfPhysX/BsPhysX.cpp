@@ -17,6 +17,7 @@
 #include "BsPhysXSliderJoint.h"
 #include "BsPhysXD6Joint.h"
 #include "BsPhysXCharacterController.h"
+#include "BsPhysXCPUDispatcher.h"
 #include "Threading/BsTaskScheduler.h"
 #include "Components/BsCCollider.h"
 #include "BsFPhysXCollider.h"
@@ -182,6 +183,12 @@ namespace bs
 
 				PhysX::TriggerEvent event;
 				event.trigger = (Collider*)pair.triggerShape->userData;
+
+				// Only the trigger receives the event, so like with contacts only the layer of the receiver is checked. The
+				// other collider's layer doesn't matter, same as its report mode.
+				if (!gPhysX().isEventLayer(event.trigger->getLayer()))
+					continue;
+
 				event.other = (Collider*)pair.otherShape->userData;
 				event.type = type;
 
@@ -191,33 +198,56 @@ namespace bs
 
 		void onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 count) override
 		{
+			PhysX& physX = gPhysX();
+
+			// Returns how the collider wants to receive events, taking into account layers that have events disabled
+			auto getReportMode = [&physX](Collider* collider)
+			{
+				if (collider == nullptr || !physX.isEventLayer(collider->getLayer()))
+					return CollisionReportMode::None;
+
+				return collider->getCollisionReportMode();
+			};
+
 			for (PxU32 i = 0; i < count; i++)
 			{
 				const PxContactPair& pair = pairs[i];
 
-				PhysX::ContactEventType type;
-				bool ignoreContact = false;
-				switch((UINT32)pair.events)
+				PhysX::ContactEvent event;
+				event.colliderA = (Collider*)pair.shapes[0]->userData;
+				event.colliderB = (Collider*)pair.shapes[1]->userData;
+
+				// Filter out events nobody is listening to, before recording them
+				CollisionReportMode reportModeA = getReportMode(event.colliderA);
+				CollisionReportMode reportModeB = getReportMode(event.colliderB);
+
+				if (reportModeA == CollisionReportMode::None && reportModeB == CollisionReportMode::None)
+					continue;
+
+				// Persistent contacts are only reported if a listener explicitly asked for them. Touch can also be both
+				// found and lost during the same step, in which case both events are reported.
+				PhysX::ContactEventType types[2];
+				UINT32 numTypes = 0;
+
+				if (pair.events.isSet(PxPairFlag::eNOTIFY_TOUCH_FOUND))
+					types[numTypes++] = PhysX::ContactEventType::ContactBegin;
+				else if (pair.events.isSet(PxPairFlag::eNOTIFY_TOUCH_PERSISTS))
 				{
-				case PxPairFlag::eNOTIFY_TOUCH_FOUND:
-					type = PhysX::ContactEventType::ContactBegin;
-					break;
-				case PxPairFlag::eNOTIFY_TOUCH_PERSISTS:
-					type = PhysX::ContactEventType::ContactStay;
-					break;
-				case PxPairFlag::eNOTIFY_TOUCH_LOST:
-					type = PhysX::ContactEventType::ContactEnd;
-					break;
-				default:
-					ignoreContact = true;
-					break;
+					if (reportModeA == CollisionReportMode::ReportPersistent || 
+						reportModeB == CollisionReportMode::ReportPersistent)
+					{
+						types[numTypes++] = PhysX::ContactEventType::ContactStay;
+					}
 				}
 
-				if (ignoreContact)
+				if (pair.events.isSet(PxPairFlag::eNOTIFY_TOUCH_LOST))
+					types[numTypes++] = PhysX::ContactEventType::ContactEnd;
+
+				if (numTypes == 0)
 					continue;
 
-				PhysX::ContactEvent event;
-				event.type = type;
+				event.firstPoint = 0;
+				event.numPoints = 0;
 
 				PxU32 contactCount = pair.contactCount;
 				const PxU8* stream = pair.contactStream;
@@ -250,17 +280,35 @@ namespace bs
 							else
 								point.impulse = 0.0f;
 
-							event.points.push_back(point);
+							UINT32 pointIdx = physX._reportContactPoint(point);
+							if (contactIdx == 0)
+								event.firstPoint = pointIdx;
 
 							contactIdx++;
 						}
 					}
+
+					event.numPoints = contactIdx;
 				}
 
-				event.colliderA = (Collider*)pair.shapes[0]->userData;
-				event.colliderB = (Collider*)pair.shapes[1]->userData;
+				// Events share the same contact points
+				for (UINT32 j = 0; j < numTypes; j++)
+				{
+					event.type = types[j];
+
+					if (event.type == PhysX::ContactEventType::ContactStay)
+					{
+						event.notifyA = reportModeA == CollisionReportMode::ReportPersistent;
+						event.notifyB = reportModeB == CollisionReportMode::ReportPersistent;
+					}
+					else
+					{
+						event.notifyA = reportModeA != CollisionReportMode::None;
+						event.notifyB = reportModeB != CollisionReportMode::None;
+					}
 
-				gPhysX()._reportContactEvent(event);
+					physX._reportContactEvent(event);
+				}
 			}
 		}
 
@@ -284,28 +332,6 @@ namespace bs
 		}
 	};
 
-	class PhysXCPUDispatcher : public PxCpuDispatcher
-	{
-	public:
-		void submitTask(PxBaseTask& physxTask) override
-		{
-			// Note: Banshee's task scheduler is pretty low granularity. Consider a better task manager in case PhysX ends
-			// up submitting many tasks.
-			// - PhysX's task manager doesn't seem much lighter either. But perhaps I can at least create a task pool to 
-			//   avoid allocating them constantly.
-
-			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
-			SPtr<Task> task = Task::create("PhysX", runTask);
-
-			TaskScheduler::instance().addTask(task);
-		}
-
-		PxU32 getWorkerCount() const override
-		{
-			return (PxU32)TaskScheduler::instance().getNumWorkers();
-		}
-	};
-
 	class PhysXBroadPhaseCallback : public PxBroadPhaseCallback
 	{
 		void onObjectOutOfBounds(PxShape& shape, PxActor& actor) override
@@ -454,9 +480,40 @@ namespace bs
 		}
 	};
 
+	void parseHit(const PxOverlapHit& input, PhysicsQueryHit& output)
+	{
+		output.colliderRaw = (Collider*)input.shape->userData;
+
+		if (output.colliderRaw != nullptr)
+		{
+			CCollider* component = (CCollider*)output.colliderRaw->_getOwner(PhysicsOwnerType::Component);
+			if (component != nullptr)
+				output.collider = static_object_cast<CCollider>(component->getHandle());
+		}
+	}
+
+	/** 
+	 * Resources used for executing a range of queries from a query batch. Kept around between batches so executing a
+	 * batch doesn't need to allocate memory.
+	 */
+	struct PhysXQueryBatchChunk
+	{
+		/** Maximum number of queries executed by a single chunk. */
+		static constexpr UINT32 MAX_QUERIES = 64;
+
+		PxBatchQuery* batchQuery = nullptr;
+
+		PxRaycastQueryResult raycastResults[MAX_QUERIES];
+		PxSweepQueryResult sweepResults[MAX_QUERIES];
+		PxOverlapQueryResult overlapResults[MAX_QUERIES];
+
+		Vector<PxRaycastHit> raycastTouches;
+		Vector<PxSweepHit> sweepTouches;
+		Vector<PxOverlapHit> overlapTouches;
+	};
+
 	static PhysXAllocator gPhysXAllocator;
 	static PhysXErrorCallback gPhysXErrorHandler;
-	static PhysXCPUDispatcher gPhysXCPUDispatcher;
 	static PhysXEventCallback gPhysXEventCallback;
 	static PhysXBroadPhaseCallback gPhysXBroadphaseCallback;
 
@@ -483,9 +540,18 @@ namespace bs
 			mCooking = PxCreateCooking(PX_PHYSICS_VERSION, *mFoundation, cookingParams);
 		}
 
+		// Simulation threads compete with TaskScheduler workers for the same cores, so leave some of the workers' share
+		// to other systems
+		const UINT32 numWorkers = TaskScheduler::instance().getNumWorkers();
+		const UINT32 numSimulationWorkers = numWorkers > input.numReservedWorkers ? 
+			numWorkers - input.numReservedWorkers : 1;
+
+		mCPUDispatcher = bs_new<PhysXCPUDispatcher>(numSimulationWorkers, input.numSpinsBeforeSleep);
+		mScratchBuffer = (UINT8*)bs_alloc_aligned16(SCRATCH_BUFFER_SIZE);
+
 		PxSceneDesc sceneDesc(mScale); // TODO - Test out various other parameters provided by scene desc
 		sceneDesc.gravity = toPxVector(input.gravity);
-		sceneDesc.cpuDispatcher = &gPhysXCPUDispatcher;
+		sceneDesc.cpuDispatcher = mCPUDispatcher;
 		sceneDesc.filterShader = PhysXFilterShader;
 		sceneDesc.simulationEventCallback = &gPhysXEventCallback;
 		sceneDesc.broadPhaseCallback = &gPhysXBroadphaseCallback;
@@ -509,9 +575,22 @@ namespace bs
 
 	PhysX::~PhysX()
 	{
+		if (mSimulationInProgress)
+			mScene->fetchResults(true);
+
+		for (auto& entry : mQueryBatchChunks)
+		{
+			entry->batchQuery->release();
+			bs_delete(entry);
+		}
+
 		mCharManager->release();
 		mScene->release();
 
+		// Must be destroyed after the scene, as the scene can still be using it
+		bs_delete(mCPUDispatcher);
+		bs_free_aligned16(mScratchBuffer);
+
 		if (mCooking != nullptr)
 			mCooking->release();
 
@@ -521,29 +600,48 @@ namespace bs
 
 	void PhysX::fixedUpdate(float step)
 	{
+		const bool async = mFlags.isSet(PhysicsFlag::Async_Simulation);
+
+		// Retrieve results of the step started during the last fixed update, before starting a new one. The results
+		// might have already been retrieved if the scene was accessed in the meantime, in which case they are only applied
+		// now, so events are always triggered from here. Results are not interpolated if async simulation was disabled
+		// in the meantime.
+		if (mSimulationInProgress)
+			fetchResults();
+
+		if (mResultsPending)
+			applyResults(async);
+
 		if (mPaused)
 			return;
 
-		mUpdateInProgress = true;
-
-		// Note: Consider delaying fetchResults one frame. This could improve performance because Physics update would be
-		//       able to run parallel to the simulation thread, but at a cost to input latency.
-		bs_frame_mark();
-		UINT8* scratchBuffer = bs_frame_alloc_aligned(SCRATCH_BUFFER_SIZE, 16);
+		mScene->simulate(step, nullptr, mScratchBuffer, SCRATCH_BUFFER_SIZE);
+		mSimulationInProgress = true;
+		mSimulationThread = BS_THREAD_CURRENT_ID;
+		mSimulationStep = (UINT64)(step * 1000000.0);
 
-		mScene->simulate(step, nullptr, scratchBuffer, SCRATCH_BUFFER_SIZE);
+		if (!async)
+		{
+			fetchResults();
+			applyResults(false);
+		}
+	}
 
+	void PhysX::fetchResults()
+	{
 		UINT32 errorState;
 		if (!mScene->fetchResults(true, &errorState))
 			LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
 
-		bs_frame_free_aligned(scratchBuffer);
-		bs_frame_clear();
+		mSimulationInProgress = false;
+		mResultsPending = true;
 
-		// Update rigidbodies with new transforms
 		PxU32 numActiveTransforms;
 		const PxActiveTransform* activeTransforms = mScene->getActiveTransforms(numActiveTransforms);
 
+		mResults.clear();
+		mResults.reserve(numActiveTransforms);
+
 		for (PxU32 i = 0; i < numActiveTransforms; i++)
 		{
 			Rigidbody* rigidbody = static_cast<Rigidbody*>(activeTransforms[i].userData);
@@ -555,13 +653,52 @@ namespace bs
 				continue;
 
 			const PxTransform& transform = activeTransforms[i].actor2World;
+			mResults.push_back({ rigidbody, fromPxVector(transform.p), fromPxQuaternion(transform.q) });
+		}
+	}
+
+	void PhysX::applyResults(bool interpolate)
+	{
+		mResultsPending = false;
+		mUpdateInProgress = true;
+
+		// Previous results have been reached, so they become the starting point of the new interpolation
+		if (interpolate)
+			mInterpolator.beginStep(gTime().getLastFixedUpdateTimePrecise(), mSimulationStep);
+
+		// Update rigidbodies with new transforms
+		mPoses.clear();
+		if (!interpolate)
+			mPoses.reserve(mResults.size());
+
+		for (auto& entry : mResults)
+		{
+			if (!interpolate)
+			{
+				// Applied in bulk below, so all the transforms are written before any components are notified
+				mPoses.push_back({ entry.rigidbody->_getSceneObject(), entry.position, entry.rotation });
+				continue;
+			}
+
+			if (!mInterpolator.setResult(entry.rigidbody, entry.position, entry.rotation))
+			{
+				// Body just started moving, start interpolating from its current transform
+				Vector3 startPosition;
+				Quaternion startRotation;
+				entry.rigidbody->_getTransform(startPosition, startRotation);
 
-			// Note: Make this faster, avoid dereferencing Rigidbody and attempt to access pos/rot destination directly,
-			//       use non-temporal writes
-			rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
+				mInterpolator.add(entry.rigidbody, entry.rigidbody->_getSceneObject(), startPosition, startRotation,
+					entry.position, entry.rotation);
+			}
 		}
 
-		// Note: Consider extrapolating for the remaining "simulationAmount" value
+		mResults.clear();
+
+		// Bodies that stopped moving have reached their final transform, no need to interpolate them further
+		if (interpolate)
+			mInterpolator.endStep(mPoses);
+
+		SceneObject::_setWorldPoses(mPoses.data(), (UINT32)mPoses.size());
 		mUpdateInProgress = false;
 
 		triggerEvents();
@@ -569,7 +706,80 @@ namespace bs
 
 	void PhysX::update()
 	{
-		// Note: Potentially interpolate (would mean a one frame delay needs to be introduced)
+		if (mInterpolator.isEmpty())
+			return;
+
+		// Displayed state lags one step behind the simulation. Interpolate between the results of the two most recently
+		// completed steps, where the latest result is reached at the time the last simulation step was started.
+		mInterpolator.evaluate(gTime().getTimePrecise(), mPoses);
+
+		mUpdateInProgress = true;
+		SceneObject::_setWorldPoses(mPoses.data(), (UINT32)mPoses.size());
+		mUpdateInProgress = false;
+	}
+
+	void PhysX::clearInterpolation()
+	{
+		mPoses.clear();
+		mInterpolator.clear(mPoses);
+
+		mUpdateInProgress = true;
+		SceneObject::_setWorldPoses(mPoses.data(), (UINT32)mPoses.size());
+		mUpdateInProgress = false;
+	}
+
+	void PhysX::_notifyRigidbodyTeleported(Rigidbody* rigidbody)
+	{
+		mInterpolator.remove(rigidbody);
+
+		// Results retrieved early would otherwise override the new transform, or reference a destroyed rigidbody
+		if (mResultsPending)
+		{
+			auto iterFind = std::find_if(mResults.begin(), mResults.end(), 
+				[rigidbody](const SimulationResult& entry) { return entry.rigidbody == rigidbody; });
+
+			if (iterFind != mResults.end())
+			{
+				*iterFind = mResults.back();
+				mResults.pop_back();
+			}
+		}
+	}
+
+	void PhysX::_notifyColliderDestroyed(Collider* collider)
+	{
+		// Events are only kept around between an early retrieval of the results and the next fixed update
+		if (!mResultsPending)
+			return;
+
+		mTriggerEvents.erase(std::remove_if(mTriggerEvents.begin(), mTriggerEvents.end(), 
+			[collider](const TriggerEvent& entry) { return entry.trigger == collider || entry.other == collider; }),
+			mTriggerEvents.end());
+
+		mContactEvents.erase(std::remove_if(mContactEvents.begin(), mContactEvents.end(), 
+			[collider](const ContactEvent& entry) { return entry.colliderA == collider || entry.colliderB == collider; }),
+			mContactEvents.end());
+	}
+
+	void PhysX::_notifyJointDestroyed(Joint* joint)
+	{
+		if (!mResultsPending)
+			return;
+
+		mJointBreakEvents.erase(std::remove_if(mJointBreakEvents.begin(), mJointBreakEvents.end(), 
+			[joint](const JointBreakEvent& entry) { return entry.joint == joint; }),
+			mJointBreakEvents.end());
+	}
+
+	void PhysX::_waitForSimulation() const
+	{
+		if (!mSimulationInProgress)
+			return;
+
+		BS_ASSERT(BS_THREAD_CURRENT_ID == mSimulationThread && 
+			"Physics scene accessed from another thread while the simulation is running.");
+
+		const_cast<PhysX*>(this)->fetchResults();
 	}
 
 	void PhysX::_reportContactEvent(const ContactEvent& event)
@@ -577,6 +787,12 @@ namespace bs
 		mContactEvents.push_back(event);
 	}
 
+	UINT32 PhysX::_reportContactPoint(const ContactPoint& point)
+	{
+		mContactPoints.push_back(point);
+		return (UINT32)mContactPoints.size() - 1;
+	}
+
 	void PhysX::_reportTriggerEvent(const TriggerEvent& event)
 	{
 		mTriggerEvents.push_back(event);
@@ -610,12 +826,14 @@ namespace bs
 			}
 		}
 
-		auto notifyContact = [&](Collider* obj, Collider* other, ContactEventType type, 
-			const Vector<ContactPoint>& points, bool flipNormals = false)
+		auto notifyContact = [&](Collider* obj, Collider* other, const ContactEvent& event, bool flipNormals = false)
 		{
 			data.colliders[0] = obj;
 			data.colliders[1] = other;
-			data.contactPoints = points;
+
+			// Assigning to the same array keeps its memory, so no allocation is needed once it grows large enough
+			const auto firstPoint = mContactPoints.begin() + event.firstPoint;
+			data.contactPoints.assign(firstPoint, firstPoint + event.numPoints);
 
 			if(flipNormals)
 			{
@@ -626,7 +844,7 @@ namespace bs
 			Rigidbody* rigidbody = obj->getRigidbody();
 			if(rigidbody != nullptr)
 			{
-				switch (type)
+				switch (event.type)
 				{
 				case ContactEventType::ContactBegin:
 					rigidbody->onCollisionBegin(data);
@@ -641,7 +859,7 @@ namespace bs
 			}
 			else
 			{
-				switch (type)
+				switch (event.type)
 				{
 				case ContactEventType::ContactBegin:
 					obj->onCollisionBegin(data);
@@ -656,27 +874,14 @@ namespace bs
 			}
 		};
 
+		// Events were already filtered according to the report mode of the colliders when recorded
 		for (auto& entry : mContactEvents)
 		{
-			if (entry.colliderA != nullptr)
-			{
-				CollisionReportMode reportModeA = entry.colliderA->getCollisionReportMode();
+			if (entry.notifyA)
+				notifyContact(entry.colliderA, entry.colliderB, entry, true);
 
-				if (reportModeA == CollisionReportMode::ReportPersistent)
-					notifyContact(entry.colliderA, entry.colliderB, entry.type, entry.points, true);
-				else if (reportModeA == CollisionReportMode::Report && entry.type != ContactEventType::ContactStay)
-					notifyContact(entry.colliderA, entry.colliderB, entry.type, entry.points, true);
-			}
-
-			if (entry.colliderB != nullptr)
-			{
-				CollisionReportMode reportModeB = entry.colliderB->getCollisionReportMode();
-
-				if (reportModeB == CollisionReportMode::ReportPersistent)
-					notifyContact(entry.colliderB, entry.colliderA, entry.type, entry.points, false);
-				else if (reportModeB == CollisionReportMode::Report && entry.type != ContactEventType::ContactStay)
-					notifyContact(entry.colliderB, entry.colliderA, entry.type, entry.points, false);
-			}
+			if (entry.notifyB)
+				notifyContact(entry.colliderB, entry.colliderA, entry, false);
 		}
 
 		for(auto& entry : mJointBreakEvents)
@@ -686,89 +891,107 @@ namespace bs
 
 		mTriggerEvents.clear();
 		mContactEvents.clear();
+		mContactPoints.clear();
 		mJointBreakEvents.clear();
 	}
 
 	SPtr<PhysicsMaterial> PhysX::createMaterial(float staticFriction, float dynamicFriction, float restitution)
 	{
+		_waitForSimulation();
 		return bs_core_ptr_new<PhysXMaterial>(mPhysics, staticFriction, dynamicFriction, restitution);
 	}
 
 	SPtr<PhysicsMesh> PhysX::createMesh(const SPtr<MeshData>& meshData, PhysicsMeshType type)
 	{
+		_waitForSimulation();
 		return bs_core_ptr_new<PhysXMesh>(meshData, type);
 	}
 
 	SPtr<Rigidbody> PhysX::createRigidbody(const HSceneObject& linkedSO)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXRigidbody>(mPhysics, mScene, linkedSO);
 	}
 
 	SPtr<BoxCollider> PhysX::createBoxCollider(const Vector3& extents, const Vector3& position,
 		const Quaternion& rotation)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXBoxCollider>(mPhysics, position, rotation, extents);
 	}
 
 	SPtr<SphereCollider> PhysX::createSphereCollider(float radius, const Vector3& position, const Quaternion& rotation)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXSphereCollider>(mPhysics, position, rotation, radius);
 	}
 
 	SPtr<PlaneCollider> PhysX::createPlaneCollider(const Vector3& position, const Quaternion& rotation)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXPlaneCollider>(mPhysics, position, rotation);
 	}
 
 	SPtr<CapsuleCollider> PhysX::createCapsuleCollider(float radius, float halfHeight, const Vector3& position, 
 		const Quaternion& rotation)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXCapsuleCollider>(mPhysics, position, rotation, radius, halfHeight);
 	}
 
 	SPtr<MeshCollider> PhysX::createMeshCollider(const Vector3& position, const Quaternion& rotation)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXMeshCollider>(mPhysics, position, rotation);
 	}
 
 	SPtr<FixedJoint> PhysX::createFixedJoint(const FIXED_JOINT_DESC& desc)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXFixedJoint>(mPhysics, desc);
 	}
 
 	SPtr<DistanceJoint> PhysX::createDistanceJoint(const DISTANCE_JOINT_DESC& desc)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXDistanceJoint>(mPhysics, desc);
 	}
 
 	SPtr<HingeJoint> PhysX::createHingeJoint(const HINGE_JOINT_DESC& desc)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXHingeJoint>(mPhysics, desc);
 	}
 
 	SPtr<SphericalJoint> PhysX::createSphericalJoint(const SPHERICAL_JOINT_DESC& desc)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXSphericalJoint>(mPhysics, desc);
 	}
 
 	SPtr<SliderJoint> PhysX::createSliderJoint(const SLIDER_JOINT_DESC& desc)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXSliderJoint>(mPhysics, desc);
 	}
 
 	SPtr<D6Joint> PhysX::createD6Joint(const D6_JOINT_DESC& desc)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXD6Joint>(mPhysics, desc);
 	}
 
 	SPtr<CharacterController> PhysX::createCharacterController(const CHAR_CONTROLLER_DESC& desc)
 	{
+		_waitForSimulation();
 		return bs_shared_ptr_new<PhysXCharacterController>(mCharManager, desc);
 	}
 
 	Vector<PhysicsQueryHit> PhysX::sweepAll(const PxGeometry& geometry, const PxTransform& tfrm, const Vector3& unitDir,
 		UINT64 layer, float maxDist) const
 	{
+		_waitForSimulation();
+
 		PhysXSweepQueryCallback output;
 
 		PxQueryFilterData filterData;
@@ -783,6 +1006,8 @@ namespace bs
 	bool PhysX::sweepAny(const PxGeometry& geometry, const PxTransform& tfrm, const Vector3& unitDir, UINT64 layer, 
 		float maxDist) const
 	{
+		_waitForSimulation();
+
 		PxSweepBuffer output;
 
 		PxQueryFilterData filterData;
@@ -795,6 +1020,8 @@ namespace bs
 
 	bool PhysX::rayCast(const Vector3& origin, const Vector3& unitDir, PhysicsQueryHit& hit, UINT64 layer, float max) const
 	{
+		_waitForSimulation();
+
 		PxRaycastBuffer output;
 
 		PxQueryFilterData filterData;
@@ -855,6 +1082,8 @@ namespace bs
 	Vector<PhysicsQueryHit> PhysX::rayCastAll(const Vector3& origin, const Vector3& unitDir,
 		UINT64 layer, float max) const
 	{
+		_waitForSimulation();
+
 		PhysXRaycastQueryCallback output;
 
 		PxQueryFilterData filterData;
@@ -912,6 +1141,8 @@ namespace bs
 	bool PhysX::rayCastAny(const Vector3& origin, const Vector3& unitDir,
 		UINT64 layer, float max) const
 	{
+		_waitForSimulation();
+
 		PxRaycastBuffer output;
 
 		PxQueryFilterData filterData;
@@ -1048,9 +1279,209 @@ namespace bs
 		return overlapAny(geometry, transform, layer);
 	}
 
+	void PhysX::queryBatch(const PHYSICS_QUERY_DESC* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+		UINT32 maxHitsPerQuery, UINT32* numHits) const
+	{
+		_waitForSimulation();
+
+		if (numQueries == 0)
+			return;
+
+		Lock lock(mQueryBatchMutex);
+
+		const UINT32 chunkSize = PhysXQueryBatchChunk::MAX_QUERIES;
+		const UINT32 numChunks = Math::divideAndRoundUp(numQueries, chunkSize);
+
+		while ((UINT32)mQueryBatchChunks.size() < numChunks)
+		{
+			PhysXQueryBatchChunk* chunk = bs_new<PhysXQueryBatchChunk>();
+
+			PxBatchQueryDesc desc(chunkSize, chunkSize, chunkSize);
+			desc.queryMemory.userRaycastResultBuffer = chunk->raycastResults;
+			desc.queryMemory.userSweepResultBuffer = chunk->sweepResults;
+			desc.queryMemory.userOverlapResultBuffer = chunk->overlapResults;
+
+			chunk->batchQuery = mScene->createBatchQuery(desc);
+			mQueryBatchChunks.push_back(chunk);
+		}
+
+		auto executeChunk = [=](UINT32 idx)
+		{
+			const UINT32 start = idx * chunkSize;
+			const UINT32 count = std::min(chunkSize, numQueries - start);
+
+			executeQueryBatchChunk(*mQueryBatchChunks[idx], queries + start, count, 
+				hits + start * maxHitsPerQuery, maxHitsPerQuery, numHits + start);
+		};
+
+		if (numChunks == 1)
+		{
+			executeChunk(0);
+			return;
+		}
+
+		SPtr<TaskGroup> taskGroup = TaskGroup::create("PhysicsQueryBatch", executeChunk, numChunks);
+		TaskScheduler::instance().addTaskGroup(taskGroup);
+		taskGroup->wait();
+	}
+
+	void PhysX::executeQueryBatchChunk(PhysXQueryBatchChunk& chunk, const PHYSICS_QUERY_DESC* queries,
+		UINT32 numQueries, PhysicsQueryHit* hits, UINT32 maxHitsPerQuery, UINT32* numHits) const
+	{
+		// PhysX limits the number of touches per query to 16 bits
+		const PxU16 maxTouches = (PxU16)std::min(maxHitsPerQuery, 0xFFFFU);
+
+		UINT32 numRaycasts = 0;
+		UINT32 numSweeps = 0;
+		UINT32 numOverlaps = 0;
+		for (UINT32 i = 0; i < numQueries; i++)
+		{
+			switch (queries[i].type)
+			{
+			case PhysicsQueryType::RayCast:
+				numRaycasts++;
+				break;
+			case PhysicsQueryType::BoxCast:
+			case PhysicsQueryType::SphereCast:
+			case PhysicsQueryType::CapsuleCast:
+				numSweeps++;
+				break;
+			default:
+				numOverlaps++;
+				break;
+			}
+		}
+
+		// Only grows, so memory is allocated only for the first few batches
+		if (chunk.raycastTouches.size() < numRaycasts * maxTouches)
+			chunk.raycastTouches.resize(numRaycasts * maxTouches);
+
+		if (chunk.sweepTouches.size() < numSweeps * maxTouches)
+			chunk.sweepTouches.resize(numSweeps * maxTouches);
+
+		if (chunk.overlapTouches.size() < numOverlaps * maxTouches)
+			chunk.overlapTouches.resize(numOverlaps * maxTouches);
+
+		PxBatchQueryMemory memory(numRaycasts, numSweeps, numOverlaps);
+		memory.userRaycastResultBuffer = chunk.raycastResults;
+		memory.userRaycastTouchBuffer = chunk.raycastTouches.data();
+		memory.raycastTouchBufferSize = numRaycasts * maxTouches;
+		memory.userSweepResultBuffer = chunk.sweepResults;
+		memory.userSweepTouchBuffer = chunk.sweepTouches.data();
+		memory.sweepTouchBufferSize = numSweeps * maxTouches;
+		memory.userOverlapResultBuffer = chunk.overlapResults;
+		memory.userOverlapTouchBuffer = chunk.overlapTouches.data();
+		memory.overlapTouchBufferSize = numOverlaps * maxTouches;
+
+		PxBatchQuery* batchQuery = chunk.batchQuery;
+		batchQuery->setUserMemory(memory);
+
+		for (UINT32 i = 0; i < numQueries; i++)
+		{
+			const PHYSICS_QUERY_DESC& desc = queries[i];
+			void* userData = (void*)(UINT64)i;
+
+			PxQueryFilterData filterData;
+			memcpy(&filterData.data.word0, &desc.layer, sizeof(desc.layer));
+
+			// Report all hits as touches, as otherwise only the closest (blocking) hit is reported
+			PxU16 queryMaxTouches = 0;
+			if (desc.allHits || desc.type >= PhysicsQueryType::BoxOverlap)
+			{
+				filterData.flags |= PxQueryFlag::eNO_BLOCK;
+				queryMaxTouches = maxTouches;
+			}
+
+			const PxTransform transform = toPxTransform(desc.position, desc.rotation);
+			const PxHitFlags hitFlags = desc.allHits ? 
+				PxHitFlag::eDEFAULT | PxHitFlag::eUV | PxHitFlag::eMESH_MULTIPLE :
+				PxHitFlag::eDEFAULT | PxHitFlag::eUV;
+
+			switch (desc.type)
+			{
+			case PhysicsQueryType::RayCast:
+				batchQuery->raycast(toPxVector(desc.position), toPxVector(desc.unitDir), desc.maxDistance, queryMaxTouches,
+					hitFlags, filterData, userData);
+				break;
+			case PhysicsQueryType::BoxCast:
+				batchQuery->sweep(PxBoxGeometry(toPxVector(desc.halfExtents)), transform, toPxVector(desc.unitDir),
+					desc.maxDistance, queryMaxTouches, hitFlags, filterData, userData);
+				break;
+			case PhysicsQueryType::SphereCast:
+				batchQuery->sweep(PxSphereGeometry(desc.radius), transform, toPxVector(desc.unitDir),
+					desc.maxDistance, queryMaxTouches, hitFlags, filterData, userData);
+				break;
+			case PhysicsQueryType::CapsuleCast:
+				batchQuery->sweep(PxCapsuleGeometry(desc.radius, desc.halfHeight), transform, toPxVector(desc.unitDir),
+					desc.maxDistance, queryMaxTouches, hitFlags, filterData, userData);
+				break;
+			case PhysicsQueryType::BoxOverlap:
+				batchQuery->overlap(PxBoxGeometry(toPxVector(desc.halfExtents)), transform, queryMaxTouches, filterData,
+					userData);
+				break;
+			case PhysicsQueryType::SphereOverlap:
+				batchQuery->overlap(PxSphereGeometry(desc.radius), transform, queryMaxTouches, filterData, userData);
+				break;
+			case PhysicsQueryType::CapsuleOverlap:
+				batchQuery->overlap(PxCapsuleGeometry(desc.radius, desc.halfHeight), transform, queryMaxTouches,
+					filterData, userData);
+				break;
+			}
+		}
+
+		batchQuery->execute();
+
+		// Results are grouped per query type, use the user data to find the query they belong to
+		auto outputResults = [&](auto* results, UINT32 numResults)
+		{
+			for (UINT32 i = 0; i < numResults; i++)
+			{
+				const auto& result = results[i];
+				const UINT32 queryIdx = (UINT32)(UINT64)result.userData;
+
+				PhysicsQueryHit* output = hits + queryIdx * maxHitsPerQuery;
+				UINT32 count = 0;
+
+				if (result.queryStatus != PxBatchQueryStatus::eSUCCESS && 
+					result.queryStatus != PxBatchQueryStatus::eOVERFLOW)
+				{
+					numHits[queryIdx] = 0;
+					continue;
+				}
+
+				if (result.hasBlock && count < maxHitsPerQuery)
+				{
+					output[count] = PhysicsQueryHit();
+					parseHit(result.block, output[count++]);
+				}
+
+				for (PxU32 j = 0; j < result.nbTouches && count < maxHitsPerQuery; j++)
+				{
+					output[count] = PhysicsQueryHit();
+					parseHit(result.touches[j], output[count++]);
+				}
+
+				// PhysX reports touches in no particular order
+				if (queries[queryIdx].allHits)
+				{
+					std::sort(output, output + count, 
+						[](const PhysicsQueryHit& a, const PhysicsQueryHit& b) { return a.distance < b.distance; });
+				}
+
+				numHits[queryIdx] = count;
+			}
+		};
+
+		outputResults(chunk.raycastResults, numRaycasts);
+		outputResults(chunk.sweepResults, numSweeps);
+		outputResults(chunk.overlapResults, numOverlaps);
+	}
+
 	bool PhysX::_rayCast(const Vector3& origin, const Vector3& unitDir, const Collider& collider, PhysicsQueryHit& hit,
 		float maxDist) const
 	{
+		_waitForSimulation();
+
 		FPhysXCollider* physxCollider = static_cast<FPhysXCollider*>(collider._getInternal());
 		PxShape* shape = physxCollider->_getShape();
 
@@ -1074,6 +1505,8 @@ namespace bs
 	bool PhysX::sweep(const PxGeometry& geometry, const PxTransform& tfrm, const Vector3& unitDir,
 		PhysicsQueryHit& hit, UINT64 layer, float maxDist) const
 	{
+		_waitForSimulation();
+
 		PxSweepBuffer output;
 
 		PxQueryFilterData filterData;
@@ -1090,6 +1523,8 @@ namespace bs
 
 	bool PhysX::overlapAny(const PxGeometry& geometry, const PxTransform& tfrm, UINT64 layer) const
 	{
+		_waitForSimulation();
+
 		PxOverlapBuffer output;
 
 		PxQueryFilterData filterData;
@@ -1101,6 +1536,8 @@ namespace bs
 
 	Vector<Collider*> PhysX::overlap(const PxGeometry& geometry, const PxTransform& tfrm, UINT64 layer) const
 	{
+		_waitForSimulation();
+
 		PhysXOverlapQueryCallback output;
 
 		PxQueryFilterData filterData;
@@ -1113,6 +1550,11 @@ namespace bs
 	void PhysX::setFlag(PhysicsFlags flag, bool enabled)
 	{
 		Physics::setFlag(flag, enabled);
+		_waitForSimulation();
+
+		// Stop interpolating and apply the results of the last step directly
+		if (!mFlags.isSet(PhysicsFlag::Async_Simulation))
+			clearInterpolation();
 
 		mCharManager->setOverlapRecoveryModule(mFlags.isSet(PhysicsFlag::CCT_OverlapRecovery));
 		mCharManager->setPreciseSweeps(mFlags.isSet(PhysicsFlag::CCT_PreciseSweeps));
@@ -1121,6 +1563,11 @@ namespace bs
 
 	void PhysX::setPaused(bool paused)
 	{
+		// No fixed updates happen while paused, so the step running in the background must complete now. Interpolation
+		// continues until the results of the step are reached.
+		if (paused)
+			_waitForSimulation();
+
 		mPaused = paused;
 	}
 
@@ -1131,11 +1578,14 @@ namespace bs
 
 	void PhysX::setGravity(const Vector3& gravity)
 	{
+		_waitForSimulation();
 		mScene->setGravity(toPxVector(gravity));
 	}
 
 	void PhysX::setMaxTesselationEdgeLength(float length)
 	{
+		_waitForSimulation();
+
 		mTesselationLength = length;
 
 		mCharManager->setTessellation(mFlags.isSet(PhysicsFlag::CCT_Tesselation), mTesselationLength);
@@ -1143,6 +1593,8 @@ namespace bs
 
 	UINT32 PhysX::addBroadPhaseRegion(const AABox& region)
 	{
+		_waitForSimulation();
+
 		UINT32 id = mNextRegionIdx++;
 
 		PxBroadPhaseRegion pxRegion;
@@ -1157,6 +1609,8 @@ namespace bs
 
 	void PhysX::removeBroadPhaseRegion(UINT32 regionId)
 	{
+		_waitForSimulation();
+
 		auto iterFind = mBroadPhaseRegionHandles.find(regionId);
 		if (iterFind == mBroadPhaseRegionHandles.end())
 			return;
@@ -1167,6 +1621,8 @@ namespace bs
 
 	void PhysX::clearBroadPhaseRegions()
 	{
+		_waitForSimulation();
+
 		for(auto& entry : mBroadPhaseRegionHandles)
 			mScene->removeBroadPhaseRegion(entry.second);
 
@@ -5,6 +5,8 @@
 #include "BsPhysXPrerequisites.h"
 #include "Physics/BsPhysics.h"
 #include "Physics/BsPhysicsCommon.h"
+#include "BsPhysXInterpolator.h"
+#include "Scene/BsSceneObject.h"
 #include "PxPhysics.h"
 #include "foundation/Px.h"
 #include "characterkinematic/PxControllerManager.h"
@@ -16,6 +18,8 @@ namespace bs
 	 *  @{
 	 */
 
+	struct PhysXQueryBatchChunk;
+
 	/** NVIDIA PhysX implementation of Physics. */
 	class PhysX : public Physics
 	{
@@ -41,8 +45,10 @@ namespace bs
 			Collider* colliderA; /** First collider. */
 			Collider* colliderB; /** Second collider. */
 			ContactEventType type; /** Exact type of the event. */
-			// Note: Not too happy this is heap allocated, use static allocator?
-			Vector<ContactPoint> points; /** Information about all contact points between the colliders. */
+			UINT32 firstPoint; /** Index of the first contact point of the event, in the shared contact point pool. */
+			UINT32 numPoints; /** Number of contact points between the colliders. */
+			bool notifyA; /** True if the first collider should receive the event. */
+			bool notifyB; /** True if the second collider should receive the event. */
 		};
 
 		/** Event reported when a joint breaks. */
@@ -51,6 +57,14 @@ namespace bs
 			Joint* joint; /** Broken joint. */
 		};
 
+		/** Transform of a rigidbody that moved during the simulation step. */
+		struct SimulationResult
+		{
+			Rigidbody* rigidbody; /** Rigidbody that moved. */
+			Vector3 position; /** World position of the rigidbody at the end of the step. */
+			Quaternion rotation; /** World rotation of the rigidbody at the end of the step. */
+		};
+
 	public:
 		PhysX(const PHYSICS_INIT_DESC& input);
 		~PhysX();
@@ -183,6 +197,10 @@ namespace bs
 		bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const override;
 
+		/** @copydoc Physics::queryBatch */
+		void queryBatch(const PHYSICS_QUERY_DESC* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+			UINT32 maxHitsPerQuery, UINT32* numHits) const override;
+
 		/** @copydoc Physics::setFlag */
 		void setFlag(PhysicsFlags flags, bool enabled) override;
 
@@ -229,15 +247,46 @@ namespace bs
 		bool _rayCast(const Vector3& origin, const Vector3& unitDir, const Collider& collider, PhysicsQueryHit& hit, 
 			float maxDist = FLT_MAX) const override;
 
-		/** Triggered by the PhysX simulation when an interaction between two colliders is found. */
+		/** 
+		 * Triggered by the PhysX simulation when an interaction between two colliders is found. Contact points of the event
+		 * must be reported through _reportContactPoint() beforehand.
+		 */
 		void _reportContactEvent(const ContactEvent& event);
 
+		/** Records a contact point for a contact event about to be reported. Returns the index of the point in the pool. */
+		UINT32 _reportContactPoint(const ContactPoint& point);
+
 		/** Triggered by the PhysX simulation when an interaction between two trigger and a collider is found. */
 		void _reportTriggerEvent(const TriggerEvent& event);
 
 		/** Triggered by the PhysX simulation when a joint breaks. */
 		void _reportJointBreakEvent(const JointBreakEvent& event);
 
+		/** 
+		 * Notifies the system that the rigidbody was destroyed or had its transform explicitly set, and any interpolation
+		 * of its transform should be stopped.
+		 */
+		void _notifyRigidbodyTeleported(Rigidbody* rigidbody);
+
+		/** Notifies the system that the collider was destroyed, and any events it has pending should be discarded. */
+		void _notifyColliderDestroyed(Collider* collider);
+
+		/** Notifies the system that the joint was destroyed, and any events it has pending should be discarded. */
+		void _notifyJointDestroyed(Joint* joint);
+
+		/**
+		 * Waits until the simulation step running in the background completes, if any. PhysX doesn't allow the scene to be
+		 * accessed while it is being simulated, so this must be called before any query or modification of the scene, or
+		 * of the objects within it. Only relevant when PhysicsFlag::Async_Simulation is enabled, as otherwise the step
+		 * always completes within fixedUpdate(). 
+		 *
+		 * Results of the step are only retrieved and buffered. They are applied to the rigidbodies, and collision events
+		 * are triggered, at the start of the next fixedUpdate(), so no user code is called from within this method.
+		 *
+		 * @note	Must be called from the thread that runs the simulation.
+		 */
+		void _waitForSimulation() const;
+
 		/** Returns the default PhysX material. */
 		physx::PxMaterial* getDefaultMaterial() const { return mDefaultMaterial; }
 
@@ -259,6 +308,28 @@ namespace bs
 		/** Sends out all events recorded during simulation to the necessary physics objects. */
 		void triggerEvents();
 
+		/** 
+		 * Waits until the simulation step started by fixedUpdate() completes, and buffers its results. Collision events
+		 * reported by the step are buffered as well. Results are applied by applyResults().
+		 */
+		void fetchResults();
+
+		/** 
+		 * Applies the results buffered by fetchResults() to rigidbodies, and triggers the buffered collision events. If
+		 * @p interpolate is true the results are recorded for interpolation in update() instead of being applied directly.
+		 */
+		void applyResults(bool interpolate);
+
+		/** Applies the final result of all interpolated transforms and stops interpolating them. */
+		void clearInterpolation();
+
+		/**
+		 * Executes a range of queries from a query batch using a single PhysX batch query. See queryBatch() for the
+		 * description of the parameters.
+		 */
+		void executeQueryBatchChunk(PhysXQueryBatchChunk& chunk, const PHYSICS_QUERY_DESC* queries, UINT32 numQueries,
+			PhysicsQueryHit* hits, UINT32 maxHitsPerQuery, UINT32* numHits) const;
+
 		/**
 		 * Helper method that performs a sweep query by checking if the provided geometry hits any physics objects
 		 * when moved along the specified direction. Returns information about the first hit.
@@ -292,16 +363,30 @@ namespace bs
 		UINT32 mNextRegionIdx = 1;
 		bool mPaused = false;
 
+		UINT8* mScratchBuffer = nullptr;
+		bool mSimulationInProgress = false;
+		ThreadId mSimulationThread;
+		UINT64 mSimulationStep = 0;
+		bool mResultsPending = false;
+		Vector<SimulationResult> mResults;
+		PhysXInterpolator mInterpolator;
+		Vector<SceneObjectPose> mPoses;
+
 		Vector<TriggerEvent> mTriggerEvents;
 		Vector<ContactEvent> mContactEvents;
+		Vector<ContactPoint> mContactPoints;
 		Vector<JointBreakEvent> mJointBreakEvents;
 		UnorderedMap<UINT32, UINT32> mBroadPhaseRegionHandles;
 
+		mutable Mutex mQueryBatchMutex;
+		mutable Vector<PhysXQueryBatchChunk*> mQueryBatchChunks;
+
 		physx::PxFoundation* mFoundation = nullptr;
 		physx::PxPhysics* mPhysics = nullptr;
 		physx::PxCooking* mCooking = nullptr;
 		physx::PxScene* mScene = nullptr;
 		physx::PxControllerManager* mCharManager = nullptr;
+		PhysXCPUDispatcher* mCPUDispatcher = nullptr;
 
 		physx::PxMaterial* mDefaultMaterial = nullptr;
 		physx::PxTolerancesScale mScale;
@@ -30,12 +30,14 @@ namespace bs
 
 	void PhysXBoxCollider::setScale(const Vector3& scale)
 	{
+		gPhysX()._waitForSimulation();
 		BoxCollider::setScale(scale);
 		applyGeometry();
 	}
 
 	void PhysXBoxCollider::setExtents(const Vector3& extents)
 	{
+		gPhysX()._waitForSimulation();
 		mExtents = extents;
 		applyGeometry();
 	}
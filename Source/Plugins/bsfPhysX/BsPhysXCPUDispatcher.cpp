@@ -0,0 +1,168 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysXCPUDispatcher.h"
+#include "Threading/BsTaskScheduler.h"
+#include "task/PxTask.h"
+
+using namespace physx;
+
+namespace bs
+{
+	/** Dispatcher and index of the worker running on the current thread, if any. */
+	static BS_THREADLOCAL PhysXCPUDispatcher* sWorkerDispatcher = nullptr;
+	static BS_THREADLOCAL UINT32 sWorkerIdx = 0;
+
+	void PhysXCPUDispatcher::TaskQueue::push(PxBaseTask* task)
+	{
+		ScopedSpinLock scopedLock(lock);
+
+		const UINT32 capacity = (UINT32)tasks.size();
+		if (count == capacity)
+		{
+			// Unwrap the ring buffer into a larger one
+			Vector<PxBaseTask*> newTasks(capacity * 2);
+			for (UINT32 i = 0; i < count; i++)
+				newTasks[i] = tasks[(head + i) % capacity];
+
+			tasks.swap(newTasks);
+			head = 0;
+		}
+
+		tasks[(head + count) % tasks.size()] = task;
+		count++;
+	}
+
+	PxBaseTask* PhysXCPUDispatcher::TaskQueue::popBack()
+	{
+		ScopedSpinLock scopedLock(lock);
+
+		if (count == 0)
+			return nullptr;
+
+		count--;
+		return tasks[(head + count) % tasks.size()];
+	}
+
+	PxBaseTask* PhysXCPUDispatcher::TaskQueue::popFront()
+	{
+		ScopedSpinLock scopedLock(lock);
+
+		if (count == 0)
+			return nullptr;
+
+		PxBaseTask* task = tasks[head];
+		head = (head + 1) % tasks.size();
+		count--;
+
+		return task;
+	}
+
+	PhysXCPUDispatcher::PhysXCPUDispatcher(UINT32 numWorkers, UINT32 numSpinsBeforeSleep)
+		:mNumSpinsBeforeSleep(numSpinsBeforeSleep)
+	{
+		numWorkers = std::max(1U, numWorkers);
+
+		mWorkers.reserve(numWorkers);
+		for (UINT32 i = 0; i < numWorkers; i++)
+			mWorkers.push_back(bs_unique_ptr_new<Worker>());
+
+		// Start the threads only once all the queues exist, as workers can steal from any of them
+		for (UINT32 i = 0; i < numWorkers; i++)
+			mWorkers[i]->thread = Thread(std::bind(&PhysXCPUDispatcher::runWorker, this, i));
+	}
+
+	PhysXCPUDispatcher::~PhysXCPUDispatcher()
+	{
+		{
+			Lock lock(mSleepMutex);
+			mShutdown = true;
+		}
+
+		mSleepSignal.notify_all();
+
+		for (auto& worker : mWorkers)
+			worker->thread.join();
+	}
+
+	void PhysXCPUDispatcher::submitTask(PxBaseTask& task)
+	{
+		// Tasks submitted from a worker are usually continuations of its current task, so keep them local to the worker.
+		// Others are distributed evenly.
+		UINT32 workerIdx;
+		if (sWorkerDispatcher == this)
+			workerIdx = sWorkerIdx;
+		else
+			workerIdx = mNextWorker.fetch_add(1, std::memory_order_relaxed) % (UINT32)mWorkers.size();
+
+		mWorkers[workerIdx]->queue.push(&task);
+		mNumQueued.fetch_add(1);
+
+		if (mNumSleeping.load() > 0)
+		{
+			Lock lock(mSleepMutex);
+			mSleepSignal.notify_one();
+		}
+	}
+
+	PxBaseTask* PhysXCPUDispatcher::findTask(UINT32 workerIdx)
+	{
+		PxBaseTask* task = mWorkers[workerIdx]->queue.popBack();
+		if (task == nullptr)
+		{
+			const UINT32 numWorkers = (UINT32)mWorkers.size();
+			for (UINT32 i = 1; i < numWorkers && task == nullptr; i++)
+				task = mWorkers[(workerIdx + i) % numWorkers]->queue.popFront();
+		}
+
+		if (task != nullptr)
+			mNumQueued.fetch_sub(1);
+
+		return task;
+	}
+
+	void PhysXCPUDispatcher::runWorker(UINT32 workerIdx)
+	{
+		sWorkerDispatcher = this;
+		sWorkerIdx = workerIdx;
+
+		UINT32 numSpins = 0;
+		while (true)
+		{
+			PxBaseTask* task = findTask(workerIdx);
+			if (task != nullptr)
+			{
+				task->run();
+				task->release();
+
+				numSpins = 0;
+				continue;
+			}
+
+			// PhysX usually submits tasks in quick succession, so check again a few times before going to sleep. Don't spin
+			// while the TaskScheduler is running tasks though, as spinning would take cores away from its workers.
+			if (numSpins < mNumSpinsBeforeSleep && TaskScheduler::instance().getNumActiveTasks() == 0)
+			{
+				numSpins++;
+				std::this_thread::yield();
+				continue;
+			}
+
+			{
+				Lock lock(mSleepMutex);
+
+				mNumSleeping.fetch_add(1);
+				while (mNumQueued.load() <= 0 && !mShutdown)
+					mSleepSignal.wait(lock);
+
+				mNumSleeping.fetch_sub(1);
+
+				if (mShutdown && mNumQueued.load() <= 0)
+					break;
+			}
+
+			numSpins = 0;
+		}
+
+		sWorkerDispatcher = nullptr;
+	}
+}
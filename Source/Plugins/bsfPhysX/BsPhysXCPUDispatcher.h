@@ -0,0 +1,94 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPhysXPrerequisites.h"
+#include "Threading/BsSpinLock.h"
+#include "task/PxCpuDispatcher.h"
+
+namespace bs
+{
+	/** @addtogroup PhysX
+	 *  @{
+	 */
+
+	/**
+	 * Executes tasks submitted by PhysX on a set of dedicated worker threads. PhysX submits a large number of very small
+	 * tasks during simulation, so unlike the general purpose TaskScheduler this dispatcher doesn't allocate anything per
+	 * task. Task pointers are pushed directly into a queue local to each worker, and idle workers steal tasks from the
+	 * queues of other workers.
+	 *
+	 * The TaskScheduler queues, sorts and allocates per task and runs each task on a thread pool thread, which is too
+	 * heavy for PhysX tasks, so this dispatcher runs its own threads instead of sharing the TaskScheduler workers. To
+	 * limit oversubscription, fewer threads are created than there are TaskScheduler workers, and idle threads go to
+	 * sleep without spinning while the TaskScheduler has tasks running.
+	 */
+	class PhysXCPUDispatcher : public physx::PxCpuDispatcher
+	{
+	public:
+		/**
+		 * Creates the dispatcher and starts its worker threads.
+		 *
+		 * @param[in]	numWorkers			Number of worker threads to create. Must be at least one.
+		 * @param[in]	numSpinsBeforeSleep	Number of times an idle worker checks for new tasks before going to sleep. Ignored
+		 *									while the TaskScheduler has tasks running.
+		 */
+		PhysXCPUDispatcher(UINT32 numWorkers, UINT32 numSpinsBeforeSleep);
+
+		/** Stops all worker threads. All submitted tasks must have completed before this is called. */
+		~PhysXCPUDispatcher();
+
+		/** @copydoc physx::PxCpuDispatcher::submitTask */
+		void submitTask(physx::PxBaseTask& task) override;
+
+		/** @copydoc physx::PxCpuDispatcher::getWorkerCount */
+		physx::PxU32 getWorkerCount() const override { return (physx::PxU32)mWorkers.size(); }
+
+	private:
+		/** Queue of tasks waiting to be executed by a single worker. Grows as needed, but never shrinks. */
+		struct TaskQueue
+		{
+			/** Adds a task to the back of the queue. */
+			void push(physx::PxBaseTask* task);
+
+			/** Removes a task from the back of the queue (most recently added). Returns null if the queue is empty. */
+			physx::PxBaseTask* popBack();
+
+			/** Removes a task from the front of the queue (least recently added). Returns null if the queue is empty. */
+			physx::PxBaseTask* popFront();
+
+			Vector<physx::PxBaseTask*> tasks = Vector<physx::PxBaseTask*>(64);
+			UINT32 head = 0;
+			UINT32 count = 0;
+			SpinLock lock;
+		};
+
+		/** Information about a single worker thread. */
+		struct Worker
+		{
+			TaskQueue queue;
+			Thread thread;
+		};
+
+		/** Main loop of a worker thread. */
+		void runWorker(UINT32 workerIdx);
+
+		/** 
+		 * Finds a task to execute for the specified worker, first checking the worker's own queue and then the queues of
+		 * other workers. Returns null if no tasks are queued.
+		 */
+		physx::PxBaseTask* findTask(UINT32 workerIdx);
+
+		Vector<UPtr<Worker>> mWorkers;
+		UINT32 mNumSpinsBeforeSleep;
+		std::atomic<UINT32> mNextWorker { 0 };
+		std::atomic<INT32> mNumQueued { 0 };
+		std::atomic<UINT32> mNumSleeping { 0 };
+		bool mShutdown = false;
+
+		Mutex mSleepMutex;
+		Signal mSleepSignal;
+	};
+
+	/** @} */
+}
@@ -30,12 +30,14 @@ namespace bs
 
 	void PhysXCapsuleCollider::setScale(const Vector3& scale)
 	{
+		gPhysX()._waitForSimulation();
 		CapsuleCollider::setScale(scale);
 		applyGeometry();
 	}
 
 	void PhysXCapsuleCollider::setHalfHeight(float halfHeight)
 	{
+		gPhysX()._waitForSimulation();
 		mHalfHeight = halfHeight;
 		applyGeometry();
 	}
@@ -47,6 +49,7 @@ namespace bs
 
 	void PhysXCapsuleCollider::setRadius(float radius)
 	{
+		gPhysX()._waitForSimulation();
 		mRadius = radius;
 		applyGeometry();
 	}
@@ -78,12 +78,15 @@ namespace bs
 
 	PhysXCharacterController::~PhysXCharacterController()
 	{
+		gPhysX()._waitForSimulation();
 		mController->setUserData(nullptr);
 		mController->release();
 	}
 
 	CharacterCollisionFlags PhysXCharacterController::move(const Vector3& displacement)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxControllerFilters filters;
 		filters.mFilterCallback = this;
 		filters.mFilterFlags = PxQueryFlag::eANY_HIT | PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER;
@@ -115,6 +118,7 @@ namespace bs
 
 	void PhysXCharacterController::setPosition(const Vector3& position)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setPosition(toPxExtVector(position));
 	}
 
@@ -125,6 +129,7 @@ namespace bs
 
 	void PhysXCharacterController::setFootPosition(const Vector3& position)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setFootPosition(toPxExtVector(position));
 	}
 
@@ -135,6 +140,7 @@ namespace bs
 
 	void PhysXCharacterController::setRadius(float radius)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setRadius(radius);
 	}
 
@@ -145,6 +151,7 @@ namespace bs
 
 	void PhysXCharacterController::setHeight(float height)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setHeight(height);
 	}
 
@@ -155,6 +162,7 @@ namespace bs
 
 	void PhysXCharacterController::setUp(const Vector3& up)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setUpDirection(toPxVector(up));
 	}
 
@@ -165,6 +173,7 @@ namespace bs
 
 	void PhysXCharacterController::setClimbingMode(CharacterClimbingMode mode)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setClimbingMode(toPxEnum(mode));
 	}
 
@@ -175,6 +184,7 @@ namespace bs
 
 	void PhysXCharacterController::setNonWalkableMode(CharacterNonWalkableMode mode)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setNonWalkableMode(toPxEnum(mode));
 	}
 
@@ -185,6 +195,7 @@ namespace bs
 
 	void PhysXCharacterController::setMinMoveDistance(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mMinMoveDistance = value;
 	}
 
@@ -195,6 +206,7 @@ namespace bs
 
 	void PhysXCharacterController::setContactOffset(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setContactOffset(value);
 	}
 
@@ -205,6 +217,7 @@ namespace bs
 
 	void PhysXCharacterController::setStepOffset(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setStepOffset(value);
 	}
 
@@ -215,6 +228,7 @@ namespace bs
 
 	void PhysXCharacterController::setSlopeLimit(Radian value)
 	{
+		gPhysX()._waitForSimulation();
 		mController->setSlopeLimit(value.valueRadians());
 	}
 
@@ -145,6 +145,7 @@ namespace bs
 
 	void PhysXD6Joint::setMotion(D6JointAxis axis, D6JointMotion motion)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setMotion(toPxAxis(axis), toPxMotion(motion));
 	}
 
@@ -179,6 +180,8 @@ namespace bs
 
 	void PhysXD6Joint::setLimitLinear(const LimitLinear& limit)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxJointLinearLimit pxLimit(gPhysX().getScale(), limit.extent, limit.contactDist);
 		pxLimit.stiffness = limit.spring.stiffness;
 		pxLimit.damping = limit.spring.damping;
@@ -204,6 +207,8 @@ namespace bs
 
 	void PhysXD6Joint::setLimitTwist(const LimitAngularRange& limit)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxJointAngularLimitPair pxLimit(limit.lower.valueRadians(), limit.upper.valueRadians(), limit.contactDist);
 		pxLimit.stiffness = limit.spring.stiffness;
 		pxLimit.damping = limit.spring.damping;
@@ -229,6 +234,8 @@ namespace bs
 
 	void PhysXD6Joint::setLimitSwing(const LimitConeRange& limit)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxJointLimitCone pxLimit(limit.yLimitAngle.valueRadians(), limit.zLimitAngle.valueRadians(), limit.contactDist);
 		pxLimit.stiffness = limit.spring.stiffness;
 		pxLimit.damping = limit.spring.damping;
@@ -252,6 +259,8 @@ namespace bs
 
 	void PhysXD6Joint::setDrive(D6JointDriveType type, const D6JointDrive& drive)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxD6JointDrive pxDrive;
 
 		if(drive.acceleration)
@@ -276,6 +285,7 @@ namespace bs
 
 	void PhysXD6Joint::setDriveTransform(const Vector3& position, const Quaternion& rotation)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setDrivePosition(toPxTransform(position, rotation));
 	}
 
@@ -299,6 +309,7 @@ namespace bs
 
 	void PhysXD6Joint::setDriveVelocity(const Vector3& linear, const Vector3& angular)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setDriveVelocity(toPxVector(linear), toPxVector(angular));
 	}
 
@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsPhysXDistanceJoint.h"
+#include "BsPhysX.h"
 #include "BsFPhysXJoint.h"
 #include "BsPhysXRigidbody.h"
 #include "PxRigidDynamic.h"
@@ -79,6 +80,7 @@ namespace bs
 
 	void PhysXDistanceJoint::setMinDistance(float value)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setMinDistance(value);
 	}
 
@@ -89,6 +91,7 @@ namespace bs
 
 	void PhysXDistanceJoint::setMaxDistance(float value)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setMaxDistance(value);
 	}
 
@@ -99,6 +102,7 @@ namespace bs
 
 	void PhysXDistanceJoint::setTolerance(float value)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setTolerance(value);
 	}
 
@@ -112,12 +116,14 @@ namespace bs
 
 	void PhysXDistanceJoint::setSpring(const Spring& value)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setDamping(value.damping);
 		getInternal()->setStiffness(value.stiffness);
 	}
 
 	void PhysXDistanceJoint::setFlag(DistanceJointFlag flag, bool enabled)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setDistanceJointFlag(toPxFlag(flag), enabled);
 	}
 
@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsPhysXHingeJoint.h"
+#include "BsPhysX.h"
 #include "BsFPhysXJoint.h"
 #include "BsPhysXRigidbody.h"
 #include "PxRigidDynamic.h"
@@ -88,6 +89,8 @@ namespace bs
 
 	void PhysXHingeJoint::setLimit(const LimitAngularRange& limit)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxJointAngularLimitPair pxLimit(limit.lower.valueRadians(), limit.upper.valueRadians(), limit.contactDist);
 		pxLimit.stiffness = limit.spring.stiffness;
 		pxLimit.damping = limit.spring.damping;
@@ -109,6 +112,8 @@ namespace bs
 
 	void PhysXHingeJoint::setDrive(const HingeJointDrive& drive)
 	{
+		gPhysX()._waitForSimulation();
+
 		getInternal()->setDriveVelocity(drive.speed);
 		getInternal()->setDriveForceLimit(drive.forceLimit);
 		getInternal()->setDriveGearRatio(drive.gearRatio);
@@ -117,6 +122,7 @@ namespace bs
 
 	void PhysXHingeJoint::setFlag(HingeJointFlag flag, bool enabled)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setRevoluteJointFlag(toPxFlag(flag), enabled);
 	}
 
@@ -0,0 +1,115 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysXInterpolator.h"
+
+namespace bs
+{
+	void PhysXInterpolator::beginStep(UINT64 resultTime, UINT64 stepLength)
+	{
+		mResultTime = resultTime;
+		mStepLength = stepLength;
+
+		for (auto& entry : mEntries)
+		{
+			entry.prevPosition = entry.position;
+			entry.prevRotation = entry.rotation;
+			entry.updated = false;
+		}
+	}
+
+	bool PhysXInterpolator::setResult(Rigidbody* rigidbody, const Vector3& position, const Quaternion& rotation)
+	{
+		auto iterFind = mLookup.find(rigidbody);
+		if (iterFind == mLookup.end())
+			return false;
+
+		InterpolatedTransform& entry = mEntries[iterFind->second];
+		entry.position = position;
+		entry.rotation = rotation;
+		entry.updated = true;
+
+		return true;
+	}
+
+	void PhysXInterpolator::add(Rigidbody* rigidbody, SceneObject* sceneObject, const Vector3& startPosition,
+		const Quaternion& startRotation, const Vector3& position, const Quaternion& rotation)
+	{
+		InterpolatedTransform entry;
+		entry.rigidbody = rigidbody;
+		entry.sceneObject = sceneObject;
+		entry.prevPosition = startPosition;
+		entry.prevRotation = startRotation;
+		entry.position = position;
+		entry.rotation = rotation;
+		entry.updated = true;
+
+		mLookup[rigidbody] = (UINT32)mEntries.size();
+		mEntries.push_back(entry);
+	}
+
+	void PhysXInterpolator::endStep(Vector<SceneObjectPose>& poses)
+	{
+		for (UINT32 i = 0; i < (UINT32)mEntries.size();)
+		{
+			const InterpolatedTransform& entry = mEntries[i];
+			if (entry.updated)
+			{
+				i++;
+				continue;
+			}
+
+			poses.push_back({ entry.sceneObject, entry.position, entry.rotation });
+			remove(entry.rigidbody);
+		}
+	}
+
+	void PhysXInterpolator::evaluate(UINT64 time, Vector<SceneObjectPose>& poses) const
+	{
+		float t = 1.0f;
+		if (mStepLength > 0)
+		{
+			if (time > mResultTime)
+				t = std::min(1.0f, (float)((time - mResultTime) / (double)mStepLength));
+			else
+				t = 0.0f;
+		}
+
+		poses.resize(mEntries.size());
+		for (UINT32 i = 0; i < (UINT32)mEntries.size(); i++)
+		{
+			const InterpolatedTransform& entry = mEntries[i];
+
+			poses[i].sceneObject = entry.sceneObject;
+			poses[i].position = Vector3::lerp(t, entry.prevPosition, entry.position);
+			poses[i].rotation = Quaternion::slerp(t, entry.prevRotation, entry.rotation);
+		}
+	}
+
+	void PhysXInterpolator::remove(Rigidbody* rigidbody)
+	{
+		auto iterFind = mLookup.find(rigidbody);
+		if (iterFind == mLookup.end())
+			return;
+
+		// Swap with the last entry to keep the array packed
+		const UINT32 idx = iterFind->second;
+		const UINT32 lastIdx = (UINT32)mEntries.size() - 1;
+		if (idx != lastIdx)
+		{
+			mEntries[idx] = mEntries[lastIdx];
+			mLookup[mEntries[idx].rigidbody] = idx;
+		}
+
+		mEntries.pop_back();
+		mLookup.erase(rigidbody);
+	}
+
+	void PhysXInterpolator::clear(Vector<SceneObjectPose>& poses)
+	{
+		for (auto& entry : mEntries)
+			poses.push_back({ entry.sceneObject, entry.position, entry.rotation });
+
+		mEntries.clear();
+		mLookup.clear();
+	}
+}
@@ -0,0 +1,92 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPhysXPrerequisites.h"
+#include "Scene/BsSceneObject.h"
+#include "Math/BsVector3.h"
+#include "Math/BsQuaternion.h"
+
+namespace bs
+{
+	/** @addtogroup PhysX
+	 *  @{
+	 */
+
+	/**
+	 * Keeps track of the rigidbody transforms resulting from the two most recent simulation steps, and interpolates
+	 * between them. Used when the simulation runs in the background, in which case the displayed state lags one step
+	 * behind the simulation. Only rigidbodies that are moving are tracked.
+	 */
+	class PhysXInterpolator
+	{
+		/** Transforms of a rigidbody resulting from the two most recent simulation steps. */
+		struct InterpolatedTransform
+		{
+			Rigidbody* rigidbody;
+			SceneObject* sceneObject;
+			Vector3 prevPosition;
+			Quaternion prevRotation;
+			Vector3 position;
+			Quaternion rotation;
+			bool updated;
+		};
+
+	public:
+		/**
+		 * Starts recording the results of a new simulation step. Results of the previous step become the starting point
+		 * of the interpolation.
+		 *
+		 * @param[in]	resultTime	Time at which the results of the step are reached, in microseconds. Interpolation
+		 *							towards the results starts at this time.
+		 * @param[in]	stepLength	Length of the simulation step, in microseconds.
+		 */
+		void beginStep(UINT64 resultTime, UINT64 stepLength);
+
+		/**
+		 * Records the transform a rigidbody reached during the step being recorded. Returns false if the rigidbody isn't
+		 * being interpolated, in which case it must be registered through add() instead.
+		 */
+		bool setResult(Rigidbody* rigidbody, const Vector3& position, const Quaternion& rotation);
+
+		/**
+		 * Starts interpolating a rigidbody that started moving during the step being recorded.
+		 *
+		 * @param[in]	rigidbody		Rigidbody to interpolate.
+		 * @param[in]	sceneObject		Scene object the interpolated transform is applied to.
+		 * @param[in]	startPosition	Position of the rigidbody before the step.
+		 * @param[in]	startRotation	Rotation of the rigidbody before the step.
+		 * @param[in]	position		Position the rigidbody reached during the step.
+		 * @param[in]	rotation		Rotation the rigidbody reached during the step.
+		 */
+		void add(Rigidbody* rigidbody, SceneObject* sceneObject, const Vector3& startPosition,
+			const Quaternion& startRotation, const Vector3& position, const Quaternion& rotation);
+
+		/**
+		 * Finishes recording the step. Rigidbodies that didn't move during the step have reached their final transform,
+		 * so they stop being interpolated and their final transforms are appended to @p poses.
+		 */
+		void endStep(Vector<SceneObjectPose>& poses);
+
+		/** Outputs the interpolated transforms of all rigidbodies at the specified time, in microseconds. */
+		void evaluate(UINT64 time, Vector<SceneObjectPose>& poses) const;
+
+		/** Stops interpolating the specified rigidbody, if it is being interpolated. */
+		void remove(Rigidbody* rigidbody);
+
+		/** Stops interpolating all rigidbodies and appends the final transforms they were interpolating to, to @p poses. */
+		void clear(Vector<SceneObjectPose>& poses);
+
+		/** Returns true if no rigidbodies are being interpolated. */
+		bool isEmpty() const { return mEntries.empty(); }
+
+	private:
+		UINT64 mResultTime = 0;
+		UINT64 mStepLength = 0;
+
+		Vector<InterpolatedTransform> mEntries;
+		UnorderedMap<Rigidbody*, UINT32> mLookup;
+	};
+
+	/** @} */
+}
@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsPhysXMaterial.h"
+#include "BsPhysX.h"
 #include "PxPhysics.h"
 
 namespace bs
@@ -18,6 +19,7 @@ namespace bs
 
 	void PhysXMaterial::setStaticFriction(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setStaticFriction(value);
 	}
 
@@ -28,6 +30,7 @@ namespace bs
 
 	void PhysXMaterial::setDynamicFriction(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setDynamicFriction(value);
 	}
 
@@ -38,6 +41,7 @@ namespace bs
 
 	void PhysXMaterial::setRestitutionCoefficient(float value)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setRestitution(value);
 	}
 
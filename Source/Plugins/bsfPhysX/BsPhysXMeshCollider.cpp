@@ -28,6 +28,7 @@ namespace bs
 
 	void PhysXMeshCollider::setScale(const Vector3& scale)
 	{
+		gPhysX()._waitForSimulation();
 		MeshCollider::setScale(scale);
 		applyGeometry();
 	}
@@ -67,6 +68,8 @@ namespace bs
 
 	void PhysXMeshCollider::setGeometry(const PxGeometry& geometry)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxShape* shape = getInternal()->_getShape();
 		if (shape->getGeometryType() != geometry.getType())
 		{
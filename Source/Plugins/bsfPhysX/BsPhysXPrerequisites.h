@@ -31,6 +31,7 @@ namespace bs
 	class PhysXRigidbody;
 	class PhsyXMaterial;
 	class FPhysXCollider;
+	class PhysXCPUDispatcher;
 
 	/** @addtogroup PhysX
 	 *  @{
@@ -59,12 +59,17 @@ namespace bs
 
 	PhysXRigidbody::~PhysXRigidbody()
 	{
+		gPhysX()._waitForSimulation();
+		gPhysX()._notifyRigidbodyTeleported(this);
+
 		mInternal->userData = nullptr;
 		mInternal->release();
 	}
 
 	void PhysXRigidbody::move(const Vector3& position)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (getIsKinematic())
 		{
 			PxTransform target;
@@ -83,6 +88,8 @@ namespace bs
 
 	void PhysXRigidbody::rotate(const Quaternion& rotation)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (getIsKinematic())
 		{
 			PxTransform target;
@@ -111,11 +118,15 @@ namespace bs
 
 	void PhysXRigidbody::setTransform(const Vector3& pos, const Quaternion& rot)
 	{
+		gPhysX()._waitForSimulation();
+		gPhysX()._notifyRigidbodyTeleported(this);
 		mInternal->setGlobalPose(toPxTransform(pos, rot));
 	}
 
 	void PhysXRigidbody::setMass(float mass)
 	{
+		gPhysX()._waitForSimulation();
+
 		if(((UINT32)mFlags & (UINT32)RigidbodyFlag::AutoMass) != 0)
 		{
 			LOGWRN("Attempting to set Rigidbody mass, but it has automatic mass calculation turned on.");
@@ -132,6 +143,7 @@ namespace bs
 
 	void PhysXRigidbody::setIsKinematic(bool kinematic)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, kinematic);
 	}
 
@@ -147,16 +159,19 @@ namespace bs
 
 	void PhysXRigidbody::sleep()
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->putToSleep();
 	}
 
 	void PhysXRigidbody::wakeUp()
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->wakeUp();
 	}
 
 	void PhysXRigidbody::setSleepThreshold(float threshold)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setSleepThreshold(threshold);
 	}
 
@@ -167,6 +182,7 @@ namespace bs
 
 	void PhysXRigidbody::setUseGravity(bool gravity)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setActorFlag(PxActorFlag::eDISABLE_GRAVITY, !gravity);
 	}
 
@@ -177,6 +193,7 @@ namespace bs
 
 	void PhysXRigidbody::setVelocity(const Vector3& velocity)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setLinearVelocity(toPxVector(velocity));
 	}
 
@@ -187,6 +204,7 @@ namespace bs
 
 	void PhysXRigidbody::setAngularVelocity(const Vector3& velocity)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setAngularVelocity(toPxVector(velocity));
 	}
 
@@ -197,6 +215,7 @@ namespace bs
 
 	void PhysXRigidbody::setDrag(float drag)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setLinearDamping(drag);
 	}
 
@@ -207,6 +226,7 @@ namespace bs
 
 	void PhysXRigidbody::setAngularDrag(float drag)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setAngularDamping(drag);
 	}
 
@@ -217,6 +237,8 @@ namespace bs
 
 	void PhysXRigidbody::setInertiaTensor(const Vector3& tensor)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (((UINT32)mFlags & (UINT32)RigidbodyFlag::AutoTensors) != 0)
 		{
 			LOGWRN("Attempting to set Rigidbody inertia tensor, but it has automatic tensor calculation turned on.");
@@ -233,6 +255,7 @@ namespace bs
 
 	void PhysXRigidbody::setMaxAngularVelocity(float maxVelocity)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setMaxAngularVelocity(maxVelocity);
 	}
 
@@ -243,6 +266,8 @@ namespace bs
 
 	void PhysXRigidbody::setCenterOfMass(const Vector3& position, const Quaternion& rotation)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (((UINT32)mFlags & (UINT32)RigidbodyFlag::AutoTensors) != 0)
 		{
 			LOGWRN("Attempting to set Rigidbody center of mass, but it has automatic tensor calculation turned on.");
@@ -266,6 +291,7 @@ namespace bs
 
 	void PhysXRigidbody::setPositionSolverCount(UINT32 count)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setSolverIterationCounts(std::max(1U, count), getVelocitySolverCount());
 	}
 
@@ -280,6 +306,7 @@ namespace bs
 
 	void PhysXRigidbody::setVelocitySolverCount(UINT32 count)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->setSolverIterationCounts(getPositionSolverCount(), std::max(1U, count));
 	}
 
@@ -294,6 +321,8 @@ namespace bs
 
 	void PhysXRigidbody::setFlags(RigidbodyFlag flags)
 	{
+		gPhysX()._waitForSimulation();
+
 		bool ccdEnabledOld = mInternal->getRigidBodyFlags() & PxRigidBodyFlag::eENABLE_CCD;
 		bool ccdEnabledNew = ((UINT32)flags & (UINT32)RigidbodyFlag::CCD) != 0;
 		
@@ -325,16 +354,20 @@ namespace bs
 
 	void PhysXRigidbody::addForce(const Vector3& force, ForceMode mode)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->addForce(toPxVector(force), toPxForceMode(mode));
 	}
 
 	void PhysXRigidbody::addTorque(const Vector3& force, ForceMode mode)
 	{
+		gPhysX()._waitForSimulation();
 		mInternal->addTorque(toPxVector(force), toPxForceMode(mode));
 	}
 
 	void PhysXRigidbody::addForceAtPoint(const Vector3& force, const Vector3& position, PointForceMode mode)
 	{
+		gPhysX()._waitForSimulation();
+
 		const PxVec3& pxForce = toPxVector(force);
 		const PxVec3& pxPos = toPxVector(position);
 
@@ -396,6 +429,8 @@ namespace bs
 
 	void PhysXRigidbody::addCollider(Collider* collider)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (collider == nullptr)
 			return;
 
@@ -407,6 +442,8 @@ namespace bs
 
 	void PhysXRigidbody::removeCollider(Collider* collider)
 	{
+		gPhysX()._waitForSimulation();
+
 		if (collider == nullptr)
 			return;
 
@@ -418,6 +455,8 @@ namespace bs
 
 	void PhysXRigidbody::removeColliders()
 	{
+		gPhysX()._waitForSimulation();
+
 		UINT32 numShapes = mInternal->getNbShapes();
 		PxShape** shapes = (PxShape**)bs_stack_alloc(sizeof(PxShape*) * numShapes);
 
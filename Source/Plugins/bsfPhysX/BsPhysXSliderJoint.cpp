@@ -82,6 +82,8 @@ namespace bs
 
 	void PhysXSliderJoint::setLimit(const LimitLinearRange& limit)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxJointLinearLimitPair pxLimit(gPhysX().getScale(), limit.lower, limit.upper, limit.contactDist);
 		pxLimit.stiffness = limit.spring.stiffness;
 		pxLimit.damping = limit.spring.damping;
@@ -92,6 +94,7 @@ namespace bs
 
 	void PhysXSliderJoint::setFlag(SliderJointFlag flag, bool enabled)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setPrismaticJointFlag(toPxFlag(flag), enabled);
 	}
 
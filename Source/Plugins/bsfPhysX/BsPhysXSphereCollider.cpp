@@ -30,12 +30,14 @@ namespace bs
 
 	void PhysXSphereCollider::setScale(const Vector3& scale)
 	{
+		gPhysX()._waitForSimulation();
 		SphereCollider::setScale(scale);
 		applyGeometry();
 	}
 
 	void PhysXSphereCollider::setRadius(float radius)
 	{
+		gPhysX()._waitForSimulation();
 		mRadius = radius;
 		applyGeometry();
 	}
@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsPhysXSphericalJoint.h"
+#include "BsPhysX.h"
 #include "BsFPhysXJoint.h"
 #include "BsPhysXRigidbody.h"
 #include "PxRigidDynamic.h"
@@ -71,6 +72,8 @@ namespace bs
 
 	void PhysXSphericalJoint::setLimit(const LimitConeRange& limit)
 	{
+		gPhysX()._waitForSimulation();
+
 		PxJointLimitCone pxLimit(limit.yLimitAngle.valueRadians(), limit.zLimitAngle.valueRadians(), limit.contactDist);
 		pxLimit.stiffness = limit.spring.stiffness;
 		pxLimit.damping = limit.spring.damping;
@@ -81,6 +84,7 @@ namespace bs
 
 	void PhysXSphericalJoint::setFlag(SphericalJointFlag flag, bool enabled)
 	{
+		gPhysX()._waitForSimulation();
 		getInternal()->setSphericalJointFlag(toPxFlag(flag), enabled);
 	}
 
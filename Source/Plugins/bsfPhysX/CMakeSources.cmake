@@ -18,6 +18,8 @@ set(BS_PHYSX_INC_NOFILTER
 	"BsPhysXSphericalJoint.h"
 	"BsPhysXD6Joint.h"
 	"BsPhysXCharacterController.h"
+	"BsPhysXCPUDispatcher.h"
+	"BsPhysXInterpolator.h"
 )
 
 set(BS_PHYSX_SRC_NOFILTER
@@ -40,6 +42,8 @@ set(BS_PHYSX_SRC_NOFILTER
 	"BsPhysXSphericalJoint.cpp"
 	"BsPhysXD6Joint.cpp"
 	"BsPhysXCharacterController.cpp"
+	"BsPhysXCPUDispatcher.cpp"
+	"BsPhysXInterpolator.cpp"
 )
 
 set(BS_PHYSX_INC_RTTI
@@ -0,0 +1,311 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysX.h"
+#include "BsFPhysXCollider.h"
+#include "PxPhysicsAPI.h"
+#include "Physics/BsBoxCollider.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+
+using namespace physx;
+
+namespace bs
+{
+	/** Type of a collision event received by a collider. */
+	enum class TestEventType
+	{
+		Begin,
+		Stay,
+		End
+	};
+
+	/** Collision event as received by a collider. */
+	struct TestEvent
+	{
+		Collider* collider;
+		Collider* other;
+		TestEventType type;
+
+		bool operator==(const TestEvent& rhs) const
+		{
+			return collider == rhs.collider && other == rhs.other && type == rhs.type;
+		}
+	};
+
+	/** Records all collision events received by a set of colliders, in the order they were received. */
+	class EventRecorder
+	{
+	public:
+		/** Starts recording events received by the collider. */
+		void listen(const SPtr<Collider>& collider)
+		{
+			auto record = [this](TestEventType type)
+			{
+				return [this, type](const CollisionDataRaw& data)
+				{
+					events.push_back({ data.colliders[0], data.colliders[1], type });
+				};
+			};
+
+			mConnections.push_back(collider->onCollisionBegin.connect(record(TestEventType::Begin)));
+			mConnections.push_back(collider->onCollisionStay.connect(record(TestEventType::Stay)));
+			mConnections.push_back(collider->onCollisionEnd.connect(record(TestEventType::End)));
+		}
+
+		~EventRecorder()
+		{
+			for (auto& entry : mConnections)
+				entry.disconnect();
+		}
+
+		Vector<TestEvent> events;
+
+	private:
+		Vector<HEvent> mConnections;
+	};
+
+	/** Returns the PhysX shape of a collider. */
+	PxShape* getShape(const SPtr<Collider>& collider)
+	{
+		return static_cast<FPhysXCollider*>(collider->_getInternal())->_getShape();
+	}
+
+	/**
+	 * Reports a contact between two colliders to the PhysX simulation event callback, the same way PhysX does when it
+	 * finds one. The event is delivered to the colliders during the next fixed update.
+	 */
+	void reportContact(const SPtr<Collider>& a, const SPtr<Collider>& b, PxPairFlags events)
+	{
+		PxContactPair pair;
+		pair.shapes[0] = getShape(a);
+		pair.shapes[1] = getShape(b);
+		pair.contactStream = nullptr;
+		pair.contactStreamSize = 0;
+		pair.contactCount = 0;
+		pair.requiredBufferSize = 0;
+		pair.flags = PxContactPairFlags();
+		pair.events = events;
+
+		PxContactPairHeader header;
+		header.actors[0] = getShape(a)->getActor();
+		header.actors[1] = getShape(b)->getActor();
+		header.extraDataStream = nullptr;
+		header.extraDataStreamSize = 0;
+		header.flags = PxContactPairHeaderFlags();
+
+		gPhysX().getScene()->getSimulationEventCallback()->onContact(header, &pair, 1);
+	}
+
+	/** Reports an interaction between a trigger and another collider, the same way PhysX does when it finds one. */
+	void reportTrigger(const SPtr<Collider>& trigger, const SPtr<Collider>& other, PxPairFlag::Enum status)
+	{
+		PxTriggerPair pair;
+		pair.triggerShape = getShape(trigger);
+		pair.triggerActor = getShape(trigger)->getActor();
+		pair.otherShape = getShape(other);
+		pair.otherActor = getShape(other)->getActor();
+		pair.status = status;
+		pair.flags = PxTriggerPairFlags();
+
+		gPhysX().getScene()->getSimulationEventCallback()->onTrigger(&pair, 1);
+	}
+
+	class PhysXContactTestSuite : public TestSuite
+	{
+	public:
+		PhysXContactTestSuite();
+
+	protected:
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testContactFiltering();
+		void testTriggerFiltering();
+	};
+
+	PhysXContactTestSuite::PhysXContactTestSuite()
+	{
+		BS_ADD_TEST(PhysXContactTestSuite::testContactFiltering);
+		BS_ADD_TEST(PhysXContactTestSuite::testTriggerFiltering);
+	}
+
+	void PhysXContactTestSuite::startUp()
+	{
+		// Modules can't be restarted, so physics is shared by all the tests
+		PHYSICS_INIT_DESC desc;
+		desc.initCooking = false;
+
+		Physics::startUp<PhysX>(desc);
+	}
+
+	void PhysXContactTestSuite::shutDown()
+	{
+		Physics::shutDown();
+	}
+
+	void PhysXContactTestSuite::testContactFiltering()
+	{
+		static constexpr float STEP = 1.0f / 60.0f;
+		static constexpr UINT64 DISABLED_LAYER = 5;
+
+		// Colliders are far apart, so the simulation itself doesn't report anything about them
+		SPtr<Collider> a = gPhysics().createBoxCollider(Vector3::ONE, Vector3(-10.0f, 0.0f, 0.0f),
+			Quaternion::IDENTITY);
+		SPtr<Collider> b = gPhysics().createBoxCollider(Vector3::ONE, Vector3(10.0f, 0.0f, 0.0f),
+			Quaternion::IDENTITY);
+
+		EventRecorder recorder;
+		recorder.listen(a);
+		recorder.listen(b);
+
+		auto simulate = [&](const SPtr<Collider>& first, const SPtr<Collider>& second, PxPairFlags events)
+		{
+			recorder.events.clear();
+
+			reportContact(first, second, events);
+			gPhysics().fixedUpdate(STEP);
+
+			return recorder.events;
+		};
+
+		const PxPairFlags found = PxPairFlag::eNOTIFY_TOUCH_FOUND;
+		const PxPairFlags persists = PxPairFlag::eNOTIFY_TOUCH_PERSISTS;
+		const PxPairFlags lost = PxPairFlag::eNOTIFY_TOUCH_LOST;
+
+		// Nobody listening, nothing is reported
+		a->setCollisionReportMode(CollisionReportMode::None);
+		b->setCollisionReportMode(CollisionReportMode::None);
+
+		BS_TEST_ASSERT(simulate(a, b, found).empty());
+
+		// Only colliders that asked for events receive them
+		b->setCollisionReportMode(CollisionReportMode::Report);
+
+		Vector<TestEvent> expected = { { b.get(), a.get(), TestEventType::Begin } };
+		BS_TEST_ASSERT(simulate(a, b, found) == expected);
+
+		expected = { { b.get(), a.get(), TestEventType::End } };
+		BS_TEST_ASSERT(simulate(b, a, lost) == expected);
+
+		a->setCollisionReportMode(CollisionReportMode::Report);
+
+		expected = { { a.get(), b.get(), TestEventType::Begin }, { b.get(), a.get(), TestEventType::Begin } };
+		BS_TEST_ASSERT(simulate(a, b, found) == expected);
+
+		// Persistent contacts are only reported to colliders that asked for them
+		BS_TEST_ASSERT(simulate(a, b, persists).empty());
+
+		a->setCollisionReportMode(CollisionReportMode::ReportPersistent);
+
+		expected = { { a.get(), b.get(), TestEventType::Stay } };
+		BS_TEST_ASSERT(simulate(a, b, persists) == expected);
+
+		expected = { { a.get(), b.get(), TestEventType::Begin }, { b.get(), a.get(), TestEventType::Begin } };
+		BS_TEST_ASSERT(simulate(a, b, found) == expected);
+
+		// Touch found and lost during the same step reports both, in order
+		expected = {
+			{ a.get(), b.get(), TestEventType::Begin }, { b.get(), a.get(), TestEventType::Begin },
+			{ a.get(), b.get(), TestEventType::End }, { b.get(), a.get(), TestEventType::End }
+		};
+		BS_TEST_ASSERT(simulate(a, b, found | lost) == expected);
+
+		// Colliders on layers with events disabled are treated as if they didn't ask for events
+		a->setLayer(DISABLED_LAYER);
+		gPhysics().setEventLayers(BS_ALL_LAYERS & ~(1ULL << DISABLED_LAYER));
+
+		expected = { { b.get(), a.get(), TestEventType::Begin } };
+		BS_TEST_ASSERT(simulate(a, b, found) == expected);
+		BS_TEST_ASSERT(simulate(a, b, persists).empty());
+
+		b->setLayer(DISABLED_LAYER);
+		BS_TEST_ASSERT(simulate(a, b, found).empty());
+
+		gPhysics().setEventLayers(BS_ALL_LAYERS);
+
+		expected = { { a.get(), b.get(), TestEventType::End }, { b.get(), a.get(), TestEventType::End } };
+		BS_TEST_ASSERT(simulate(a, b, lost) == expected);
+	}
+
+	void PhysXContactTestSuite::testTriggerFiltering()
+	{
+		static constexpr float STEP = 1.0f / 60.0f;
+		static constexpr UINT64 DISABLED_LAYER = 5;
+
+		SPtr<Collider> trigger = gPhysics().createBoxCollider(Vector3::ONE, Vector3(-10.0f, 0.0f, 0.0f),
+			Quaternion::IDENTITY);
+		trigger->setIsTrigger(true);
+
+		SPtr<Collider> other = gPhysics().createBoxCollider(Vector3::ONE, Vector3(10.0f, 0.0f, 0.0f),
+			Quaternion::IDENTITY);
+
+		EventRecorder recorder;
+		recorder.listen(trigger);
+		recorder.listen(other);
+
+		auto simulate = [&](PxPairFlag::Enum status)
+		{
+			recorder.events.clear();
+
+			reportTrigger(trigger, other, status);
+			gPhysics().fixedUpdate(STEP);
+
+			return recorder.events;
+		};
+
+		// Only the trigger receives events, according to its own report mode
+		trigger->setCollisionReportMode(CollisionReportMode::None);
+		other->setCollisionReportMode(CollisionReportMode::ReportPersistent);
+
+		BS_TEST_ASSERT(simulate(PxPairFlag::eNOTIFY_TOUCH_FOUND).empty());
+
+		trigger->setCollisionReportMode(CollisionReportMode::Report);
+		other->setCollisionReportMode(CollisionReportMode::None);
+
+		Vector<TestEvent> expected = { { trigger.get(), other.get(), TestEventType::Begin } };
+		BS_TEST_ASSERT(simulate(PxPairFlag::eNOTIFY_TOUCH_FOUND) == expected);
+		BS_TEST_ASSERT(simulate(PxPairFlag::eNOTIFY_TOUCH_PERSISTS).empty());
+
+		trigger->setCollisionReportMode(CollisionReportMode::ReportPersistent);
+
+		expected = { { trigger.get(), other.get(), TestEventType::Stay } };
+		BS_TEST_ASSERT(simulate(PxPairFlag::eNOTIFY_TOUCH_PERSISTS) == expected);
+
+		// Only the layer of the trigger is checked, as it is the one receiving the event
+		other->setLayer(DISABLED_LAYER);
+		gPhysics().setEventLayers(BS_ALL_LAYERS & ~(1ULL << DISABLED_LAYER));
+
+		expected = { { trigger.get(), other.get(), TestEventType::End } };
+		BS_TEST_ASSERT(simulate(PxPairFlag::eNOTIFY_TOUCH_LOST) == expected);
+
+		trigger->setLayer(DISABLED_LAYER);
+		BS_TEST_ASSERT(simulate(PxPairFlag::eNOTIFY_TOUCH_FOUND).empty());
+
+		gPhysics().setEventLayers(BS_ALL_LAYERS);
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	// Test failures are reported through the stack allocator, normally set up by the application
+	MemStack::beginThread();
+
+	ThreadPool::startUp<TThreadPool<>>(std::max(1U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY - 1));
+	TaskScheduler::startUp();
+
+	SPtr<TestSuite> tests = PhysXContactTestSuite::create<PhysXContactTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+
+	MemStack::endThread();
+	return 0;
+}
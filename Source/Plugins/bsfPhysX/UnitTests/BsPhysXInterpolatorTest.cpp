@@ -0,0 +1,252 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysXInterpolator.h"
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/**
+	 * Returns a dummy rigidbody pointer usable as an identifier. The interpolator never accesses the rigidbodies or scene
+	 * objects it tracks.
+	 */
+	Rigidbody* dummyRigidbody(UINT32 idx)
+	{
+		return reinterpret_cast<Rigidbody*>((uintptr_t)(idx + 1) * 16);
+	}
+
+	/** Returns a dummy scene object pointer usable as an identifier. See dummyRigidbody(). */
+	SceneObject* dummySceneObject(UINT32 idx)
+	{
+		return reinterpret_cast<SceneObject*>((uintptr_t)(idx + 1) * 32);
+	}
+
+	/** Finds the pose of the provided scene object in the array. Returns null if not found. */
+	const SceneObjectPose* findPose(const Vector<SceneObjectPose>& poses, SceneObject* sceneObject)
+	{
+		for (auto& entry : poses)
+		{
+			if (entry.sceneObject == sceneObject)
+				return &entry;
+		}
+
+		return nullptr;
+	}
+
+	class PhysXInterpolatorTestSuite : public TestSuite
+	{
+	public:
+		PhysXInterpolatorTestSuite();
+
+	private:
+		void testInterpolation();
+		void testStoppedBodies();
+		void testTeleport();
+	};
+
+	PhysXInterpolatorTestSuite::PhysXInterpolatorTestSuite()
+	{
+		BS_ADD_TEST(PhysXInterpolatorTestSuite::testInterpolation);
+		BS_ADD_TEST(PhysXInterpolatorTestSuite::testStoppedBodies);
+		BS_ADD_TEST(PhysXInterpolatorTestSuite::testTeleport);
+	}
+
+	void PhysXInterpolatorTestSuite::testInterpolation()
+	{
+		static constexpr UINT64 STEP = 20000;
+
+		PhysXInterpolator interpolator;
+		Vector<SceneObjectPose> poses;
+
+		// First step, body starts moving from its current transform
+		const Quaternion rotation(Degree(0), Degree(90), Degree(0));
+		interpolator.beginStep(STEP, STEP);
+		interpolator.add(dummyRigidbody(0), dummySceneObject(0), Vector3(0, 0, 0), Quaternion::IDENTITY,
+			Vector3(10, 0, 0), rotation);
+		interpolator.endStep(poses);
+
+		BS_TEST_ASSERT(poses.empty());
+		BS_TEST_ASSERT(!interpolator.isEmpty());
+
+		// Interpolation starts at the result time and covers a single step, any time outside of it is clamped
+		interpolator.evaluate(STEP / 2, poses);
+		BS_TEST_ASSERT(poses.size() == 1);
+		BS_TEST_ASSERT(poses[0].sceneObject == dummySceneObject(0));
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].position, Vector3(0, 0, 0)));
+
+		interpolator.evaluate(STEP, poses);
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].position, Vector3(0, 0, 0)));
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].rotation, Quaternion::IDENTITY));
+
+		interpolator.evaluate(STEP + STEP / 2, poses);
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].position, Vector3(5, 0, 0)));
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].rotation, Quaternion(Degree(0), Degree(45), Degree(0))));
+
+		interpolator.evaluate(STEP * 2, poses);
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].position, Vector3(10, 0, 0)));
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].rotation, rotation));
+
+		interpolator.evaluate(STEP * 10, poses);
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].position, Vector3(10, 0, 0)));
+
+		// Next step continues from the results of the previous one
+		poses.clear();
+		interpolator.beginStep(STEP * 2, STEP);
+		BS_TEST_ASSERT(interpolator.setResult(dummyRigidbody(0), Vector3(20, 0, 0), rotation));
+		BS_TEST_ASSERT(!interpolator.setResult(dummyRigidbody(1), Vector3(0, 0, 0), Quaternion::IDENTITY));
+		interpolator.endStep(poses);
+
+		BS_TEST_ASSERT(poses.empty());
+
+		interpolator.evaluate(STEP * 2 + STEP / 4, poses);
+		BS_TEST_ASSERT(poses.size() == 1);
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].position, Vector3(12.5f, 0, 0)));
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].rotation, rotation));
+
+		// Clearing applies the final results
+		poses.clear();
+		interpolator.clear(poses);
+
+		BS_TEST_ASSERT(interpolator.isEmpty());
+		BS_TEST_ASSERT(poses.size() == 1);
+		BS_TEST_ASSERT(Math::approxEquals(poses[0].position, Vector3(20, 0, 0)));
+	}
+
+	void PhysXInterpolatorTestSuite::testStoppedBodies()
+	{
+		static constexpr UINT32 NUM_BODIES = 8;
+
+		PhysXInterpolator interpolator;
+		Vector<SceneObjectPose> poses;
+
+		interpolator.beginStep(0, 1000);
+		for (UINT32 i = 0; i < NUM_BODIES; i++)
+		{
+			interpolator.add(dummyRigidbody(i), dummySceneObject(i), Vector3(0, 0, 0), Quaternion::IDENTITY,
+				Vector3((float)i, 0, 0), Quaternion::IDENTITY);
+		}
+
+		interpolator.endStep(poses);
+		BS_TEST_ASSERT(poses.empty());
+
+		// Only even bodies keep moving, odd ones went to sleep and are left at the transform they last reached
+		interpolator.beginStep(1000, 1000);
+		for (UINT32 i = 0; i < NUM_BODIES; i += 2)
+			BS_TEST_ASSERT(interpolator.setResult(dummyRigidbody(i), Vector3((float)i, 1, 0), Quaternion::IDENTITY));
+
+		interpolator.endStep(poses);
+		BS_TEST_ASSERT(poses.size() == NUM_BODIES / 2);
+
+		for (UINT32 i = 1; i < NUM_BODIES; i += 2)
+		{
+			const SceneObjectPose* pose = findPose(poses, dummySceneObject(i));
+			BS_TEST_ASSERT(pose != nullptr);
+
+			if (pose != nullptr)
+			{
+				BS_TEST_ASSERT(Math::approxEquals(pose->position, Vector3((float)i, 0, 0)));
+			}
+		}
+
+		// Stopped bodies are no longer interpolated, and the moving ones still interpolate correctly
+		interpolator.evaluate(1500, poses);
+		BS_TEST_ASSERT(poses.size() == NUM_BODIES / 2);
+
+		for (UINT32 i = 0; i < NUM_BODIES; i++)
+		{
+			const SceneObjectPose* pose = findPose(poses, dummySceneObject(i));
+			BS_TEST_ASSERT((pose != nullptr) == (i % 2 == 0));
+
+			if (pose != nullptr)
+			{
+				BS_TEST_ASSERT(Math::approxEquals(pose->position, Vector3((float)i, 0.5f, 0)));
+			}
+		}
+
+		// Body that starts moving again is tracked anew
+		BS_TEST_ASSERT(!interpolator.setResult(dummyRigidbody(1), Vector3(1, 1, 0), Quaternion::IDENTITY));
+	}
+
+	void PhysXInterpolatorTestSuite::testTeleport()
+	{
+		static constexpr UINT32 NUM_BODIES = 4;
+
+		PhysXInterpolator interpolator;
+		Vector<SceneObjectPose> poses;
+
+		interpolator.beginStep(0, 1000);
+		for (UINT32 i = 0; i < NUM_BODIES; i++)
+		{
+			interpolator.add(dummyRigidbody(i), dummySceneObject(i), Vector3(0, 0, 0), Quaternion::IDENTITY,
+				Vector3((float)i, 0, 0), Quaternion::IDENTITY);
+		}
+
+		interpolator.endStep(poses);
+
+		// Teleported body stops being interpolated immediately, so the interpolation doesn't override its new transform
+		interpolator.remove(dummyRigidbody(0));
+		interpolator.remove(dummyRigidbody(NUM_BODIES));
+
+		interpolator.evaluate(1000, poses);
+		BS_TEST_ASSERT(poses.size() == NUM_BODIES - 1);
+		BS_TEST_ASSERT(findPose(poses, dummySceneObject(0)) == nullptr);
+
+		// Remaining bodies keep their own results after the removal reorders them
+		poses.clear();
+		interpolator.beginStep(1000, 1000);
+		for (UINT32 i = 1; i < NUM_BODIES; i++)
+			BS_TEST_ASSERT(interpolator.setResult(dummyRigidbody(i), Vector3((float)i, 2, 0), Quaternion::IDENTITY));
+
+		interpolator.endStep(poses);
+		BS_TEST_ASSERT(poses.empty());
+
+		interpolator.evaluate(2000, poses);
+		for (UINT32 i = 1; i < NUM_BODIES; i++)
+		{
+			const SceneObjectPose* pose = findPose(poses, dummySceneObject(i));
+			BS_TEST_ASSERT(pose != nullptr);
+
+			if (pose != nullptr)
+			{
+				BS_TEST_ASSERT(Math::approxEquals(pose->position, Vector3((float)i, 2, 0)));
+			}
+		}
+
+		// Teleported body that keeps moving starts interpolating from its new transform
+		BS_TEST_ASSERT(!interpolator.setResult(dummyRigidbody(0), Vector3(5, 0, 0), Quaternion::IDENTITY));
+		interpolator.add(dummyRigidbody(0), dummySceneObject(0), Vector3(4, 0, 0), Quaternion::IDENTITY,
+			Vector3(5, 0, 0), Quaternion::IDENTITY);
+
+		interpolator.evaluate(1500, poses);
+		const SceneObjectPose* pose = findPose(poses, dummySceneObject(0));
+		BS_TEST_ASSERT(pose != nullptr);
+
+		if (pose != nullptr)
+		{
+			BS_TEST_ASSERT(Math::approxEquals(pose->position, Vector3(4.5f, 0, 0)));
+		}
+
+		// Removing all bodies
+		for (UINT32 i = 0; i < NUM_BODIES; i++)
+			interpolator.remove(dummyRigidbody(i));
+
+		BS_TEST_ASSERT(interpolator.isEmpty());
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	// Test failures are reported through the stack allocator, normally set up by the application
+	MemStack::beginThread();
+
+	SPtr<TestSuite> tests = PhysXInterpolatorTestSuite::create<PhysXInterpolatorTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	MemStack::endThread();
+	return 0;
+}
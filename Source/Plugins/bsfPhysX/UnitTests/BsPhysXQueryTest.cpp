@@ -0,0 +1,238 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysX.h"
+#include "Physics/BsBoxCollider.h"
+#include "Physics/BsSphereCollider.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+#include "Math/BsMath.h"
+#include "Math/BsAABox.h"
+#include "Math/BsSphere.h"
+#include "Math/BsCapsule.h"
+#include "Math/BsLineSegment3.h"
+
+namespace bs
+{
+	/** Sorts query hits by distance, closest first. */
+	void sortHits(Vector<PhysicsQueryHit>& hits)
+	{
+		std::sort(hits.begin(), hits.end(),
+			[](const PhysicsQueryHit& a, const PhysicsQueryHit& b) { return a.distance < b.distance; });
+	}
+
+	/** Checks if two query hits refer to the same collider at the same location. */
+	bool hitsEqual(const PhysicsQueryHit& a, const PhysicsQueryHit& b)
+	{
+		return a.colliderRaw == b.colliderRaw && Math::approxEquals(a.distance, b.distance, 0.001f) &&
+			Math::approxEquals(a.point, b.point, 0.001f) && Math::approxEquals(a.normal, b.normal, 0.001f);
+	}
+
+	/** Checks if two sets of colliders contain the same entries, in any order. */
+	bool collidersEqual(Vector<Collider*> a, Vector<Collider*> b)
+	{
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+
+		return a == b;
+	}
+
+	class PhysXQueryTestSuite : public TestSuite
+	{
+	public:
+		PhysXQueryTestSuite();
+
+	private:
+		void testQueryBatch();
+	};
+
+	PhysXQueryTestSuite::PhysXQueryTestSuite()
+	{
+		BS_ADD_TEST(PhysXQueryTestSuite::testQueryBatch);
+	}
+
+	void PhysXQueryTestSuite::testQueryBatch()
+	{
+		static constexpr UINT32 MAX_HITS = 8;
+
+		PHYSICS_INIT_DESC desc;
+		desc.initCooking = false;
+
+		Physics::startUp<PhysX>(desc);
+
+		{
+			// Row of boxes along the negative Z axis, with a sphere to the side of the middle one
+			Vector<SPtr<Collider>> colliders;
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				colliders.push_back(gPhysics().createBoxCollider(Vector3::ONE, Vector3(0.0f, 0.0f, -5.0f * (i + 1)),
+					Quaternion::IDENTITY));
+			}
+
+			colliders.push_back(gPhysics().createSphereCollider(1.0f, Vector3(5.0f, 0.0f, -10.0f), Quaternion::IDENTITY));
+
+			Vector<PHYSICS_QUERY_DESC> queries;
+			auto addQuery = [&](PhysicsQueryType type, const Vector3& position, const Vector3& unitDir, bool allHits)
+			{
+				PHYSICS_QUERY_DESC query;
+				query.type = type;
+				query.position = position;
+				query.unitDir = unitDir;
+				query.allHits = allHits;
+				query.halfExtents = Vector3(0.5f, 0.5f, 0.5f);
+				query.radius = 0.5f;
+				query.halfHeight = 0.5f;
+
+				queries.push_back(query);
+				return (UINT32)queries.size() - 1;
+			};
+
+			const Vector3 forward = -Vector3::UNIT_Z;
+			const UINT32 rayClosest = addQuery(PhysicsQueryType::RayCast, Vector3::ZERO, forward, false);
+			const UINT32 rayAll = addQuery(PhysicsQueryType::RayCast, Vector3::ZERO, forward, true);
+			const UINT32 rayMiss = addQuery(PhysicsQueryType::RayCast, Vector3::ZERO, Vector3::UNIT_Z, false);
+			const UINT32 rayAllLimited = addQuery(PhysicsQueryType::RayCast, Vector3::ZERO, forward, true);
+			queries[rayAllLimited].maxDistance = 6.0f;
+			const UINT32 sphereClosest = addQuery(PhysicsQueryType::SphereCast, Vector3::ZERO, forward, false);
+			const UINT32 sphereAll = addQuery(PhysicsQueryType::SphereCast, Vector3::ZERO, forward, true);
+			const UINT32 boxClosest = addQuery(PhysicsQueryType::BoxCast, Vector3(5.0f, 0.0f, 0.0f), forward, false);
+			const UINT32 capsuleAll = addQuery(PhysicsQueryType::CapsuleCast, Vector3(1.0f, 0.0f, 0.0f), forward, true);
+			const UINT32 boxOverlap = addQuery(PhysicsQueryType::BoxOverlap, Vector3(0.0f, 0.0f, -10.0f), forward, false);
+			const UINT32 sphereOverlap = addQuery(PhysicsQueryType::SphereOverlap, Vector3(2.5f, 0.0f, -10.0f), forward,
+				false);
+			queries[sphereOverlap].radius = 2.0f;
+			const UINT32 capsuleOverlap = addQuery(PhysicsQueryType::CapsuleOverlap, Vector3(0.0f, 0.0f, -6.25f),
+				forward, false);
+			queries[capsuleOverlap].halfHeight = 2.0f;
+
+			// Repeat the queries enough times for the batch to be split into multiple chunks, executed on worker threads
+			const UINT32 numUniqueQueries = (UINT32)queries.size();
+			for (UINT32 i = 0; i < 20; i++)
+			{
+				for (UINT32 j = 0; j < numUniqueQueries; j++)
+					queries.push_back(queries[j]);
+			}
+
+			const UINT32 numQueries = (UINT32)queries.size();
+			Vector<PhysicsQueryHit> hits(numQueries * MAX_HITS);
+			Vector<UINT32> numHits(numQueries);
+
+			gPhysics().queryBatch(queries.data(), numQueries, hits.data(), MAX_HITS, numHits.data());
+
+			auto getHits = [&](UINT32 queryIdx)
+			{
+				const auto first = hits.begin() + queryIdx * MAX_HITS;
+				return Vector<PhysicsQueryHit>(first, first + numHits[queryIdx]);
+			};
+
+			auto getColliders = [&](UINT32 queryIdx)
+			{
+				Vector<Collider*> output;
+				for (auto& entry : getHits(queryIdx))
+					output.push_back(entry.colliderRaw);
+
+				return output;
+			};
+
+			for (UINT32 i = 0; i < numQueries; i += numUniqueQueries)
+			{
+				const PHYSICS_QUERY_DESC& base = queries[i];
+
+				// Closest hits match the single queries
+				PhysicsQueryHit hit;
+				BS_TEST_ASSERT(gPhysics().rayCast(base.position, forward, hit));
+				BS_TEST_ASSERT(numHits[i + rayClosest] == 1);
+				BS_TEST_ASSERT(hitsEqual(hits[(i + rayClosest) * MAX_HITS], hit));
+				BS_TEST_ASSERT(hit.colliderRaw == colliders[0].get());
+				BS_TEST_ASSERT(Math::approxEquals(hit.distance, 4.0f, 0.001f));
+
+				BS_TEST_ASSERT(numHits[i + rayMiss] == 0);
+
+				const Sphere sphere(Vector3::ZERO, 0.5f);
+				BS_TEST_ASSERT(gPhysics().sphereCast(sphere, forward, hit));
+				BS_TEST_ASSERT(numHits[i + sphereClosest] == 1);
+				BS_TEST_ASSERT(hitsEqual(hits[(i + sphereClosest) * MAX_HITS], hit));
+
+				const AABox box(Vector3(4.5f, -0.5f, -0.5f), Vector3(5.5f, 0.5f, 0.5f));
+				BS_TEST_ASSERT(gPhysics().boxCast(box, Quaternion::IDENTITY, forward, hit));
+				BS_TEST_ASSERT(numHits[i + boxClosest] == 1);
+				BS_TEST_ASSERT(hitsEqual(hits[(i + boxClosest) * MAX_HITS], hit));
+				BS_TEST_ASSERT(hit.colliderRaw == colliders[3].get());
+
+				// All hits match the single queries, sorted by distance
+				auto compareAll = [&](UINT32 queryIdx, Vector<PhysicsQueryHit> expected)
+				{
+					const Vector<PhysicsQueryHit> batchHits = getHits(queryIdx);
+					sortHits(expected);
+
+					if (batchHits.size() != expected.size())
+						return false;
+
+					for (UINT32 j = 0; j < (UINT32)expected.size(); j++)
+					{
+						if (!hitsEqual(batchHits[j], expected[j]))
+							return false;
+					}
+
+					return true;
+				};
+
+				BS_TEST_ASSERT(numHits[i + rayAll] == 3);
+				BS_TEST_ASSERT(compareAll(i + rayAll, gPhysics().rayCastAll(base.position, forward)));
+
+				BS_TEST_ASSERT(numHits[i + rayAllLimited] == 1);
+				BS_TEST_ASSERT(compareAll(i + rayAllLimited, gPhysics().rayCastAll(base.position, forward,
+					BS_ALL_LAYERS, 6.0f)));
+
+				BS_TEST_ASSERT(numHits[i + sphereAll] == 3);
+				BS_TEST_ASSERT(compareAll(i + sphereAll, gPhysics().sphereCastAll(sphere, forward)));
+
+				// Capsule axis is along X, matching the capsule of the batch query with identity rotation
+				const Capsule capsule(LineSegment3(Vector3(0.5f, 0.0f, 0.0f), Vector3(1.5f, 0.0f, 0.0f)), 0.5f);
+				BS_TEST_ASSERT(numHits[i + capsuleAll] == 3);
+				BS_TEST_ASSERT(compareAll(i + capsuleAll, gPhysics().capsuleCastAll(capsule, Quaternion::IDENTITY,
+					forward)));
+
+				// Overlaps report the same colliders as the single queries, in any order
+				const AABox overlapBox(Vector3(-0.5f, -0.5f, -10.5f), Vector3(0.5f, 0.5f, -9.5f));
+				BS_TEST_ASSERT(numHits[i + boxOverlap] == 1);
+				BS_TEST_ASSERT(collidersEqual(getColliders(i + boxOverlap),
+					gPhysics()._boxOverlap(overlapBox, Quaternion::IDENTITY)));
+
+				const Sphere overlapSphere(Vector3(2.5f, 0.0f, -10.0f), 2.0f);
+				BS_TEST_ASSERT(numHits[i + sphereOverlap] == 2);
+				BS_TEST_ASSERT(collidersEqual(getColliders(i + sphereOverlap), gPhysics()._sphereOverlap(overlapSphere)));
+
+				const Capsule overlapCapsule(LineSegment3(Vector3(-2.0f, 0.0f, -6.25f), Vector3(2.0f, 0.0f, -6.25f)), 0.5f);
+				BS_TEST_ASSERT(numHits[i + capsuleOverlap] == 1);
+				BS_TEST_ASSERT(collidersEqual(getColliders(i + capsuleOverlap),
+					gPhysics()._capsuleOverlap(overlapCapsule, Quaternion::IDENTITY)));
+			}
+		}
+
+		Physics::shutDown();
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	// Test failures are reported through the stack allocator, normally set up by the application
+	MemStack::beginThread();
+
+	ThreadPool::startUp<TThreadPool<>>(std::max(1U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY - 1));
+	TaskScheduler::startUp();
+
+	SPtr<TestSuite> tests = PhysXQueryTestSuite::create<PhysXQueryTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+
+	MemStack::endThread();
+	return 0;
+}
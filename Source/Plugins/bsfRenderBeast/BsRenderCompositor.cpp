@@ -343,9 +343,9 @@ namespace bs { namespace ct
 			gRendererUtility().setPassParams(renderElem->params, iter->passIdx);
 
 			if(renderElem->morphVertexDeclaration == nullptr)
-				gRendererUtility().draw(renderElem->mesh, renderElem->subMesh);
+				gRendererUtility().draw(renderElem->mesh, *iter->subMesh);
 			else
-				gRendererUtility().drawMorph(renderElem->mesh, renderElem->subMesh, renderElem->morphShapeBuffer, 
+				gRendererUtility().drawMorph(renderElem->mesh, *iter->subMesh, renderElem->morphShapeBuffer, 
 					renderElem->morphVertexDeclaration);
 		}
 
@@ -1368,9 +1368,9 @@ namespace bs { namespace ct
 				{
 					const auto& renderElem = static_cast<const RenderableElement*>(iter->renderElem);
 					if (renderElem->morphVertexDeclaration == nullptr)
-						gRendererUtility().draw(renderElem->mesh, renderElem->subMesh);
+						gRendererUtility().draw(renderElem->mesh, *iter->subMesh);
 					else
-						gRendererUtility().drawMorph(renderElem->mesh, renderElem->subMesh, renderElem->morphShapeBuffer,
+						gRendererUtility().drawMorph(renderElem->mesh, *iter->subMesh, renderElem->morphShapeBuffer,
 							renderElem->morphVertexDeclaration);
 				}
 			}
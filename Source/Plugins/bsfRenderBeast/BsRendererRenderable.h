@@ -41,6 +41,9 @@ namespace bs { namespace ct
 	class RenderableElement : public RenderElement
 	{
 	public:
+		/** Portions of the mesh to render at lower levels of detail, starting with LOD 1. Empty if the mesh has none. */
+		Vector<SubMesh> lodSubMeshes;
+
 		/**
 		 * Optional overrides for material sampler states. Used when renderer wants to override certain sampling properties
 		 * on a global scale (for example filtering most commonly).
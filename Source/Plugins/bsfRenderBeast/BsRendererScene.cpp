@@ -246,6 +246,10 @@ namespace bs {	namespace ct
 				renElement.type = (UINT32)RenderElementType::Renderable;
 				renElement.mesh = mesh;
 				renElement.subMesh = meshProps.getSubMesh(i);
+
+				for (UINT32 j = 1; j < meshProps.getNumLODs(); j++)
+					renElement.lodSubMeshes.push_back(meshProps.getSubMesh(i, j));
+
 				renElement.animType = renderable->getAnimType();
 				renElement.animationId = renderable->getAnimationId();
 				renElement.morphShapeVersion = 0;
@@ -507,6 +511,9 @@ namespace bs {	namespace ct
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
 		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
 
+		for (auto& view : mInfo.views)
+			view->_notifyRenderableRemoved(renderableId, lastRenderableId);
+
 		bs_delete(rendererRenderable);
 	}
 
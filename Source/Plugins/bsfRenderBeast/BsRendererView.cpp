@@ -4,6 +4,7 @@
 #include "Renderer/BsCamera.h"
 #include "Renderer/BsRenderable.h"
 #include "Renderer/BsRendererUtility.h"
+#include "Mesh/BsMesh.h"
 #include "Material/BsMaterial.h"
 #include "Material/BsShader.h"
 #include "Material/BsGpuParamsSet.h"
@@ -297,26 +298,33 @@ namespace bs { namespace ct
 		if (mRenderSettings->overlayOnly)
 			return;
 
+		mRenderableLODs.resize(sceneInfo.renderables.size(), 0);
+
 		// Update per-object param buffers and queue render elements
 		for(UINT32 i = 0; i < (UINT32)sceneInfo.renderables.size(); i++)
 		{
 			if (!mVisibility.renderables[i])
 				continue;
 
-			const AABox& boundingBox = sceneInfo.renderableCullInfos[i].bounds.getBox();
-			const float distanceToCamera = (mProperties.viewOrigin - boundingBox.getCenter()).length();
+			const Bounds& bounds = sceneInfo.renderableCullInfos[i].bounds;
+			const float distanceToCamera = (mProperties.viewOrigin - bounds.getBox().getCenter()).length();
 
+			const UINT32 lodIdx = selectLOD(i, *sceneInfo.renderables[i], bounds.getSphere());
 			for (auto& renderElem : sceneInfo.renderables[i]->elements)
 			{
+				const SubMesh* subMesh = &renderElem.subMesh;
+				if (lodIdx > 0 && lodIdx <= (UINT32)renderElem.lodSubMeshes.size())
+					subMesh = &renderElem.lodSubMeshes[lodIdx - 1];
+
 				// Note: I could keep renderables in multiple separate arrays, so I don't need to do the check here
 				ShaderFlags shaderFlags = renderElem.material->getShader()->getFlags();
 
 				if (shaderFlags.isSet(ShaderFlag::Transparent))
-					mTransparentQueue->add(&renderElem, distanceToCamera);
+					mTransparentQueue->add(&renderElem, distanceToCamera, subMesh);
 				else if (shaderFlags.isSet(ShaderFlag::Forward))
-					mForwardOpaqueQueue->add(&renderElem, distanceToCamera);
+					mForwardOpaqueQueue->add(&renderElem, distanceToCamera, subMesh);
 				else
-					mDeferredOpaqueQueue->add(&renderElem, distanceToCamera);
+					mDeferredOpaqueQueue->add(&renderElem, distanceToCamera, subMesh);
 			}
 		}
 
@@ -337,6 +345,53 @@ namespace bs { namespace ct
 		mTransparentQueue->sort();
 	}
 
+	UINT32 RendererView::selectLOD(UINT32 renderableIdx, const RendererRenderable& renderable, const Sphere& bounds)
+	{
+		// Fraction of the threshold size the screen size must move past before the level of detail changes
+		static constexpr float LOD_HYSTERESIS = 0.1f;
+
+		if (renderable.elements.empty() || renderable.elements[0].mesh == nullptr)
+			return 0;
+
+		const MeshProperties& meshProps = renderable.elements[0].mesh->getProperties();
+		const UINT32 numLODs = meshProps.getNumLODs();
+		if (numLODs == 1)
+			return 0;
+
+		// Diameter of the bounds relative to the viewport height
+		float screenSize = bounds.getRadius() * std::abs(mProperties.projTransform[1][1]);
+		if (mProperties.projType == PT_PERSPECTIVE)
+		{
+			float distance = (bounds.getCenter() - mProperties.viewOrigin).length();
+			screenSize /= std::max(distance, mProperties.nearPlane);
+		}
+
+		UINT32 lodIdx = std::min(mRenderableLODs[renderableIdx], numLODs - 1);
+		while (lodIdx + 1 < numLODs && screenSize < meshProps.getLODScreenSize(lodIdx + 1) * (1.0f - LOD_HYSTERESIS))
+			lodIdx++;
+
+		while (lodIdx > 0 && screenSize > meshProps.getLODScreenSize(lodIdx) * (1.0f + LOD_HYSTERESIS))
+			lodIdx--;
+
+		mRenderableLODs[renderableIdx] = lodIdx;
+		return lodIdx;
+	}
+
+	void RendererView::_notifyRenderableRemoved(UINT32 renderableIdx, UINT32 lastRenderableIdx)
+	{
+		if (lastRenderableIdx < (UINT32)mRenderableLODs.size())
+		{
+			// Mirror the swap with the last element performed by the scene
+			mRenderableLODs[renderableIdx] = mRenderableLODs[lastRenderableIdx];
+			mRenderableLODs.resize(lastRenderableIdx);
+		}
+		else if (renderableIdx < (UINT32)mRenderableLODs.size())
+		{
+			// Last renderable was added after the view last selected LODs, so it has none selected yet
+			mRenderableLODs[renderableIdx] = 0;
+		}
+	}
+
 	Vector2 RendererView::getDeviceZToViewZ(const Matrix4& projMatrix)
 	{
 		// Returns a set of values that will transform depth buffer values (in range [0, 1]) to a distance
@@ -382,6 +382,15 @@ namespace bs { namespace ct
 		/** Assigns a view index to the view. To be called by the parent view group when the view is added to it. */
 		void _setViewIdx(UINT32 viewIdx) { mViewIdx = viewIdx; }
 
+		/**
+		 * Notifies the view that a renderable was removed from the scene, and that the last renderable was moved into its
+		 * slot. Keeps per-renderable data stored by the view in sync with the scene.
+		 *
+		 * @param[in]	renderableIdx		Index of the removed renderable.
+		 * @param[in]	lastRenderableIdx	Index of the last renderable before the removal.
+		 */
+		void _notifyRenderableRemoved(UINT32 renderableIdx, UINT32 lastRenderableIdx);
+
 		/**
 		 * Extracts the necessary values from the projection matrix that allow you to transform device Z value (range [0, 1]
 		 * into view Z value.
@@ -408,6 +417,12 @@ namespace bs { namespace ct
 		 */
 		static Vector2 getNDCZToDeviceZ();
 	private:
+		/** 
+		 * Selects the level of detail to render a renderable with, based on the size of its bounds on screen. Uses the
+		 * level selected during the previous frame to avoid switching back and forth near the threshold sizes.
+		 */
+		UINT32 selectLOD(UINT32 renderableIdx, const RendererRenderable& renderable, const Sphere& bounds);
+
 		RendererViewProperties mProperties;
 		RENDERER_VIEW_TARGET_DESC mTargetDesc;
 		Camera* mCamera;
@@ -422,6 +437,7 @@ namespace bs { namespace ct
 
 		SPtr<GpuParamBlockBuffer> mParamBuffer;
 		VisibilityInfo mVisibility;
+		Vector<UINT32> mRenderableLODs; // Level of detail selected for each renderable during the last frame
 		LightGrid mLightGrid;
 		UINT32 mViewIdx;
 	};
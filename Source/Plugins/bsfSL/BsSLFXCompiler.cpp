@@ -1914,7 +1914,7 @@ namespace bs
 				StringStream subShaderSource;
 				const UnorderedMap<String, String> subShaderDefines = extPointShader.defines.getAll();
 				{
-					Lock fileLock = FileScheduler::getLock(path);
+					FileScheduler::Slot fileSlot = FileScheduler::getLock(path);
 
 					SPtr<DataStream> stream = FileSystem::openFile(path);
 					if(stream)
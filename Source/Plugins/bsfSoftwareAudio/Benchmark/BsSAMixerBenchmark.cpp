@@ -0,0 +1,119 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAPrerequisites.h"
+#include "BsSAMixer.h"
+#include "Math/BsMath.h"
+#include "Utility/BsTimer.h"
+#include <iostream>
+
+namespace bs
+{
+	/** Number of voices playing at once. */
+	static constexpr UINT32 NUM_VOICES = 512;
+
+	/** Sample rate of the mixer output. */
+	static constexpr UINT32 OUTPUT_SAMPLE_RATE = 48000;
+
+	/** Number of frames mixed at once. */
+	static constexpr UINT32 BLOCK_SIZE = 512;
+
+	/** Amount of audio to mix, in seconds. */
+	static constexpr UINT32 DURATION = 10;
+
+	/** Creates a buffer containing a sine wave of the provided frequency. */
+	SPtr<SASampleBuffer> createSineBuffer(UINT32 sampleRate, UINT32 numChannels, float frequency, float length)
+	{
+		SPtr<SASampleBuffer> buffer = bs_shared_ptr_new<SASampleBuffer>();
+		buffer->sampleRate = sampleRate;
+		buffer->numChannels = numChannels;
+		buffer->numFrames = (UINT32)(sampleRate * length);
+		buffer->samples.resize(buffer->numFrames * numChannels);
+
+		for (UINT32 i = 0; i < buffer->numFrames; i++)
+		{
+			float value = Math::sin(Math::TWO_PI * frequency * i / (float)sampleRate) * 0.5f;
+			for (UINT32 j = 0; j < numChannels; j++)
+				buffer->samples[i * numChannels + j] = value;
+		}
+
+		return buffer;
+	}
+
+	/**
+	 * Mixes NUM_VOICES looping voices for DURATION seconds and returns the average time per block, in milliseconds.
+	 * Voices are split between 3D mono voices with varying pitch and position, 2D stereo voices that play at the output
+	 * rate, and 2D mono voices that require resampling.
+	 */
+	double runMixerBenchmark()
+	{
+		SPtr<SASampleBuffer> mono3D = createSineBuffer(44100, 1, 440.0f, 2.0f);
+		SPtr<SASampleBuffer> stereo = createSineBuffer(OUTPUT_SAMPLE_RATE, 2, 220.0f, 3.0f);
+		SPtr<SASampleBuffer> mono = createSineBuffer(22050, 1, 330.0f, 1.5f);
+
+		SAMixer mixer(OUTPUT_SAMPLE_RATE);
+
+		SAListenerProperties listener;
+		mixer.setListener(listener);
+
+		for (UINT32 i = 0; i < NUM_VOICES; i++)
+		{
+			SAVoiceProperties props;
+			props.loop = true;
+			props.volume = 1.0f / NUM_VOICES;
+
+			switch (i % 4)
+			{
+			case 0:
+			case 1:
+			{
+				float angle = Math::TWO_PI * i / (float)NUM_VOICES;
+
+				props.buffer = mono3D;
+				props.is3D = true;
+				props.position = Vector3(Math::cos(angle), 0.0f, Math::sin(angle)) * (1.0f + (i % 20));
+				props.velocity = Vector3(0.0f, 0.0f, (float)(i % 7) - 3.0f);
+				props.pitch = 0.8f + (i % 9) * 0.05f;
+			}
+				break;
+			case 2:
+				props.buffer = stereo;
+				break;
+			case 3:
+				props.buffer = mono;
+				break;
+			}
+
+			UINT32 voiceId = mixer.createVoice();
+			mixer.setVoiceProperties(voiceId, props);
+			mixer.play(voiceId);
+		}
+
+		const UINT32 numBlocks = DURATION * OUTPUT_SAMPLE_RATE / BLOCK_SIZE;
+		Vector<float> output(BLOCK_SIZE * SAMixer::NUM_OUTPUT_CHANNELS);
+
+		// Applies the queued commands so they aren't part of the measurement
+		mixer.mix(output.data(), BLOCK_SIZE);
+
+		Timer timer;
+		for (UINT32 i = 0; i < numBlocks; i++)
+			mixer.mix(output.data(), BLOCK_SIZE);
+
+		return timer.getMicroseconds() / (double)numBlocks / 1000.0;
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	std::cout << "Mixing " << NUM_VOICES << " voices for " << DURATION << " seconds of audio, in blocks of "
+		<< BLOCK_SIZE << " frames at " << OUTPUT_SAMPLE_RATE << " Hz." << std::endl;
+
+	double blockTime = runMixerBenchmark();
+	double blockBudget = BLOCK_SIZE / (double)OUTPUT_SAMPLE_RATE * 1000.0;
+
+	std::cout << "Average: " << blockTime << " ms per block (" << (blockTime / blockBudget) * 100.0
+		<< "% of the real-time budget)" << std::endl;
+
+	return 0;
+}
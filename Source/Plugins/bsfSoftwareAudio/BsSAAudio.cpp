@@ -0,0 +1,259 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAAudio.h"
+#include "BsSAAudioClip.h"
+#include "BsSAAudioListener.h"
+#include "BsSAAudioSource.h"
+#include "BsSAAudioOutput.h"
+#include "BsSAStream.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Name of the device that discards all output. */
+	static const char* NULL_DEVICE_NAME = "Null";
+
+	/** Name of the device that records the output into a wave file. */
+	static const char* WAVE_DEVICE_NAME = "Wave File";
+
+	SAAudio::SAAudio()
+		:mMixer(SAMPLE_RATE)
+	{
+#if BS_SA_OPENAL
+		Vector<String> openALDevices;
+		String defaultOpenALDevice;
+		SAOpenALAudioOutput::enumerateDevices(openALDevices, defaultOpenALDevice);
+
+		for (auto& name : openALDevices)
+			mAllDevices.push_back({ name });
+#endif
+
+		mAllDevices.push_back({ NULL_DEVICE_NAME });
+		mAllDevices.push_back({ WAVE_DEVICE_NAME });
+
+#if BS_SA_OPENAL
+		// Play through the default OpenAL device if there is one, otherwise discard all output
+		if (!openALDevices.empty())
+		{
+			SPtr<SAOpenALAudioOutput> output = bs_shared_ptr_new<SAOpenALAudioOutput>(defaultOpenALDevice, SAMPLE_RATE);
+			if (output->isValid())
+			{
+				mDefaultDevice = { defaultOpenALDevice };
+				mOutput = output;
+			}
+		}
+#endif
+
+		if (mOutput == nullptr)
+		{
+			mDefaultDevice = { NULL_DEVICE_NAME };
+			mOutput = bs_shared_ptr_new<SANullAudioOutput>();
+		}
+
+		mActiveDevice = mDefaultDevice;
+
+		mMixerThread = ThreadPool::instance().run("AudioMixer", std::bind(&SAAudio::runMixer, this));
+	}
+
+	SAAudio::~SAAudio()
+	{
+		stopManualSources();
+
+		{
+			Lock lock(mMixerMutex);
+			mShutdown = true;
+		}
+
+		mMixerSignal.notify_all();
+		mMixerThread.blockUntilComplete();
+
+		if (mStreamingTask != nullptr)
+			mStreamingTask->wait();
+
+		assert(mListeners.empty()); // Everything should be destroyed at this point
+		mOutput = nullptr;
+	}
+
+	void SAAudio::setVolume(float volume)
+	{
+		mVolume = Math::clamp01(volume);
+		mMixer.setVolume(mVolume);
+	}
+
+	void SAAudio::setPaused(bool paused)
+	{
+		mIsPaused = paused;
+		mMixer.setPaused(paused);
+	}
+
+	void SAAudio::setActiveDevice(const AudioDevice& device)
+	{
+		SPtr<SAAudioOutput> output;
+		if (device.name == WAVE_DEVICE_NAME)
+			output = bs_shared_ptr_new<SAWaveAudioOutput>(mWaveOutputPath, SAMPLE_RATE);
+		else if (device.name == NULL_DEVICE_NAME)
+			output = bs_shared_ptr_new<SANullAudioOutput>();
+		else
+		{
+#if BS_SA_OPENAL
+			SPtr<SAOpenALAudioOutput> openALOutput = bs_shared_ptr_new<SAOpenALAudioOutput>(device.name, SAMPLE_RATE);
+			if (!openALOutput->isValid())
+				return;
+
+			output = openALOutput;
+#else
+			return;
+#endif
+		}
+
+		{
+			Lock lock(mMixerMutex);
+			std::swap(mOutput, output);
+		}
+
+		// Previous output (if any) gets closed here, outside of the lock
+		output = nullptr;
+		mActiveDevice = device;
+	}
+
+	void SAAudio::_registerListener(SAAudioListener* listener)
+	{
+		mListeners.push_back(listener);
+
+		if (mListeners.size() > 1)
+			LOGWRN("Software audio supports only a single audio listener. Only the first listener will be heard.");
+
+		_notifyListenerChanged(listener);
+	}
+
+	void SAAudio::_unregisterListener(SAAudioListener* listener)
+	{
+		auto iterFind = std::find(mListeners.begin(), mListeners.end(), listener);
+		if (iterFind != mListeners.end())
+			mListeners.erase(iterFind);
+
+		if (!mListeners.empty())
+			_notifyListenerChanged(mListeners[0]);
+	}
+
+	void SAAudio::_notifyListenerChanged(SAAudioListener* listener)
+	{
+		if (mListeners.empty() || mListeners[0] != listener)
+			return;
+
+		const Transform& tfrm = listener->getTransform();
+
+		SAListenerProperties props;
+		props.position = tfrm.getPosition();
+		props.right = tfrm.getRight();
+		props.velocity = listener->getVelocity();
+
+		mMixer.setListener(props);
+	}
+
+	void SAAudio::_registerStream(const SPtr<SAStream>& stream)
+	{
+		Lock lock(mStreamMutex);
+		mStreams.push_back(stream);
+	}
+
+	void SAAudio::_unregisterStream(const SPtr<SAStream>& stream)
+	{
+		Lock lock(mStreamMutex);
+
+		auto iterFind = std::find(mStreams.begin(), mStreams.end(), stream);
+		if (iterFind != mStreams.end())
+			mStreams.erase(iterFind);
+	}
+
+	void SAAudio::_update()
+	{
+		// If previous task still hasn't completed, just skip streaming this frame, queuing more tasks won't help
+		if (mStreamingTask == nullptr || mStreamingTask->isComplete())
+		{
+			mStreamingTask = Task::create("AudioStream", std::bind(&SAAudio::updateStreaming, this),
+				TaskPriority::VeryHigh);
+			TaskScheduler::instance().addTask(mStreamingTask);
+		}
+
+		// Sample buffers the mixer stopped using are released here, rather than on the mixer thread
+		mMixer.releaseAppliedCommands();
+
+		Audio::_update();
+	}
+
+	void SAAudio::updateStreaming()
+	{
+		// Streams are filled outside of the lock, so sources can be created and destroyed while decoding is in progress
+		{
+			Lock lock(mStreamMutex);
+			mActiveStreams = mStreams;
+		}
+
+		for (auto& stream : mActiveStreams)
+			stream->fill();
+
+		mActiveStreams.clear();
+	}
+
+	SPtr<AudioClip> SAAudio::createClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples,
+		const AUDIO_CLIP_DESC& desc)
+	{
+		return bs_core_ptr_new<SAAudioClip>(samples, streamSize, numSamples, desc);
+	}
+
+	SPtr<AudioListener> SAAudio::createListener()
+	{
+		return bs_shared_ptr_new<SAAudioListener>();
+	}
+
+	SPtr<AudioSource> SAAudio::createSource()
+	{
+		return bs_shared_ptr_new<SAAudioSource>();
+	}
+
+	void SAAudio::runMixer()
+	{
+		using Clock = std::chrono::steady_clock;
+
+		const auto blockDuration = std::chrono::duration_cast<Clock::duration>(
+			std::chrono::duration<double>((double)BLOCK_SIZE / SAMPLE_RATE));
+
+		Vector<float> buffer(BLOCK_SIZE * SAMixer::NUM_OUTPUT_CHANNELS);
+		auto nextBlock = Clock::now();
+
+		while (true)
+		{
+			mMixer.mix(buffer.data(), BLOCK_SIZE);
+
+			Lock lock(mMixerMutex);
+			if (mShutdown)
+				break;
+
+			mOutput->write(buffer.data(), BLOCK_SIZE);
+
+			// Outputs that wait until they're ready for more data pace the mixer on their own
+			if (mOutput->isBlocking())
+			{
+				nextBlock = Clock::now();
+				continue;
+			}
+
+			// Keep to real time. If mixing fell behind don't try to catch up, just continue from now.
+			nextBlock += blockDuration;
+
+			auto now = Clock::now();
+			if (nextBlock < now)
+				nextBlock = now;
+
+			mMixerSignal.wait_until(lock, nextBlock, [this]() { return mShutdown; });
+			if (mShutdown)
+				break;
+		}
+	}
+
+	SAAudio& gSAAudio()
+	{
+		return static_cast<SAAudio&>(SAAudio::instance());
+	}
+}
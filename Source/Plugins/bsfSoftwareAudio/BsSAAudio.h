@@ -0,0 +1,141 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSAPrerequisites.h"
+#include "Audio/BsAudio.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "BsSAMixer.h"
+
+namespace bs
+{
+	/** @addtogroup SoftwareAudio
+	 *  @{
+	 */
+
+	/**
+	 * Global manager for the audio implementation that mixes all audio in software. Mixing happens on a dedicated thread
+	 * in fixed size blocks, paced to real time, and is sent to the output of the active device. Streamed clips are
+	 * decoded ahead of the mixer on a worker thread, once per frame.
+	 *
+	 * Available devices are all OpenAL playback devices (if built with OpenAL), "Null", which discards the output, and
+	 * "Wave File", which records it to the path set by setWaveOutputPath(). The default device is the default OpenAL
+	 * device, or "Null" if there is none.
+	 */
+	class SAAudio : public Audio
+	{
+	public:
+		/** Sample rate of the mixed output. */
+		static constexpr UINT32 SAMPLE_RATE = 48000;
+
+		/** Number of frames mixed at once. */
+		static constexpr UINT32 BLOCK_SIZE = 512;
+
+		SAAudio();
+		virtual ~SAAudio();
+
+		/** @copydoc Audio::setVolume */
+		void setVolume(float volume) override;
+
+		/** @copydoc Audio::getVolume */
+		float getVolume() const override { return mVolume; }
+
+		/** @copydoc Audio::setPaused */
+		void setPaused(bool paused) override;
+
+		/** @copydoc Audio::isPaused */
+		bool isPaused() const override { return mIsPaused; }
+
+		/** @copydoc Audio::setActiveDevice */
+		void setActiveDevice(const AudioDevice& device) override;
+
+		/** @copydoc Audio::getActiveDevice */
+		AudioDevice getActiveDevice() const override { return mActiveDevice; }
+
+		/** @copydoc Audio::getDefaultDevice */
+		AudioDevice getDefaultDevice() const override { return mDefaultDevice; }
+
+		/** @copydoc Audio::getAllDevices */
+		const Vector<AudioDevice>& getAllDevices() const override { return mAllDevices; };
+
+		/** @copydoc Audio::_update */
+		void _update() override;
+
+		/**
+		 * Sets the path of the file the "Wave File" device records to. Takes effect the next time the device is
+		 * activated.
+		 */
+		void setWaveOutputPath(const Path& path) { mWaveOutputPath = path; }
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Returns the mixer all audio sources play through. */
+		SAMixer& _getMixer() { return mMixer; }
+
+		/** Registers a new AudioListener. Should be called on listener creation. */
+		void _registerListener(SAAudioListener* listener);
+
+		/** Unregisters an existing AudioListener. Should be called before listener destruction. */
+		void _unregisterListener(SAAudioListener* listener);
+
+		/** Notifies the mixer that properties of a listener changed. Only the first registered listener is heard. */
+		void _notifyListenerChanged(SAAudioListener* listener);
+
+		/** Registers a stream to be filled by the streaming worker. */
+		void _registerStream(const SPtr<SAStream>& stream);
+
+		/** Unregisters a stream previously registered with _registerStream(). */
+		void _unregisterStream(const SPtr<SAStream>& stream);
+
+		/** @} */
+
+	private:
+		/** @copydoc Audio::createClip */
+		SPtr<AudioClip> createClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples,
+			const AUDIO_CLIP_DESC& desc) override;
+
+		/** @copydoc Audio::createListener */
+		SPtr<AudioListener> createListener() override;
+
+		/** @copydoc Audio::createSource */
+		SPtr<AudioSource> createSource() override;
+
+		/** Main loop of the mixer thread. */
+		void runMixer();
+
+		/** Decodes data ahead of the mixer for all registered streams. */
+		void updateStreaming();
+
+		float mVolume = 1.0f;
+		bool mIsPaused = false;
+
+		SAMixer mMixer;
+		Vector<SAAudioListener*> mListeners;
+
+		Vector<AudioDevice> mAllDevices;
+		AudioDevice mDefaultDevice;
+		AudioDevice mActiveDevice;
+		Path mWaveOutputPath = "AudioOutput.wav";
+
+		// Mixer thread
+		HThread mMixerThread;
+		SPtr<SAAudioOutput> mOutput;
+		bool mShutdown = false;
+		Mutex mMixerMutex;
+		Signal mMixerSignal;
+
+		// Streaming
+		Vector<SPtr<SAStream>> mStreams;
+		Vector<SPtr<SAStream>> mActiveStreams;
+		SPtr<Task> mStreamingTask;
+		Mutex mStreamMutex;
+	};
+
+	/** Provides easier access to SAAudio. */
+	SAAudio& gSAAudio();
+
+	/** @} */
+}
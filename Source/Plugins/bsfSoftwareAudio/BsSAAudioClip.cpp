@@ -0,0 +1,255 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAAudioClip.h"
+#include "BsSAMixer.h"
+#include "BsOggVorbisDecoder.h"
+#include "Audio/BsAudioUtility.h"
+#include "FileSystem/BsDataStream.h"
+
+namespace bs
+{
+	SAAudioClip::SAAudioClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples, const AUDIO_CLIP_DESC& desc)
+		:AudioClip(samples, streamSize, numSamples, desc)
+	{ }
+
+	void SAAudioClip::initialize()
+	{
+		{
+			Lock lock(mMutex); // Needs to be called even if stream data is null, to ensure memory fence is added so the
+							   // other thread sees properly initialized AudioClip members
+
+			AudioDataInfo info;
+			info.bitDepth = mDesc.bitDepth;
+			info.numChannels = mDesc.numChannels;
+			info.numSamples = mNumSamples;
+			info.sampleRate = mDesc.frequency;
+
+			// If we need to keep source data, read everything into memory and keep a copy
+			if (mKeepSourceData && mStreamData != nullptr)
+			{
+				mStreamData->seek(mStreamOffset);
+
+				UINT8* sampleBuffer = (UINT8*)bs_alloc(mStreamSize);
+				mStreamData->read(sampleBuffer, mStreamSize);
+
+				mSourceStreamData = bs_shared_ptr_new<MemoryDataStream>(sampleBuffer, mStreamSize);
+				mSourceStreamSize = mStreamSize;
+			}
+
+			// Uncompressed data gains nothing from streaming when it's kept in memory anyway
+			bool loadDecompressed =
+				mDesc.readMode == AudioReadMode::LoadDecompressed ||
+				(mDesc.readMode == AudioReadMode::LoadCompressed && mDesc.format == AudioFormat::PCM);
+
+			if (mStreamData != nullptr && info.numSamples > 0)
+			{
+				if (loadDecompressed)
+					loadSamples(info);
+				else
+					startStreaming(info);
+			}
+
+			if (!mIsStreamed)
+			{
+				mStreamData = nullptr;
+				mStreamOffset = 0;
+				mStreamSize = 0;
+			}
+		}
+
+		AudioClip::initialize();
+	}
+
+	void SAAudioClip::loadSamples(AudioDataInfo info)
+	{
+		SPtr<DataStream> stream;
+		UINT32 offset = 0;
+		if (mSourceStreamData != nullptr) // If it's already loaded in memory, use it directly
+			stream = mSourceStreamData;
+		else
+		{
+			stream = mStreamData;
+			offset = mStreamOffset;
+		}
+
+		UINT32 bytesPerSample = info.bitDepth / 8;
+		UINT32 bufferSize = info.numSamples * bytesPerSample;
+		UINT8* sampleBuffer = (UINT8*)bs_alloc(bufferSize);
+
+		// Decompress from Ogg
+		if (mDesc.format == AudioFormat::VORBIS)
+		{
+			OggVorbisDecoder reader;
+			if (reader.open(stream, info, offset))
+				reader.read(sampleBuffer, info.numSamples);
+			else
+				LOGERR("Failed decompressing AudioClip stream.");
+		}
+		// Load directly
+		else
+		{
+			stream->seek(offset);
+			stream->read(sampleBuffer, bufferSize);
+		}
+
+		// Mixer only handles mono and stereo sources
+		if (info.numChannels > 2)
+		{
+			UINT32 numMonoSamples = info.numSamples / info.numChannels;
+			UINT8* monoBuffer = (UINT8*)bs_alloc(numMonoSamples * bytesPerSample);
+
+			AudioUtility::convertToMono(sampleBuffer, monoBuffer, info.bitDepth, numMonoSamples, info.numChannels,
+				AudioConversionMode::Parallel);
+			bs_free(sampleBuffer);
+
+			sampleBuffer = monoBuffer;
+			info.numSamples = numMonoSamples;
+			info.numChannels = 1;
+		}
+
+		mSampleBuffer = bs_shared_ptr_new<SASampleBuffer>();
+		mSampleBuffer->numChannels = info.numChannels;
+		mSampleBuffer->numFrames = info.numSamples / info.numChannels;
+		mSampleBuffer->sampleRate = info.sampleRate;
+
+		// Clips not meant to be kept decompressed in memory are usually long, so they're stored at half the size and
+		// converted by the mixer as they play
+		if (mDesc.readMode != AudioReadMode::LoadDecompressed)
+		{
+			mSampleBuffer->samples16.resize(info.numSamples);
+			UINT8* output = (UINT8*)mSampleBuffer->samples16.data();
+
+			if (info.bitDepth == 16)
+				memcpy(output, sampleBuffer, info.numSamples * sizeof(INT16));
+			else
+			{
+				AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, output, 16, info.numSamples,
+					AudioConversionMode::Parallel);
+			}
+		}
+		else
+		{
+			mSampleBuffer->samples.resize(info.numSamples);
+			AudioUtility::convertToFloat(sampleBuffer, info.bitDepth, mSampleBuffer->samples.data(),
+				info.numSamples, AudioConversionMode::Parallel);
+		}
+
+		bs_free(sampleBuffer);
+	}
+
+	void SAAudioClip::startStreaming(AudioDataInfo info)
+	{
+		// Compressed data is decoded from memory, so if reading from file make a copy of it (unless one already exists)
+		if (mDesc.readMode == AudioReadMode::LoadCompressed && mStreamData->isFile())
+		{
+			if (mSourceStreamData != nullptr)
+				mStreamData = mSourceStreamData;
+			else
+			{
+				UINT8* data = (UINT8*)bs_alloc(mStreamSize);
+
+				mStreamData->seek(mStreamOffset);
+				mStreamData->read(data, mStreamSize);
+
+				mStreamData = bs_shared_ptr_new<MemoryDataStream>(data, mStreamSize);
+			}
+
+			mStreamOffset = 0;
+		}
+
+		if (mDesc.format == AudioFormat::VORBIS)
+		{
+			if (!mVorbisReader.open(mStreamData, info, mStreamOffset))
+			{
+				LOGERR("Failed decompressing AudioClip stream.");
+				return;
+			}
+
+			mNeedsDecompression = true;
+		}
+
+		mIsStreamed = true;
+		mStreamInfo = info;
+
+		// Clips with more than two channels are down-mixed to mono as they're decoded
+		mSampleBuffer = bs_shared_ptr_new<SASampleBuffer>();
+		mSampleBuffer->numChannels = info.numChannels > 2 ? 1 : info.numChannels;
+		mSampleBuffer->numFrames = info.numSamples / info.numChannels;
+		mSampleBuffer->sampleRate = info.sampleRate;
+	}
+
+	SPtr<const SASampleBuffer> SAAudioClip::_getSampleBuffer() const
+	{
+		Lock lock(mMutex);
+		return mSampleBuffer;
+	}
+
+	SPtr<SAStream> SAAudioClip::_createStream()
+	{
+		Lock lock(mMutex);
+
+		if (!mIsStreamed)
+			return nullptr;
+
+		SPtr<SAAudioClip> thisPtr = std::static_pointer_cast<SAAudioClip>(getThisPtr());
+		return bs_shared_ptr_new<SAStream>(thisPtr, mSampleBuffer->numChannels, mSampleBuffer->numFrames);
+	}
+
+	void SAAudioClip::readStreamFrames(INT16* output, UINT32 offset, UINT32 numFrames) const
+	{
+		Lock lock(mMutex);
+
+		const UINT32 numChannels = mStreamInfo.numChannels;
+		const UINT32 bitDepth = mStreamInfo.bitDepth;
+		const UINT32 numSamples = numFrames * numChannels;
+		const UINT32 size = numSamples * (bitDepth / 8);
+
+		if (mStreamBuffer.size() < size)
+			mStreamBuffer.resize(size);
+
+		UINT8* samples = mStreamBuffer.data();
+		if (mNeedsDecompression)
+		{
+			// Seeking requires the decoder to re-synchronize, skip it when continuing from the previous read
+			if (offset != mNextStreamFrame)
+				mVorbisReader.seek(offset * numChannels);
+
+			mVorbisReader.read(samples, numSamples);
+		}
+		else
+		{
+			mStreamData->seek(mStreamOffset + offset * numChannels * (bitDepth / 8));
+			mStreamData->read(samples, size);
+		}
+
+		mNextStreamFrame = offset + numFrames;
+
+		UINT32 numOutputSamples = numSamples;
+		if (numChannels > 2)
+		{
+			const UINT32 monoSize = numFrames * (bitDepth / 8);
+			if (mMonoBuffer.size() < monoSize)
+				mMonoBuffer.resize(monoSize);
+
+			AudioUtility::convertToMono(samples, mMonoBuffer.data(), bitDepth, numFrames, numChannels);
+
+			samples = mMonoBuffer.data();
+			numOutputSamples = numFrames;
+		}
+
+		if (bitDepth == 16)
+			memcpy(output, samples, numOutputSamples * sizeof(INT16));
+		else
+			AudioUtility::convertBitDepth(samples, bitDepth, (UINT8*)output, 16, numOutputSamples);
+	}
+
+	SPtr<DataStream> SAAudioClip::getSourceStream(UINT32& size)
+	{
+		Lock lock(mMutex);
+
+		size = mSourceStreamSize;
+		mSourceStreamData->seek(0);
+
+		return mSourceStreamData;
+	}
+}
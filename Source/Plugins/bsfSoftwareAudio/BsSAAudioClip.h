@@ -0,0 +1,77 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSAPrerequisites.h"
+#include "BsSAStream.h"
+#include "Audio/BsAudioClip.h"
+#include "BsOggVorbisDecoder.h"
+
+namespace bs
+{
+	/** @addtogroup SoftwareAudio
+	 *  @{
+	 */
+
+	/**
+	 * Software audio implementation of an AudioClip. Clips using AudioReadMode::LoadDecompressed are fully decoded on
+	 * initialization and stored as floating point samples, so the mixer can read them without any further conversion.
+	 * Uncompressed clips using AudioReadMode::LoadCompressed are stored as 16-bit samples instead, halving their memory
+	 * use. All other clips are streamed: each playing source decodes them block by block, through its own SAStream.
+	 */
+	class SAAudioClip : public AudioClip, public SAStreamSource
+	{
+	public:
+		SAAudioClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples, const AUDIO_CLIP_DESC& desc);
+		virtual ~SAAudioClip() = default;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Returns the samples of the clip, or null if the clip has no audio data. Buffers of streamed clips only describe
+		 * the format of the data.
+		 */
+		SPtr<const SASampleBuffer> _getSampleBuffer() const;
+
+		/** Creates a new stream to play the clip through. Returns null if the clip isn't streamed. */
+		SPtr<SAStream> _createStream();
+
+		/** @copydoc SAStreamSource::readStreamFrames */
+		void readStreamFrames(INT16* output, UINT32 offset, UINT32 numFrames) const override;
+
+		/** @} */
+	protected:
+		/** @copydoc Resource::initialize */
+		void initialize() override;
+
+		/** @copydoc AudioClip::getSourceStream */
+		SPtr<DataStream> getSourceStream(UINT32& size) override;
+	private:
+		/** Decodes all of the clip's data into the sample buffer. Caller must hold the lock. */
+		void loadSamples(AudioDataInfo info);
+
+		/** Prepares the clip's data for decoding as it plays. Caller must hold the lock. */
+		void startStreaming(AudioDataInfo info);
+
+		mutable Mutex mMutex;
+		SPtr<SASampleBuffer> mSampleBuffer;
+
+		// Streaming
+		bool mIsStreamed = false;
+		bool mNeedsDecompression = false;
+		AudioDataInfo mStreamInfo;
+		mutable OggVorbisDecoder mVorbisReader;
+		mutable UINT32 mNextStreamFrame = 0;
+		mutable Vector<UINT8> mStreamBuffer;
+		mutable Vector<UINT8> mMonoBuffer;
+
+		// These streams exist to save original audio data in case it's needed later (usually for saving with the editor, or
+		// manual data manipulation). In normal usage (in-game) these will be null so no memory is wasted.
+		SPtr<DataStream> mSourceStreamData;
+		UINT32 mSourceStreamSize = 0;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,29 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAAudioListener.h"
+#include "BsSAAudio.h"
+
+namespace bs
+{
+	SAAudioListener::SAAudioListener()
+	{
+		gSAAudio()._registerListener(this);
+	}
+
+	SAAudioListener::~SAAudioListener()
+	{
+		gSAAudio()._unregisterListener(this);
+	}
+
+	void SAAudioListener::setTransform(const Transform& transform)
+	{
+		AudioListener::setTransform(transform);
+		gSAAudio()._notifyListenerChanged(this);
+	}
+
+	void SAAudioListener::setVelocity(const Vector3& velocity)
+	{
+		AudioListener::setVelocity(velocity);
+		gSAAudio()._notifyListenerChanged(this);
+	}
+}
@@ -0,0 +1,29 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSAPrerequisites.h"
+#include "Audio/BsAudioListener.h"
+
+namespace bs
+{
+	/** @addtogroup SoftwareAudio
+	 *  @{
+	 */
+
+	/** Software audio implementation of an AudioListener. */
+	class SAAudioListener : public AudioListener
+	{
+	public:
+		SAAudioListener();
+		virtual ~SAAudioListener();
+
+		/** @copydoc SceneActor::setTransform */
+		void setTransform(const Transform& transform) override;
+
+		/** @copydoc AudioListener::setVelocity */
+		void setVelocity(const Vector3& velocity) override;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,200 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAAudioOutput.h"
+#include "BsSAMixer.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+
+#if BS_SA_OPENAL
+#include "AL/al.h"
+#endif
+
+namespace bs
+{
+	/** Size of the RIFF, fmt and data chunk headers of a PCM wave file. */
+	static constexpr UINT32 WAVE_HEADER_SIZE = 44;
+
+	SAWaveAudioOutput::SAWaveAudioOutput(const Path& path, UINT32 sampleRate)
+		:mSampleRate(sampleRate)
+	{
+		mStream = FileSystem::createAndOpenFile(path);
+		if (mStream == nullptr)
+		{
+			LOGERR("Unable to open \"" + path.toString() + "\" for audio output.");
+			return;
+		}
+
+		// Sizes are unknown until the output is closed, header is rewritten at that point
+		writeHeader();
+	}
+
+	SAWaveAudioOutput::~SAWaveAudioOutput()
+	{
+		if (mStream == nullptr)
+			return;
+
+		mStream->seek(0);
+		writeHeader();
+		mStream->close();
+	}
+
+	void SAWaveAudioOutput::write(const float* samples, UINT32 numFrames)
+	{
+		if (mStream == nullptr)
+			return;
+
+		UINT32 numSamples = numFrames * SAMixer::NUM_OUTPUT_CHANNELS;
+		if (mConversionBuffer.size() < numSamples)
+			mConversionBuffer.resize(numSamples);
+
+		SAMixer::convertToInt16(samples, mConversionBuffer.data(), numSamples);
+
+		UINT32 size = numSamples * sizeof(INT16);
+		mStream->write(mConversionBuffer.data(), size);
+		mDataSize += size;
+	}
+
+	void SAWaveAudioOutput::writeHeader()
+	{
+		const UINT16 numChannels = (UINT16)SAMixer::NUM_OUTPUT_CHANNELS;
+		const UINT16 bitDepth = 16;
+		const UINT16 blockAlign = numChannels * (bitDepth / 8);
+		const UINT32 byteRate = mSampleRate * blockAlign;
+		const UINT16 format = 1; // PCM
+		const UINT32 formatSize = 16;
+		const UINT32 riffSize = WAVE_HEADER_SIZE - 8 + mDataSize;
+
+		mStream->write("RIFF", 4);
+		mStream->write(&riffSize, sizeof(riffSize));
+		mStream->write("WAVE", 4);
+
+		mStream->write("fmt ", 4);
+		mStream->write(&formatSize, sizeof(formatSize));
+		mStream->write(&format, sizeof(format));
+		mStream->write(&numChannels, sizeof(numChannels));
+		mStream->write(&mSampleRate, sizeof(mSampleRate));
+		mStream->write(&byteRate, sizeof(byteRate));
+		mStream->write(&blockAlign, sizeof(blockAlign));
+		mStream->write(&bitDepth, sizeof(bitDepth));
+
+		mStream->write("data", 4);
+		mStream->write(&mDataSize, sizeof(mDataSize));
+	}
+
+#if BS_SA_OPENAL
+	/** Maximum time to wait for an OpenAL device to finish playing a queued block, in milliseconds. */
+	static constexpr UINT32 MAX_WAIT_MS = 100;
+
+	SAOpenALAudioOutput::SAOpenALAudioOutput(const String& deviceName, UINT32 sampleRate)
+		:mSampleRate(sampleRate)
+	{
+		mDevice = alcOpenDevice(deviceName.empty() ? nullptr : deviceName.c_str());
+		if (mDevice == nullptr)
+		{
+			LOGERR("Failed to open OpenAL device: " + deviceName);
+			return;
+		}
+
+		mContext = alcCreateContext(mDevice, nullptr);
+		if (mContext == nullptr)
+		{
+			LOGERR("Failed to create OpenAL context for device: " + deviceName);
+
+			alcCloseDevice(mDevice);
+			mDevice = nullptr;
+			return;
+		}
+
+		// All output goes through a single source, so the context can remain current for all threads
+		alcMakeContextCurrent(mContext);
+
+		alGenSources(1, &mSource);
+		alSourcei(mSource, AL_SOURCE_RELATIVE, AL_TRUE);
+		alGenBuffers(NUM_BUFFERS, mBuffers);
+	}
+
+	SAOpenALAudioOutput::~SAOpenALAudioOutput()
+	{
+		if (mContext == nullptr)
+			return;
+
+		alSourceStop(mSource);
+		alSourcei(mSource, AL_BUFFER, 0);
+		alDeleteSources(1, &mSource);
+		alDeleteBuffers(NUM_BUFFERS, mBuffers);
+
+		alcMakeContextCurrent(nullptr);
+		alcDestroyContext(mContext);
+		alcCloseDevice(mDevice);
+	}
+
+	void SAOpenALAudioOutput::write(const float* samples, UINT32 numFrames)
+	{
+		if (mContext == nullptr)
+			return;
+
+		UINT32 numSamples = numFrames * SAMixer::NUM_OUTPUT_CHANNELS;
+		if (mConversionBuffer.size() < numSamples)
+			mConversionBuffer.resize(numSamples);
+
+		SAMixer::convertToInt16(samples, mConversionBuffer.data(), numSamples);
+
+		// Fill up the queue first, after that wait for the device to finish playing one of the queued blocks
+		UINT32 buffer;
+		if (mNumUsedBuffers < NUM_BUFFERS)
+			buffer = mBuffers[mNumUsedBuffers++];
+		else
+		{
+			UINT32 numWaits = 0;
+			while (true)
+			{
+				ALint numProcessed = 0;
+				alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &numProcessed);
+
+				if (numProcessed > 0)
+					break;
+
+				// Device stopped consuming data (e.g. it got disconnected), drop the block instead of stalling the mixer
+				if (numWaits++ > MAX_WAIT_MS)
+					return;
+
+				BS_THREAD_SLEEP(1);
+			}
+
+			alSourceUnqueueBuffers(mSource, 1, &buffer);
+		}
+
+		alBufferData(buffer, AL_FORMAT_STEREO16, mConversionBuffer.data(), numSamples * sizeof(INT16), mSampleRate);
+		alSourceQueueBuffers(mSource, 1, &buffer);
+
+		// Source stops once it runs out of queued data (e.g. if the mixer falls behind), and needs to be restarted
+		ALint state;
+		alGetSourcei(mSource, AL_SOURCE_STATE, &state);
+
+		if (state != AL_PLAYING)
+			alSourcePlay(mSource);
+	}
+
+	void SAOpenALAudioOutput::enumerateDevices(Vector<String>& devices, String& defaultDevice)
+	{
+		if (alcIsExtensionPresent(nullptr, "ALC_ENUMERATE_ALL_EXT") == ALC_FALSE)
+		{
+			devices.push_back(u8"");
+			defaultDevice = u8"";
+			return;
+		}
+
+		defaultDevice = String(alcGetString(nullptr, ALC_DEFAULT_ALL_DEVICES_SPECIFIER));
+
+		// Device names are separated by a null character, and the list is terminated by an additional one
+		const ALCchar* names = alcGetString(nullptr, ALC_ALL_DEVICES_SPECIFIER);
+		while (*names != 0)
+		{
+			String name(names);
+			names += name.size() + 1;
+
+			devices.push_back(name);
+		}
+	}
+#endif
+}
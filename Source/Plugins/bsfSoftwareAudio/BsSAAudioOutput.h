@@ -0,0 +1,105 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSAPrerequisites.h"
+
+#if BS_SA_OPENAL
+#include "AL/alc.h"
+#endif
+
+namespace bs
+{
+	/** @addtogroup SoftwareAudio
+	 *  @{
+	 */
+
+	/** Destination for the audio mixed by SAAudio. Always called from the mixer thread. */
+	class SAAudioOutput
+	{
+	public:
+		virtual ~SAAudioOutput() = default;
+
+		/**
+		 * Outputs a block of mixed audio.
+		 *
+		 * @param[in]	samples		Interleaved stereo samples in [-1, 1] range.
+		 * @param[in]	numFrames	Number of frames in @p samples.
+		 */
+		virtual void write(const float* samples, UINT32 numFrames) = 0;
+
+		/**
+		 * Returns true if write() blocks until the output is ready for more data. The mixer doesn't pace itself to real
+		 * time when writing to such outputs.
+		 */
+		virtual bool isBlocking() const { return false; }
+	};
+
+	/** Output that discards all audio. */
+	class SANullAudioOutput : public SAAudioOutput
+	{
+	public:
+		/** @copydoc SAAudioOutput::write */
+		void write(const float* samples, UINT32 numFrames) override { }
+	};
+
+	/** Output that records all audio into a 16-bit stereo wave file. */
+	class SAWaveAudioOutput : public SAAudioOutput
+	{
+	public:
+		SAWaveAudioOutput(const Path& path, UINT32 sampleRate);
+		~SAWaveAudioOutput();
+
+		/** @copydoc SAAudioOutput::write */
+		void write(const float* samples, UINT32 numFrames) override;
+
+	private:
+		/** Writes the wave file header, with sizes matching the amount of data written so far. */
+		void writeHeader();
+
+		SPtr<DataStream> mStream;
+		UINT32 mSampleRate;
+		UINT32 mDataSize = 0;
+		Vector<INT16> mConversionBuffer;
+	};
+
+#if BS_SA_OPENAL
+	/** Output that plays all audio through an OpenAL playback device. */
+	class SAOpenALAudioOutput : public SAAudioOutput
+	{
+	public:
+		/** Number of blocks queued on the device at once. Determines the output latency. */
+		static constexpr UINT32 NUM_BUFFERS = 4;
+
+		/**
+		 * Opens the OpenAL device with the provided name, or the default device if the name is empty. Check isValid()
+		 * to see if the device was opened.
+		 */
+		SAOpenALAudioOutput(const String& deviceName, UINT32 sampleRate);
+		~SAOpenALAudioOutput();
+
+		/** Returns true if the device was opened successfully. */
+		bool isValid() const { return mContext != nullptr; }
+
+		/** @copydoc SAAudioOutput::write */
+		void write(const float* samples, UINT32 numFrames) override;
+
+		/** @copydoc SAAudioOutput::isBlocking */
+		bool isBlocking() const override { return true; }
+
+		/** Returns the names of all OpenAL playback devices, and the name of the default device. */
+		static void enumerateDevices(Vector<String>& devices, String& defaultDevice);
+
+	private:
+		ALCdevice* mDevice = nullptr;
+		ALCcontext* mContext = nullptr;
+		UINT32 mSource = 0;
+		UINT32 mBuffers[NUM_BUFFERS];
+		UINT32 mNumUsedBuffers = 0;
+		UINT32 mSampleRate;
+		Vector<INT16> mConversionBuffer;
+	};
+#endif
+
+	/** @} */
+}
@@ -0,0 +1,185 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAAudioSource.h"
+#include "BsSAAudio.h"
+#include "BsSAAudioClip.h"
+#include "BsSAStream.h"
+
+namespace bs
+{
+	SAAudioSource::SAAudioSource()
+	{
+		mVoiceId = gSAAudio()._getMixer().createVoice();
+		updateVoice();
+	}
+
+	SAAudioSource::~SAAudioSource()
+	{
+		gSAAudio()._getMixer().destroyVoice(mVoiceId);
+
+		if (mStream != nullptr)
+			gSAAudio()._unregisterStream(mStream);
+	}
+
+	void SAAudioSource::setClip(const HAudioClip& clip)
+	{
+		stop();
+
+		AudioSource::setClip(clip);
+		updateStream();
+		updateVoice();
+	}
+
+	void SAAudioSource::setTransform(const Transform& transform)
+	{
+		AudioSource::setTransform(transform);
+		updateVoice();
+	}
+
+	void SAAudioSource::setVelocity(const Vector3& velocity)
+	{
+		AudioSource::setVelocity(velocity);
+		updateVoice();
+	}
+
+	void SAAudioSource::setVolume(float volume)
+	{
+		AudioSource::setVolume(volume);
+		updateVoice();
+	}
+
+	void SAAudioSource::setPitch(float pitch)
+	{
+		AudioSource::setPitch(pitch);
+		updateVoice();
+	}
+
+	void SAAudioSource::setIsLooping(bool loop)
+	{
+		AudioSource::setIsLooping(loop);
+		updateVoice();
+	}
+
+	void SAAudioSource::setPriority(INT32 priority)
+	{
+		// The mixer has no voice limit, so priority has no effect
+		AudioSource::setPriority(priority);
+	}
+
+	void SAAudioSource::setMinDistance(float distance)
+	{
+		AudioSource::setMinDistance(distance);
+		updateVoice();
+	}
+
+	void SAAudioSource::setAttenuation(float attenuation)
+	{
+		AudioSource::setAttenuation(attenuation);
+		updateVoice();
+	}
+
+	void SAAudioSource::play()
+	{
+		gSAAudio()._getMixer().play(mVoiceId);
+	}
+
+	void SAAudioSource::pause()
+	{
+		gSAAudio()._getMixer().pause(mVoiceId);
+	}
+
+	void SAAudioSource::stop()
+	{
+		gSAAudio()._getMixer().stop(mVoiceId);
+	}
+
+	void SAAudioSource::setTime(float time)
+	{
+		gSAAudio()._getMixer().seek(mVoiceId, time);
+	}
+
+	float SAAudioSource::getTime() const
+	{
+		return gSAAudio()._getMixer().getTime(mVoiceId);
+	}
+
+	AudioSourceState SAAudioSource::getState() const
+	{
+		switch (gSAAudio()._getMixer().getState(mVoiceId))
+		{
+		case SAVoiceState::Playing:
+			return AudioSourceState::Playing;
+		case SAVoiceState::Paused:
+			return AudioSourceState::Paused;
+		default:
+			return AudioSourceState::Stopped;
+		}
+	}
+
+	void SAAudioSource::onClipChanged()
+	{
+		AudioSourceState state = getState();
+		float time = getTime();
+
+		stop();
+		updateStream();
+		updateVoice();
+
+		setTime(time);
+
+		if (state != AudioSourceState::Stopped)
+			play();
+
+		if (state == AudioSourceState::Paused)
+			pause();
+	}
+
+	void SAAudioSource::updateVoice()
+	{
+		SAVoiceProperties props;
+
+		if (mAudioClip.isLoaded())
+		{
+			SAAudioClip* clip = static_cast<SAAudioClip*>(mAudioClip.get());
+			props.buffer = clip->_getSampleBuffer();
+			props.stream = mStream;
+		}
+
+		props.is3D = is3D();
+		props.position = mTransform.getPosition();
+		props.velocity = mVelocity;
+		props.volume = mVolume;
+		props.pitch = mPitch;
+		props.loop = mLoop;
+		props.minDistance = mMinDistance;
+		props.attenuation = mAttenuation;
+
+		gSAAudio()._getMixer().setVoiceProperties(mVoiceId, props);
+	}
+
+	void SAAudioSource::updateStream()
+	{
+		if (mStream != nullptr)
+		{
+			gSAAudio()._unregisterStream(mStream);
+			mStream = nullptr;
+		}
+
+		if (mAudioClip.isLoaded())
+		{
+			SAAudioClip* clip = static_cast<SAAudioClip*>(mAudioClip.get());
+			mStream = clip->_createStream();
+
+			if (mStream != nullptr)
+				gSAAudio()._registerStream(mStream);
+		}
+	}
+
+	bool SAAudioSource::is3D() const
+	{
+		if (!mAudioClip.isLoaded())
+			return true;
+
+		return mAudioClip->is3D();
+	}
+}
@@ -0,0 +1,87 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSAPrerequisites.h"
+#include "Audio/BsAudioSource.h"
+
+namespace bs
+{
+	/** @addtogroup SoftwareAudio
+	 *  @{
+	 */
+
+	/**
+	 * Software audio implementation of an AudioSource. Each source owns a single voice in the SAMixer, and a stream to
+	 * play streamed clips through.
+	 */
+	class SAAudioSource : public AudioSource
+	{
+	public:
+		SAAudioSource();
+		virtual ~SAAudioSource();
+
+		/** @copydoc SceneActor::setTransform */
+		void setTransform(const Transform& transform) override;
+
+		/** @copydoc AudioSource::setClip */
+		void setClip(const HAudioClip& clip) override;
+
+		/** @copydoc AudioSource::setVelocity */
+		void setVelocity(const Vector3& velocity) override;
+
+		/** @copydoc AudioSource::setVolume */
+		void setVolume(float volume) override;
+
+		/** @copydoc AudioSource::setPitch */
+		void setPitch(float pitch) override;
+
+		/** @copydoc AudioSource::setIsLooping */
+		void setIsLooping(bool loop) override;
+
+		/** @copydoc AudioSource::setPriority */
+		void setPriority(INT32 priority) override;
+
+		/** @copydoc AudioSource::setMinDistance */
+		void setMinDistance(float distance) override;
+
+		/** @copydoc AudioSource::setAttenuation */
+		void setAttenuation(float attenuation) override;
+
+		/** @copydoc AudioSource::setTime */
+		void setTime(float time) override;
+
+		/** @copydoc AudioSource::getTime */
+		float getTime() const override;
+
+		/** @copydoc AudioSource::play */
+		void play() override;
+
+		/** @copydoc AudioSource::pause */
+		void pause() override;
+
+		/** @copydoc AudioSource::stop */
+		void stop() override;
+
+		/** @copydoc AudioSource::getState */
+		AudioSourceState getState() const override;
+
+	private:
+		/** @copydoc AudioSource::onClipChanged */
+		void onClipChanged() override;
+
+		/** Sends the current source properties to the mixer. */
+		void updateVoice();
+
+		/** Creates a new stream for the current clip, if it is streamed, replacing the previous one. */
+		void updateStream();
+
+		/** Returns true if the sound source is three dimensional (volume and pitch varies based on listener distance and velocity). */
+		bool is3D() const;
+
+		UINT32 mVoiceId;
+		SPtr<SAStream> mStream;
+	};
+
+	/** @} */
+}
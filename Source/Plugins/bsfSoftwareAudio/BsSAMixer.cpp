@@ -0,0 +1,755 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAMixer.h"
+#include "BsSAStream.h"
+#include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
+#include "Audio/BsAudioUtility.h"
+
+namespace bs
+{
+	SAMixer::SAMixer(UINT32 sampleRate)
+		:mSampleRate(sampleRate), mConversionBuffer(CONVERSION_BUFFER_FRAMES * 2)
+	{
+		mVoices.reserve(INITIAL_VOICE_CAPACITY);
+	}
+
+	UINT32 SAMixer::createVoice()
+	{
+		Lock lock(mMutex);
+
+		UINT32 voiceId;
+		if (!mFreeVoiceIds.empty())
+		{
+			voiceId = mFreeVoiceIds.back();
+			mFreeVoiceIds.pop_back();
+		}
+		else
+		{
+			voiceId = (UINT32)mStatus.size();
+			mStatus.push_back(VoiceStatus());
+
+			// The mixer can't grow its voice storage without allocating, so allocate larger storage for it here
+			if (voiceId >= mVoiceCapacity)
+			{
+				mVoiceCapacity *= 2;
+
+				Vector<Voice> newStorage;
+				newStorage.reserve(mVoiceCapacity);
+
+				mVoiceStorage.swap(newStorage);
+				mHasNewVoiceStorage = true;
+			}
+		}
+
+		VoiceStatus& status = mStatus[voiceId];
+		status.state = SAVoiceState::Stopped;
+		status.time = 0.0f;
+		status.sequence++;
+
+		Command command;
+		command.type = CommandType::Create;
+		command.voiceId = voiceId;
+		command.sequence = status.sequence;
+		command.time = 0.0f;
+
+		queueCommand(command);
+		return voiceId;
+	}
+
+	void SAMixer::destroyVoice(UINT32 voiceId)
+	{
+		Lock lock(mMutex);
+
+		VoiceStatus& status = mStatus[voiceId];
+		status.state = SAVoiceState::Stopped;
+		status.sequence++;
+
+		Command command;
+		command.type = CommandType::Destroy;
+		command.voiceId = voiceId;
+		command.sequence = status.sequence;
+		command.time = 0.0f;
+
+		queueCommand(command);
+		mFreeVoiceIds.push_back(voiceId);
+	}
+
+	void SAMixer::setVoiceProperties(UINT32 voiceId, const SAVoiceProperties& props)
+	{
+		Lock lock(mMutex);
+
+		Command command;
+		command.type = CommandType::SetProperties;
+		command.voiceId = voiceId;
+		command.sequence = mStatus[voiceId].sequence;
+		command.time = 0.0f;
+		command.props = props;
+
+		queueCommand(command);
+	}
+
+	void SAMixer::play(UINT32 voiceId)
+	{
+		queueStateCommand(CommandType::Play, voiceId, SAVoiceState::Playing, -1.0f);
+	}
+
+	void SAMixer::pause(UINT32 voiceId)
+	{
+		SAVoiceState state = getState(voiceId);
+		if (state == SAVoiceState::Stopped)
+			return;
+
+		queueStateCommand(CommandType::Pause, voiceId, SAVoiceState::Paused, -1.0f);
+	}
+
+	void SAMixer::stop(UINT32 voiceId)
+	{
+		queueStateCommand(CommandType::Stop, voiceId, SAVoiceState::Stopped, 0.0f);
+	}
+
+	void SAMixer::seek(UINT32 voiceId, float time)
+	{
+		SAVoiceState state = getState(voiceId);
+		queueStateCommand(CommandType::Seek, voiceId, state, std::max(time, 0.0f));
+	}
+
+	SAVoiceState SAMixer::getState(UINT32 voiceId) const
+	{
+		Lock lock(mMutex);
+		return mStatus[voiceId].state;
+	}
+
+	float SAMixer::getTime(UINT32 voiceId) const
+	{
+		Lock lock(mMutex);
+		return mStatus[voiceId].time;
+	}
+
+	void SAMixer::setListener(const SAListenerProperties& props)
+	{
+		Lock lock(mMutex);
+		mQueuedListener = props;
+	}
+
+	void SAMixer::setVolume(float volume)
+	{
+		Lock lock(mMutex);
+		mQueuedVolume = volume;
+	}
+
+	void SAMixer::setPaused(bool paused)
+	{
+		Lock lock(mMutex);
+		mQueuedPaused = paused;
+	}
+
+	void SAMixer::releaseAppliedCommands()
+	{
+		Lock lock(mMutex);
+		mAppliedCommands.clear();
+
+		// Release storage the mixer moved away from
+		if (!mHasNewVoiceStorage && mVoiceStorage.capacity() > 0)
+			Vector<Voice>().swap(mVoiceStorage);
+	}
+
+	void SAMixer::queueCommand(Command command)
+	{
+		mAppliedCommands.clear();
+		mQueuedCommands.push_back(std::move(command));
+	}
+
+	void SAMixer::queueStateCommand(CommandType type, UINT32 voiceId, SAVoiceState state, float time)
+	{
+		Lock lock(mMutex);
+
+		VoiceStatus& status = mStatus[voiceId];
+		status.state = state;
+		status.sequence++;
+
+		if (time >= 0.0f)
+			status.time = time;
+
+		Command command;
+		command.type = type;
+		command.voiceId = voiceId;
+		command.sequence = status.sequence;
+		command.time = time;
+
+		queueCommand(command);
+	}
+
+	void SAMixer::applyCommands()
+	{
+		{
+			Lock lock(mMutex);
+
+			// Move the voices to larger storage allocated by the simulation thread. Old storage is released there.
+			if (mHasNewVoiceStorage)
+			{
+				for (auto& voice : mVoices)
+					mVoiceStorage.push_back(std::move(voice));
+
+				mVoices.swap(mVoiceStorage);
+				mHasNewVoiceStorage = false;
+			}
+
+			// Commands are only picked up once the simulation thread released the previously applied ones, so there is
+			// always an empty list to hand the applied commands back in
+			if (mAppliedCommands.empty())
+				std::swap(mQueuedCommands, mActiveCommands);
+
+			mListener = mQueuedListener;
+			mVolume = mQueuedVolume;
+			mPaused = mQueuedPaused;
+		}
+
+		for (auto& command : mActiveCommands)
+		{
+			// Storage for the voice was allocated when it was created, so this never allocates
+			if (command.voiceId >= (UINT32)mVoices.size())
+			{
+				assert(command.voiceId < (UINT32)mVoices.capacity());
+				mVoices.resize(command.voiceId + 1);
+			}
+
+			Voice& voice = mVoices[command.voiceId];
+			voice.sequence = command.sequence;
+
+			switch (command.type)
+			{
+			case CommandType::Create:
+			case CommandType::Destroy:
+				// The command holds empty properties, swapping keeps the old ones alive until the command is released
+				std::swap(voice.props, command.props);
+				voice.state = SAVoiceState::Stopped;
+				voice.position = 0.0;
+				voice.hasGain = false;
+				voice.restartStream = true;
+				break;
+			case CommandType::SetProperties:
+				if (voice.props.buffer != command.props.buffer)
+				{
+					voice.position = 0.0;
+					voice.hasGain = false;
+				}
+
+				if (voice.props.stream != command.props.stream || voice.props.loop != command.props.loop)
+					voice.restartStream = true;
+
+				std::swap(voice.props, command.props);
+				break;
+			case CommandType::Play:
+				if (voice.state != SAVoiceState::Playing)
+					voice.hasGain = false;
+
+				voice.state = SAVoiceState::Playing;
+				break;
+			case CommandType::Pause:
+				if (voice.state == SAVoiceState::Playing)
+					voice.state = SAVoiceState::Paused;
+				break;
+			case CommandType::Stop:
+				voice.state = SAVoiceState::Stopped;
+				voice.position = 0.0;
+				voice.restartStream = true;
+				break;
+			case CommandType::Seek:
+				if (voice.props.buffer != nullptr)
+				{
+					const SASampleBuffer& buffer = *voice.props.buffer;
+					voice.position = std::min((double)command.time * buffer.sampleRate, (double)buffer.numFrames);
+					voice.restartStream = true;
+				}
+				break;
+			}
+		}
+
+		if (!mActiveCommands.empty())
+		{
+			Lock lock(mMutex);
+			std::swap(mActiveCommands, mAppliedCommands);
+		}
+	}
+
+	void SAMixer::publishStatus()
+	{
+		Lock lock(mMutex);
+
+		UINT32 numVoices = std::min((UINT32)mVoices.size(), (UINT32)mStatus.size());
+		for (UINT32 i = 0; i < numVoices; i++)
+		{
+			const Voice& voice = mVoices[i];
+			VoiceStatus& status = mStatus[i];
+
+			// Commands were issued after this block started, the status already reflects them
+			if (voice.sequence != status.sequence)
+				continue;
+
+			status.state = voice.state;
+
+			if (voice.props.buffer != nullptr)
+				status.time = (float)(voice.position / voice.props.buffer->sampleRate);
+		}
+	}
+
+	void SAMixer::mix(float* output, UINT32 numFrames)
+	{
+		applyCommands();
+
+		UINT32 numSamples = numFrames * NUM_OUTPUT_CHANNELS;
+		memset(output, 0, numSamples * sizeof(float));
+
+		if (!mPaused)
+		{
+			for (auto& voice : mVoices)
+			{
+				if (voice.state != SAVoiceState::Playing)
+					continue;
+
+				// Buffers of streamed clips have no samples, and can't be played without a stream
+				const SASampleBuffer* buffer = voice.props.buffer.get();
+				const bool hasSamples = buffer != nullptr &&
+					(voice.props.stream != nullptr || !buffer->samples.empty() || !buffer->samples16.empty());
+
+				if (!hasSamples || buffer->numFrames == 0)
+				{
+					voice.state = SAVoiceState::Stopped;
+					continue;
+				}
+
+				mixVoice(voice, output, numFrames);
+			}
+
+			applyVolume(output, numSamples, mVolume);
+		}
+
+		publishStatus();
+	}
+
+	void SAMixer::calculateVoiceParameters(const Voice& voice, float (&gain)[2], double& step) const
+	{
+		const SAVoiceProperties& props = voice.props;
+
+		step = (props.buffer->sampleRate / (double)mSampleRate) * std::max(props.pitch, 0.0f);
+
+		if (!props.is3D)
+		{
+			gain[0] = props.volume;
+			gain[1] = props.volume;
+			return;
+		}
+
+		Vector3 toSource = props.position - mListener.position;
+		float distance = toSource.length();
+
+		// Inverse distance attenuation, clamped so sources closer than the minimum distance play at full volume
+		float volume = props.volume;
+		if (distance > props.minDistance)
+		{
+			float denom = props.minDistance + props.attenuation * (distance - props.minDistance);
+			volume *= props.minDistance / std::max(denom, 1e-4f);
+		}
+
+		float pan = 0.0f;
+		if (distance > 1e-4f)
+		{
+			Vector3 direction = toSource / distance;
+			pan = Math::clamp(direction.dot(mListener.right), -1.0f, 1.0f);
+
+			// Doppler shift, with velocities clamped to keep the pitch finite
+			const float maxSpeed = SPEED_OF_SOUND * 0.5f;
+			float listenerSpeed = Math::clamp(-direction.dot(mListener.velocity), -maxSpeed, maxSpeed);
+			float sourceSpeed = Math::clamp(-direction.dot(props.velocity), -maxSpeed, maxSpeed);
+
+			step *= (SPEED_OF_SOUND - listenerSpeed) / (SPEED_OF_SOUND - sourceSpeed);
+		}
+
+		// Constant power panning
+		float angle = (pan + 1.0f) * 0.5f * Math::HALF_PI;
+		gain[0] = Math::cos(angle) * volume;
+		gain[1] = Math::sin(angle) * volume;
+	}
+
+	void SAMixer::mixVoice(Voice& voice, float* output, UINT32 numFrames)
+	{
+		const SASampleBuffer& buffer = *voice.props.buffer;
+		const float* src = buffer.samples.data();
+		const bool isStereo = buffer.numChannels == 2;
+		const bool isInt16 = !buffer.samples16.empty();
+		const UINT32 lastFrame = buffer.numFrames - 1;
+
+		float target[2];
+		double step;
+		calculateVoiceParameters(voice, target, step);
+
+		if (step <= 0.0)
+			return;
+
+		// Ramp from the gain of the previous block to avoid clicks when volume or panning changes
+		if (!voice.hasGain)
+		{
+			voice.gain[0] = target[0];
+			voice.gain[1] = target[1];
+			voice.hasGain = true;
+		}
+
+		float gain[2] = { voice.gain[0], voice.gain[1] };
+		float gainStep[2] = { (target[0] - gain[0]) / numFrames, (target[1] - gain[1]) / numFrames };
+
+		voice.gain[0] = target[0];
+		voice.gain[1] = target[1];
+
+		if (voice.props.stream != nullptr)
+		{
+			mixStreamedVoice(voice, output, numFrames, step, gain, gainStep);
+			return;
+		}
+
+		UINT32 outFrame = 0;
+		while (outFrame < numFrames)
+		{
+			// Number of frames that can be interpolated without reading past the end of the buffer
+			UINT32 count = 0;
+			if (voice.position < lastFrame)
+			{
+				double available = std::ceil((lastFrame - voice.position) / step);
+				count = (UINT32)std::min(available, (double)(numFrames - outFrame));
+
+				while (count > 0 && voice.position + step * (count - 1) >= lastFrame)
+					count--;
+			}
+
+			if (count > 0)
+			{
+				const float* spanSrc = src;
+				UINT32 firstFrame = 0;
+
+				// Convert the source frames read by the span into floating point, limiting the span so they fit into the
+				// conversion buffer
+				if (isInt16)
+				{
+					UINT32 maxCount = (UINT32)((CONVERSION_BUFFER_FRAMES - 3) / step) + 1;
+					count = std::min(count, maxCount);
+
+					firstFrame = (UINT32)voice.position;
+					UINT32 endFrame = std::min((UINT32)(voice.position + step * (count - 1)) + 2, buffer.numFrames);
+
+					UINT32 offset = firstFrame * buffer.numChannels;
+					UINT32 numSamples = (endFrame - firstFrame) * buffer.numChannels;
+					AudioUtility::convertToFloat((const UINT8*)(buffer.samples16.data() + offset), 16,
+						mConversionBuffer.data(), numSamples);
+
+					spanSrc = mConversionBuffer.data();
+				}
+
+				double position = voice.position - firstFrame;
+
+				float* dst = output + outFrame * NUM_OUTPUT_CHANNELS;
+				if (isStereo)
+					position = mixStereo(spanSrc, position, step, dst, count, gain, gainStep);
+				else
+					position = mixMono(spanSrc, position, step, dst, count, gain, gainStep);
+
+				voice.position = position + firstFrame;
+
+				gain[0] += gainStep[0] * count;
+				gain[1] += gainStep[1] * count;
+				outFrame += count;
+			}
+			else if (voice.position < buffer.numFrames)
+			{
+				// Last frame of the buffer, interpolate towards the start when looping or towards silence otherwise
+				UINT32 idx = (UINT32)voice.position;
+				float t = (float)(voice.position - idx);
+
+				float* dst = output + outFrame * NUM_OUTPUT_CHANNELS;
+				for (UINT32 i = 0; i < NUM_OUTPUT_CHANNELS; i++)
+				{
+					UINT32 channel = isStereo ? i : 0;
+
+					float a = buffer.getSample(idx * buffer.numChannels + channel);
+					float b = voice.props.loop ? buffer.getSample(channel) : 0.0f;
+
+					dst[i] += (a + (b - a) * t) * gain[i];
+				}
+
+				gain[0] += gainStep[0];
+				gain[1] += gainStep[1];
+				voice.position += step;
+				outFrame++;
+			}
+			else if (voice.props.loop)
+				voice.position = std::fmod(voice.position - buffer.numFrames, (double)buffer.numFrames);
+			else
+			{
+				voice.state = SAVoiceState::Stopped;
+				voice.position = 0.0;
+				voice.hasGain = false;
+				break;
+			}
+		}
+	}
+
+	void SAMixer::mixStreamedVoice(Voice& voice, float* output, UINT32 numFrames, double step, float (&gain)[2],
+		const float (&gainStep)[2])
+	{
+		const SASampleBuffer& buffer = *voice.props.buffer;
+		SAStream& stream = *voice.props.stream;
+		const bool isStereo = buffer.numChannels == 2;
+		const bool loop = voice.props.loop;
+
+		if (voice.restartStream)
+		{
+			if (loop)
+				voice.position = std::fmod(voice.position, (double)buffer.numFrames);
+
+			stream.restart((UINT32)voice.position, loop);
+			voice.restartStream = false;
+		}
+
+		UINT32 outFrame = 0;
+		while (outFrame < numFrames)
+		{
+			const UINT32 firstFrame = stream.getFrame();
+			const UINT32 numRead = std::min(stream.getNumAvailable(), CONVERSION_BUFFER_FRAMES - 1);
+			stream.read(mConversionBuffer.data(), numRead);
+
+			// Non-looping stream decoded its last frame, interpolate towards silence past it
+			UINT32 numSrcFrames = numRead;
+			const bool reachedEnd = !loop && firstFrame + numRead >= buffer.numFrames;
+			if (reachedEnd)
+			{
+				memset(mConversionBuffer.data() + numRead * buffer.numChannels, 0, buffer.numChannels * sizeof(float));
+				numSrcFrames++;
+			}
+
+			// Number of frames that can be interpolated without reading past the converted frames
+			double position = voice.position - firstFrame;
+			UINT32 count = 0;
+			if (numSrcFrames > 1 && position < numSrcFrames - 1)
+			{
+				const UINT32 lastFrame = numSrcFrames - 1;
+				double available = std::ceil((lastFrame - position) / step);
+				count = (UINT32)std::min(available, (double)(numFrames - outFrame));
+
+				while (count > 0 && position + step * (count - 1) >= lastFrame)
+					count--;
+			}
+
+			if (count == 0)
+			{
+				if (reachedEnd)
+				{
+					voice.state = SAVoiceState::Stopped;
+					voice.position = 0.0;
+					voice.hasGain = false;
+					voice.restartStream = true;
+				}
+
+				// Otherwise the worker hasn't decoded the following frames yet, the rest of the block stays silent
+				break;
+			}
+
+			float* dst = output + outFrame * NUM_OUTPUT_CHANNELS;
+			if (isStereo)
+				position = mixStereo(mConversionBuffer.data(), position, step, dst, count, gain, gainStep);
+			else
+				position = mixMono(mConversionBuffer.data(), position, step, dst, count, gain, gainStep);
+
+			// Release the frames the play position moved past, so the worker can decode new ones in their place
+			const UINT32 numPassed = std::min((UINT32)position, numRead);
+			stream.consume(numPassed);
+			voice.position = stream.getFrame() + (position - numPassed);
+
+			gain[0] += gainStep[0] * count;
+			gain[1] += gainStep[1] * count;
+			outFrame += count;
+		}
+	}
+
+	double SAMixer::mixMono(const float* src, double position, double step, float* output, UINT32 numFrames,
+		const float (&gain)[2], const float (&gainStep)[2])
+	{
+		using namespace simd;
+
+		// Gains of two consecutive frames, in the same layout as the interleaved output
+		float32x4 gainVec = make_float(gain[0], gain[1], gain[0] + gainStep[0], gain[1] + gainStep[1]);
+		float32x4 gainInc = make_float(gainStep[0] * 2.0f, gainStep[1] * 2.0f, gainStep[0] * 2.0f, gainStep[1] * 2.0f);
+
+		const bool direct = step == 1.0 && position == std::floor(position);
+
+		SIMDPP_ALIGN(16) float cur[4];
+		SIMDPP_ALIGN(16) float next[4];
+		SIMDPP_ALIGN(16) float frac[4];
+
+		UINT32 i = 0;
+		for (; i + 4 <= numFrames; i += 4)
+		{
+			float32x4 samples;
+			if (direct)
+				samples = load_u(src + (UINT32)position + i);
+			else
+			{
+				// Positions are tracked in double precision, only the interpolation itself is vectorized
+				for (UINT32 j = 0; j < 4; j++)
+				{
+					double pos = position + step * (i + j);
+					UINT32 idx = (UINT32)pos;
+
+					cur[j] = src[idx];
+					next[j] = src[idx + 1];
+					frac[j] = (float)(pos - idx);
+				}
+
+				float32x4 a = load(cur);
+				float32x4 b = load(next);
+				float32x4 t = load(frac);
+
+				samples = add(a, mul(sub(b, a), t));
+			}
+
+			float* dst = output + i * 2;
+			float32x4 out0 = load_u(dst);
+			float32x4 out1 = load_u(dst + 4);
+
+			out0 = add(out0, mul(zip4_lo(samples, samples), gainVec));
+			gainVec = add(gainVec, gainInc);
+
+			out1 = add(out1, mul(zip4_hi(samples, samples), gainVec));
+			gainVec = add(gainVec, gainInc);
+
+			store_u(dst, out0);
+			store_u(dst + 4, out1);
+		}
+
+		float gainL = gain[0] + gainStep[0] * i;
+		float gainR = gain[1] + gainStep[1] * i;
+		for (; i < numFrames; i++)
+		{
+			double pos = position + step * i;
+			UINT32 idx = (UINT32)pos;
+			float t = (float)(pos - idx);
+
+			float sample = src[idx] + (src[idx + 1] - src[idx]) * t;
+			output[i * 2 + 0] += sample * gainL;
+			output[i * 2 + 1] += sample * gainR;
+
+			gainL += gainStep[0];
+			gainR += gainStep[1];
+		}
+
+		return position + step * numFrames;
+	}
+
+	double SAMixer::mixStereo(const float* src, double position, double step, float* output, UINT32 numFrames,
+		const float (&gain)[2], const float (&gainStep)[2])
+	{
+		using namespace simd;
+
+		float32x4 gainVec = make_float(gain[0], gain[1], gain[0] + gainStep[0], gain[1] + gainStep[1]);
+		float32x4 gainInc = make_float(gainStep[0] * 2.0f, gainStep[1] * 2.0f, gainStep[0] * 2.0f, gainStep[1] * 2.0f);
+
+		const bool direct = step == 1.0 && position == std::floor(position);
+
+		SIMDPP_ALIGN(16) float cur[4];
+		SIMDPP_ALIGN(16) float next[4];
+		SIMDPP_ALIGN(16) float frac[4];
+
+		UINT32 i = 0;
+		for (; i + 2 <= numFrames; i += 2)
+		{
+			float32x4 samples;
+			if (direct)
+				samples = load_u(src + ((UINT32)position + i) * 2);
+			else
+			{
+				for (UINT32 j = 0; j < 2; j++)
+				{
+					double pos = position + step * (i + j);
+					UINT32 idx = (UINT32)pos;
+					float t = (float)(pos - idx);
+
+					cur[j * 2 + 0] = src[idx * 2 + 0];
+					cur[j * 2 + 1] = src[idx * 2 + 1];
+					next[j * 2 + 0] = src[idx * 2 + 2];
+					next[j * 2 + 1] = src[idx * 2 + 3];
+					frac[j * 2 + 0] = t;
+					frac[j * 2 + 1] = t;
+				}
+
+				float32x4 a = load(cur);
+				float32x4 b = load(next);
+				float32x4 t = load(frac);
+
+				samples = add(a, mul(sub(b, a), t));
+			}
+
+			float* dst = output + i * 2;
+			float32x4 out = load_u(dst);
+			out = add(out, mul(samples, gainVec));
+			gainVec = add(gainVec, gainInc);
+
+			store_u(dst, out);
+		}
+
+		if (i < numFrames)
+		{
+			double pos = position + step * i;
+			UINT32 idx = (UINT32)pos;
+			float t = (float)(pos - idx);
+
+			for (UINT32 j = 0; j < 2; j++)
+			{
+				float sample = src[idx * 2 + j] + (src[idx * 2 + 2 + j] - src[idx * 2 + j]) * t;
+				output[i * 2 + j] += sample * (gain[j] + gainStep[j] * i);
+			}
+		}
+
+		return position + step * numFrames;
+	}
+
+	void SAMixer::applyVolume(float* samples, UINT32 count, float volume)
+	{
+		using namespace simd;
+
+		float32x4 volumeVec = load_splat(&volume);
+		float32x4 minVec = make_float(-1.0f);
+		float32x4 maxVec = make_float(1.0f);
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4 value = load_u(samples + i);
+			value = min(max(mul(value, volumeVec), minVec), maxVec);
+
+			store_u(samples + i, value);
+		}
+
+		for (; i < count; i++)
+			samples[i] = Math::clamp(samples[i] * volume, -1.0f, 1.0f);
+	}
+
+	void SAMixer::convertToInt16(const float* input, INT16* output, UINT32 count)
+	{
+		using namespace simd;
+
+		float32x8 minVec = make_float(-1.0f);
+		float32x8 maxVec = make_float(1.0f);
+		float32x8 scaleVec = make_float(32767.0f);
+
+		UINT32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			float32x8 value = load_u(input + i);
+			value = mul(min(max(value, minVec), maxVec), scaleVec);
+
+			int16x8 converted = to_int16(to_int32(value));
+			store_u(output + i, converted);
+		}
+
+		for (; i < count; i++)
+			output[i] = (INT16)(Math::clamp(input[i], -1.0f, 1.0f) * 32767.0f);
+	}
+}
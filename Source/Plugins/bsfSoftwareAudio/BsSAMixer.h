@@ -0,0 +1,284 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSAPrerequisites.h"
+#include "Math/BsVector3.h"
+
+namespace bs
+{
+	/** @addtogroup SoftwareAudio
+	 *  @{
+	 */
+
+	/**
+	 * Audio data with channel data interleaved. Samples are stored either as floating point values in [-1, 1] range, or
+	 * as 16-bit signed integers at half the memory cost. The mixer converts integer samples to floating point as it plays
+	 * them. Buffers of streamed clips have no samples and only describe the format, the samples are read from the
+	 * SAStream of the voice instead.
+	 */
+	struct SASampleBuffer
+	{
+		/** Returns the sample at the provided index, as a floating point value in [-1, 1] range. */
+		float getSample(UINT32 idx) const
+		{
+			if (!samples16.empty())
+				return samples16[idx] / 32767.0f;
+
+			return samples[idx];
+		}
+
+		Vector<float> samples; /**< Floating point samples. Empty if samples are stored in @p samples16. */
+		Vector<INT16> samples16; /**< 16-bit integer samples. Empty if samples are stored in @p samples. */
+		UINT32 numChannels = 1; /**< Either one or two. */
+		UINT32 numFrames = 0; /**< Number of samples per channel. */
+		UINT32 sampleRate = 44100;
+	};
+
+	/** Parameters of a single voice, as set by its audio source. */
+	struct SAVoiceProperties
+	{
+		SPtr<const SASampleBuffer> buffer;
+		SPtr<SAStream> stream; /**< Set if the samples are streamed instead of being stored in @p buffer. */
+		Vector3 position = Vector3::ZERO;
+		Vector3 velocity = Vector3::ZERO;
+		float volume = 1.0f;
+		float pitch = 1.0f;
+		float minDistance = 1.0f;
+		float attenuation = 1.0f;
+		bool loop = false;
+		bool is3D = false;
+	};
+
+	/** Parameters of the listener all 3D voices are heard from. */
+	struct SAListenerProperties
+	{
+		Vector3 position = Vector3::ZERO;
+		Vector3 right = Vector3::UNIT_X;
+		Vector3 velocity = Vector3::ZERO;
+	};
+
+	/** Playback state of a single voice in SAMixer. */
+	enum class SAVoiceState
+	{
+		Stopped,
+		Playing,
+		Paused
+	};
+
+	/**
+	 * Mixes any number of voices into a single interleaved stereo stream.
+	 *
+	 * Voices are controlled from the simulation thread, while mix() is expected to be called from a dedicated audio
+	 * thread. Commands issued to voices are queued and applied at the start of the next mixed block, so mix() never waits
+	 * on the simulation thread for longer than it takes to swap the queue.
+	 *
+	 * mix() doesn't allocate or free memory. Voice storage is allocated by the simulation thread ahead of time, and
+	 * references to sample buffers and streams that voices stop using are handed back to the simulation thread, which
+	 * releases them when it next queues a command, or calls releaseAppliedCommands().
+	 */
+	class SAMixer
+	{
+	public:
+		/** Number of channels in the output produced by mix(). */
+		static constexpr UINT32 NUM_OUTPUT_CHANNELS = 2;
+
+		/** Speed of sound used for doppler calculations, in meters per second. */
+		static constexpr float SPEED_OF_SOUND = 343.3f;
+
+		/** Maximum number of source frames of a 16-bit buffer converted to floating point at once. */
+		static constexpr UINT32 CONVERSION_BUFFER_FRAMES = 1024;
+
+		/** Number of voices storage is allocated for up front. Storage is doubled whenever more voices are created. */
+		static constexpr UINT32 INITIAL_VOICE_CAPACITY = 64;
+
+		SAMixer(UINT32 sampleRate);
+
+		/** Registers a new voice and returns its identifier. The voice starts out stopped and without a buffer. */
+		UINT32 createVoice();
+
+		/** Destroys a voice previously created with createVoice(). */
+		void destroyVoice(UINT32 voiceId);
+
+		/** Replaces all properties of the voice. Playback position is preserved unless the sample buffer changes. */
+		void setVoiceProperties(UINT32 voiceId, const SAVoiceProperties& props);
+
+		/** Starts or resumes playback of the voice. */
+		void play(UINT32 voiceId);
+
+		/** Pauses playback of the voice, keeping its current position. */
+		void pause(UINT32 voiceId);
+
+		/** Stops playback of the voice and rewinds it to the start. */
+		void stop(UINT32 voiceId);
+
+		/** Moves the playback position of the voice to the provided time, in seconds. */
+		void seek(UINT32 voiceId, float time);
+
+		/** Returns the playback state of the voice, including any commands not yet applied by the mixer. */
+		SAVoiceState getState(UINT32 voiceId) const;
+
+		/** Returns the current playback position of the voice, in seconds. */
+		float getTime(UINT32 voiceId) const;
+
+		/** Updates the listener all 3D voices are heard from. */
+		void setListener(const SAListenerProperties& props);
+
+		/** Sets the volume applied to the final mix. */
+		void setVolume(float volume);
+
+		/** Pauses or resumes all voices. While paused mix() outputs silence and no voice advances. */
+		void setPaused(bool paused);
+
+		/**
+		 * Releases the commands the mixer has already applied, along with any sample buffers and streams the voices
+		 * stopped using because of them. Happens automatically when a command is queued, but should also be called
+		 * regularly from the simulation thread in case no commands are issued for a while.
+		 */
+		void releaseAppliedCommands();
+
+		/** Returns the sample rate of the output stream. */
+		UINT32 getSampleRate() const { return mSampleRate; }
+
+		/**
+		 * Mixes the next block of all playing voices.
+		 *
+		 * @param[out]	output		Buffer to receive @p numFrames interleaved stereo frames.
+		 * @param[in]	numFrames	Number of frames to mix.
+		 */
+		void mix(float* output, UINT32 numFrames);
+
+		/** @name Kernels
+		 *  @{
+		 */
+
+		/**
+		 * Resamples a span of a mono source using linear interpolation and accumulates it into an interleaved stereo
+		 * output, ramping the per-channel gain linearly over the span.
+		 *
+		 * @param[in]		src			Source samples. All samples read by interpolation must be in range, meaning
+		 *								@p position + @p step * (@p numFrames - 1) + 1 must be a valid index.
+		 * @param[in]		position	Position of the first output frame in the source, in source frames.
+		 * @param[in]		step		Distance between two output frames in the source, in source frames.
+		 * @param[in, out]	output		Interleaved stereo output to accumulate to.
+		 * @param[in]		numFrames	Number of frames to output.
+		 * @param[in]		gain		Gain of the left and right channel at the first frame.
+		 * @param[in]		gainStep	Change of gain of the left and right channel per frame.
+		 * @return						Position in the source following the last output frame.
+		 */
+		static double mixMono(const float* src, double position, double step, float* output, UINT32 numFrames,
+			const float (&gain)[2], const float (&gainStep)[2]);
+
+		/** Same as mixMono(), except the source is interleaved stereo. */
+		static double mixStereo(const float* src, double position, double step, float* output, UINT32 numFrames,
+			const float (&gain)[2], const float (&gainStep)[2]);
+
+		/** Multiplies the samples by @p volume and clamps them to [-1, 1] range. */
+		static void applyVolume(float* samples, UINT32 count, float volume);
+
+		/** Converts floating point samples in [-1, 1] range into 16-bit signed integers. Values outside are clamped. */
+		static void convertToInt16(const float* input, INT16* output, UINT32 count);
+
+		/** @} */
+	private:
+		/** Type of a command queued for a voice. */
+		enum class CommandType
+		{
+			Create,
+			Destroy,
+			SetProperties,
+			Play,
+			Pause,
+			Stop,
+			Seek
+		};
+
+		/** Command queued by the simulation thread, applied at the start of the next mixed block. */
+		struct Command
+		{
+			CommandType type;
+			UINT32 voiceId;
+			UINT32 sequence;
+			float time;
+			SAVoiceProperties props;
+		};
+
+		/** Data about a voice, only accessed by the mixing thread. */
+		struct Voice
+		{
+			SAVoiceProperties props;
+			SAVoiceState state = SAVoiceState::Stopped;
+			double position = 0.0;
+			float gain[2] = { 0.0f, 0.0f };
+			bool hasGain = false;
+			bool restartStream = true;
+			UINT32 sequence = 0;
+		};
+
+		/** Information about a voice visible to the simulation thread. */
+		struct VoiceStatus
+		{
+			SAVoiceState state = SAVoiceState::Stopped;
+			float time = 0.0f;
+
+			/**
+			 * Number of state changing commands issued for this voice. The mixer only reports state back once it has
+			 * caught up with all of them, so a fresh play() is not overwritten by a state from an older block.
+			 */
+			UINT32 sequence = 0;
+		};
+
+		/** Queues a command that changes the playback state of a voice, and updates the visible state immediately. */
+		void queueStateCommand(CommandType type, UINT32 voiceId, SAVoiceState state, float time);
+
+		/** Adds a command to the queue, releasing any commands already applied first. Caller must hold the mutex. */
+		void queueCommand(Command command);
+
+		/**
+		 * Applies all commands queued since the last block. Properties replaced by the commands are swapped into the
+		 * commands themselves, so they are released on the simulation thread along with the commands.
+		 */
+		void applyCommands();
+
+		/** Writes state of all voices so it is visible to the simulation thread. */
+		void publishStatus();
+
+		/** Calculates the channel gains and playback rate of a voice, for the current listener. */
+		void calculateVoiceParameters(const Voice& voice, float (&gain)[2], double& step) const;
+
+		/** Mixes the next @p numFrames frames of the voice into the output. */
+		void mixVoice(Voice& voice, float* output, UINT32 numFrames);
+
+		/**
+		 * Mixes the next @p numFrames frames of a voice whose samples are streamed. Any frames not yet decoded by the
+		 * streaming worker are left silent.
+		 */
+		void mixStreamedVoice(Voice& voice, float* output, UINT32 numFrames, double step, float (&gain)[2],
+			const float (&gainStep)[2]);
+
+		UINT32 mSampleRate;
+
+		// Mixer thread only
+		Vector<Voice> mVoices;
+		Vector<float> mConversionBuffer;
+		Vector<Command> mActiveCommands;
+		SAListenerProperties mListener;
+		float mVolume = 1.0f;
+		bool mPaused = false;
+
+		// Shared, guarded by mutex
+		Vector<Command> mQueuedCommands;
+		Vector<Command> mAppliedCommands; /**< Commands applied by the mixer, waiting to be released. */
+		Vector<Voice> mVoiceStorage; /**< Larger voice storage for the mixer to move to, or old storage to release. */
+		bool mHasNewVoiceStorage = false;
+		UINT32 mVoiceCapacity = INITIAL_VOICE_CAPACITY;
+		Vector<VoiceStatus> mStatus;
+		Vector<UINT32> mFreeVoiceIds;
+		SAListenerProperties mQueuedListener;
+		float mQueuedVolume = 1.0f;
+		bool mQueuedPaused = false;
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,47 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAPrerequisites.h"
+#include "Audio/BsAudioManager.h"
+#include "BsSAAudio.h"
+#include "BsOAImporter.h"
+#include "Importer/BsImporter.h"
+
+namespace bs
+{
+	class SAFactory : public AudioFactory
+	{
+	public:
+		void startUp() override
+		{
+			Audio::startUp<SAAudio>();
+		}
+
+		void shutDown() override
+		{
+			Audio::shutDown();
+		}
+	};
+
+	/**	Returns a name of the plugin. */
+	extern "C" BS_PLUGIN_EXPORT const char* getPluginName()
+	{
+		static const char* pluginName = "SoftwareAudio";
+		return pluginName;
+	}
+
+	/**	Entry point to the plugin. Called by the engine when the plugin is loaded. */
+	extern "C" BS_PLUGIN_EXPORT void* loadPlugin()
+	{
+		// Decoding of the source formats is shared with the OpenAudio plugin, only playback differs
+		OAImporter* importer = bs_new<OAImporter>();
+		Importer::instance()._registerAssetImporter(importer);
+
+		return bs_new<SAFactory>();
+	}
+
+	/**	Exit point of the plugin. Called by the engine before the plugin is unloaded. */
+	extern "C" BS_PLUGIN_EXPORT void unloadPlugin(SAFactory* instance)
+	{
+		bs_delete(instance);
+	}
+}
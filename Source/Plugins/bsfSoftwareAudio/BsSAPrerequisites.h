@@ -0,0 +1,34 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+/** Set to 1 by the build if OpenAL is available, in which case its playback devices can be used for output. */
+#ifndef BS_SA_OPENAL
+#define BS_SA_OPENAL 0
+#endif
+
+namespace bs
+{
+	class SAAudio;
+	class SAAudioClip;
+	class SAAudioListener;
+	class SAAudioSource;
+	class SAAudioOutput;
+	class SAMixer;
+	class SAStream;
+	class SAStreamSource;
+	struct SASampleBuffer;
+}
+
+/** @addtogroup Plugins
+ *  @{
+ */
+
+/** @defgroup SoftwareAudio bsfSoftwareAudio
+ *	Audio implementation that performs all mixing in software. Output is sent to an OpenAL device (if OpenAL is
+ *	available), nowhere (useful for servers and automated tests) or into a wave file.
+ */
+
+/** @} */
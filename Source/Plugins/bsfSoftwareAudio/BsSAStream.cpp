@@ -0,0 +1,112 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAStream.h"
+#include "Audio/BsAudioUtility.h"
+
+namespace bs
+{
+	SAStream::SAStream(const SPtr<SAStreamSource>& source, UINT32 numChannels, UINT32 numFrames)
+		:mSource(source), mNumChannels(numChannels), mNumFrames(numFrames), mSamples(CAPACITY * numChannels)
+	{ }
+
+	void SAStream::fill()
+	{
+		const UINT32 requestId = mRequestId.load(std::memory_order_acquire);
+		if (requestId != mProducerRequestId)
+		{
+			mDecodeFrame = mRequestFrame.load(std::memory_order_relaxed);
+			mDecodeLoop = mRequestLoop.load(std::memory_order_relaxed);
+			mProducerRequestId = requestId;
+
+			// Consumer doesn't read or consume while its request is pending, so the tail is stable
+			mHead.store(mTail.load(std::memory_order_acquire), std::memory_order_relaxed);
+			mHandledRequestId.store(requestId, std::memory_order_release);
+		}
+
+		if (mNumFrames == 0)
+			return;
+
+		UINT64 head = mHead.load(std::memory_order_relaxed);
+		while (true)
+		{
+			const UINT64 tail = mTail.load(std::memory_order_acquire);
+			const UINT32 numFree = CAPACITY - (UINT32)(head - tail);
+			if (numFree == 0)
+				break;
+
+			if (mDecodeFrame >= mNumFrames)
+			{
+				if (!mDecodeLoop)
+					break;
+
+				mDecodeFrame = 0;
+			}
+
+			// Decode a single block, without wrapping around the end of the ring or the end of the source
+			const UINT32 ringIdx = (UINT32)(head % CAPACITY);
+			UINT32 count = std::min(numFree, BLOCK_SIZE);
+			count = std::min(count, mNumFrames - mDecodeFrame);
+			count = std::min(count, CAPACITY - ringIdx);
+
+			mSource->readStreamFrames(mSamples.data() + ringIdx * mNumChannels, mDecodeFrame, count);
+
+			head += count;
+			mDecodeFrame += count;
+			mHead.store(head, std::memory_order_release);
+
+			// Anything decoded from now on would be discarded anyway
+			if (mRequestId.load(std::memory_order_relaxed) != mProducerRequestId)
+				break;
+		}
+	}
+
+	void SAStream::restart(UINT32 frame, bool loop)
+	{
+		mFrame = frame;
+		mLoop = loop;
+
+		mRequestFrame.store(frame, std::memory_order_relaxed);
+		mRequestLoop.store(loop, std::memory_order_relaxed);
+		mRequestId.store(mRequestId.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	UINT32 SAStream::getNumAvailable() const
+	{
+		if (mHandledRequestId.load(std::memory_order_acquire) != mRequestId.load(std::memory_order_relaxed))
+			return 0;
+
+		return (UINT32)(mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_relaxed));
+	}
+
+	void SAStream::read(float* output, UINT32 numFrames) const
+	{
+		const UINT64 tail = mTail.load(std::memory_order_relaxed);
+
+		// Frames might wrap around the end of the ring, in which case they are converted in two parts
+		UINT32 ringIdx = (UINT32)(tail % CAPACITY);
+		while (numFrames > 0)
+		{
+			const UINT32 count = std::min(numFrames, CAPACITY - ringIdx);
+			const UINT32 numSamples = count * mNumChannels;
+
+			AudioUtility::convertToFloat((const UINT8*)(mSamples.data() + ringIdx * mNumChannels), 16, output,
+				numSamples);
+
+			output += numSamples;
+			numFrames -= count;
+			ringIdx = 0;
+		}
+	}
+
+	void SAStream::consume(UINT32 numFrames)
+	{
+		if (mNumFrames > 0)
+		{
+			mFrame += numFrames;
+			if (mLoop)
+				mFrame %= mNumFrames;
+		}
+
+		mTail.store(mTail.load(std::memory_order_relaxed) + numFrames, std::memory_order_release);
+	}
+}
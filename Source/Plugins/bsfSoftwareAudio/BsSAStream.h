@@ -0,0 +1,128 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSAPrerequisites.h"
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup SoftwareAudio
+	 *  @{
+	 */
+
+	/** Provides decoded samples to SAStream. Implemented by audio clips whose data gets streamed. */
+	class SAStreamSource
+	{
+	public:
+		virtual ~SAStreamSource() = default;
+
+		/**
+		 * Decodes frames as 16-bit samples, channel data interleaved. Sources with more than two channels must be
+		 * down-mixed to mono.
+		 *
+		 * @param[out]	output		Previously allocated buffer to contain the samples.
+		 * @param[in]	offset		Index of the first frame to decode.
+		 * @param[in]	numFrames	Number of frames to decode.
+		 *
+		 * @note	Must be thread safe, as it gets called from the streaming worker thread.
+		 */
+		virtual void readStreamFrames(INT16* output, UINT32 offset, UINT32 numFrames) const = 0;
+	};
+
+	/**
+	 * Ring buffer of decoded frames following the playback position of a single streamed voice. Frames are decoded in
+	 * blocks by a streaming worker through fill(), while the mixer thread reads and consumes them. Neither side ever
+	 * waits on the other. If the mixer runs out of decoded frames it plays silence until the worker catches up.
+	 *
+	 * Methods are split between the producer (the streaming worker) and the consumer (the mixer). Each side's methods must
+	 * only be called from a single thread at a time.
+	 */
+	class SAStream
+	{
+	public:
+		/** Number of frames the ring buffer holds. */
+		static constexpr UINT32 CAPACITY = 32768;
+
+		/** Maximum number of frames decoded in a single call to the source. */
+		static constexpr UINT32 BLOCK_SIZE = 4096;
+
+		/**
+		 * Creates a new stream.
+		 *
+		 * @param[in]	source		Source to decode the frames from.
+		 * @param[in]	numChannels	Number of channels in the decoded frames. Either one or two.
+		 * @param[in]	numFrames	Total number of frames in the source.
+		 */
+		SAStream(const SPtr<SAStreamSource>& source, UINT32 numChannels, UINT32 numFrames);
+
+		/** @name Producer
+		 *  @{
+		 */
+
+		/** Decodes frames until the ring buffer is full, or the end of a non-looping stream is reached. */
+		void fill();
+
+		/** @} */
+
+		/** @name Consumer
+		 *  @{
+		 */
+
+		/**
+		 * Discards all decoded frames and restarts decoding from the provided frame. No frames are available until the
+		 * producer handles the request.
+		 *
+		 * @param[in]	frame	Frame to restart from.
+		 * @param[in]	loop	If true, decoding wraps around to the start once it reaches the end of the source.
+		 */
+		void restart(UINT32 frame, bool loop);
+
+		/** Returns the number of decoded frames that can be read, following the frame returned by getFrame(). */
+		UINT32 getNumAvailable() const;
+
+		/** Returns the index of the first frame that can be read, in the source. */
+		UINT32 getFrame() const { return mFrame; }
+
+		/**
+		 * Converts decoded frames to floating point samples in [-1, 1] range, channel data interleaved.
+		 *
+		 * @param[out]	output		Buffer to receive the samples.
+		 * @param[in]	numFrames	Number of frames to read, starting with the frame returned by getFrame(). Must not be
+		 *							larger than getNumAvailable().
+		 */
+		void read(float* output, UINT32 numFrames) const;
+
+		/** Releases the first @p numFrames frames, making space for the producer to decode more. */
+		void consume(UINT32 numFrames);
+
+		/** @} */
+
+	private:
+		SPtr<SAStreamSource> mSource;
+		UINT32 mNumChannels;
+		UINT32 mNumFrames;
+		Vector<INT16> mSamples;
+
+		// Ring positions, in frames. Only ever increase, wrapped around the ring on access.
+		std::atomic<UINT64> mHead{0}; // Written by the producer
+		std::atomic<UINT64> mTail{0}; // Written by the consumer
+
+		// Restart requests, handled by the producer on its next fill
+		std::atomic<UINT32> mRequestId{0};
+		std::atomic<UINT32> mRequestFrame{0};
+		std::atomic<bool> mRequestLoop{false};
+		std::atomic<UINT32> mHandledRequestId{0};
+
+		// Producer only
+		UINT32 mDecodeFrame = 0;
+		bool mDecodeLoop = false;
+		UINT32 mProducerRequestId = 0;
+
+		// Consumer only
+		UINT32 mFrame = 0;
+		bool mLoop = false;
+	};
+
+	/** @} */
+}
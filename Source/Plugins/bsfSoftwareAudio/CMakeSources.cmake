@@ -0,0 +1,48 @@
+set(BS_SOFTWAREAUDIO_INC_NOFILTER
+	"BsSAPrerequisites.h"
+	"BsSAMixer.h"
+	"BsSAStream.h"
+	"BsSAAudioOutput.h"
+	"BsSAAudioClip.h"
+	"BsSAAudio.h"
+	"BsSAAudioSource.h"
+	"BsSAAudioListener.h"
+)
+
+set(BS_SOFTWAREAUDIO_SRC_NOFILTER
+	"BsSAPlugin.cpp"
+	"BsSAMixer.cpp"
+	"BsSAStream.cpp"
+	"BsSAAudioOutput.cpp"
+	"BsSAAudioClip.cpp"
+	"BsSAAudio.cpp"
+	"BsSAAudioSource.cpp"
+	"BsSAAudioListener.cpp"
+)
+
+set(BS_SOFTWAREAUDIO_INC_IMPORT
+	"../bsfOpenAudio/BsOAImporter.h"
+	"../bsfOpenAudio/BsWaveDecoder.h"
+	"../bsfOpenAudio/BsOggVorbisDecoder.h"
+	"../bsfOpenAudio/BsFLACDecoder.h"
+	"../bsfOpenAudio/BsAudioDecoder.h"
+	"../bsfOpenAudio/BsOggVorbisEncoder.h"
+)
+
+set(BS_SOFTWAREAUDIO_SRC_IMPORT
+	"../bsfOpenAudio/BsOAImporter.cpp"
+	"../bsfOpenAudio/BsWaveDecoder.cpp"
+	"../bsfOpenAudio/BsOggVorbisDecoder.cpp"
+	"../bsfOpenAudio/BsFLACDecoder.cpp"
+	"../bsfOpenAudio/BsOggVorbisEncoder.cpp"
+)
+
+source_group("" FILES ${BS_SOFTWAREAUDIO_INC_NOFILTER} ${BS_SOFTWAREAUDIO_SRC_NOFILTER})
+source_group("Import" FILES ${BS_SOFTWAREAUDIO_INC_IMPORT} ${BS_SOFTWAREAUDIO_SRC_IMPORT})
+
+set(BS_SOFTWAREAUDIO_SRC
+	${BS_SOFTWAREAUDIO_INC_NOFILTER}
+	${BS_SOFTWAREAUDIO_SRC_NOFILTER}
+	${BS_SOFTWAREAUDIO_INC_IMPORT}
+	${BS_SOFTWAREAUDIO_SRC_IMPORT}
+)
@@ -0,0 +1,485 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSAPrerequisites.h"
+#include "BsSAMixer.h"
+#include "BsSAStream.h"
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+#include "Math/BsMath.h"
+#include "Math/BsRandom.h"
+
+namespace bs
+{
+	/** Scalar version of SAMixer::mixMono() and SAMixer::mixStereo(), for any number of source channels. */
+	void mixReference(const float* src, UINT32 numChannels, double position, double step, float* output,
+		UINT32 numFrames, const float (&gain)[2], const float (&gainStep)[2])
+	{
+		for (UINT32 i = 0; i < numFrames; i++)
+		{
+			double pos = position + step * i;
+			UINT32 idx = (UINT32)pos;
+			float t = (float)(pos - idx);
+
+			for (UINT32 j = 0; j < 2; j++)
+			{
+				UINT32 channel = numChannels == 2 ? j : 0;
+
+				float a = src[idx * numChannels + channel];
+				float b = src[(idx + 1) * numChannels + channel];
+				output[i * 2 + j] += (a + (b - a) * t) * (gain[j] + gainStep[j] * i);
+			}
+		}
+	}
+
+	/** Creates a buffer filled with random samples, all of which are exactly representable as 16-bit integers. */
+	SPtr<SASampleBuffer> createRandomBuffer(Random& random, UINT32 numChannels, UINT32 numFrames, bool int16)
+	{
+		SPtr<SASampleBuffer> buffer = bs_shared_ptr_new<SASampleBuffer>();
+		buffer->numChannels = numChannels;
+		buffer->numFrames = numFrames;
+		buffer->sampleRate = 44100;
+
+		UINT32 numSamples = numFrames * numChannels;
+		if (int16)
+			buffer->samples16.resize(numSamples);
+		else
+			buffer->samples.resize(numSamples);
+
+		for (UINT32 i = 0; i < numSamples; i++)
+		{
+			INT16 value = (INT16)random.getRange(-32767, 32767);
+			if (int16)
+				buffer->samples16[i] = value;
+			else
+				buffer->samples[i] = value / 32767.0f;
+		}
+
+		return buffer;
+	}
+
+	/** Stream source that reads frames from a buffer of 16-bit samples. */
+	class BufferStreamSource : public SAStreamSource
+	{
+	public:
+		BufferStreamSource(const SPtr<SASampleBuffer>& buffer)
+			:mBuffer(buffer)
+		{ }
+
+		/** @copydoc SAStreamSource::readStreamFrames */
+		void readStreamFrames(INT16* output, UINT32 offset, UINT32 numFrames) const override
+		{
+			const UINT32 numChannels = mBuffer->numChannels;
+			memcpy(output, mBuffer->samples16.data() + offset * numChannels, numFrames * numChannels * sizeof(INT16));
+		}
+
+	private:
+		SPtr<SASampleBuffer> mBuffer;
+	};
+
+	class SAMixerTestSuite : public TestSuite
+	{
+	public:
+		SAMixerTestSuite();
+
+	private:
+		void testMixKernels();
+		void testVolumeAndConversion();
+		void testPanning();
+		void testInt16Playback();
+		void testStreamedPlayback();
+		void testBufferRelease();
+	};
+
+	SAMixerTestSuite::SAMixerTestSuite()
+	{
+		BS_ADD_TEST(SAMixerTestSuite::testMixKernels);
+		BS_ADD_TEST(SAMixerTestSuite::testVolumeAndConversion);
+		BS_ADD_TEST(SAMixerTestSuite::testPanning);
+		BS_ADD_TEST(SAMixerTestSuite::testInt16Playback);
+		BS_ADD_TEST(SAMixerTestSuite::testStreamedPlayback);
+		BS_ADD_TEST(SAMixerTestSuite::testBufferRelease);
+	}
+
+	void SAMixerTestSuite::testMixKernels()
+	{
+		// Frame counts exercise both the vectorized loops and their remainders. Integer positions with a step of one take
+		// the direct load path, the rest interpolate.
+		const UINT32 frameCounts[] = { 1, 2, 3, 7, 64, 513 };
+		const double positions[] = { 0.0, 3.0, 2.25 };
+		const double steps[] = { 1.0, 0.5, 1.37, 2.9 };
+
+		// Different gains per channel and different ramps, so swapped channels or ramps show up as errors
+		const float gain[2] = { 0.25f, 0.9f };
+		const float gainStep[2] = { 0.001f, -0.0005f };
+
+		Random random(4321);
+		SPtr<SASampleBuffer> mono = createRandomBuffer(random, 1, 2048, false);
+		SPtr<SASampleBuffer> stereo = createRandomBuffer(random, 2, 2048, false);
+
+		for (auto numFrames : frameCounts)
+		{
+			for (auto position : positions)
+			{
+				for (auto step : steps)
+				{
+					for (UINT32 numChannels = 1; numChannels <= 2; numChannels++)
+					{
+						const float* src = numChannels == 2 ? stereo->samples.data() : mono->samples.data();
+
+						// Kernels accumulate, so start from non-zero output
+						Vector<float> output(numFrames * 2);
+						for (auto& entry : output)
+							entry = random.getUNorm() - 0.5f;
+
+						Vector<float> reference = output;
+						mixReference(src, numChannels, position, step, reference.data(), numFrames, gain, gainStep);
+
+						double end;
+						if (numChannels == 2)
+							end = SAMixer::mixStereo(src, position, step, output.data(), numFrames, gain, gainStep);
+						else
+							end = SAMixer::mixMono(src, position, step, output.data(), numFrames, gain, gainStep);
+
+						BS_TEST_ASSERT(end == position + step * numFrames);
+
+						bool matches = true;
+						for (UINT32 i = 0; i < numFrames * 2; i++)
+							matches &= Math::approxEquals(output[i], reference[i], 1e-5f);
+
+						BS_TEST_ASSERT(matches);
+					}
+				}
+			}
+		}
+	}
+
+	void SAMixerTestSuite::testVolumeAndConversion()
+	{
+		// Values over the range get clipped. Counts exercise both the vectorized loops and their remainders.
+		const float values[] = { -2.0f, -1.0f, -0.75f, -0.5f, -1e-3f, 0.0f, 1e-3f, 0.33f, 0.5f, 1.0f, 1.5f };
+		const UINT32 numValues = sizeof(values) / sizeof(values[0]);
+
+		for (UINT32 count = 1; count <= numValues * 3; count++)
+		{
+			Vector<float> samples(count);
+			for (UINT32 i = 0; i < count; i++)
+				samples[i] = values[i % numValues];
+
+			const float volume = 1.5f;
+			Vector<float> scaled = samples;
+			SAMixer::applyVolume(scaled.data(), count, volume);
+
+			Vector<INT16> converted(count);
+			SAMixer::convertToInt16(samples.data(), converted.data(), count);
+
+			bool matches = true;
+			for (UINT32 i = 0; i < count; i++)
+			{
+				float expected = Math::clamp(samples[i] * volume, -1.0f, 1.0f);
+				matches &= Math::approxEquals(scaled[i], expected, 1e-6f);
+
+				INT16 expectedInt = (INT16)(Math::clamp(samples[i], -1.0f, 1.0f) * 32767.0f);
+				matches &= converted[i] == expectedInt;
+			}
+
+			BS_TEST_ASSERT(matches);
+		}
+	}
+
+	void SAMixerTestSuite::testPanning()
+	{
+		const UINT32 numFrames = 64;
+
+		SPtr<SASampleBuffer> buffer = bs_shared_ptr_new<SASampleBuffer>();
+		buffer->sampleRate = 48000;
+		buffer->numFrames = numFrames * 2;
+		buffer->samples.resize(buffer->numFrames, 0.5f);
+
+		// Source to the front right of the listener, at distance 5. Direction dot right is 0.6.
+		SAVoiceProperties props;
+		props.buffer = buffer;
+		props.is3D = true;
+		props.position = Vector3(3.0f, 0.0f, 4.0f);
+
+		struct TestCase
+		{
+			float volume;
+			float gain[2];
+		};
+
+		// Inverse distance attenuation gives a volume of 1/5, constant power panning gives an angle of 0.4 PI
+		float angle = 1.6f * 0.5f * Math::HALF_PI;
+		TestCase testCases[] =
+		{
+			{ 1.0f, { Math::cos(angle) * 0.2f, Math::sin(angle) * 0.2f } },
+			{ 0.5f, { Math::cos(angle) * 0.1f, Math::sin(angle) * 0.1f } }
+		};
+
+		for (auto& testCase : testCases)
+		{
+			SAMixer mixer(48000);
+
+			props.volume = testCase.volume;
+			UINT32 voiceId = mixer.createVoice();
+			mixer.setVoiceProperties(voiceId, props);
+			mixer.play(voiceId);
+
+			Vector<float> output(numFrames * SAMixer::NUM_OUTPUT_CHANNELS);
+			mixer.mix(output.data(), numFrames);
+
+			bool matches = true;
+			for (UINT32 i = 0; i < numFrames; i++)
+			{
+				matches &= Math::approxEquals(output[i * 2 + 0], 0.5f * testCase.gain[0], 1e-5f);
+				matches &= Math::approxEquals(output[i * 2 + 1], 0.5f * testCase.gain[1], 1e-5f);
+			}
+
+			BS_TEST_ASSERT(matches);
+			BS_TEST_ASSERT(output[1] > output[0]);
+		}
+
+		// Non-3D voices are centered, and the final mix is clipped after master volume is applied
+		{
+			SAMixer mixer(48000);
+			mixer.setVolume(3.0f);
+
+			props.is3D = false;
+			props.volume = 1.0f;
+			UINT32 voiceId = mixer.createVoice();
+			mixer.setVoiceProperties(voiceId, props);
+			mixer.play(voiceId);
+
+			Vector<float> output(numFrames * SAMixer::NUM_OUTPUT_CHANNELS);
+			mixer.mix(output.data(), numFrames);
+
+			bool matches = true;
+			for (auto& entry : output)
+				matches &= entry == 1.0f;
+
+			BS_TEST_ASSERT(matches);
+		}
+	}
+
+	void SAMixerTestSuite::testInt16Playback()
+	{
+		// Long enough to be converted in multiple spans, and played past its end so it loops
+		const UINT32 numFrames = SAMixer::CONVERSION_BUFFER_FRAMES * 3 + 17;
+		const UINT32 blockSize = 512;
+		const UINT32 numBlocks = 24;
+
+		for (UINT32 numChannels = 1; numChannels <= 2; numChannels++)
+		{
+			Random floatRandom(1234);
+			Random intRandom(1234);
+
+			SAVoiceProperties props;
+			props.loop = true;
+			props.pitch = 1.3f;
+
+			SAMixer floatMixer(48000);
+			props.buffer = createRandomBuffer(floatRandom, numChannels, numFrames, false);
+
+			UINT32 floatVoice = floatMixer.createVoice();
+			floatMixer.setVoiceProperties(floatVoice, props);
+			floatMixer.play(floatVoice);
+
+			SAMixer intMixer(48000);
+			props.buffer = createRandomBuffer(intRandom, numChannels, numFrames, true);
+
+			UINT32 intVoice = intMixer.createVoice();
+			intMixer.setVoiceProperties(intVoice, props);
+			intMixer.play(intVoice);
+
+			Vector<float> floatOutput(blockSize * SAMixer::NUM_OUTPUT_CHANNELS);
+			Vector<float> intOutput(blockSize * SAMixer::NUM_OUTPUT_CHANNELS);
+
+			bool matches = true;
+			for (UINT32 i = 0; i < numBlocks; i++)
+			{
+				floatMixer.mix(floatOutput.data(), blockSize);
+				intMixer.mix(intOutput.data(), blockSize);
+
+				for (UINT32 j = 0; j < blockSize * SAMixer::NUM_OUTPUT_CHANNELS; j++)
+					matches &= Math::approxEquals(floatOutput[j], intOutput[j], 1e-5f);
+			}
+
+			BS_TEST_ASSERT(matches);
+			BS_TEST_ASSERT(intMixer.getState(intVoice) == SAVoiceState::Playing);
+			BS_TEST_ASSERT(Math::approxEquals(floatMixer.getTime(floatVoice), intMixer.getTime(intVoice)));
+		}
+	}
+
+	void SAMixerTestSuite::testStreamedPlayback()
+	{
+		// Long enough to wrap around the stream's ring buffer, and played past its end
+		const UINT32 numFrames = SAStream::CAPACITY + 1000;
+		const UINT32 blockSize = 512;
+		const UINT32 numBlocks = 80;
+
+		for (UINT32 numChannels = 1; numChannels <= 2; numChannels++)
+		{
+			for (UINT32 loop = 0; loop < 2; loop++)
+			{
+				Random random(1234);
+				SPtr<SASampleBuffer> samples = createRandomBuffer(random, numChannels, numFrames, true);
+
+				SAVoiceProperties props;
+				props.loop = loop == 1;
+				props.pitch = 1.3f;
+
+				SAMixer memoryMixer(48000);
+				props.buffer = samples;
+
+				UINT32 memoryVoice = memoryMixer.createVoice();
+				memoryMixer.setVoiceProperties(memoryVoice, props);
+				memoryMixer.play(memoryVoice);
+
+				// Streamed voice only gets the format of the data, samples are read through the stream
+				SPtr<SASampleBuffer> format = bs_shared_ptr_new<SASampleBuffer>();
+				format->numChannels = numChannels;
+				format->numFrames = numFrames;
+				format->sampleRate = samples->sampleRate;
+
+				SPtr<SAStream> stream = bs_shared_ptr_new<SAStream>(bs_shared_ptr_new<BufferStreamSource>(samples),
+					numChannels, numFrames);
+
+				SAMixer streamMixer(48000);
+				props.buffer = format;
+				props.stream = stream;
+
+				UINT32 streamVoice = streamMixer.createVoice();
+				streamMixer.setVoiceProperties(streamVoice, props);
+				streamMixer.play(streamVoice);
+
+				Vector<float> memoryOutput(blockSize * SAMixer::NUM_OUTPUT_CHANNELS);
+				Vector<float> streamOutput(blockSize * SAMixer::NUM_OUTPUT_CHANNELS);
+
+				// Nothing is decoded until the stream gets filled, mixer plays silence instead of waiting for it
+				streamMixer.mix(streamOutput.data(), blockSize);
+
+				bool silent = true;
+				for (auto& entry : streamOutput)
+					silent &= entry == 0.0f;
+
+				BS_TEST_ASSERT(silent);
+				BS_TEST_ASSERT(streamMixer.getState(streamVoice) == SAVoiceState::Playing);
+				BS_TEST_ASSERT(streamMixer.getTime(streamVoice) == 0.0f);
+
+				// Once decoded, streamed data plays the same as data in memory
+				bool matches = true;
+				for (UINT32 i = 0; i < numBlocks; i++)
+				{
+					stream->fill();
+
+					memoryMixer.mix(memoryOutput.data(), blockSize);
+					streamMixer.mix(streamOutput.data(), blockSize);
+
+					for (UINT32 j = 0; j < blockSize * SAMixer::NUM_OUTPUT_CHANNELS; j++)
+						matches &= Math::approxEquals(memoryOutput[j], streamOutput[j], 1e-5f);
+
+					matches &= memoryMixer.getState(memoryVoice) == streamMixer.getState(streamVoice);
+				}
+
+				BS_TEST_ASSERT(matches);
+				BS_TEST_ASSERT(Math::approxEquals(memoryMixer.getTime(memoryVoice), streamMixer.getTime(streamVoice)));
+
+				const SAVoiceState expectedState = props.loop ? SAVoiceState::Playing : SAVoiceState::Stopped;
+				BS_TEST_ASSERT(streamMixer.getState(streamVoice) == expectedState);
+
+				if (!props.loop)
+					continue;
+
+				// Without more data decoded the voice runs out of frames, and keeps playing silence in place
+				for (UINT32 i = 0; i < SAStream::CAPACITY / blockSize + 1; i++)
+					streamMixer.mix(streamOutput.data(), blockSize);
+
+				const float time = streamMixer.getTime(streamVoice);
+				streamMixer.mix(streamOutput.data(), blockSize);
+
+				silent = true;
+				for (auto& entry : streamOutput)
+					silent &= entry == 0.0f;
+
+				BS_TEST_ASSERT(silent);
+				BS_TEST_ASSERT(streamMixer.getTime(streamVoice) == time);
+				BS_TEST_ASSERT(streamMixer.getState(streamVoice) == SAVoiceState::Playing);
+			}
+		}
+	}
+
+	void SAMixerTestSuite::testBufferRelease()
+	{
+		const UINT32 blockSize = 512;
+		Vector<float> output(blockSize * SAMixer::NUM_OUTPUT_CHANNELS);
+
+		Random random(1234);
+		SAMixer mixer(48000);
+
+		// Buffer replaced by the mixer is kept alive until the simulation thread releases the applied commands
+		SAVoiceProperties props;
+		props.buffer = createRandomBuffer(random, 2, 4096, false);
+
+		UINT32 voice = mixer.createVoice();
+		mixer.setVoiceProperties(voice, props);
+		mixer.play(voice);
+		mixer.mix(output.data(), blockSize);
+
+		std::weak_ptr<const SASampleBuffer> oldBuffer = props.buffer;
+		props.buffer = createRandomBuffer(random, 2, 4096, false);
+		mixer.setVoiceProperties(voice, props);
+		mixer.mix(output.data(), blockSize);
+
+		BS_TEST_ASSERT(!oldBuffer.expired());
+
+		mixer.releaseAppliedCommands();
+		BS_TEST_ASSERT(oldBuffer.expired());
+
+		// Same for a buffer of a destroyed voice, queuing another command releases it as well
+		oldBuffer = props.buffer;
+		props.buffer = nullptr;
+		mixer.destroyVoice(voice);
+		mixer.mix(output.data(), blockSize);
+
+		BS_TEST_ASSERT(!oldBuffer.expired());
+
+		voice = mixer.createVoice();
+		BS_TEST_ASSERT(oldBuffer.expired());
+
+		// More voices than storage was initially allocated for all get applied and play
+		Vector<UINT32> voices;
+		for (UINT32 i = 0; i < SAMixer::INITIAL_VOICE_CAPACITY * 2 + 1; i++)
+		{
+			UINT32 newVoice = mixer.createVoice();
+			props.buffer = createRandomBuffer(random, 1, 48000, false);
+			mixer.setVoiceProperties(newVoice, props);
+			mixer.play(newVoice);
+
+			voices.push_back(newVoice);
+		}
+
+		mixer.mix(output.data(), blockSize);
+		mixer.releaseAppliedCommands();
+		mixer.mix(output.data(), blockSize);
+
+		bool playing = true;
+		for (auto& entry : voices)
+		{
+			playing &= mixer.getState(entry) == SAVoiceState::Playing;
+			playing &= mixer.getTime(entry) > 0.0f;
+		}
+
+		BS_TEST_ASSERT(playing);
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	SPtr<TestSuite> tests = SAMixerTestSuite::create<SAMixerTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	return 0;
+}